@@ -11,10 +11,24 @@
         "native/src/binding.cpp",
         "native/src/mygramclient.cpp",
         "native/src/mygramclient_c.cpp",
+        "native/src/field_schema.cpp",
+        "native/src/info_poller.cpp",
+        "native/src/server_metrics.cpp",
         "native/src/search_expression.cpp",
+        "native/src/expression_cache.cpp",
+        "native/src/query_analysis.cpp",
+        "native/src/query_cost.cpp",
+        "native/src/query_canonical.cpp",
+        "native/src/term_stats.cpp",
         "native/src/string_utils.cpp",
+        "native/src/builtin_normalizer.cpp",
+        "native/src/utf8_decode.cpp",
+        "native/src/ngram_batch.cpp",
+        "native/src/ngram_filter.cpp",
+        "native/src/local_index.cpp",
         "native/src/network_utils.cpp",
-        "native/src/memory_utils.cpp"
+        "native/src/memory_utils.cpp",
+        "native/src/memory_pressure.cpp"
       ],
       "include_dirs": [
         "native/include"
@@ -134,5 +148,45 @@
         "-lz"
       ]
     }
+  ],
+  "conditions": [
+    [
+      "OS!='win'",
+      {
+        "targets": [
+          {
+            "target_name": "mygram_standin",
+            "type": "executable",
+            "sources": [
+              "native/tools/standin_server.cpp",
+              "native/src/local_index.cpp",
+              "native/src/query_analysis.cpp",
+              "native/src/search_expression.cpp",
+              "native/src/string_utils.cpp",
+              "native/src/builtin_normalizer.cpp",
+              "native/src/utf8_decode.cpp",
+              "native/src/network_utils.cpp"
+            ],
+            "include_dirs": [
+              "native/include"
+            ],
+            "cflags!": [ "-fno-exceptions" ],
+            "cflags_cc!": [ "-fno-exceptions" ],
+            "cflags_cc": [
+              "-std=c++17",
+              "-fexceptions",
+              "-pthread"
+            ],
+            "xcode_settings": {
+              "GCC_ENABLE_CPP_EXCEPTIONS": "YES",
+              "CLANG_CXX_LIBRARY": "libc++",
+              "MACOSX_DEPLOYMENT_TARGET": "10.15",
+              "CLANG_CXX_LANGUAGE_STANDARD": "c++17"
+            },
+            "ldflags": [ "-pthread" ]
+          }
+        ]
+      }
+    ]
   ]
 }
@@ -0,0 +1,137 @@
+/**
+ * @file expression_cache.h
+ * @brief Concurrent LRU cache of parsed search expressions
+ *
+ * Search boxes send the same expressions over and over. ExpressionCache parses
+ * each distinct expression once and serves the converted query string and the
+ * simplified term lists from memory afterwards.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mygramdb::client {
+
+/**
+ * @brief Parse results for one search expression
+ */
+struct CachedExpression {
+  std::string error;                   // Parse error (empty on success)
+  std::string query;                   // ConvertSearchExpression result
+  bool simplified = false;             // SimplifySearchExpression succeeded
+  std::string main_term;               // Simplified main term
+  std::vector<std::string> and_terms;  // Simplified additional required terms
+  std::vector<std::string> not_terms;  // Simplified excluded terms
+
+  /**
+   * @brief Check if the expression parsed successfully
+   */
+  [[nodiscard]] bool Ok() const { return error.empty(); }
+};
+
+/**
+ * @brief Cache counters
+ */
+struct ExpressionCacheStats {
+  uint64_t hits = 0;       // Lookups served from the cache
+  uint64_t misses = 0;     // Lookups that parsed the expression
+  uint64_t evictions = 0;  // Entries dropped to stay within capacity
+  size_t size = 0;         // Entries currently cached
+  size_t capacity = 0;     // Maximum entries
+
+  /**
+   * @brief Fraction of lookups served from the cache (0 before any lookup)
+   */
+  [[nodiscard]] double HitRate() const {
+    uint64_t lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+  }
+};
+
+/**
+ * @brief Expression cache configuration
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - Default cache settings
+struct ExpressionCacheConfig {
+  size_t capacity = 1024;  // Maximum entries (0 disables caching)
+  size_t shards = 8;       // Independently locked shards (reduces contention)
+};
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Sharded, thread-safe LRU cache of expression → parse results
+ *
+ * Each shard has its own lock and LRU list, so concurrent lookups of different
+ * expressions rarely contend. Parse errors are cached too, so repeated bad
+ * input does not re-run the parser.
+ *
+ * Example usage:
+ * @code
+ *   ExpressionCache cache;
+ *   auto parsed = cache.Get("golang -old");
+ *   if (parsed->Ok()) {
+ *     client.Search("articles", parsed->main_term, parsed->and_terms, parsed->not_terms, ...);
+ *   }
+ *   std::cout << cache.GetStats().HitRate() << "\n";
+ * @endcode
+ */
+class ExpressionCache {
+ public:
+  /**
+   * @brief Construct cache with configuration
+   * @param config Cache configuration
+   */
+  explicit ExpressionCache(ExpressionCacheConfig config = {});
+
+  /**
+   * @brief Destructor
+   */
+  ~ExpressionCache();
+
+  // Non-copyable, non-movable (holds locks)
+  ExpressionCache(const ExpressionCache&) = delete;
+  ExpressionCache& operator=(const ExpressionCache&) = delete;
+  ExpressionCache(ExpressionCache&&) = delete;
+  ExpressionCache& operator=(ExpressionCache&&) = delete;
+
+  /**
+   * @brief Get parse results, parsing and caching the expression on a miss
+   * @param expression Web-style search expression
+   * @return Shared parse results (never nullptr)
+   */
+  [[nodiscard]] std::shared_ptr<const CachedExpression> Get(const std::string& expression);
+
+  /**
+   * @brief Get cache counters
+   */
+  [[nodiscard]] ExpressionCacheStats GetStats() const;
+
+  /**
+   * @brief Change the capacity, evicting least recently used entries if needed
+   * @param capacity Maximum entries (0 disables caching)
+   */
+  void Resize(size_t capacity);
+
+  /**
+   * @brief Remove all entries (counters are kept)
+   */
+  void Clear();
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Parse an expression into cacheable results without caching
+ * @param expression Web-style search expression
+ * @return Parse results
+ */
+CachedExpression ParseExpressionForCache(const std::string& expression);
+
+}  // namespace mygramdb::client
@@ -0,0 +1,122 @@
+/**
+ * @file field_schema.h
+ * @brief Typed decoding of document filter fields
+ *
+ * MygramDB returns filter fields as `key=value` text. A per-table FieldSchema
+ * declares how each field should be decoded so callers get integers, floats
+ * and timestamps without re-parsing strings on every hydration.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mygramdb::client {
+
+/**
+ * @brief Declared type of a filter field
+ */
+enum class FieldType : uint8_t {
+  kString,    // Raw text (default)
+  kInteger,   // Signed 64-bit integer
+  kFloat,     // Double precision number
+  kTimestamp  // Milliseconds since the Unix epoch (UTC)
+};
+
+/**
+ * @brief Field name → declared type for one table
+ */
+using FieldSchema = std::unordered_map<std::string, FieldType>;
+
+/**
+ * @brief Decoded filter field value
+ *
+ * The raw text stays in Document::fields; this holds the decoded form.
+ * A value that does not parse as its declared type decodes as kString.
+ */
+struct FieldValue {
+  FieldType type = FieldType::kString;
+  int64_t integer = 0;  // kInteger value, or kTimestamp milliseconds
+  double number = 0.0;  // kFloat value (also set for kInteger and kTimestamp)
+};
+
+/**
+ * @brief Parse a plain decimal number ([+-]digits[.digits][e[+-]digits])
+ *
+ * Stricter than strtod: hex, inf and nan spellings are rejected.
+ *
+ * @param text Input text
+ * @param value Output value
+ * @return true if the whole text is a decimal number
+ */
+bool ParseDecimalNumber(std::string_view text, double& value);
+
+/**
+ * @brief Parse a signed 64-bit decimal integer
+ *
+ * @param text Input text
+ * @return Integer value, or std::nullopt if not an integer or out of range
+ */
+std::optional<int64_t> ParseInteger(std::string_view text);
+
+/**
+ * @brief Parse a timestamp to milliseconds since the Unix epoch
+ *
+ * Accepted forms:
+ * - Integer epoch seconds (`1700000000`)
+ * - ISO-8601 date (`2024-01-31`)
+ * - ISO-8601 date-time (`2024-01-31T12:34:56`, `T` or space separator),
+ *   with optional fraction (`.123`) and zone (`Z`, `+09:00`, `-0500`)
+ *
+ * Date-times without a zone are interpreted as UTC.
+ *
+ * @param text Input text
+ * @return Milliseconds since epoch, or std::nullopt if not a timestamp
+ */
+std::optional<int64_t> ParseTimestampMillis(std::string_view text);
+
+/**
+ * @brief Decode a raw field value according to its declared type
+ *
+ * @param text Raw value
+ * @param type Declared type
+ * @return Decoded value (kString if the text does not match the type)
+ */
+FieldValue DecodeFieldValue(std::string_view text, FieldType type);
+
+/**
+ * @brief Infer the narrowest type that fits a raw value
+ *
+ * Integers with leading zeros (zip codes, padded IDs) are inferred as strings
+ * so they round-trip unchanged.
+ *
+ * @param text Raw value
+ * @return Inferred type
+ */
+FieldType InferFieldType(std::string_view text);
+
+/**
+ * @brief Widen two observed types to one that fits both
+ *
+ * kInteger + kFloat widens to kFloat; any other mismatch widens to kString.
+ */
+FieldType MergeFieldTypes(FieldType current, FieldType observed);
+
+/**
+ * @brief Get type name ("string", "integer", "float", "timestamp")
+ */
+const char* FieldTypeToString(FieldType type);
+
+/**
+ * @brief Parse type name
+ *
+ * @param name Type name as returned by FieldTypeToString
+ * @return Field type, or std::nullopt if unknown
+ */
+std::optional<FieldType> ParseFieldType(std::string_view name);
+
+}  // namespace mygramdb::client
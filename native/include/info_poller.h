@@ -0,0 +1,138 @@
+/**
+ * @file info_poller.h
+ * @brief Background INFO poller with a cached snapshot
+ *
+ * Dashboards and health checks often read server statistics far more often
+ * than they change. InfoPoller refreshes INFO on its own connection at a fixed
+ * interval and serves the latest parsed snapshot without a network round trip.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "mygramclient.h"
+
+namespace mygramdb::client {
+
+/**
+ * @brief Info poller configuration
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - Default polling settings
+struct InfoPollerConfig {
+  ClientConfig client;          // Connection settings (the poller opens its own connection)
+  uint32_t interval_ms = 1000;  // Delay between polls
+};
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief One successful INFO poll
+ */
+struct InfoSnapshot {
+  ServerInfo info;             // Parsed INFO response
+  int64_t captured_at_ms = 0;  // Wall-clock capture time (ms since Unix epoch)
+  uint64_t sequence = 0;       // 1 for the first successful poll, +1 per poll
+};
+
+/**
+ * @brief Polls INFO on a background thread and caches the latest snapshot
+ *
+ * Snapshots are immutable and shared, so readers on any thread can hold one
+ * while the poller publishes the next. A failed poll keeps the previous
+ * snapshot, records the error and reconnects on the next attempt.
+ *
+ * Example usage:
+ * @code
+ *   InfoPollerConfig config;
+ *   config.client.host = "localhost";
+ *   config.interval_ms = 5000;
+ *
+ *   InfoPoller poller(config);
+ *   if (auto err = poller.Start()) {
+ *     std::cerr << "Poller failed: " << *err << std::endl;
+ *     return;
+ *   }
+ *
+ *   if (auto snapshot = poller.Latest()) {
+ *     std::cout << "Documents: " << snapshot->info.doc_count << "\n";
+ *   }
+ * @endcode
+ */
+class InfoPoller {
+ public:
+  /**
+   * @brief Callback invoked on the polling thread after each successful poll
+   */
+  using SnapshotListener = std::function<void(const InfoSnapshot& snapshot)>;
+
+  /**
+   * @brief Construct poller with configuration
+   * @param config Poller configuration
+   */
+  explicit InfoPoller(InfoPollerConfig config);
+
+  /**
+   * @brief Destructor - stops polling
+   */
+  ~InfoPoller();
+
+  // Non-copyable, non-movable (owns a running thread)
+  InfoPoller(const InfoPoller&) = delete;
+  InfoPoller& operator=(const InfoPoller&) = delete;
+  InfoPoller(InfoPoller&&) = delete;
+  InfoPoller& operator=(InfoPoller&&) = delete;
+
+  /**
+   * @brief Register a listener for new snapshots (call before Start)
+   *
+   * The listener runs on the thread that polled and must not call back into
+   * this poller's Start/Stop.
+   */
+  void SetListener(SnapshotListener listener);
+
+  /**
+   * @brief Poll once synchronously, then keep polling in the background
+   * @return std::nullopt on success, error message if the first poll failed
+   */
+  std::optional<std::string> Start();
+
+  /**
+   * @brief Stop polling and close the connection
+   *
+   * The latest snapshot stays available.
+   */
+  void Stop();
+
+  /**
+   * @brief Check if the background thread is running
+   */
+  [[nodiscard]] bool IsRunning() const;
+
+  /**
+   * @brief Refresh the snapshot now, outside the schedule
+   * @return std::nullopt on success, error message on failure
+   */
+  std::optional<std::string> PollNow();
+
+  /**
+   * @brief Get the latest snapshot
+   * @return Snapshot, or nullptr before the first successful poll
+   */
+  [[nodiscard]] std::shared_ptr<const InfoSnapshot> Latest() const;
+
+  /**
+   * @brief Get the error of the most recent poll
+   * @return Error message (empty if the last poll succeeded)
+   */
+  [[nodiscard]] std::string GetLastError() const;
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace mygramdb::client
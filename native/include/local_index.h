@@ -0,0 +1,173 @@
+/**
+ * @file local_index.h
+ * @brief In-process n-gram inverted index with MygramDB search semantics
+ *
+ * For small reference tables a network round trip to the server costs more
+ * than the search itself. LocalIndex indexes documents the way the server
+ * does (normalize, split into hybrid n-grams, one posting list per n-gram)
+ * and answers Search/Count with the same term semantics as
+ * MygramClient::Search, in process.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "mygramclient.h"
+#include "query_canonical.h"
+
+namespace mygramdb::client {
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Local index configuration
+ *
+ * Mirror the server's table settings to get the results the server would.
+ */
+struct LocalIndexConfig {
+  int ascii_ngram_size = 2;                                // ngram_size for non-CJK text
+  int kanji_ngram_size = 1;                                // kanji_ngram_size
+  QueryNormalization normalization{true, "narrow", false};  // Applied to documents and terms alike
+};
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Local index counters
+ */
+struct LocalIndexStats {
+  size_t documents = 0;      // Live documents
+  size_t removed = 0;        // Removed or replaced documents still in posting lists
+  size_t ngrams = 0;         // Distinct n-grams (posting lists)
+  uint64_t postings = 0;     // Posting list entries
+  size_t posting_bytes = 0;  // Compressed size of all posting lists
+};
+
+/**
+ * @brief In-process n-gram inverted index
+ *
+ * Posting lists hold ascending document ids as varint-encoded deltas, with
+ * a skip entry every few dozen ids so intersections can jump ahead instead
+ * of decoding every entry. N-grams are keyed by their 64-bit hash (see
+ * utils::HashNgram).
+ *
+ * A document matches a term when it contains every n-gram of the term; as
+ * on the server, positions are not checked. The query must match all
+ * positive terms and no NOT term. A term too short to form an n-gram
+ * matches nothing. Filters compare field values for equality. Results are
+ * ordered by primary key (or a field), comparing digit-only values as
+ * numbers.
+ *
+ * Removing or replacing a document only marks it; posting lists are
+ * rebuilt without removed documents by Compact(), which runs automatically
+ * once they make up half of the index. Searches may run concurrently with
+ * each other; updates take an exclusive lock.
+ *
+ * Example usage:
+ * @code
+ *   LocalIndex index;
+ *   index.Add("1", "東京都の天気", {{"status", "1"}});
+ *   auto result = index.Search("天気", 10);
+ * @endcode
+ */
+class LocalIndex {
+ public:
+  /**
+   * @brief Construct an empty index
+   * @param config N-gram sizes and normalization
+   */
+  explicit LocalIndex(LocalIndexConfig config = {});
+
+  /**
+   * @brief Destructor
+   */
+  ~LocalIndex();
+
+  // Non-copyable, non-movable (holds locks)
+  LocalIndex(const LocalIndex&) = delete;
+  LocalIndex& operator=(const LocalIndex&) = delete;
+  LocalIndex(LocalIndex&&) = delete;
+  LocalIndex& operator=(LocalIndex&&) = delete;
+
+  /**
+   * @brief Add a document, replacing any document with the same primary key
+   *
+   * @param primary_key Primary key
+   * @param text Indexed text
+   * @param fields Filter fields (key=value pairs)
+   */
+  void Add(const std::string& primary_key, std::string_view text,
+           const std::vector<std::pair<std::string, std::string>>& fields = {});
+
+  /**
+   * @brief Remove a document
+   *
+   * @param primary_key Primary key
+   * @return True if the document was indexed
+   */
+  bool Remove(const std::string& primary_key);
+
+  /**
+   * @brief Search for documents (same arguments as MygramClient::Search, without the table)
+   *
+   * @param query Search query text
+   * @param limit Maximum number of results (0 for all)
+   * @param offset Result offset for pagination
+   * @param and_terms Additional required terms
+   * @param not_terms Excluded terms
+   * @param filters Filter conditions (key=value pairs)
+   * @param sort_column Field to sort by (empty for primary key)
+   * @param sort_desc Sort descending
+   * @return SearchResponse on success, Error if the query has no positive term
+   */
+  [[nodiscard]] std::variant<SearchResponse, Error> Search(
+      const std::string& query,
+      uint32_t limit = 1000,  // NOLINT(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+      uint32_t offset = 0, const std::vector<std::string>& and_terms = {},
+      const std::vector<std::string>& not_terms = {},
+      const std::vector<std::pair<std::string, std::string>>& filters = {}, const std::string& sort_column = "",
+      bool sort_desc = true) const;
+
+  /**
+   * @brief Count matching documents
+   *
+   * @param query Search query text
+   * @param and_terms Additional required terms
+   * @param not_terms Excluded terms
+   * @param filters Filter conditions (key=value pairs)
+   * @return CountResponse on success, Error if the query has no positive term
+   */
+  [[nodiscard]] std::variant<CountResponse, Error> Count(
+      const std::string& query, const std::vector<std::string>& and_terms = {},
+      const std::vector<std::string>& not_terms = {},
+      const std::vector<std::pair<std::string, std::string>>& filters = {}) const;
+
+  /**
+   * @brief Get index counters
+   */
+  [[nodiscard]] LocalIndexStats GetStats() const;
+
+  /**
+   * @brief Rebuild posting lists without removed documents
+   */
+  void Compact();
+
+  /**
+   * @brief Remove all documents
+   */
+  void Clear();
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace mygramdb::client
@@ -0,0 +1,144 @@
+/**
+ * @file memory_pressure.h
+ * @brief Periodic memory health signal that shrinks and regrows caches
+ *
+ * Caches sized for a healthy host can push a memory-limited container into an
+ * OOM kill. MemoryPressureMonitor samples utils::GetMemoryHealthStatus() (which
+ * honours cgroup limits) on a background thread and tells subscribers when the
+ * status changes; subscribed caches evict down to a fraction of their capacity
+ * under WARNING or CRITICAL and get their full capacity back once HEALTHY.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "expression_cache.h"
+#include "memory_utils.h"
+
+namespace mygramdb::client {
+
+/**
+ * @brief Memory pressure monitor configuration
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - Default pressure settings
+struct MemoryPressureConfig {
+  uint32_t interval_ms = 5000;     // Delay between health checks
+  double warning_fraction = 0.5;   // Capacity kept by subscribed caches on WARNING
+  double critical_fraction = 0.1;  // Capacity kept by subscribed caches on CRITICAL
+};
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Samples memory health on a background thread and notifies subscribers of changes
+ *
+ * Listeners run on the thread that performed the check (the monitor's thread,
+ * or the caller of CheckNow()) and only when the status changes. An UNKNOWN
+ * reading is ignored, so a failed check leaves caches as they are.
+ *
+ * Example usage:
+ * @code
+ *   ExpressionCache cache({4096});
+ *   MemoryPressureMonitor monitor;
+ *   auto subscription = monitor.SubscribeCache(cache);  // 2048 entries on WARNING, 409 on CRITICAL
+ *   monitor.Start();
+ *   ...
+ *   monitor.Unsubscribe(subscription);  // Before the cache is destroyed
+ * @endcode
+ */
+class MemoryPressureMonitor {
+ public:
+  /**
+   * @brief Callback invoked when the memory health status changes
+   */
+  using StatusListener = std::function<void(utils::MemoryHealthStatus status)>;
+
+  /**
+   * @brief Source of memory health readings
+   */
+  using StatusSource = std::function<utils::MemoryHealthStatus()>;
+
+  /**
+   * @brief Construct monitor with configuration
+   * @param config Monitor configuration
+   * @param source Health readings (empty = utils::GetMemoryHealthStatus)
+   */
+  explicit MemoryPressureMonitor(MemoryPressureConfig config = {}, StatusSource source = nullptr);
+
+  /**
+   * @brief Destructor - stops monitoring
+   */
+  ~MemoryPressureMonitor();
+
+  // Non-copyable, non-movable (owns a running thread)
+  MemoryPressureMonitor(const MemoryPressureMonitor&) = delete;
+  MemoryPressureMonitor& operator=(const MemoryPressureMonitor&) = delete;
+  MemoryPressureMonitor(MemoryPressureMonitor&&) = delete;
+  MemoryPressureMonitor& operator=(MemoryPressureMonitor&&) = delete;
+
+  /**
+   * @brief Register a listener for status changes
+   *
+   * The listener is called right away with the current status if one is
+   * known. Listeners must not subscribe or unsubscribe from within the call.
+   *
+   * @return Subscription id for Unsubscribe()
+   */
+  uint64_t Subscribe(StatusListener listener);
+
+  /**
+   * @brief Resize a cache with the memory health status
+   *
+   * The cache's capacity at subscription is its full capacity; WARNING and
+   * CRITICAL scale it by warning_fraction and critical_fraction, evicting
+   * least recently used entries. The cache must outlive the subscription.
+   *
+   * @return Subscription id for Unsubscribe()
+   */
+  uint64_t SubscribeCache(ExpressionCache& cache);
+
+  /**
+   * @brief Remove a subscription (no calls to it are in progress or follow)
+   */
+  void Unsubscribe(uint64_t subscription);
+
+  /**
+   * @brief Check once synchronously, then keep checking in the background
+   */
+  void Start();
+
+  /**
+   * @brief Stop checking (subscriptions are kept)
+   */
+  void Stop();
+
+  /**
+   * @brief Check if the background thread is running
+   */
+  [[nodiscard]] bool IsRunning() const;
+
+  /**
+   * @brief Check memory health now, notifying subscribers if the status changed
+   * @return Status read (UNKNOWN if the reading failed)
+   */
+  utils::MemoryHealthStatus CheckNow();
+
+  /**
+   * @brief Get the last known status (UNKNOWN before the first successful check)
+   */
+  [[nodiscard]] utils::MemoryHealthStatus GetStatus() const;
+
+  /**
+   * @brief Capacity a cache with the given full capacity keeps in a status
+   */
+  [[nodiscard]] size_t ScaledCapacity(size_t full_capacity, utils::MemoryHealthStatus status) const;
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace mygramdb::client
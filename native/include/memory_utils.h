@@ -20,6 +20,22 @@ struct SystemMemoryInfo {
   uint64_t available_physical_bytes;  ///< Available physical RAM
   uint64_t total_swap_bytes;          ///< Total swap space
   uint64_t available_swap_bytes;      ///< Available swap space
+  bool cgroup_limited;                ///< Physical figures are the cgroup's budget, not the host's
+};
+
+/**
+ * @brief Memory accounting of the process's cgroup (Linux)
+ *
+ * Limits are the tightest of the cgroup and its visible ancestors, so a
+ * pod-level limit applies to every container in the pod.
+ */
+struct CgroupMemoryInfo {
+  int version;                   ///< cgroup version (1 or 2)
+  uint64_t limit_bytes;          ///< Memory limit (UINT64_MAX if unlimited)
+  uint64_t usage_bytes;          ///< Memory charged to the cgroup, page cache included
+  uint64_t inactive_file_bytes;  ///< Inactive page cache within usage (reclaimed before an OOM kill)
+  uint64_t swap_limit_bytes;     ///< Swap limit (UINT64_MAX if unlimited or not accounted)
+  uint64_t swap_usage_bytes;     ///< Swap in use
 };
 
 /**
@@ -44,10 +60,29 @@ enum class MemoryHealthStatus : std::uint8_t {
 /**
  * @brief Get system memory information
  *
+ * Inside a container (cgroup v1 or v2) with a memory limit below the host's
+ * RAM, the physical figures describe the container's budget: total is the
+ * limit and available is the smaller of the host's available memory and the
+ * limit minus the cgroup's working set (usage less inactive page cache). A
+ * cgroup swap limit likewise caps the swap figures.
+ *
  * @return System memory info, or std::nullopt on error
  */
 std::optional<SystemMemoryInfo> GetSystemMemoryInfo();
 
+/**
+ * @brief Get memory accounting of the process's cgroup
+ *
+ * Reads /proc/self/cgroup and the memory controller files under
+ * /sys/fs/cgroup (memory.max, memory.high, memory.current and memory.stat
+ * for v2; memory.limit_in_bytes, memory.usage_in_bytes and memory.stat for
+ * v1).
+ *
+ * @return cgroup memory info, or std::nullopt if there is no memory controller
+ *         (or the platform is not Linux)
+ */
+std::optional<CgroupMemoryInfo> GetCgroupMemoryInfo();
+
 /**
  * @brief Get current process memory usage
  *
@@ -77,6 +112,14 @@ bool CheckMemoryAvailability(uint64_t required_bytes, double safety_margin_ratio
  */
 MemoryHealthStatus GetMemoryHealthStatus();
 
+/**
+ * @brief Get memory health status of an existing reading
+ *
+ * @param info System memory info
+ * @return Memory health status enum
+ */
+MemoryHealthStatus GetMemoryHealthStatus(const SystemMemoryInfo& info);
+
 /**
  * @brief Get human-readable string for memory health status
  *
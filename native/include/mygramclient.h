@@ -10,14 +10,22 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
+#include "field_schema.h"
+#include "term_stats.h"
+
 namespace mygramdb::client {
 
+class NgramBloomFilter;
+
 /**
  * @brief Error wrapper to distinguish from success strings in std::variant
  */
@@ -48,9 +56,81 @@ struct SearchResult {
 struct Document {
   std::string primary_key;                                  // Document primary key
   std::vector<std::pair<std::string, std::string>> fields;  // Filter fields (key=value)
+  std::vector<FieldValue> typed_fields;                     // Decoded values, parallel to fields (empty without schema)
 
   Document() = default;
   explicit Document(std::string primary_key_value) : primary_key(std::move(primary_key_value)) {}
+
+  /**
+   * @brief Get raw field text
+   * @return Value, or std::nullopt if the field is absent
+   */
+  [[nodiscard]] std::optional<std::string_view> GetString(std::string_view name) const;
+
+  /**
+   * @brief Get integer field
+   *
+   * Uses the decoded value when a schema applies, otherwise parses the raw text.
+   *
+   * @return Value, or std::nullopt if absent or not an integer
+   */
+  [[nodiscard]] std::optional<int64_t> GetInteger(std::string_view name) const;
+
+  /**
+   * @brief Get numeric field (integer fields are widened)
+   * @return Value, or std::nullopt if absent or not a number
+   */
+  [[nodiscard]] std::optional<double> GetFloat(std::string_view name) const;
+
+  /**
+   * @brief Get timestamp field as milliseconds since the Unix epoch
+   * @return Value, or std::nullopt if absent or not a timestamp
+   */
+  [[nodiscard]] std::optional<int64_t> GetTimestamp(std::string_view name) const;
+};
+
+/**
+ * @brief Storage kind of a columnar field
+ */
+enum class ColumnKind : uint8_t {
+  kNumeric,  // Every present value parsed as a decimal number
+  kString    // Values kept as packed UTF-8 strings
+};
+
+/**
+ * @brief One requested field across a page of documents (struct-of-arrays)
+ *
+ * Each column has one slot per requested primary key. Numeric columns store
+ * values in `numbers` (NaN where absent); string columns pack all values into
+ * `string_data`, with row i spanning `string_offsets[i]..string_offsets[i + 1]`.
+ *
+ * When the table has a field schema, declared string fields always use string
+ * storage and timestamp fields store epoch milliseconds in `numbers`.
+ */
+struct FieldColumn {
+  std::string name;                        // Field name
+  ColumnKind kind = ColumnKind::kNumeric;  // Storage kind
+  std::vector<double> numbers;             // Numeric values (kNumeric only)
+  std::string string_data;                 // Packed string bytes (kString only)
+  std::vector<uint32_t> string_offsets;    // Row offsets into string_data, size rows + 1 (kString only)
+  std::vector<uint8_t> present;            // 1 if the row's document has this field
+  std::optional<FieldType> declared_type;  // Type from the table's field schema, if any
+
+  /**
+   * @brief Get string value of a row (kString columns only)
+   */
+  [[nodiscard]] std::string_view StringAt(size_t row) const {
+    return std::string_view(string_data).substr(string_offsets[row], string_offsets[row + 1] - string_offsets[row]);
+  }
+};
+
+/**
+ * @brief Multi-document GET result in columnar form
+ */
+struct ColumnarDocuments {
+  std::vector<std::string> primary_keys;  // Requested primary keys (row order)
+  std::vector<uint8_t> found;             // 1 if the document exists
+  std::vector<FieldColumn> columns;       // One column per requested field (request order)
 };
 
 /**
@@ -89,6 +169,9 @@ struct CountResponse {
 
 /**
  * @brief Server information
+ *
+ * The common fields are filled from well-known keys; `values` keeps every
+ * key of the INFO body so newer server statistics need no client change.
  */
 struct ServerInfo {
   std::string version;
@@ -97,7 +180,26 @@ struct ServerInfo {
   uint64_t active_connections = 0;
   uint64_t index_size_bytes = 0;
   uint64_t doc_count = 0;
-  std::vector<std::string> tables;  // List of table names
+  std::vector<std::string> tables;                         // List of table names
+  std::map<std::string, std::string, std::less<>> values;  // All INFO keys (section headers skipped)
+
+  /**
+   * @brief Get raw value of an INFO key
+   * @return Value, or std::nullopt if the key is absent
+   */
+  [[nodiscard]] std::optional<std::string_view> Get(std::string_view key) const;
+
+  /**
+   * @brief Get unsigned integer value of an INFO key
+   * @return Value, or std::nullopt if absent or not an unsigned integer
+   */
+  [[nodiscard]] std::optional<uint64_t> GetUint(std::string_view key) const;
+
+  /**
+   * @brief Get numeric value of an INFO key
+   * @return Value, or std::nullopt if absent or not a decimal number
+   */
+  [[nodiscard]] std::optional<double> GetDouble(std::string_view key) const;
 };
 
 /**
@@ -119,6 +221,10 @@ struct ClientConfig {
   uint16_t port = 11016;              // Default port for MygramDB protocol
   uint32_t timeout_ms = 5000;         // Default timeout in milliseconds
   uint32_t recv_buffer_size = 65536;  // Default buffer size (64KB)
+  bool learn_field_schemas = false;   // Infer field types of tables without a declared schema
+  bool reorder_terms = false;         // Put the rarest known term first in SEARCH/COUNT
+  bool analyze_queries = false;       // Answer contradictory or invalid SEARCH/COUNT locally
+  uint32_t multiline_idle_ms = 100;   // Idle time after a blank line that ends an INFO/CONFIG reply
 };
 // NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
 
@@ -234,6 +340,81 @@ class MygramClient {
    */
   std::variant<Document, Error> Get(const std::string& table, const std::string& primary_key);
 
+  /**
+   * @brief Get selected fields of many documents as columns
+   *
+   * GET commands are pipelined over the connection and the responses are
+   * decoded straight into per-field columns, without building a Document
+   * per row. Documents the server reports as missing leave their row empty
+   * (found = 0) instead of failing the whole call.
+   *
+   * @param table Table name
+   * @param primary_keys Primary keys to fetch (row order)
+   * @param fields Field names to extract (column order)
+   * @return ColumnarDocuments on success, Error on failure
+   */
+  std::variant<ColumnarDocuments, Error> GetColumns(const std::string& table,
+                                                    const std::vector<std::string>& primary_keys,
+                                                    const std::vector<std::string>& fields);
+
+  /**
+   * @brief Declare the filter field types of a table
+   *
+   * Get() decodes declared fields into Document::typed_fields and GetColumns()
+   * uses the declared types for column storage. Fields missing from the schema
+   * decode as strings. Declaring replaces any schema learned for the table.
+   *
+   * @param table Table name
+   * @param schema Field types (empty to drop the table's schema)
+   */
+  void SetFieldSchema(const std::string& table, FieldSchema schema);
+
+  /**
+   * @brief Get the declared or learned field schema of a table
+   *
+   * With ClientConfig::learn_field_schemas, types are inferred from the values
+   * seen by Get() and widened when a later value does not fit.
+   *
+   * @param table Table name
+   * @return Field schema, or std::nullopt if the table has none
+   */
+  [[nodiscard]] std::optional<FieldSchema> GetFieldSchema(const std::string& table) const;
+
+  /**
+   * @brief Get the term statistics used by ClientConfig::reorder_terms
+   *
+   * With reorder_terms, single-term COUNT/SEARCH results and DEBUG candidate
+   * counts are recorded automatically; callers may also prime the cache.
+   *
+   * @return Term statistics of this client
+   */
+  TermStatsCache& GetTermStats();
+
+  /**
+   * @brief Attach an n-gram filter to a table
+   *
+   * SEARCH/COUNT calls for the table with a positive term containing an
+   * n-gram the filter never saw return an empty result without a round trip.
+   * The filter is shared, not copied: keep adding the table's new documents
+   * to it (not concurrently with queries) so it keeps covering the index.
+   *
+   * @param table Table name
+   * @param filter Filter of the table's n-grams (nullptr to detach)
+   */
+  void SetNgramFilter(const std::string& table, std::shared_ptr<const NgramBloomFilter> filter);
+
+  /**
+   * @brief Get the number of SEARCH/COUNT calls answered without the server
+   *
+   * With ClientConfig::analyze_queries, queries that can never match (a term
+   * both required and excluded) return an empty result and invalid ones
+   * (empty terms, no positive term) return an error without a round trip.
+   * Queries rejected by an n-gram filter (see SetNgramFilter) count as well.
+   *
+   * @return Round trips saved so far
+   */
+  [[nodiscard]] uint64_t GetSavedRoundTrips() const;
+
   /**
    * @brief Get server information
    * @return ServerInfo on success, Error on failure
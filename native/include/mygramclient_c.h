@@ -28,6 +28,31 @@ extern "C" {
  */
 typedef struct MygramClient_C MygramClient_C;
 
+/**
+ * @brief Opaque handle to a background INFO poller
+ */
+typedef struct MygramInfoPoller_C MygramInfoPoller_C;
+
+/**
+ * @brief Opaque handle to a server metrics collector
+ */
+typedef struct MygramMetricsCollector_C MygramMetricsCollector_C;
+
+/**
+ * @brief Opaque handle to a parsed search expression cache
+ */
+typedef struct MygramExpressionCache_C MygramExpressionCache_C;
+
+/**
+ * @brief Opaque handle to an in-process n-gram index
+ */
+typedef struct MygramLocalIndex_C MygramLocalIndex_C;
+
+/**
+ * @brief Opaque handle to a Bloom filter of a table's n-grams
+ */
+typedef struct MygramNgramFilter_C MygramNgramFilter_C;
+
 /**
  * @brief Client configuration
  */
@@ -36,8 +61,30 @@ typedef struct {
   uint16_t port;              // Server port (default: 11016)
   uint32_t timeout_ms;        // Connection timeout in milliseconds (default: 5000)
   uint32_t recv_buffer_size;  // Receive buffer size (default: 65536)
+  int learn_field_schemas;    // Infer field types of tables without a declared schema (default: 0)
+  int reorder_terms;          // Put the rarest known term first in SEARCH/COUNT (default: 0)
+  int analyze_queries;        // Answer contradictory or invalid SEARCH/COUNT locally (default: 0)
 } MygramClientConfig_C;
 
+/**
+ * @brief Filter field type (values of FieldType in mygramclient.h)
+ */
+typedef enum {
+  MYGRAM_FIELD_STRING = 0,    // Raw text
+  MYGRAM_FIELD_INTEGER = 1,   // Signed 64-bit integer
+  MYGRAM_FIELD_FLOAT = 2,     // Double precision number
+  MYGRAM_FIELD_TIMESTAMP = 3  // Milliseconds since the Unix epoch (UTC)
+} MygramFieldType_C;
+
+/**
+ * @brief Field schema of one table
+ */
+typedef struct {
+  char** field_names;  // Array of field names
+  int* field_types;    // Array of MygramFieldType_C values
+  size_t field_count;  // Number of fields
+} MygramFieldSchema_C;
+
 /**
  * @brief Search result
  */
@@ -49,14 +96,49 @@ typedef struct {
 
 /**
  * @brief Document with fields
+ *
+ * When the table has a field schema, field_types/field_integers/field_numbers
+ * hold the decoded value of each field; otherwise they are NULL.
  */
 typedef struct {
-  char* primary_key;    // Document primary key
-  char** field_keys;    // Array of field keys
-  char** field_values;  // Array of field values
-  size_t field_count;   // Number of fields
+  char* primary_key;        // Document primary key
+  char** field_keys;        // Array of field keys
+  char** field_values;      // Array of field values
+  size_t field_count;       // Number of fields
+  int* field_types;         // Decoded MygramFieldType_C per field (or NULL)
+  int64_t* field_integers;  // Integer value or timestamp milliseconds per field (or NULL)
+  double* field_numbers;    // Numeric value per field, 0 for strings (or NULL)
 } MygramDocument_C;
 
+/**
+ * @brief One field column of a columnar multi-document result
+ *
+ * Exactly one storage form is populated: `numbers` when is_numeric is 1,
+ * otherwise `string_data` + `string_offsets` (row i spans
+ * string_offsets[i]..string_offsets[i + 1]).
+ */
+typedef struct {
+  char* name;                // Field name
+  int is_numeric;            // 1 = numbers, 0 = packed strings
+  double* numbers;           // row_count values, NaN where absent (or NULL)
+  char* string_data;         // Packed UTF-8 bytes, not NUL-separated (or NULL)
+  size_t string_data_size;   // Size of string_data in bytes
+  uint32_t* string_offsets;  // row_count + 1 offsets (or NULL)
+  uint8_t* present;          // row_count flags, 1 if the document has the field
+  int field_type;            // MygramFieldType_C from the table schema, or -1 if undeclared
+} MygramColumn_C;
+
+/**
+ * @brief Columnar multi-document result
+ */
+typedef struct {
+  char** primary_keys;      // Requested primary keys (row order)
+  uint8_t* found;           // row_count flags, 1 if the document exists
+  size_t row_count;         // Number of rows
+  MygramColumn_C* columns;  // Columns (request order)
+  size_t column_count;      // Number of columns
+} MygramColumnarResult_C;
+
 /**
  * @brief Server information
  */
@@ -69,8 +151,229 @@ typedef struct {
   uint64_t doc_count;
   char** tables;       // Array of table names
   size_t table_count;  // Number of tables
+  char** keys;         // Every INFO key (sorted)
+  char** values;       // Value of each key
+  size_t value_count;  // Number of keys
 } MygramServerInfo_C;
 
+/**
+ * @brief Parsed search expression
+ */
+typedef struct {
+  char* error;        // Parse error, NULL on success
+  char* query;        // Converted query string
+  int simplified;     // 1 if main_term/and_terms/not_terms are set
+  char* main_term;    // Simplified main term
+  char** and_terms;   // Additional required terms
+  size_t and_count;   // Number of and_terms
+  char** not_terms;   // Excluded terms
+  size_t not_count;   // Number of not_terms
+} MygramParsedExpression_C;
+
+/**
+ * @brief Batch of converted search expressions, packed into one buffer
+ *
+ * Entry i is data[offsets[i], offsets[i + 1]): the converted query string
+ * when ok[i] is 1, the parse error when ok[i] is 0.
+ */
+typedef struct {
+  char* data;         // Query strings and error messages, back to back (NUL-terminated as a whole)
+  size_t data_size;   // Bytes in data, excluding the terminator
+  uint32_t* offsets;  // count + 1 byte offsets into data
+  uint8_t* ok;        // 1 if the entry converted, 0 if it holds the parse error
+  size_t count;       // Number of entries
+} MygramConvertedExpressions_C;
+
+/**
+ * @brief Term normalization applied by canonical query keys (zero fields leave terms untouched)
+ */
+typedef struct {
+  int nfkc;           // Apply NFKC normalization to terms
+  const char* width;  // Width conversion: "keep", "narrow", "wide" (NULL = "keep")
+  int lower;          // Lowercase terms
+} MygramQueryNormalization_C;
+
+/**
+ * @brief What an n-gram batch produces per document besides its n-gram count
+ */
+typedef enum {
+  MYGRAM_NGRAM_BATCH_COUNTS = 0,  // N-gram counts only
+  MYGRAM_NGRAM_BATCH_HASHES = 1,  // 64-bit n-gram hashes
+  MYGRAM_NGRAM_BATCH_NGRAMS = 2   // N-gram text
+} MygramNgramBatchOutput_C;
+
+/**
+ * @brief N-gram batch settings (zero fields use the defaults)
+ */
+typedef struct {
+  int ascii_ngram_size;  // Server's ngram_size for non-CJK text (default: 2)
+  int kanji_ngram_size;  // Server's kanji_ngram_size (default: 1)
+  int nfkc;              // Apply NFKC normalization to documents
+  const char* width;     // Width conversion: "keep", "narrow", "wide" (NULL = "keep")
+  int lower;             // Lowercase documents
+  int output;            // MygramNgramBatchOutput_C
+  int distinct;          // Keep only the first occurrence of an n-gram in each document
+  size_t max_threads;    // Upper bound on threads (0 = default, 1 = calling thread only)
+} MygramNgramBatchConfig_C;
+
+/**
+ * @brief N-grams of a batch of documents, packed into flat buffers
+ *
+ * Document i owns entries [document_offsets[i], document_offsets[i + 1]) of
+ * hashes or of the n-grams; n-gram j is data[ngram_offsets[j], ngram_offsets[j + 1]).
+ */
+typedef struct {
+  uint32_t* counts;            // N-grams of each document
+  uint32_t* document_offsets;  // count + 1 entry offsets (NULL for MYGRAM_NGRAM_BATCH_COUNTS)
+  size_t count;                // Number of documents
+  uint64_t* hashes;            // Hashes of all documents, in order (MYGRAM_NGRAM_BATCH_HASHES)
+  size_t hash_count;           // Number of hashes
+  char* data;                  // N-gram text, back to back (MYGRAM_NGRAM_BATCH_NGRAMS, NUL-terminated as a whole)
+  size_t data_size;            // Bytes in data, excluding the terminator
+  uint32_t* ngram_offsets;     // ngram_count + 1 byte offsets into data (MYGRAM_NGRAM_BATCH_NGRAMS)
+  size_t ngram_count;          // Number of n-grams
+} MygramNgramBatch_C;
+
+/**
+ * @brief Query cost estimation settings (zero fields use the defaults)
+ */
+typedef struct {
+  int ascii_ngram_size;       // Server's ngram_size for non-CJK text (default: 2)
+  int kanji_ngram_size;       // Server's kanji_ngram_size (default: 1)
+  int nfkc;                   // Apply NFKC normalization to terms
+  const char* width;          // Width conversion: "keep", "narrow", "wide" (NULL = "keep")
+  int lower;                  // Lowercase terms
+  uint32_t moderate_ngrams;   // Total n-grams for the "moderate" class (default: 32)
+  uint32_t high_ngrams;       // Total n-grams for the "high" class (default: 128)
+  uint32_t excessive_ngrams;  // Total n-grams for the "excessive" class (default: 512)
+} MygramQueryCostConfig_C;
+
+/**
+ * @brief Query cost classes
+ */
+typedef enum {
+  MYGRAM_QUERY_COST_LOW = 0,
+  MYGRAM_QUERY_COST_MODERATE = 1,
+  MYGRAM_QUERY_COST_HIGH = 2,
+  MYGRAM_QUERY_COST_EXCESSIVE = 3
+} MygramQueryCostClass_C;
+
+/**
+ * @brief Estimated cost of a query
+ */
+typedef struct {
+  char* error;               // Parse error, NULL on success
+  char** terms;              // Every term and phrase, in expression order
+  uint32_t* term_ngrams;     // N-grams of each term
+  uint8_t* term_flags;       // Per term: bit 0 phrase, bit 1 excluded, bit 2 optional (under OR)
+  size_t term_count;         // Number of terms
+  uint64_t total_ngrams;     // Sum of n-grams over all terms
+  uint64_t distinct_ngrams;  // Distinct n-grams over the whole query
+  uint32_t max_term_ngrams;  // N-grams of the most expensive term
+  uint32_t short_terms;      // Terms too short to produce any n-gram
+  int cost_class;            // MygramQueryCostClass_C
+} MygramQueryCost_C;
+
+// Bits of MygramQueryCost_C::term_flags
+#define MYGRAM_TERM_PHRASE 0x1
+#define MYGRAM_TERM_EXCLUDED 0x2
+#define MYGRAM_TERM_OPTIONAL 0x4
+
+/**
+ * @brief Expression cache counters
+ */
+typedef struct {
+  uint64_t hits;       // Lookups served from the cache
+  uint64_t misses;     // Lookups that parsed the expression
+  uint64_t evictions;  // Entries dropped to stay within capacity
+  size_t size;         // Entries currently cached
+  size_t capacity;     // Maximum entries
+} MygramExpressionCacheStats_C;
+
+/**
+ * @brief Local index settings (zero n-gram sizes use the defaults)
+ */
+typedef struct {
+  int ascii_ngram_size;  // Server's ngram_size for non-CJK text (default: 2)
+  int kanji_ngram_size;  // Server's kanji_ngram_size (default: 1)
+  int nfkc;              // Apply NFKC normalization to documents and terms
+  const char* width;     // Width conversion: "keep", "narrow", "wide" (NULL = "keep")
+  int lower;             // Lowercase documents and terms
+} MygramLocalIndexConfig_C;
+
+/**
+ * @brief Local index counters
+ */
+typedef struct {
+  size_t documents;      // Live documents
+  size_t removed;        // Removed or replaced documents still in posting lists
+  size_t ngrams;         // Distinct n-grams (posting lists)
+  uint64_t postings;     // Posting list entries
+  size_t posting_bytes;  // Compressed size of all posting lists
+} MygramLocalIndexStats_C;
+
+/**
+ * @brief N-gram filter settings (zero values use the defaults)
+ */
+typedef struct {
+  int ascii_ngram_size;   // Server's ngram_size for non-CJK text (default: 2)
+  int kanji_ngram_size;   // Server's kanji_ngram_size (default: 1)
+  int nfkc;               // Apply NFKC normalization to documents and terms
+  const char* width;      // Width conversion: "keep", "narrow", "wide" (NULL = "keep")
+  int lower;              // Lowercase documents and terms
+  double bits_per_ngram;  // Filter bits per expected n-gram (default: 10, ~1% false positives)
+} MygramNgramFilterConfig_C;
+
+/**
+ * @brief N-gram filter counters
+ */
+typedef struct {
+  uint64_t ngrams;             // N-grams added
+  size_t size_bytes;           // Size of the bit array
+  uint32_t hash_count;         // Bits set per n-gram
+  double false_positive_rate;  // Estimated from the fraction of bits set
+} MygramNgramFilterStats_C;
+
+/**
+ * @brief Memory health reading (cgroup-aware on Linux)
+ */
+typedef struct {
+  int status;                         // 0 = HEALTHY, 1 = WARNING, 2 = CRITICAL, 3 = UNKNOWN
+  uint64_t total_physical_bytes;      // Physical memory, or the cgroup limit if lower
+  uint64_t available_physical_bytes;  // Memory that can still be used without pressure
+  int cgroup_limited;                 // 1 if the figures are the cgroup's budget
+} MygramMemoryHealth_C;
+
+/**
+ * @brief Rates over one rolling window
+ */
+typedef struct {
+  uint32_t window_seconds;     // Requested window length
+  double covered_seconds;      // Time covered by samples (shorter while warming up)
+  double requests_per_second;  // total_requests growth rate
+  double errors_per_second;    // total_errors growth rate (0 if not reported)
+  double error_ratio;          // Errors per request over the window
+  double docs_per_second;      // doc_count change rate
+  int64_t doc_delta;           // doc_count change over the window
+  int64_t index_bytes_delta;   // index_size_bytes change over the window
+} MygramMetricsWindow_C;
+
+/**
+ * @brief Server metrics derived from INFO deltas
+ */
+typedef struct {
+  int64_t captured_at_ms;          // Time of the newest sample (0 before the first sample)
+  uint64_t sample_count;           // Samples currently retained
+  uint64_t doc_count;              // Latest doc_count
+  uint64_t index_size_bytes;       // Latest index_size_bytes
+  double index_bytes_per_doc;      // index_size_bytes / doc_count
+  uint64_t active_connections;     // Latest active_connections
+  int reports_errors;              // 1 if INFO includes total_errors
+  uint32_t counter_resets;         // Times the server counters restarted
+  MygramMetricsWindow_C* windows;  // One entry per configured window
+  size_t window_count;             // Number of windows
+} MygramServerMetrics_C;
+
 /**
  * @brief Create a new MygramDB client
  *
@@ -191,6 +494,48 @@ int mygramclient_count_advanced(MygramClient_C* client, const char* table, const
  */
 int mygramclient_get(MygramClient_C* client, const char* table, const char* primary_key, MygramDocument_C** doc);
 
+/**
+ * @brief Get selected fields of many documents as columns
+ *
+ * @param client Client handle
+ * @param table Table name
+ * @param primary_keys Array of primary keys
+ * @param key_count Number of primary keys
+ * @param fields Array of field names
+ * @param field_count Number of field names
+ * @param result Output columnar result (caller must free with mygramclient_free_columnar_result)
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_get_columns(MygramClient_C* client, const char* table, const char** primary_keys, size_t key_count,
+                             const char** fields, size_t field_count, MygramColumnarResult_C** result);
+
+/**
+ * @brief Declare the filter field types of a table
+ *
+ * Replaces any declared or learned schema of the table. A field_count of 0
+ * drops the table's schema.
+ *
+ * @param client Client handle
+ * @param table Table name
+ * @param field_names Array of field names
+ * @param field_types Array of MygramFieldType_C values
+ * @param field_count Number of fields
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_set_field_schema(MygramClient_C* client, const char* table, const char** field_names,
+                                  const int* field_types, size_t field_count);
+
+/**
+ * @brief Get the declared or learned field schema of a table
+ *
+ * @param client Client handle
+ * @param table Table name
+ * @param schema Output schema, empty if the table has none
+ *               (caller must free with mygramclient_free_field_schema)
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_get_field_schema(MygramClient_C* client, const char* table, MygramFieldSchema_C** schema);
+
 /**
  * @brief Get server information
  *
@@ -261,6 +606,522 @@ int mygramclient_debug_on(MygramClient_C* client);
  */
 int mygramclient_debug_off(MygramClient_C* client);
 
+/**
+ * @brief Create a background INFO poller with its own connection
+ *
+ * @param config Connection configuration
+ * @param interval_ms Delay between polls (0 for default: 1000)
+ * @return Poller handle, or NULL on error
+ */
+MygramInfoPoller_C* mygramclient_info_poller_create(const MygramClientConfig_C* config, uint32_t interval_ms);
+
+/**
+ * @brief Stop and destroy an INFO poller
+ *
+ * @param poller Poller handle
+ */
+void mygramclient_info_poller_destroy(MygramInfoPoller_C* poller);
+
+/**
+ * @brief Poll once synchronously, then keep polling in the background
+ *
+ * @param poller Poller handle
+ * @return 0 on success, -1 if the first poll failed
+ */
+int mygramclient_info_poller_start(MygramInfoPoller_C* poller);
+
+/**
+ * @brief Stop polling (the latest snapshot stays available)
+ *
+ * @param poller Poller handle
+ */
+void mygramclient_info_poller_stop(MygramInfoPoller_C* poller);
+
+/**
+ * @brief Refresh the snapshot now, outside the schedule
+ *
+ * @param poller Poller handle
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_info_poller_poll_now(MygramInfoPoller_C* poller);
+
+/**
+ * @brief Get the latest cached snapshot
+ *
+ * @param poller Poller handle
+ * @param info Output server info, NULL before the first successful poll
+ *             (caller must free with mygramclient_free_server_info)
+ * @param captured_at_ms Output capture time in ms since Unix epoch (can be NULL)
+ * @param sequence Output snapshot sequence number (can be NULL)
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_info_poller_latest(MygramInfoPoller_C* poller, MygramServerInfo_C** info, int64_t* captured_at_ms,
+                                    uint64_t* sequence);
+
+/**
+ * @brief Get the error of the most recent poll
+ *
+ * @param poller Poller handle
+ * @return Error message, empty if the last poll succeeded (valid until the next call)
+ */
+const char* mygramclient_info_poller_get_last_error(const MygramInfoPoller_C* poller);
+
+/**
+ * @brief Create a server metrics collector with its own connection
+ *
+ * @param config Connection configuration
+ * @param interval_ms Delay between samples (0 for default: 1000)
+ * @param window_seconds Rolling window lengths (NULL for default: 60, 300, 900)
+ * @param window_count Number of windows
+ * @return Collector handle, or NULL on error
+ */
+MygramMetricsCollector_C* mygramclient_metrics_collector_create(const MygramClientConfig_C* config,
+                                                                uint32_t interval_ms, const uint32_t* window_seconds,
+                                                                size_t window_count);
+
+/**
+ * @brief Stop and destroy a metrics collector
+ *
+ * @param collector Collector handle
+ */
+void mygramclient_metrics_collector_destroy(MygramMetricsCollector_C* collector);
+
+/**
+ * @brief Take the first sample, then keep sampling in the background
+ *
+ * @param collector Collector handle
+ * @return 0 on success, -1 if the first sample failed
+ */
+int mygramclient_metrics_collector_start(MygramMetricsCollector_C* collector);
+
+/**
+ * @brief Stop sampling (collected samples are kept)
+ *
+ * @param collector Collector handle
+ */
+void mygramclient_metrics_collector_stop(MygramMetricsCollector_C* collector);
+
+/**
+ * @brief Compute metrics from the retained samples
+ *
+ * @param collector Collector handle
+ * @param metrics Output metrics (caller must free with mygramclient_free_server_metrics)
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_metrics_collector_get(MygramMetricsCollector_C* collector, MygramServerMetrics_C** metrics);
+
+/**
+ * @brief Get the error of the most recent sample attempt
+ *
+ * @param collector Collector handle
+ * @return Error message, empty if the last sample succeeded (valid until the next call)
+ */
+const char* mygramclient_metrics_collector_get_last_error(const MygramMetricsCollector_C* collector);
+
+/**
+ * @brief Create a thread-safe LRU cache of parsed search expressions
+ *
+ * @param capacity Maximum entries (0 disables caching)
+ * @return Cache handle, or NULL on error
+ */
+MygramExpressionCache_C* mygramclient_expression_cache_create(size_t capacity);
+
+/**
+ * @brief Destroy an expression cache
+ *
+ * @param cache Cache handle
+ */
+void mygramclient_expression_cache_destroy(MygramExpressionCache_C* cache);
+
+/**
+ * @brief Parse a search expression, using the cache when possible
+ *
+ * Parse errors are reported in the result's error field, not the return value.
+ *
+ * @param cache Cache handle
+ * @param expression Web-style search expression
+ * @param result Output parse result (caller must free with mygramclient_free_parsed_expression)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_expression_cache_get(MygramExpressionCache_C* cache, const char* expression,
+                                      MygramParsedExpression_C** result);
+
+/**
+ * @brief Get cache counters
+ *
+ * @param cache Cache handle
+ * @param stats Output counters
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_expression_cache_stats(const MygramExpressionCache_C* cache, MygramExpressionCacheStats_C* stats);
+
+/**
+ * @brief Change the cache capacity, evicting entries if needed
+ *
+ * @param cache Cache handle
+ * @param capacity Maximum entries (0 disables caching)
+ */
+void mygramclient_expression_cache_resize(MygramExpressionCache_C* cache, size_t capacity);
+
+/**
+ * @brief Remove all cached entries (counters are kept)
+ *
+ * @param cache Cache handle
+ */
+void mygramclient_expression_cache_clear(MygramExpressionCache_C* cache);
+
+/**
+ * @brief Create an in-process n-gram index with MygramDB search semantics
+ *
+ * @param config Index settings (NULL for NFKC, narrow width and the default n-gram sizes)
+ * @return Index handle, or NULL on error
+ */
+MygramLocalIndex_C* mygramclient_local_index_create(const MygramLocalIndexConfig_C* config);
+
+/**
+ * @brief Destroy a local index
+ *
+ * @param index Index handle
+ */
+void mygramclient_local_index_destroy(MygramLocalIndex_C* index);
+
+/**
+ * @brief Add a document, replacing any document with the same primary key
+ *
+ * @param index Index handle
+ * @param primary_key Primary key
+ * @param text Indexed text (UTF-8, need not be NUL-terminated)
+ * @param length Bytes in text
+ * @param field_keys Array of filter field names (can be NULL)
+ * @param field_values Array of filter field values (can be NULL)
+ * @param field_count Number of fields
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_local_index_add(MygramLocalIndex_C* index, const char* primary_key, const char* text, size_t length,
+                                 const char** field_keys, const char** field_values, size_t field_count);
+
+/**
+ * @brief Remove a document
+ *
+ * @param index Index handle
+ * @param primary_key Primary key
+ * @return 1 if the document was removed, 0 if it was not indexed, -1 on error
+ */
+int mygramclient_local_index_remove(MygramLocalIndex_C* index, const char* primary_key);
+
+/**
+ * @brief Search the local index (arguments as mygramclient_search_advanced, without the table)
+ *
+ * @param index Index handle
+ * @param query Search query text
+ * @param limit Maximum number of results (0 for all)
+ * @param offset Result offset for pagination
+ * @param and_terms Array of AND terms (can be NULL)
+ * @param and_count Number of AND terms
+ * @param not_terms Array of NOT terms (can be NULL)
+ * @param not_count Number of NOT terms
+ * @param filter_keys Array of filter keys (can be NULL)
+ * @param filter_values Array of filter values (can be NULL)
+ * @param filter_count Number of filters
+ * @param sort_column Field to sort by (can be NULL for primary key)
+ * @param sort_desc Sort descending (0 = ascending, 1 = descending)
+ * @param result Output search results (caller must free with mygramclient_free_search_result)
+ * @return 0 on success, -1 on error (see mygramclient_local_index_get_last_error)
+ */
+int mygramclient_local_index_search(MygramLocalIndex_C* index, const char* query, uint32_t limit, uint32_t offset,
+                                    const char** and_terms, size_t and_count, const char** not_terms,
+                                    size_t not_count, const char** filter_keys, const char** filter_values,
+                                    size_t filter_count, const char* sort_column, int sort_desc,
+                                    MygramSearchResult_C** result);
+
+/**
+ * @brief Count matching documents in the local index
+ *
+ * @param index Index handle
+ * @param query Search query text
+ * @param and_terms Array of AND terms (can be NULL)
+ * @param and_count Number of AND terms
+ * @param not_terms Array of NOT terms (can be NULL)
+ * @param not_count Number of NOT terms
+ * @param filter_keys Array of filter keys (can be NULL)
+ * @param filter_values Array of filter values (can be NULL)
+ * @param filter_count Number of filters
+ * @param count Output count
+ * @return 0 on success, -1 on error (see mygramclient_local_index_get_last_error)
+ */
+int mygramclient_local_index_count(MygramLocalIndex_C* index, const char* query, const char** and_terms,
+                                   size_t and_count, const char** not_terms, size_t not_count,
+                                   const char** filter_keys, const char** filter_values, size_t filter_count,
+                                   uint64_t* count);
+
+/**
+ * @brief Get local index counters
+ *
+ * @param index Index handle
+ * @param stats Output counters
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_local_index_stats(const MygramLocalIndex_C* index, MygramLocalIndexStats_C* stats);
+
+/**
+ * @brief Rebuild posting lists without removed documents
+ *
+ * @param index Index handle
+ */
+void mygramclient_local_index_compact(MygramLocalIndex_C* index);
+
+/**
+ * @brief Remove all documents
+ *
+ * @param index Index handle
+ */
+void mygramclient_local_index_clear(MygramLocalIndex_C* index);
+
+/**
+ * @brief Get the error of the most recent failed search or count
+ *
+ * @param index Index handle
+ * @return Error message (valid until the next call on the index)
+ */
+const char* mygramclient_local_index_get_last_error(const MygramLocalIndex_C* index);
+
+/**
+ * @brief Create an empty Bloom filter of a table's n-grams
+ *
+ * @param expected_ngrams Distinct n-grams the filter is sized for
+ * @param config Filter settings (NULL for NFKC, narrow width and the defaults)
+ * @return Filter handle, or NULL on error
+ */
+MygramNgramFilter_C* mygramclient_ngram_filter_create(size_t expected_ngrams, const MygramNgramFilterConfig_C* config);
+
+/**
+ * @brief Restore a filter from mygramclient_ngram_filter_serialize output
+ *
+ * @param data Serialized filter
+ * @param length Bytes in data
+ * @return Filter handle, or NULL if the data is not a valid filter
+ */
+MygramNgramFilter_C* mygramclient_ngram_filter_deserialize(const uint8_t* data, size_t length);
+
+/**
+ * @brief Destroy a filter (clients it was attached to keep using it)
+ *
+ * @param filter Filter handle
+ */
+void mygramclient_ngram_filter_destroy(MygramNgramFilter_C* filter);
+
+/**
+ * @brief Add the n-grams of a document text (normalized first)
+ *
+ * Must not run while a client the filter is attached to is searching.
+ *
+ * @param filter Filter handle
+ * @param text Document text (UTF-8, need not be NUL-terminated)
+ * @param length Bytes in text
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_ngram_filter_add_text(MygramNgramFilter_C* filter, const char* text, size_t length);
+
+/**
+ * @brief Add n-gram hashes of normalized text (e.g. from mygramclient_ngram_batch)
+ *
+ * @param filter Filter handle
+ * @param hashes Hashes as produced by mygramclient_hybrid_ngram_hashes
+ * @param count Number of hashes
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_ngram_filter_add_hashes(MygramNgramFilter_C* filter, const uint64_t* hashes, size_t count);
+
+/**
+ * @brief Check whether a term may match any document
+ *
+ * @param filter Filter handle
+ * @param term Search term
+ * @return 1 if it may match, 0 if an n-gram of the term was never added, -1 on error
+ */
+int mygramclient_ngram_filter_may_match(const MygramNgramFilter_C* filter, const char* term);
+
+/**
+ * @brief Get filter counters
+ *
+ * @param filter Filter handle
+ * @param stats Output counters
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_ngram_filter_stats(const MygramNgramFilter_C* filter, MygramNgramFilterStats_C* stats);
+
+/**
+ * @brief Serialize a filter
+ *
+ * @param filter Filter handle
+ * @param data Output bytes (caller must free with mygramclient_free_ngram_filter_data)
+ * @param length Output number of bytes
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_ngram_filter_serialize(const MygramNgramFilter_C* filter, uint8_t** data, size_t* length);
+
+/**
+ * @brief Attach an n-gram filter to a table of a client
+ *
+ * SEARCH/COUNT calls for the table with a positive term the filter rules
+ * out return an empty result without a round trip (counted by
+ * mygramclient_get_saved_round_trips). The client shares the filter.
+ *
+ * @param client Client handle
+ * @param table Table name
+ * @param filter Filter handle (NULL to detach)
+ * @return 0 on success, -1 on error
+ */
+int mygramclient_set_ngram_filter(MygramClient_C* client, const char* table, const MygramNgramFilter_C* filter);
+
+/**
+ * @brief Convert many web-style search expressions in one call
+ *
+ * Parse errors are reported per entry, not through the return value. Large
+ * batches are split across a few short-lived threads.
+ *
+ * @param expressions Web-style search expressions
+ * @param count Number of expressions
+ * @param max_threads Upper bound on threads (0 = default, 1 = calling thread only)
+ * @param result Output packed results (caller must free with mygramclient_free_converted_expressions)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_convert_search_expressions(const char** expressions, size_t count, size_t max_threads,
+                                            MygramConvertedExpressions_C** result);
+
+/**
+ * @brief Build the canonical SEARCH command for a query
+ *
+ * Equivalent queries (term order, duplicate terms or filters, filter order
+ * and normalization differences) give the same key, usable for result
+ * caching and for coalescing identical requests. The key is itself a valid
+ * command returning the same results.
+ *
+ * @param table Table name
+ * @param query Main search term
+ * @param and_terms Array of AND terms (can be NULL)
+ * @param and_count Number of AND terms
+ * @param not_terms Array of NOT terms (can be NULL)
+ * @param not_count Number of NOT terms
+ * @param filter_keys Array of filter keys (can be NULL)
+ * @param filter_values Array of filter values (can be NULL)
+ * @param filter_count Number of filters
+ * @param sort_column Column name for SORT clause (can be NULL for primary key)
+ * @param sort_desc Sort descending (0 = ascending, 1 = descending)
+ * @param limit Maximum results (0 = server default)
+ * @param offset Result offset
+ * @param normalization Term normalization (NULL = none)
+ * @param key Output key (caller must free with mygramclient_free_string)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_canonical_search_key(const char* table, const char* query, const char** and_terms, size_t and_count,
+                                      const char** not_terms, size_t not_count, const char** filter_keys,
+                                      const char** filter_values, size_t filter_count, const char* sort_column,
+                                      int sort_desc, uint32_t limit, uint32_t offset,
+                                      const MygramQueryNormalization_C* normalization, char** key);
+
+/**
+ * @brief Build the canonical COUNT command for a query
+ *
+ * @param table Table name
+ * @param query Main search term
+ * @param and_terms Array of AND terms (can be NULL)
+ * @param and_count Number of AND terms
+ * @param not_terms Array of NOT terms (can be NULL)
+ * @param not_count Number of NOT terms
+ * @param filter_keys Array of filter keys (can be NULL)
+ * @param filter_values Array of filter values (can be NULL)
+ * @param filter_count Number of filters
+ * @param normalization Term normalization (NULL = none)
+ * @param key Output key (caller must free with mygramclient_free_string)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_canonical_count_key(const char* table, const char* query, const char** and_terms, size_t and_count,
+                                     const char** not_terms, size_t not_count, const char** filter_keys,
+                                     const char** filter_values, size_t filter_count,
+                                     const MygramQueryNormalization_C* normalization, char** key);
+
+/**
+ * @brief Estimate the cost of a web-style search expression
+ *
+ * Splits every term into the hybrid n-grams the server looks up. Parse
+ * errors are reported in the result's error field, not the return value.
+ *
+ * @param expression Web-style search expression
+ * @param config Estimation settings (NULL for defaults)
+ * @param result Output estimate (caller must free with mygramclient_free_query_cost)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_estimate_query_cost(const char* expression, const MygramQueryCostConfig_C* config,
+                                     MygramQueryCost_C** result);
+
+/**
+ * @brief Check that a buffer is well-formed UTF-8
+ *
+ * Rejects overlong forms, surrogates, code points above U+10FFFF and truncated
+ * sequences. ASCII runs are skipped with SIMD where the CPU supports it.
+ *
+ * @param data Bytes to check
+ * @param length Number of bytes
+ * @param error_offset Set to the offset of the first ill-formed sequence (may be NULL)
+ * @return 1 if well-formed, 0 if not, -1 on invalid arguments
+ */
+int mygramclient_validate_utf8(const char* data, size_t length, size_t* error_offset);
+
+/**
+ * @brief Read the memory health of the host or, in a container, of its cgroup
+ *
+ * A caller polling this can shrink its caches on WARNING or CRITICAL and
+ * grow them back on HEALTHY.
+ *
+ * @param health Output reading (status UNKNOWN and zero sizes if memory info is unavailable)
+ * @return 0 on success, -1 on invalid arguments
+ */
+int mygramclient_get_memory_health(MygramMemoryHealth_C* health);
+
+/**
+ * @brief Hash the n-grams of a text with a rolling 64-bit hash
+ *
+ * @param text UTF-8 text (should be normalized)
+ * @param length Text length in bytes
+ * @param ngram_size N-gram size
+ * @param hashes Output hashes, NULL when there are none (caller must free with mygramclient_free_hashes)
+ * @param count Output number of hashes
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_ngram_hashes(const char* text, size_t length, int ngram_size, uint64_t** hashes, size_t* count);
+
+/**
+ * @brief Hash the hybrid n-grams of a text with a rolling 64-bit hash
+ *
+ * @param text UTF-8 text (should be normalized)
+ * @param length Text length in bytes
+ * @param ascii_ngram_size N-gram size for non-CJK characters
+ * @param kanji_ngram_size N-gram size for CJK ideographs
+ * @param hashes Output hashes, NULL when there are none (caller must free with mygramclient_free_hashes)
+ * @param count Output number of hashes
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_hybrid_ngram_hashes(const char* text, size_t length, int ascii_ngram_size, int kanji_ngram_size,
+                                     uint64_t** hashes, size_t* count);
+
+/**
+ * @brief Normalize and split a batch of documents into hybrid n-grams
+ *
+ * Documents are passed back to back in one buffer. Large batches are
+ * spread over a few short-lived threads that balance uneven documents by
+ * work stealing. Packed outputs are limited to 4 GiB per batch.
+ *
+ * @param data Document texts (UTF-8), back to back
+ * @param offsets count + 1 byte offsets into data; document i is data[offsets[i], offsets[i + 1])
+ * @param count Number of documents
+ * @param config Batch settings (NULL for defaults)
+ * @param result Output packed results (caller must free with mygramclient_free_ngram_batch)
+ * @return 0 on success, -1 on invalid arguments or allocation failure
+ */
+int mygramclient_ngram_batch(const char* data, const uint32_t* offsets, size_t count,
+                             const MygramNgramBatchConfig_C* config, MygramNgramBatch_C** result);
+
 /**
  * @brief Get last error message
  *
@@ -269,6 +1130,16 @@ int mygramclient_debug_off(MygramClient_C* client);
  */
 const char* mygramclient_get_last_error(const MygramClient_C* client);
 
+/**
+ * @brief Get the number of SEARCH/COUNT calls answered without the server
+ *
+ * Counts queries answered by analyze_queries or an attached n-gram filter.
+ *
+ * @param client Client handle
+ * @return Round trips saved so far (0 for an invalid handle)
+ */
+uint64_t mygramclient_get_saved_round_trips(const MygramClient_C* client);
+
 /**
  * @brief Free search result
  *
@@ -283,6 +1154,27 @@ void mygramclient_free_search_result(MygramSearchResult_C* result);
  */
 void mygramclient_free_document(MygramDocument_C* doc);
 
+/**
+ * @brief Free columnar result
+ *
+ * @param result Columnar result to free
+ */
+void mygramclient_free_columnar_result(MygramColumnarResult_C* result);
+
+/**
+ * @brief Free field schema
+ *
+ * @param schema Field schema to free
+ */
+void mygramclient_free_field_schema(MygramFieldSchema_C* schema);
+
+/**
+ * @brief Free serialized n-gram filter bytes
+ *
+ * @param data Bytes to free
+ */
+void mygramclient_free_ngram_filter_data(uint8_t* data);
+
 /**
  * @brief Free server info
  *
@@ -290,6 +1182,48 @@ void mygramclient_free_document(MygramDocument_C* doc);
  */
 void mygramclient_free_server_info(MygramServerInfo_C* info);
 
+/**
+ * @brief Free parsed search expression
+ *
+ * @param result Parse result to free
+ */
+void mygramclient_free_parsed_expression(MygramParsedExpression_C* result);
+
+/**
+ * @brief Free server metrics
+ *
+ * @param metrics Server metrics to free
+ */
+void mygramclient_free_server_metrics(MygramServerMetrics_C* metrics);
+
+/**
+ * @brief Free converted expression batch
+ *
+ * @param result Batch to free
+ */
+void mygramclient_free_converted_expressions(MygramConvertedExpressions_C* result);
+
+/**
+ * @brief Free query cost estimate
+ *
+ * @param result Estimate to free
+ */
+void mygramclient_free_query_cost(MygramQueryCost_C* result);
+
+/**
+ * @brief Free n-gram hashes
+ *
+ * @param hashes Hashes to free
+ */
+void mygramclient_free_hashes(uint64_t* hashes);
+
+/**
+ * @brief Free n-gram batch
+ *
+ * @param result Batch to free
+ */
+void mygramclient_free_ngram_batch(MygramNgramBatch_C* result);
+
 /**
  * @brief Free string
  *
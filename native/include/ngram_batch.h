@@ -0,0 +1,96 @@
+/**
+ * @file ngram_batch.h
+ * @brief Bulk normalization and hybrid n-gram splitting of many documents
+ *
+ * Repeats the server's ingest-side split (normalize, then
+ * utils::GenerateHybridNgrams) over a batch of documents on several
+ * threads, for tools that predict index size or screen content before it
+ * is loaded. Documents vary widely in length, so the batch is scheduled
+ * with utils::ParallelForStealing rather than split evenly.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "string_utils.h"
+
+namespace mygramdb::utils {
+
+/**
+ * @brief What a batch produces per document besides its n-gram count
+ */
+enum class NgramBatchOutput : uint8_t {
+  kCounts,  // N-gram counts only
+  kHashes,  // 64-bit n-gram hashes (see HashNgram)
+  kNgrams   // N-gram text
+};
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Batch settings
+ *
+ * The n-gram sizes and normalization must match the server's configuration
+ * for the results to match what the server indexes.
+ */
+struct NgramBatchOptions {
+  Normalizer normalizer{false, WidthMode::kKeep, false};  // Applied to each document first
+  int ascii_ngram_size = 2;                               // Server's ngram_size for non-CJK text
+  int kanji_ngram_size = 1;                               // Server's kanji_ngram_size
+  NgramBatchOutput output = NgramBatchOutput::kCounts;    // What to produce
+  bool distinct = false;                                  // Keep only the first occurrence in each document
+  size_t max_threads = 0;                                 // Upper bound on threads (0 = default)
+};
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief N-grams of a batch of documents, packed into flat buffers
+ *
+ * Document i owns entries [document_offsets[i], document_offsets[i + 1]) of
+ * hashes (kHashes) or of the n-grams (kNgrams). N-gram j is
+ * data[ngram_offsets[j], ngram_offsets[j + 1]).
+ */
+struct NgramBatch {
+  std::vector<uint32_t> counts;            // N-grams of each document
+  std::vector<uint32_t> document_offsets;  // Size() + 1 entry offsets (kHashes, kNgrams)
+  std::vector<uint64_t> hashes;            // Hashes of all documents, in order (kHashes)
+  std::string data;                        // N-gram text, back to back (kNgrams)
+  std::vector<uint32_t> ngram_offsets;     // N-grams + 1 byte offsets into data (kNgrams)
+
+  [[nodiscard]] size_t Size() const { return counts.size(); }
+
+  /**
+   * @brief Text of one n-gram (kNgrams)
+   */
+  [[nodiscard]] std::string_view Ngram(size_t index) const {
+    return std::string_view(data).substr(ngram_offsets[index], ngram_offsets[index + 1] - ngram_offsets[index]);
+  }
+};
+
+// Batches smaller than this per worker are processed on the calling thread
+inline constexpr size_t kMinDocumentsPerWorker = 64;
+
+// Documents a worker claims at a time
+inline constexpr size_t kDocumentsPerBlock = 16;
+
+/**
+ * @brief Normalize and split many documents in one call
+ *
+ * Equivalent to normalizing each document and calling
+ * GenerateHybridNgramViews or GenerateHybridNgramHashes on it, with the
+ * results packed in input order. Packed outputs are limited to 4 GiB per
+ * batch; split larger inputs into several batches.
+ *
+ * @param documents Document texts (UTF-8)
+ * @param options Normalization, n-gram sizes and output
+ * @return Packed results
+ */
+NgramBatch GenerateNgramBatch(const std::vector<std::string_view>& documents, const NgramBatchOptions& options);
+
+}  // namespace mygramdb::utils
@@ -0,0 +1,171 @@
+/**
+ * @file ngram_filter.h
+ * @brief Bloom filter of a table's indexed n-grams for local rejection of impossible queries
+ *
+ * A document matches a term only if it contains every n-gram of the term, so
+ * a term with an n-gram that occurs in no document of the table matches
+ * nothing. NgramBloomFilter holds the n-grams of every indexed document in a
+ * few bits each; a client with a filter for a table answers such queries with
+ * an empty result instead of sending them (see MygramClient::SetNgramFilter).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "mygramclient.h"
+#include "query_canonical.h"
+#include "string_utils.h"
+
+namespace mygramdb::client {
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief N-gram filter configuration
+ *
+ * N-gram sizes and normalization must mirror the server's table settings:
+ * an n-gram the filter hashes differently from the server's is reported
+ * absent and would wrongly empty a query.
+ */
+struct NgramFilterConfig {
+  int ascii_ngram_size = 2;                                // ngram_size for non-CJK text
+  int kanji_ngram_size = 1;                                // kanji_ngram_size
+  QueryNormalization normalization{true, "narrow", false};  // Applied to documents and terms alike
+  double bits_per_ngram = 10.0;                            // ~1% false positives at the expected n-gram count
+};
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief N-gram filter counters
+ */
+struct NgramFilterStats {
+  uint64_t ngrams = 0;                // N-grams added (repeats of an n-gram count once, up to false positives)
+  size_t size_bytes = 0;              // Size of the bit array
+  uint32_t hash_count = 0;            // Bits set per n-gram
+  double false_positive_rate = 0.0;   // Estimated from the fraction of bits set
+};
+
+/**
+ * @brief Blocked Bloom filter over 64-bit n-gram hashes (see utils::HashNgram)
+ *
+ * Each n-gram sets a few bits within one 64-byte block, so a lookup touches
+ * a single cache line. The filter never reports an added n-gram as absent;
+ * an absent n-gram is reported present with the false positive rate, which
+ * only costs the round trip the filter would have saved.
+ *
+ * Build it from every document of the table, e.g. a full export of the
+ * table's text columns or a NgramBatch over it, and keep it current by
+ * adding inserted and updated documents as they are written. Deleted
+ * documents can stay: their n-grams only raise the false positive rate. A
+ * filter built from a sample would miss the rare n-grams and wrongly empty
+ * queries for them.
+ *
+ * Serialize() produces a compact byte string, so a filter built once (for
+ * instance next to a snapshot) can be shipped to many clients.
+ *
+ * Lookups may run concurrently; additions must not run concurrently with
+ * anything else.
+ *
+ * Example usage:
+ * @code
+ *   NgramBloomFilter filter(estimated_ngrams);
+ *   for (const auto& text : documents) {
+ *     filter.AddText(text);
+ *   }
+ *   client.SetNgramFilter("articles", std::make_shared<NgramBloomFilter>(std::move(filter)));
+ * @endcode
+ */
+class NgramBloomFilter {
+ public:
+  /**
+   * @brief Construct an empty filter
+   * @param expected_ngrams Distinct n-grams the filter is sized for (more raise the false positive rate)
+   * @param config N-gram sizes, normalization and bits per n-gram
+   */
+  explicit NgramBloomFilter(size_t expected_ngrams, NgramFilterConfig config = {});
+
+  /**
+   * @brief Add the n-grams of a document text (normalized first)
+   */
+  void AddText(std::string_view text);
+
+  /**
+   * @brief Add one n-gram hash, as produced by GenerateHybridNgramHashes on normalized text
+   */
+  void AddHash(uint64_t hash);
+
+  /**
+   * @brief Add n-gram hashes (e.g. the hashes of an NgramBatch)
+   */
+  void AddHashes(const uint64_t* hashes, size_t count);
+
+  /**
+   * @brief Check whether an n-gram hash may have been added
+   */
+  [[nodiscard]] bool MayContainHash(uint64_t hash) const;
+
+  /**
+   * @brief Check whether a term may match any document
+   *
+   * @param term Search term (normalized like documents)
+   * @return false if an n-gram of the term was never added; true otherwise,
+   *         including for terms too short to form an n-gram
+   */
+  [[nodiscard]] bool MayMatch(std::string_view term) const;
+
+  /**
+   * @brief Check whether a query may match any document
+   *
+   * NOT terms cannot make an empty result non-empty, so only the positive
+   * terms are checked.
+   *
+   * @param main_term Main search term
+   * @param and_terms Additional required terms
+   * @return false if some positive term cannot match
+   */
+  [[nodiscard]] bool MayMatchQuery(std::string_view main_term, const std::vector<std::string>& and_terms) const;
+
+  /**
+   * @brief Get filter counters
+   */
+  [[nodiscard]] NgramFilterStats GetStats() const;
+
+  /**
+   * @brief Get the configuration (bits_per_ngram as constructed)
+   */
+  [[nodiscard]] const NgramFilterConfig& GetConfig() const { return config_; }
+
+  /**
+   * @brief Serialize the filter (configuration and bits, little-endian)
+   */
+  [[nodiscard]] std::string Serialize() const;
+
+  /**
+   * @brief Restore a filter from Serialize() output
+   * @return Filter, or Error if the data is truncated or not a filter
+   */
+  static std::variant<NgramBloomFilter, Error> Deserialize(std::string_view data);
+
+  /**
+   * @brief Remove all n-grams (the size is kept)
+   */
+  void Clear();
+
+ private:
+  NgramBloomFilter() = default;
+
+  NgramFilterConfig config_;
+  utils::Normalizer normalizer_;
+  std::vector<uint64_t> words_;  // Bit array, kWordsPerBlock words per block
+  uint64_t ngrams_ = 0;          // AddHash calls that set a new bit
+  uint32_t hash_count_ = 1;      // Bits set per n-gram
+};
+
+}  // namespace mygramdb::client
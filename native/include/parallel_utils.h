@@ -0,0 +1,223 @@
+/**
+ * @file parallel_utils.h
+ * @brief Data-parallel loops over an index range
+ */
+
+#ifndef MYGRAMDB_UTILS_PARALLEL_UTILS_H_
+#define MYGRAMDB_UTILS_PARALLEL_UTILS_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace mygramdb::utils {
+
+// Default upper bound on workers (batches are short-lived; more threads cost more than they save)
+inline constexpr size_t kDefaultMaxParallelWorkers = 4;
+
+/**
+ * @brief Number of workers ParallelFor uses for a range
+ *
+ * @param count Number of items
+ * @param min_items_per_worker Smallest share worth a thread of its own
+ * @param max_workers Upper bound (0 = hardware concurrency, at most kDefaultMaxParallelWorkers)
+ * @return Worker count, at least 1
+ */
+inline size_t ParallelWorkerCount(size_t count, size_t min_items_per_worker, size_t max_workers = 0) {
+  if (max_workers == 0) {
+    max_workers = std::min<size_t>(std::max(1U, std::thread::hardware_concurrency()), kDefaultMaxParallelWorkers);
+  }
+  size_t by_size = min_items_per_worker == 0 ? count : count / min_items_per_worker;
+  return std::max<size_t>(1, std::min(by_size, max_workers));
+}
+
+/**
+ * @brief Run body over [0, count) split into contiguous chunks
+ *
+ * Chunk w is passed as body(w, begin, end). The calling thread runs the first
+ * chunk; the others run on short-lived threads that are joined before
+ * returning. Small ranges run inline without creating any thread. The first
+ * exception thrown by a chunk is rethrown after all chunks finish.
+ *
+ * @param count Number of items
+ * @param min_items_per_worker Smallest share worth a thread of its own
+ * @param max_workers Upper bound on workers (0 = default)
+ * @param body Callable taking (size_t worker, size_t begin, size_t end)
+ * @return Number of workers used (chunk indexes are below this)
+ */
+template <typename Body>
+size_t ParallelFor(size_t count, size_t min_items_per_worker, size_t max_workers, Body&& body) {
+  size_t workers = ParallelWorkerCount(count, min_items_per_worker, max_workers);
+  if (workers == 1) {
+    body(size_t{0}, size_t{0}, count);
+    return 1;
+  }
+
+  size_t chunk = count / workers;
+  size_t remainder = count % workers;
+  auto chunk_begin = [chunk, remainder](size_t worker) { return worker * chunk + std::min(worker, remainder); };
+
+  std::vector<std::exception_ptr> errors(workers);
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (size_t worker = 1; worker < workers; ++worker) {
+    threads.emplace_back([&, worker] {
+      try {
+        body(worker, chunk_begin(worker), chunk_begin(worker + 1));
+      } catch (...) {
+        errors[worker] = std::current_exception();
+      }
+    });
+  }
+
+  try {
+    body(size_t{0}, size_t{0}, chunk_begin(1));
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return workers;
+}
+
+namespace detail {
+
+// A range [begin, end) packed into one word, so it can be claimed from or split with a single CAS
+inline constexpr int kRangeHalfBits = 32;
+inline constexpr uint64_t kRangeHalfMask = (uint64_t{1} << kRangeHalfBits) - 1;
+inline constexpr size_t kMaxStealingCount = kRangeHalfMask;
+
+inline uint64_t PackRange(uint64_t begin, uint64_t end) { return (begin << kRangeHalfBits) | end; }
+inline uint64_t RangeBegin(uint64_t range) { return range >> kRangeHalfBits; }
+inline uint64_t RangeEnd(uint64_t range) { return range & kRangeHalfMask; }
+
+/**
+ * @brief Move the back half of the largest other range into ranges[thief]
+ *
+ * @return False if every other range is empty
+ */
+inline bool StealHalf(std::vector<std::atomic<uint64_t>>& ranges, size_t thief) {
+  while (true) {
+    size_t victim = ranges.size();
+    uint64_t largest = 0;
+    for (size_t worker = 0; worker < ranges.size(); ++worker) {
+      uint64_t range = ranges[worker].load(std::memory_order_acquire);
+      if (worker != thief && RangeEnd(range) - RangeBegin(range) > largest) {
+        largest = RangeEnd(range) - RangeBegin(range);
+        victim = worker;
+      }
+    }
+    if (victim == ranges.size()) {
+      return false;
+    }
+
+    uint64_t range = ranges[victim].load(std::memory_order_acquire);
+    while (RangeBegin(range) < RangeEnd(range)) {
+      uint64_t remaining = RangeEnd(range) - RangeBegin(range);
+      uint64_t split = RangeEnd(range) - (remaining + 1) / 2;
+      if (ranges[victim].compare_exchange_weak(range, PackRange(RangeBegin(range), split),
+                                               std::memory_order_acq_rel, std::memory_order_acquire)) {
+        // Only this thread stores into its own empty range; others skip it until then
+        ranges[thief].store(PackRange(split, RangeEnd(range)), std::memory_order_release);
+        return true;
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Run body over [0, count) in blocks, balancing uneven items by work stealing
+ *
+ * For items whose cost varies widely (documents of very different sizes),
+ * where the even split of ParallelFor would leave workers idle. Each worker
+ * starts with a contiguous share and takes blocks of at most `grain` items
+ * from its front; a worker whose share is used up steals the back half of
+ * the largest remaining share. Blocks are passed as body(worker, begin, end),
+ * many per worker and in no particular order, but two calls with the same
+ * worker never run at the same time. Threads, small ranges and exceptions
+ * are handled as in ParallelFor.
+ *
+ * @param count Number of items
+ * @param min_items_per_worker Smallest share worth a thread of its own
+ * @param grain Items per block (at least 1)
+ * @param max_workers Upper bound on workers (0 = default)
+ * @param body Callable taking (size_t worker, size_t begin, size_t end)
+ * @return Number of workers used (worker indexes are below this)
+ */
+template <typename Body>
+size_t ParallelForStealing(size_t count, size_t min_items_per_worker, size_t grain, size_t max_workers,
+                           Body&& body) {
+  size_t workers = ParallelWorkerCount(count, min_items_per_worker, max_workers);
+  if (workers == 1 || count > detail::kMaxStealingCount) {
+    return ParallelFor(count, min_items_per_worker, max_workers, body);
+  }
+  grain = std::max<size_t>(grain, 1);
+
+  std::vector<std::atomic<uint64_t>> ranges(workers);
+  for (size_t worker = 0; worker < workers; ++worker) {
+    ranges[worker].store(detail::PackRange(count * worker / workers, count * (worker + 1) / workers),
+                         std::memory_order_relaxed);
+  }
+
+  auto run = [&](size_t worker) {
+    std::atomic<uint64_t>& own = ranges[worker];
+    do {
+      uint64_t range = own.load(std::memory_order_acquire);
+      while (detail::RangeBegin(range) < detail::RangeEnd(range)) {
+        uint64_t begin = detail::RangeBegin(range);
+        uint64_t end = std::min<uint64_t>(begin + grain, detail::RangeEnd(range));
+        if (own.compare_exchange_weak(range, detail::PackRange(end, detail::RangeEnd(range)),
+                                      std::memory_order_acq_rel, std::memory_order_acquire)) {
+          body(worker, static_cast<size_t>(begin), static_cast<size_t>(end));
+          range = own.load(std::memory_order_acquire);
+        }
+      }
+    } while (detail::StealHalf(ranges, worker));
+  };
+
+  std::vector<std::exception_ptr> errors(workers);
+  std::vector<std::thread> threads;
+  threads.reserve(workers - 1);
+  for (size_t worker = 1; worker < workers; ++worker) {
+    threads.emplace_back([&, worker] {
+      try {
+        run(worker);
+      } catch (...) {
+        errors[worker] = std::current_exception();
+      }
+    });
+  }
+
+  try {
+    run(0);
+  } catch (...) {
+    errors[0] = std::current_exception();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return workers;
+}
+
+}  // namespace mygramdb::utils
+
+#endif  // MYGRAMDB_UTILS_PARALLEL_UTILS_H_
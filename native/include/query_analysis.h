@@ -0,0 +1,84 @@
+/**
+ * @file query_analysis.h
+ * @brief Static analysis of search queries before they are sent
+ *
+ * Some queries have a known outcome without asking the server: `+foo -foo`
+ * can never match, and a query without any positive term is rejected. The
+ * analysis finds these cases (plus duplicate terms, which are harmless but
+ * wasteful) so the client can answer locally and skip the round trip.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "search_expression.h"
+
+namespace mygramdb::client {
+
+/**
+ * @brief What the client should do with a query
+ */
+enum class QueryVerdict : uint8_t {
+  kSend,    // Outcome depends on the index; send it
+  kEmpty,   // Can never match; answer with an empty result
+  kInvalid  // Server would reject it; answer with an error
+};
+
+/**
+ * @brief Analysis result
+ *
+ * Only exact term matches are compared: `+Foo -foo` is not reported as a
+ * contradiction since the server's normalization is unknown here.
+ */
+struct QueryAnalysis {
+  QueryVerdict verdict = QueryVerdict::kSend;  // Suggested handling
+  std::string reason;                          // Why the query is empty or invalid
+  std::vector<std::string> contradictions;     // Terms both required and excluded in one group
+  std::vector<std::string> duplicates;         // Terms repeated within one group
+
+  /**
+   * @brief Check if the query has to go to the server
+   */
+  [[nodiscard]] bool NeedsServer() const { return verdict == QueryVerdict::kSend; }
+};
+
+/**
+ * @brief Analyze a main term with additional AND/NOT terms
+ * @param query Main search term
+ * @param and_terms Additional required terms
+ * @param not_terms Excluded terms
+ * @return Analysis result
+ */
+QueryAnalysis AnalyzeTerms(const std::string& query, const std::vector<std::string>& and_terms,
+                           const std::vector<std::string>& not_terms);
+
+/**
+ * @brief Analyze a parsed query AST
+ *
+ * An AND group is empty if it requires and excludes the same term or has an
+ * empty child; an OR group is empty if all of its children are. A query
+ * whose top level has no positive part is invalid.
+ *
+ * @param ast Query AST
+ * @return Analysis result
+ */
+QueryAnalysis AnalyzeQueryAst(const QueryAst& ast);
+
+/**
+ * @brief Parse and analyze a web-style search expression
+ * @param expression Web-style search expression
+ * @return Analysis result (kInvalid with the parse error if it does not parse)
+ */
+QueryAnalysis AnalyzeExpression(const std::string& expression);
+
+/**
+ * @brief Remove repeated terms, keeping the first occurrence of each
+ * @param terms Terms (modified in place)
+ * @return Number of terms removed
+ */
+size_t DedupeTerms(std::vector<std::string>& terms);
+
+}  // namespace mygramdb::client
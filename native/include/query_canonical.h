@@ -0,0 +1,127 @@
+/**
+ * @file query_canonical.h
+ * @brief Canonical query forms and command keys
+ *
+ * "+foo +bar", "bar foo" and "foo  bar" all ask the server for the same
+ * documents, yet naive command building produces three different strings.
+ * Canonicalization sorts and dedupes the AND/NOT term sets (and filters) so
+ * equivalent queries map to one command key, suitable for result caching and
+ * for coalescing concurrent identical requests.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace mygramdb::client {
+
+/**
+ * @brief Client-side term normalization
+ *
+ * Only enable what the server's own text normalization does; otherwise one
+ * key could merge queries the server treats differently. The defaults leave
+ * terms untouched.
+ */
+struct QueryNormalization {
+  bool nfkc = false;           // Apply NFKC normalization
+  std::string width = "keep";  // Width conversion: "keep", "narrow", or "wide"
+  bool lower = false;          // Convert to lowercase
+
+  /**
+   * @brief Check if normalization leaves terms unchanged
+   */
+  [[nodiscard]] bool IsIdentity() const { return !nfkc && width == "keep" && !lower; }
+};
+
+/**
+ * @brief Search terms in canonical order
+ *
+ * Positive terms are sorted and deduplicated; the smallest becomes the main
+ * term. Excluded terms are sorted and deduplicated.
+ */
+struct CanonicalTerms {
+  std::string main_term;               // Smallest positive term
+  std::vector<std::string> and_terms;  // Remaining positive terms (sorted)
+  std::vector<std::string> not_terms;  // Excluded terms (sorted)
+};
+
+/**
+ * @brief Normalize a single term
+ * @param term Search term
+ * @param normalization Normalization settings
+ * @return Normalized term
+ */
+std::string NormalizeQueryTerm(const std::string& term, const QueryNormalization& normalization);
+
+/**
+ * @brief Canonicalize a main term with additional AND/NOT terms
+ *
+ * The main term is just another required term, so it takes part in sorting.
+ * Empty terms are dropped (main_term stays empty if no positive term is left).
+ *
+ * @param query Main search term
+ * @param and_terms Additional required terms
+ * @param not_terms Excluded terms
+ * @param normalization Normalization settings
+ * @return Canonical terms
+ */
+CanonicalTerms CanonicalizeTerms(const std::string& query, const std::vector<std::string>& and_terms,
+                                 const std::vector<std::string>& not_terms,
+                                 const QueryNormalization& normalization = {});
+
+/**
+ * @brief Canonicalize a web-style search expression
+ *
+ * Expressions using OR or grouping have no term-list form and are rejected.
+ *
+ * @param expression Web-style search expression
+ * @param normalization Normalization settings
+ * @return Canonical terms or error message
+ */
+std::variant<CanonicalTerms, std::string> CanonicalizeExpression(const std::string& expression,
+                                                                  const QueryNormalization& normalization = {});
+
+/**
+ * @brief Build a SEARCH command line (without the CRLF terminator)
+ *
+ * Terms and filter values containing whitespace or quotes are double-quoted.
+ * SORT DESC on the primary key is the server default and is omitted.
+ */
+std::string BuildSearchCommand(const std::string& table, const std::string& query,
+                               const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                               const std::vector<std::pair<std::string, std::string>>& filters,
+                               const std::string& sort_column, bool sort_desc, uint32_t limit, uint32_t offset);
+
+/**
+ * @brief Build a COUNT command line (without the CRLF terminator)
+ */
+std::string BuildCountCommand(const std::string& table, const std::string& query,
+                              const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                              const std::vector<std::pair<std::string, std::string>>& filters);
+
+/**
+ * @brief Build the canonical SEARCH command for a query
+ *
+ * Equivalent queries (term order, duplicate terms or filters, filter order,
+ * and normalization differences) produce the same string. The key is itself a
+ * valid command returning the same results as the original.
+ */
+std::string CanonicalSearchKey(const std::string& table, const std::string& query,
+                               const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                               const std::vector<std::pair<std::string, std::string>>& filters,
+                               const std::string& sort_column, bool sort_desc, uint32_t limit, uint32_t offset,
+                               const QueryNormalization& normalization = {});
+
+/**
+ * @brief Build the canonical COUNT command for a query
+ */
+std::string CanonicalCountKey(const std::string& table, const std::string& query,
+                              const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                              const std::vector<std::pair<std::string, std::string>>& filters,
+                              const QueryNormalization& normalization = {});
+
+}  // namespace mygramdb::client
@@ -0,0 +1,114 @@
+/**
+ * @file query_cost.h
+ * @brief Query cost estimation from hybrid n-gram expansion
+ *
+ * The server splits every term into hybrid n-grams (see
+ * utils::GenerateHybridNgrams) and looks up one posting list per n-gram, so
+ * a long term or a long OR chain can expand into hundreds of lookups. The
+ * estimator repeats that split on the client and classifies the query before
+ * it is sent, so callers can route, deprioritize or reject expensive queries.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include "query_canonical.h"
+#include "search_expression.h"
+
+namespace mygramdb::client {
+
+/**
+ * @brief Coarse cost class of a query
+ */
+enum class QueryCostClass : uint8_t {
+  kLow,       // Below moderate_ngrams
+  kModerate,  // At least moderate_ngrams
+  kHigh,      // At least high_ngrams
+  kExcessive  // At least excessive_ngrams
+};
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Cost estimation settings
+ *
+ * The n-gram sizes and normalization must match the server's configuration
+ * for the counts to match what the server looks up.
+ */
+struct QueryCostConfig {
+  int ascii_ngram_size = 2;          // Server's ngram_size for non-CJK text
+  int kanji_ngram_size = 1;          // Server's kanji_ngram_size
+  QueryNormalization normalization;  // Applied to each term before the split
+  uint32_t moderate_ngrams = 32;     // Total n-grams for kModerate
+  uint32_t high_ngrams = 128;        // Total n-grams for kHigh
+  uint32_t excessive_ngrams = 512;   // Total n-grams for kExcessive
+};
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Cost of one term
+ */
+struct TermCost {
+  std::string term;       // Term text as parsed (phrases without quotes)
+  uint32_t ngrams = 0;    // N-grams the term expands into
+  bool phrase = false;    // Quoted phrase
+  bool excluded = false;  // Under a NOT
+  bool optional = false;  // Under an OR (one alternative among others)
+};
+
+/**
+ * @brief Estimated cost of a query
+ */
+struct QueryCost {
+  std::vector<TermCost> terms;                       // Every term and phrase, in expression order
+  uint64_t total_ngrams = 0;                         // Sum of n-grams over all terms (posting list lookups)
+  uint64_t distinct_ngrams = 0;                      // Distinct n-grams over the whole query
+  uint32_t max_term_ngrams = 0;                      // N-grams of the most expensive term
+  uint32_t short_terms = 0;                          // Terms too short to produce any n-gram
+  QueryCostClass cost_class = QueryCostClass::kLow;  // Class of total_ngrams
+};
+
+/**
+ * @brief Count the hybrid n-grams of a term
+ * @param term Term text
+ * @param config N-gram sizes and normalization
+ * @return Number of n-grams, as produced by utils::GenerateHybridNgrams
+ */
+uint32_t CountTermNgrams(const std::string& term, const QueryCostConfig& config);
+
+/**
+ * @brief Estimate the cost of a parsed query
+ * @param ast Non-empty query AST
+ * @param config Estimation settings
+ * @return Estimated cost
+ */
+QueryCost EstimateQueryCost(const QueryAst& ast, const QueryCostConfig& config = {});
+
+/**
+ * @brief Parse a web-style search expression and estimate its cost
+ * @param expression Web-style search expression
+ * @param config Estimation settings
+ * @return Estimated cost, or parse error message
+ */
+std::variant<QueryCost, std::string> EstimateExpressionCost(const std::string& expression,
+                                                            const QueryCostConfig& config = {});
+
+/**
+ * @brief Classify a total n-gram count
+ * @param total_ngrams Total n-grams of a query
+ * @param config Class thresholds
+ * @return Cost class
+ */
+QueryCostClass ClassifyQueryCost(uint64_t total_ngrams, const QueryCostConfig& config);
+
+/**
+ * @brief Get the name of a cost class ("low", "moderate", "high", "excessive")
+ */
+const char* QueryCostClassName(QueryCostClass cost_class);
+
+}  // namespace mygramdb::client
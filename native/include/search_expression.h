@@ -16,15 +16,17 @@
  * - `golang tutorial` → `golang AND tutorial` (implicit AND)
  * - `"machine learning" tutorial` → `"machine learning" AND tutorial` (phrase search)
  * - `golang -old` → `golang AND NOT old`
- * - `python OR ruby` → `(python OR ruby)`
+ * - `python OR ruby` → `python OR ruby`
  * - `golang +(tutorial OR guide)` → `golang AND (tutorial OR guide)`
  * - `機械学習　チュートリアル` → `機械学習 AND チュートリアル` (full-width space)
  */
 
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -57,6 +59,147 @@ struct SearchExpression {
   [[nodiscard]] std::string ToQueryString() const;
 };
 
+/**
+ * @brief Query AST node kinds
+ */
+enum class QueryNodeKind : uint8_t {
+  kTerm,    // Single term
+  kPhrase,  // Quoted phrase
+  kAnd,     // All children must match
+  kOr,      // Any child must match
+  kNot      // Child must not match
+};
+
+/**
+ * @brief Query AST node
+ *
+ * Nodes live in the QueryAst arena and refer to each other by index. Term and
+ * phrase text is stored in the AST's shared text buffer.
+ */
+struct QueryNode {
+  static constexpr uint32_t kNone = UINT32_MAX;  // "No node" index
+
+  QueryNodeKind kind = QueryNodeKind::kTerm;  // Node kind
+  uint32_t text_offset = 0;                   // Term/Phrase: start of text in the text buffer
+  uint32_t text_length = 0;                   // Term/Phrase: text length in bytes
+  uint32_t first_child = kNone;               // And/Or/Not: first child
+  uint32_t next_sibling = kNone;              // Next child of the same parent
+  uint32_t child_count = 0;                   // And/Or/Not: number of children
+};
+
+/**
+ * @brief Arena-allocated boolean query tree
+ *
+ * All nodes are stored in one vector and all term text in one string, so an
+ * AST costs two allocations regardless of size and can be copied or cached
+ * cheaply. Children are built before their parent; the builder methods
+ * flatten nested groups of the same kind and collapse single-child groups.
+ *
+ * Example usage:
+ * @code
+ *   auto result = ParseQueryAst("golang (tutorial OR guide) -old");
+ *   const auto& ast = std::get<QueryAst>(result);
+ *   for (uint32_t child = ast.GetNode(ast.Root()).first_child; child != QueryNode::kNone;
+ *        child = ast.GetNode(child).next_sibling) {
+ *     // ...
+ *   }
+ *   std::string query = ast.ToQueryString();  // golang AND (tutorial OR guide) AND NOT old
+ * @endcode
+ */
+class QueryAst {
+ public:
+  /**
+   * @brief Add a term or phrase node
+   * @param text Term text (unquoted)
+   * @param phrase True for a quoted phrase
+   * @return Node index
+   */
+  uint32_t AddTerm(std::string_view text, bool phrase = false);
+
+  /**
+   * @brief Add an AND or OR node over existing nodes
+   * @param kind QueryNodeKind::kAnd or QueryNodeKind::kOr
+   * @param children Child node indexes (must not already have a parent)
+   * @return Node index (the child itself when there is only one)
+   */
+  uint32_t AddGroup(QueryNodeKind kind, const std::vector<uint32_t>& children);
+
+  /**
+   * @brief Add a NOT node over an existing node
+   * @param child Child node index (double negation is removed)
+   * @return Node index
+   */
+  uint32_t AddNot(uint32_t child);
+
+  /**
+   * @brief Set the root node
+   */
+  void SetRoot(uint32_t root) { root_ = root; }
+
+  /**
+   * @brief Get the root node index (QueryNode::kNone when empty)
+   */
+  [[nodiscard]] uint32_t Root() const { return root_; }
+
+  /**
+   * @brief Check if the AST has no root
+   */
+  [[nodiscard]] bool Empty() const { return root_ == QueryNode::kNone; }
+
+  /**
+   * @brief Get a node by index
+   */
+  [[nodiscard]] const QueryNode& GetNode(uint32_t index) const { return nodes_[index]; }
+
+  /**
+   * @brief Get the number of nodes in the arena (including unreachable ones)
+   */
+  [[nodiscard]] size_t NodeCount() const { return nodes_.size(); }
+
+  /**
+   * @brief Get the text of a term or phrase node
+   */
+  [[nodiscard]] std::string_view GetText(uint32_t index) const;
+
+  /**
+   * @brief Serialize the whole tree to the server query syntax
+   */
+  [[nodiscard]] std::string ToQueryString() const;
+
+  /**
+   * @brief Serialize one subtree to the server query syntax
+   * @param index Subtree root
+   */
+  [[nodiscard]] std::string ToQueryString(uint32_t index) const;
+
+ private:
+  void AppendQuery(uint32_t index, bool parenthesize_groups, std::string& out) const;
+
+  std::vector<QueryNode> nodes_;      // Node arena
+  std::string text_;                  // Term text buffer
+  uint32_t root_ = QueryNode::kNone;  // Root node
+};
+
+/**
+ * @brief Parse web-style search expression into a query AST
+ *
+ * Grammar (single pass, one token of lookahead):
+ * ```
+ * query   := and
+ * and     := or { or }                  (implicit AND)
+ * or      := unary { "OR" unary }
+ * unary   := [ "+" | "-" ] primary
+ * primary := term | "phrase" | "(" and ")"
+ * ```
+ *
+ * `OR` binds tighter than the implicit AND, so `golang tutorial OR guide`
+ * means `golang AND (tutorial OR guide)`.
+ *
+ * @param expression Web-style search expression
+ * @return Query AST, or error message
+ */
+std::variant<QueryAst, std::string> ParseQueryAst(const std::string& expression);
+
 /**
  * @brief Parse web-style search expression
  *
@@ -66,19 +209,22 @@ struct SearchExpression {
  * Operator precedence (highest to lowest):
  * 1. Parentheses `()`
  * 2. Prefix operators `+` and `-`
- * 3. Implicit AND (space between required terms)
- * 4. `OR` operator
+ * 3. `OR` operator
+ * 4. Implicit AND (space between terms)
+ *
+ * Top-level terms and phrases become required terms, top-level negated terms
+ * become excluded terms, and everything else (OR groups, negated groups) is
+ * serialized into raw_expression.
  *
  * Examples:
  * ```cpp
  * auto expr = ParseSearchExpression("+golang tutorial");
- * // expr.required_terms = ["golang"]
- * // expr.optional_terms = ["tutorial"]
+ * // expr.required_terms = ["golang", "tutorial"]
  *
  * auto expr = ParseSearchExpression("+golang +(tutorial OR guide) -old");
  * // expr.required_terms = ["golang"]
  * // expr.excluded_terms = ["old"]
- * // expr.raw_expression = "+(tutorial OR guide)"
+ * // expr.raw_expression = "tutorial OR guide"
  * ```
  *
  * @param expression Web-style search expression
@@ -86,6 +232,16 @@ struct SearchExpression {
  */
 std::variant<SearchExpression, std::string> ParseSearchExpression(const std::string& expression);
 
+/**
+ * @brief Flatten a query AST into required, excluded and raw parts
+ *
+ * Same result as ParseSearchExpression for the expression the AST was parsed from.
+ *
+ * @param ast Non-empty query AST
+ * @return Flattened expression
+ */
+SearchExpression FlattenQueryAst(const QueryAst& ast);
+
 /**
  * @brief Convert search expression directly to QueryAST-compatible string
  *
@@ -93,29 +249,83 @@ std::variant<SearchExpression, std::string> ParseSearchExpression(const std::str
  * and ToQueryString() in one call.
  *
  * Examples:
- * - `+golang tutorial` → `golang AND (tutorial)`
+ * - `+golang tutorial` → `golang AND tutorial`
  * - `+golang -old` → `golang AND NOT old`
  * - `python OR ruby` → `python OR ruby`
  * - `+golang +(tutorial OR guide)` → `golang AND (tutorial OR guide)`
+ * - `a OR b c` → `(a OR b) AND c` (OR binds tighter than the implicit AND)
+ *
+ * Whitespace-only input and a dangling operator (`a OR`, `golang -`) are
+ * errors rather than an empty query.
  *
  * @param expression Web-style search expression
  * @return QueryAST-compatible query string, or error message
  */
 std::variant<std::string, std::string> ConvertSearchExpression(const std::string& expression);
 
+/**
+ * @brief Conversion results of a batch, packed into one buffer
+ *
+ * Entry i is the query string (ok[i] == 1) or the parse error (ok[i] == 0)
+ * stored at data[offsets[i], offsets[i + 1]).
+ */
+struct ConvertedExpressions {
+  std::string data;               // Query strings and error messages, back to back
+  std::vector<uint32_t> offsets;  // Size() + 1 byte offsets into data
+  std::vector<uint8_t> ok;        // 1 if the entry converted, 0 if it holds the error
+
+  [[nodiscard]] size_t Size() const { return ok.size(); }
+
+  /**
+   * @brief Text of one entry (query string or error message)
+   */
+  [[nodiscard]] std::string_view Text(size_t index) const {
+    return std::string_view(data).substr(offsets[index], offsets[index + 1] - offsets[index]);
+  }
+};
+
+// Batches smaller than this per worker are converted on the calling thread
+inline constexpr size_t kMinExpressionsPerWorker = 256;
+
+/**
+ * @brief Convert many search expressions in one call
+ *
+ * Equivalent to calling ConvertSearchExpression on each input, with the
+ * results packed into one buffer. Large batches are split across a few
+ * short-lived threads (see utils::ParallelFor).
+ *
+ * @param expressions Web-style search expressions
+ * @param max_threads Upper bound on threads (0 = default, 1 = calling thread only)
+ * @return Packed results in input order
+ */
+ConvertedExpressions ConvertSearchExpressions(const std::vector<std::string>& expressions, size_t max_threads = 0);
+
 /**
  * @brief Simplify search expression to basic terms (for backward compatibility)
  *
  * For clients that don't support QueryAST, this extracts simple term lists.
- * Complex expressions with OR/grouping will lose semantic meaning.
+ * Expressions with OR or grouping have no such form and are rejected rather
+ * than simplified to a wider query.
  *
  * @param expression Web-style search expression
- * @param main_term Output: first required term (or first term if none required)
+ * @param main_term Output: first required term
  * @param and_terms Output: additional required terms
  * @param not_terms Output: excluded terms
- * @return true on success, false on error (check error message)
+ * @return true on success, false on a parse error, a group, or no required term
  */
 bool SimplifySearchExpression(const std::string& expression, std::string& main_term,
                               std::vector<std::string>& and_terms, std::vector<std::string>& not_terms);
 
+/**
+ * @brief Simplify an already parsed search expression to basic terms
+ *
+ * @param expr Parsed search expression
+ * @param main_term Output: first required term
+ * @param and_terms Output: additional required terms
+ * @param not_terms Output: excluded terms
+ * @return true on success, false if raw_expression is set or there is no required term
+ */
+bool SimplifySearchExpression(const SearchExpression& expr, std::string& main_term,
+                              std::vector<std::string>& and_terms, std::vector<std::string>& not_terms);
+
 }  // namespace mygramdb::client
@@ -0,0 +1,139 @@
+/**
+ * @file server_metrics.h
+ * @brief Capacity metrics derived from INFO deltas
+ *
+ * INFO reports cumulative counters (total_requests, doc_count, ...). The
+ * MetricsCollector samples them on a schedule and turns consecutive samples
+ * into rates over rolling windows, so applications can watch query load and
+ * index growth without an external scraper.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "info_poller.h"
+
+namespace mygramdb::client {
+
+/**
+ * @brief Rates over one rolling window
+ */
+struct MetricsWindow {
+  uint32_t window_seconds = 0;       // Requested window length
+  double covered_seconds = 0.0;      // Time covered by samples (shorter while warming up)
+  double requests_per_second = 0.0;  // total_requests growth rate
+  double errors_per_second = 0.0;    // total_errors growth rate (0 if not reported)
+  double error_ratio = 0.0;          // Errors per request over the window
+  double docs_per_second = 0.0;      // doc_count change rate (negative when documents are removed)
+  int64_t doc_delta = 0;             // doc_count change over the window
+  int64_t index_bytes_delta = 0;     // index_size_bytes change over the window
+};
+
+/**
+ * @brief Latest server metrics
+ */
+struct ServerMetrics {
+  int64_t captured_at_ms = 0;          // Time of the newest sample (0 before the first sample)
+  uint64_t sample_count = 0;           // Samples currently retained
+  uint64_t doc_count = 0;              // Latest doc_count
+  uint64_t index_size_bytes = 0;       // Latest index_size_bytes
+  double index_bytes_per_doc = 0.0;    // index_size_bytes / doc_count (0 when empty)
+  uint64_t active_connections = 0;     // Latest active_connections
+  bool reports_errors = false;         // INFO includes total_errors
+  uint32_t counter_resets = 0;         // Times the server counters restarted (e.g. server restart)
+  std::vector<MetricsWindow> windows;  // One entry per configured window
+};
+
+/**
+ * @brief Metrics collector configuration
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - 1, 5 and 15 minute windows
+struct MetricsCollectorConfig {
+  InfoPollerConfig poller;                                // Sampling connection and interval
+  std::vector<uint32_t> window_seconds = {60, 300, 900};  // Rolling window lengths
+};
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Samples INFO on a schedule and derives rates over rolling windows
+ *
+ * Counters that go backwards (server restart) are stitched so rates stay
+ * non-negative across the restart. Samples older than the longest window
+ * are discarded.
+ *
+ * Example usage:
+ * @code
+ *   MetricsCollectorConfig config;
+ *   config.poller.client.host = "localhost";
+ *   config.poller.interval_ms = 5000;
+ *
+ *   MetricsCollector collector(config);
+ *   collector.Start();
+ *   // ...
+ *   auto metrics = collector.GetMetrics();
+ *   std::cout << metrics.windows[0].requests_per_second << " req/s\n";
+ * @endcode
+ */
+class MetricsCollector {
+ public:
+  /**
+   * @brief Construct collector with configuration
+   * @param config Collector configuration
+   */
+  explicit MetricsCollector(MetricsCollectorConfig config);
+
+  /**
+   * @brief Destructor - stops sampling
+   */
+  ~MetricsCollector();
+
+  // Non-copyable, non-movable (owns a running poller)
+  MetricsCollector(const MetricsCollector&) = delete;
+  MetricsCollector& operator=(const MetricsCollector&) = delete;
+  MetricsCollector(MetricsCollector&&) = delete;
+  MetricsCollector& operator=(MetricsCollector&&) = delete;
+
+  /**
+   * @brief Take the first sample, then keep sampling in the background
+   * @return std::nullopt on success, error message if the first sample failed
+   */
+  std::optional<std::string> Start();
+
+  /**
+   * @brief Stop sampling (collected samples are kept)
+   */
+  void Stop();
+
+  /**
+   * @brief Check if sampling is running
+   */
+  [[nodiscard]] bool IsRunning() const;
+
+  /**
+   * @brief Add a sample taken elsewhere (e.g. from another InfoPoller)
+   * @param snapshot INFO snapshot; samples must arrive in capture order
+   */
+  void Record(const InfoSnapshot& snapshot);
+
+  /**
+   * @brief Compute metrics from the retained samples
+   */
+  [[nodiscard]] ServerMetrics GetMetrics() const;
+
+  /**
+   * @brief Get the error of the most recent sample attempt
+   * @return Error message (empty if the last sample succeeded)
+   */
+  [[nodiscard]] std::string GetLastError() const;
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace mygramdb::client
@@ -5,17 +5,77 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mygramdb::utils {
 
+/**
+ * @brief Width conversion applied by normalization
+ */
+enum class WidthMode : uint8_t {
+  kKeep,    // No conversion
+  kNarrow,  // Full-width to half-width
+  kWide     // Half-width to full-width
+};
+
+/**
+ * @brief Parse a width option ("narrow", "wide"; anything else keeps the width)
+ */
+WidthMode ParseWidthMode(std::string_view width);
+
+/**
+ * @brief Reusable text normalizer for one configuration
+ *
+ * Gives the same result as NormalizeText with the same options, without the
+ * per-call setup: the width option is parsed once, ICU transliterators are
+ * created once per thread and reused (a transliterator must not be used by
+ * two threads at a time, so each thread gets its own), and ASCII-only text
+ * that normalization cannot change except for case skips ICU entirely.
+ * Without ICU, NormalizeTextBuiltin is used. A Normalizer has no mutable
+ * state and can be shared between threads.
+ */
+class Normalizer {
+ public:
+  /**
+   * @param nfkc Apply NFKC normalization
+   * @param width Width conversion
+   * @param lower Convert to lowercase
+   */
+  explicit Normalizer(bool nfkc = true, WidthMode width = WidthMode::kNarrow, bool lower = false)
+      : nfkc_(nfkc), width_(width), lower_(lower) {}
+
+  /**
+   * @brief Normalize text
+   */
+  [[nodiscard]] std::string Normalize(std::string_view text) const;
+
+  /**
+   * @brief Normalize text into out (replaced), reusing its capacity
+   */
+  void Normalize(std::string_view text, std::string& out) const;
+
+  /**
+   * @brief Check if normalization leaves every text unchanged
+   */
+  [[nodiscard]] bool IsIdentity() const { return !nfkc_ && width_ == WidthMode::kKeep && !lower_; }
+
+ private:
+  bool nfkc_;
+  WidthMode width_;
+  bool lower_;
+};
+
 /**
  * @brief Normalize text according to configuration
  *
  * Applies NFKC normalization, width conversion, and case conversion
- * Uses ICU library if available, otherwise uses simple fallback
+ * Uses ICU library if available, otherwise built-in tables generated from ICU.
+ * Use a Normalizer to normalize many texts with one configuration.
  *
  * @param text Input text
  * @param nfkc Apply NFKC normalization
@@ -26,6 +86,29 @@ namespace mygramdb::utils {
 std::string NormalizeText(const std::string& text, bool nfkc = true, const std::string& width = "narrow",
                           bool lower = false);
 
+/**
+ * @brief Normalize text with built-in tables instead of ICU
+ *
+ * The normalizer of builds without ICU. NFKC (compatibility decomposition,
+ * canonical ordering and composition), the width transliterators and
+ * root-locale lowercasing (with the final sigma rule) are replayed from
+ * tables generated from ICU by native/tools/gen_normalization_tables.cpp, so
+ * the result equals NormalizeTextICU's for the ICU version the tables came
+ * from. Ill-formed UTF-8 becomes U+FFFD, as with ICU.
+ *
+ * @param text Input text
+ * @param nfkc Apply NFKC normalization
+ * @param width Width conversion
+ * @param lower Convert to lowercase
+ * @param out Normalized text (replaced)
+ */
+void NormalizeTextBuiltin(std::string_view text, bool nfkc, WidthMode width, bool lower, std::string& out);
+
+/**
+ * @brief Append the UTF-8 encoding of a codepoint (nothing if out of range)
+ */
+void AppendUtf8(uint32_t codepoint, std::string& out);
+
 #ifdef USE_ICU
 /**
  * @brief Normalize text using ICU
@@ -63,6 +146,207 @@ std::vector<std::string> GenerateNgrams(const std::string& text, int n = 1);
 std::vector<std::string> GenerateHybridNgrams(const std::string& text, int ascii_ngram_size = 2,
                                               int kanji_ngram_size = 1);
 
+/**
+ * @brief Reusable buffers for n-gram views
+ *
+ * The *NgramViews functions return n-grams as views into the input text. When
+ * the input is not well-formed UTF-8 it is first re-encoded into `text` the
+ * way Utf8ToCodepoints/CodepointsToUtf8 would, and the views point there, so
+ * the n-grams always equal those of GenerateNgrams/GenerateHybridNgrams.
+ *
+ * Reusing one scratch object across calls avoids per-call allocations once
+ * its buffers have grown. Views stay valid until the next call with the same
+ * scratch (and while the input text is alive).
+ */
+struct NgramScratch {
+  std::vector<uint32_t> codepoints;      ///< Decoded code points
+  std::vector<size_t> offsets;           ///< Byte offset of each code point, plus the end offset
+  std::string text;                      ///< Re-encoded text (ill-formed input only)
+  std::vector<std::string_view> ngrams;  ///< N-gram views (the returned vector)
+  std::vector<uint64_t> prefix_hashes;   ///< Polynomial hash of each codepoint prefix (hash functions only)
+  std::vector<uint64_t> hash_powers;     ///< Powers of the hash base (hash functions only)
+};
+
+/**
+ * @brief Decode text into scratch.codepoints and scratch.offsets
+ *
+ * @param text UTF-8 text
+ * @param scratch Buffers to fill
+ * @return Buffer the offsets refer to: text itself, or scratch.text for ill-formed input
+ */
+std::string_view IndexCodepoints(std::string_view text, NgramScratch& scratch);
+
+/**
+ * @brief Generate n-grams as views, without allocating per n-gram
+ *
+ * @param text Input text (should be normalized)
+ * @param n N-gram size
+ * @param scratch Reusable buffers
+ * @return N-gram views (scratch.ngrams), equal to GenerateNgrams(text, n)
+ */
+const std::vector<std::string_view>& GenerateNgramViews(std::string_view text, int n, NgramScratch& scratch);
+
+/**
+ * @brief Generate hybrid n-grams as views, without allocating per n-gram
+ *
+ * @param text Input text (should be normalized)
+ * @param ascii_ngram_size N-gram size for ASCII/alphanumeric characters
+ * @param kanji_ngram_size N-gram size for CJK characters
+ * @param scratch Reusable buffers
+ * @return N-gram views (scratch.ngrams), equal to GenerateHybridNgrams(text, ...)
+ */
+const std::vector<std::string_view>& GenerateHybridNgramViews(std::string_view text, int ascii_ngram_size,
+                                                              int kanji_ngram_size, NgramScratch& scratch);
+
+/**
+ * @brief 64-bit hash of one n-gram
+ *
+ * Computed from codepoints (as decoded by Utf8ToCodepoints), not from the
+ * UTF-8 bytes. The function is fixed and unseeded, so hashes can be stored
+ * or compared across processes and match the JavaScript implementation.
+ *
+ * @param ngram N-gram text
+ * @return Hash equal to the one GenerateNgramHashes produces for the same codepoints
+ */
+uint64_t HashNgram(std::string_view ngram);
+
+/**
+ * @brief Generate n-gram hashes with a rolling hash, without building n-gram strings
+ *
+ * @param text Input text (should be normalized)
+ * @param n N-gram size
+ * @param scratch Reusable buffers
+ * @param hashes Output hashes (cleared first), one per GenerateNgrams(text, n) entry
+ */
+void GenerateNgramHashes(std::string_view text, int n, NgramScratch& scratch, std::vector<uint64_t>& hashes);
+
+/**
+ * @brief Generate hybrid n-gram hashes with a rolling hash, without building n-gram strings
+ *
+ * @param text Input text (should be normalized)
+ * @param ascii_ngram_size N-gram size for ASCII/alphanumeric characters
+ * @param kanji_ngram_size N-gram size for CJK characters
+ * @param scratch Reusable buffers
+ * @param hashes Output hashes (cleared first), one per GenerateHybridNgrams(text, ...) entry
+ */
+void GenerateHybridNgramHashes(std::string_view text, int ascii_ngram_size, int kanji_ngram_size,
+                               NgramScratch& scratch, std::vector<uint64_t>& hashes);
+
+/**
+ * @brief Normalizes a document fed in chunks, with memory bounded by the chunk size
+ *
+ * Chunks may split UTF-8 sequences anywhere. Input is held back until a
+ * boundary: ASCII whitespace or digit, hiragana, katakana, CJK ideograph or
+ * Hangul syllable. Normalization never combines these with what precedes
+ * them, and they end the context of the final sigma rule, so the text before
+ * a boundary normalizes the same on its own and the concatenated output
+ * equals Normalize() of the whole document. A run of max_pending bytes
+ * without a boundary is cut at a codepoint boundary anyway; only there can
+ * the output differ (e.g. a combining mark split from its base).
+ *
+ * Example usage:
+ * @code
+ *   StreamingNormalizer stream(Normalizer(true, WidthMode::kNarrow, true),
+ *                              [&](std::string_view text) { output << text; });
+ *   while (input.read(buffer, sizeof(buffer)) || input.gcount() > 0) {
+ *     stream.Feed({buffer, static_cast<size_t>(input.gcount())});
+ *   }
+ *   stream.Finish();
+ * @endcode
+ */
+class StreamingNormalizer {
+ public:
+  /**
+   * @brief Receives normalized text in document order (the view is valid during the call only)
+   */
+  using OutputListener = std::function<void(std::string_view normalized)>;
+
+  // NOLINTNEXTLINE(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+  static constexpr size_t kDefaultMaxPending = 64 * 1024;  // Bytes held back at most without a boundary
+
+  /**
+   * @param normalizer Normalization to apply
+   * @param listener Output callback
+   * @param max_pending Bytes held back at most while waiting for a boundary
+   */
+  StreamingNormalizer(Normalizer normalizer, OutputListener listener, size_t max_pending = kDefaultMaxPending);
+
+  /**
+   * @brief Add the next chunk; normalized text up to the last boundary is passed to the listener
+   */
+  void Feed(std::string_view chunk);
+
+  /**
+   * @brief Normalize everything held back; the stream can then take a new document
+   */
+  void Finish();
+
+  /**
+   * @brief Bytes fed but not normalized yet
+   */
+  [[nodiscard]] size_t PendingBytes() const { return pending_.size(); }
+
+ private:
+  void Flush(size_t end);
+
+  Normalizer normalizer_;
+  OutputListener listener_;
+  size_t max_pending_;
+  std::string pending_;  // Fed bytes not normalized yet
+  size_t scanned_ = 0;   // Bytes of pending_ already searched for boundaries
+  std::string output_;   // Reused output buffer
+};
+
+/**
+ * @brief Generates the n-grams of a document fed in chunks
+ *
+ * Emits the same n-grams, in the same order, as GenerateNgrams or
+ * GenerateHybridNgrams on the whole document. Chunks may split UTF-8
+ * sequences anywhere; only the last few code points (those that can still
+ * start an n-gram) and an incomplete sequence are carried to the next chunk.
+ */
+class StreamingNgramGenerator {
+ public:
+  /**
+   * @brief Receives each n-gram in text order (the view is valid during the call only)
+   */
+  using NgramListener = std::function<void(std::string_view ngram)>;
+
+  /**
+   * @brief Plain n-grams, as GenerateNgrams(text, n)
+   */
+  StreamingNgramGenerator(int n, NgramListener listener);
+
+  /**
+   * @brief Hybrid n-grams, as GenerateHybridNgrams(text, ascii_ngram_size, kanji_ngram_size)
+   */
+  StreamingNgramGenerator(int ascii_ngram_size, int kanji_ngram_size, NgramListener listener);
+
+  /**
+   * @brief Add the next chunk; every n-gram that ends in it is passed to the listener
+   */
+  void Feed(std::string_view chunk);
+
+  /**
+   * @brief End the document; the generator can then take a new one
+   */
+  void Finish();
+
+ private:
+  void Decode(bool at_end);
+  void EmitDecided(bool at_end);
+
+  bool hybrid_;
+  int ascii_ngram_size_;
+  int kanji_ngram_size_;
+  NgramListener listener_;
+  std::string pending_;               // Undecoded bytes (an incomplete sequence plus the new chunk)
+  std::string text_;                  // Bytes of the carried code points, re-encoded where ill-formed
+  std::vector<uint32_t> codepoints_;  // Carried code points
+  std::vector<size_t> offsets_;       // Offset of each carried code point in text_
+  std::vector<bool> cjk_;             // Whether each carried code point is a CJK ideograph
+};
+
 /**
  * @brief Convert UTF-8 string to codepoint vector
  *
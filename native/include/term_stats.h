@@ -0,0 +1,153 @@
+/**
+ * @file term_stats.h
+ * @brief Per-table term frequency cache for selectivity-driven term ordering
+ *
+ * The server starts an AND query from the main term's posting list, so a
+ * common main term inflates `candidates` even when another term would have
+ * narrowed the set immediately. TermStatsCache remembers how many documents
+ * each term matched (from COUNT results and DEBUG candidate counts) and puts
+ * the rarest known term first.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mygramdb::client {
+
+/**
+ * @brief Term statistics cache configuration
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - Default cache settings
+struct TermStatsConfig {
+  size_t max_terms_per_table = 4096;  // Oldest entries are dropped beyond this
+  uint32_t max_age_ms = 300000;       // Statistics older than this are ignored (0 = never expire)
+};
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Cache counters
+ */
+struct TermStatsCacheStats {
+  size_t entries = 0;     // Terms with statistics (all tables)
+  uint64_t hits = 0;      // Lookups that found fresh statistics
+  uint64_t misses = 0;    // Lookups without (fresh) statistics
+  uint64_t reorders = 0;  // Reorder() calls that changed the main term
+};
+
+/**
+ * @brief Thread-safe per-table term → document frequency cache
+ *
+ * Exact counts (single-term COUNT without filters) take precedence over
+ * candidate estimates from DEBUG output until they expire.
+ *
+ * Example usage:
+ * @code
+ *   TermStatsCache stats;
+ *   stats.RecordCount("articles", "the", 950000);
+ *   stats.RecordCount("articles", "golang", 1200);
+ *
+ *   std::string main_term = "the";
+ *   std::vector<std::string> and_terms = {"golang"};
+ *   stats.Reorder("articles", main_term, and_terms);  // main_term == "golang"
+ * @endcode
+ */
+class TermStatsCache {
+ public:
+  /**
+   * @brief Construct cache with configuration
+   * @param config Cache configuration
+   */
+  explicit TermStatsCache(TermStatsConfig config = {});
+
+  /**
+   * @brief Destructor
+   */
+  ~TermStatsCache();
+
+  // Non-copyable, non-movable (holds a lock)
+  TermStatsCache(const TermStatsCache&) = delete;
+  TermStatsCache& operator=(const TermStatsCache&) = delete;
+  TermStatsCache(TermStatsCache&&) = delete;
+  TermStatsCache& operator=(TermStatsCache&&) = delete;
+
+  /**
+   * @brief Record the exact number of documents matching a term
+   * @param table Table name
+   * @param term Search term
+   * @param count Matching documents
+   */
+  void RecordCount(const std::string& table, const std::string& term, uint64_t count);
+
+  /**
+   * @brief Record a candidate estimate for a query's main term (DEBUG candidates)
+   *
+   * Ignored while a fresh exact count exists for the term.
+   *
+   * @param table Table name
+   * @param term Main search term
+   * @param candidates Initial candidate count reported by the server
+   */
+  void RecordCandidates(const std::string& table, const std::string& term, uint64_t candidates);
+
+  /**
+   * @brief Get the known document frequency of a term
+   * @param table Table name
+   * @param term Search term
+   * @return Document frequency, or std::nullopt if unknown or expired
+   */
+  [[nodiscard]] std::optional<uint64_t> Lookup(const std::string& table, const std::string& term) const;
+
+  /**
+   * @brief Put the most selective known term first
+   *
+   * Terms are stably ordered by known frequency; terms without statistics are
+   * assumed common and keep their relative order after the known ones. The
+   * result set is unchanged since all positive terms are intersected anyway.
+   *
+   * @param table Table name
+   * @param main_term Main term (in/out)
+   * @param and_terms Additional required terms (in/out)
+   * @return true if the main term changed
+   */
+  bool Reorder(const std::string& table, std::string& main_term, std::vector<std::string>& and_terms) const;
+
+  /**
+   * @brief Get cache counters
+   */
+  [[nodiscard]] TermStatsCacheStats GetStats() const;
+
+  /**
+   * @brief Drop all statistics (counters are kept)
+   */
+  void Clear();
+
+ private:
+  class Impl;  // Forward declaration for PIMPL
+  std::unique_ptr<Impl> impl_;
+};
+
+/**
+ * @brief Simplify a search expression, choosing the most selective main term
+ *
+ * Same as SimplifySearchExpression() in search_expression.h, followed by
+ * TermStatsCache::Reorder() for the given table.
+ *
+ * @param expression Web-style search expression
+ * @param table Table the query will run against
+ * @param stats Term statistics
+ * @param main_term Output: most selective known required term
+ * @param and_terms Output: remaining required terms
+ * @param not_terms Output: excluded terms
+ * @return true on success, false if the expression is invalid or has no required term
+ */
+bool SimplifySearchExpression(const std::string& expression, const std::string& table, const TermStatsCache& stats,
+                              std::string& main_term, std::vector<std::string>& and_terms,
+                              std::vector<std::string>& not_terms);
+
+}  // namespace mygramdb::client
@@ -0,0 +1,105 @@
+/**
+ * @file utf8_decode.h
+ * @brief UTF-8 validation and decoding with a SIMD fast path for ASCII runs
+ *
+ * Runs of ASCII are skipped 32 (AVX2) or 16 (SSE2) bytes at a time, picked at
+ * runtime from the CPU's features; other targets scan 8 bytes per step with
+ * plain integer operations. Multi-byte sequences are checked against the
+ * well-formed byte sequences of the Unicode standard (Table 3-7), so overlong
+ * forms, surrogates, code points above U+10FFFF and truncated sequences are
+ * all rejected.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace mygramdb::utils {
+
+/**
+ * @brief Length of the ASCII run at the start of a buffer
+ *
+ * @param data Bytes to scan
+ * @param size Number of bytes
+ * @return Bytes before the first byte >= 0x80 (size if there is none)
+ */
+size_t AsciiPrefixLength(const char* data, size_t size);
+
+/**
+ * @brief Length of the ASCII run starting at data[0], which must be ASCII
+ *
+ * A lone ASCII character between multi-byte ones (common in mixed CJK text)
+ * is answered inline without calling the scanner.
+ *
+ * @param data Bytes to scan (size > 0)
+ * @param size Number of bytes
+ * @return Run length, at least 1
+ */
+inline size_t AsciiRunLength(const char* data, size_t size) {
+  constexpr unsigned char kFirstNonAscii = 0x80;
+  if (size < 2 || static_cast<unsigned char>(data[1]) >= kFirstNonAscii) {
+    return 1;
+  }
+  return AsciiPrefixLength(data, size);
+}
+
+/**
+ * @brief Name of the scanner AsciiPrefixLength dispatches to ("avx2", "sse2" or "scalar")
+ */
+const char* Utf8ScanLevel();
+
+/**
+ * @brief Check that text is well-formed UTF-8
+ *
+ * @param text Bytes to check
+ * @param error_offset Set to the offset of the first ill-formed sequence (optional)
+ * @return True if text is well-formed
+ */
+bool ValidateUtf8(std::string_view text, size_t* error_offset = nullptr);
+
+/**
+ * @brief Decode the well-formed sequence at the start of a buffer
+ *
+ * @param data Bytes to decode
+ * @param size Number of bytes (> 0)
+ * @param codepoint Set to the decoded codepoint
+ * @return Bytes consumed (1-4), or 0 if the sequence is ill-formed or cut off by size
+ */
+int DecodeUtf8Char(const char* data, size_t size, uint32_t& codepoint);
+
+/**
+ * @brief Decode well-formed UTF-8 into codepoints
+ *
+ * @param text UTF-8 text
+ * @param codepoints Output codepoints (cleared first); on error, those before the error
+ * @param error_offset Set to the offset of the first ill-formed sequence (optional)
+ * @return True if text is well-formed
+ */
+bool DecodeUtf8(std::string_view text, std::vector<uint32_t>& codepoints, size_t* error_offset = nullptr);
+
+/**
+ * @brief Decode UTF-8, replacing each ill-formed sequence with U+FFFD
+ *
+ * Emits one U+FFFD per maximal subpart of an ill-formed sequence (the
+ * practice recommended by the Unicode standard and followed by ICU's UTF-8
+ * conversion), so the codepoints match what ICU would see.
+ *
+ * @param text UTF-8 text, possibly ill-formed
+ * @param codepoints Output codepoints (cleared first)
+ */
+void DecodeUtf8Replacing(std::string_view text, std::vector<uint32_t>& codepoints);
+
+/**
+ * @brief Find the byte offset of each codepoint of well-formed UTF-8
+ *
+ * @param text UTF-8 text
+ * @param offsets Output offsets (cleared first): one per codepoint, plus text.size() on success
+ * @param error_offset Set to the offset of the first ill-formed sequence (optional)
+ * @return True if text is well-formed
+ */
+bool Utf8Boundaries(std::string_view text, std::vector<size_t>& offsets, size_t* error_offset = nullptr);
+
+}  // namespace mygramdb::utils
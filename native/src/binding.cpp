@@ -7,6 +7,7 @@
 
 #include <node_api.h>
 #include <string>
+#include <vector>
 #include <cstring>
 #include <cstdlib>
 #include "../include/mygramclient_c.h"
@@ -35,6 +36,99 @@ static void ThrowError(napi_env env, const char* message) {
   napi_throw_error(env, nullptr, message);
 }
 
+// Helper to read a JS string of any length
+static napi_status GetStringValue(napi_env env, napi_value value, std::string* out) {
+  size_t length = 0;
+  napi_status status = napi_get_value_string_utf8(env, value, nullptr, 0, &length);
+  if (status != napi_ok) {
+    return status;
+  }
+  out->resize(length + 1);
+  status = napi_get_value_string_utf8(env, value, &(*out)[0], length + 1, &length);
+  out->resize(length);
+  return status;
+}
+
+// Helper to read a JS array of strings
+static napi_status GetStringArray(napi_env env, napi_value value, std::vector<std::string>* out) {
+  uint32_t length = 0;
+  napi_status status = napi_get_array_length(env, value, &length);
+  if (status != napi_ok) {
+    return status;
+  }
+  out->resize(length);
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value element;
+    status = napi_get_element(env, value, i, &element);
+    if (status != napi_ok) {
+      return status;
+    }
+    status = GetStringValue(env, element, &(*out)[i]);
+    if (status != napi_ok) {
+      return status;
+    }
+  }
+  return napi_ok;
+}
+
+// Helper to read a JS array of unsigned integers
+static napi_status GetUint32Array(napi_env env, napi_value value, std::vector<uint32_t>* out) {
+  uint32_t length = 0;
+  napi_status status = napi_get_array_length(env, value, &length);
+  if (status != napi_ok) {
+    return status;
+  }
+  out->resize(length);
+  for (uint32_t i = 0; i < length; i++) {
+    napi_value element;
+    status = napi_get_element(env, value, i, &element);
+    if (status != napi_ok) {
+      return status;
+    }
+    status = napi_get_value_uint32(env, element, &(*out)[i]);
+    if (status != napi_ok) {
+      return status;
+    }
+  }
+  return napi_ok;
+}
+
+// Helper to collect C string pointers for the C API
+static std::vector<const char*> ToCStringArray(const std::vector<std::string>& values) {
+  std::vector<const char*> pointers;
+  pointers.reserve(values.size());
+  for (const auto& value : values) {
+    pointers.push_back(value.c_str());
+  }
+  return pointers;
+}
+
+// Helper to create a typed array holding a copy of `count` elements
+static napi_status CreateTypedArrayCopy(napi_env env, napi_typedarray_type type, const void* data,
+                                        size_t count, size_t element_size, napi_value* result) {
+  void* buffer_data = nullptr;
+  napi_value arraybuffer;
+  napi_status status = napi_create_arraybuffer(env, count * element_size, &buffer_data, &arraybuffer);
+  if (status != napi_ok) {
+    return status;
+  }
+  if (count > 0 && data != nullptr) {
+    std::memcpy(buffer_data, data, count * element_size);
+  }
+  return napi_create_typedarray(env, type, count, arraybuffer, 0, result);
+}
+
+// Field type names, indexed by MygramFieldType_C
+static const char* const kFieldTypeNames[] = { "string", "integer", "float", "timestamp" };
+
+// Helper to get the name of a MygramFieldType_C value
+static const char* FieldTypeName(int type) {
+  if (type < MYGRAM_FIELD_STRING || type > MYGRAM_FIELD_TIMESTAMP) {
+    return "string";
+  }
+  return kFieldTypeNames[type];
+}
+
 /**
  * Create new MygramDB client
  *
@@ -42,6 +136,7 @@ static void ThrowError(napi_env env, const char* message) {
  * @param {string} config.host - Server hostname
  * @param {number} config.port - Server port
  * @param {number} config.timeout - Connection timeout in milliseconds
+ * @param {boolean} config.learnFieldSchemas - Infer field types of tables without a declared schema
  * @returns {External} Client handle
  */
 static napi_value CreateClient(napi_env env, napi_callback_info info) {
@@ -95,12 +190,48 @@ static napi_value CreateClient(napi_env env, napi_callback_info info) {
     NAPI_CALL(env, napi_get_value_int32(env, timeout_val, &timeout));
   }
 
+  // Extract learnFieldSchemas
+  bool learn_field_schemas = false;
+  napi_value learn_val;
+  bool has_learn;
+  NAPI_CALL(env, napi_has_named_property(env, config, "learnFieldSchemas", &has_learn));
+  if (has_learn) {
+    NAPI_CALL(env, napi_get_named_property(env, config, "learnFieldSchemas", &learn_val));
+    NAPI_CALL(env, napi_coerce_to_bool(env, learn_val, &learn_val));
+    NAPI_CALL(env, napi_get_value_bool(env, learn_val, &learn_field_schemas));
+  }
+
+  // Extract reorderTerms
+  bool reorder_terms = false;
+  napi_value reorder_val;
+  bool has_reorder;
+  NAPI_CALL(env, napi_has_named_property(env, config, "reorderTerms", &has_reorder));
+  if (has_reorder) {
+    NAPI_CALL(env, napi_get_named_property(env, config, "reorderTerms", &reorder_val));
+    NAPI_CALL(env, napi_coerce_to_bool(env, reorder_val, &reorder_val));
+    NAPI_CALL(env, napi_get_value_bool(env, reorder_val, &reorder_terms));
+  }
+
+  // Extract analyzeQueries
+  bool analyze_queries = false;
+  napi_value analyze_val;
+  bool has_analyze;
+  NAPI_CALL(env, napi_has_named_property(env, config, "analyzeQueries", &has_analyze));
+  if (has_analyze) {
+    NAPI_CALL(env, napi_get_named_property(env, config, "analyzeQueries", &analyze_val));
+    NAPI_CALL(env, napi_coerce_to_bool(env, analyze_val, &analyze_val));
+    NAPI_CALL(env, napi_get_value_bool(env, analyze_val, &analyze_queries));
+  }
+
   // Create client configuration
-  MygramClientConfig_C config_c;
+  MygramClientConfig_C config_c = {};
   config_c.host = host;
   config_c.port = static_cast<uint16_t>(port);
   config_c.timeout_ms = static_cast<uint32_t>(timeout);
   config_c.recv_buffer_size = 65536;
+  config_c.learn_field_schemas = learn_field_schemas ? 1 : 0;
+  config_c.reorder_terms = reorder_terms ? 1 : 0;
+  config_c.analyze_queries = analyze_queries ? 1 : 0;
 
   // Create client
   MygramClient_C* client = mygramclient_create(&config_c);
@@ -296,6 +427,2386 @@ static napi_value SearchSimple(napi_env env, napi_callback_info info) {
   return ret_obj;
 }
 
+/**
+ * Get selected fields of many documents as columns
+ *
+ * @param {External} client - Client handle
+ * @param {string} table - Table name
+ * @param {string[]} primaryKeys - Primary keys (row order)
+ * @param {string[]} fields - Field names (column order)
+ * @returns {Object} { primary_keys, found: Uint8Array, columns: Array<{ name, kind, type?, present: Uint8Array,
+ *   values?: Float64Array, data?: Uint8Array, offsets?: Uint32Array }> }
+ */
+static napi_value GetColumns(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value args[4];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 4) {
+    ThrowError(env, "Expected 4 arguments: client, table, primaryKeys, fields");
+    return nullptr;
+  }
+
+  MygramClient_C* client;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&client)));
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[1], &table));
+
+  std::vector<std::string> keys;
+  NAPI_CALL(env, GetStringArray(env, args[2], &keys));
+
+  std::vector<std::string> fields;
+  NAPI_CALL(env, GetStringArray(env, args[3], &fields));
+
+  std::vector<const char*> key_ptrs = ToCStringArray(keys);
+  std::vector<const char*> field_ptrs = ToCStringArray(fields);
+
+  MygramColumnarResult_C* result = nullptr;
+  int rc = mygramclient_get_columns(client, table.c_str(), key_ptrs.data(), key_ptrs.size(), field_ptrs.data(),
+                                    field_ptrs.size(), &result);
+
+  if (rc != 0 || result == nullptr) {
+    const char* error = mygramclient_get_last_error(client);
+    ThrowError(env, error ? error : "GetColumns failed");
+    return nullptr;
+  }
+
+  napi_value ret_obj;
+  NAPI_CALL(env, napi_create_object(env, &ret_obj));
+
+  napi_value pkeys_array;
+  NAPI_CALL(env, napi_create_array_with_length(env, result->row_count, &pkeys_array));
+  for (size_t i = 0; i < result->row_count; i++) {
+    napi_value pkey_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, result->primary_keys[i], NAPI_AUTO_LENGTH, &pkey_val));
+    NAPI_CALL(env, napi_set_element(env, pkeys_array, static_cast<uint32_t>(i), pkey_val));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, ret_obj, "primary_keys", pkeys_array));
+
+  napi_value found_val;
+  NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint8_array, result->found, result->row_count, sizeof(uint8_t),
+                                      &found_val));
+  NAPI_CALL(env, napi_set_named_property(env, ret_obj, "found", found_val));
+
+  napi_value columns_array;
+  NAPI_CALL(env, napi_create_array_with_length(env, result->column_count, &columns_array));
+  for (size_t i = 0; i < result->column_count; i++) {
+    const MygramColumn_C& column = result->columns[i];
+
+    napi_value column_obj;
+    NAPI_CALL(env, napi_create_object(env, &column_obj));
+
+    napi_value name_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, column.name, NAPI_AUTO_LENGTH, &name_val));
+    NAPI_CALL(env, napi_set_named_property(env, column_obj, "name", name_val));
+
+    napi_value kind_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, column.is_numeric ? "number" : "string", NAPI_AUTO_LENGTH,
+                                           &kind_val));
+    NAPI_CALL(env, napi_set_named_property(env, column_obj, "kind", kind_val));
+
+    if (column.field_type >= 0) {
+      napi_value type_val;
+      NAPI_CALL(env, napi_create_string_utf8(env, FieldTypeName(column.field_type), NAPI_AUTO_LENGTH, &type_val));
+      NAPI_CALL(env, napi_set_named_property(env, column_obj, "type", type_val));
+    }
+
+    napi_value present_val;
+    NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint8_array, column.present, result->row_count,
+                                        sizeof(uint8_t), &present_val));
+    NAPI_CALL(env, napi_set_named_property(env, column_obj, "present", present_val));
+
+    if (column.is_numeric) {
+      napi_value values_val;
+      NAPI_CALL(env, CreateTypedArrayCopy(env, napi_float64_array, column.numbers, result->row_count,
+                                          sizeof(double), &values_val));
+      NAPI_CALL(env, napi_set_named_property(env, column_obj, "values", values_val));
+    } else {
+      napi_value data_val;
+      NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint8_array, column.string_data, column.string_data_size,
+                                          sizeof(uint8_t), &data_val));
+      NAPI_CALL(env, napi_set_named_property(env, column_obj, "data", data_val));
+
+      napi_value offsets_val;
+      NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint32_array, column.string_offsets, result->row_count + 1,
+                                          sizeof(uint32_t), &offsets_val));
+      NAPI_CALL(env, napi_set_named_property(env, column_obj, "offsets", offsets_val));
+    }
+
+    NAPI_CALL(env, napi_set_element(env, columns_array, static_cast<uint32_t>(i), column_obj));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, ret_obj, "columns", columns_array));
+
+  mygramclient_free_columnar_result(result);
+
+  return ret_obj;
+}
+
+/**
+ * Get document by primary key with typed field values
+ *
+ * Fields decoded by the table's field schema become numbers (integer, float)
+ * or Dates (timestamp); everything else stays a string.
+ *
+ * @param {External} client - Client handle
+ * @param {string} table - Table name
+ * @param {string} primaryKey - Primary key
+ * @returns {Object} { primary_key, fields: Object<string, string|number|Date> }
+ */
+static napi_value GetDocument(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 3) {
+    ThrowError(env, "Expected 3 arguments: client, table, primaryKey");
+    return nullptr;
+  }
+
+  MygramClient_C* client;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&client)));
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[1], &table));
+
+  std::string primary_key;
+  NAPI_CALL(env, GetStringValue(env, args[2], &primary_key));
+
+  MygramDocument_C* doc = nullptr;
+  int rc = mygramclient_get(client, table.c_str(), primary_key.c_str(), &doc);
+
+  if (rc != 0 || doc == nullptr) {
+    const char* error = mygramclient_get_last_error(client);
+    ThrowError(env, error ? error : "Get failed");
+    return nullptr;
+  }
+
+  napi_value ret_obj;
+  NAPI_CALL(env, napi_create_object(env, &ret_obj));
+
+  napi_value pkey_val;
+  NAPI_CALL(env, napi_create_string_utf8(env, doc->primary_key, NAPI_AUTO_LENGTH, &pkey_val));
+  NAPI_CALL(env, napi_set_named_property(env, ret_obj, "primary_key", pkey_val));
+
+  napi_value fields_obj;
+  NAPI_CALL(env, napi_create_object(env, &fields_obj));
+  for (size_t i = 0; i < doc->field_count; i++) {
+    int type = doc->field_types != nullptr ? doc->field_types[i] : MYGRAM_FIELD_STRING;
+
+    napi_value value;
+    if (type == MYGRAM_FIELD_INTEGER || type == MYGRAM_FIELD_FLOAT) {
+      NAPI_CALL(env, napi_create_double(env, doc->field_numbers[i], &value));
+    } else if (type == MYGRAM_FIELD_TIMESTAMP) {
+      NAPI_CALL(env, napi_create_date(env, static_cast<double>(doc->field_integers[i]), &value));
+    } else {
+      NAPI_CALL(env, napi_create_string_utf8(env, doc->field_values[i], NAPI_AUTO_LENGTH, &value));
+    }
+    NAPI_CALL(env, napi_set_named_property(env, fields_obj, doc->field_keys[i], value));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, ret_obj, "fields", fields_obj));
+
+  mygramclient_free_document(doc);
+
+  return ret_obj;
+}
+
+/**
+ * Declare the filter field types of a table
+ *
+ * @param {External} client - Client handle
+ * @param {string} table - Table name
+ * @param {Object<string, string>} schema - Field name to 'string' | 'integer' | 'float' | 'timestamp'
+ */
+static napi_value SetFieldSchema(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 3) {
+    ThrowError(env, "Expected 3 arguments: client, table, schema");
+    return nullptr;
+  }
+
+  MygramClient_C* client;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&client)));
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[1], &table));
+
+  napi_value names_array;
+  NAPI_CALL(env, napi_get_property_names(env, args[2], &names_array));
+  std::vector<std::string> names;
+  NAPI_CALL(env, GetStringArray(env, names_array, &names));
+
+  std::vector<int> types;
+  types.reserve(names.size());
+  for (const auto& name : names) {
+    napi_value type_val;
+    NAPI_CALL(env, napi_get_named_property(env, args[2], name.c_str(), &type_val));
+    std::string type_name;
+    NAPI_CALL(env, GetStringValue(env, type_val, &type_name));
+
+    int type = -1;
+    for (int t = MYGRAM_FIELD_STRING; t <= MYGRAM_FIELD_TIMESTAMP; t++) {
+      if (type_name == kFieldTypeNames[t]) {
+        type = t;
+      }
+    }
+    if (type < 0) {
+      std::string message = "Unknown field type for " + name + ": " + type_name;
+      ThrowError(env, message.c_str());
+      return nullptr;
+    }
+    types.push_back(type);
+  }
+
+  std::vector<const char*> name_ptrs = ToCStringArray(names);
+  if (mygramclient_set_field_schema(client, table.c_str(), name_ptrs.data(), types.data(), types.size()) != 0) {
+    const char* error = mygramclient_get_last_error(client);
+    ThrowError(env, error ? error : "SetFieldSchema failed");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Get the declared or learned field schema of a table
+ *
+ * @param {External} client - Client handle
+ * @param {string} table - Table name
+ * @returns {Object<string, string>|null} Field name to type name, or null if the table has no schema
+ */
+static napi_value GetFieldSchema(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: client, table");
+    return nullptr;
+  }
+
+  MygramClient_C* client;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&client)));
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[1], &table));
+
+  MygramFieldSchema_C* schema = nullptr;
+  if (mygramclient_get_field_schema(client, table.c_str(), &schema) != 0 || schema == nullptr) {
+    const char* error = mygramclient_get_last_error(client);
+    ThrowError(env, error ? error : "GetFieldSchema failed");
+    return nullptr;
+  }
+
+  napi_value result;
+  if (schema->field_count == 0) {
+    NAPI_CALL(env, napi_get_null(env, &result));
+  } else {
+    NAPI_CALL(env, napi_create_object(env, &result));
+    for (size_t i = 0; i < schema->field_count; i++) {
+      napi_value type_val;
+      NAPI_CALL(env, napi_create_string_utf8(env, FieldTypeName(schema->field_types[i]), NAPI_AUTO_LENGTH,
+                                             &type_val));
+      NAPI_CALL(env, napi_set_named_property(env, result, schema->field_names[i], type_val));
+    }
+  }
+
+  mygramclient_free_field_schema(schema);
+
+  return result;
+}
+
+// Helper to convert a C server info struct to a JS object
+static napi_value CreateServerInfoObject(napi_env env, const MygramServerInfo_C* info) {
+  napi_value obj;
+  NAPI_CALL(env, napi_create_object(env, &obj));
+
+  napi_value version_val;
+  NAPI_CALL(env, napi_create_string_utf8(env, info->version, NAPI_AUTO_LENGTH, &version_val));
+  NAPI_CALL(env, napi_set_named_property(env, obj, "version", version_val));
+
+  const struct {
+    const char* name;
+    uint64_t value;
+  } counters[] = {
+    { "uptime_seconds", info->uptime_seconds },
+    { "total_requests", info->total_requests },
+    { "active_connections", info->active_connections },
+    { "index_size_bytes", info->index_size_bytes },
+    { "doc_count", info->doc_count },
+  };
+  for (const auto& counter : counters) {
+    napi_value counter_val;
+    NAPI_CALL(env, napi_create_double(env, static_cast<double>(counter.value), &counter_val));
+    NAPI_CALL(env, napi_set_named_property(env, obj, counter.name, counter_val));
+  }
+
+  napi_value tables_array;
+  NAPI_CALL(env, napi_create_array_with_length(env, info->table_count, &tables_array));
+  for (size_t i = 0; i < info->table_count; i++) {
+    napi_value table_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, info->tables[i], NAPI_AUTO_LENGTH, &table_val));
+    NAPI_CALL(env, napi_set_element(env, tables_array, static_cast<uint32_t>(i), table_val));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, obj, "tables", tables_array));
+
+  napi_value values_obj;
+  NAPI_CALL(env, napi_create_object(env, &values_obj));
+  for (size_t i = 0; i < info->value_count; i++) {
+    napi_value value_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, info->values[i], NAPI_AUTO_LENGTH, &value_val));
+    NAPI_CALL(env, napi_set_named_property(env, values_obj, info->keys[i], value_val));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, obj, "values", values_obj));
+
+  return obj;
+}
+
+/**
+ * Get server information
+ *
+ * @param {External} client - Client handle
+ * @returns {Object} { version, uptime_seconds, total_requests, active_connections, index_size_bytes,
+ *   doc_count, tables, values: Object<string, string> }
+ */
+static napi_value Info(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected client handle");
+    return nullptr;
+  }
+
+  MygramClient_C* client;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&client)));
+
+  MygramServerInfo_C* server_info = nullptr;
+  if (mygramclient_info(client, &server_info) != 0 || server_info == nullptr) {
+    const char* error = mygramclient_get_last_error(client);
+    ThrowError(env, error ? error : "Info failed");
+    return nullptr;
+  }
+
+  napi_value result = CreateServerInfoObject(env, server_info);
+  mygramclient_free_server_info(server_info);
+  return result;
+}
+
+/**
+ * Create a background INFO poller with its own connection
+ *
+ * @param {string} host - Server hostname
+ * @param {number} port - Server port
+ * @param {number} timeout - Connection timeout in milliseconds
+ * @param {number} intervalMs - Delay between polls
+ * @returns {External} Poller handle
+ */
+static napi_value CreateInfoPoller(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value args[4];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 4) {
+    ThrowError(env, "Expected 4 arguments: host, port, timeout, intervalMs");
+    return nullptr;
+  }
+
+  std::string host;
+  NAPI_CALL(env, GetStringValue(env, args[0], &host));
+
+  int port;
+  NAPI_CALL(env, napi_get_value_int32(env, args[1], &port));
+
+  int timeout;
+  NAPI_CALL(env, napi_get_value_int32(env, args[2], &timeout));
+
+  uint32_t interval_ms;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[3], &interval_ms));
+
+  MygramClientConfig_C config_c = {};
+  config_c.host = host.c_str();
+  config_c.port = static_cast<uint16_t>(port);
+  config_c.timeout_ms = static_cast<uint32_t>(timeout);
+
+  MygramInfoPoller_C* poller = mygramclient_info_poller_create(&config_c, interval_ms);
+  if (poller == nullptr) {
+    ThrowError(env, "Failed to create info poller");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, poller, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Start an INFO poller (polls once synchronously)
+ *
+ * @param {External} poller - Poller handle
+ * @returns {boolean} True if the first poll succeeded
+ */
+static napi_value StartInfoPoller(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected poller handle");
+    return nullptr;
+  }
+
+  MygramInfoPoller_C* poller;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&poller)));
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, mygramclient_info_poller_start(poller) == 0, &result));
+  return result;
+}
+
+/**
+ * Stop and destroy an INFO poller
+ *
+ * @param {External} poller - Poller handle
+ */
+static napi_value DestroyInfoPoller(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected poller handle");
+    return nullptr;
+  }
+
+  MygramInfoPoller_C* poller;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&poller)));
+
+  mygramclient_info_poller_destroy(poller);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Get the latest cached INFO snapshot
+ *
+ * @param {External} poller - Poller handle
+ * @returns {Object|null} { info, captured_at_ms, sequence }, or null before the first successful poll
+ */
+static napi_value GetInfoSnapshot(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected poller handle");
+    return nullptr;
+  }
+
+  MygramInfoPoller_C* poller;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&poller)));
+
+  MygramServerInfo_C* server_info = nullptr;
+  int64_t captured_at_ms = 0;
+  uint64_t sequence = 0;
+  if (mygramclient_info_poller_latest(poller, &server_info, &captured_at_ms, &sequence) != 0) {
+    ThrowError(env, "Failed to read info snapshot");
+    return nullptr;
+  }
+
+  napi_value result;
+  if (server_info == nullptr) {
+    NAPI_CALL(env, napi_get_null(env, &result));
+    return result;
+  }
+
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  napi_value info_obj = CreateServerInfoObject(env, server_info);
+  mygramclient_free_server_info(server_info);
+  if (info_obj == nullptr) {
+    return nullptr;
+  }
+  NAPI_CALL(env, napi_set_named_property(env, result, "info", info_obj));
+
+  napi_value captured_val;
+  NAPI_CALL(env, napi_create_double(env, static_cast<double>(captured_at_ms), &captured_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "captured_at_ms", captured_val));
+
+  napi_value sequence_val;
+  NAPI_CALL(env, napi_create_double(env, static_cast<double>(sequence), &sequence_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "sequence", sequence_val));
+
+  return result;
+}
+
+/**
+ * Get the error of the most recent poll
+ *
+ * @param {External} poller - Poller handle
+ * @returns {string} Error message (empty if the last poll succeeded)
+ */
+static napi_value GetInfoPollerError(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected poller handle");
+    return nullptr;
+  }
+
+  MygramInfoPoller_C* poller;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&poller)));
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_string_utf8(env, mygramclient_info_poller_get_last_error(poller), NAPI_AUTO_LENGTH,
+                                         &result));
+  return result;
+}
+
+/**
+ * Create a server metrics collector with its own connection
+ *
+ * @param {string} host - Server hostname
+ * @param {number} port - Server port
+ * @param {number} timeout - Connection timeout in milliseconds
+ * @param {number} intervalMs - Delay between samples
+ * @param {number[]} windows - Rolling window lengths in seconds (empty for defaults)
+ * @returns {External} Collector handle
+ */
+static napi_value CreateMetricsCollector(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 5) {
+    ThrowError(env, "Expected 5 arguments: host, port, timeout, intervalMs, windows");
+    return nullptr;
+  }
+
+  std::string host;
+  NAPI_CALL(env, GetStringValue(env, args[0], &host));
+
+  int port;
+  NAPI_CALL(env, napi_get_value_int32(env, args[1], &port));
+
+  int timeout;
+  NAPI_CALL(env, napi_get_value_int32(env, args[2], &timeout));
+
+  uint32_t interval_ms;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[3], &interval_ms));
+
+  std::vector<uint32_t> windows;
+  NAPI_CALL(env, GetUint32Array(env, args[4], &windows));
+
+  MygramClientConfig_C config_c = {};
+  config_c.host = host.c_str();
+  config_c.port = static_cast<uint16_t>(port);
+  config_c.timeout_ms = static_cast<uint32_t>(timeout);
+
+  MygramMetricsCollector_C* collector =
+      mygramclient_metrics_collector_create(&config_c, interval_ms, windows.data(), windows.size());
+  if (collector == nullptr) {
+    ThrowError(env, "Failed to create metrics collector");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, collector, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Start a metrics collector (samples once synchronously)
+ *
+ * @param {External} collector - Collector handle
+ * @returns {boolean} True if the first sample succeeded
+ */
+static napi_value StartMetricsCollector(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected collector handle");
+    return nullptr;
+  }
+
+  MygramMetricsCollector_C* collector;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&collector)));
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, mygramclient_metrics_collector_start(collector) == 0, &result));
+  return result;
+}
+
+/**
+ * Stop and destroy a metrics collector
+ *
+ * @param {External} collector - Collector handle
+ */
+static napi_value DestroyMetricsCollector(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected collector handle");
+    return nullptr;
+  }
+
+  MygramMetricsCollector_C* collector;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&collector)));
+
+  mygramclient_metrics_collector_destroy(collector);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+// Helper to set a numeric property
+static napi_status SetNumberProperty(napi_env env, napi_value object, const char* name, double value) {
+  napi_value number;
+  napi_status status = napi_create_double(env, value, &number);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_set_named_property(env, object, name, number);
+}
+
+/**
+ * Get metrics computed from the retained samples
+ *
+ * @param {External} collector - Collector handle
+ * @returns {Object} Server metrics with a windows array
+ */
+static napi_value GetServerMetrics(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected collector handle");
+    return nullptr;
+  }
+
+  MygramMetricsCollector_C* collector;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&collector)));
+
+  MygramServerMetrics_C* metrics = nullptr;
+  if (mygramclient_metrics_collector_get(collector, &metrics) != 0 || metrics == nullptr) {
+    ThrowError(env, "Failed to read server metrics");
+    return nullptr;
+  }
+
+  // Copy into a vector so the C result can be freed before any early return
+  MygramServerMetrics_C summary = *metrics;
+  std::vector<MygramMetricsWindow_C> windows(metrics->windows, metrics->windows + metrics->window_count);
+  mygramclient_free_server_metrics(metrics);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, SetNumberProperty(env, result, "captured_at_ms", static_cast<double>(summary.captured_at_ms)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "sample_count", static_cast<double>(summary.sample_count)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "doc_count", static_cast<double>(summary.doc_count)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "index_size_bytes", static_cast<double>(summary.index_size_bytes)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "index_bytes_per_doc", summary.index_bytes_per_doc));
+  NAPI_CALL(env,
+            SetNumberProperty(env, result, "active_connections", static_cast<double>(summary.active_connections)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "counter_resets", static_cast<double>(summary.counter_resets)));
+
+  napi_value reports_errors;
+  NAPI_CALL(env, napi_get_boolean(env, summary.reports_errors != 0, &reports_errors));
+  NAPI_CALL(env, napi_set_named_property(env, result, "reports_errors", reports_errors));
+
+  napi_value windows_arr;
+  NAPI_CALL(env, napi_create_array_with_length(env, windows.size(), &windows_arr));
+  for (size_t i = 0; i < windows.size(); i++) {
+    const MygramMetricsWindow_C& window = windows[i];
+    napi_value window_obj;
+    NAPI_CALL(env, napi_create_object(env, &window_obj));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "window_seconds", window.window_seconds));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "covered_seconds", window.covered_seconds));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "requests_per_second", window.requests_per_second));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "errors_per_second", window.errors_per_second));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "error_ratio", window.error_ratio));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "docs_per_second", window.docs_per_second));
+    NAPI_CALL(env, SetNumberProperty(env, window_obj, "doc_delta", static_cast<double>(window.doc_delta)));
+    NAPI_CALL(env,
+              SetNumberProperty(env, window_obj, "index_bytes_delta", static_cast<double>(window.index_bytes_delta)));
+    NAPI_CALL(env, napi_set_element(env, windows_arr, static_cast<uint32_t>(i), window_obj));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, result, "windows", windows_arr));
+
+  return result;
+}
+
+/**
+ * Get the error of the most recent sample attempt
+ *
+ * @param {External} collector - Collector handle
+ * @returns {string} Error message (empty if the last sample succeeded)
+ */
+static napi_value GetMetricsCollectorError(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected collector handle");
+    return nullptr;
+  }
+
+  MygramMetricsCollector_C* collector;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&collector)));
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_string_utf8(env, mygramclient_metrics_collector_get_last_error(collector),
+                                         NAPI_AUTO_LENGTH, &result));
+  return result;
+}
+
+/**
+ * Create a parsed search expression cache
+ *
+ * @param {number} capacity - Maximum entries (0 disables caching)
+ * @returns {External} Cache handle
+ */
+static napi_value CreateExpressionCache(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected capacity");
+    return nullptr;
+  }
+
+  uint32_t capacity;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[0], &capacity));
+
+  MygramExpressionCache_C* cache = mygramclient_expression_cache_create(capacity);
+  if (cache == nullptr) {
+    ThrowError(env, "Failed to create expression cache");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, cache, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Destroy a parsed search expression cache
+ *
+ * @param {External} cache - Cache handle
+ */
+static napi_value DestroyExpressionCache(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected cache handle");
+    return nullptr;
+  }
+
+  MygramExpressionCache_C* cache;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&cache)));
+
+  mygramclient_expression_cache_destroy(cache);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+// Helper to create a JS array of strings
+static napi_status CreateStringArray(napi_env env, const std::vector<std::string>& values, napi_value* out) {
+  napi_status status = napi_create_array_with_length(env, values.size(), out);
+  for (size_t i = 0; status == napi_ok && i < values.size(); i++) {
+    napi_value element;
+    status = napi_create_string_utf8(env, values[i].c_str(), values[i].size(), &element);
+    if (status == napi_ok) {
+      status = napi_set_element(env, *out, static_cast<uint32_t>(i), element);
+    }
+  }
+  return status;
+}
+
+/**
+ * Parse a search expression through the cache
+ *
+ * @param {External} cache - Cache handle
+ * @param {string} expression - Web-style search expression
+ * @returns {Object} { query, simplified, main_term, and_terms, not_terms }
+ * @throws {Error} If the expression is invalid
+ */
+static napi_value ParseExpressionCached(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: cache, expression");
+    return nullptr;
+  }
+
+  MygramExpressionCache_C* cache;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&cache)));
+
+  std::string expression;
+  NAPI_CALL(env, GetStringValue(env, args[1], &expression));
+
+  MygramParsedExpression_C* parsed = nullptr;
+  if (mygramclient_expression_cache_get(cache, expression.c_str(), &parsed) != 0 || parsed == nullptr) {
+    ThrowError(env, "Failed to parse expression");
+    return nullptr;
+  }
+
+  // Copy out of the C result so it can be freed before any early return
+  std::string error = parsed->error != nullptr ? parsed->error : "";
+  std::string query = parsed->query != nullptr ? parsed->query : "";
+  bool simplified = parsed->simplified != 0;
+  std::string main_term = parsed->main_term != nullptr ? parsed->main_term : "";
+  std::vector<std::string> and_terms(parsed->and_terms, parsed->and_terms + parsed->and_count);
+  std::vector<std::string> not_terms(parsed->not_terms, parsed->not_terms + parsed->not_count);
+  mygramclient_free_parsed_expression(parsed);
+
+  if (!error.empty()) {
+    ThrowError(env, error.c_str());
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  napi_value query_val;
+  NAPI_CALL(env, napi_create_string_utf8(env, query.c_str(), query.size(), &query_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "query", query_val));
+
+  napi_value simplified_val;
+  NAPI_CALL(env, napi_get_boolean(env, simplified, &simplified_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "simplified", simplified_val));
+
+  napi_value main_term_val;
+  NAPI_CALL(env, napi_create_string_utf8(env, main_term.c_str(), main_term.size(), &main_term_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "main_term", main_term_val));
+
+  napi_value and_terms_arr;
+  NAPI_CALL(env, CreateStringArray(env, and_terms, &and_terms_arr));
+  NAPI_CALL(env, napi_set_named_property(env, result, "and_terms", and_terms_arr));
+
+  napi_value not_terms_arr;
+  NAPI_CALL(env, CreateStringArray(env, not_terms, &not_terms_arr));
+  NAPI_CALL(env, napi_set_named_property(env, result, "not_terms", not_terms_arr));
+
+  return result;
+}
+
+/**
+ * Get expression cache counters
+ *
+ * @param {External} cache - Cache handle
+ * @returns {Object} { hits, misses, evictions, size, capacity }
+ */
+static napi_value GetExpressionCacheStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected cache handle");
+    return nullptr;
+  }
+
+  MygramExpressionCache_C* cache;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&cache)));
+
+  MygramExpressionCacheStats_C stats = {};
+  if (mygramclient_expression_cache_stats(cache, &stats) != 0) {
+    ThrowError(env, "Failed to read expression cache stats");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, SetNumberProperty(env, result, "hits", static_cast<double>(stats.hits)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "misses", static_cast<double>(stats.misses)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "evictions", static_cast<double>(stats.evictions)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "size", static_cast<double>(stats.size)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "capacity", static_cast<double>(stats.capacity)));
+  return result;
+}
+
+/**
+ * Change the expression cache capacity
+ *
+ * @param {External} cache - Cache handle
+ * @param {number} capacity - Maximum entries (0 disables caching)
+ */
+static napi_value ResizeExpressionCache(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: cache, capacity");
+    return nullptr;
+  }
+
+  MygramExpressionCache_C* cache;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&cache)));
+
+  uint32_t capacity;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[1], &capacity));
+
+  mygramclient_expression_cache_resize(cache, capacity);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Remove all cached expressions
+ *
+ * @param {External} cache - Cache handle
+ */
+static napi_value ClearExpressionCache(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected cache handle");
+    return nullptr;
+  }
+
+  MygramExpressionCache_C* cache;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&cache)));
+
+  mygramclient_expression_cache_clear(cache);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+// Helper to turn UTF-8 byte offsets into UTF-16 code unit offsets (for String.prototype.slice)
+static void Utf8OffsetsToUtf16(const char* data, uint32_t* offsets, size_t offset_count) {
+  uint32_t units = 0;
+  uint32_t byte_pos = 0;
+  for (size_t i = 0; i < offset_count; i++) {
+    uint32_t target = offsets[i];
+    for (; byte_pos < target; byte_pos++) {
+      auto byte = static_cast<unsigned char>(data[byte_pos]);
+      if ((byte & 0xC0) != 0x80) {
+        units += byte >= 0xF0 ? 2 : 1;  // 4-byte sequences are surrogate pairs
+      }
+    }
+    offsets[i] = units;
+  }
+}
+
+/**
+ * Convert many search expressions in one call
+ *
+ * Entry i is data.slice(offsets[i], offsets[i + 1]): the converted query
+ * when ok[i] is 1, the parse error message when ok[i] is 0.
+ *
+ * @param {string[]} expressions - Web-style search expressions
+ * @param {number} [maxThreads=0] - Upper bound on threads (0 = default)
+ * @returns {{data: string, offsets: Uint32Array, ok: Uint8Array}} Packed results
+ */
+static napi_value ConvertSearchExpressions(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected expressions array");
+    return nullptr;
+  }
+
+  std::vector<std::string> expressions;
+  NAPI_CALL(env, GetStringArray(env, args[0], &expressions));
+
+  uint32_t max_threads = 0;
+  if (argc >= 2) {
+    napi_valuetype type;
+    NAPI_CALL(env, napi_typeof(env, args[1], &type));
+    if (type == napi_number) {
+      NAPI_CALL(env, napi_get_value_uint32(env, args[1], &max_threads));
+    }
+  }
+
+  std::vector<const char*> expression_ptrs = ToCStringArray(expressions);
+  MygramConvertedExpressions_C* converted = nullptr;
+  if (mygramclient_convert_search_expressions(expression_ptrs.data(), expression_ptrs.size(), max_threads,
+                                              &converted) != 0 || converted == nullptr) {
+    ThrowError(env, "Failed to convert expressions");
+    return nullptr;
+  }
+
+  // Copy out of the C result so it can be freed before any early return
+  std::string data(converted->data, converted->data_size);
+  std::vector<uint32_t> offsets(converted->offsets, converted->offsets + converted->count + 1);
+  std::vector<uint8_t> ok(converted->ok, converted->ok + converted->count);
+  mygramclient_free_converted_expressions(converted);
+
+  Utf8OffsetsToUtf16(data.c_str(), offsets.data(), offsets.size());
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  napi_value data_val;
+  NAPI_CALL(env, napi_create_string_utf8(env, data.c_str(), data.size(), &data_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "data", data_val));
+
+  napi_value offsets_val;
+  NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint32_array, offsets.data(), offsets.size(), sizeof(uint32_t),
+                                      &offsets_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "offsets", offsets_val));
+
+  napi_value ok_val;
+  NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint8_array, ok.data(), ok.size(), sizeof(uint8_t), &ok_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "ok", ok_val));
+
+  return result;
+}
+
+// Helper to read an optional unsigned integer property (left unchanged when absent or undefined)
+static napi_status GetOptionalUint32Property(napi_env env, napi_value object, const char* name, uint32_t* out) {
+  napi_value value;
+  napi_status status = napi_get_named_property(env, object, name, &value);
+  if (status != napi_ok) {
+    return status;
+  }
+  napi_valuetype type;
+  status = napi_typeof(env, value, &type);
+  if (status != napi_ok || type == napi_undefined) {
+    return status;
+  }
+  return napi_get_value_uint32(env, value, out);
+}
+
+// Helper to read an optional boolean property (left unchanged when absent or undefined)
+static napi_status GetOptionalBoolProperty(napi_env env, napi_value object, const char* name, bool* out) {
+  napi_value value;
+  napi_status status = napi_get_named_property(env, object, name, &value);
+  if (status != napi_ok) {
+    return status;
+  }
+  napi_valuetype type;
+  status = napi_typeof(env, value, &type);
+  if (status != napi_ok || type == napi_undefined) {
+    return status;
+  }
+  status = napi_coerce_to_bool(env, value, &value);
+  if (status != napi_ok) {
+    return status;
+  }
+  return napi_get_value_bool(env, value, out);
+}
+
+/**
+ * Estimate the cost of a search expression from its hybrid n-gram expansion
+ *
+ * @param {string} expression - Web-style search expression
+ * @param {Object} [options] - asciiNgramSize, kanjiNgramSize, nfkc, width, lower,
+ *   moderateNgrams, highNgrams, excessiveNgrams
+ * @returns {Object} Estimate with terms, total_ngrams, distinct_ngrams, max_term_ngrams,
+ *   short_terms and cost_class
+ * @throws {Error} If the expression does not parse
+ */
+static napi_value EstimateQueryCost(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected expression");
+    return nullptr;
+  }
+
+  std::string expression;
+  NAPI_CALL(env, GetStringValue(env, args[0], &expression));
+
+  MygramQueryCostConfig_C config = {};
+  std::string width;
+  napi_valuetype options_type = napi_undefined;
+  if (argc >= 2) {
+    NAPI_CALL(env, napi_typeof(env, args[1], &options_type));
+  }
+  if (options_type == napi_object) {
+    napi_value options = args[1];
+    uint32_t ascii_ngram_size = 0;
+    uint32_t kanji_ngram_size = 0;
+    bool nfkc = false;
+    bool lower = false;
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "asciiNgramSize", &ascii_ngram_size));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "kanjiNgramSize", &kanji_ngram_size));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, options, "nfkc", &nfkc));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, options, "lower", &lower));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "moderateNgrams", &config.moderate_ngrams));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "highNgrams", &config.high_ngrams));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "excessiveNgrams", &config.excessive_ngrams));
+    config.ascii_ngram_size = static_cast<int>(ascii_ngram_size);
+    config.kanji_ngram_size = static_cast<int>(kanji_ngram_size);
+    config.nfkc = nfkc ? 1 : 0;
+    config.lower = lower ? 1 : 0;
+
+    bool has_width;
+    NAPI_CALL(env, napi_has_named_property(env, options, "width", &has_width));
+    if (has_width) {
+      napi_value width_val;
+      NAPI_CALL(env, napi_get_named_property(env, options, "width", &width_val));
+      NAPI_CALL(env, GetStringValue(env, width_val, &width));
+      config.width = width.c_str();
+    }
+  }
+
+  MygramQueryCost_C* cost = nullptr;
+  if (mygramclient_estimate_query_cost(expression.c_str(), &config, &cost) != 0 || cost == nullptr) {
+    ThrowError(env, "Failed to estimate query cost");
+    return nullptr;
+  }
+  if (cost->error != nullptr) {
+    std::string error = cost->error;
+    mygramclient_free_query_cost(cost);
+    ThrowError(env, error.c_str());
+    return nullptr;
+  }
+
+  // Copy out of the C result so it can be freed before any early return
+  std::vector<std::string> terms(cost->terms, cost->terms + cost->term_count);
+  std::vector<uint32_t> term_ngrams(cost->term_ngrams, cost->term_ngrams + cost->term_count);
+  std::vector<uint8_t> term_flags(cost->term_flags, cost->term_flags + cost->term_count);
+  MygramQueryCost_C totals = *cost;
+  mygramclient_free_query_cost(cost);
+
+  static const char* const kCostClassNames[] = { "low", "moderate", "high", "excessive" };
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  napi_value terms_arr;
+  NAPI_CALL(env, napi_create_array_with_length(env, terms.size(), &terms_arr));
+  for (size_t i = 0; i < terms.size(); i++) {
+    napi_value term_obj;
+    NAPI_CALL(env, napi_create_object(env, &term_obj));
+
+    napi_value term_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, terms[i].c_str(), terms[i].size(), &term_val));
+    NAPI_CALL(env, napi_set_named_property(env, term_obj, "term", term_val));
+    NAPI_CALL(env, SetNumberProperty(env, term_obj, "ngrams", term_ngrams[i]));
+
+    const char* flag_names[] = { "phrase", "excluded", "optional" };
+    const int flag_bits[] = { MYGRAM_TERM_PHRASE, MYGRAM_TERM_EXCLUDED, MYGRAM_TERM_OPTIONAL };
+    for (size_t flag = 0; flag < 3; flag++) {
+      napi_value flag_val;
+      NAPI_CALL(env, napi_get_boolean(env, (term_flags[i] & flag_bits[flag]) != 0, &flag_val));
+      NAPI_CALL(env, napi_set_named_property(env, term_obj, flag_names[flag], flag_val));
+    }
+
+    NAPI_CALL(env, napi_set_element(env, terms_arr, static_cast<uint32_t>(i), term_obj));
+  }
+  NAPI_CALL(env, napi_set_named_property(env, result, "terms", terms_arr));
+
+  NAPI_CALL(env, SetNumberProperty(env, result, "total_ngrams", static_cast<double>(totals.total_ngrams)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "distinct_ngrams", static_cast<double>(totals.distinct_ngrams)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "max_term_ngrams", totals.max_term_ngrams));
+  NAPI_CALL(env, SetNumberProperty(env, result, "short_terms", totals.short_terms));
+
+  napi_value class_val;
+  const char* class_name = kCostClassNames[totals.cost_class];
+  NAPI_CALL(env, napi_create_string_utf8(env, class_name, NAPI_AUTO_LENGTH, &class_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "cost_class", class_val));
+
+  return result;
+}
+
+/**
+ * Hash the n-grams of a text with a rolling 64-bit hash
+ *
+ * @param {string} text - Text (should be normalized)
+ * @param {number} asciiNgramSize - N-gram size (for non-CJK characters when kanjiNgramSize is given)
+ * @param {number} [kanjiNgramSize] - N-gram size for CJK ideographs; selects hybrid n-grams
+ * @returns {BigUint64Array} One hash per n-gram, in text order
+ */
+static napi_value NgramHashes(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: text, ngramSize");
+    return nullptr;
+  }
+
+  std::string text;
+  NAPI_CALL(env, GetStringValue(env, args[0], &text));
+
+  int32_t ascii_ngram_size;
+  NAPI_CALL(env, napi_get_value_int32(env, args[1], &ascii_ngram_size));
+
+  bool hybrid = false;
+  int32_t kanji_ngram_size = 0;
+  if (argc >= 3) {
+    napi_valuetype type;
+    NAPI_CALL(env, napi_typeof(env, args[2], &type));
+    if (type == napi_number) {
+      hybrid = true;
+      NAPI_CALL(env, napi_get_value_int32(env, args[2], &kanji_ngram_size));
+    }
+  }
+
+  uint64_t* hashes = nullptr;
+  size_t count = 0;
+  int status = hybrid ? mygramclient_hybrid_ngram_hashes(text.c_str(), text.size(), ascii_ngram_size,
+                                                         kanji_ngram_size, &hashes, &count)
+                      : mygramclient_ngram_hashes(text.c_str(), text.size(), ascii_ngram_size, &hashes, &count);
+  if (status != 0) {
+    ThrowError(env, "Failed to hash n-grams");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_status create_status =
+      CreateTypedArrayCopy(env, napi_biguint64_array, hashes, count, sizeof(uint64_t), &result);
+  mygramclient_free_hashes(hashes);
+  NAPI_CALL(env, create_status);
+  return result;
+}
+
+/**
+ * Normalize and split a batch of documents into hybrid n-grams
+ *
+ * @param {string[] | Uint8Array} documents - Document texts, or UTF-8 documents back to back
+ * @param {Uint32Array | null} offsets - Document boundaries in bytes when documents is a Uint8Array
+ * @param {Object} [options] - asciiNgramSize, kanjiNgramSize, nfkc, width, lower, output
+ *   ('counts', 'hashes' or 'ngrams'), distinct, maxThreads
+ * @returns {Object} Batch with counts, and document_offsets plus hashes or data/ngram_offsets
+ *   (UTF-16 offsets) for the 'hashes' and 'ngrams' outputs
+ */
+static napi_value NgramBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value args[3];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected documents");
+    return nullptr;
+  }
+
+  // Documents as one buffer plus count + 1 offsets; string arrays are packed here
+  std::string packed;
+  std::vector<uint32_t> packed_offsets;
+  const char* data = nullptr;
+  const uint32_t* offsets = nullptr;
+  size_t count = 0;
+
+  bool is_array;
+  NAPI_CALL(env, napi_is_array(env, args[0], &is_array));
+  if (is_array) {
+    std::vector<std::string> documents;
+    NAPI_CALL(env, GetStringArray(env, args[0], &documents));
+    packed_offsets.reserve(documents.size() + 1);
+    packed_offsets.push_back(0);
+    for (const auto& document : documents) {
+      packed += document;
+      if (packed.size() > UINT32_MAX) {
+        ThrowError(env, "Documents exceed 4 GiB; split the batch");
+        return nullptr;
+      }
+      packed_offsets.push_back(static_cast<uint32_t>(packed.size()));
+    }
+    data = packed.data();
+    offsets = packed_offsets.data();
+    count = documents.size();
+  } else {
+    bool is_typedarray = false;
+    NAPI_CALL(env, napi_is_typedarray(env, args[0], &is_typedarray));
+    napi_valuetype offsets_type = napi_undefined;
+    if (argc >= 2) {
+      NAPI_CALL(env, napi_typeof(env, args[1], &offsets_type));
+    }
+    if (!is_typedarray || offsets_type != napi_object) {
+      ThrowError(env, "Expected documents array, or bytes and offsets");
+      return nullptr;
+    }
+
+    napi_typedarray_type data_type;
+    size_t data_length;
+    void* data_ptr = nullptr;
+    NAPI_CALL(env, napi_get_typedarray_info(env, args[0], &data_type, &data_length, &data_ptr, nullptr, nullptr));
+    napi_typedarray_type offsets_kind;
+    size_t offsets_length = 0;
+    void* offsets_ptr = nullptr;
+    bool offsets_typed = false;
+    NAPI_CALL(env, napi_is_typedarray(env, args[1], &offsets_typed));
+    if (offsets_typed) {
+      NAPI_CALL(env, napi_get_typedarray_info(env, args[1], &offsets_kind, &offsets_length, &offsets_ptr, nullptr,
+                                              nullptr));
+    }
+    if (data_type != napi_uint8_array || !offsets_typed || offsets_kind != napi_uint32_array || offsets_length == 0) {
+      ThrowError(env, "Expected Uint8Array documents and Uint32Array offsets");
+      return nullptr;
+    }
+
+    data = data_length > 0 ? static_cast<const char*>(data_ptr) : "";
+    offsets = static_cast<const uint32_t*>(offsets_ptr);
+    count = offsets_length - 1;
+    if (offsets[count] > data_length) {
+      ThrowError(env, "Document offsets exceed the data");
+      return nullptr;
+    }
+  }
+
+  MygramNgramBatchConfig_C config = {};
+  std::string width;
+  napi_valuetype options_type = napi_undefined;
+  if (argc >= 3) {
+    NAPI_CALL(env, napi_typeof(env, args[2], &options_type));
+  }
+  if (options_type == napi_object) {
+    napi_value options = args[2];
+    uint32_t ascii_ngram_size = 0;
+    uint32_t kanji_ngram_size = 0;
+    uint32_t max_threads = 0;
+    bool nfkc = false;
+    bool lower = false;
+    bool distinct = false;
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "asciiNgramSize", &ascii_ngram_size));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "kanjiNgramSize", &kanji_ngram_size));
+    NAPI_CALL(env, GetOptionalUint32Property(env, options, "maxThreads", &max_threads));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, options, "nfkc", &nfkc));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, options, "lower", &lower));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, options, "distinct", &distinct));
+    config.ascii_ngram_size = static_cast<int>(ascii_ngram_size);
+    config.kanji_ngram_size = static_cast<int>(kanji_ngram_size);
+    config.max_threads = max_threads;
+    config.nfkc = nfkc ? 1 : 0;
+    config.lower = lower ? 1 : 0;
+    config.distinct = distinct ? 1 : 0;
+
+    bool has_width;
+    NAPI_CALL(env, napi_has_named_property(env, options, "width", &has_width));
+    if (has_width) {
+      napi_value width_val;
+      NAPI_CALL(env, napi_get_named_property(env, options, "width", &width_val));
+      NAPI_CALL(env, GetStringValue(env, width_val, &width));
+      config.width = width.c_str();
+    }
+
+    bool has_output;
+    NAPI_CALL(env, napi_has_named_property(env, options, "output", &has_output));
+    if (has_output) {
+      napi_value output_val;
+      std::string output;
+      NAPI_CALL(env, napi_get_named_property(env, options, "output", &output_val));
+      NAPI_CALL(env, GetStringValue(env, output_val, &output));
+      if (output == "hashes") {
+        config.output = MYGRAM_NGRAM_BATCH_HASHES;
+      } else if (output == "ngrams") {
+        config.output = MYGRAM_NGRAM_BATCH_NGRAMS;
+      } else if (output != "counts") {
+        ThrowError(env, "output must be 'counts', 'hashes' or 'ngrams'");
+        return nullptr;
+      }
+    }
+  }
+
+  MygramNgramBatch_C* batch = nullptr;
+  if (mygramclient_ngram_batch(data, offsets, count, &config, &batch) != 0 || batch == nullptr) {
+    ThrowError(env, "Failed to split documents");
+    return nullptr;
+  }
+
+  // Copy out of the C result so it can be freed before any early return
+  std::vector<uint32_t> counts(batch->counts, batch->counts + batch->count);
+  std::vector<uint32_t> document_offsets;
+  if (batch->document_offsets != nullptr) {
+    document_offsets.assign(batch->document_offsets, batch->document_offsets + batch->count + 1);
+  }
+  std::vector<uint64_t> hashes(batch->hashes, batch->hashes + batch->hash_count);
+  std::string ngram_data;
+  std::vector<uint32_t> ngram_offsets;
+  if (batch->data != nullptr) {
+    ngram_data.assign(batch->data, batch->data_size);
+    ngram_offsets.assign(batch->ngram_offsets, batch->ngram_offsets + batch->ngram_count + 1);
+  }
+  mygramclient_free_ngram_batch(batch);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+
+  napi_value counts_val;
+  NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint32_array, counts.data(), counts.size(), sizeof(uint32_t),
+                                      &counts_val));
+  NAPI_CALL(env, napi_set_named_property(env, result, "counts", counts_val));
+
+  if (config.output != MYGRAM_NGRAM_BATCH_COUNTS) {
+    napi_value offsets_val;
+    NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint32_array, document_offsets.data(), document_offsets.size(),
+                                        sizeof(uint32_t), &offsets_val));
+    NAPI_CALL(env, napi_set_named_property(env, result, "document_offsets", offsets_val));
+  }
+
+  if (config.output == MYGRAM_NGRAM_BATCH_HASHES) {
+    napi_value hashes_val;
+    NAPI_CALL(env, CreateTypedArrayCopy(env, napi_biguint64_array, hashes.data(), hashes.size(), sizeof(uint64_t),
+                                        &hashes_val));
+    NAPI_CALL(env, napi_set_named_property(env, result, "hashes", hashes_val));
+  } else if (config.output == MYGRAM_NGRAM_BATCH_NGRAMS) {
+    Utf8OffsetsToUtf16(ngram_data.c_str(), ngram_offsets.data(), ngram_offsets.size());
+
+    napi_value data_val;
+    NAPI_CALL(env, napi_create_string_utf8(env, ngram_data.c_str(), ngram_data.size(), &data_val));
+    NAPI_CALL(env, napi_set_named_property(env, result, "data", data_val));
+
+    napi_value ngram_offsets_val;
+    NAPI_CALL(env, CreateTypedArrayCopy(env, napi_uint32_array, ngram_offsets.data(), ngram_offsets.size(),
+                                        sizeof(uint32_t), &ngram_offsets_val));
+    NAPI_CALL(env, napi_set_named_property(env, result, "ngram_offsets", ngram_offsets_val));
+  }
+
+  return result;
+}
+
+/**
+ * Create an in-process n-gram index
+ *
+ * @param {Object} [options] - asciiNgramSize, kanjiNgramSize, nfkc, width, lower
+ *   (omitted: NFKC, narrow width and the default n-gram sizes)
+ * @returns {External} Index handle
+ */
+static napi_value CreateLocalIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  napi_valuetype options_type = napi_undefined;
+  if (argc >= 1) {
+    NAPI_CALL(env, napi_typeof(env, args[0], &options_type));
+  }
+
+  MygramLocalIndexConfig_C config = {};
+  std::string width = "keep";
+  bool use_config = options_type == napi_object;
+  if (use_config) {
+    uint32_t ascii_ngram_size = 0;
+    uint32_t kanji_ngram_size = 0;
+    bool nfkc = false;
+    bool lower = false;
+    NAPI_CALL(env, GetOptionalUint32Property(env, args[0], "asciiNgramSize", &ascii_ngram_size));
+    NAPI_CALL(env, GetOptionalUint32Property(env, args[0], "kanjiNgramSize", &kanji_ngram_size));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, args[0], "nfkc", &nfkc));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, args[0], "lower", &lower));
+
+    napi_value width_val;
+    napi_valuetype width_type;
+    NAPI_CALL(env, napi_get_named_property(env, args[0], "width", &width_val));
+    NAPI_CALL(env, napi_typeof(env, width_val, &width_type));
+    if (width_type == napi_string) {
+      NAPI_CALL(env, GetStringValue(env, width_val, &width));
+    }
+
+    config.ascii_ngram_size = static_cast<int>(ascii_ngram_size);
+    config.kanji_ngram_size = static_cast<int>(kanji_ngram_size);
+    config.nfkc = nfkc ? 1 : 0;
+    config.width = width.c_str();
+    config.lower = lower ? 1 : 0;
+  }
+
+  MygramLocalIndex_C* index = mygramclient_local_index_create(use_config ? &config : nullptr);
+  if (index == nullptr) {
+    ThrowError(env, "Failed to create local index");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, index, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Destroy an in-process n-gram index
+ *
+ * @param {External} index - Index handle
+ */
+static napi_value DestroyLocalIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected index handle");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  mygramclient_local_index_destroy(index);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+// Helper to read an optional JS array of strings (empty when undefined or null)
+static napi_status GetOptionalStringArray(napi_env env, napi_value value, std::vector<std::string>* out) {
+  napi_valuetype type;
+  napi_status status = napi_typeof(env, value, &type);
+  if (status != napi_ok || type == napi_undefined || type == napi_null) {
+    out->clear();
+    return status;
+  }
+  return GetStringArray(env, value, out);
+}
+
+/**
+ * Add a document to a local index, replacing any document with the same primary key
+ *
+ * @param {External} index - Index handle
+ * @param {string} primaryKey - Primary key
+ * @param {string} text - Indexed text
+ * @param {string[]} [fieldKeys] - Filter field names
+ * @param {string[]} [fieldValues] - Filter field values
+ */
+static napi_value LocalIndexAdd(napi_env env, napi_callback_info info) {
+  size_t argc = 5;
+  napi_value args[5];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 3) {
+    ThrowError(env, "Expected at least 3 arguments: index, primaryKey, text");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  std::string primary_key;
+  NAPI_CALL(env, GetStringValue(env, args[1], &primary_key));
+  std::string text;
+  NAPI_CALL(env, GetStringValue(env, args[2], &text));
+
+  std::vector<std::string> field_keys;
+  std::vector<std::string> field_values;
+  if (argc >= 5) {
+    NAPI_CALL(env, GetOptionalStringArray(env, args[3], &field_keys));
+    NAPI_CALL(env, GetOptionalStringArray(env, args[4], &field_values));
+  }
+  if (field_keys.size() != field_values.size()) {
+    ThrowError(env, "Field keys and values must have the same length");
+    return nullptr;
+  }
+  auto field_key_ptrs = ToCStringArray(field_keys);
+  auto field_value_ptrs = ToCStringArray(field_values);
+
+  if (mygramclient_local_index_add(index, primary_key.c_str(), text.data(), text.size(), field_key_ptrs.data(),
+                                   field_value_ptrs.data(), field_keys.size()) != 0) {
+    ThrowError(env, "Failed to add document");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Remove a document from a local index
+ *
+ * @param {External} index - Index handle
+ * @param {string} primaryKey - Primary key
+ * @returns {boolean} True if the document was indexed
+ */
+static napi_value LocalIndexRemove(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: index, primaryKey");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  std::string primary_key;
+  NAPI_CALL(env, GetStringValue(env, args[1], &primary_key));
+
+  int rc = mygramclient_local_index_remove(index, primary_key.c_str());
+  if (rc < 0) {
+    ThrowError(env, "Failed to remove document");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, rc == 1, &result));
+  return result;
+}
+
+/**
+ * Search a local index
+ *
+ * @param {External} index - Index handle
+ * @param {string} query - Search query text
+ * @param {number} limit - Maximum number of results (0 for all)
+ * @param {number} offset - Result offset
+ * @param {string[]} [andTerms] - Additional required terms
+ * @param {string[]} [notTerms] - Excluded terms
+ * @param {string[]} [filterKeys] - Filter field names
+ * @param {string[]} [filterValues] - Filter values
+ * @param {string} [sortColumn] - Field to sort by (empty for primary key)
+ * @param {boolean} [sortDesc=true] - Sort descending
+ * @returns {Object} { total_count, primary_keys }
+ * @throws {Error} If the query has no positive term
+ */
+static napi_value LocalIndexSearch(napi_env env, napi_callback_info info) {
+  size_t argc = 10;
+  napi_value args[10];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 4) {
+    ThrowError(env, "Expected at least 4 arguments: index, query, limit, offset");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  std::string query;
+  NAPI_CALL(env, GetStringValue(env, args[1], &query));
+  uint32_t limit;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[2], &limit));
+  uint32_t offset;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[3], &offset));
+
+  std::vector<std::string> lists[4];  // and, not, filter keys, filter values
+  for (size_t i = 0; i < 4 && 4 + i < argc; i++) {
+    NAPI_CALL(env, GetOptionalStringArray(env, args[4 + i], &lists[i]));
+  }
+  if (lists[2].size() != lists[3].size()) {
+    ThrowError(env, "Filter keys and values must have the same length");
+    return nullptr;
+  }
+
+  std::string sort_column;
+  if (argc >= 9) {
+    napi_valuetype sort_type;
+    NAPI_CALL(env, napi_typeof(env, args[8], &sort_type));
+    if (sort_type == napi_string) {
+      NAPI_CALL(env, GetStringValue(env, args[8], &sort_column));
+    }
+  }
+  bool sort_desc = true;
+  if (argc >= 10) {
+    napi_valuetype desc_type;
+    NAPI_CALL(env, napi_typeof(env, args[9], &desc_type));
+    if (desc_type == napi_boolean) {
+      NAPI_CALL(env, napi_get_value_bool(env, args[9], &sort_desc));
+    }
+  }
+
+  auto and_ptrs = ToCStringArray(lists[0]);
+  auto not_ptrs = ToCStringArray(lists[1]);
+  auto key_ptrs = ToCStringArray(lists[2]);
+  auto value_ptrs = ToCStringArray(lists[3]);
+
+  MygramSearchResult_C* search_result = nullptr;
+  if (mygramclient_local_index_search(index, query.c_str(), limit, offset, and_ptrs.data(), and_ptrs.size(),
+                                      not_ptrs.data(), not_ptrs.size(), key_ptrs.data(), value_ptrs.data(),
+                                      key_ptrs.size(), sort_column.c_str(), sort_desc ? 1 : 0,
+                                      &search_result) != 0 ||
+      search_result == nullptr) {
+    ThrowError(env, mygramclient_local_index_get_last_error(index));
+    return nullptr;
+  }
+
+  // Copy out of the C result so it can be freed before any early return
+  uint64_t total_count = search_result->total_count;
+  std::vector<std::string> primary_keys(search_result->primary_keys,
+                                        search_result->primary_keys + search_result->count);
+  mygramclient_free_search_result(search_result);
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, SetNumberProperty(env, result, "total_count", static_cast<double>(total_count)));
+
+  napi_value primary_keys_arr;
+  NAPI_CALL(env, CreateStringArray(env, primary_keys, &primary_keys_arr));
+  NAPI_CALL(env, napi_set_named_property(env, result, "primary_keys", primary_keys_arr));
+  return result;
+}
+
+/**
+ * Count matching documents in a local index
+ *
+ * @param {External} index - Index handle
+ * @param {string} query - Search query text
+ * @param {string[]} [andTerms] - Additional required terms
+ * @param {string[]} [notTerms] - Excluded terms
+ * @param {string[]} [filterKeys] - Filter field names
+ * @param {string[]} [filterValues] - Filter values
+ * @returns {number} Matching documents
+ * @throws {Error} If the query has no positive term
+ */
+static napi_value LocalIndexCount(napi_env env, napi_callback_info info) {
+  size_t argc = 6;
+  napi_value args[6];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected at least 2 arguments: index, query");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  std::string query;
+  NAPI_CALL(env, GetStringValue(env, args[1], &query));
+
+  std::vector<std::string> lists[4];  // and, not, filter keys, filter values
+  for (size_t i = 0; i < 4 && 2 + i < argc; i++) {
+    NAPI_CALL(env, GetOptionalStringArray(env, args[2 + i], &lists[i]));
+  }
+  if (lists[2].size() != lists[3].size()) {
+    ThrowError(env, "Filter keys and values must have the same length");
+    return nullptr;
+  }
+
+  auto and_ptrs = ToCStringArray(lists[0]);
+  auto not_ptrs = ToCStringArray(lists[1]);
+  auto key_ptrs = ToCStringArray(lists[2]);
+  auto value_ptrs = ToCStringArray(lists[3]);
+
+  uint64_t count = 0;
+  if (mygramclient_local_index_count(index, query.c_str(), and_ptrs.data(), and_ptrs.size(), not_ptrs.data(),
+                                     not_ptrs.size(), key_ptrs.data(), value_ptrs.data(), key_ptrs.size(),
+                                     &count) != 0) {
+    ThrowError(env, mygramclient_local_index_get_last_error(index));
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_double(env, static_cast<double>(count), &result));
+  return result;
+}
+
+/**
+ * Get local index counters
+ *
+ * @param {External} index - Index handle
+ * @returns {Object} { documents, removed, ngrams, postings, posting_bytes }
+ */
+static napi_value GetLocalIndexStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected index handle");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  MygramLocalIndexStats_C stats = {};
+  if (mygramclient_local_index_stats(index, &stats) != 0) {
+    ThrowError(env, "Failed to read local index stats");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, SetNumberProperty(env, result, "documents", static_cast<double>(stats.documents)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "removed", static_cast<double>(stats.removed)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "ngrams", static_cast<double>(stats.ngrams)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "postings", static_cast<double>(stats.postings)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "posting_bytes", static_cast<double>(stats.posting_bytes)));
+  return result;
+}
+
+/**
+ * Rebuild local index posting lists without removed documents
+ *
+ * @param {External} index - Index handle
+ */
+static napi_value CompactLocalIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected index handle");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  mygramclient_local_index_compact(index);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Remove all documents from a local index
+ *
+ * @param {External} index - Index handle
+ */
+static napi_value ClearLocalIndex(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected index handle");
+    return nullptr;
+  }
+
+  MygramLocalIndex_C* index;
+  NAPI_CALL(env, napi_get_value_external(env, args[0], reinterpret_cast<void**>(&index)));
+
+  mygramclient_local_index_clear(index);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+// Helper to read the n-gram filter handle passed as the first argument
+static napi_status GetNgramFilter(napi_env env, napi_value value, MygramNgramFilter_C** filter) {
+  return napi_get_value_external(env, value, reinterpret_cast<void**>(filter));
+}
+
+/**
+ * Create a Bloom filter of a table's n-grams
+ *
+ * @param {number} expectedNgrams - Distinct n-grams the filter is sized for
+ * @param {Object} [options] - asciiNgramSize, kanjiNgramSize, nfkc, width, lower, bitsPerNgram
+ *   (omitted: NFKC, narrow width and the defaults)
+ * @returns {External} Filter handle
+ */
+static napi_value CreateNgramFilter(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected expected n-gram count");
+    return nullptr;
+  }
+
+  double expected_ngrams = 0;
+  NAPI_CALL(env, napi_get_value_double(env, args[0], &expected_ngrams));
+
+  napi_valuetype options_type = napi_undefined;
+  if (argc >= 2) {
+    NAPI_CALL(env, napi_typeof(env, args[1], &options_type));
+  }
+
+  MygramNgramFilterConfig_C config = {};
+  std::string width = "keep";
+  bool use_config = options_type == napi_object;
+  if (use_config) {
+    uint32_t ascii_ngram_size = 0;
+    uint32_t kanji_ngram_size = 0;
+    bool nfkc = false;
+    bool lower = false;
+    NAPI_CALL(env, GetOptionalUint32Property(env, args[1], "asciiNgramSize", &ascii_ngram_size));
+    NAPI_CALL(env, GetOptionalUint32Property(env, args[1], "kanjiNgramSize", &kanji_ngram_size));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, args[1], "nfkc", &nfkc));
+    NAPI_CALL(env, GetOptionalBoolProperty(env, args[1], "lower", &lower));
+
+    napi_value width_val;
+    napi_valuetype width_type;
+    NAPI_CALL(env, napi_get_named_property(env, args[1], "width", &width_val));
+    NAPI_CALL(env, napi_typeof(env, width_val, &width_type));
+    if (width_type == napi_string) {
+      NAPI_CALL(env, GetStringValue(env, width_val, &width));
+    }
+
+    napi_value bits_val;
+    napi_valuetype bits_type;
+    NAPI_CALL(env, napi_get_named_property(env, args[1], "bitsPerNgram", &bits_val));
+    NAPI_CALL(env, napi_typeof(env, bits_val, &bits_type));
+    if (bits_type == napi_number) {
+      NAPI_CALL(env, napi_get_value_double(env, bits_val, &config.bits_per_ngram));
+    }
+
+    config.ascii_ngram_size = static_cast<int>(ascii_ngram_size);
+    config.kanji_ngram_size = static_cast<int>(kanji_ngram_size);
+    config.nfkc = nfkc ? 1 : 0;
+    config.width = width.c_str();
+    config.lower = lower ? 1 : 0;
+  }
+
+  MygramNgramFilter_C* filter = mygramclient_ngram_filter_create(
+      expected_ngrams > 0 ? static_cast<size_t>(expected_ngrams) : 0, use_config ? &config : nullptr);
+  if (filter == nullptr) {
+    ThrowError(env, "Failed to create n-gram filter");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, filter, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Restore a Bloom filter of a table's n-grams from serializeNgramFilter output
+ *
+ * @param {Uint8Array} data - Serialized filter
+ * @returns {External} Filter handle
+ */
+static napi_value DeserializeNgramFilter(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  bool is_typedarray = false;
+  if (argc >= 1) {
+    NAPI_CALL(env, napi_is_typedarray(env, args[0], &is_typedarray));
+  }
+  napi_typedarray_type data_type = napi_int8_array;
+  size_t length = 0;
+  void* data = nullptr;
+  if (is_typedarray) {
+    NAPI_CALL(env, napi_get_typedarray_info(env, args[0], &data_type, &length, &data, nullptr, nullptr));
+  }
+  if (!is_typedarray || data_type != napi_uint8_array) {
+    ThrowError(env, "Expected Uint8Array");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter =
+      mygramclient_ngram_filter_deserialize(length > 0 ? static_cast<const uint8_t*>(data) : nullptr, length);
+  if (filter == nullptr) {
+    ThrowError(env, "Invalid n-gram filter data");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_external(env, filter, nullptr, nullptr, &result));
+  return result;
+}
+
+/**
+ * Destroy a Bloom filter of a table's n-grams
+ *
+ * @param {External} filter - Filter handle
+ */
+static napi_value DestroyNgramFilter(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected filter handle");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter;
+  NAPI_CALL(env, GetNgramFilter(env, args[0], &filter));
+
+  mygramclient_ngram_filter_destroy(filter);
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Add document texts or n-gram hashes to a filter
+ *
+ * @param {External} filter - Filter handle
+ * @param {string | string[] | BigUint64Array} input - Document text(s), or hashes of normalized text
+ */
+static napi_value NgramFilterAdd(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: filter, input");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter;
+  NAPI_CALL(env, GetNgramFilter(env, args[0], &filter));
+
+  bool is_typedarray = false;
+  bool is_array = false;
+  NAPI_CALL(env, napi_is_typedarray(env, args[1], &is_typedarray));
+  NAPI_CALL(env, napi_is_array(env, args[1], &is_array));
+
+  int status = 0;
+  if (is_typedarray) {
+    napi_typedarray_type type;
+    size_t count = 0;
+    void* data = nullptr;
+    NAPI_CALL(env, napi_get_typedarray_info(env, args[1], &type, &count, &data, nullptr, nullptr));
+    if (type != napi_biguint64_array) {
+      ThrowError(env, "Expected BigUint64Array of n-gram hashes");
+      return nullptr;
+    }
+    status = mygramclient_ngram_filter_add_hashes(filter, static_cast<const uint64_t*>(data), count);
+  } else if (is_array) {
+    std::vector<std::string> texts;
+    NAPI_CALL(env, GetStringArray(env, args[1], &texts));
+    for (size_t i = 0; i < texts.size() && status == 0; i++) {
+      status = mygramclient_ngram_filter_add_text(filter, texts[i].data(), texts[i].size());
+    }
+  } else {
+    std::string text;
+    NAPI_CALL(env, GetStringValue(env, args[1], &text));
+    status = mygramclient_ngram_filter_add_text(filter, text.data(), text.size());
+  }
+  if (status != 0) {
+    ThrowError(env, "Failed to add to n-gram filter");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_undefined(env, &result));
+  return result;
+}
+
+/**
+ * Check whether a term may match any document of a filter's table
+ *
+ * @param {External} filter - Filter handle
+ * @param {string} term - Search term
+ * @returns {boolean} False if an n-gram of the term was never added
+ */
+static napi_value NgramFilterMayMatch(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value args[2];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected 2 arguments: filter, term");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter;
+  NAPI_CALL(env, GetNgramFilter(env, args[0], &filter));
+
+  std::string term;
+  NAPI_CALL(env, GetStringValue(env, args[1], &term));
+
+  int match = mygramclient_ngram_filter_may_match(filter, term.c_str());
+  if (match < 0) {
+    ThrowError(env, "Invalid filter handle");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_get_boolean(env, match == 1, &result));
+  return result;
+}
+
+/**
+ * Get n-gram filter counters
+ *
+ * @param {External} filter - Filter handle
+ * @returns {Object} { ngrams, size_bytes, hash_count, false_positive_rate }
+ */
+static napi_value GetNgramFilterStats(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected filter handle");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter;
+  NAPI_CALL(env, GetNgramFilter(env, args[0], &filter));
+
+  MygramNgramFilterStats_C stats = {};
+  if (mygramclient_ngram_filter_stats(filter, &stats) != 0) {
+    ThrowError(env, "Failed to read n-gram filter stats");
+    return nullptr;
+  }
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  NAPI_CALL(env, SetNumberProperty(env, result, "ngrams", static_cast<double>(stats.ngrams)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "size_bytes", static_cast<double>(stats.size_bytes)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "hash_count", static_cast<double>(stats.hash_count)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "false_positive_rate", stats.false_positive_rate));
+  return result;
+}
+
+/**
+ * Serialize an n-gram filter
+ *
+ * @param {External} filter - Filter handle
+ * @returns {Uint8Array} Serialized filter (see deserializeNgramFilter)
+ */
+static napi_value SerializeNgramFilter(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value args[1];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 1) {
+    ThrowError(env, "Expected filter handle");
+    return nullptr;
+  }
+
+  MygramNgramFilter_C* filter;
+  NAPI_CALL(env, GetNgramFilter(env, args[0], &filter));
+
+  uint8_t* data = nullptr;
+  size_t length = 0;
+  if (mygramclient_ngram_filter_serialize(filter, &data, &length) != 0) {
+    ThrowError(env, "Failed to serialize n-gram filter");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_status copy_status = CreateTypedArrayCopy(env, napi_uint8_array, data, length, sizeof(uint8_t), &result);
+  mygramclient_free_ngram_filter_data(data);
+  NAPI_CALL(env, copy_status);
+  return result;
+}
+
+// Helper to read optional { nfkc, width, lower } term normalization (width must outlive out)
+static napi_status GetQueryNormalization(napi_env env, napi_value value, MygramQueryNormalization_C* out,
+                                         std::string* width) {
+  napi_valuetype type;
+  napi_status status = napi_typeof(env, value, &type);
+  if (status != napi_ok || type != napi_object) {
+    return status;
+  }
+  bool nfkc = false;
+  bool lower = false;
+  status = GetOptionalBoolProperty(env, value, "nfkc", &nfkc);
+  if (status == napi_ok) {
+    status = GetOptionalBoolProperty(env, value, "lower", &lower);
+  }
+  if (status != napi_ok) {
+    return status;
+  }
+  out->nfkc = nfkc ? 1 : 0;
+  out->lower = lower ? 1 : 0;
+
+  napi_value width_val;
+  status = napi_get_named_property(env, value, "width", &width_val);
+  if (status != napi_ok) {
+    return status;
+  }
+  status = napi_typeof(env, width_val, &type);
+  if (status != napi_ok || type != napi_string) {
+    return status;
+  }
+  status = GetStringValue(env, width_val, width);
+  out->width = width->c_str();
+  return status;
+}
+
+/**
+ * Build the canonical SEARCH command for a query
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {number} limit - Maximum results (0 = server default)
+ * @param {number} offset - Result offset
+ * @param {string[]} [andTerms] - Additional required terms
+ * @param {string[]} [notTerms] - Excluded terms
+ * @param {string[]} [filterKeys] - Filter field names
+ * @param {string[]} [filterValues] - Filter values
+ * @param {string} [sortColumn] - Sort column (empty for the primary key)
+ * @param {boolean} [sortDesc=true] - Sort descending
+ * @param {Object} [normalization] - { nfkc, width, lower } applied to terms
+ * @returns {string} Canonical key
+ */
+static napi_value CanonicalSearchKey(napi_env env, napi_callback_info info) {
+  size_t argc = 11;
+  napi_value args[11];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 4) {
+    ThrowError(env, "Expected at least 4 arguments: table, query, limit, offset");
+    return nullptr;
+  }
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[0], &table));
+  std::string query;
+  NAPI_CALL(env, GetStringValue(env, args[1], &query));
+  uint32_t limit;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[2], &limit));
+  uint32_t offset;
+  NAPI_CALL(env, napi_get_value_uint32(env, args[3], &offset));
+
+  std::vector<std::string> lists[4];  // and, not, filter keys, filter values
+  for (size_t i = 0; i < 4 && 4 + i < argc; i++) {
+    NAPI_CALL(env, GetOptionalStringArray(env, args[4 + i], &lists[i]));
+  }
+  if (lists[2].size() != lists[3].size()) {
+    ThrowError(env, "Filter keys and values must have the same length");
+    return nullptr;
+  }
+
+  std::string sort_column;
+  if (argc >= 9) {
+    napi_valuetype sort_type;
+    NAPI_CALL(env, napi_typeof(env, args[8], &sort_type));
+    if (sort_type == napi_string) {
+      NAPI_CALL(env, GetStringValue(env, args[8], &sort_column));
+    }
+  }
+  bool sort_desc = true;
+  if (argc >= 10) {
+    napi_valuetype desc_type;
+    NAPI_CALL(env, napi_typeof(env, args[9], &desc_type));
+    if (desc_type == napi_boolean) {
+      NAPI_CALL(env, napi_get_value_bool(env, args[9], &sort_desc));
+    }
+  }
+  MygramQueryNormalization_C normalization = {};
+  std::string width;
+  if (argc >= 11) {
+    NAPI_CALL(env, GetQueryNormalization(env, args[10], &normalization, &width));
+  }
+
+  auto and_ptrs = ToCStringArray(lists[0]);
+  auto not_ptrs = ToCStringArray(lists[1]);
+  auto key_ptrs = ToCStringArray(lists[2]);
+  auto value_ptrs = ToCStringArray(lists[3]);
+
+  char* key = nullptr;
+  if (mygramclient_canonical_search_key(table.c_str(), query.c_str(), and_ptrs.data(), and_ptrs.size(),
+                                        not_ptrs.data(), not_ptrs.size(), key_ptrs.data(), value_ptrs.data(),
+                                        key_ptrs.size(), sort_column.c_str(), sort_desc ? 1 : 0, limit, offset,
+                                        &normalization, &key) != 0) {
+    ThrowError(env, "Failed to build canonical search key");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_status create_status = napi_create_string_utf8(env, key, NAPI_AUTO_LENGTH, &result);
+  mygramclient_free_string(key);
+  NAPI_CALL(env, create_status);
+  return result;
+}
+
+/**
+ * Build the canonical COUNT command for a query
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {string[]} [andTerms] - Additional required terms
+ * @param {string[]} [notTerms] - Excluded terms
+ * @param {string[]} [filterKeys] - Filter field names
+ * @param {string[]} [filterValues] - Filter values
+ * @param {Object} [normalization] - { nfkc, width, lower } applied to terms
+ * @returns {string} Canonical key
+ */
+static napi_value CanonicalCountKey(napi_env env, napi_callback_info info) {
+  size_t argc = 7;
+  napi_value args[7];
+  NAPI_CALL(env, napi_get_cb_info(env, info, &argc, args, nullptr, nullptr));
+
+  if (argc < 2) {
+    ThrowError(env, "Expected at least 2 arguments: table, query");
+    return nullptr;
+  }
+
+  std::string table;
+  NAPI_CALL(env, GetStringValue(env, args[0], &table));
+  std::string query;
+  NAPI_CALL(env, GetStringValue(env, args[1], &query));
+
+  std::vector<std::string> lists[4];  // and, not, filter keys, filter values
+  for (size_t i = 0; i < 4 && 2 + i < argc; i++) {
+    NAPI_CALL(env, GetOptionalStringArray(env, args[2 + i], &lists[i]));
+  }
+  if (lists[2].size() != lists[3].size()) {
+    ThrowError(env, "Filter keys and values must have the same length");
+    return nullptr;
+  }
+  MygramQueryNormalization_C normalization = {};
+  std::string width;
+  if (argc >= 7) {
+    NAPI_CALL(env, GetQueryNormalization(env, args[6], &normalization, &width));
+  }
+
+  auto and_ptrs = ToCStringArray(lists[0]);
+  auto not_ptrs = ToCStringArray(lists[1]);
+  auto key_ptrs = ToCStringArray(lists[2]);
+  auto value_ptrs = ToCStringArray(lists[3]);
+
+  char* key = nullptr;
+  if (mygramclient_canonical_count_key(table.c_str(), query.c_str(), and_ptrs.data(), and_ptrs.size(),
+                                       not_ptrs.data(), not_ptrs.size(), key_ptrs.data(), value_ptrs.data(),
+                                       key_ptrs.size(), &normalization, &key) != 0) {
+    ThrowError(env, "Failed to build canonical count key");
+    return nullptr;
+  }
+
+  napi_value result;
+  napi_status create_status = napi_create_string_utf8(env, key, NAPI_AUTO_LENGTH, &result);
+  mygramclient_free_string(key);
+  NAPI_CALL(env, create_status);
+  return result;
+}
+
+/**
+ * Read the memory health of the host or, in a container, of its cgroup
+ *
+ * @returns {Object} { status: 'HEALTHY' | 'WARNING' | 'CRITICAL' | 'UNKNOWN', total_physical_bytes,
+ *                     available_physical_bytes, cgroup_limited }
+ */
+static napi_value GetMemoryHealth(napi_env env, napi_callback_info /*info*/) {
+  MygramMemoryHealth_C health = {};
+  if (mygramclient_get_memory_health(&health) != 0) {
+    ThrowError(env, "Failed to read memory health");
+    return nullptr;
+  }
+
+  static const char* const kStatusNames[] = { "HEALTHY", "WARNING", "CRITICAL", "UNKNOWN" };
+  const char* status_name = health.status >= 0 && health.status <= 3 ? kStatusNames[health.status] : "UNKNOWN";
+
+  napi_value result;
+  NAPI_CALL(env, napi_create_object(env, &result));
+  napi_value status_value;
+  NAPI_CALL(env, napi_create_string_utf8(env, status_name, NAPI_AUTO_LENGTH, &status_value));
+  NAPI_CALL(env, napi_set_named_property(env, result, "status", status_value));
+  NAPI_CALL(env,
+            SetNumberProperty(env, result, "total_physical_bytes", static_cast<double>(health.total_physical_bytes)));
+  NAPI_CALL(env, SetNumberProperty(env, result, "available_physical_bytes",
+                                   static_cast<double>(health.available_physical_bytes)));
+  napi_value cgroup_limited;
+  NAPI_CALL(env, napi_get_boolean(env, health.cgroup_limited != 0, &cgroup_limited));
+  NAPI_CALL(env, napi_set_named_property(env, result, "cgroup_limited", cgroup_limited));
+  return result;
+}
+
 /**
  * Get last error message
  *
@@ -334,6 +2845,50 @@ static napi_value Init(napi_env env, napi_value exports) {
     { "destroyClient", nullptr, DestroyClient, nullptr, nullptr, nullptr, napi_default, nullptr },
     { "isConnected", nullptr, IsConnected, nullptr, nullptr, nullptr, napi_default, nullptr },
     { "search", nullptr, SearchSimple, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "get", nullptr, GetDocument, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getColumns", nullptr, GetColumns, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "setFieldSchema", nullptr, SetFieldSchema, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getFieldSchema", nullptr, GetFieldSchema, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "info", nullptr, Info, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "createInfoPoller", nullptr, CreateInfoPoller, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "startInfoPoller", nullptr, StartInfoPoller, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "destroyInfoPoller", nullptr, DestroyInfoPoller, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getInfoSnapshot", nullptr, GetInfoSnapshot, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getInfoPollerError", nullptr, GetInfoPollerError, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "createMetricsCollector", nullptr, CreateMetricsCollector, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "startMetricsCollector", nullptr, StartMetricsCollector, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "destroyMetricsCollector", nullptr, DestroyMetricsCollector, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getServerMetrics", nullptr, GetServerMetrics, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getMetricsCollectorError", nullptr, GetMetricsCollectorError, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "createExpressionCache", nullptr, CreateExpressionCache, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "destroyExpressionCache", nullptr, DestroyExpressionCache, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "parseExpressionCached", nullptr, ParseExpressionCached, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getExpressionCacheStats", nullptr, GetExpressionCacheStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "resizeExpressionCache", nullptr, ResizeExpressionCache, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "clearExpressionCache", nullptr, ClearExpressionCache, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "convertSearchExpressions", nullptr, ConvertSearchExpressions, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "estimateQueryCost", nullptr, EstimateQueryCost, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "canonicalSearchKey", nullptr, CanonicalSearchKey, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "canonicalCountKey", nullptr, CanonicalCountKey, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ngramHashes", nullptr, NgramHashes, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ngramBatch", nullptr, NgramBatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "createLocalIndex", nullptr, CreateLocalIndex, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "destroyLocalIndex", nullptr, DestroyLocalIndex, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "localIndexAdd", nullptr, LocalIndexAdd, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "localIndexRemove", nullptr, LocalIndexRemove, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "localIndexSearch", nullptr, LocalIndexSearch, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "localIndexCount", nullptr, LocalIndexCount, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getLocalIndexStats", nullptr, GetLocalIndexStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "compactLocalIndex", nullptr, CompactLocalIndex, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "clearLocalIndex", nullptr, ClearLocalIndex, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "createNgramFilter", nullptr, CreateNgramFilter, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "deserializeNgramFilter", nullptr, DeserializeNgramFilter, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "destroyNgramFilter", nullptr, DestroyNgramFilter, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ngramFilterAdd", nullptr, NgramFilterAdd, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "ngramFilterMayMatch", nullptr, NgramFilterMayMatch, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getNgramFilterStats", nullptr, GetNgramFilterStats, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "serializeNgramFilter", nullptr, SerializeNgramFilter, nullptr, nullptr, nullptr, napi_default, nullptr },
+    { "getMemoryHealth", nullptr, GetMemoryHealth, nullptr, nullptr, nullptr, napi_default, nullptr },
     { "getLastError", nullptr, GetLastError, nullptr, nullptr, nullptr, napi_default, nullptr }
   };
 
@@ -0,0 +1,313 @@
+/**
+ * @file builtin_normalizer.cpp
+ * @brief Table-based text normalization for builds without ICU
+ *
+ * Replays the steps of the ICU path (NFKC, the Fullwidth-Halfwidth or
+ * Halfwidth-Fullwidth transliterator, root-locale lowercasing) with tables
+ * generated from ICU by native/tools/gen_normalization_tables.cpp.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "string_utils.h"
+#include "utf8_decode.h"
+
+namespace mygramdb::utils {
+
+namespace {
+
+/**
+ * @brief Codepoint mapped to pool[offset, offset + length)
+ */
+struct NormalizationMapping {
+  uint32_t codepoint;
+  uint16_t offset;
+  uint8_t length;
+};
+
+/**
+ * @brief Pair of codepoints composed into one
+ */
+struct Composition {
+  uint32_t first;
+  uint32_t second;
+  uint32_t composed;
+};
+
+/**
+ * @brief Inclusive range of codepoints
+ */
+struct CodepointRange {
+  uint32_t first;
+  uint32_t last;
+};
+
+/**
+ * @brief Inclusive range of codepoints with one canonical combining class
+ */
+struct CombiningClassRange {
+  uint32_t first;
+  uint32_t last;
+  uint8_t combining_class;
+};
+
+#include "normalization_tables.inc"
+
+// Hangul syllable decomposition and composition (Unicode 3.12)
+constexpr uint32_t kHangulSBase = 0xAC00;
+constexpr uint32_t kHangulLBase = 0x1100;
+constexpr uint32_t kHangulVBase = 0x1161;
+constexpr uint32_t kHangulTBase = 0x11A7;  // One before the first trailing consonant
+constexpr uint32_t kHangulLCount = 19;
+constexpr uint32_t kHangulVCount = 21;
+constexpr uint32_t kHangulTCount = 28;
+constexpr uint32_t kHangulNCount = kHangulVCount * kHangulTCount;
+constexpr uint32_t kHangulSCount = kHangulLCount * kHangulNCount;
+
+constexpr uint32_t kFirstCombiningMark = 0x0300;  // No codepoint below has a non-zero combining class
+constexpr uint32_t kAsciiLimit = 0x80;
+constexpr uint32_t kCapitalSigma = 0x03A3;
+constexpr uint32_t kFinalSigma = 0x03C2;
+
+/**
+ * @brief Append the mapping of a codepoint from a table, or the codepoint itself
+ */
+template <size_t N, size_t P>
+void AppendMapped(const NormalizationMapping (&mappings)[N], const uint32_t (&pool)[P], uint32_t codepoint,
+                  std::vector<uint32_t>& out) {
+  if (codepoint >= mappings[0].codepoint && codepoint <= mappings[N - 1].codepoint) {
+    const auto* it = std::lower_bound(
+        std::begin(mappings), std::end(mappings), codepoint,
+        [](const NormalizationMapping& mapping, uint32_t value) { return mapping.codepoint < value; });
+    if (it->codepoint == codepoint) {
+      out.insert(out.end(), pool + it->offset, pool + it->offset + it->length);
+      return;
+    }
+  }
+  out.push_back(codepoint);
+}
+
+/**
+ * @brief Map every codepoint through a table
+ */
+template <size_t N, size_t P>
+void MapCodepoints(const std::vector<uint32_t>& in, const NormalizationMapping (&mappings)[N],
+                   const uint32_t (&pool)[P], std::vector<uint32_t>& out) {
+  out.clear();
+  for (uint32_t codepoint : in) {
+    AppendMapped(mappings, pool, codepoint, out);
+  }
+}
+
+/**
+ * @brief Composition of a pair from a table sorted by (first, second), or 0
+ */
+template <size_t N>
+uint32_t ComposePair(const Composition (&compositions)[N], uint32_t first, uint32_t second) {
+  const auto* it = std::lower_bound(std::begin(compositions), std::end(compositions), std::make_pair(first, second),
+                                    [](const Composition& composition, const std::pair<uint32_t, uint32_t>& key) {
+                                      return std::make_pair(composition.first, composition.second) < key;
+                                    });
+  return it != std::end(compositions) && it->first == first && it->second == second ? it->composed : 0;
+}
+
+/**
+ * @brief Canonical composition of two codepoints, Hangul jamo included, or 0
+ */
+uint32_t ComposeCanonicalPair(uint32_t first, uint32_t second) {
+  if (first >= kHangulLBase && first < kHangulLBase + kHangulLCount && second >= kHangulVBase &&
+      second < kHangulVBase + kHangulVCount) {
+    return kHangulSBase + ((first - kHangulLBase) * kHangulVCount + (second - kHangulVBase)) * kHangulTCount;
+  }
+  if (first >= kHangulSBase && first < kHangulSBase + kHangulSCount && (first - kHangulSBase) % kHangulTCount == 0 &&
+      second > kHangulTBase && second < kHangulTBase + kHangulTCount) {
+    return first + (second - kHangulTBase);
+  }
+  return ComposePair(kCanonicalCompositions, first, second);
+}
+
+uint8_t CombiningClass(uint32_t codepoint) {
+  if (codepoint < kFirstCombiningMark) {
+    return 0;
+  }
+  const auto* it =
+      std::upper_bound(std::begin(kCombiningClassRanges), std::end(kCombiningClassRanges), codepoint,
+                       [](uint32_t value, const CombiningClassRange& range) { return value < range.first; });
+  if (it == std::begin(kCombiningClassRanges) || codepoint > std::prev(it)->last) {
+    return 0;
+  }
+  return std::prev(it)->combining_class;
+}
+
+/**
+ * @brief Full compatibility decomposition (NFKD mappings; Hangul syllables arithmetically)
+ */
+void DecomposeCompatibility(const std::vector<uint32_t>& in, std::vector<uint32_t>& out) {
+  out.clear();
+  for (uint32_t codepoint : in) {
+    if (codepoint >= kHangulSBase && codepoint < kHangulSBase + kHangulSCount) {
+      uint32_t index = codepoint - kHangulSBase;
+      out.push_back(kHangulLBase + index / kHangulNCount);
+      out.push_back(kHangulVBase + (index % kHangulNCount) / kHangulTCount);
+      if (index % kHangulTCount != 0) {
+        out.push_back(kHangulTBase + index % kHangulTCount);
+      }
+    } else {
+      AppendMapped(kNfkdMappings, kNfkdPool, codepoint, out);
+    }
+  }
+}
+
+/**
+ * @brief Canonical ordering: stable sort of each run of combining marks by combining class
+ */
+void ReorderMarks(std::vector<uint32_t>& codepoints, std::vector<uint8_t>& classes) {
+  classes.resize(codepoints.size());
+  for (size_t i = 0; i < codepoints.size(); ++i) {
+    classes[i] = CombiningClass(codepoints[i]);
+    // Insertion sort, moving the mark before marks of a higher class
+    for (size_t j = i; j > 0 && classes[j] != 0 && classes[j - 1] > classes[j]; --j) {
+      std::swap(classes[j], classes[j - 1]);
+      std::swap(codepoints[j], codepoints[j - 1]);
+    }
+  }
+}
+
+/**
+ * @brief Canonical composition of canonically ordered codepoints, in place
+ *
+ * Each codepoint composes with the last starter unless a codepoint between
+ * them blocks it (class 0, or a class not below its own).
+ */
+void ComposeCanonical(std::vector<uint32_t>& codepoints, const std::vector<uint8_t>& classes) {
+  size_t kept = 0;
+  size_t starter = 0;
+  bool has_starter = false;
+  uint8_t last_class = 0;
+  for (size_t i = 0; i < codepoints.size(); ++i) {
+    uint32_t codepoint = codepoints[i];
+    uint8_t combining_class = classes[i];
+    if (has_starter && (kept == starter + 1 || (last_class != 0 && last_class < combining_class))) {
+      uint32_t composed = ComposeCanonicalPair(codepoints[starter], codepoint);
+      if (composed != 0) {
+        codepoints[starter] = composed;
+        continue;
+      }
+    }
+    if (combining_class == 0) {
+      starter = kept;
+      has_starter = true;
+    }
+    last_class = combining_class;
+    codepoints[kept++] = codepoint;
+  }
+  codepoints.resize(kept);
+}
+
+/**
+ * @brief Compose adjacent pairs from a table in place
+ */
+template <size_t N>
+void ComposeAdjacent(std::vector<uint32_t>& codepoints, const Composition (&compositions)[N]) {
+  size_t kept = 0;
+  for (size_t i = 0; i < codepoints.size(); ++i) {
+    if (kept > 0) {
+      uint32_t composed = ComposePair(compositions, codepoints[kept - 1], codepoints[i]);
+      if (composed != 0) {
+        codepoints[kept - 1] = composed;
+        continue;
+      }
+    }
+    codepoints[kept++] = codepoints[i];
+  }
+  codepoints.resize(kept);
+}
+
+template <size_t N>
+bool InRanges(const CodepointRange (&ranges)[N], uint32_t codepoint) {
+  const auto* it = std::upper_bound(std::begin(ranges), std::end(ranges), codepoint,
+                                    [](uint32_t value, const CodepointRange& range) { return value < range.first; });
+  return it != std::begin(ranges) && codepoint <= std::prev(it)->last;
+}
+
+/**
+ * @brief Cased letter at the nearest position that is not case-ignorable, scanning from begin by step
+ */
+bool NextNonIgnorableIsCased(const std::vector<uint32_t>& codepoints, size_t begin, ptrdiff_t step) {
+  for (auto i = static_cast<ptrdiff_t>(begin); i >= 0 && i < static_cast<ptrdiff_t>(codepoints.size());
+       i += step) {
+    if (!InRanges(kCaseIgnorableRanges, codepoints[i])) {
+      return InRanges(kCasedRanges, codepoints[i]);
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Check the Final_Sigma condition for the capital sigma at index
+ *
+ * Preceded by a cased letter and not followed by one, skipping case-ignorable
+ * characters both ways (Unicode Table 3-17, as ICU evaluates it).
+ */
+bool IsFinalSigma(const std::vector<uint32_t>& codepoints, size_t index) {
+  return index > 0 && NextNonIgnorableIsCased(codepoints, index - 1, -1) &&
+         !NextNonIgnorableIsCased(codepoints, index + 1, 1);
+}
+
+/**
+ * @brief Lowercase with the root locale's full mappings
+ */
+void LowerCodepoints(const std::vector<uint32_t>& in, std::vector<uint32_t>& out) {
+  out.clear();
+  for (size_t i = 0; i < in.size(); ++i) {
+    uint32_t codepoint = in[i];
+    if (codepoint < kAsciiLimit) {
+      out.push_back(codepoint >= 'A' && codepoint <= 'Z' ? codepoint - 'A' + 'a' : codepoint);
+    } else if (codepoint == kCapitalSigma && IsFinalSigma(in, i)) {
+      out.push_back(kFinalSigma);
+    } else {
+      AppendMapped(kLowerMappings, kLowerPool, codepoint, out);
+    }
+  }
+}
+
+}  // namespace
+
+void NormalizeTextBuiltin(std::string_view text, bool nfkc, WidthMode width, bool lower, std::string& out) {
+  thread_local std::vector<uint32_t> codepoints;
+  thread_local std::vector<uint32_t> mapped;
+  thread_local std::vector<uint8_t> classes;
+  DecodeUtf8Replacing(text, codepoints);
+
+  if (nfkc) {
+    DecomposeCompatibility(codepoints, mapped);
+    ReorderMarks(mapped, classes);
+    ComposeCanonical(mapped, classes);
+    codepoints.swap(mapped);
+  }
+
+  if (width == WidthMode::kNarrow) {
+    MapCodepoints(codepoints, kNarrowMappings, kNarrowPool, mapped);
+    codepoints.swap(mapped);
+  } else if (width == WidthMode::kWide) {
+    // Half-width voiced kana are two codepoints that widen into one
+    ComposeAdjacent(codepoints, kWideCompositions);
+    MapCodepoints(codepoints, kWideMappings, kWidePool, mapped);
+    codepoints.swap(mapped);
+  }
+
+  if (lower) {
+    LowerCodepoints(codepoints, mapped);
+    codepoints.swap(mapped);
+  }
+
+  out.clear();
+  out.reserve(text.size());
+  for (uint32_t codepoint : codepoints) {
+    AppendUtf8(codepoint, out);
+  }
+}
+
+}  // namespace mygramdb::utils
@@ -0,0 +1,213 @@
+/**
+ * @file expression_cache.cpp
+ * @brief Concurrent LRU cache of parsed search expressions
+ */
+
+#include "expression_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "search_expression.h"
+
+namespace mygramdb::client {
+
+namespace {
+
+/**
+ * @brief One independently locked LRU list
+ */
+struct CacheShard {
+  using Entry = std::pair<std::string, std::shared_ptr<const CachedExpression>>;
+
+  std::mutex mutex;                                                        // Guards the fields below
+  std::list<Entry> lru;                                                    // Most recently used first
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index;  // Keys point into lru
+  size_t capacity = 0;                                                     // Maximum entries in this shard
+
+  /**
+   * @brief Drop least recently used entries beyond capacity
+   * @return Number of entries dropped
+   */
+  size_t EvictOverflow() {
+    size_t evicted = 0;
+    while (lru.size() > capacity) {
+      index.erase(lru.back().first);
+      lru.pop_back();
+      ++evicted;
+    }
+    return evicted;
+  }
+};
+
+}  // namespace
+
+CachedExpression ParseExpressionForCache(const std::string& expression) {
+  CachedExpression parsed;
+
+  auto result = ParseQueryAst(expression);
+  if (auto* err = std::get_if<std::string>(&result)) {
+    parsed.error = *err;
+    return parsed;
+  }
+
+  const auto& ast = std::get<QueryAst>(result);
+  parsed.query = ast.ToQueryString();
+  parsed.simplified =
+      SimplifySearchExpression(FlattenQueryAst(ast), parsed.main_term, parsed.and_terms, parsed.not_terms);
+  return parsed;
+}
+
+/**
+ * @brief PIMPL implementation class
+ */
+class ExpressionCache::Impl {
+ public:
+  explicit Impl(const ExpressionCacheConfig& config) : shards_(std::max<size_t>(config.shards, 1)) {
+    SetCapacity(config.capacity);
+  }
+
+  std::shared_ptr<const CachedExpression> Get(const std::string& expression) {
+    {
+      CacheShard* shard = nullptr;
+      auto lock = LockShardFor(expression, shard);
+      auto found = shard->index.find(expression);
+      if (found != shard->index.end()) {
+        shard->lru.splice(shard->lru.begin(), shard->lru, found->second);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return found->second->second;
+      }
+    }
+
+    // Parse outside the lock; a concurrent miss on the same key keeps the first insert
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    auto parsed = std::make_shared<const CachedExpression>(ParseExpressionForCache(expression));
+
+    // Look the shard up again: a resize in between may have remapped the key
+    CacheShard* locked_shard = nullptr;
+    auto lock = LockShardFor(expression, locked_shard);
+    CacheShard& shard = *locked_shard;
+    if (shard.capacity == 0) {
+      return parsed;
+    }
+    auto found = shard.index.find(expression);
+    if (found != shard.index.end()) {
+      return found->second->second;
+    }
+    shard.lru.emplace_front(expression, parsed);
+    shard.index.emplace(shard.lru.front().first, shard.lru.begin());
+    evictions_.fetch_add(shard.EvictOverflow(), std::memory_order_relaxed);
+    return parsed;
+  }
+
+  [[nodiscard]] ExpressionCacheStats GetStats() const {
+    ExpressionCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.evictions = evictions_.load(std::memory_order_relaxed);
+    stats.capacity = capacity_.load(std::memory_order_relaxed);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      stats.size += shard.lru.size();
+    }
+    return stats;
+  }
+
+  void SetCapacity(size_t capacity) {
+    // Every shard stays locked while the mapping changes, so Get() never
+    // works on a shard the key no longer maps to (locked in index order)
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(shards_.size());
+    for (auto& shard : shards_) {
+      locks.emplace_back(shard.mutex);
+    }
+
+    capacity_.store(capacity, std::memory_order_relaxed);
+
+    // Small caches use fewer shards so every shard can hold at least one entry.
+    // Changing the shard count remaps keys, so the old entries are dropped.
+    size_t active = std::clamp<size_t>(capacity, 1, shards_.size());
+    bool remap = active != active_shards_.exchange(active, std::memory_order_relaxed);
+
+    // Spread the capacity over the active shards; the first shards take the remainder
+    size_t per_shard = capacity / active;
+    size_t remainder = capacity % active;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+      shards_[i].capacity = i < active ? per_shard + (i < remainder ? 1 : 0) : 0;
+      if (remap) {
+        evictions_.fetch_add(shards_[i].lru.size(), std::memory_order_relaxed);
+        shards_[i].index.clear();
+        shards_[i].lru.clear();
+      } else {
+        evictions_.fetch_add(shards_[i].EvictOverflow(), std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void Clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      shard.index.clear();
+      shard.lru.clear();
+    }
+  }
+
+ private:
+  CacheShard& ShardFor(const std::string& expression) {
+    return shards_[std::hash<std::string_view>{}(expression) % active_shards_.load(std::memory_order_relaxed)];
+  }
+
+  /**
+   * @brief Lock the shard an expression maps to
+   *
+   * The shard count only changes while SetCapacity() holds every shard lock,
+   * so a mapping that still holds after locking is stable until unlock.
+   */
+  std::unique_lock<std::mutex> LockShardFor(const std::string& expression, CacheShard*& shard) {
+    while (true) {
+      shard = &ShardFor(expression);
+      std::unique_lock<std::mutex> lock(shard->mutex);
+      if (shard == &ShardFor(expression)) {
+        return lock;
+      }
+    }
+  }
+
+  mutable std::vector<CacheShard> shards_;  // Fixed shard storage
+  std::atomic<size_t> active_shards_{0};    // Shards in use (fewer for small capacities)
+  std::atomic<size_t> capacity_{0};         // Total capacity
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+// ExpressionCache public interface implementation
+
+ExpressionCache::ExpressionCache(ExpressionCacheConfig config) : impl_(std::make_unique<Impl>(config)) {}
+
+ExpressionCache::~ExpressionCache() = default;
+
+std::shared_ptr<const CachedExpression> ExpressionCache::Get(const std::string& expression) {
+  return impl_->Get(expression);
+}
+
+ExpressionCacheStats ExpressionCache::GetStats() const {
+  return impl_->GetStats();
+}
+
+void ExpressionCache::Resize(size_t capacity) {
+  impl_->SetCapacity(capacity);
+}
+
+void ExpressionCache::Clear() {
+  impl_->Clear();
+}
+
+}  // namespace mygramdb::client
@@ -0,0 +1,352 @@
+/**
+ * @file field_schema.cpp
+ * @brief Typed decoding of document filter fields
+ */
+
+#include "field_schema.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+
+namespace mygramdb::client {
+
+namespace {
+
+constexpr int64_t kMillisecondsPerSecond = 1000;
+constexpr int64_t kSecondsPerMinute = 60;
+constexpr int64_t kSecondsPerHour = 3600;
+constexpr int64_t kSecondsPerDay = 86400;
+constexpr int kMaxMonth = 12;
+constexpr int kMaxHour = 23;
+constexpr int kMaxMinute = 59;
+constexpr int kMaxSecond = 60;  // Allow leap second notation
+constexpr int kMillisecondDigits = 3;
+
+bool IsDigit(char character) {
+  return std::isdigit(static_cast<unsigned char>(character)) != 0;
+}
+
+/**
+ * @brief Read exactly `count` digits at `pos` as an integer
+ */
+bool ReadDigits(std::string_view text, size_t& pos, size_t count, int& value) {
+  if (pos + count > text.size()) {
+    return false;
+  }
+  value = 0;
+  for (size_t i = 0; i < count; ++i) {
+    char character = text[pos + i];
+    if (!IsDigit(character)) {
+      return false;
+    }
+    value = value * 10 + (character - '0');  // NOLINT(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+  }
+  pos += count;
+  return true;
+}
+
+bool IsLeapYear(int year) {
+  // NOLINTNEXTLINE(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - Gregorian rules
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+int DaysInMonth(int year, int month) {
+  // NOLINTNEXTLINE(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+  static constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+  return month == 2 && IsLeapYear(year) ? 29 : kDays[month - 1];  // NOLINT(readability-magic-numbers)
+}
+
+/**
+ * @brief Days since 1970-01-01 for a proleptic Gregorian date
+ *
+ * Howard Hinnant's days_from_civil algorithm.
+ */
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+int64_t DaysFromCivil(int64_t year, int month, int day) {
+  year -= month <= 2 ? 1 : 0;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t year_of_era = year - era * 400;
+  const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Parse an optional zone suffix (Z, ±HH, ±HH:MM, ±HHMM) to an offset in seconds
+ */
+bool ParseZoneOffset(std::string_view text, size_t& pos, int64_t& offset_seconds) {
+  offset_seconds = 0;
+  if (pos == text.size()) {
+    return true;
+  }
+  if (text[pos] == 'Z' || text[pos] == 'z') {
+    ++pos;
+    return true;
+  }
+  if (text[pos] != '+' && text[pos] != '-') {
+    return false;
+  }
+
+  int64_t sign = text[pos] == '-' ? -1 : 1;
+  ++pos;
+  int hours = 0;
+  int minutes = 0;
+  if (!ReadDigits(text, pos, 2, hours) || hours > kMaxHour) {
+    return false;
+  }
+  // Minutes are optional ("+09"), but a colon must be followed by them ("+09:" is invalid)
+  bool colon = pos < text.size() && text[pos] == ':';
+  if (colon) {
+    ++pos;
+  }
+  if ((colon || pos < text.size()) && (!ReadDigits(text, pos, 2, minutes) || minutes > kMaxMinute)) {
+    return false;
+  }
+  offset_seconds = sign * (hours * kSecondsPerHour + minutes * kSecondsPerMinute);
+  return true;
+}
+
+}  // namespace
+
+bool ParseDecimalNumber(std::string_view text, double& value) {
+  size_t pos = 0;
+  if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+    ++pos;
+  }
+  size_t digits = 0;
+  while (pos < text.size() && IsDigit(text[pos])) {
+    ++pos;
+    ++digits;
+  }
+  if (pos < text.size() && text[pos] == '.') {
+    ++pos;
+    while (pos < text.size() && IsDigit(text[pos])) {
+      ++pos;
+      ++digits;
+    }
+  }
+  if (digits == 0) {
+    return false;
+  }
+  if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+    ++pos;
+    if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+      ++pos;
+    }
+    size_t exponent_digits = 0;
+    while (pos < text.size() && IsDigit(text[pos])) {
+      ++pos;
+      ++exponent_digits;
+    }
+    if (exponent_digits == 0) {
+      return false;
+    }
+  }
+  if (pos != text.size()) {
+    return false;
+  }
+
+  value = std::strtod(std::string(text).c_str(), nullptr);
+  return true;
+}
+
+std::optional<int64_t> ParseInteger(std::string_view text) {
+  if (!text.empty() && text[0] == '+') {
+    text.remove_prefix(1);
+    if (!text.empty() && text[0] == '-') {
+      return std::nullopt;
+    }
+  }
+  if (text.empty()) {
+    return std::nullopt;
+  }
+
+  int64_t value = 0;
+  const char* end = text.data() + text.size();
+  auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  if (ec != std::errc() || ptr != end) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::optional<int64_t> ParseTimestampMillis(std::string_view text) {
+  if (text.empty()) {
+    return std::nullopt;
+  }
+
+  // Plain integer: epoch seconds
+  if (auto seconds = ParseInteger(text)) {
+    constexpr int64_t kMaxSeconds = std::numeric_limits<int64_t>::max() / kMillisecondsPerSecond;
+    if (*seconds > kMaxSeconds || *seconds < -kMaxSeconds) {
+      return std::nullopt;
+    }
+    return *seconds * kMillisecondsPerSecond;
+  }
+
+  size_t pos = 0;
+  int year = 0;
+  int month = 0;
+  int day = 0;
+  // NOLINTNEXTLINE(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers) - YYYY
+  if (!ReadDigits(text, pos, 4, year) || pos >= text.size() || text[pos++] != '-' ||
+      !ReadDigits(text, pos, 2, month) || pos >= text.size() || text[pos++] != '-' ||
+      !ReadDigits(text, pos, 2, day)) {
+    return std::nullopt;
+  }
+  if (month < 1 || month > kMaxMonth || day < 1 || day > DaysInMonth(year, month)) {
+    return std::nullopt;
+  }
+
+  int64_t seconds = DaysFromCivil(year, month, day) * kSecondsPerDay;
+  int64_t millis = 0;
+
+  if (pos < text.size()) {
+    if (text[pos] != 'T' && text[pos] != 't' && text[pos] != ' ') {
+      return std::nullopt;
+    }
+    ++pos;
+
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (!ReadDigits(text, pos, 2, hour) || hour > kMaxHour || pos >= text.size() || text[pos++] != ':' ||
+        !ReadDigits(text, pos, 2, minute) || minute > kMaxMinute) {
+      return std::nullopt;
+    }
+    if (pos < text.size() && text[pos] == ':') {
+      ++pos;
+      if (!ReadDigits(text, pos, 2, second) || second > kMaxSecond) {
+        return std::nullopt;
+      }
+      if (pos < text.size() && (text[pos] == '.' || text[pos] == ',')) {
+        ++pos;
+        size_t fraction_start = pos;
+        int scale = kMillisecondDigits;
+        while (pos < text.size() && IsDigit(text[pos])) {
+          // Keep millisecond precision, ignore finer digits
+          if (scale > 0) {
+            millis = millis * 10 + (text[pos] - '0');  // NOLINT(readability-magic-numbers)
+            --scale;
+          }
+          ++pos;
+        }
+        if (pos == fraction_start) {
+          return std::nullopt;
+        }
+        for (; scale > 0; --scale) {
+          millis *= 10;  // NOLINT(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+        }
+      }
+    }
+    seconds += hour * kSecondsPerHour + minute * kSecondsPerMinute + second;
+
+    int64_t offset_seconds = 0;
+    if (!ParseZoneOffset(text, pos, offset_seconds)) {
+      return std::nullopt;
+    }
+    seconds -= offset_seconds;
+  }
+
+  if (pos != text.size()) {
+    return std::nullopt;
+  }
+  return seconds * kMillisecondsPerSecond + millis;
+}
+
+FieldValue DecodeFieldValue(std::string_view text, FieldType type) {
+  FieldValue value;
+  switch (type) {
+    case FieldType::kInteger:
+      if (auto integer = ParseInteger(text)) {
+        value.type = FieldType::kInteger;
+        value.integer = *integer;
+        value.number = static_cast<double>(*integer);
+      }
+      break;
+    case FieldType::kFloat:
+      if (ParseDecimalNumber(text, value.number)) {
+        value.type = FieldType::kFloat;
+      }
+      break;
+    case FieldType::kTimestamp:
+      if (auto millis = ParseTimestampMillis(text)) {
+        value.type = FieldType::kTimestamp;
+        value.integer = *millis;
+        value.number = static_cast<double>(*millis);
+      }
+      break;
+    case FieldType::kString:
+      break;
+  }
+  return value;
+}
+
+FieldType InferFieldType(std::string_view text) {
+  std::string_view digits = text;
+  if (!digits.empty() && (digits[0] == '+' || digits[0] == '-')) {
+    digits.remove_prefix(1);
+  }
+  // "007" and "0123.5" are identifiers, not numbers
+  if (digits.size() > 1 && digits[0] == '0' && IsDigit(digits[1])) {
+    return FieldType::kString;
+  }
+
+  if (ParseInteger(text)) {
+    return FieldType::kInteger;
+  }
+  double number = 0.0;
+  if (ParseDecimalNumber(text, number)) {
+    return FieldType::kFloat;
+  }
+  if (ParseTimestampMillis(text)) {
+    return FieldType::kTimestamp;
+  }
+  return FieldType::kString;
+}
+
+FieldType MergeFieldTypes(FieldType current, FieldType observed) {
+  if (current == observed) {
+    return current;
+  }
+  if ((current == FieldType::kInteger && observed == FieldType::kFloat) ||
+      (current == FieldType::kFloat && observed == FieldType::kInteger)) {
+    return FieldType::kFloat;
+  }
+  return FieldType::kString;
+}
+
+const char* FieldTypeToString(FieldType type) {
+  switch (type) {
+    case FieldType::kInteger:
+      return "integer";
+    case FieldType::kFloat:
+      return "float";
+    case FieldType::kTimestamp:
+      return "timestamp";
+    case FieldType::kString:
+      break;
+  }
+  return "string";
+}
+
+std::optional<FieldType> ParseFieldType(std::string_view name) {
+  if (name == "string") {
+    return FieldType::kString;
+  }
+  if (name == "integer") {
+    return FieldType::kInteger;
+  }
+  if (name == "float") {
+    return FieldType::kFloat;
+  }
+  if (name == "timestamp") {
+    return FieldType::kTimestamp;
+  }
+  return std::nullopt;
+}
+
+}  // namespace mygramdb::client
@@ -0,0 +1,180 @@
+/**
+ * @file info_poller.cpp
+ * @brief Background INFO poller implementation
+ */
+
+#include "info_poller.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace mygramdb::client {
+
+/**
+ * @brief PIMPL implementation class
+ */
+class InfoPoller::Impl {
+ public:
+  explicit Impl(InfoPollerConfig config) : config_(std::move(config)), client_(config_.client) {}
+
+  ~Impl() { Stop(); }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  std::optional<std::string> Start() {
+    if (IsRunning()) {
+      return std::nullopt;
+    }
+
+    if (auto err = PollOnce()) {
+      return err;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_requested_ = false;
+    }
+    thread_ = std::thread(&Impl::Run, this);
+    return std::nullopt;
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_requested_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(client_mutex_);
+    client_.Disconnect();
+  }
+
+  [[nodiscard]] bool IsRunning() const { return thread_.joinable(); }
+
+  std::optional<std::string> PollOnce() {
+    std::lock_guard<std::mutex> client_lock(client_mutex_);
+
+    if (!client_.IsConnected()) {
+      if (auto err = client_.Connect()) {
+        SetError(*err);
+        return err;
+      }
+    }
+
+    auto result = client_.Info();
+    if (auto* err = std::get_if<Error>(&result)) {
+      // Reconnect on the next attempt; the connection state is unknown
+      client_.Disconnect();
+      SetError(err->message);
+      return err->message;
+    }
+
+    auto snapshot = std::make_shared<InfoSnapshot>();
+    snapshot->info = std::move(std::get<ServerInfo>(result));
+    snapshot->captured_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch())
+                                   .count();
+
+    {
+      std::lock_guard<std::mutex> state_lock(state_mutex_);
+      snapshot->sequence = ++sequence_;
+      latest_ = snapshot;
+      last_error_.clear();
+    }
+
+    if (listener_) {
+      listener_(*snapshot);
+    }
+    return std::nullopt;
+  }
+
+  void SetListener(SnapshotListener listener) { listener_ = std::move(listener); }
+
+  [[nodiscard]] std::shared_ptr<const InfoSnapshot> Latest() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return latest_;
+  }
+
+  [[nodiscard]] std::string GetLastError() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return last_error_;
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stop_requested_) {
+      if (wake_.wait_for(lock, std::chrono::milliseconds(config_.interval_ms), [this] { return stop_requested_; })) {
+        break;
+      }
+      lock.unlock();
+      PollOnce();  // Errors are recorded in last_error_
+      lock.lock();
+    }
+  }
+
+  void SetError(const std::string& message) {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    last_error_ = message;
+  }
+
+  InfoPollerConfig config_;
+  MygramClient client_;
+  std::mutex client_mutex_;    // Serializes polls on client_
+  SnapshotListener listener_;  // Called after each successful poll
+
+  mutable std::mutex state_mutex_;              // Guards latest_, last_error_, sequence_
+  std::shared_ptr<const InfoSnapshot> latest_;  // Latest successful poll
+  std::string last_error_;                      // Error of the most recent poll
+  uint64_t sequence_ = 0;                       // Successful polls so far
+
+  std::mutex wake_mutex_;  // Guards stop_requested_
+  std::condition_variable wake_;
+  bool stop_requested_ = false;
+  std::thread thread_;
+};
+
+// InfoPoller public interface implementation
+
+InfoPoller::InfoPoller(InfoPollerConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+InfoPoller::~InfoPoller() = default;
+
+void InfoPoller::SetListener(SnapshotListener listener) {
+  impl_->SetListener(std::move(listener));
+}
+
+std::optional<std::string> InfoPoller::Start() {
+  return impl_->Start();
+}
+
+void InfoPoller::Stop() {
+  impl_->Stop();
+}
+
+bool InfoPoller::IsRunning() const {
+  return impl_->IsRunning();
+}
+
+std::optional<std::string> InfoPoller::PollNow() {
+  return impl_->PollOnce();
+}
+
+std::shared_ptr<const InfoSnapshot> InfoPoller::Latest() const {
+  return impl_->Latest();
+}
+
+std::string InfoPoller::GetLastError() const {
+  return impl_->GetLastError();
+}
+
+}  // namespace mygramdb::client
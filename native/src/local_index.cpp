@@ -0,0 +1,530 @@
+/**
+ * @file local_index.cpp
+ * @brief In-process n-gram inverted index with MygramDB search semantics
+ */
+
+#include "local_index.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+
+#include "query_analysis.h"
+#include "string_utils.h"
+
+namespace mygramdb::client {
+
+namespace {
+
+constexpr uint32_t kSkipInterval = 64;             // Posting list entries between skip entries
+constexpr uint8_t kVarintPayloadMask = 0x7F;       // Low 7 bits of each varint byte
+constexpr uint8_t kVarintContinuation = 0x80;      // Set on every varint byte but the last
+constexpr int kVarintShift = 7;                    // Payload bits per varint byte
+constexpr size_t kMinRemovedForCompaction = 1024;  // Removed documents below this never trigger Compact()
+
+/**
+ * @brief Position reached after one posting list entry
+ */
+struct SkipEntry {
+  uint32_t doc_id;  // Document id of the entry
+  uint32_t offset;  // Byte offset just past the entry
+};
+
+/**
+ * @brief Ascending document ids, delta + varint encoded
+ */
+struct PostingList {
+  std::vector<uint8_t> bytes;    // Delta from the previous id (the first id is its own delta)
+  std::vector<SkipEntry> skips;  // Every kSkipInterval-th entry, for SkipTo
+  uint32_t count = 0;            // Number of entries
+  uint32_t last = 0;             // Last id appended
+
+  void Append(uint32_t doc_id) {
+    uint32_t delta = doc_id - (count == 0 ? 0 : last);
+    while (delta > kVarintPayloadMask) {
+      bytes.push_back(static_cast<uint8_t>((delta & kVarintPayloadMask) | kVarintContinuation));
+      delta >>= kVarintShift;
+    }
+    bytes.push_back(static_cast<uint8_t>(delta));
+    if (count % kSkipInterval == 0) {
+      skips.push_back({doc_id, static_cast<uint32_t>(bytes.size())});
+    }
+    last = doc_id;
+    ++count;
+  }
+};
+
+/**
+ * @brief Forward iterator over a posting list
+ */
+class PostingCursor {
+ public:
+  explicit PostingCursor(const PostingList& list) : list_(&list) { Next(); }
+
+  [[nodiscard]] bool Valid() const { return valid_; }
+  [[nodiscard]] uint32_t Doc() const { return doc_; }
+
+  void Next() {
+    if (pos_ >= list_->bytes.size()) {
+      valid_ = false;
+      return;
+    }
+    uint32_t delta = 0;
+    for (int shift = 0;; shift += kVarintShift) {
+      uint8_t byte = list_->bytes[pos_++];
+      delta |= static_cast<uint32_t>(byte & kVarintPayloadMask) << shift;
+      if ((byte & kVarintContinuation) == 0) {
+        break;
+      }
+    }
+    doc_ += delta;
+  }
+
+  /**
+   * @brief Advance to the first entry >= target, jumping over whole skip intervals
+   */
+  void SkipTo(uint32_t target) {
+    if (!valid_ || doc_ >= target) {
+      return;
+    }
+    // Targets within the current interval are reached by decoding; only a
+    // target past the next skip entry is worth a binary search
+    const auto& skips = list_->skips;
+    if (skip_ < skips.size() && skips[skip_].doc_id <= target) {
+      auto it = std::upper_bound(skips.begin() + static_cast<ptrdiff_t>(skip_), skips.end(), target,
+                                 [](uint32_t value, const SkipEntry& skip) { return value < skip.doc_id; });
+      skip_ = static_cast<size_t>(it - skips.begin());
+      if (std::prev(it)->offset > pos_) {
+        doc_ = std::prev(it)->doc_id;
+        pos_ = std::prev(it)->offset;
+      }
+    }
+    while (valid_ && doc_ < target) {
+      Next();
+    }
+  }
+
+ private:
+  const PostingList* list_;
+  size_t pos_ = 0;   // Byte offset of the next entry
+  size_t skip_ = 0;  // First skip entry not yet jumped to
+  uint32_t doc_ = 0;
+  bool valid_ = true;
+};
+
+/**
+ * @brief Indexed document (slot of a document id)
+ */
+struct DocumentEntry {
+  std::string primary_key;
+  std::vector<std::pair<std::string, std::string>> fields;
+  std::optional<uint64_t> key_number;  // Primary key as a number, if it is digits only and fits
+  bool alive = true;                   // False once removed or replaced
+};
+
+bool IsDigits(std::string_view value) {
+  return !value.empty() && std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+/**
+ * @brief Compare sort keys: digit-only values first, as numbers, then the rest as strings
+ *
+ * Mixing numeric and string comparison pair by pair is not transitive
+ * ("9" < "10" < "1a" < "9"), so the two kinds are kept apart; this is a
+ * total order as std::partial_sort requires.
+ */
+int CompareSortKeys(const std::string& a, const std::string& b) {
+  bool a_is_number = IsDigits(a);
+  bool b_is_number = IsDigits(b);
+  if (a_is_number != b_is_number) {
+    return a_is_number ? -1 : 1;
+  }
+  if (a_is_number) {
+    std::string_view a_digits(a);
+    std::string_view b_digits(b);
+    a_digits.remove_prefix(std::min(a_digits.find_first_not_of('0'), a_digits.size() - 1));
+    b_digits.remove_prefix(std::min(b_digits.find_first_not_of('0'), b_digits.size() - 1));
+    if (a_digits.size() != b_digits.size()) {
+      return a_digits.size() < b_digits.size() ? -1 : 1;
+    }
+    if (int result = a_digits.compare(b_digits); result != 0) {
+      return result;
+    }
+  }
+  return a.compare(b);
+}
+
+/**
+ * @brief Parse a digit-only primary key, so sorting by it avoids string comparisons
+ */
+std::optional<uint64_t> ParseKeyNumber(const std::string& primary_key) {
+  uint64_t number = 0;
+  const char* end = primary_key.data() + primary_key.size();
+  auto [ptr, ec] = std::from_chars(primary_key.data(), end, number);
+  if (ec != std::errc() || ptr != end || primary_key.empty() || primary_key[0] == '+' || primary_key[0] == '-') {
+    return std::nullopt;
+  }
+  return number;
+}
+
+const std::string* FindField(const DocumentEntry& document, const std::string& key) {
+  for (const auto& [field_key, value] : document.fields) {
+    if (field_key == key) {
+      return &value;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+/**
+ * @brief PIMPL implementation class
+ */
+class LocalIndex::Impl {
+ public:
+  explicit Impl(const LocalIndexConfig& config)
+      : config_(config),
+        normalizer_(config.normalization.nfkc, utils::ParseWidthMode(config.normalization.width),
+                    config.normalization.lower) {}
+
+  void Add(const std::string& primary_key, std::string_view text,
+           const std::vector<std::pair<std::string, std::string>>& fields) {
+    thread_local std::vector<uint64_t> hashes;
+    Hashes(text, hashes);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    RemoveLocked(primary_key);
+    auto doc_id = static_cast<uint32_t>(documents_.size());
+    documents_.push_back({primary_key, fields, ParseKeyNumber(primary_key), true});
+    ids_[primary_key] = doc_id;
+    for (uint64_t hash : hashes) {
+      postings_[hash].Append(doc_id);
+    }
+    CompactIfNeededLocked();
+  }
+
+  bool Remove(const std::string& primary_key) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    bool removed = RemoveLocked(primary_key);
+    CompactIfNeededLocked();
+    return removed;
+  }
+
+  std::variant<SearchResponse, Error> Search(const std::string& query, uint32_t limit, uint32_t offset,
+                                             const std::vector<std::string>& and_terms,
+                                             const std::vector<std::string>& not_terms,
+                                             const std::vector<std::pair<std::string, std::string>>& filters,
+                                             const std::string& sort_column, bool sort_desc) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<uint32_t> matches;
+    if (auto err = MatchLocked(query, and_terms, not_terms, filters, matches)) {
+      return *err;
+    }
+
+    auto key = [&](uint32_t doc_id) -> const std::string& {
+      static const std::string kMissing;
+      if (sort_column.empty()) {
+        return documents_[doc_id].primary_key;
+      }
+      const std::string* value = FindField(documents_[doc_id], sort_column);
+      return value != nullptr ? *value : kMissing;
+    };
+    auto before = [&](uint32_t a, uint32_t b) {
+      const auto& number_a = documents_[a].key_number;
+      const auto& number_b = documents_[b].key_number;
+      int order = 0;
+      if (sort_column.empty() && number_a && number_b && *number_a != *number_b) {
+        order = *number_a < *number_b ? -1 : 1;
+      } else {
+        order = CompareSortKeys(key(a), key(b));
+      }
+      if (order == 0) {
+        return sort_desc ? a > b : a < b;
+      }
+      return sort_desc ? order > 0 : order < 0;
+    };
+
+    SearchResponse response;
+    response.total_count = matches.size();
+    size_t begin = std::min<size_t>(offset, matches.size());
+    size_t end = limit == 0 ? matches.size() : std::min<size_t>(begin + limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + static_cast<ptrdiff_t>(end), matches.end(), before);
+    response.results.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+      response.results.emplace_back(documents_[matches[i]].primary_key);
+    }
+    return response;
+  }
+
+  std::variant<CountResponse, Error> Count(const std::string& query, const std::vector<std::string>& and_terms,
+                                           const std::vector<std::string>& not_terms,
+                                           const std::vector<std::pair<std::string, std::string>>& filters) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<uint32_t> matches;
+    if (auto err = MatchLocked(query, and_terms, not_terms, filters, matches)) {
+      return *err;
+    }
+    CountResponse response;
+    response.count = matches.size();
+    return response;
+  }
+
+  LocalIndexStats GetStats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    LocalIndexStats stats;
+    stats.documents = ids_.size();
+    stats.removed = documents_.size() - ids_.size();
+    stats.ngrams = postings_.size();
+    for (const auto& [hash, list] : postings_) {
+      stats.postings += list.count;
+      stats.posting_bytes += list.bytes.size() + list.skips.size() * sizeof(SkipEntry);
+    }
+    return stats;
+  }
+
+  void Compact() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    CompactLocked();
+  }
+
+  void Clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    documents_.clear();
+    ids_.clear();
+    postings_.clear();
+  }
+
+ private:
+  /**
+   * @brief Distinct n-gram hashes of a normalized text, sorted
+   */
+  void Hashes(std::string_view text, std::vector<uint64_t>& hashes) const {
+    thread_local utils::NgramScratch scratch;
+    thread_local std::string normalized;
+    if (!normalizer_.IsIdentity()) {
+      normalizer_.Normalize(text, normalized);
+      text = normalized;
+    }
+    utils::GenerateHybridNgramHashes(text, config_.ascii_ngram_size, config_.kanji_ngram_size, scratch, hashes);
+    std::sort(hashes.begin(), hashes.end());
+    hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  }
+
+  bool RemoveLocked(const std::string& primary_key) {
+    auto found = ids_.find(primary_key);
+    if (found == ids_.end()) {
+      return false;
+    }
+    documents_[found->second].alive = false;
+    ids_.erase(found);
+    return true;
+  }
+
+  void CompactIfNeededLocked() {
+    size_t removed = documents_.size() - ids_.size();
+    if (removed >= kMinRemovedForCompaction && removed * 2 >= documents_.size()) {
+      CompactLocked();
+    }
+  }
+
+  /**
+   * @brief Drop removed documents and renumber the rest, keeping their order
+   */
+  void CompactLocked() {
+    if (documents_.size() == ids_.size()) {
+      return;
+    }
+
+    std::vector<uint32_t> new_ids(documents_.size());
+    std::vector<DocumentEntry> documents;
+    documents.reserve(ids_.size());
+    for (size_t doc_id = 0; doc_id < documents_.size(); ++doc_id) {
+      if (documents_[doc_id].alive) {
+        new_ids[doc_id] = static_cast<uint32_t>(documents.size());
+        documents.push_back(std::move(documents_[doc_id]));
+      }
+    }
+    for (auto& [primary_key, doc_id] : ids_) {
+      doc_id = new_ids[doc_id];
+    }
+
+    for (auto it = postings_.begin(); it != postings_.end();) {
+      PostingList compacted;
+      for (PostingCursor cursor(it->second); cursor.Valid(); cursor.Next()) {
+        if (documents_[cursor.Doc()].alive) {
+          compacted.Append(new_ids[cursor.Doc()]);
+        }
+      }
+      if (compacted.count == 0) {
+        it = postings_.erase(it);
+      } else {
+        it->second = std::move(compacted);
+        ++it;
+      }
+    }
+    documents_ = std::move(documents);
+  }
+
+  /**
+   * @brief Append the posting lists of a term's n-grams to lists
+   *
+   * @return False if no document can contain the term (no n-grams, or one never indexed)
+   */
+  bool CollectLists(const std::string& term, std::vector<const PostingList*>& lists) const {
+    thread_local std::vector<uint64_t> hashes;
+    Hashes(term, hashes);
+    if (hashes.empty()) {
+      return false;
+    }
+    for (uint64_t hash : hashes) {
+      auto found = postings_.find(hash);
+      if (found == postings_.end()) {
+        return false;
+      }
+      lists.push_back(&found->second);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Find the documents matching a query, in document id order
+   */
+  std::optional<Error> MatchLocked(const std::string& query, const std::vector<std::string>& and_terms,
+                                   const std::vector<std::string>& not_terms,
+                                   const std::vector<std::pair<std::string, std::string>>& filters,
+                                   std::vector<uint32_t>& matches) const {
+    auto analysis = AnalyzeTerms(query, and_terms, not_terms);
+    if (analysis.verdict == QueryVerdict::kInvalid) {
+      return Error(analysis.reason);
+    }
+    if (analysis.verdict == QueryVerdict::kEmpty) {
+      return std::nullopt;
+    }
+
+    // Every n-gram of every positive term, intersected from the shortest list up
+    std::vector<const PostingList*> lists;
+    if (!CollectLists(query, lists)) {
+      return std::nullopt;
+    }
+    for (const auto& term : and_terms) {
+      if (!CollectLists(term, lists)) {
+        return std::nullopt;
+      }
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const PostingList* a, const PostingList* b) { return std::tie(a->count, a) < std::tie(b->count, b); });
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+
+    for (PostingCursor cursor(*lists.front()); cursor.Valid(); cursor.Next()) {
+      if (documents_[cursor.Doc()].alive) {
+        matches.push_back(cursor.Doc());
+      }
+    }
+    for (size_t i = 1; i < lists.size() && !matches.empty(); ++i) {
+      KeepContained(*lists[i], matches);
+    }
+
+    // A NOT term removes the documents containing all of its n-grams
+    for (const auto& term : not_terms) {
+      std::vector<const PostingList*> excluded;
+      if (matches.empty() || !CollectLists(term, excluded)) {
+        continue;
+      }
+      std::vector<uint32_t> hits = matches;
+      for (const PostingList* list : excluded) {
+        KeepContained(*list, hits);
+      }
+      std::vector<uint32_t> kept;
+      kept.reserve(matches.size() - hits.size());
+      std::set_difference(matches.begin(), matches.end(), hits.begin(), hits.end(), std::back_inserter(kept));
+      matches.swap(kept);
+    }
+
+    if (!filters.empty()) {
+      matches.erase(std::remove_if(matches.begin(), matches.end(),
+                                   [&](uint32_t doc_id) {
+                                     for (const auto& [key, value] : filters) {
+                                       const std::string* field = FindField(documents_[doc_id], key);
+                                       if (field == nullptr || *field != value) {
+                                         return true;
+                                       }
+                                     }
+                                     return false;
+                                   }),
+                    matches.end());
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Keep the ids (ascending) that are in a posting list
+   */
+  static void KeepContained(const PostingList& list, std::vector<uint32_t>& doc_ids) {
+    PostingCursor cursor(list);
+    size_t kept = 0;
+    for (uint32_t doc_id : doc_ids) {
+      cursor.SkipTo(doc_id);
+      if (!cursor.Valid()) {
+        break;
+      }
+      if (cursor.Doc() == doc_id) {
+        doc_ids[kept++] = doc_id;
+      }
+    }
+    doc_ids.resize(kept);
+  }
+
+  LocalIndexConfig config_;
+  utils::Normalizer normalizer_;
+  mutable std::shared_mutex mutex_;                // Guards the fields below
+  std::vector<DocumentEntry> documents_;           // Indexed by document id
+  std::unordered_map<std::string, uint32_t> ids_;  // Primary key of each live document → document id
+  std::unordered_map<uint64_t, PostingList> postings_;  // N-gram hash → documents containing it
+};
+
+LocalIndex::LocalIndex(LocalIndexConfig config) : impl_(std::make_unique<Impl>(config)) {}
+
+LocalIndex::~LocalIndex() = default;
+
+void LocalIndex::Add(const std::string& primary_key, std::string_view text,
+                     const std::vector<std::pair<std::string, std::string>>& fields) {
+  impl_->Add(primary_key, text, fields);
+}
+
+bool LocalIndex::Remove(const std::string& primary_key) {
+  return impl_->Remove(primary_key);
+}
+
+std::variant<SearchResponse, Error> LocalIndex::Search(const std::string& query, uint32_t limit, uint32_t offset,
+                                                       const std::vector<std::string>& and_terms,
+                                                       const std::vector<std::string>& not_terms,
+                                                       const std::vector<std::pair<std::string, std::string>>& filters,
+                                                       const std::string& sort_column, bool sort_desc) const {
+  return impl_->Search(query, limit, offset, and_terms, not_terms, filters, sort_column, sort_desc);
+}
+
+std::variant<CountResponse, Error> LocalIndex::Count(
+    const std::string& query, const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+    const std::vector<std::pair<std::string, std::string>>& filters) const {
+  return impl_->Count(query, and_terms, not_terms, filters);
+}
+
+LocalIndexStats LocalIndex::GetStats() const {
+  return impl_->GetStats();
+}
+
+void LocalIndex::Compact() {
+  impl_->Compact();
+}
+
+void LocalIndex::Clear() {
+  impl_->Clear();
+}
+
+}  // namespace mygramdb::client
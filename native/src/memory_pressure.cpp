@@ -0,0 +1,187 @@
+/**
+ * @file memory_pressure.cpp
+ * @brief Memory pressure monitor implementation
+ */
+
+#include "memory_pressure.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace mygramdb::client {
+
+using utils::MemoryHealthStatus;
+
+/**
+ * @brief PIMPL implementation class
+ */
+class MemoryPressureMonitor::Impl {
+ public:
+  Impl(MemoryPressureConfig config, StatusSource source) : config_(config), source_(std::move(source)) {
+    if (!source_) {
+      source_ = [] { return utils::GetMemoryHealthStatus(); };
+    }
+  }
+
+  ~Impl() { Stop(); }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  uint64_t Subscribe(StatusListener listener) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    uint64_t subscription = ++last_subscription_;
+    if (status_ != MemoryHealthStatus::UNKNOWN) {
+      listener(status_);
+    }
+    listeners_.emplace(subscription, std::move(listener));
+    return subscription;
+  }
+
+  void Unsubscribe(uint64_t subscription) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    listeners_.erase(subscription);
+  }
+
+  void Start() {
+    if (IsRunning()) {
+      return;
+    }
+
+    CheckNow();
+
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_requested_ = false;
+    }
+    thread_ = std::thread(&Impl::Run, this);
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_requested_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  [[nodiscard]] bool IsRunning() const { return thread_.joinable(); }
+
+  MemoryHealthStatus CheckNow() {
+    MemoryHealthStatus status = source_();
+    if (status == MemoryHealthStatus::UNKNOWN) {
+      return status;  // Keep the last known status and cache sizes
+    }
+
+    // Listeners are called under the lock, so Unsubscribe() waits for a running call
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    if (status != status_) {
+      status_ = status;
+      for (auto& [subscription, listener] : listeners_) {
+        listener(status);
+      }
+    }
+    return status;
+  }
+
+  [[nodiscard]] MemoryHealthStatus GetStatus() const {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    return status_;
+  }
+
+  [[nodiscard]] size_t ScaledCapacity(size_t full_capacity, MemoryHealthStatus status) const {
+    double fraction = 1.0;
+    if (status == MemoryHealthStatus::WARNING) {
+      fraction = config_.warning_fraction;
+    } else if (status == MemoryHealthStatus::CRITICAL) {
+      fraction = config_.critical_fraction;
+    }
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    return static_cast<size_t>(std::floor(static_cast<double>(full_capacity) * fraction));
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    while (!stop_requested_) {
+      if (wake_.wait_for(lock, std::chrono::milliseconds(config_.interval_ms), [this] { return stop_requested_; })) {
+        break;
+      }
+      lock.unlock();
+      CheckNow();
+      lock.lock();
+    }
+  }
+
+  MemoryPressureConfig config_;
+  StatusSource source_;
+
+  mutable std::mutex listeners_mutex_;                       // Guards listeners_, status_, last_subscription_
+  std::map<uint64_t, StatusListener> listeners_;             // Subscription id → listener
+  MemoryHealthStatus status_ = MemoryHealthStatus::UNKNOWN;  // Last known status
+  uint64_t last_subscription_ = 0;                           // Last subscription id handed out
+
+  std::mutex wake_mutex_;  // Guards stop_requested_
+  std::condition_variable wake_;
+  bool stop_requested_ = false;
+  std::thread thread_;
+};
+
+// MemoryPressureMonitor public interface implementation
+
+MemoryPressureMonitor::MemoryPressureMonitor(MemoryPressureConfig config, StatusSource source)
+    : impl_(std::make_unique<Impl>(config, std::move(source))) {}
+
+MemoryPressureMonitor::~MemoryPressureMonitor() = default;
+
+uint64_t MemoryPressureMonitor::Subscribe(StatusListener listener) {
+  return impl_->Subscribe(std::move(listener));
+}
+
+uint64_t MemoryPressureMonitor::SubscribeCache(ExpressionCache& cache) {
+  size_t full_capacity = cache.GetStats().capacity;
+  return impl_->Subscribe([this, &cache, full_capacity](MemoryHealthStatus status) {
+    cache.Resize(impl_->ScaledCapacity(full_capacity, status));
+  });
+}
+
+void MemoryPressureMonitor::Unsubscribe(uint64_t subscription) {
+  impl_->Unsubscribe(subscription);
+}
+
+void MemoryPressureMonitor::Start() {
+  impl_->Start();
+}
+
+void MemoryPressureMonitor::Stop() {
+  impl_->Stop();
+}
+
+bool MemoryPressureMonitor::IsRunning() const {
+  return impl_->IsRunning();
+}
+
+MemoryHealthStatus MemoryPressureMonitor::CheckNow() {
+  return impl_->CheckNow();
+}
+
+MemoryHealthStatus MemoryPressureMonitor::GetStatus() const {
+  return impl_->GetStatus();
+}
+
+size_t MemoryPressureMonitor::ScaledCapacity(size_t full_capacity, MemoryHealthStatus status) const {
+  return impl_->ScaledCapacity(full_capacity, status);
+}
+
+}  // namespace mygramdb::client
@@ -5,12 +5,14 @@
 
 #include "memory_utils.h"
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <cmath>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 #include <sstream>
 
 #ifdef __APPLE__
@@ -39,6 +41,123 @@ constexpr uint64_t kBytesPerKB = 1024;
 constexpr uint64_t kBytesPerMB = 1024 * 1024;
 constexpr uint64_t kBytesPerGB = 1024 * 1024 * 1024;
 
+#ifdef __linux__
+constexpr uint64_t kUnlimited = std::numeric_limits<uint64_t>::max();
+constexpr uint64_t kCgroupV1Unlimited = uint64_t{1} << 62;  // v1 reports no limit as LONG_MAX rounded to a page
+const std::string kCgroupV2Root = "/sys/fs/cgroup";
+const std::string kCgroupV1MemoryRoot = "/sys/fs/cgroup/memory";
+
+/**
+ * @brief Read a single-value cgroup file
+ *
+ * @return Value, kUnlimited for "max" (v2) or a v1 no-limit value, std::nullopt if unreadable
+ */
+std::optional<uint64_t> ReadCgroupValue(const std::string& path) {
+  std::ifstream file(path);
+  std::string value;
+  if (!file || !(file >> value)) {
+    return std::nullopt;
+  }
+  if (value == "max") {
+    return kUnlimited;
+  }
+  try {
+    uint64_t bytes = std::stoull(value);
+    return bytes >= kCgroupV1Unlimited ? kUnlimited : bytes;
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+/**
+ * @brief Read one key of a cgroup memory.stat file (0 if absent)
+ */
+uint64_t ReadCgroupStat(const std::string& path, const std::string& key) {
+  std::ifstream file(path);
+  std::string name;
+  uint64_t value = 0;
+  while (file >> name >> value) {
+    if (name == key) {
+      return value;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Tightest limit of a cgroup directory and its ancestors up to the mount root
+ *
+ * Limits missing from a level (the root cgroup has none) are skipped.
+ */
+uint64_t ReadCgroupLimit(const std::string& root, const std::string& dir, const std::string& file) {
+  uint64_t limit = kUnlimited;
+  std::string current = dir;
+  while (true) {
+    limit = std::min(limit, ReadCgroupValue(current + "/" + file).value_or(kUnlimited));
+    if (current.size() <= root.size()) {
+      return limit;
+    }
+    current.resize(current.rfind('/'));
+  }
+}
+
+/**
+ * @brief Find the process's cgroup directory under a controller mount
+ *
+ * The path from /proc/self/cgroup is relative to the hierarchy root; without
+ * a cgroup namespace a container sees the host's path while its own cgroup is
+ * mounted at the root, so fall back to the mount root when the path is absent.
+ */
+std::string ResolveCgroupDir(const std::string& root, const std::string& relative, const std::string& probe) {
+  std::string dir = root + (relative == "/" ? "" : relative);
+  if (std::ifstream(dir + "/" + probe)) {
+    return dir;
+  }
+  return root;
+}
+
+/**
+ * @brief Locate the memory controller in /proc/self/cgroup
+ *
+ * @param[out] relative cgroup path of the memory controller
+ * @return 1 for a v1 memory hierarchy, 2 for the v2 unified hierarchy, 0 if neither
+ */
+int FindMemoryCgroup(std::string& relative) {
+  std::ifstream cgroups("/proc/self/cgroup");
+  std::string line;
+  std::string unified;
+  bool has_unified = false;
+  while (std::getline(cgroups, line)) {
+    // Format: hierarchy-id:controller-list:path
+    size_t first = line.find(':');
+    size_t second = first == std::string::npos ? std::string::npos : line.find(':', first + 1);
+    if (second == std::string::npos) {
+      continue;
+    }
+    std::string controllers = line.substr(first + 1, second - first - 1);
+    std::string path = line.substr(second + 1);
+    if (controllers.empty() && line.compare(0, first, "0") == 0) {
+      unified = path;
+      has_unified = true;
+      continue;
+    }
+    std::istringstream list(controllers);
+    std::string controller;
+    while (std::getline(list, controller, ',')) {
+      if (controller == "memory") {
+        relative = path;  // A v1 memory hierarchy wins over the unified one in hybrid setups
+        return 1;
+      }
+    }
+  }
+  if (has_unified) {
+    relative = unified;
+    return 2;
+  }
+  return 0;
+}
+#endif
+
 }  // namespace
 
 std::optional<SystemMemoryInfo> GetSystemMemoryInfo() {
@@ -133,6 +252,22 @@ std::optional<SystemMemoryInfo> GetSystemMemoryInfo() {
     return std::nullopt;
   }
 
+  // /proc/meminfo describes the host; inside a container the cgroup limit is what triggers OOM kills
+  if (auto cgroup = GetCgroupMemoryInfo()) {
+    if (cgroup->limit_bytes < info.total_physical_bytes) {
+      uint64_t working_set = cgroup->usage_bytes - std::min(cgroup->inactive_file_bytes, cgroup->usage_bytes);
+      uint64_t cgroup_available = cgroup->limit_bytes - std::min(working_set, cgroup->limit_bytes);
+      info.total_physical_bytes = cgroup->limit_bytes;
+      info.available_physical_bytes = std::min(info.available_physical_bytes, cgroup_available);
+      info.cgroup_limited = true;
+    }
+    if (cgroup->swap_limit_bytes < info.total_swap_bytes) {
+      uint64_t swap_available = cgroup->swap_limit_bytes - std::min(cgroup->swap_usage_bytes, cgroup->swap_limit_bytes);
+      info.total_swap_bytes = cgroup->swap_limit_bytes;
+      info.available_swap_bytes = std::min(info.available_swap_bytes, swap_available);
+    }
+  }
+
 #else
   std::cerr << "Unsupported platform for memory info" << std::endl;
   return std::nullopt;
@@ -141,6 +276,54 @@ std::optional<SystemMemoryInfo> GetSystemMemoryInfo() {
   return info;
 }
 
+std::optional<CgroupMemoryInfo> GetCgroupMemoryInfo() {
+#ifdef __linux__
+  std::string relative;
+  int version = FindMemoryCgroup(relative);
+  if (version == 0) {
+    return std::nullopt;
+  }
+
+  CgroupMemoryInfo info{};
+  info.version = version;
+  if (version == 2) {
+    std::string dir = ResolveCgroupDir(kCgroupV2Root, relative, "memory.current");
+    auto usage = ReadCgroupValue(dir + "/memory.current");
+    if (!usage) {
+      return std::nullopt;  // Memory controller not enabled for this cgroup
+    }
+    info.usage_bytes = *usage;
+    // memory.high throttles and reclaims rather than kills, but usage cannot stay above it either
+    info.limit_bytes = std::min(ReadCgroupLimit(kCgroupV2Root, dir, "memory.max"),
+                                ReadCgroupLimit(kCgroupV2Root, dir, "memory.high"));
+    info.inactive_file_bytes = ReadCgroupStat(dir + "/memory.stat", "inactive_file");
+    info.swap_limit_bytes = ReadCgroupLimit(kCgroupV2Root, dir, "memory.swap.max");
+    info.swap_usage_bytes = ReadCgroupValue(dir + "/memory.swap.current").value_or(0);
+  } else {
+    std::string dir = ResolveCgroupDir(kCgroupV1MemoryRoot, relative, "memory.usage_in_bytes");
+    auto usage = ReadCgroupValue(dir + "/memory.usage_in_bytes");
+    if (!usage) {
+      return std::nullopt;
+    }
+    info.usage_bytes = *usage;
+    info.limit_bytes = ReadCgroupLimit(kCgroupV1MemoryRoot, dir, "memory.limit_in_bytes");
+    // total_inactive_file includes child cgroups, like usage_in_bytes
+    info.inactive_file_bytes = ReadCgroupStat(dir + "/memory.stat", "total_inactive_file");
+
+    // memsw files (present only with swap accounting) limit and count memory plus swap
+    uint64_t memsw_limit = ReadCgroupLimit(kCgroupV1MemoryRoot, dir, "memory.memsw.limit_in_bytes");
+    info.swap_limit_bytes = memsw_limit == kUnlimited || info.limit_bytes == kUnlimited
+                                ? kUnlimited
+                                : memsw_limit - std::min(info.limit_bytes, memsw_limit);
+    uint64_t memsw_usage = ReadCgroupValue(dir + "/memory.memsw.usage_in_bytes").value_or(info.usage_bytes);
+    info.swap_usage_bytes = memsw_usage - std::min(info.usage_bytes, memsw_usage);
+  }
+  return info;
+#else
+  return std::nullopt;
+#endif
+}
+
 std::optional<ProcessMemoryInfo> GetProcessMemoryInfo() {
   ProcessMemoryInfo info{};
 
@@ -240,10 +423,17 @@ MemoryHealthStatus GetMemoryHealthStatus() {
   if (!system_info) {
     return MemoryHealthStatus::UNKNOWN;
   }
+  return GetMemoryHealthStatus(*system_info);
+}
+
+MemoryHealthStatus GetMemoryHealthStatus(const SystemMemoryInfo& info) {
+  if (info.total_physical_bytes == 0) {
+    return MemoryHealthStatus::UNKNOWN;
+  }
 
   // Calculate available memory ratio
-  double available_ratio = static_cast<double>(system_info->available_physical_bytes) /
-                           static_cast<double>(system_info->total_physical_bytes);
+  double available_ratio =
+      static_cast<double>(info.available_physical_bytes) / static_cast<double>(info.total_physical_bytes);
 
   if (available_ratio >= kHealthyThreshold) {
     return MemoryHealthStatus::HEALTHY;
@@ -7,16 +7,25 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cctype>
+#include <charconv>
 #include <cstring>
 #include <iomanip>
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
 
+#include "ngram_filter.h"
+#include "query_analysis.h"
+#include "query_canonical.h"
+
 namespace mygramdb::client {
 
 namespace {
@@ -25,8 +34,10 @@ namespace {
 constexpr size_t kErrorPrefixLen = 6;    // Length of "ERROR "
 constexpr size_t kSavedPrefixLen = 9;    // Length of "SNAPSHOT "
 constexpr size_t kLoadedPrefixLen = 10;  // Length of "SNAPSHOT: "
+constexpr size_t kDocPrefixLen = 7;      // Length of "OK DOC "
 constexpr int kMillisecondsPerSecond = 1000;
 constexpr int kMicrosecondsPerMillisecond = 1000;
+constexpr size_t kGetPipelineDepth = 128;  // GET commands in flight per columnar batch
 
 /**
  * @brief Parse key=value pairs from string
@@ -48,6 +59,103 @@ std::vector<std::pair<std::string, std::string>> ParseKeyValuePairs(const std::s
   return pairs;
 }
 
+/**
+ * @brief Find the index of a field in a document
+ */
+std::optional<size_t> FindField(const Document& doc, std::string_view name) {
+  for (size_t i = 0; i < doc.fields.size(); ++i) {
+    if (doc.fields[i].first == name) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief Get a field's decoded value, decoding the raw text as `fallback` without a schema
+ */
+std::optional<FieldValue> GetFieldValue(const Document& doc, std::string_view name, FieldType fallback) {
+  auto index = FindField(doc, name);
+  if (!index) {
+    return std::nullopt;
+  }
+  if (*index < doc.typed_fields.size()) {
+    return doc.typed_fields[*index];
+  }
+  return DecodeFieldValue(doc.fields[*index].second, fallback);
+}
+
+/**
+ * @brief Append one row to every column from a GET response line
+ *
+ * @param line Response line ("OK DOC <pk> key=value ..." or an error line)
+ * @param fields Requested field names (column order)
+ * @param columns Columns being built
+ * @param row_values Scratch buffer, one slot per column
+ * @return true if the document was found
+ */
+bool AppendColumnarRow(std::string_view line, const std::vector<std::string>& fields,
+                       std::vector<FieldColumn>& columns, std::vector<std::optional<std::string_view>>& row_values) {
+  std::fill(row_values.begin(), row_values.end(), std::nullopt);
+
+  bool found = line.substr(0, kDocPrefixLen) == "OK DOC ";
+  if (found) {
+    std::string_view rest = line.substr(kDocPrefixLen);
+    bool is_primary_key = true;
+    while (!rest.empty()) {
+      size_t token_end = rest.find(' ');
+      std::string_view token = rest.substr(0, token_end);
+      rest = token_end == std::string_view::npos ? std::string_view() : rest.substr(token_end + 1);
+      if (token.empty()) {
+        continue;
+      }
+      if (is_primary_key) {
+        is_primary_key = false;
+        continue;
+      }
+
+      size_t eq_pos = token.find('=');
+      if (eq_pos == std::string_view::npos) {
+        continue;
+      }
+      std::string_view key = token.substr(0, eq_pos);
+      for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i] == key) {
+          row_values[i] = token.substr(eq_pos + 1);
+          break;
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    auto& column = columns[i];
+    double number = std::numeric_limits<double>::quiet_NaN();
+    if (row_values[i]) {
+      column.present.push_back(1);
+      column.string_data.append(row_values[i]->data(), row_values[i]->size());
+      if (column.kind == ColumnKind::kNumeric) {
+        if (column.declared_type == FieldType::kTimestamp) {
+          auto millis = ParseTimestampMillis(*row_values[i]);
+          if (millis) {
+            number = static_cast<double>(*millis);
+          } else {
+            column.kind = ColumnKind::kString;
+          }
+        } else if (!ParseDecimalNumber(*row_values[i], number)) {
+          column.kind = ColumnKind::kString;
+        }
+      }
+    } else {
+      column.present.push_back(0);
+    }
+    column.numbers.push_back(number);
+    column.string_offsets.push_back(static_cast<uint32_t>(column.string_data.size()));
+  }
+
+  return found;
+}
+
 /**
  * @brief Extract debug info from response tokens
  */
@@ -95,6 +203,60 @@ std::optional<DebugInfo> ParseDebugInfo(const std::vector<std::string>& tokens,
   return info;
 }
 
+/**
+ * @brief Parse a Redis-style INFO response ("OK INFO" followed by "key: value" lines)
+ */
+ServerInfo ParseInfoResponse(const std::string& response) {
+  ServerInfo info;
+  std::istringstream iss(response);
+  std::string line;
+
+  // Skip first line "OK INFO"
+  std::getline(iss, line);
+
+  while (std::getline(iss, line)) {
+    // Skip empty lines and section headers (lines starting with #)
+    if (line.empty() || line[0] == '#' || line[0] == '\r') {
+      continue;
+    }
+
+    // Parse "key: value" format (values may themselves contain ':')
+    size_t colon_pos = line.find(':');
+    if (colon_pos == std::string::npos) {
+      continue;
+    }
+    std::string key = line.substr(0, colon_pos);
+    std::string value = line.substr(colon_pos + 1);
+
+    // Trim leading/trailing whitespace from value
+    size_t start = value.find_first_not_of(" \t\r\n");
+    size_t end = value.find_last_not_of(" \t\r\n");
+    value = start == std::string::npos ? std::string() : value.substr(start, end - start + 1);
+
+    info.values[std::move(key)] = std::move(value);
+  }
+
+  info.version = std::string(info.Get("version").value_or(""));
+  info.uptime_seconds = info.GetUint("uptime_seconds").value_or(0);
+  info.total_requests = info.GetUint("total_requests").value_or(0);
+  info.active_connections =
+      info.GetUint("active_connections").value_or(info.GetUint("connected_clients").value_or(0));
+  info.index_size_bytes = info.GetUint("index_size_bytes").value_or(info.GetUint("used_memory_bytes").value_or(0));
+  info.doc_count = info.GetUint("doc_count").value_or(info.GetUint("total_documents").value_or(0));
+
+  // Parse comma-separated table names
+  std::istringstream table_iss(std::string(info.Get("tables").value_or("")));
+  std::string table;
+  while (std::getline(table_iss, table, ',')) {
+    size_t table_start = table.find_first_not_of(' ');
+    if (table_start != std::string::npos) {
+      info.tables.push_back(table.substr(table_start, table.find_last_not_of(' ') - table_start + 1));
+    }
+  }
+
+  return info;
+}
+
 /**
  * @brief Validate that a string does not contain ASCII control characters
  */
@@ -111,36 +273,6 @@ std::optional<std::string> ValidateNoControlCharacters(const std::string& value,
   return std::nullopt;
 }
 
-/**
- * @brief Escape special characters in query strings
- */
-std::string EscapeQueryString(const std::string& str) {
-  // Check if string needs quoting (contains spaces or special chars)
-  bool needs_quotes = false;
-  for (char character : str) {
-    if (character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '"' ||
-        character == '\'') {
-      needs_quotes = true;
-      break;
-    }
-  }
-
-  if (!needs_quotes) {
-    return str;
-  }
-
-  // Use double quotes and escape internal quotes
-  std::string result = "\"";
-  for (char character : str) {
-    if (character == '"' || character == '\\') {
-      result += '\\';
-    }
-    result += character;
-  }
-  result += '"';
-  return result;
-}
-
 }  // namespace
 
 /**
@@ -283,46 +415,24 @@ class MygramClient::Impl {
       }
     }
 
-    // Build command
-    std::ostringstream cmd;
-    cmd << "SEARCH " << table << " " << EscapeQueryString(query);
-
-    for (const auto& term : and_terms) {
-      cmd << " AND " << EscapeQueryString(term);
-    }
-
-    for (const auto& term : not_terms) {
-      cmd << " NOT " << EscapeQueryString(term);
-    }
-
-    for (const auto& [key, value] : filters) {
-      cmd << " FILTER " << key << " = " << EscapeQueryString(value);
+    std::string main_term = query;
+    std::vector<std::string> required = and_terms;
+    std::vector<std::string> excluded = not_terms;
+    auto analysis = AnalyzeBeforeSend(main_term, required, excluded);
+    if (analysis.verdict == QueryVerdict::kInvalid) {
+      return Error(analysis.reason);
     }
-
-    // SORT clause (replaces ORDER BY)
-    if (!sort_column.empty()) {
-      cmd << " SORT " << sort_column << (sort_desc ? " DESC" : " ASC");
-    } else if (!sort_desc) {
-      // Only add SORT ASC if explicitly requesting ascending order for primary key
-      cmd << " SORT ASC";
+    if (analysis.verdict == QueryVerdict::kEmpty || RejectedByNgramFilter(table, main_term, required)) {
+      return SearchResponse{};
     }
-    // Default is SORT DESC (primary key descending), so no need to add it explicitly
 
-    // LIMIT clause - support MySQL-style offset,count format when both are specified
-    if (limit > 0 && offset > 0) {
-      cmd << " LIMIT " << offset << "," << limit;
-    } else if (limit > 0) {
-      cmd << " LIMIT " << limit;
+    // Start from the rarest known term; the intersection (and so the result) is the same
+    if (config_.reorder_terms) {
+      term_stats_.Reorder(table, main_term, required);
     }
 
-    // OFFSET clause - only needed if LIMIT didn't use offset,count format
-    // (This is redundant if we used LIMIT offset,count above, but kept for clarity)
-    // Note: The LIMIT offset,count format above already handles offset, so we skip this
-    // if (offset > 0 && limit == 0) {
-    //   cmd << " OFFSET " << offset;
-    // }
-
-    auto result = SendCommand(cmd.str());
+    auto result = SendCommand(
+        BuildSearchCommand(table, main_term, required, excluded, filters, sort_column, sort_desc, limit, offset));
     if (auto* err = std::get_if<Error>(&result)) {
       return *err;
     }
@@ -371,6 +481,10 @@ class MygramClient::Impl {
       resp.debug = ParseDebugInfo(tokens, debug_index);
     }
 
+    if (config_.reorder_terms) {
+      RecordTermStats(table, main_term, required, excluded, filters, resp.total_count, resp.debug);
+    }
+
     return resp;
   }
 
@@ -403,23 +517,22 @@ class MygramClient::Impl {
       }
     }
 
-    // Build command
-    std::ostringstream cmd;
-    cmd << "COUNT " << table << " " << EscapeQueryString(query);
-
-    for (const auto& term : and_terms) {
-      cmd << " AND " << EscapeQueryString(term);
+    std::string main_term = query;
+    std::vector<std::string> required = and_terms;
+    std::vector<std::string> excluded = not_terms;
+    auto analysis = AnalyzeBeforeSend(main_term, required, excluded);
+    if (analysis.verdict == QueryVerdict::kInvalid) {
+      return Error(analysis.reason);
     }
-
-    for (const auto& term : not_terms) {
-      cmd << " NOT " << EscapeQueryString(term);
+    if (analysis.verdict == QueryVerdict::kEmpty || RejectedByNgramFilter(table, main_term, required)) {
+      return CountResponse{};
     }
 
-    for (const auto& [key, value] : filters) {
-      cmd << " FILTER " << key << " = " << EscapeQueryString(value);
+    if (config_.reorder_terms) {
+      term_stats_.Reorder(table, main_term, required);
     }
 
-    auto result = SendCommand(cmd.str());
+    auto result = SendCommand(BuildCountCommand(table, main_term, required, excluded, filters));
     if (auto* err = std::get_if<Error>(&result)) {
       return *err;
     }
@@ -454,6 +567,10 @@ class MygramClient::Impl {
       resp.debug = ParseDebugInfo(tokens, 0);
     }
 
+    if (config_.reorder_terms) {
+      RecordTermStats(table, main_term, required, excluded, filters, resp.count, resp.debug);
+    }
+
     return resp;
   }
 
@@ -495,82 +612,118 @@ class MygramClient::Impl {
     std::string rest;
     std::getline(iss, rest);
     doc.fields = ParseKeyValuePairs(rest);
+    ApplyFieldSchema(table, doc);
 
     return doc;
   }
 
-  std::variant<ServerInfo, Error> Info() {
-    auto result = SendCommand("INFO");
-    if (auto* err = std::get_if<Error>(&result)) {
-      return *err;
+  std::variant<ColumnarDocuments, Error> GetColumns(const std::string& table,
+                                                    const std::vector<std::string>& primary_keys,
+                                                    const std::vector<std::string>& fields) {
+    if (auto err = ValidateNoControlCharacters(table, "table name")) {
+      return Error(*err);
     }
-
-    std::string response = std::get<std::string>(result);
-    if (response.find("ERROR") == 0) {
-      return Error(response.substr(kErrorPrefixLen));
+    for (const auto& primary_key : primary_keys) {
+      if (auto err = ValidateNoControlCharacters(primary_key, "primary key")) {
+        return Error(*err);
+      }
+    }
+    for (const auto& field : fields) {
+      if (auto err = ValidateNoControlCharacters(field, "field name")) {
+        return Error(*err);
+      }
     }
 
-    if (response.find("OK INFO") != 0) {
-      return Error("Unexpected response format");
+    ColumnarDocuments docs;
+    docs.primary_keys = primary_keys;
+    docs.found.reserve(primary_keys.size());
+    docs.columns.resize(fields.size());
+    auto schema = schemas_.find(table);
+    for (size_t i = 0; i < fields.size(); ++i) {
+      auto& column = docs.columns[i];
+      column.name = fields[i];
+      if (schema != schemas_.end()) {
+        auto type = schema->second.types.find(fields[i]);
+        if (type != schema->second.types.end()) {
+          column.declared_type = type->second;
+          if (type->second == FieldType::kString) {
+            column.kind = ColumnKind::kString;
+          }
+        }
+      }
+      column.numbers.reserve(primary_keys.size());
+      column.present.reserve(primary_keys.size());
+      column.string_offsets.reserve(primary_keys.size() + 1);
+      column.string_offsets.push_back(0);
     }
 
-    // Parse Redis-style INFO response (multi-line key: value format)
-    ServerInfo info;
-    std::istringstream iss(response);
-    std::string line;
+    std::vector<std::optional<std::string_view>> row_values(fields.size());
+    std::vector<std::string> lines;
+    std::string batch;
 
-    // Skip first line "OK INFO"
-    std::getline(iss, line);
+    // Pipeline GETs in bounded windows: one round trip per window instead of per key
+    for (size_t start = 0; start < primary_keys.size(); start += kGetPipelineDepth) {
+      size_t end = std::min(primary_keys.size(), start + kGetPipelineDepth);
 
-    while (std::getline(iss, line)) {
-      // Skip empty lines and section headers (lines starting with #)
-      if (line.empty() || line[0] == '#' || line[0] == '\r') {
-        continue;
+      batch.clear();
+      for (size_t i = start; i < end; ++i) {
+        batch.append("GET ").append(table).append(" ").append(primary_keys[i]).append("\r\n");
+      }
+      if (auto err = SendAll(batch)) {
+        return Error(*err);
       }
 
-      // Parse "key: value" format
-      size_t colon_pos = line.find(':');
-      if (colon_pos != std::string::npos) {
-        std::string key = line.substr(0, colon_pos);
-        std::string value = line.substr(colon_pos + 1);
+      lines.clear();
+      if (auto err = ReceiveLines(end - start, lines)) {
+        return Error(*err);
+      }
 
-        // Trim leading/trailing whitespace from value
-        size_t start = value.find_first_not_of(" \t\r\n");
-        size_t end = value.find_last_not_of(" \t\r\n");
-        if (start != std::string::npos) {
-          value = value.substr(start, end - start + 1);
+      for (const auto& line : lines) {
+        if (line.find("OK DOC") != 0 && line.find("ERROR") != 0) {
+          return Error("Unexpected response format");
         }
+        docs.found.push_back(AppendColumnarRow(line, fields, docs.columns, row_values) ? 1 : 0);
+      }
+    }
 
-        if (key == "version") {
-          info.version = value;
-        } else if (key == "uptime_seconds") {
-          info.uptime_seconds = std::stoull(value);
-        } else if (key == "total_requests") {
-          info.total_requests = std::stoull(value);
-        } else if (key == "active_connections") {
-          info.active_connections = std::stoull(value);
-        } else if (key == "index_size_bytes") {
-          info.index_size_bytes = std::stoull(value);
-        } else if (key == "doc_count" || key == "total_documents") {
-          info.doc_count = std::stoull(value);
-        } else if (key == "tables") {
-          // Parse comma-separated table names
-          std::istringstream table_iss(value);
-          std::string table;
-          while (std::getline(table_iss, table, ',')) {
-            if (!table.empty()) {
-              info.tables.push_back(table);
-            }
-          }
-        }
+    // Keep only the storage each column ended up needing
+    for (auto& column : docs.columns) {
+      if (column.kind == ColumnKind::kNumeric) {
+        column.string_data.clear();
+        column.string_data.shrink_to_fit();
+        column.string_offsets.clear();
+        column.string_offsets.shrink_to_fit();
+      } else {
+        column.numbers.clear();
+        column.numbers.shrink_to_fit();
       }
     }
 
-    return info;
+    return docs;
+  }
+
+  std::variant<ServerInfo, Error> Info() {
+    auto result = SendMultilineCommand("INFO");
+    if (auto* err = std::get_if<Error>(&result)) {
+      return *err;
+    }
+
+    std::string response = std::get<std::string>(result);
+    if (response.find("ERROR") == 0) {
+      return Error(response.substr(kErrorPrefixLen));
+    }
+
+    if (response.find("OK INFO") != 0) {
+      // The rest of the reply (if any) would answer the next command
+      Disconnect();
+      return Error("Unexpected response format");
+    }
+
+    return ParseInfoResponse(response);
   }
 
   std::variant<std::string, Error> GetConfig() {
-    auto result = SendCommand("CONFIG");
+    auto result = SendMultilineCommand("CONFIG");
     if (auto* err = std::get_if<Error>(&result)) {
       return *err;
     }
@@ -720,14 +873,344 @@ class MygramClient::Impl {
     return std::nullopt;
   }
 
+  void SetFieldSchema(const std::string& table, FieldSchema schema) {
+    if (schema.empty()) {
+      schemas_.erase(table);
+      return;
+    }
+    schemas_[table] = TableSchema{std::move(schema), true};
+  }
+
+  [[nodiscard]] std::optional<FieldSchema> GetFieldSchema(const std::string& table) const {
+    auto iter = schemas_.find(table);
+    if (iter == schemas_.end()) {
+      return std::nullopt;
+    }
+    return iter->second.types;
+  }
+
+  void SetNgramFilter(const std::string& table, std::shared_ptr<const NgramBloomFilter> filter) {
+    if (!filter) {
+      ngram_filters_.erase(table);
+      return;
+    }
+    ngram_filters_[table] = std::move(filter);
+  }
+
   [[nodiscard]] const std::string& GetLastError() const { return last_error_; }
 
+  TermStatsCache& GetTermStats() { return term_stats_; }
+
+  [[nodiscard]] uint64_t GetSavedRoundTrips() const { return saved_round_trips_; }
+
  private:
+  /**
+   * @brief Analyze SEARCH/COUNT terms locally when ClientConfig::analyze_queries is set
+   *
+   * Queries with a known outcome are counted as saved round trips. Otherwise
+   * repeated terms are dropped in place, which leaves the result unchanged.
+   */
+  QueryAnalysis AnalyzeBeforeSend(const std::string& main_term, std::vector<std::string>& required,
+                                  std::vector<std::string>& excluded) {
+    if (!config_.analyze_queries) {
+      return {};
+    }
+
+    QueryAnalysis analysis = AnalyzeTerms(main_term, required, excluded);
+    if (!analysis.NeedsServer()) {
+      ++saved_round_trips_;
+    } else if (!analysis.duplicates.empty()) {
+      required.erase(std::remove(required.begin(), required.end(), main_term), required.end());
+      DedupeTerms(required);
+      DedupeTerms(excluded);
+    }
+    return analysis;
+  }
+
+  /**
+   * @brief Check the positive terms against the table's n-gram filter, if any
+   * @return true if some term cannot match (counted as a saved round trip)
+   */
+  bool RejectedByNgramFilter(const std::string& table, const std::string& main_term,
+                             const std::vector<std::string>& required) {
+    auto iter = ngram_filters_.find(table);
+    if (iter == ngram_filters_.end() || iter->second->MayMatchQuery(main_term, required)) {
+      return false;
+    }
+    ++saved_round_trips_;
+    return true;
+  }
+
+  /**
+   * @brief Feed term statistics from a SEARCH/COUNT response
+   *
+   * A lone term without NOT or FILTER clauses yields its exact document count;
+   * DEBUG candidates estimate the main term's frequency in any query.
+   */
+  void RecordTermStats(const std::string& table, const std::string& main_term,
+                       const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                       const std::vector<std::pair<std::string, std::string>>& filters, uint64_t total_count,
+                       const std::optional<DebugInfo>& debug) {
+    if (and_terms.empty() && not_terms.empty() && filters.empty()) {
+      term_stats_.RecordCount(table, main_term, total_count);
+    } else if (debug) {
+      term_stats_.RecordCandidates(table, main_term, debug->candidates);
+    }
+  }
+
+  /**
+   * @brief Field schema of one table
+   */
+  struct TableSchema {
+    FieldSchema types;      // Field types
+    bool declared = false;  // Set explicitly (false = learned from responses)
+  };
+
+  /**
+   * @brief Decode a document's fields with its table's schema, learning types if enabled
+   */
+  void ApplyFieldSchema(const std::string& table, Document& doc) {
+    auto iter = schemas_.find(table);
+    if (iter == schemas_.end()) {
+      if (!config_.learn_field_schemas) {
+        return;
+      }
+      iter = schemas_.emplace(table, TableSchema{}).first;
+    }
+
+    auto& schema = iter->second;
+    doc.typed_fields.reserve(doc.fields.size());
+    for (const auto& [name, value] : doc.fields) {
+      auto type = schema.types.find(name);
+      if (type == schema.types.end()) {
+        if (schema.declared) {
+          doc.typed_fields.emplace_back();  // Undeclared fields stay strings
+          continue;
+        }
+        type = schema.types.emplace(name, InferFieldType(value)).first;
+      } else if (!schema.declared) {
+        type->second = MergeFieldTypes(type->second, InferFieldType(value));
+      }
+      doc.typed_fields.push_back(DecodeFieldValue(value, type->second));
+    }
+  }
+
+  /**
+   * @brief Send a buffer, retrying on partial writes
+   *
+   * Disconnects on failure: part of a pipelined batch may already have been
+   * sent, and its replies would answer the next command.
+   */
+  std::optional<std::string> SendAll(const std::string& data) {
+    if (!IsConnected()) {
+      last_error_ = "Not connected";
+      return last_error_;
+    }
+
+    size_t offset = 0;
+    while (offset < data.size()) {
+      ssize_t sent = send(sock_, data.data() + offset, data.size() - offset, 0);
+      if (sent < 0) {
+        last_error_ = std::string("Failed to send command: ") + strerror(errno);
+        Disconnect();
+        return last_error_;
+      }
+      offset += static_cast<size_t>(sent);
+    }
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Send a command whose reply ends with a blank line (INFO, CONFIG)
+   *
+   * The protocol has no explicit terminator, and blank lines also separate
+   * sections inside the reply. A blank line therefore only ends the reply
+   * when it is the last thing received and nothing follows within
+   * multiline_idle_ms; a section boundary that happens to end a TCP segment
+   * is read through. A reply whose first line is not "OK ..." (an ERROR) is
+   * a single line.
+   */
+  std::variant<std::string, Error> SendMultilineCommand(const std::string& command) {
+    if (auto err = SendAll(command + "\r\n")) {
+      return Error(*err);
+    }
+
+    std::string response;
+    std::vector<char> buffer(config_.recv_buffer_size);
+    size_t line_start = 0;
+    while (true) {
+      bool may_end = false;  // Everything received so far ends with a blank line
+      size_t newline = response.find('\n', line_start);
+      if (newline != std::string::npos) {
+        std::string_view line(response.data() + line_start, newline - line_start);
+        if (!line.empty() && line.back() == '\r') {
+          line.remove_suffix(1);
+        }
+        bool first_line = line_start == 0;
+        line_start = newline + 1;
+        if (first_line) {
+          if (line.rfind("OK", 0) != 0) {
+            break;  // Single-line reply
+          }
+          continue;
+        }
+        if (!line.empty() || line_start < response.size()) {
+          continue;  // Body line, or a blank line with more data already behind it
+        }
+
+        // Trailing blank line: the reply ends unless more data follows shortly
+        pollfd readable{sock_, POLLIN, 0};
+        int ready = 0;
+        do {
+          ready = poll(&readable, 1, static_cast<int>(config_.multiline_idle_ms));
+        } while (ready < 0 && errno == EINTR);
+        if (ready <= 0) {
+          break;
+        }
+        may_end = true;
+      }
+
+      ssize_t received = recv(sock_, buffer.data(), buffer.size(), 0);
+      if (received <= 0) {
+        if (received == 0) {
+          last_error_ = "Connection closed by server";
+        } else {
+          last_error_ = std::string("Failed to receive response: ") + strerror(errno);
+        }
+        Disconnect();
+        if (received == 0 && may_end) {
+          break;  // Closed right after a complete reply
+        }
+        return Error(last_error_);
+      }
+      response.append(buffer.data(), static_cast<size_t>(received));
+    }
+
+    // Remove the terminator
+    while (!response.empty() && (response.back() == '\n' || response.back() == '\r')) {
+      response.pop_back();
+    }
+    return response;
+  }
+
+  /**
+   * @brief Receive exactly `count` response lines (trailing \r\n stripped)
+   *
+   * Disconnects on failure, since the unread replies would otherwise be
+   * taken as the answers to later commands.
+   */
+  std::optional<std::string> ReceiveLines(size_t count, std::vector<std::string>& lines) {
+    std::string pending;
+    std::vector<char> buffer(config_.recv_buffer_size);
+    size_t line_start = 0;
+
+    while (lines.size() < count) {
+      size_t newline = pending.find('\n', line_start);
+      if (newline != std::string::npos) {
+        size_t line_end = newline;
+        if (line_end > line_start && pending[line_end - 1] == '\r') {
+          --line_end;
+        }
+        lines.emplace_back(pending, line_start, line_end - line_start);
+        line_start = newline + 1;
+        continue;
+      }
+
+      // Drop consumed bytes before reading more
+      pending.erase(0, line_start);
+      line_start = 0;
+
+      ssize_t received = recv(sock_, buffer.data(), buffer.size(), 0);
+      if (received <= 0) {
+        if (received == 0) {
+          last_error_ = "Connection closed by server";
+        } else {
+          last_error_ = std::string("Failed to receive response: ") + strerror(errno);
+        }
+        Disconnect();
+        return last_error_;
+      }
+      pending.append(buffer.data(), static_cast<size_t>(received));
+    }
+    return std::nullopt;
+  }
+
   ClientConfig config_;
   int sock_{-1};
   std::string last_error_;
+  std::unordered_map<std::string, TableSchema> schemas_;  // Field schemas by table
+  TermStatsCache term_stats_;                             // Term frequencies for reorder_terms
+  std::unordered_map<std::string, std::shared_ptr<const NgramBloomFilter>> ngram_filters_;  // By table
+  uint64_t saved_round_trips_ = 0;  // Queries answered by analyze_queries or an n-gram filter
 };
 
+// ServerInfo accessors
+
+std::optional<std::string_view> ServerInfo::Get(std::string_view key) const {
+  auto iter = values.find(key);
+  if (iter == values.end()) {
+    return std::nullopt;
+  }
+  return std::string_view(iter->second);
+}
+
+std::optional<uint64_t> ServerInfo::GetUint(std::string_view key) const {
+  auto value = Get(key);
+  if (!value || value->empty()) {
+    return std::nullopt;
+  }
+  uint64_t number = 0;
+  const char* end = value->data() + value->size();
+  auto [ptr, ec] = std::from_chars(value->data(), end, number);
+  if (ec != std::errc() || ptr != end) {
+    return std::nullopt;
+  }
+  return number;
+}
+
+std::optional<double> ServerInfo::GetDouble(std::string_view key) const {
+  auto value = Get(key);
+  double number = 0.0;
+  if (!value || !ParseDecimalNumber(*value, number)) {
+    return std::nullopt;
+  }
+  return number;
+}
+
+// Document accessors
+
+std::optional<std::string_view> Document::GetString(std::string_view name) const {
+  auto index = FindField(*this, name);
+  if (!index) {
+    return std::nullopt;
+  }
+  return std::string_view(fields[*index].second);
+}
+
+std::optional<int64_t> Document::GetInteger(std::string_view name) const {
+  auto value = GetFieldValue(*this, name, FieldType::kInteger);
+  if (!value || value->type != FieldType::kInteger) {
+    return std::nullopt;
+  }
+  return value->integer;
+}
+
+std::optional<double> Document::GetFloat(std::string_view name) const {
+  auto value = GetFieldValue(*this, name, FieldType::kFloat);
+  if (!value || (value->type != FieldType::kFloat && value->type != FieldType::kInteger)) {
+    return std::nullopt;
+  }
+  return value->number;
+}
+
+std::optional<int64_t> Document::GetTimestamp(std::string_view name) const {
+  auto value = GetFieldValue(*this, name, FieldType::kTimestamp);
+  if (!value || value->type != FieldType::kTimestamp) {
+    return std::nullopt;
+  }
+  return value->integer;
+}
+
 // MygramClient public interface implementation
 
 MygramClient::MygramClient(ClientConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
@@ -766,6 +1249,32 @@ std::variant<Document, Error> MygramClient::Get(const std::string& table, const
   return impl_->Get(table, primary_key);
 }
 
+std::variant<ColumnarDocuments, Error> MygramClient::GetColumns(const std::string& table,
+                                                                const std::vector<std::string>& primary_keys,
+                                                                const std::vector<std::string>& fields) {
+  return impl_->GetColumns(table, primary_keys, fields);
+}
+
+void MygramClient::SetFieldSchema(const std::string& table, FieldSchema schema) {
+  impl_->SetFieldSchema(table, std::move(schema));
+}
+
+std::optional<FieldSchema> MygramClient::GetFieldSchema(const std::string& table) const {
+  return impl_->GetFieldSchema(table);
+}
+
+TermStatsCache& MygramClient::GetTermStats() {
+  return impl_->GetTermStats();
+}
+
+void MygramClient::SetNgramFilter(const std::string& table, std::shared_ptr<const NgramBloomFilter> filter) {
+  impl_->SetNgramFilter(table, std::move(filter));
+}
+
+uint64_t MygramClient::GetSavedRoundTrips() const {
+  return impl_->GetSavedRoundTrips();
+}
+
 std::variant<ServerInfo, Error> MygramClient::Info() {
   return impl_->Info();
 }
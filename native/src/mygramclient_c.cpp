@@ -16,7 +16,19 @@
 #include <string>
 #include <vector>
 
+#include "expression_cache.h"
+#include "info_poller.h"
+#include "local_index.h"
+#include "memory_utils.h"
 #include "mygramclient.h"
+#include "ngram_batch.h"
+#include "ngram_filter.h"
+#include "query_canonical.h"
+#include "query_cost.h"
+#include "search_expression.h"
+#include "server_metrics.h"
+#include "string_utils.h"
+#include "utf8_decode.h"
 
 using namespace mygramdb::client;
 
@@ -26,6 +38,34 @@ struct MygramClient_C {
   std::string last_error;
 };
 
+// Opaque info poller handle
+struct MygramInfoPoller_C {
+  std::unique_ptr<InfoPoller> poller;
+  mutable std::string last_error;  // Copy returned by mygramclient_info_poller_get_last_error
+};
+
+// Opaque metrics collector handle
+struct MygramMetricsCollector_C {
+  std::unique_ptr<MetricsCollector> collector;
+  mutable std::string last_error;  // Copy returned by mygramclient_metrics_collector_get_last_error
+};
+
+// Opaque expression cache handle
+struct MygramExpressionCache_C {
+  std::unique_ptr<ExpressionCache> cache;
+};
+
+// Opaque local index handle
+struct MygramLocalIndex_C {
+  std::unique_ptr<LocalIndex> index;
+  std::string last_error;
+};
+
+// Opaque n-gram filter handle (shared with the clients it is attached to)
+struct MygramNgramFilter_C {
+  std::shared_ptr<NgramBloomFilter> filter;
+};
+
 // Helper: Allocate C string copy
 // cppcoreguidelines-no-malloc)
 static char* strdup_safe(const std::string& str) {
@@ -67,20 +107,72 @@ static void free_c_string_array(char** array, size_t count) {
   free(array);
 }
 
-MygramClient_C* mygramclient_create(const MygramClientConfig_C* config) {
-  if (config == nullptr) {
+// Helper: Copy vector contents into a malloc'd array (NULL when empty)
+template <typename T>
+static T* copy_to_c_array(const std::vector<T>& vec) {
+  if (vec.empty()) {
     return nullptr;
   }
 
-  auto* client_c = new MygramClient_C();
+  auto* result = static_cast<T*>(malloc(sizeof(T) * vec.size()));
+  if (result != nullptr) {
+    std::memcpy(result, vec.data(), sizeof(T) * vec.size());
+  }
+  return result;
+}
+
+// Helper: Convert ServerInfo to a malloc'd C struct (NULL on allocation failure)
+static MygramServerInfo_C* server_info_to_c(const ServerInfo& server_info) {
+  auto* info_c = static_cast<MygramServerInfo_C*>(calloc(1, sizeof(MygramServerInfo_C)));
+  if (info_c == nullptr) {
+    return nullptr;
+  }
+
+  info_c->version = strdup_safe(server_info.version);
+  info_c->uptime_seconds = server_info.uptime_seconds;
+  info_c->total_requests = server_info.total_requests;
+  info_c->active_connections = server_info.active_connections;
+  info_c->index_size_bytes = server_info.index_size_bytes;
+  info_c->doc_count = server_info.doc_count;
+  info_c->table_count = server_info.tables.size();
+  info_c->tables = string_vector_to_c_array(server_info.tables);
 
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  keys.reserve(server_info.values.size());
+  values.reserve(server_info.values.size());
+  for (const auto& [key, value] : server_info.values) {
+    keys.push_back(key);
+    values.push_back(value);
+  }
+  info_c->value_count = keys.size();
+  info_c->keys = string_vector_to_c_array(keys);
+  info_c->values = string_vector_to_c_array(values);
+
+  return info_c;
+}
+
+// Helper: Convert C client configuration, applying defaults for zero fields
+static ClientConfig to_client_config(const MygramClientConfig_C* config) {
   ClientConfig cpp_config;
   cpp_config.host = (config->host != nullptr) ? config->host : "127.0.0.1";
   cpp_config.port = config->port != 0 ? config->port : 11016;
   cpp_config.timeout_ms = config->timeout_ms != 0 ? config->timeout_ms : 5000;
   cpp_config.recv_buffer_size = config->recv_buffer_size != 0 ? config->recv_buffer_size : 65536;
+  cpp_config.learn_field_schemas = config->learn_field_schemas != 0;
+  cpp_config.reorder_terms = config->reorder_terms != 0;
+  cpp_config.analyze_queries = config->analyze_queries != 0;
+  return cpp_config;
+}
+
+MygramClient_C* mygramclient_create(const MygramClientConfig_C* config) {
+  if (config == nullptr) {
+    return nullptr;
+  }
+
+  auto* client_c = new MygramClient_C();
 
-  client_c->client = std::make_unique<MygramClient>(cpp_config);
+  client_c->client = std::make_unique<MygramClient>(to_client_config(config));
 
   return client_c;
 }
@@ -282,10 +374,150 @@ int mygramclient_get(MygramClient_C* client, const char* table, const char* prim
     doc_c->field_values = nullptr;
   }
 
+  // Decoded values (only when a field schema applied)
+  std::vector<int> types;
+  std::vector<int64_t> integers;
+  std::vector<double> numbers;
+  types.reserve(document.typed_fields.size());
+  integers.reserve(document.typed_fields.size());
+  numbers.reserve(document.typed_fields.size());
+  for (const auto& value : document.typed_fields) {
+    types.push_back(static_cast<int>(value.type));
+    integers.push_back(value.integer);
+    numbers.push_back(value.number);
+  }
+  doc_c->field_types = copy_to_c_array(types);
+  doc_c->field_integers = copy_to_c_array(integers);
+  doc_c->field_numbers = copy_to_c_array(numbers);
+
   *doc = doc_c;
   return 0;
 }
 
+int mygramclient_get_columns(MygramClient_C* client, const char* table, const char** primary_keys, size_t key_count,
+                             const char** fields, size_t field_count, MygramColumnarResult_C** result) {
+  if (client == nullptr || client->client == nullptr || table == nullptr || result == nullptr ||
+      (key_count > 0 && primary_keys == nullptr) || (field_count > 0 && fields == nullptr)) {
+    return -1;
+  }
+
+  std::vector<std::string> keys_vec;
+  keys_vec.reserve(key_count);
+  for (size_t i = 0; i < key_count; ++i) {
+    keys_vec.emplace_back(primary_keys[i] != nullptr ? primary_keys[i] : "");
+  }
+
+  std::vector<std::string> fields_vec;
+  fields_vec.reserve(field_count);
+  for (size_t i = 0; i < field_count; ++i) {
+    fields_vec.emplace_back(fields[i] != nullptr ? fields[i] : "");
+  }
+
+  auto columns_result = client->client->GetColumns(table, keys_vec, fields_vec);
+
+  if (auto* err = std::get_if<Error>(&columns_result)) {
+    client->last_error = err->message;
+    return -1;
+  }
+
+  const auto& docs = std::get<ColumnarDocuments>(columns_result);
+
+  auto* result_c = static_cast<MygramColumnarResult_C*>(calloc(1, sizeof(MygramColumnarResult_C)));
+  if (result_c == nullptr) {
+    client->last_error = "Memory allocation failed";
+    return -1;
+  }
+
+  result_c->row_count = docs.primary_keys.size();
+  result_c->primary_keys = string_vector_to_c_array(docs.primary_keys);
+  result_c->found = copy_to_c_array(docs.found);
+  result_c->column_count = docs.columns.size();
+  if (!docs.columns.empty()) {
+    result_c->columns = static_cast<MygramColumn_C*>(calloc(docs.columns.size(), sizeof(MygramColumn_C)));
+    if (result_c->columns == nullptr) {
+      result_c->column_count = 0;
+      mygramclient_free_columnar_result(result_c);
+      client->last_error = "Memory allocation failed";
+      return -1;
+    }
+  }
+
+  for (size_t i = 0; i < docs.columns.size(); ++i) {
+    const auto& column = docs.columns[i];
+    auto& column_c = result_c->columns[i];
+    column_c.name = strdup_safe(column.name);
+    column_c.is_numeric = column.kind == ColumnKind::kNumeric ? 1 : 0;
+    column_c.present = copy_to_c_array(column.present);
+    column_c.field_type = column.declared_type ? static_cast<int>(*column.declared_type) : -1;
+    if (column.kind == ColumnKind::kNumeric) {
+      column_c.numbers = copy_to_c_array(column.numbers);
+    } else {
+      column_c.string_data_size = column.string_data.size();
+      column_c.string_data = static_cast<char*>(malloc(column.string_data.size() + 1));
+      if (column_c.string_data != nullptr) {
+        std::memcpy(column_c.string_data, column.string_data.data(), column.string_data.size());
+        column_c.string_data[column.string_data.size()] = '\0';
+      }
+      column_c.string_offsets = copy_to_c_array(column.string_offsets);
+    }
+  }
+
+  *result = result_c;
+  return 0;
+}
+
+int mygramclient_set_field_schema(MygramClient_C* client, const char* table, const char** field_names,
+                                  const int* field_types, size_t field_count) {
+  if (client == nullptr || client->client == nullptr || table == nullptr ||
+      (field_count > 0 && (field_names == nullptr || field_types == nullptr))) {
+    return -1;
+  }
+
+  FieldSchema schema;
+  for (size_t i = 0; i < field_count; ++i) {
+    if (field_names[i] == nullptr) {
+      continue;
+    }
+    if (field_types[i] < MYGRAM_FIELD_STRING || field_types[i] > MYGRAM_FIELD_TIMESTAMP) {
+      client->last_error = std::string("Invalid field type for ") + field_names[i];
+      return -1;
+    }
+    schema[field_names[i]] = static_cast<FieldType>(field_types[i]);
+  }
+
+  client->client->SetFieldSchema(table, std::move(schema));
+  return 0;
+}
+
+int mygramclient_get_field_schema(MygramClient_C* client, const char* table, MygramFieldSchema_C** schema) {
+  if (client == nullptr || client->client == nullptr || table == nullptr || schema == nullptr) {
+    return -1;
+  }
+
+  auto* schema_c = static_cast<MygramFieldSchema_C*>(calloc(1, sizeof(MygramFieldSchema_C)));
+  if (schema_c == nullptr) {
+    client->last_error = "Memory allocation failed";
+    return -1;
+  }
+
+  if (auto field_schema = client->client->GetFieldSchema(table)) {
+    std::vector<std::string> names;
+    std::vector<int> types;
+    names.reserve(field_schema->size());
+    types.reserve(field_schema->size());
+    for (const auto& [name, type] : *field_schema) {
+      names.push_back(name);
+      types.push_back(static_cast<int>(type));
+    }
+    schema_c->field_count = names.size();
+    schema_c->field_names = string_vector_to_c_array(names);
+    schema_c->field_types = copy_to_c_array(types);
+  }
+
+  *schema = schema_c;
+  return 0;
+}
+
 int mygramclient_info(MygramClient_C* client, MygramServerInfo_C** info) {
   if (client == nullptr || client->client == nullptr || info == nullptr) {
     return -1;
@@ -298,23 +530,12 @@ int mygramclient_info(MygramClient_C* client, MygramServerInfo_C** info) {
     return -1;
   }
 
-  auto server_info = std::get<ServerInfo>(info_result);
-
-  auto* info_c = static_cast<MygramServerInfo_C*>(malloc(sizeof(MygramServerInfo_C)));
+  auto* info_c = server_info_to_c(std::get<ServerInfo>(info_result));
   if (info_c == nullptr) {
     client->last_error = "Memory allocation failed";
     return -1;
   }
 
-  info_c->version = strdup_safe(server_info.version);
-  info_c->uptime_seconds = server_info.uptime_seconds;
-  info_c->total_requests = server_info.total_requests;
-  info_c->active_connections = server_info.active_connections;
-  info_c->index_size_bytes = server_info.index_size_bytes;
-  info_c->doc_count = server_info.doc_count;
-  info_c->table_count = server_info.tables.size();
-  info_c->tables = string_vector_to_c_array(server_info.tables);
-
   *info = info_c;
   return 0;
 }
@@ -432,6 +653,775 @@ const char* mygramclient_get_last_error(const MygramClient_C* client) {
   return client->last_error.c_str();
 }
 
+uint64_t mygramclient_get_saved_round_trips(const MygramClient_C* client) {
+  if (client == nullptr) {
+    return 0;
+  }
+
+  return client->client->GetSavedRoundTrips();
+}
+
+MygramInfoPoller_C* mygramclient_info_poller_create(const MygramClientConfig_C* config, uint32_t interval_ms) {
+  if (config == nullptr) {
+    return nullptr;
+  }
+
+  InfoPollerConfig poller_config;
+  poller_config.client = to_client_config(config);
+  if (interval_ms != 0) {
+    poller_config.interval_ms = interval_ms;
+  }
+
+  auto* poller_c = new MygramInfoPoller_C();
+  poller_c->poller = std::make_unique<InfoPoller>(std::move(poller_config));
+  return poller_c;
+}
+
+void mygramclient_info_poller_destroy(MygramInfoPoller_C* poller) {
+  delete poller;
+}
+
+int mygramclient_info_poller_start(MygramInfoPoller_C* poller) {
+  if (poller == nullptr || poller->poller == nullptr) {
+    return -1;
+  }
+
+  return poller->poller->Start() ? -1 : 0;
+}
+
+void mygramclient_info_poller_stop(MygramInfoPoller_C* poller) {
+  if (poller != nullptr && poller->poller != nullptr) {
+    poller->poller->Stop();
+  }
+}
+
+int mygramclient_info_poller_poll_now(MygramInfoPoller_C* poller) {
+  if (poller == nullptr || poller->poller == nullptr) {
+    return -1;
+  }
+
+  return poller->poller->PollNow() ? -1 : 0;
+}
+
+int mygramclient_info_poller_latest(MygramInfoPoller_C* poller, MygramServerInfo_C** info, int64_t* captured_at_ms,
+                                    uint64_t* sequence) {
+  if (poller == nullptr || poller->poller == nullptr || info == nullptr) {
+    return -1;
+  }
+
+  *info = nullptr;
+  auto snapshot = poller->poller->Latest();
+  if (snapshot == nullptr) {
+    return 0;
+  }
+
+  *info = server_info_to_c(snapshot->info);
+  if (*info == nullptr) {
+    return -1;
+  }
+  if (captured_at_ms != nullptr) {
+    *captured_at_ms = snapshot->captured_at_ms;
+  }
+  if (sequence != nullptr) {
+    *sequence = snapshot->sequence;
+  }
+  return 0;
+}
+
+const char* mygramclient_info_poller_get_last_error(const MygramInfoPoller_C* poller) {
+  if (poller == nullptr || poller->poller == nullptr) {
+    return "Invalid poller handle";
+  }
+
+  poller->last_error = poller->poller->GetLastError();
+  return poller->last_error.c_str();
+}
+
+MygramMetricsCollector_C* mygramclient_metrics_collector_create(const MygramClientConfig_C* config,
+                                                                uint32_t interval_ms, const uint32_t* window_seconds,
+                                                                size_t window_count) {
+  if (config == nullptr) {
+    return nullptr;
+  }
+
+  MetricsCollectorConfig collector_config;
+  collector_config.poller.client = to_client_config(config);
+  if (interval_ms != 0) {
+    collector_config.poller.interval_ms = interval_ms;
+  }
+  if (window_seconds != nullptr && window_count > 0) {
+    collector_config.window_seconds.assign(window_seconds, window_seconds + window_count);
+  }
+
+  auto* collector_c = new MygramMetricsCollector_C();
+  collector_c->collector = std::make_unique<MetricsCollector>(std::move(collector_config));
+  return collector_c;
+}
+
+void mygramclient_metrics_collector_destroy(MygramMetricsCollector_C* collector) {
+  delete collector;
+}
+
+int mygramclient_metrics_collector_start(MygramMetricsCollector_C* collector) {
+  if (collector == nullptr || collector->collector == nullptr) {
+    return -1;
+  }
+
+  return collector->collector->Start() ? -1 : 0;
+}
+
+void mygramclient_metrics_collector_stop(MygramMetricsCollector_C* collector) {
+  if (collector != nullptr && collector->collector != nullptr) {
+    collector->collector->Stop();
+  }
+}
+
+int mygramclient_metrics_collector_get(MygramMetricsCollector_C* collector, MygramServerMetrics_C** metrics) {
+  if (collector == nullptr || collector->collector == nullptr || metrics == nullptr) {
+    return -1;
+  }
+
+  ServerMetrics server_metrics = collector->collector->GetMetrics();
+
+  auto* metrics_c = static_cast<MygramServerMetrics_C*>(calloc(1, sizeof(MygramServerMetrics_C)));
+  if (metrics_c == nullptr) {
+    return -1;
+  }
+
+  metrics_c->captured_at_ms = server_metrics.captured_at_ms;
+  metrics_c->sample_count = server_metrics.sample_count;
+  metrics_c->doc_count = server_metrics.doc_count;
+  metrics_c->index_size_bytes = server_metrics.index_size_bytes;
+  metrics_c->index_bytes_per_doc = server_metrics.index_bytes_per_doc;
+  metrics_c->active_connections = server_metrics.active_connections;
+  metrics_c->reports_errors = server_metrics.reports_errors ? 1 : 0;
+  metrics_c->counter_resets = server_metrics.counter_resets;
+
+  std::vector<MygramMetricsWindow_C> windows;
+  windows.reserve(server_metrics.windows.size());
+  for (const auto& window : server_metrics.windows) {
+    windows.push_back({window.window_seconds, window.covered_seconds, window.requests_per_second,
+                       window.errors_per_second, window.error_ratio, window.docs_per_second, window.doc_delta,
+                       window.index_bytes_delta});
+  }
+  metrics_c->windows = copy_to_c_array(windows);
+  metrics_c->window_count = metrics_c->windows != nullptr ? windows.size() : 0;
+
+  *metrics = metrics_c;
+  return 0;
+}
+
+const char* mygramclient_metrics_collector_get_last_error(const MygramMetricsCollector_C* collector) {
+  if (collector == nullptr || collector->collector == nullptr) {
+    return "Invalid collector handle";
+  }
+
+  collector->last_error = collector->collector->GetLastError();
+  return collector->last_error.c_str();
+}
+
+MygramExpressionCache_C* mygramclient_expression_cache_create(size_t capacity) {
+  ExpressionCacheConfig config;
+  config.capacity = capacity;
+
+  auto* cache_c = new MygramExpressionCache_C();
+  cache_c->cache = std::make_unique<ExpressionCache>(config);
+  return cache_c;
+}
+
+void mygramclient_expression_cache_destroy(MygramExpressionCache_C* cache) {
+  delete cache;
+}
+
+int mygramclient_expression_cache_get(MygramExpressionCache_C* cache, const char* expression,
+                                      MygramParsedExpression_C** result) {
+  if (cache == nullptr || cache->cache == nullptr || expression == nullptr || result == nullptr) {
+    return -1;
+  }
+
+  auto parsed = cache->cache->Get(expression);
+
+  auto* result_c = static_cast<MygramParsedExpression_C*>(calloc(1, sizeof(MygramParsedExpression_C)));
+  if (result_c == nullptr) {
+    return -1;
+  }
+
+  if (!parsed->Ok()) {
+    result_c->error = strdup_safe(parsed->error);
+  } else {
+    result_c->query = strdup_safe(parsed->query);
+    result_c->simplified = parsed->simplified ? 1 : 0;
+    if (parsed->simplified) {
+      result_c->main_term = strdup_safe(parsed->main_term);
+      result_c->and_terms = string_vector_to_c_array(parsed->and_terms);
+      result_c->and_count = parsed->and_terms.size();
+      result_c->not_terms = string_vector_to_c_array(parsed->not_terms);
+      result_c->not_count = parsed->not_terms.size();
+    }
+  }
+
+  *result = result_c;
+  return 0;
+}
+
+int mygramclient_expression_cache_stats(const MygramExpressionCache_C* cache, MygramExpressionCacheStats_C* stats) {
+  if (cache == nullptr || cache->cache == nullptr || stats == nullptr) {
+    return -1;
+  }
+
+  ExpressionCacheStats cache_stats = cache->cache->GetStats();
+  stats->hits = cache_stats.hits;
+  stats->misses = cache_stats.misses;
+  stats->evictions = cache_stats.evictions;
+  stats->size = cache_stats.size;
+  stats->capacity = cache_stats.capacity;
+  return 0;
+}
+
+void mygramclient_expression_cache_resize(MygramExpressionCache_C* cache, size_t capacity) {
+  if (cache != nullptr && cache->cache != nullptr) {
+    cache->cache->Resize(capacity);
+  }
+}
+
+void mygramclient_expression_cache_clear(MygramExpressionCache_C* cache) {
+  if (cache != nullptr && cache->cache != nullptr) {
+    cache->cache->Clear();
+  }
+}
+
+// Helper: Convert a C string array to a vector, skipping NULL entries
+static std::vector<std::string> c_array_to_string_vector(const char** values, size_t count) {
+  std::vector<std::string> vec;
+  for (size_t i = 0; values != nullptr && i < count; ++i) {
+    if (values[i] != nullptr) {
+      vec.emplace_back(values[i]);
+    }
+  }
+  return vec;
+}
+
+// Helper: Convert parallel key/value C arrays to pairs, skipping NULL entries
+static std::vector<std::pair<std::string, std::string>> c_arrays_to_pairs(const char** keys, const char** values,
+                                                                          size_t count) {
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (size_t i = 0; keys != nullptr && values != nullptr && i < count; ++i) {
+    if (keys[i] != nullptr && values[i] != nullptr) {
+      pairs.emplace_back(keys[i], values[i]);
+    }
+  }
+  return pairs;
+}
+
+MygramLocalIndex_C* mygramclient_local_index_create(const MygramLocalIndexConfig_C* config) {
+  LocalIndexConfig index_config;
+  if (config != nullptr) {
+    if (config->ascii_ngram_size > 0) {
+      index_config.ascii_ngram_size = config->ascii_ngram_size;
+    }
+    if (config->kanji_ngram_size > 0) {
+      index_config.kanji_ngram_size = config->kanji_ngram_size;
+    }
+    index_config.normalization.nfkc = config->nfkc != 0;
+    index_config.normalization.width = config->width != nullptr ? config->width : "keep";
+    index_config.normalization.lower = config->lower != 0;
+  }
+
+  auto* index_c = new MygramLocalIndex_C();
+  index_c->index = std::make_unique<LocalIndex>(index_config);
+  return index_c;
+}
+
+void mygramclient_local_index_destroy(MygramLocalIndex_C* index) {
+  delete index;
+}
+
+int mygramclient_local_index_add(MygramLocalIndex_C* index, const char* primary_key, const char* text, size_t length,
+                                 const char** field_keys, const char** field_values, size_t field_count) {
+  if (index == nullptr || index->index == nullptr || primary_key == nullptr || (text == nullptr && length > 0)) {
+    return -1;
+  }
+
+  index->index->Add(primary_key, std::string_view(text, length),
+                    c_arrays_to_pairs(field_keys, field_values, field_count));
+  return 0;
+}
+
+int mygramclient_local_index_remove(MygramLocalIndex_C* index, const char* primary_key) {
+  if (index == nullptr || index->index == nullptr || primary_key == nullptr) {
+    return -1;
+  }
+  return index->index->Remove(primary_key) ? 1 : 0;
+}
+
+int mygramclient_local_index_search(MygramLocalIndex_C* index, const char* query, uint32_t limit, uint32_t offset,
+                                    const char** and_terms, size_t and_count, const char** not_terms,
+                                    size_t not_count, const char** filter_keys, const char** filter_values,
+                                    size_t filter_count, const char* sort_column, int sort_desc,
+                                    MygramSearchResult_C** result) {
+  if (index == nullptr || index->index == nullptr || query == nullptr || result == nullptr) {
+    return -1;
+  }
+
+  auto search_result = index->index->Search(
+      query, limit, offset, c_array_to_string_vector(and_terms, and_count),
+      c_array_to_string_vector(not_terms, not_count), c_arrays_to_pairs(filter_keys, filter_values, filter_count),
+      sort_column != nullptr ? sort_column : "", sort_desc != 0);
+
+  if (auto* err = std::get_if<Error>(&search_result)) {
+    index->last_error = err->message;
+    return -1;
+  }
+
+  const auto& resp = std::get<SearchResponse>(search_result);
+
+  auto* result_c = static_cast<MygramSearchResult_C*>(calloc(1, sizeof(MygramSearchResult_C)));
+  if (result_c == nullptr) {
+    index->last_error = "Memory allocation failed";
+    return -1;
+  }
+
+  result_c->count = resp.results.size();
+  result_c->total_count = resp.total_count;
+  if (!resp.results.empty()) {
+    result_c->primary_keys = static_cast<char**>(malloc(sizeof(char*) * resp.results.size()));
+    if (result_c->primary_keys == nullptr) {
+      free(result_c);
+      index->last_error = "Memory allocation failed";
+      return -1;
+    }
+    for (size_t i = 0; i < resp.results.size(); ++i) {
+      result_c->primary_keys[i] = strdup_safe(resp.results[i].primary_key);
+    }
+  }
+
+  *result = result_c;
+  return 0;
+}
+
+int mygramclient_local_index_count(MygramLocalIndex_C* index, const char* query, const char** and_terms,
+                                   size_t and_count, const char** not_terms, size_t not_count,
+                                   const char** filter_keys, const char** filter_values, size_t filter_count,
+                                   uint64_t* count) {
+  if (index == nullptr || index->index == nullptr || query == nullptr || count == nullptr) {
+    return -1;
+  }
+
+  auto count_result = index->index->Count(query, c_array_to_string_vector(and_terms, and_count),
+                                          c_array_to_string_vector(not_terms, not_count),
+                                          c_arrays_to_pairs(filter_keys, filter_values, filter_count));
+
+  if (auto* err = std::get_if<Error>(&count_result)) {
+    index->last_error = err->message;
+    return -1;
+  }
+
+  *count = std::get<CountResponse>(count_result).count;
+  return 0;
+}
+
+int mygramclient_local_index_stats(const MygramLocalIndex_C* index, MygramLocalIndexStats_C* stats) {
+  if (index == nullptr || index->index == nullptr || stats == nullptr) {
+    return -1;
+  }
+
+  LocalIndexStats index_stats = index->index->GetStats();
+  stats->documents = index_stats.documents;
+  stats->removed = index_stats.removed;
+  stats->ngrams = index_stats.ngrams;
+  stats->postings = index_stats.postings;
+  stats->posting_bytes = index_stats.posting_bytes;
+  return 0;
+}
+
+void mygramclient_local_index_compact(MygramLocalIndex_C* index) {
+  if (index != nullptr && index->index != nullptr) {
+    index->index->Compact();
+  }
+}
+
+void mygramclient_local_index_clear(MygramLocalIndex_C* index) {
+  if (index != nullptr && index->index != nullptr) {
+    index->index->Clear();
+  }
+}
+
+const char* mygramclient_local_index_get_last_error(const MygramLocalIndex_C* index) {
+  if (index == nullptr) {
+    return "Invalid index handle";
+  }
+  return index->last_error.c_str();
+}
+
+MygramNgramFilter_C* mygramclient_ngram_filter_create(size_t expected_ngrams, const MygramNgramFilterConfig_C* config) {
+  NgramFilterConfig filter_config;
+  if (config != nullptr) {
+    if (config->ascii_ngram_size > 0) {
+      filter_config.ascii_ngram_size = config->ascii_ngram_size;
+    }
+    if (config->kanji_ngram_size > 0) {
+      filter_config.kanji_ngram_size = config->kanji_ngram_size;
+    }
+    filter_config.normalization.nfkc = config->nfkc != 0;
+    filter_config.normalization.width = config->width != nullptr ? config->width : "keep";
+    filter_config.normalization.lower = config->lower != 0;
+    if (config->bits_per_ngram > 0) {
+      filter_config.bits_per_ngram = config->bits_per_ngram;
+    }
+  }
+
+  auto* filter_c = new MygramNgramFilter_C();
+  filter_c->filter = std::make_shared<NgramBloomFilter>(expected_ngrams, filter_config);
+  return filter_c;
+}
+
+MygramNgramFilter_C* mygramclient_ngram_filter_deserialize(const uint8_t* data, size_t length) {
+  if (data == nullptr) {
+    return nullptr;
+  }
+
+  auto result = NgramBloomFilter::Deserialize(std::string_view(reinterpret_cast<const char*>(data), length));
+  if (std::holds_alternative<Error>(result)) {
+    return nullptr;
+  }
+  auto* filter_c = new MygramNgramFilter_C();
+  filter_c->filter = std::make_shared<NgramBloomFilter>(std::get<NgramBloomFilter>(std::move(result)));
+  return filter_c;
+}
+
+void mygramclient_ngram_filter_destroy(MygramNgramFilter_C* filter) {
+  delete filter;
+}
+
+int mygramclient_ngram_filter_add_text(MygramNgramFilter_C* filter, const char* text, size_t length) {
+  if (filter == nullptr || filter->filter == nullptr || (text == nullptr && length > 0)) {
+    return -1;
+  }
+  filter->filter->AddText(std::string_view(text != nullptr ? text : "", length));
+  return 0;
+}
+
+int mygramclient_ngram_filter_add_hashes(MygramNgramFilter_C* filter, const uint64_t* hashes, size_t count) {
+  if (filter == nullptr || filter->filter == nullptr || (hashes == nullptr && count > 0)) {
+    return -1;
+  }
+  filter->filter->AddHashes(hashes, count);
+  return 0;
+}
+
+int mygramclient_ngram_filter_may_match(const MygramNgramFilter_C* filter, const char* term) {
+  if (filter == nullptr || filter->filter == nullptr || term == nullptr) {
+    return -1;
+  }
+  return filter->filter->MayMatch(term) ? 1 : 0;
+}
+
+int mygramclient_ngram_filter_stats(const MygramNgramFilter_C* filter, MygramNgramFilterStats_C* stats) {
+  if (filter == nullptr || filter->filter == nullptr || stats == nullptr) {
+    return -1;
+  }
+
+  NgramFilterStats filter_stats = filter->filter->GetStats();
+  stats->ngrams = filter_stats.ngrams;
+  stats->size_bytes = filter_stats.size_bytes;
+  stats->hash_count = filter_stats.hash_count;
+  stats->false_positive_rate = filter_stats.false_positive_rate;
+  return 0;
+}
+
+int mygramclient_ngram_filter_serialize(const MygramNgramFilter_C* filter, uint8_t** data, size_t* length) {
+  if (filter == nullptr || filter->filter == nullptr || data == nullptr || length == nullptr) {
+    return -1;
+  }
+
+  std::string bytes = filter->filter->Serialize();
+  *data = static_cast<uint8_t*>(malloc(bytes.size()));
+  if (*data == nullptr) {
+    *length = 0;
+    return -1;
+  }
+  std::memcpy(*data, bytes.data(), bytes.size());
+  *length = bytes.size();
+  return 0;
+}
+
+int mygramclient_set_ngram_filter(MygramClient_C* client, const char* table, const MygramNgramFilter_C* filter) {
+  if (client == nullptr || client->client == nullptr || table == nullptr) {
+    return -1;
+  }
+  client->client->SetNgramFilter(table, filter != nullptr ? filter->filter : nullptr);
+  return 0;
+}
+
+int mygramclient_convert_search_expressions(const char** expressions, size_t count, size_t max_threads,
+                                            MygramConvertedExpressions_C** result) {
+  if ((expressions == nullptr && count > 0) || result == nullptr) {
+    return -1;
+  }
+
+  std::vector<std::string> inputs;
+  inputs.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    inputs.emplace_back(expressions[i] != nullptr ? expressions[i] : "");
+  }
+  ConvertedExpressions converted = ConvertSearchExpressions(inputs, max_threads);
+
+  auto* result_c =
+      static_cast<MygramConvertedExpressions_C*>(calloc(1, sizeof(MygramConvertedExpressions_C)));
+  if (result_c == nullptr) {
+    return -1;
+  }
+
+  result_c->data = strdup_safe(converted.data);
+  result_c->data_size = converted.data.size();
+  result_c->offsets = copy_to_c_array(converted.offsets);
+  result_c->ok = copy_to_c_array(converted.ok);
+  result_c->count = converted.Size();
+  if (result_c->data == nullptr || result_c->offsets == nullptr || (count > 0 && result_c->ok == nullptr)) {
+    mygramclient_free_converted_expressions(result_c);
+    return -1;
+  }
+
+  *result = result_c;
+  return 0;
+}
+
+// Helper: Convert C normalization settings (NULL = none)
+static QueryNormalization to_query_normalization(const MygramQueryNormalization_C* normalization) {
+  QueryNormalization result;
+  if (normalization != nullptr) {
+    result.nfkc = normalization->nfkc != 0;
+    result.width = normalization->width != nullptr ? normalization->width : "keep";
+    result.lower = normalization->lower != 0;
+  }
+  return result;
+}
+
+int mygramclient_canonical_search_key(const char* table, const char* query, const char** and_terms, size_t and_count,
+                                      const char** not_terms, size_t not_count, const char** filter_keys,
+                                      const char** filter_values, size_t filter_count, const char* sort_column,
+                                      int sort_desc, uint32_t limit, uint32_t offset,
+                                      const MygramQueryNormalization_C* normalization, char** key) {
+  if (table == nullptr || query == nullptr || key == nullptr) {
+    return -1;
+  }
+
+  *key = strdup_safe(CanonicalSearchKey(
+      table, query, c_array_to_string_vector(and_terms, and_count), c_array_to_string_vector(not_terms, not_count),
+      c_arrays_to_pairs(filter_keys, filter_values, filter_count), sort_column != nullptr ? sort_column : "",
+      sort_desc != 0, limit, offset, to_query_normalization(normalization)));
+  return *key != nullptr ? 0 : -1;
+}
+
+int mygramclient_canonical_count_key(const char* table, const char* query, const char** and_terms, size_t and_count,
+                                     const char** not_terms, size_t not_count, const char** filter_keys,
+                                     const char** filter_values, size_t filter_count,
+                                     const MygramQueryNormalization_C* normalization, char** key) {
+  if (table == nullptr || query == nullptr || key == nullptr) {
+    return -1;
+  }
+
+  *key = strdup_safe(CanonicalCountKey(
+      table, query, c_array_to_string_vector(and_terms, and_count), c_array_to_string_vector(not_terms, not_count),
+      c_arrays_to_pairs(filter_keys, filter_values, filter_count), to_query_normalization(normalization)));
+  return *key != nullptr ? 0 : -1;
+}
+
+int mygramclient_validate_utf8(const char* data, size_t length, size_t* error_offset) {
+  if (data == nullptr && length > 0) {
+    return -1;
+  }
+  return mygramdb::utils::ValidateUtf8(std::string_view(data != nullptr ? data : "", length), error_offset) ? 1 : 0;
+}
+
+int mygramclient_get_memory_health(MygramMemoryHealth_C* health) {
+  if (health == nullptr) {
+    return -1;
+  }
+
+  *health = {};
+  health->status = static_cast<int>(mygramdb::utils::MemoryHealthStatus::UNKNOWN);
+  if (auto info = mygramdb::utils::GetSystemMemoryInfo()) {
+    health->status = static_cast<int>(mygramdb::utils::GetMemoryHealthStatus(*info));
+    health->total_physical_bytes = info->total_physical_bytes;
+    health->available_physical_bytes = info->available_physical_bytes;
+    health->cgroup_limited = info->cgroup_limited ? 1 : 0;
+  }
+  return 0;
+}
+
+// Helper: Copy hashes out of a per-thread buffer reused across calls
+template <typename Generate>
+static int hash_ngrams(const char* text, size_t length, uint64_t** hashes, size_t* count, Generate&& generate) {
+  if ((text == nullptr && length > 0) || hashes == nullptr || count == nullptr) {
+    return -1;
+  }
+
+  thread_local mygramdb::utils::NgramScratch scratch;
+  thread_local std::vector<uint64_t> buffer;
+  generate(std::string_view(text != nullptr ? text : "", length), scratch, buffer);
+
+  *hashes = copy_to_c_array(buffer);
+  if (*hashes == nullptr && !buffer.empty()) {
+    *count = 0;
+    return -1;
+  }
+  *count = buffer.size();
+  return 0;
+}
+
+int mygramclient_ngram_hashes(const char* text, size_t length, int ngram_size, uint64_t** hashes, size_t* count) {
+  return hash_ngrams(text, length, hashes, count, [ngram_size](auto view, auto& scratch, auto& out) {
+    mygramdb::utils::GenerateNgramHashes(view, ngram_size, scratch, out);
+  });
+}
+
+int mygramclient_hybrid_ngram_hashes(const char* text, size_t length, int ascii_ngram_size, int kanji_ngram_size,
+                                     uint64_t** hashes, size_t* count) {
+  return hash_ngrams(text, length, hashes, count, [=](auto view, auto& scratch, auto& out) {
+    mygramdb::utils::GenerateHybridNgramHashes(view, ascii_ngram_size, kanji_ngram_size, scratch, out);
+  });
+}
+
+int mygramclient_ngram_batch(const char* data, const uint32_t* offsets, size_t count,
+                             const MygramNgramBatchConfig_C* config, MygramNgramBatch_C** result) {
+  if ((data == nullptr && count > 0) || offsets == nullptr || result == nullptr) {
+    return -1;
+  }
+
+  using mygramdb::utils::NgramBatchOutput;
+  mygramdb::utils::NgramBatchOptions options;
+  if (config != nullptr) {
+    if (config->ascii_ngram_size > 0) {
+      options.ascii_ngram_size = config->ascii_ngram_size;
+    }
+    if (config->kanji_ngram_size > 0) {
+      options.kanji_ngram_size = config->kanji_ngram_size;
+    }
+    options.normalizer = mygramdb::utils::Normalizer(
+        config->nfkc != 0, mygramdb::utils::ParseWidthMode(config->width != nullptr ? config->width : "keep"),
+        config->lower != 0);
+    if (config->output < MYGRAM_NGRAM_BATCH_COUNTS || config->output > MYGRAM_NGRAM_BATCH_NGRAMS) {
+      return -1;
+    }
+    options.output = static_cast<NgramBatchOutput>(config->output);
+    options.distinct = config->distinct != 0;
+    options.max_threads = config->max_threads;
+  }
+
+  std::vector<std::string_view> documents;
+  documents.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    if (offsets[i + 1] < offsets[i]) {
+      return -1;
+    }
+    documents.emplace_back(data + offsets[i], offsets[i + 1] - offsets[i]);
+  }
+
+  auto batch = mygramdb::utils::GenerateNgramBatch(documents, options);
+
+  auto* result_c = static_cast<MygramNgramBatch_C*>(calloc(1, sizeof(MygramNgramBatch_C)));
+  if (result_c == nullptr) {
+    return -1;
+  }
+
+  result_c->counts = copy_to_c_array(batch.counts);
+  result_c->count = batch.Size();
+  result_c->document_offsets = copy_to_c_array(batch.document_offsets);
+  result_c->hashes = copy_to_c_array(batch.hashes);
+  result_c->hash_count = batch.hashes.size();
+  bool ok = (count == 0 || result_c->counts != nullptr) &&
+            (batch.document_offsets.empty() || result_c->document_offsets != nullptr) &&
+            (batch.hashes.empty() || result_c->hashes != nullptr);
+  if (options.output == NgramBatchOutput::kNgrams) {
+    result_c->data = strdup_safe(batch.data);
+    result_c->data_size = batch.data.size();
+    result_c->ngram_offsets = copy_to_c_array(batch.ngram_offsets);
+    result_c->ngram_count = batch.ngram_offsets.size() - 1;
+    ok = ok && result_c->data != nullptr && result_c->ngram_offsets != nullptr;
+  }
+  if (!ok) {
+    mygramclient_free_ngram_batch(result_c);
+    return -1;
+  }
+
+  *result = result_c;
+  return 0;
+}
+
+int mygramclient_estimate_query_cost(const char* expression, const MygramQueryCostConfig_C* config,
+                                     MygramQueryCost_C** result) {
+  if (expression == nullptr || result == nullptr) {
+    return -1;
+  }
+
+  QueryCostConfig cost_config;
+  if (config != nullptr) {
+    if (config->ascii_ngram_size > 0) {
+      cost_config.ascii_ngram_size = config->ascii_ngram_size;
+    }
+    if (config->kanji_ngram_size > 0) {
+      cost_config.kanji_ngram_size = config->kanji_ngram_size;
+    }
+    cost_config.normalization.nfkc = config->nfkc != 0;
+    cost_config.normalization.width = config->width != nullptr ? config->width : "keep";
+    cost_config.normalization.lower = config->lower != 0;
+    if (config->moderate_ngrams != 0) {
+      cost_config.moderate_ngrams = config->moderate_ngrams;
+    }
+    if (config->high_ngrams != 0) {
+      cost_config.high_ngrams = config->high_ngrams;
+    }
+    if (config->excessive_ngrams != 0) {
+      cost_config.excessive_ngrams = config->excessive_ngrams;
+    }
+  }
+
+  auto estimate = EstimateExpressionCost(expression, cost_config);
+
+  auto* result_c = static_cast<MygramQueryCost_C*>(calloc(1, sizeof(MygramQueryCost_C)));
+  if (result_c == nullptr) {
+    return -1;
+  }
+
+  if (auto* err = std::get_if<std::string>(&estimate)) {
+    result_c->error = strdup_safe(*err);
+    *result = result_c;
+    return 0;
+  }
+
+  const QueryCost& cost = std::get<QueryCost>(estimate);
+  std::vector<std::string> terms;
+  std::vector<uint32_t> term_ngrams;
+  std::vector<uint8_t> term_flags;
+  terms.reserve(cost.terms.size());
+  for (const auto& term : cost.terms) {
+    terms.push_back(term.term);
+    term_ngrams.push_back(term.ngrams);
+    term_flags.push_back(static_cast<uint8_t>((term.phrase ? MYGRAM_TERM_PHRASE : 0) |
+                                              (term.excluded ? MYGRAM_TERM_EXCLUDED : 0) |
+                                              (term.optional ? MYGRAM_TERM_OPTIONAL : 0)));
+  }
+  result_c->terms = string_vector_to_c_array(terms);
+  result_c->term_ngrams = copy_to_c_array(term_ngrams);
+  result_c->term_flags = copy_to_c_array(term_flags);
+  result_c->term_count = terms.size();
+  if (!terms.empty() &&
+      (result_c->terms == nullptr || result_c->term_ngrams == nullptr || result_c->term_flags == nullptr)) {
+    result_c->term_count = result_c->terms != nullptr ? terms.size() : 0;
+    mygramclient_free_query_cost(result_c);
+    return -1;
+  }
+  result_c->total_ngrams = cost.total_ngrams;
+  result_c->distinct_ngrams = cost.distinct_ngrams;
+  result_c->max_term_ngrams = cost.max_term_ngrams;
+  result_c->short_terms = cost.short_terms;
+  result_c->cost_class = static_cast<int>(cost.cost_class);
+
+  *result = result_c;
+  return 0;
+}
+
 void mygramclient_free_search_result(MygramSearchResult_C* result) {
   if (result == nullptr) {
     return;
@@ -449,9 +1439,41 @@ void mygramclient_free_document(MygramDocument_C* doc) {
   free(doc->primary_key);
   free_c_string_array(doc->field_keys, doc->field_count);
   free_c_string_array(doc->field_values, doc->field_count);
+  free(doc->field_types);
+  free(doc->field_integers);
+  free(doc->field_numbers);
   free(doc);
 }
 
+void mygramclient_free_field_schema(MygramFieldSchema_C* schema) {
+  if (schema == nullptr) {
+    return;
+  }
+
+  free_c_string_array(schema->field_names, schema->field_count);
+  free(schema->field_types);
+  free(schema);
+}
+
+void mygramclient_free_columnar_result(MygramColumnarResult_C* result) {
+  if (result == nullptr) {
+    return;
+  }
+
+  free_c_string_array(result->primary_keys, result->row_count);
+  free(result->found);
+  for (size_t i = 0; i < result->column_count; ++i) {
+    MygramColumn_C& column = result->columns[i];
+    free(column.name);
+    free(column.numbers);
+    free(column.string_data);
+    free(column.string_offsets);
+    free(column.present);
+  }
+  free(result->columns);
+  free(result);
+}
+
 void mygramclient_free_server_info(MygramServerInfo_C* info) {
   if (info == nullptr) {
     return;
@@ -459,9 +1481,77 @@ void mygramclient_free_server_info(MygramServerInfo_C* info) {
 
   free(info->version);
   free_c_string_array(info->tables, info->table_count);
+  free_c_string_array(info->keys, info->value_count);
+  free_c_string_array(info->values, info->value_count);
   free(info);
 }
 
+void mygramclient_free_parsed_expression(MygramParsedExpression_C* result) {
+  if (result == nullptr) {
+    return;
+  }
+
+  free(result->error);
+  free(result->query);
+  free(result->main_term);
+  free_c_string_array(result->and_terms, result->and_count);
+  free_c_string_array(result->not_terms, result->not_count);
+  free(result);
+}
+
+void mygramclient_free_converted_expressions(MygramConvertedExpressions_C* result) {
+  if (result == nullptr) {
+    return;
+  }
+
+  free(result->data);
+  free(result->offsets);
+  free(result->ok);
+  free(result);
+}
+
+void mygramclient_free_ngram_batch(MygramNgramBatch_C* result) {
+  if (result == nullptr) {
+    return;
+  }
+
+  free(result->counts);
+  free(result->document_offsets);
+  free(result->hashes);
+  free(result->data);
+  free(result->ngram_offsets);
+  free(result);
+}
+
+void mygramclient_free_hashes(uint64_t* hashes) {
+  free(hashes);
+}
+
+void mygramclient_free_ngram_filter_data(uint8_t* data) {
+  free(data);
+}
+
+void mygramclient_free_query_cost(MygramQueryCost_C* result) {
+  if (result == nullptr) {
+    return;
+  }
+
+  free(result->error);
+  free_c_string_array(result->terms, result->term_count);
+  free(result->term_ngrams);
+  free(result->term_flags);
+  free(result);
+}
+
+void mygramclient_free_server_metrics(MygramServerMetrics_C* metrics) {
+  if (metrics == nullptr) {
+    return;
+  }
+
+  free(metrics->windows);
+  free(metrics);
+}
+
 void mygramclient_free_string(char* str) {
   free(str);
 }
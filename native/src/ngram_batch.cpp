@@ -0,0 +1,148 @@
+/**
+ * @file ngram_batch.cpp
+ * @brief Bulk normalization and hybrid n-gram splitting of many documents
+ */
+
+#include "ngram_batch.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "parallel_utils.h"
+
+namespace mygramdb::utils {
+
+namespace {
+
+// Results for documents [begin, end); offsets are relative to the block until merged
+struct Block {
+  size_t begin = 0;
+  std::vector<uint64_t> hashes;
+  std::string data;
+  std::vector<uint32_t> ngram_ends;  // End offset of each n-gram in data
+};
+
+// Buffers one worker reuses across documents, and the blocks it produced
+struct Worker {
+  NgramScratch scratch;
+  std::string normalized;
+  std::vector<uint64_t> hashes;
+  std::unordered_set<std::string_view> seen_ngrams;
+  std::unordered_set<uint64_t> seen_hashes;
+  std::vector<Block> blocks;
+};
+
+/**
+ * @brief Split one document, appending its hashes or n-grams to block (nullptr for counts only)
+ *
+ * @return Number of n-grams kept
+ */
+uint32_t ProcessDocument(std::string_view document, const NgramBatchOptions& options, Worker& worker, Block* block) {
+  std::string_view text = document;
+  if (!options.normalizer.IsIdentity()) {
+    options.normalizer.Normalize(document, worker.normalized);
+    text = worker.normalized;
+  }
+
+  if (options.output == NgramBatchOutput::kHashes) {
+    GenerateHybridNgramHashes(text, options.ascii_ngram_size, options.kanji_ngram_size, worker.scratch,
+                              worker.hashes);
+    size_t before = block->hashes.size();
+    if (options.distinct) {
+      worker.seen_hashes.clear();
+      for (uint64_t hash : worker.hashes) {
+        if (worker.seen_hashes.insert(hash).second) {
+          block->hashes.push_back(hash);
+        }
+      }
+    } else {
+      block->hashes.insert(block->hashes.end(), worker.hashes.begin(), worker.hashes.end());
+    }
+    return static_cast<uint32_t>(block->hashes.size() - before);
+  }
+
+  const auto& ngrams =
+      GenerateHybridNgramViews(text, options.ascii_ngram_size, options.kanji_ngram_size, worker.scratch);
+  if (!options.distinct && block == nullptr) {
+    return static_cast<uint32_t>(ngrams.size());
+  }
+
+  worker.seen_ngrams.clear();
+  uint32_t count = 0;
+  for (std::string_view ngram : ngrams) {
+    if (options.distinct && !worker.seen_ngrams.insert(ngram).second) {
+      continue;
+    }
+    ++count;
+    if (block != nullptr) {
+      block->data += ngram;
+      block->ngram_ends.push_back(static_cast<uint32_t>(block->data.size()));
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+NgramBatch GenerateNgramBatch(const std::vector<std::string_view>& documents, const NgramBatchOptions& options) {
+  NgramBatch batch;
+  batch.counts.resize(documents.size());
+  bool packed = options.output != NgramBatchOutput::kCounts;
+
+  std::vector<Worker> workers(ParallelWorkerCount(documents.size(), kMinDocumentsPerWorker, options.max_threads));
+  ParallelForStealing(documents.size(), kMinDocumentsPerWorker, kDocumentsPerBlock, options.max_threads,
+                      [&](size_t worker_index, size_t begin, size_t end) {
+                        Worker& worker = workers[worker_index];
+                        Block* block = nullptr;
+                        if (packed) {
+                          block = &worker.blocks.emplace_back();
+                          block->begin = begin;
+                        }
+                        for (size_t i = begin; i < end; ++i) {
+                          batch.counts[i] = ProcessDocument(documents[i], options, worker, block);
+                        }
+                      });
+  if (!packed) {
+    return batch;
+  }
+
+  // Blocks were claimed in no particular order; merge them in document order
+  std::vector<const Block*> blocks;
+  for (const auto& worker : workers) {
+    for (const auto& block : worker.blocks) {
+      blocks.push_back(&block);
+    }
+  }
+  std::sort(blocks.begin(), blocks.end(), [](const Block* a, const Block* b) { return a->begin < b->begin; });
+
+  batch.document_offsets.resize(documents.size() + 1);
+  for (size_t i = 0; i < documents.size(); ++i) {
+    batch.document_offsets[i + 1] = batch.document_offsets[i] + batch.counts[i];
+  }
+
+  if (options.output == NgramBatchOutput::kHashes) {
+    batch.hashes.reserve(batch.document_offsets.back());
+    for (const Block* block : blocks) {
+      batch.hashes.insert(batch.hashes.end(), block->hashes.begin(), block->hashes.end());
+    }
+    return batch;
+  }
+
+  size_t total = 0;
+  for (const Block* block : blocks) {
+    total += block->data.size();
+  }
+  batch.data.reserve(total);
+  batch.ngram_offsets.reserve(batch.document_offsets.back() + 1);
+  batch.ngram_offsets.push_back(0);
+  for (const Block* block : blocks) {
+    auto base = static_cast<uint32_t>(batch.data.size());
+    for (uint32_t end : block->ngram_ends) {
+      batch.ngram_offsets.push_back(base + end);
+    }
+    batch.data += block->data;
+  }
+  return batch;
+}
+
+}  // namespace mygramdb::utils
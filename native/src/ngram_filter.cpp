@@ -0,0 +1,222 @@
+/**
+ * @file ngram_filter.cpp
+ * @brief Blocked Bloom filter of indexed n-grams
+ */
+
+#include "ngram_filter.h"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+namespace mygramdb::client {
+
+namespace {
+
+constexpr size_t kBlockBits = 512;                     // One 64-byte cache line per block
+constexpr size_t kWordBits = 64;
+constexpr size_t kWordsPerBlock = kBlockBits / kWordBits;
+constexpr int kBlockBitShift = 23;                     // Top 9 of 32 bits select a bit within the block
+constexpr uint32_t kBitStepMultiplier = 0x9E3779B9U;  // Derives the next bit position
+constexpr uint32_t kMaxHashCount = 16;
+constexpr double kMinBitsPerNgram = 1.0;
+constexpr size_t kMaxBlocks = UINT32_MAX;             // Block index is derived from 32 hash bits
+
+// Serialized layout (little-endian):
+//   magic "MGNF", version, ascii_ngram_size, kanji_ngram_size, flags (1 = nfkc, 2 = lower),
+//   width (0 = keep, 1 = narrow, 2 = wide), hash_count, 2 reserved bytes,
+//   block count (u32), n-gram count (u64), then the bit array as u64 words
+constexpr char kMagic[] = {'M', 'G', 'N', 'F'};
+constexpr uint8_t kFormatVersion = 1;
+constexpr size_t kHeaderSize = 24;
+constexpr uint8_t kFlagNfkc = 1;
+constexpr uint8_t kFlagLower = 2;
+constexpr int kBitsPerByte = 8;
+
+uint8_t EncodeWidth(const std::string& width) {
+  switch (utils::ParseWidthMode(width)) {
+    case utils::WidthMode::kNarrow:
+      return 1;
+    case utils::WidthMode::kWide:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+const char* DecodeWidth(uint8_t width) {
+  return width == 1 ? "narrow" : width == 2 ? "wide" : "keep";
+}
+
+void PutLittleEndian(std::string& out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out += static_cast<char>((value >> (i * kBitsPerByte)) & 0xFFU);
+  }
+}
+
+uint64_t GetLittleEndian(std::string_view data, size_t offset, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(static_cast<uint8_t>(data[offset + i])) << (i * kBitsPerByte);
+  }
+  return value;
+}
+
+/**
+ * @brief Block of a hash: the high 32 bits scaled to the block count
+ */
+size_t BlockOf(uint64_t hash, size_t blocks) {
+  return static_cast<size_t>(((hash >> 32) * blocks) >> 32);  // NOLINT(readability-magic-numbers)
+}
+
+}  // namespace
+
+NgramBloomFilter::NgramBloomFilter(size_t expected_ngrams, NgramFilterConfig config)
+    : config_(std::move(config)),
+      normalizer_(config_.normalization.nfkc, utils::ParseWidthMode(config_.normalization.width),
+                  config_.normalization.lower) {
+  double bits_per_ngram = std::max(config_.bits_per_ngram, kMinBitsPerNgram);
+  double bits = std::max(1.0, static_cast<double>(expected_ngrams) * bits_per_ngram);
+  auto blocks = static_cast<size_t>(std::ceil(bits / static_cast<double>(kBlockBits)));
+  words_.assign(std::clamp<size_t>(blocks, 1, kMaxBlocks) * kWordsPerBlock, 0);
+  hash_count_ = std::clamp<uint32_t>(static_cast<uint32_t>(std::lround(bits_per_ngram * std::log(2.0))), 1,
+                                     kMaxHashCount);
+}
+
+void NgramBloomFilter::AddText(std::string_view text) {
+  thread_local utils::NgramScratch scratch;
+  thread_local std::string normalized;
+  thread_local std::vector<uint64_t> hashes;
+  if (!normalizer_.IsIdentity()) {
+    normalizer_.Normalize(text, normalized);
+    text = normalized;
+  }
+  utils::GenerateHybridNgramHashes(text, config_.ascii_ngram_size, config_.kanji_ngram_size, scratch, hashes);
+  AddHashes(hashes.data(), hashes.size());
+}
+
+void NgramBloomFilter::AddHash(uint64_t hash) {
+  uint64_t* block = words_.data() + BlockOf(hash, words_.size() / kWordsPerBlock) * kWordsPerBlock;
+  auto bits = static_cast<uint32_t>(hash);
+  bool added = false;
+  for (uint32_t i = 0; i < hash_count_; ++i) {
+    uint32_t bit = bits >> kBlockBitShift;
+    uint64_t mask = uint64_t{1} << (bit % kWordBits);
+    added |= (block[bit / kWordBits] & mask) == 0;
+    block[bit / kWordBits] |= mask;
+    bits *= kBitStepMultiplier;
+  }
+  ngrams_ += added ? 1 : 0;
+}
+
+void NgramBloomFilter::AddHashes(const uint64_t* hashes, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    AddHash(hashes[i]);
+  }
+}
+
+bool NgramBloomFilter::MayContainHash(uint64_t hash) const {
+  const uint64_t* block = words_.data() + BlockOf(hash, words_.size() / kWordsPerBlock) * kWordsPerBlock;
+  auto bits = static_cast<uint32_t>(hash);
+  for (uint32_t i = 0; i < hash_count_; ++i) {
+    uint32_t bit = bits >> kBlockBitShift;
+    if ((block[bit / kWordBits] & (uint64_t{1} << (bit % kWordBits))) == 0) {
+      return false;
+    }
+    bits *= kBitStepMultiplier;
+  }
+  return true;
+}
+
+bool NgramBloomFilter::MayMatch(std::string_view term) const {
+  thread_local utils::NgramScratch scratch;
+  thread_local std::string normalized;
+  thread_local std::vector<uint64_t> hashes;
+  if (!normalizer_.IsIdentity()) {
+    normalizer_.Normalize(term, normalized);
+    term = normalized;
+  }
+  utils::GenerateHybridNgramHashes(term, config_.ascii_ngram_size, config_.kanji_ngram_size, scratch, hashes);
+  return std::all_of(hashes.begin(), hashes.end(), [this](uint64_t hash) { return MayContainHash(hash); });
+}
+
+bool NgramBloomFilter::MayMatchQuery(std::string_view main_term, const std::vector<std::string>& and_terms) const {
+  return MayMatch(main_term) &&
+         std::all_of(and_terms.begin(), and_terms.end(), [this](const std::string& term) { return MayMatch(term); });
+}
+
+NgramFilterStats NgramBloomFilter::GetStats() const {
+  size_t set_bits = 0;
+  for (uint64_t word : words_) {
+    set_bits += std::bitset<kWordBits>(word).count();
+  }
+  double fill = static_cast<double>(set_bits) / static_cast<double>(words_.size() * kWordBits);
+
+  NgramFilterStats stats;
+  stats.ngrams = ngrams_;
+  stats.size_bytes = words_.size() * sizeof(uint64_t);
+  stats.hash_count = hash_count_;
+  stats.false_positive_rate = std::pow(fill, hash_count_);
+  return stats;
+}
+
+std::string NgramBloomFilter::Serialize() const {
+  std::string out;
+  out.reserve(kHeaderSize + words_.size() * sizeof(uint64_t));
+  out.append(kMagic, sizeof(kMagic));
+  out += static_cast<char>(kFormatVersion);
+  out += static_cast<char>(config_.ascii_ngram_size);
+  out += static_cast<char>(config_.kanji_ngram_size);
+  auto flags = static_cast<uint8_t>((config_.normalization.nfkc ? kFlagNfkc : 0) |
+                                    (config_.normalization.lower ? kFlagLower : 0));
+  out += static_cast<char>(flags);
+  out += static_cast<char>(EncodeWidth(config_.normalization.width));
+  out += static_cast<char>(hash_count_);
+  PutLittleEndian(out, 0, 2);
+  PutLittleEndian(out, words_.size() / kWordsPerBlock, sizeof(uint32_t));
+  PutLittleEndian(out, ngrams_, sizeof(uint64_t));
+  for (uint64_t word : words_) {
+    PutLittleEndian(out, word, sizeof(uint64_t));
+  }
+  return out;
+}
+
+std::variant<NgramBloomFilter, Error> NgramBloomFilter::Deserialize(std::string_view data) {
+  if (data.size() < kHeaderSize || data.substr(0, sizeof(kMagic)) != std::string_view(kMagic, sizeof(kMagic))) {
+    return Error("Not an n-gram filter");
+  }
+  if (static_cast<uint8_t>(data[4]) != kFormatVersion) {
+    return Error("Unsupported n-gram filter version: " + std::to_string(static_cast<uint8_t>(data[4])));
+  }
+
+  NgramBloomFilter filter;
+  auto flags = static_cast<uint8_t>(data[7]);
+  filter.config_.ascii_ngram_size = static_cast<uint8_t>(data[5]);
+  filter.config_.kanji_ngram_size = static_cast<uint8_t>(data[6]);
+  filter.config_.normalization = {(flags & kFlagNfkc) != 0, DecodeWidth(static_cast<uint8_t>(data[8])),
+                                  (flags & kFlagLower) != 0};
+  filter.normalizer_ = utils::Normalizer(filter.config_.normalization.nfkc,
+                                         utils::ParseWidthMode(filter.config_.normalization.width),
+                                         filter.config_.normalization.lower);
+  filter.hash_count_ = static_cast<uint8_t>(data[9]);
+  size_t blocks = GetLittleEndian(data, 12, sizeof(uint32_t));      // NOLINT(readability-magic-numbers)
+  filter.ngrams_ = GetLittleEndian(data, 16, sizeof(uint64_t));      // NOLINT(readability-magic-numbers)
+  if (blocks == 0 || filter.hash_count_ == 0 || filter.hash_count_ > kMaxHashCount ||
+      data.size() != kHeaderSize + blocks * kBlockBits / kBitsPerByte) {
+    return Error("Corrupt n-gram filter");
+  }
+  filter.config_.bits_per_ngram = 0.0;  // Unknown once serialized; the size is fixed
+
+  filter.words_.resize(blocks * kWordsPerBlock);
+  for (size_t i = 0; i < filter.words_.size(); ++i) {
+    filter.words_[i] = GetLittleEndian(data, kHeaderSize + i * sizeof(uint64_t), sizeof(uint64_t));
+  }
+  return filter;
+}
+
+void NgramBloomFilter::Clear() {
+  std::fill(words_.begin(), words_.end(), 0);
+  ngrams_ = 0;
+}
+
+}  // namespace mygramdb::client
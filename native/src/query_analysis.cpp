@@ -0,0 +1,229 @@
+/**
+ * @file query_analysis.cpp
+ * @brief Static analysis of search queries before they are sent
+ */
+
+#include "query_analysis.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_set>
+#include <variant>
+
+namespace mygramdb::client {
+
+namespace {
+
+constexpr const char* kNoPositiveTerm = "Search expression must have at least one positive term";
+
+/**
+ * @brief Mark the analysis empty because of a contradiction
+ */
+void SetContradiction(QueryAnalysis& analysis, const std::string& term) {
+  if (analysis.contradictions.empty()) {
+    analysis.reason = "'" + term + "' is both required and excluded";
+  }
+  analysis.contradictions.push_back(term);
+}
+
+/**
+ * @brief Walks a query AST, deciding which groups can never match
+ */
+class AstAnalyzer {
+ public:
+  AstAnalyzer(const QueryAst& ast, QueryAnalysis& analysis) : ast_(ast), analysis_(analysis) {}
+
+  /**
+   * @brief Check if a subtree can never match, recording findings on the way
+   */
+  bool IsAlwaysEmpty(uint32_t index) {
+    const QueryNode& node = ast_.GetNode(index);
+    switch (node.kind) {
+      case QueryNodeKind::kTerm:
+      case QueryNodeKind::kPhrase:
+        return false;
+      case QueryNodeKind::kNot:
+        // NOT of an empty set matches everything; still scan the child for findings
+        IsAlwaysEmpty(node.first_child);
+        return false;
+      case QueryNodeKind::kAnd:
+        return IsAndEmpty(node);
+      case QueryNodeKind::kOr:
+        return IsOrEmpty(node);
+    }
+    return false;
+  }
+
+ private:
+  [[nodiscard]] static bool IsLeaf(const QueryNode& node) {
+    return node.kind == QueryNodeKind::kTerm || node.kind == QueryNodeKind::kPhrase;
+  }
+
+  /**
+   * @brief Comparison key of a leaf (phrases and terms never compare equal)
+   */
+  [[nodiscard]] std::string LeafKey(uint32_t index) const {
+    std::string key(ast_.GetNode(index).kind == QueryNodeKind::kPhrase ? "\"" : "'");
+    key += ast_.GetText(index);
+    return key;
+  }
+
+  void RecordDuplicate(uint32_t index) { analysis_.duplicates.emplace_back(ast_.GetText(index)); }
+
+  bool IsAndEmpty(const QueryNode& node) {
+    bool empty = false;
+    std::unordered_set<std::string> required;
+    std::unordered_set<std::string> excluded;
+    std::vector<uint32_t> excluded_leaves;
+
+    for (uint32_t child = node.first_child; child != QueryNode::kNone; child = ast_.GetNode(child).next_sibling) {
+      const QueryNode& child_node = ast_.GetNode(child);
+      if (IsAlwaysEmpty(child)) {
+        empty = true;
+      }
+      if (IsLeaf(child_node)) {
+        if (!required.insert(LeafKey(child)).second) {
+          RecordDuplicate(child);
+        }
+      } else if (child_node.kind == QueryNodeKind::kNot && IsLeaf(ast_.GetNode(child_node.first_child))) {
+        if (excluded.insert(LeafKey(child_node.first_child)).second) {
+          excluded_leaves.push_back(child_node.first_child);
+        } else {
+          RecordDuplicate(child_node.first_child);
+        }
+      }
+    }
+
+    for (uint32_t leaf : excluded_leaves) {
+      if (required.count(LeafKey(leaf)) != 0) {
+        SetContradiction(analysis_, std::string(ast_.GetText(leaf)));
+        empty = true;
+      }
+    }
+    return empty;
+  }
+
+  bool IsOrEmpty(const QueryNode& node) {
+    bool all_empty = true;
+    std::unordered_set<std::string> alternatives;
+    for (uint32_t child = node.first_child; child != QueryNode::kNone; child = ast_.GetNode(child).next_sibling) {
+      if (!IsAlwaysEmpty(child)) {
+        all_empty = false;
+      }
+      if (IsLeaf(ast_.GetNode(child)) && !alternatives.insert(LeafKey(child)).second) {
+        RecordDuplicate(child);
+      }
+    }
+    return all_empty;
+  }
+
+  const QueryAst& ast_;      // Tree being analyzed
+  QueryAnalysis& analysis_;  // Findings
+};
+
+/**
+ * @brief Check if the top level of a query has no positive part
+ */
+bool HasNoPositivePart(const QueryAst& ast) {
+  const QueryNode& root = ast.GetNode(ast.Root());
+  if (root.kind == QueryNodeKind::kNot) {
+    return true;
+  }
+  if (root.kind != QueryNodeKind::kAnd) {
+    return false;
+  }
+  for (uint32_t child = root.first_child; child != QueryNode::kNone; child = ast.GetNode(child).next_sibling) {
+    if (ast.GetNode(child).kind != QueryNodeKind::kNot) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+QueryAnalysis AnalyzeTerms(const std::string& query, const std::vector<std::string>& and_terms,
+                           const std::vector<std::string>& not_terms) {
+  QueryAnalysis analysis;
+  if (query.empty()) {
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = and_terms.empty() && !not_terms.empty() ? kNoPositiveTerm : "Search query cannot be empty";
+    return analysis;
+  }
+  if (std::find(and_terms.begin(), and_terms.end(), std::string()) != and_terms.end()) {
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = "AND term cannot be empty";
+    return analysis;
+  }
+  if (std::find(not_terms.begin(), not_terms.end(), std::string()) != not_terms.end()) {
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = "NOT term cannot be empty";
+    return analysis;
+  }
+
+  std::unordered_set<std::string_view> required;
+  required.insert(query);
+  for (const auto& term : and_terms) {
+    if (!required.insert(term).second) {
+      analysis.duplicates.push_back(term);
+    }
+  }
+
+  std::unordered_set<std::string_view> excluded;
+  for (const auto& term : not_terms) {
+    if (!excluded.insert(term).second) {
+      analysis.duplicates.push_back(term);
+    } else if (required.count(term) != 0) {
+      SetContradiction(analysis, term);
+    }
+  }
+
+  if (!analysis.contradictions.empty()) {
+    analysis.verdict = QueryVerdict::kEmpty;
+  }
+  return analysis;
+}
+
+QueryAnalysis AnalyzeQueryAst(const QueryAst& ast) {
+  QueryAnalysis analysis;
+  if (ast.Empty()) {
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = "Empty search expression";
+    return analysis;
+  }
+
+  bool empty = AstAnalyzer(ast, analysis).IsAlwaysEmpty(ast.Root());
+  if (HasNoPositivePart(ast)) {
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = kNoPositiveTerm;
+  } else if (empty) {
+    analysis.verdict = QueryVerdict::kEmpty;
+  } else {
+    analysis.reason.clear();  // Contradictions confined to one OR branch do not decide the query
+  }
+  return analysis;
+}
+
+QueryAnalysis AnalyzeExpression(const std::string& expression) {
+  auto parsed = ParseQueryAst(expression);
+  if (auto* err = std::get_if<std::string>(&parsed)) {
+    QueryAnalysis analysis;
+    analysis.verdict = QueryVerdict::kInvalid;
+    analysis.reason = *err;
+    return analysis;
+  }
+  return AnalyzeQueryAst(std::get<QueryAst>(parsed));
+}
+
+size_t DedupeTerms(std::vector<std::string>& terms) {
+  std::unordered_set<std::string> seen;
+  auto kept = std::remove_if(terms.begin(), terms.end(), [&seen](const std::string& term) {
+    return !seen.insert(term).second;
+  });
+  size_t removed = static_cast<size_t>(std::distance(kept, terms.end()));
+  terms.erase(kept, terms.end());
+  return removed;
+}
+
+}  // namespace mygramdb::client
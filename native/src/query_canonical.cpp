@@ -0,0 +1,211 @@
+/**
+ * @file query_canonical.cpp
+ * @brief Canonical query forms and command keys
+ */
+
+#include "query_canonical.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+#include "search_expression.h"
+#include "string_utils.h"
+
+namespace mygramdb::client {
+
+namespace {
+
+/**
+ * @brief Escape special characters in query strings
+ */
+std::string EscapeQueryString(const std::string& str) {
+  // Check if string needs quoting (contains spaces or special chars)
+  bool needs_quotes = false;
+  for (char character : str) {
+    if (character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '"' ||
+        character == '\'') {
+      needs_quotes = true;
+      break;
+    }
+  }
+
+  if (!needs_quotes) {
+    return str;
+  }
+
+  // Use double quotes and escape internal quotes
+  std::string result = "\"";
+  for (char character : str) {
+    if (character == '"' || character == '\\') {
+      result += '\\';
+    }
+    result += character;
+  }
+  result += '"';
+  return result;
+}
+
+/**
+ * @brief Sort and remove duplicates in place
+ */
+template <typename T>
+void SortUnique(std::vector<T>& values) {
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+/**
+ * @brief Append query terms and filters shared by SEARCH and COUNT
+ */
+void AppendTermsAndFilters(std::ostringstream& cmd, const std::string& query,
+                           const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                           const std::vector<std::pair<std::string, std::string>>& filters) {
+  cmd << " " << EscapeQueryString(query);
+
+  for (const auto& term : and_terms) {
+    cmd << " AND " << EscapeQueryString(term);
+  }
+
+  for (const auto& term : not_terms) {
+    cmd << " NOT " << EscapeQueryString(term);
+  }
+
+  for (const auto& [key, value] : filters) {
+    cmd << " FILTER " << key << " = " << EscapeQueryString(value);
+  }
+}
+
+/**
+ * @brief Canonicalize positive and excluded term sets
+ */
+CanonicalTerms CanonicalizeTermSets(std::vector<std::string> positive, std::vector<std::string> negative,
+                                    const QueryNormalization& normalization) {
+  if (!normalization.IsIdentity()) {
+    for (auto& term : positive) {
+      term = NormalizeQueryTerm(term, normalization);
+    }
+    for (auto& term : negative) {
+      term = NormalizeQueryTerm(term, normalization);
+    }
+  }
+
+  // Empty terms carry no constraint; drop them before ordering
+  positive.erase(std::remove(positive.begin(), positive.end(), std::string()), positive.end());
+  negative.erase(std::remove(negative.begin(), negative.end(), std::string()), negative.end());
+  SortUnique(positive);
+  SortUnique(negative);
+
+  CanonicalTerms canonical;
+  if (!positive.empty()) {
+    canonical.main_term = std::move(positive.front());
+    canonical.and_terms.assign(std::make_move_iterator(positive.begin() + 1),
+                               std::make_move_iterator(positive.end()));
+  }
+  canonical.not_terms = std::move(negative);
+  return canonical;
+}
+
+/**
+ * @brief Sort and dedupe filters (values are compared exactly, never normalized)
+ */
+std::vector<std::pair<std::string, std::string>> CanonicalizeFilters(
+    std::vector<std::pair<std::string, std::string>> filters) {
+  SortUnique(filters);
+  return filters;
+}
+
+}  // namespace
+
+std::string NormalizeQueryTerm(const std::string& term, const QueryNormalization& normalization) {
+  if (normalization.IsIdentity()) {
+    return term;
+  }
+  return utils::NormalizeText(term, normalization.nfkc, normalization.width, normalization.lower);
+}
+
+CanonicalTerms CanonicalizeTerms(const std::string& query, const std::vector<std::string>& and_terms,
+                                 const std::vector<std::string>& not_terms, const QueryNormalization& normalization) {
+  std::vector<std::string> positive;
+  positive.reserve(and_terms.size() + 1);
+  positive.push_back(query);
+  positive.insert(positive.end(), and_terms.begin(), and_terms.end());
+  return CanonicalizeTermSets(std::move(positive), not_terms, normalization);
+}
+
+std::variant<CanonicalTerms, std::string> CanonicalizeExpression(const std::string& expression,
+                                                                  const QueryNormalization& normalization) {
+  auto parsed = ParseQueryAst(expression);
+  if (auto* err = std::get_if<std::string>(&parsed)) {
+    return *err;
+  }
+
+  SearchExpression expr = FlattenQueryAst(std::get<QueryAst>(parsed));
+  if (!expr.raw_expression.empty()) {
+    return std::string("Expressions with OR or grouping have no canonical term form");
+  }
+  if (expr.required_terms.empty() && expr.optional_terms.empty()) {
+    return std::string("Search expression must have at least one positive term");
+  }
+
+  std::vector<std::string> positive = std::move(expr.required_terms);
+  positive.insert(positive.end(), std::make_move_iterator(expr.optional_terms.begin()),
+                  std::make_move_iterator(expr.optional_terms.end()));
+  return CanonicalizeTermSets(std::move(positive), std::move(expr.excluded_terms), normalization);
+}
+
+std::string BuildSearchCommand(const std::string& table, const std::string& query,
+                               const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                               const std::vector<std::pair<std::string, std::string>>& filters,
+                               const std::string& sort_column, bool sort_desc, uint32_t limit, uint32_t offset) {
+  std::ostringstream cmd;
+  cmd << "SEARCH " << table;
+  AppendTermsAndFilters(cmd, query, and_terms, not_terms, filters);
+
+  // SORT clause (replaces ORDER BY)
+  if (!sort_column.empty()) {
+    cmd << " SORT " << sort_column << (sort_desc ? " DESC" : " ASC");
+  } else if (!sort_desc) {
+    // Only add SORT ASC if explicitly requesting ascending order for primary key
+    cmd << " SORT ASC";
+  }
+  // Default is SORT DESC (primary key descending), so no need to add it explicitly
+
+  // LIMIT clause - support MySQL-style offset,count format when both are specified
+  if (limit > 0 && offset > 0) {
+    cmd << " LIMIT " << offset << "," << limit;
+  } else if (limit > 0) {
+    cmd << " LIMIT " << limit;
+  }
+
+  return cmd.str();
+}
+
+std::string BuildCountCommand(const std::string& table, const std::string& query,
+                              const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                              const std::vector<std::pair<std::string, std::string>>& filters) {
+  std::ostringstream cmd;
+  cmd << "COUNT " << table;
+  AppendTermsAndFilters(cmd, query, and_terms, not_terms, filters);
+  return cmd.str();
+}
+
+std::string CanonicalSearchKey(const std::string& table, const std::string& query,
+                               const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                               const std::vector<std::pair<std::string, std::string>>& filters,
+                               const std::string& sort_column, bool sort_desc, uint32_t limit, uint32_t offset,
+                               const QueryNormalization& normalization) {
+  CanonicalTerms terms = CanonicalizeTerms(query, and_terms, not_terms, normalization);
+  return BuildSearchCommand(table, terms.main_term, terms.and_terms, terms.not_terms, CanonicalizeFilters(filters),
+                            sort_column, sort_desc, limit, offset);
+}
+
+std::string CanonicalCountKey(const std::string& table, const std::string& query,
+                              const std::vector<std::string>& and_terms, const std::vector<std::string>& not_terms,
+                              const std::vector<std::pair<std::string, std::string>>& filters,
+                              const QueryNormalization& normalization) {
+  CanonicalTerms terms = CanonicalizeTerms(query, and_terms, not_terms, normalization);
+  return BuildCountCommand(table, terms.main_term, terms.and_terms, terms.not_terms, CanonicalizeFilters(filters));
+}
+
+}  // namespace mygramdb::client
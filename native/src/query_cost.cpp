@@ -0,0 +1,136 @@
+/**
+ * @file query_cost.cpp
+ * @brief Query cost estimation from hybrid n-gram expansion
+ */
+
+#include "query_cost.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "string_utils.h"
+
+namespace mygramdb::client {
+
+namespace {
+
+/**
+ * @brief Walks a query AST, collecting the cost of every leaf
+ */
+class CostWalker {
+ public:
+  CostWalker(const QueryAst& ast, const QueryCostConfig& config, QueryCost& cost)
+      : ast_(ast), config_(config), cost_(cost) {}
+
+  void Walk(uint32_t index, bool excluded, bool optional) {
+    const QueryNode& node = ast_.GetNode(index);
+    switch (node.kind) {
+      case QueryNodeKind::kTerm:
+      case QueryNodeKind::kPhrase:
+        AddLeaf(index, node.kind == QueryNodeKind::kPhrase, excluded, optional);
+        return;
+      case QueryNodeKind::kNot:
+        Walk(node.first_child, !excluded, optional);
+        return;
+      case QueryNodeKind::kAnd:
+      case QueryNodeKind::kOr:
+        for (uint32_t child = node.first_child; child != QueryNode::kNone; child = ast_.GetNode(child).next_sibling) {
+          Walk(child, excluded, optional || node.kind == QueryNodeKind::kOr);
+        }
+        return;
+    }
+  }
+
+  [[nodiscard]] size_t DistinctCount() const { return distinct_.size(); }
+
+ private:
+  void AddLeaf(uint32_t index, bool phrase, bool excluded, bool optional) {
+    TermCost term;
+    term.term = std::string(ast_.GetText(index));
+    term.phrase = phrase;
+    term.excluded = excluded;
+    term.optional = optional;
+
+    std::string text = config_.normalization.IsIdentity() ? term.term
+                                                          : NormalizeQueryTerm(term.term, config_.normalization);
+    const auto& ngrams =
+        utils::GenerateHybridNgramViews(text, config_.ascii_ngram_size, config_.kanji_ngram_size, scratch_);
+    term.ngrams = static_cast<uint32_t>(ngrams.size());
+    for (std::string_view ngram : ngrams) {
+      distinct_.emplace(ngram);
+    }
+
+    cost_.total_ngrams += term.ngrams;
+    cost_.max_term_ngrams = std::max(cost_.max_term_ngrams, term.ngrams);
+    if (term.ngrams == 0) {
+      ++cost_.short_terms;
+    }
+    cost_.terms.push_back(std::move(term));
+  }
+
+  const QueryAst& ast_;                       // Tree being walked
+  const QueryCostConfig& config_;             // N-gram sizes and normalization
+  QueryCost& cost_;                           // Result being filled
+  utils::NgramScratch scratch_;               // Reused n-gram buffers
+  std::unordered_set<std::string> distinct_;  // N-grams seen so far
+};
+
+}  // namespace
+
+uint32_t CountTermNgrams(const std::string& term, const QueryCostConfig& config) {
+  std::string text = config.normalization.IsIdentity() ? term : NormalizeQueryTerm(term, config.normalization);
+  utils::NgramScratch scratch;
+  return static_cast<uint32_t>(
+      utils::GenerateHybridNgramViews(text, config.ascii_ngram_size, config.kanji_ngram_size, scratch).size());
+}
+
+QueryCost EstimateQueryCost(const QueryAst& ast, const QueryCostConfig& config) {
+  QueryCost cost;
+  if (ast.Empty()) {
+    return cost;
+  }
+
+  CostWalker walker(ast, config, cost);
+  walker.Walk(ast.Root(), false, false);
+  cost.distinct_ngrams = walker.DistinctCount();
+  cost.cost_class = ClassifyQueryCost(cost.total_ngrams, config);
+  return cost;
+}
+
+std::variant<QueryCost, std::string> EstimateExpressionCost(const std::string& expression,
+                                                            const QueryCostConfig& config) {
+  auto parsed = ParseQueryAst(expression);
+  if (auto* err = std::get_if<std::string>(&parsed)) {
+    return *err;
+  }
+  return EstimateQueryCost(std::get<QueryAst>(parsed), config);
+}
+
+QueryCostClass ClassifyQueryCost(uint64_t total_ngrams, const QueryCostConfig& config) {
+  if (total_ngrams >= config.excessive_ngrams) {
+    return QueryCostClass::kExcessive;
+  }
+  if (total_ngrams >= config.high_ngrams) {
+    return QueryCostClass::kHigh;
+  }
+  if (total_ngrams >= config.moderate_ngrams) {
+    return QueryCostClass::kModerate;
+  }
+  return QueryCostClass::kLow;
+}
+
+const char* QueryCostClassName(QueryCostClass cost_class) {
+  switch (cost_class) {
+    case QueryCostClass::kLow:
+      return "low";
+    case QueryCostClass::kModerate:
+      return "moderate";
+    case QueryCostClass::kHigh:
+      return "high";
+    case QueryCostClass::kExcessive:
+      return "excessive";
+  }
+  return "low";
+}
+
+}  // namespace mygramdb::client
@@ -6,9 +6,14 @@
 #include "search_expression.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <sstream>
+#include <utility>
+
+#include "parallel_utils.h"
 
 namespace mygramdb::client {
 
@@ -22,7 +27,7 @@ constexpr unsigned char kFullWidthSpaceByte3 = 0x80;
 /**
  * @brief Check if character sequence is full-width space (U+3000)
  */
-inline bool IsFullWidthSpace(const std::string& str, size_t pos) {
+inline bool IsFullWidthSpace(std::string_view str, size_t pos) {
   if (pos + 2 >= str.size()) {
     return false;
   }
@@ -32,6 +37,34 @@ inline bool IsFullWidthSpace(const std::string& str, size_t pos) {
          static_cast<unsigned char>(str[pos + 2]) == kFullWidthSpaceByte3;
 }
 
+/**
+ * @brief Byte classes used by the tokenizer scans
+ */
+enum ByteClass : uint8_t {
+  kSpaceByte = 1U << 0U,      // ASCII whitespace (as std::isspace in the "C" locale)
+  kDelimiterByte = 1U << 1U,  // Ends a bare term: whitespace, + - ( ) "
+  kMaybeWideByte = 1U << 2U   // Lead byte of a possible full-width space
+};
+
+// One lookup per byte instead of a chain of comparisons
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+constexpr std::array<uint8_t, 256> kByteClasses = [] {
+  std::array<uint8_t, 256> table{};
+  for (char space : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+    table[static_cast<unsigned char>(space)] = kSpaceByte | kDelimiterByte;
+  }
+  for (char special : {'+', '-', '(', ')', '"'}) {
+    table[static_cast<unsigned char>(special)] = kDelimiterByte;
+  }
+  table[kFullWidthSpaceByte1] = kMaybeWideByte;
+  return table;
+}();
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+inline uint8_t ClassOf(char byte) {
+  return kByteClasses[static_cast<unsigned char>(byte)];
+}
+
 /**
  * @brief Token types for lexical analysis
  */
@@ -48,341 +81,515 @@ enum class TokenType : uint8_t {
 
 /**
  * @brief Token structure
+ *
+ * The value points into the tokenizer input. A quoted term containing
+ * backslash escapes is left raw and flagged; see Unescape().
  */
 struct Token {
   TokenType type;
-  std::string value;
+  std::string_view value;  // Term text (view into the input)
+  bool escaped;            // Quoted term still contains backslash escapes
 
-  Token(TokenType token_type, std::string token_value = "") : type(token_type), value(std::move(token_value)) {}
+  Token(TokenType token_type = TokenType::kEnd, std::string_view token_value = {}, bool token_escaped = false)
+      : type(token_type), value(token_value), escaped(token_escaped) {}
 };
 
 /**
- * @brief Simple tokenizer for search expressions
+ * @brief Resolve backslash escapes of a raw quoted term
+ */
+void Unescape(std::string_view raw, std::string& out) {
+  out.clear();
+  out.reserve(raw.size());
+  for (size_t i = 0; i < raw.size(); ++i) {
+    if (raw[i] == '\\' && i + 1 < raw.size()) {
+      ++i;
+    }
+    out += raw[i];
+  }
+}
+
+/**
+ * @brief Tokenizer for search expressions
+ *
+ * Produces tokens that view the input without copying, scanning terms with
+ * a byte-class table and quoted phrases with memchr. Peek() buffers one
+ * token of lookahead so the parser never has to rewind.
  */
 class Tokenizer {
  public:
-  explicit Tokenizer(const std::string& input) : input_(input) {}
+  explicit Tokenizer(std::string_view input) : input_(input) {}
 
   /**
    * @brief Get next token
    */
   Token Next() {
-    SkipWhitespace();
+    if (has_peeked_) {
+      has_peeked_ = false;
+      return peeked_;
+    }
+    return Scan();
+  }
 
-    if (pos_ >= input_.size()) {
-      return {TokenType::kEnd};
+  /**
+   * @brief Look at the token after the current one without consuming it
+   */
+  const Token& Peek() {
+    if (!has_peeked_) {
+      peeked_ = Scan();
+      has_peeked_ = true;
     }
+    return peeked_;
+  }
 
-    char current_char = input_[pos_];
+ private:
+  Token Scan() {
+    SkipWhitespace();
 
-    // Quoted string
-    if (current_char == '"') {
-      std::string quoted = ReadQuotedString();
-      return {TokenType::kQuotedTerm, quoted};
+    if (pos_ >= input_.size()) {
+      return {TokenType::kEnd};
     }
 
-    // Single-character tokens
-    if (current_char == '+') {
-      ++pos_;
-      return {TokenType::kPlus};
-    }
-    if (current_char == '-') {
-      ++pos_;
-      return {TokenType::kMinus};
-    }
-    if (current_char == '(') {
-      ++pos_;
-      return {TokenType::kLParen};
-    }
-    if (current_char == ')') {
-      ++pos_;
-      return {TokenType::kRParen};
+    switch (input_[pos_]) {
+      case '"':
+        return ReadQuotedString();
+      case '+':
+        ++pos_;
+        return {TokenType::kPlus};
+      case '-':
+        ++pos_;
+        return {TokenType::kMinus};
+      case '(':
+        ++pos_;
+        return {TokenType::kLParen};
+      case ')':
+        ++pos_;
+        return {TokenType::kRParen};
+      default:
+        break;
     }
 
-    // Check for OR operator
-    if (pos_ + 2 <= input_.size()) {
-      std::string maybe_or = input_.substr(pos_, 2);
-      if (maybe_or == "OR") {
-        // Make sure it's a whole word (not part of another word)
-        bool is_whole_word = true;
-        if (pos_ > 0 && std::isalnum(static_cast<unsigned char>(input_[pos_ - 1])) != 0) {
-          is_whole_word = false;
-        }
-        if (pos_ + 2 < input_.size() && std::isalnum(static_cast<unsigned char>(input_[pos_ + 2])) != 0) {
-          is_whole_word = false;
-        }
-        if (is_whole_word) {
-          pos_ += 2;
-          return {TokenType::kOr, "OR"};
-        }
-      }
+    // OR operator, only as a whole word (not part of another word)
+    if (input_[pos_] == 'O' && pos_ + 1 < input_.size() && input_[pos_ + 1] == 'R' &&
+        (pos_ == 0 || std::isalnum(static_cast<unsigned char>(input_[pos_ - 1])) == 0) &&
+        (pos_ + 2 == input_.size() || std::isalnum(static_cast<unsigned char>(input_[pos_ + 2])) == 0)) {
+      pos_ += 2;
+      return {TokenType::kOr, input_.substr(pos_ - 2, 2)};
     }
 
     // Term (everything else)
     return {TokenType::kTerm, ReadTerm()};
   }
 
-  [[nodiscard]] size_t GetPosition() const { return pos_; }
-
-  void SetPosition(size_t pos) { pos_ = pos; }
-
- private:
   void SkipWhitespace() {
     while (pos_ < input_.size()) {
-      // Check for full-width space (3 bytes)
-      if (IsFullWidthSpace(input_, pos_)) {
-        pos_ += 3;
-        continue;
-      }
-      // Check for ASCII whitespace
-      if (std::isspace(static_cast<unsigned char>(input_[pos_])) != 0) {
+      uint8_t byte_class = ClassOf(input_[pos_]);
+      if ((byte_class & kSpaceByte) != 0) {
         ++pos_;
-        continue;
+      } else if ((byte_class & kMaybeWideByte) != 0 && IsFullWidthSpace(input_, pos_)) {
+        pos_ += 3;
+      } else {
+        break;
       }
-      break;
     }
   }
 
-  std::string ReadTerm() {
-    std::string term;
+  std::string_view ReadTerm() {
+    size_t start = pos_;
     while (pos_ < input_.size()) {
-      // Stop at full-width space
-      if (IsFullWidthSpace(input_, pos_)) {
-        break;
+      uint8_t byte_class = ClassOf(input_[pos_]);
+      if (byte_class == 0) {
+        ++pos_;  // Common case: one table lookup per byte
+        continue;
       }
-      char current_char = input_[pos_];
-      // Stop at whitespace or special characters
-      if (std::isspace(static_cast<unsigned char>(current_char)) != 0 || current_char == '+' || current_char == '-' ||
-          current_char == '(' || current_char == ')' || current_char == '"') {
+      // Stop at whitespace, special characters or a full-width space
+      if ((byte_class & kDelimiterByte) != 0 || IsFullWidthSpace(input_, pos_)) {
         break;
       }
-      term += current_char;
       ++pos_;
     }
-    return term;
+    return input_.substr(start, pos_ - start);
   }
 
-  std::string ReadQuotedString() {
-    if (pos_ >= input_.size() || input_[pos_] != '"') {
-      return "";
+  Token ReadQuotedString() {
+    size_t start = ++pos_;  // Skip opening quote
+    const char* begin = input_.data() + start;
+    size_t remaining = input_.size() - start;
+
+    // Fast path: no backslash before the closing quote
+    const void* quote = std::memchr(begin, '"', remaining);
+    size_t length = quote != nullptr ? static_cast<size_t>(static_cast<const char*>(quote) - begin) : remaining;
+    if (std::memchr(begin, '\\', length) == nullptr) {
+      pos_ = quote != nullptr ? start + length + 1 : input_.size();
+      return {TokenType::kQuotedTerm, input_.substr(start, length)};
     }
-    ++pos_;  // Skip opening quote
 
-    std::string term;
-    while (pos_ < input_.size()) {
-      char current_char = input_[pos_];
-      if (current_char == '"') {
-        ++pos_;  // Skip closing quote
-        return term;
-      }
-      if (current_char == '\\' && pos_ + 1 < input_.size()) {
-        // Handle escaped characters
-        ++pos_;
-        term += input_[pos_];
-        ++pos_;
-      } else {
-        term += current_char;
-        ++pos_;
-      }
+    // Escapes: an escaped quote does not close the phrase
+    while (pos_ < input_.size() && input_[pos_] != '"') {
+      pos_ += (input_[pos_] == '\\' && pos_ + 1 < input_.size()) ? 2 : 1;
+    }
+    Token token{TokenType::kQuotedTerm, input_.substr(start, pos_ - start), true};
+    if (pos_ < input_.size()) {
+      ++pos_;  // Skip closing quote (unclosed quote: take what we have)
     }
-    // Unclosed quote - return what we have
-    return term;
+    return token;
   }
 
-  const std::string& input_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members) - Necessary for parser
-  size_t pos_ = 0;
+  std::string_view input_;   // Expression being tokenized (owned by the caller)
+  size_t pos_ = 0;           // Scan position
+  Token peeked_;             // Lookahead buffer
+  bool has_peeked_ = false;  // Whether peeked_ holds a token
 };
 
+// Maximum parenthesis nesting (bounds parser recursion on untrusted input)
+constexpr int kMaxNestingDepth = 64;
+
 /**
- * @brief Recursive descent parser for search expressions
+ * @brief Check if a term must be quoted to survive serialization
+ */
+bool IsReservedWord(std::string_view term) {
+  return term == "AND" || term == "OR" || term == "NOT";
+}
+
+/**
+ * @brief Append a phrase with quotes and backslash escapes
+ */
+void AppendQuoted(std::string_view text, std::string& out) {
+  out += '"';
+  for (char current_char : text) {
+    if (current_char == '"' || current_char == '\\') {
+      out += '\\';
+    }
+    out += current_char;
+  }
+  out += '"';
+}
+
+/**
+ * @brief Recursive descent parser producing a QueryAst in one pass
  */
 class Parser {
  public:
-  explicit Parser(const std::string& input) : tokenizer_(input), current_(TokenType::kEnd) { Advance(); }
+  explicit Parser(std::string_view input) : tokenizer_(input) { Advance(); }
 
   /**
    * @brief Parse the expression
    */
-  std::variant<SearchExpression, std::string> Parse() {
-    SearchExpression expr;
+  std::variant<QueryAst, std::string> Parse() {
+    uint32_t root = ParseAnd(0);
+    if (!error_.empty()) {
+      return error_;
+    }
+    if (current_.type == TokenType::kRParen) {
+      return "Unexpected ')'";
+    }
+    if (root == QueryNode::kNone) {
+      return "Empty search expression";
+    }
+
+    ast_.SetRoot(root);
+    return std::move(ast_);
+  }
+
+ private:
+  void Advance() { current_ = tokenizer_.Next(); }
+
+  uint32_t Fail(const char* message) {
+    if (error_.empty()) {
+      error_ = message;
+    }
+    return QueryNode::kNone;
+  }
+
+  // and := or { or }  (stops at ')' or end; returns kNone when empty)
+  uint32_t ParseAnd(int depth) {
+    std::vector<uint32_t> children;
+    while (current_.type != TokenType::kEnd && current_.type != TokenType::kRParen) {
+      if (current_.type == TokenType::kOr) {
+        return Fail("Unexpected 'OR' operator");
+      }
+      uint32_t child = ParseOr(depth);
+      if (!error_.empty()) {
+        return QueryNode::kNone;
+      }
+      children.push_back(child);
+    }
+    return children.empty() ? QueryNode::kNone : ast_.AddGroup(QueryNodeKind::kAnd, children);
+  }
+
+  // or := unary { "OR" unary }
+  uint32_t ParseOr(int depth) {
+    std::vector<uint32_t> children{ParseUnary(depth)};
+    while (error_.empty() && current_.type == TokenType::kOr) {
+      TokenType next = tokenizer_.Peek().type;
+      if (next == TokenType::kEnd || next == TokenType::kRParen || next == TokenType::kOr) {
+        return Fail("Expected term after 'OR'");
+      }
+      Advance();
+      children.push_back(ParseUnary(depth));
+    }
+    return error_.empty() ? ast_.AddGroup(QueryNodeKind::kOr, children) : QueryNode::kNone;
+  }
+
+  // unary := [ "+" | "-" ] primary
+  uint32_t ParseUnary(int depth) {
+    if (current_.type == TokenType::kPlus) {
+      Advance();
+      if (!StartsPrimary()) {
+        return Fail("Expected term after '+'");
+      }
+      return ParsePrimary(depth);
+    }
+    if (current_.type == TokenType::kMinus) {
+      Advance();
+      if (!StartsPrimary()) {
+        return Fail("Expected term after '-'");
+      }
+      uint32_t child = ParsePrimary(depth);
+      return error_.empty() ? ast_.AddNot(child) : QueryNode::kNone;
+    }
+    return ParsePrimary(depth);
+  }
 
-    while (current_.type != TokenType::kEnd) {
-      // Handle prefix operators
-      if (current_.type == TokenType::kPlus) {
+  // primary := term | "phrase" | "(" and ")"
+  uint32_t ParsePrimary(int depth) {
+    switch (current_.type) {
+      case TokenType::kTerm: {
+        uint32_t node = ast_.AddTerm(current_.value);
         Advance();
-        if (auto term = ParsePrefixedTerm()) {
-          expr.required_terms.push_back(*term);
-        } else {
-          return "Expected term after '+'";
+        return node;
+      }
+      case TokenType::kQuotedTerm: {
+        if (current_.value.empty()) {
+          return Fail("Empty phrase");
+        }
+        std::string_view text = current_.value;
+        if (current_.escaped) {
+          Unescape(current_.value, unescaped_);
+          text = unescaped_;
         }
-      } else if (current_.type == TokenType::kMinus) {
+        uint32_t node = ast_.AddTerm(text, true);
         Advance();
-        if (auto term = ParsePrefixedTerm()) {
-          expr.excluded_terms.push_back(*term);
-        } else {
-          return "Expected term after '-'";
+        return node;
+      }
+      case TokenType::kLParen: {
+        if (depth >= kMaxNestingDepth) {
+          return Fail("Expression nested too deeply");
         }
-      } else if (current_.type == TokenType::kLParen) {
-        // Parenthesized expression - capture as raw
-        std::string paren_expr = CaptureParenExpression();
-        if (paren_expr.empty()) {
-          return "Unbalanced parentheses";
+        Advance();
+        uint32_t node = ParseAnd(depth + 1);
+        if (!error_.empty()) {
+          return QueryNode::kNone;
         }
-        if (!expr.raw_expression.empty()) {
-          expr.raw_expression += " ";
+        if (current_.type != TokenType::kRParen) {
+          return Fail("Unbalanced parentheses");
         }
-        expr.raw_expression += paren_expr;
-      } else if (current_.type == TokenType::kTerm || current_.type == TokenType::kQuotedTerm) {
-        // Check if this starts an OR expression
-        if (LooksLikeOrExpression()) {
-          std::string or_expr = CaptureOrExpression();
-          if (!expr.raw_expression.empty()) {
-            expr.raw_expression += " ";
-          }
-          expr.raw_expression += or_expr;
-        } else {
-          // Regular term (implicit AND) - add quotes if it was a quoted term
-          std::string term = current_.value;
-          if (current_.type == TokenType::kQuotedTerm) {
-            term.insert(0, "\"");
-            term += "\"";
-          }
-          expr.required_terms.push_back(term);
-          Advance();
+        if (node == QueryNode::kNone) {
+          return Fail("Empty parentheses");
         }
-      } else if (current_.type == TokenType::kOr) {
-        return "Unexpected 'OR' operator";
-      } else if (current_.type == TokenType::kRParen) {
-        return "Unexpected ')'";
-      } else {
         Advance();
+        return node;
       }
+      case TokenType::kRParen:
+        return Fail("Unexpected ')'");
+      case TokenType::kOr:
+        return Fail("Unexpected 'OR' operator");
+      default:
+        return Fail("Unexpected end of expression");
     }
+  }
 
-    return expr;
+  [[nodiscard]] bool StartsPrimary() const {
+    return current_.type == TokenType::kTerm || current_.type == TokenType::kQuotedTerm ||
+           current_.type == TokenType::kLParen;
   }
 
- private:
-  void Advance() {
-    last_pos_ = tokenizer_.GetPosition();
-    current_ = tokenizer_.Next();
+  Tokenizer tokenizer_;
+  Token current_;
+  QueryAst ast_;
+  std::string unescaped_;  // Scratch buffer for phrases with escapes
+  std::string error_;      // First error (empty while parsing succeeds)
+};
+
+}  // namespace
+
+SearchExpression FlattenQueryAst(const QueryAst& ast) {
+  SearchExpression expr;
+
+  std::vector<uint32_t> top_level;
+  const QueryNode& root = ast.GetNode(ast.Root());
+  if (root.kind == QueryNodeKind::kAnd) {
+    for (uint32_t child = root.first_child; child != QueryNode::kNone; child = ast.GetNode(child).next_sibling) {
+      top_level.push_back(child);
+    }
+  } else {
+    top_level.push_back(ast.Root());
   }
 
-  std::optional<std::string> ParsePrefixedTerm() {
-    if (current_.type == TokenType::kLParen) {
-      // Parenthesized expression after + or -
-      std::string expr = CaptureParenExpression();
-      return expr.empty() ? std::nullopt : std::optional<std::string>(expr);
+  std::vector<uint32_t> complex_parts;
+  for (uint32_t index : top_level) {
+    const QueryNode& node = ast.GetNode(index);
+    if (node.kind == QueryNodeKind::kTerm || node.kind == QueryNodeKind::kPhrase) {
+      expr.required_terms.push_back(ast.ToQueryString(index));
+      continue;
     }
-    if (current_.type == TokenType::kTerm) {
-      std::string term = current_.value;
-      Advance();
-      return term;
+    if (node.kind == QueryNodeKind::kNot) {
+      QueryNodeKind child_kind = ast.GetNode(node.first_child).kind;
+      if (child_kind == QueryNodeKind::kTerm || child_kind == QueryNodeKind::kPhrase) {
+        expr.excluded_terms.push_back(ast.ToQueryString(node.first_child));
+        continue;
+      }
     }
-    if (current_.type == TokenType::kQuotedTerm) {
-      std::string term = "\"" + current_.value + "\"";
-      Advance();
-      return term;
+    complex_parts.push_back(index);
+  }
+
+  // A single OR group is stored bare; several parts are joined with AND
+  for (size_t i = 0; i < complex_parts.size(); ++i) {
+    std::string part = ast.ToQueryString(complex_parts[i]);
+    if (i > 0) {
+      expr.raw_expression += " AND ";
+    }
+    if (complex_parts.size() > 1 && ast.GetNode(complex_parts[i]).kind == QueryNodeKind::kOr) {
+      part = "(" + part + ")";
     }
-    return std::nullopt;
+    expr.raw_expression += part;
   }
 
-  bool LooksLikeOrExpression() {
-    // Save current state
-    size_t saved_pos = tokenizer_.GetPosition();
-    Token saved_current = current_;
+  return expr;
+}
+
+// QueryAst implementation
+
+uint32_t QueryAst::AddTerm(std::string_view text, bool phrase) {
+  QueryNode node;
+  node.kind = phrase ? QueryNodeKind::kPhrase : QueryNodeKind::kTerm;
+  node.text_offset = static_cast<uint32_t>(text_.size());
+  node.text_length = static_cast<uint32_t>(text.size());
+  text_.append(text);
+  nodes_.push_back(node);
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
 
-    // Look ahead for OR
-    Advance();  // Skip current term
-    bool has_or = (current_.type == TokenType::kOr);
+uint32_t QueryAst::AddGroup(QueryNodeKind kind, const std::vector<uint32_t>& children) {
+  // Flatten nested groups of the same kind: (a AND (b AND c)) -> (a AND b AND c)
+  std::vector<uint32_t> flat;
+  flat.reserve(children.size());
+  for (uint32_t child : children) {
+    if (nodes_[child].kind != kind) {
+      flat.push_back(child);
+      continue;
+    }
+    for (uint32_t grandchild = nodes_[child].first_child; grandchild != QueryNode::kNone;
+         grandchild = nodes_[grandchild].next_sibling) {
+      flat.push_back(grandchild);
+    }
+  }
 
-    // Restore state
-    tokenizer_.SetPosition(saved_pos);
-    current_ = saved_current;
+  if (flat.size() == 1) {
+    return flat[0];
+  }
 
-    return has_or;
+  for (size_t i = 0; i + 1 < flat.size(); ++i) {
+    nodes_[flat[i]].next_sibling = flat[i + 1];
+  }
+  if (!flat.empty()) {
+    nodes_[flat.back()].next_sibling = QueryNode::kNone;
   }
 
-  std::string CaptureOrExpression() {
-    std::ostringstream oss;
+  QueryNode node;
+  node.kind = kind;
+  node.first_child = flat.empty() ? QueryNode::kNone : flat[0];
+  node.child_count = static_cast<uint32_t>(flat.size());
+  nodes_.push_back(node);
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
 
-    // Capture first term
-    if (current_.type == TokenType::kQuotedTerm) {
-      oss << "\"" << current_.value << "\"";
-    } else {
-      oss << current_.value;
-    }
-    Advance();
+uint32_t QueryAst::AddNot(uint32_t child) {
+  if (nodes_[child].kind == QueryNodeKind::kNot) {
+    return nodes_[child].first_child;  // NOT NOT x -> x
+  }
 
-    // Capture OR chain
-    while (current_.type == TokenType::kOr) {
-      oss << " OR ";
-      Advance();
-      if (current_.type == TokenType::kTerm) {
-        oss << current_.value;
-        Advance();
-      } else if (current_.type == TokenType::kQuotedTerm) {
-        oss << "\"" << current_.value << "\"";
-        Advance();
-      } else if (current_.type == TokenType::kLParen) {
-        std::string paren = CaptureParenExpression();
-        if (paren.empty()) {
-          return "";  // Error
-        }
-        oss << paren;
+  QueryNode node;
+  node.kind = QueryNodeKind::kNot;
+  node.first_child = child;
+  node.child_count = 1;
+  nodes_[child].next_sibling = QueryNode::kNone;
+  nodes_.push_back(node);
+  return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+std::string_view QueryAst::GetText(uint32_t index) const {
+  const QueryNode& node = nodes_[index];
+  return std::string_view(text_).substr(node.text_offset, node.text_length);
+}
+
+std::string QueryAst::ToQueryString() const {
+  return Empty() ? std::string() : ToQueryString(root_);
+}
+
+std::string QueryAst::ToQueryString(uint32_t index) const {
+  std::string out;
+  AppendQuery(index, false, out);
+  return out;
+}
+
+void QueryAst::AppendQuery(uint32_t index, bool parenthesize_groups, std::string& out) const {
+  const QueryNode& node = nodes_[index];
+  switch (node.kind) {
+    case QueryNodeKind::kTerm:
+      if (IsReservedWord(GetText(index))) {
+        AppendQuoted(GetText(index), out);
       } else {
-        return "";  // Error: expected term after OR
+        out += GetText(index);
       }
+      return;
+    case QueryNodeKind::kPhrase:
+      AppendQuoted(GetText(index), out);
+      return;
+    case QueryNodeKind::kNot:
+      out += "NOT ";
+      AppendQuery(node.first_child, true, out);
+      return;
+    case QueryNodeKind::kAnd:
+    case QueryNodeKind::kOr:
+      break;
+  }
+
+  if (parenthesize_groups) {
+    out += '(';
+  }
+
+  const char* separator = node.kind == QueryNodeKind::kAnd ? " AND " : " OR ";
+  bool first = true;
+  auto append_child = [&](uint32_t child) {
+    if (!first) {
+      out += separator;
     }
+    first = false;
+    AppendQuery(child, true, out);
+  };
 
-    return oss.str();
-  }
-
-  std::string CaptureParenExpression() {
-    if (current_.type != TokenType::kLParen) {
-      return "";
-    }
-
-    std::ostringstream oss;
-    int depth = 0;
-
-    // NOLINTNEXTLINE(cppcoreguidelines-avoid-do-while) - do-while is appropriate for paren matching
-    do {
-      if (current_.type == TokenType::kLParen) {
-        ++depth;
-        oss << "(";
-      } else if (current_.type == TokenType::kRParen) {
-        --depth;
-        oss << ")";
-      } else if (current_.type == TokenType::kTerm) {
-        oss << current_.value;
-      } else if (current_.type == TokenType::kQuotedTerm) {
-        oss << "\"" << current_.value << "\"";
-      } else if (current_.type == TokenType::kOr) {
-        oss << " OR ";
-      } else if (current_.type == TokenType::kPlus) {
-        oss << "+";
-      } else if (current_.type == TokenType::kMinus) {
-        oss << "-";
-      } else if (current_.type == TokenType::kEnd) {
-        return "";  // Unbalanced
+  if (node.kind == QueryNodeKind::kAnd) {
+    // Positive children first (the server expects a positive term before NOT)
+    for (uint32_t child = node.first_child; child != QueryNode::kNone; child = nodes_[child].next_sibling) {
+      if (nodes_[child].kind != QueryNodeKind::kNot) {
+        append_child(child);
       }
-
-      if (depth > 0) {
-        Advance();
+    }
+    for (uint32_t child = node.first_child; child != QueryNode::kNone; child = nodes_[child].next_sibling) {
+      if (nodes_[child].kind == QueryNodeKind::kNot) {
+        append_child(child);
       }
-    } while (depth > 0);
-
-    Advance();  // Skip closing paren
-    return oss.str();
+    }
+  } else {
+    for (uint32_t child = node.first_child; child != QueryNode::kNone; child = nodes_[child].next_sibling) {
+      append_child(child);
+    }
   }
 
-  Tokenizer tokenizer_;
-  Token current_;
-  size_t last_pos_ = 0;
-};
-
-}  // namespace
+  if (parenthesize_groups) {
+    out += ')';
+  }
+}
 
 bool SearchExpression::HasComplexExpression() const {
   if (!raw_expression.empty()) {
@@ -435,7 +642,7 @@ std::string SearchExpression::ToQueryString() const {
   return oss.str();
 }
 
-std::variant<SearchExpression, std::string> ParseSearchExpression(const std::string& expression) {
+std::variant<QueryAst, std::string> ParseQueryAst(const std::string& expression) {
   if (expression.empty()) {
     return "Empty search expression";
   }
@@ -444,15 +651,63 @@ std::variant<SearchExpression, std::string> ParseSearchExpression(const std::str
   return parser.Parse();
 }
 
+std::variant<SearchExpression, std::string> ParseSearchExpression(const std::string& expression) {
+  auto result = ParseQueryAst(expression);
+  if (auto* err = std::get_if<std::string>(&result)) {
+    return *err;
+  }
+  return FlattenQueryAst(std::get<QueryAst>(result));
+}
+
 std::variant<std::string, std::string> ConvertSearchExpression(const std::string& expression) {
-  auto result = ParseSearchExpression(expression);
+  auto result = ParseQueryAst(expression);
   if (auto* err = std::get_if<std::string>(&result)) {
     // Return error (index 1)
     return std::variant<std::string, std::string>(std::in_place_index<1>, *err);
   }
-  auto expr = std::get<SearchExpression>(result);
   // Return success (index 0)
-  return std::variant<std::string, std::string>(std::in_place_index<0>, expr.ToQueryString());
+  return std::variant<std::string, std::string>(std::in_place_index<0>, std::get<QueryAst>(result).ToQueryString());
+}
+
+ConvertedExpressions ConvertSearchExpressions(const std::vector<std::string>& expressions, size_t max_threads) {
+  // Results of one worker's chunk; offsets are relative to its own buffer until merged
+  struct Chunk {
+    size_t begin = 0;
+    size_t end = 0;
+    std::string data;
+  };
+
+  ConvertedExpressions converted;
+  converted.ok.resize(expressions.size());
+  converted.offsets.resize(expressions.size() + 1);
+
+  std::vector<Chunk> chunks(utils::ParallelWorkerCount(expressions.size(), kMinExpressionsPerWorker, max_threads));
+  utils::ParallelFor(expressions.size(), kMinExpressionsPerWorker, max_threads,
+                     [&](size_t worker, size_t begin, size_t end) {
+                       Chunk& chunk = chunks[worker];
+                       chunk.begin = begin;
+                       chunk.end = end;
+                       for (size_t i = begin; i < end; ++i) {
+                         auto result = ConvertSearchExpression(expressions[i]);
+                         converted.ok[i] = result.index() == 0 ? 1 : 0;
+                         chunk.data += result.index() == 0 ? std::get<0>(result) : std::get<1>(result);
+                         converted.offsets[i + 1] = static_cast<uint32_t>(chunk.data.size());
+                       }
+                     });
+
+  size_t total = 0;
+  for (const auto& chunk : chunks) {
+    total += chunk.data.size();
+  }
+  converted.data.reserve(total);
+  for (const auto& chunk : chunks) {
+    auto base = static_cast<uint32_t>(converted.data.size());
+    for (size_t i = chunk.begin; i < chunk.end; ++i) {
+      converted.offsets[i + 1] += base;
+    }
+    converted.data += chunk.data;
+  }
+  return converted;
 }
 
 bool SimplifySearchExpression(const std::string& expression, std::string& main_term,
@@ -462,7 +717,15 @@ bool SimplifySearchExpression(const std::string& expression, std::string& main_t
     return false;
   }
 
-  auto expr = std::get<SearchExpression>(result);
+  return SimplifySearchExpression(std::get<SearchExpression>(result), main_term, and_terms, not_terms);
+}
+
+bool SimplifySearchExpression(const SearchExpression& expr, std::string& main_term,
+                              std::vector<std::string>& and_terms, std::vector<std::string>& not_terms) {
+  // Groups (OR, nested AND, NOT of a group) have no term form; dropping them would widen the results
+  if (!expr.raw_expression.empty()) {
+    return false;
+  }
 
   // Extract main term - all terms are now in required_terms
   if (!expr.required_terms.empty()) {
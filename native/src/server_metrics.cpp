@@ -0,0 +1,225 @@
+/**
+ * @file server_metrics.cpp
+ * @brief Capacity metrics derived from INFO deltas
+ */
+
+#include "server_metrics.h"
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <utility>
+
+namespace mygramdb::client {
+
+namespace {
+
+constexpr int64_t kMillisecondsPerSecond = 1000;
+
+/**
+ * @brief One INFO sample with restart-stitched cumulative counters
+ */
+struct MetricsSample {
+  int64_t captured_at_ms = 0;  // Capture time (ms since Unix epoch)
+  uint64_t requests = 0;       // Stitched total_requests
+  uint64_t errors = 0;         // Stitched total_errors
+  uint64_t doc_count = 0;      // doc_count as reported
+  uint64_t index_size_bytes = 0;  // index_size_bytes as reported
+};
+
+/**
+ * @brief Tracks a cumulative counter across server restarts
+ */
+class StitchedCounter {
+ public:
+  /**
+   * @brief Add a raw reading and return the stitched value
+   * @param raw Raw counter value
+   * @param restarted Whether the server restarted since the previous reading
+   */
+  uint64_t Update(uint64_t raw, bool restarted) {
+    if (has_previous_ && (restarted || raw < previous_)) {
+      offset_ += previous_;  // Counter restarted from zero
+    }
+    previous_ = raw;
+    has_previous_ = true;
+    return raw + offset_;
+  }
+
+ private:
+  uint64_t previous_ = 0;
+  uint64_t offset_ = 0;
+  bool has_previous_ = false;
+};
+
+double Rate(uint64_t newer, uint64_t older, double seconds) {
+  return seconds > 0.0 ? static_cast<double>(newer - older) / seconds : 0.0;
+}
+
+}  // namespace
+
+/**
+ * @brief PIMPL implementation class
+ */
+class MetricsCollector::Impl {
+ public:
+  explicit Impl(MetricsCollectorConfig config) : window_seconds_(std::move(config.window_seconds)) {
+    for (uint32_t seconds : window_seconds_) {
+      max_window_ms_ = std::max<int64_t>(max_window_ms_, static_cast<int64_t>(seconds) * kMillisecondsPerSecond);
+    }
+    poller_ = std::make_unique<InfoPoller>(std::move(config.poller));
+    poller_->SetListener([this](const InfoSnapshot& snapshot) { Record(snapshot); });
+  }
+
+  ~Impl() { poller_->Stop(); }
+
+  Impl(const Impl&) = delete;
+  Impl& operator=(const Impl&) = delete;
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  std::optional<std::string> Start() { return poller_->Start(); }
+
+  void Stop() { poller_->Stop(); }
+
+  [[nodiscard]] bool IsRunning() const { return poller_->IsRunning(); }
+
+  [[nodiscard]] std::string GetLastError() const { return poller_->GetLastError(); }
+
+  void Record(const InfoSnapshot& snapshot) {
+    const ServerInfo& info = snapshot.info;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // A shorter uptime than last time means the server restarted, even if counters caught up
+    bool restarted = !samples_.empty() && info.uptime_seconds < previous_uptime_;
+    if (!samples_.empty() && (restarted || info.total_requests < previous_requests_)) {
+      ++counter_resets_;
+    }
+    previous_uptime_ = info.uptime_seconds;
+    previous_requests_ = info.total_requests;
+
+    auto errors = info.GetUint("total_errors");
+    reports_errors_ = errors.has_value();
+
+    MetricsSample sample;
+    sample.captured_at_ms = snapshot.captured_at_ms;
+    sample.requests = requests_.Update(info.total_requests, restarted);
+    sample.errors = errors_.Update(errors.value_or(0), restarted);
+    sample.doc_count = info.doc_count;
+    sample.index_size_bytes = info.index_size_bytes;
+    samples_.push_back(sample);
+    active_connections_ = info.active_connections;
+
+    // Keep one sample at or before the start of the longest window
+    while (samples_.size() > 2 && samples_[1].captured_at_ms <= sample.captured_at_ms - max_window_ms_) {
+      samples_.pop_front();
+    }
+  }
+
+  [[nodiscard]] ServerMetrics GetMetrics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    ServerMetrics metrics;
+    metrics.sample_count = samples_.size();
+    metrics.reports_errors = reports_errors_;
+    metrics.counter_resets = counter_resets_;
+    metrics.active_connections = active_connections_;
+    if (samples_.empty()) {
+      for (uint32_t seconds : window_seconds_) {
+        MetricsWindow window;
+        window.window_seconds = seconds;
+        metrics.windows.push_back(window);
+      }
+      return metrics;
+    }
+
+    const MetricsSample& latest = samples_.back();
+    metrics.captured_at_ms = latest.captured_at_ms;
+    metrics.doc_count = latest.doc_count;
+    metrics.index_size_bytes = latest.index_size_bytes;
+    if (latest.doc_count > 0) {
+      metrics.index_bytes_per_doc =
+          static_cast<double>(latest.index_size_bytes) / static_cast<double>(latest.doc_count);
+    }
+
+    metrics.windows.reserve(window_seconds_.size());
+    for (uint32_t seconds : window_seconds_) {
+      MetricsWindow window;
+      window.window_seconds = seconds;
+
+      // Base sample: the newest one at or before the window start (the oldest while warming up)
+      int64_t window_start = latest.captured_at_ms - static_cast<int64_t>(seconds) * kMillisecondsPerSecond;
+      auto after_start = std::upper_bound(
+          samples_.begin(), samples_.end(), window_start,
+          [](int64_t start, const MetricsSample& sample) { return start < sample.captured_at_ms; });
+      const MetricsSample& base = after_start == samples_.begin() ? samples_.front() : *std::prev(after_start);
+
+      window.covered_seconds = static_cast<double>(latest.captured_at_ms - base.captured_at_ms) /
+                               static_cast<double>(kMillisecondsPerSecond);
+      window.requests_per_second = Rate(latest.requests, base.requests, window.covered_seconds);
+      window.errors_per_second = Rate(latest.errors, base.errors, window.covered_seconds);
+      if (latest.requests > base.requests) {
+        window.error_ratio =
+            static_cast<double>(latest.errors - base.errors) / static_cast<double>(latest.requests - base.requests);
+      }
+      window.doc_delta = static_cast<int64_t>(latest.doc_count) - static_cast<int64_t>(base.doc_count);
+      window.index_bytes_delta =
+          static_cast<int64_t>(latest.index_size_bytes) - static_cast<int64_t>(base.index_size_bytes);
+      if (window.covered_seconds > 0.0) {
+        window.docs_per_second = static_cast<double>(window.doc_delta) / window.covered_seconds;
+      }
+      metrics.windows.push_back(window);
+    }
+
+    return metrics;
+  }
+
+ private:
+  std::vector<uint32_t> window_seconds_;  // Configured windows
+  int64_t max_window_ms_ = 0;             // Longest window in ms
+  std::unique_ptr<InfoPoller> poller_;
+
+  mutable std::mutex mutex_;           // Guards everything below
+  std::deque<MetricsSample> samples_;  // Samples in capture order
+  StitchedCounter requests_;
+  StitchedCounter errors_;
+  uint64_t previous_uptime_ = 0;
+  uint64_t previous_requests_ = 0;
+  uint64_t active_connections_ = 0;
+  uint32_t counter_resets_ = 0;
+  bool reports_errors_ = false;
+};
+
+// MetricsCollector public interface implementation
+
+MetricsCollector::MetricsCollector(MetricsCollectorConfig config)
+    : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+MetricsCollector::~MetricsCollector() = default;
+
+std::optional<std::string> MetricsCollector::Start() {
+  return impl_->Start();
+}
+
+void MetricsCollector::Stop() {
+  impl_->Stop();
+}
+
+bool MetricsCollector::IsRunning() const {
+  return impl_->IsRunning();
+}
+
+void MetricsCollector::Record(const InfoSnapshot& snapshot) {
+  impl_->Record(snapshot);
+}
+
+ServerMetrics MetricsCollector::GetMetrics() const {
+  return impl_->GetMetrics();
+}
+
+std::string MetricsCollector::GetLastError() const {
+  return impl_->GetLastError();
+}
+
+}  // namespace mygramdb::client
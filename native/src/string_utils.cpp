@@ -7,9 +7,12 @@
 
 #include <algorithm>
 #include <array>
-#include <cctype>
 #include <iomanip>
+#include <memory>
 #include <sstream>
+#include <utility>
+
+#include "utf8_decode.h"
 
 #ifdef USE_ICU
 #include <unicode/brkiter.h>
@@ -89,44 +92,134 @@ int Utf8CharLength(unsigned char first_byte) {
   return 1;  // Invalid, treat as 1 byte
 }
 
+/**
+ * @brief Get number of bytes CodepointsToUtf8 emits for a codepoint (0 if out of range)
+ */
+int EncodedLength(uint32_t codepoint) {
+  if (codepoint <= kUnicodeMaxOneByte) {
+    return 1;
+  }
+  if (codepoint <= kUnicodeMaxTwoByte) {
+    return 2;
+  }
+  if (codepoint <= kUnicodeMaxThreeByte) {
+    return 3;
+  }
+  return codepoint <= kUnicodeMaxCodepoint ? 4 : 0;
+}
+
 }  // namespace
 
-std::vector<uint32_t> Utf8ToCodepoints(const std::string& text) {
-  std::vector<uint32_t> codepoints;
-  codepoints.reserve(text.size());  // Over-allocate for ASCII
+void AppendUtf8(uint32_t codepoint, std::string& out) {
+  if (codepoint <= kUnicodeMaxOneByte) {
+    out += static_cast<char>(codepoint);
+  } else if (codepoint <= kUnicodeMaxTwoByte) {
+    out += static_cast<char>(kUtf8TwoBytePattern | (codepoint >> kUtf8Shift6));
+    out += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
+  } else if (codepoint <= kUnicodeMaxThreeByte) {
+    out += static_cast<char>(kUtf8ThreeBytePattern | (codepoint >> kUtf8Shift12));
+    out += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift6) & kUtf8ContinuationMask));
+    out += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
+  } else if (codepoint <= kUnicodeMaxCodepoint) {
+    out += static_cast<char>(kUtf8FourBytePattern | (codepoint >> kUtf8Shift18));
+    out += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift12) & kUtf8ContinuationMask));
+    out += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift6) & kUtf8ContinuationMask));
+    out += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
+  }
+}
 
-  for (size_t i = 0; i < text.size();) {
-    auto first_byte = static_cast<unsigned char>(text[i]);
-    int char_len = Utf8CharLength(first_byte);
+namespace {
 
-    if (i + char_len > text.size()) {
-      // Incomplete UTF-8 sequence, skip
-      ++i;
+/**
+ * @brief Decode the code point starting at pos
+ *
+ * Lenient: an invalid lead byte decodes as itself, and continuation bytes are
+ * not checked. well_formed reports whether re-encoding the code point gives
+ * back the same bytes.
+ *
+ * @return Bytes consumed, or 0 for a sequence cut off by the end of text
+ */
+int DecodeCodepoint(std::string_view text, size_t pos, uint32_t& codepoint, bool& well_formed) {
+  auto first_byte = static_cast<unsigned char>(text[pos]);
+  int char_len = Utf8CharLength(first_byte);
+
+  if (pos + char_len > text.size()) {
+    return 0;
+  }
+
+  bool continuations_ok = true;
+  for (int j = 1; j < char_len; ++j) {
+    if ((static_cast<unsigned char>(text[pos + j]) & ~kUtf8ContinuationMask) != kUtf8ContinuationPattern) {
+      continuations_ok = false;
+    }
+  }
+
+  if (char_len == 1) {
+    codepoint = first_byte;
+  } else if (char_len == 2) {
+    codepoint = ((first_byte & kUtf8TwoByteDatMask) << kUtf8Shift6) |
+                (static_cast<unsigned char>(text[pos + 1]) & kUtf8ContinuationMask);
+  } else if (char_len == 3) {
+    codepoint = ((first_byte & kUtf8ThreeByteDatMask) << kUtf8Shift12) |
+                ((static_cast<unsigned char>(text[pos + 1]) & kUtf8ContinuationMask) << kUtf8Shift6) |
+                (static_cast<unsigned char>(text[pos + 2]) & kUtf8ContinuationMask);
+  } else {
+    codepoint = ((first_byte & kUtf8FourByteDatMask) << kUtf8Shift18) |
+                ((static_cast<unsigned char>(text[pos + 1]) & kUtf8ContinuationMask) << kUtf8Shift12) |
+                ((static_cast<unsigned char>(text[pos + 2]) & kUtf8ContinuationMask) << kUtf8Shift6) |
+                (static_cast<unsigned char>(text[pos + 3]) & kUtf8ContinuationMask);
+  }
+
+  well_formed = continuations_ok && EncodedLength(codepoint) == char_len;
+  return char_len;
+}
+
+/**
+ * @brief Append a run of ASCII bytes as codepoints
+ */
+void AppendAscii(const unsigned char* bytes, size_t length, std::vector<uint32_t>& codepoints) {
+  if (length == 1) {
+    codepoints.push_back(bytes[0]);
+  } else {
+    codepoints.insert(codepoints.end(), bytes, bytes + length);
+  }
+}
+
+/**
+ * @brief Decode text into codepoints (cleared first), skipping incomplete sequences
+ */
+void DecodeCodepoints(std::string_view text, std::vector<uint32_t>& codepoints) {
+  codepoints.clear();
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  for (size_t i = 0; i < text.size();) {
+    if (bytes[i] < kUtf8OneByteMask) {
+      size_t run = AsciiRunLength(text.data() + i, text.size() - i);
+      AppendAscii(bytes + i, run, codepoints);
+      i += run;
       continue;
     }
 
     uint32_t codepoint = 0;
+    bool well_formed = true;
+    int char_len = DecodeCodepoint(text, i, codepoint, well_formed);
 
-    if (char_len == 1) {
-      codepoint = first_byte;
-    } else if (char_len == 2) {
-      codepoint = ((first_byte & kUtf8TwoByteDatMask) << kUtf8Shift6) |
-                  (static_cast<unsigned char>(text[i + 1]) & kUtf8ContinuationMask);
-    } else if (char_len == 3) {
-      codepoint = ((first_byte & kUtf8ThreeByteDatMask) << kUtf8Shift12) |
-                  ((static_cast<unsigned char>(text[i + 1]) & kUtf8ContinuationMask) << kUtf8Shift6) |
-                  (static_cast<unsigned char>(text[i + 2]) & kUtf8ContinuationMask);
-    } else if (char_len == 4) {
-      codepoint = ((first_byte & kUtf8FourByteDatMask) << kUtf8Shift18) |
-                  ((static_cast<unsigned char>(text[i + 1]) & kUtf8ContinuationMask) << kUtf8Shift12) |
-                  ((static_cast<unsigned char>(text[i + 2]) & kUtf8ContinuationMask) << kUtf8Shift6) |
-                  (static_cast<unsigned char>(text[i + 3]) & kUtf8ContinuationMask);
+    if (char_len == 0) {
+      // Incomplete UTF-8 sequence, skip
+      ++i;
+      continue;
     }
 
     codepoints.push_back(codepoint);
     i += char_len;
   }
+}
+
+}  // namespace
 
+std::vector<uint32_t> Utf8ToCodepoints(const std::string& text) {
+  std::vector<uint32_t> codepoints;
+  codepoints.reserve(text.size());  // Over-allocate for ASCII
+  DecodeCodepoints(text, codepoints);
   return codepoints;
 }
 
@@ -135,35 +228,138 @@ std::string CodepointsToUtf8(const std::vector<uint32_t>& codepoints) {
   result.reserve(codepoints.size() * 3);  // Estimate
 
   for (uint32_t codepoint : codepoints) {
-    if (codepoint <= kUnicodeMaxOneByte) {
-      result += static_cast<char>(codepoint);
-    } else if (codepoint <= kUnicodeMaxTwoByte) {
-      result += static_cast<char>(kUtf8TwoBytePattern | (codepoint >> kUtf8Shift6));
-      result += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
-    } else if (codepoint <= kUnicodeMaxThreeByte) {
-      result += static_cast<char>(kUtf8ThreeBytePattern | (codepoint >> kUtf8Shift12));
-      result += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift6) & kUtf8ContinuationMask));
-      result += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
-    } else if (codepoint <= kUnicodeMaxCodepoint) {
-      result += static_cast<char>(kUtf8FourBytePattern | (codepoint >> kUtf8Shift18));
-      result += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift12) & kUtf8ContinuationMask));
-      result += static_cast<char>(kUtf8ContinuationPattern | ((codepoint >> kUtf8Shift6) & kUtf8ContinuationMask));
-      result += static_cast<char>(kUtf8ContinuationPattern | (codepoint & kUtf8ContinuationMask));
+    AppendUtf8(codepoint, result);
+  }
+
+  return result;
+}
+
+std::string_view IndexCodepoints(std::string_view text, NgramScratch& scratch) {
+  scratch.codepoints.clear();
+  scratch.offsets.clear();
+
+  bool round_trips = true;
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  for (size_t i = 0; i < text.size();) {
+    if (bytes[i] < kUtf8OneByteMask) {
+      size_t run = AsciiRunLength(text.data() + i, text.size() - i);
+      AppendAscii(bytes + i, run, scratch.codepoints);
+      for (size_t end = i + run; i < end; ++i) {
+        scratch.offsets.push_back(i);
+      }
+      continue;
     }
+
+    uint32_t codepoint = 0;
+    bool well_formed = true;
+    int char_len = DecodeCodepoint(text, i, codepoint, well_formed);
+    if (char_len == 0) {
+      round_trips = false;  // Incomplete sequence is dropped
+      ++i;
+      continue;
+    }
+    round_trips = round_trips && well_formed;
+    scratch.codepoints.push_back(codepoint);
+    scratch.offsets.push_back(i);
+    i += char_len;
+  }
+
+  if (round_trips) {
+    scratch.offsets.push_back(text.size());
+    return text;
   }
 
+  // Re-encode so every code point has the bytes CodepointsToUtf8 would give it
+  scratch.text.clear();
+  for (size_t i = 0; i < scratch.codepoints.size(); ++i) {
+    scratch.offsets[i] = scratch.text.size();
+    AppendUtf8(scratch.codepoints[i], scratch.text);
+  }
+  scratch.offsets.push_back(scratch.text.size());
+  return scratch.text;
+}
+
+WidthMode ParseWidthMode(std::string_view width) {
+  if (width == "narrow") {
+    return WidthMode::kNarrow;
+  }
+  if (width == "wide") {
+    return WidthMode::kWide;
+  }
+  return WidthMode::kKeep;
+}
+
+namespace {
+
+/**
+ * @brief Lowercase ASCII letters in place (the only case mapping ASCII text has)
+ */
+void LowerAscii(std::string& text) {
+  for (char& character : text) {
+    if (character >= 'A' && character <= 'Z') {
+      character = static_cast<char>(character - 'A' + 'a');
+    }
+  }
+}
+
+#ifdef USE_ICU
+/**
+ * @brief This thread's transliterator for a width conversion (nullptr for kKeep or if ICU cannot create it)
+ *
+ * Creating a transliterator parses its rules and is far more expensive than
+ * running it, so each thread creates each one once.
+ */
+icu::Transliterator* WidthTransliterator(WidthMode width) {
+  struct Cached {
+    std::unique_ptr<icu::Transliterator> transliterator;
+    bool created = false;
+  };
+  thread_local Cached narrow;
+  thread_local Cached wide;
+
+  if (width == WidthMode::kKeep) {
+    return nullptr;
+  }
+  Cached& cached = width == WidthMode::kNarrow ? narrow : wide;
+  if (!cached.created) {
+    cached.created = true;
+    UErrorCode status = U_ZERO_ERROR;
+    const char* id = width == WidthMode::kNarrow ? "Fullwidth-Halfwidth" : "Halfwidth-Fullwidth";
+    cached.transliterator.reset(icu::Transliterator::createInstance(id, UTRANS_FORWARD, status));
+    if (U_SUCCESS(status) == 0) {
+      cached.transliterator.reset();
+    }
+  }
+  return cached.transliterator.get();
+}
+
+#endif
+
+}  // namespace
+
+std::string Normalizer::Normalize(std::string_view text) const {
+  std::string result;
+  Normalize(text, result);
   return result;
 }
 
+void Normalizer::Normalize(std::string_view text, std::string& out) const {
+  // ASCII is NFKC-stable and already half-width, so only case can change
+  if (width_ != WidthMode::kWide && AsciiPrefixLength(text.data(), text.size()) == text.size()) {
+    out.assign(text);
+    if (lower_) {
+      LowerAscii(out);
+    }
+    return;
+  }
+
 #ifdef USE_ICU
-std::string NormalizeTextICU(const std::string& text, bool nfkc, const std::string& width, bool lower) {
   UErrorCode status = U_ZERO_ERROR;
-
-  // Convert UTF-8 to UnicodeString
-  icu::UnicodeString ustr = icu::UnicodeString::fromUTF8(text);
+  icu::UnicodeString ustr =
+      icu::UnicodeString::fromUTF8(icu::StringPiece(text.data(), static_cast<int32_t>(text.size())));
 
   // NFKC normalization
-  if (nfkc) {
+  if (nfkc_) {
     const icu::Normalizer2* normalizer = icu::Normalizer2::getNFKCInstance(status);
     if (U_SUCCESS(status) != 0) {
       icu::UnicodeString normalized;
@@ -175,171 +371,526 @@ std::string NormalizeTextICU(const std::string& text, bool nfkc, const std::stri
   }
 
   // Width conversion
-  if (width == "narrow") {
-    // Full-width to half-width conversion
-    std::unique_ptr<icu::Transliterator> trans(
-        icu::Transliterator::createInstance("Fullwidth-Halfwidth", UTRANS_FORWARD, status));
-    if ((U_SUCCESS(status) != 0) && trans != nullptr) {
-      trans->transliterate(ustr);
-    }
-  } else if (width == "wide") {
-    // Half-width to full-width conversion
-    std::unique_ptr<icu::Transliterator> trans(
-        icu::Transliterator::createInstance("Halfwidth-Fullwidth", UTRANS_FORWARD, status));
-    if ((U_SUCCESS(status) != 0) && trans != nullptr) {
-      trans->transliterate(ustr);
-    }
+  if (icu::Transliterator* transliterator = WidthTransliterator(width_)) {
+    transliterator->transliterate(ustr);
   }
 
   // Lowercase conversion
-  if (lower) {
+  if (lower_) {
     ustr.toLower();
   }
 
   // Convert back to UTF-8
-  std::string result;
-  ustr.toUTF8String(result);
-  return result;
+  out.clear();
+  ustr.toUTF8String(out);
+#else
+  NormalizeTextBuiltin(text, nfkc_, width_, lower_, out);
+#endif
+}
+
+#ifdef USE_ICU
+std::string NormalizeTextICU(const std::string& text, bool nfkc, const std::string& width, bool lower) {
+  return Normalizer(nfkc, ParseWidthMode(width), lower).Normalize(text);
 }
 #endif
 
 std::string NormalizeText(const std::string& text, bool nfkc, const std::string& width, bool lower) {
-#ifdef USE_ICU
-  return NormalizeTextICU(text, nfkc, width, lower);
-#else
-  // Fallback implementation: simple lowercasing only
-  std::string result = text;
+  return Normalizer(nfkc, ParseWidthMode(width), lower).Normalize(text);
+}
 
-  if (lower) {
-    std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+const std::vector<std::string_view>& GenerateNgramViews(std::string_view text, int n, NgramScratch& scratch) {
+  scratch.ngrams.clear();
+  if (n <= 0) {
+    return scratch.ngrams;
   }
 
-  return result;
-#endif
+  std::string_view buffer = IndexCodepoints(text, scratch);
+  size_t count = scratch.codepoints.size();
+  if (count < static_cast<size_t>(n)) {
+    return scratch.ngrams;
+  }
+
+  scratch.ngrams.reserve(count - n + 1);
+  for (size_t i = 0; i + n <= count; ++i) {
+    scratch.ngrams.push_back(buffer.substr(scratch.offsets[i], scratch.offsets[i + n] - scratch.offsets[i]));
+  }
+  return scratch.ngrams;
 }
 
 std::vector<std::string> GenerateNgrams(const std::string& text, int n) {
-  std::vector<std::string> ngrams;
+  NgramScratch scratch;
+  const auto& views = GenerateNgramViews(text, n, scratch);
+  return {views.begin(), views.end()};
+}
+
+namespace {
 
-  // Convert to codepoints for proper character-level n-grams
-  std::vector<uint32_t> codepoints = Utf8ToCodepoints(text);
+/**
+ * @brief Inclusive codepoint range
+ */
+struct CodepointRange {
+  uint32_t first;
+  uint32_t last;
+};
 
-  if (codepoints.empty() || n <= 0) {
-    return ngrams;
-  }
+/**
+ * CJK Ideograph ranges (Kanji only, excluding Hiragana/Katakana)
+ *
+ * Note: Hiragana (3040-309F) and Katakana (30A0-30FF) are intentionally excluded.
+ * They will be processed with ascii_ngram_size instead of kanji_ngram_size.
+ */
+constexpr std::array<CodepointRange, 6> kCjkRanges = {{
+    {kCjkMainStart, kCjkMainEnd},      // 4E00-9FFF: Common and uncommon Kanji
+    {kCjkExtAStart, kCjkExtAEnd},      // 3400-4DBF: Extension A
+    {kCjkExtBStart, kCjkExtBEnd},      // 20000-2A6DF: Extension B
+    {kCjkExtCStart, kCjkExtCEnd},      // 2A700-2B73F: Extension C
+    {kCjkExtDStart, kCjkExtDEnd},      // 2B740-2B81F: Extension D
+    {kCjkCompatStart, kCjkCompatEnd},  // F900-FAFF: Compatibility Ideographs
+}};
+
+// Two-level classification table layout
+constexpr uint32_t kClassBlockBits = 8;                            // Codepoints per block = 256
+constexpr uint32_t kClassBlockSize = 1U << kClassBlockBits;
+constexpr uint32_t kClassTableEnd = 0x30000;                       // Planes 0-2; no ideograph above
+constexpr uint32_t kClassBlocks = kClassTableEnd >> kClassBlockBits;
+constexpr uint8_t kUniformOtherBlock = 0;                          // Stage 2 block with no ideograph
+constexpr uint8_t kUniformCjkBlock = 1;                            // Stage 2 block of ideographs only
 
-  // For n=1 (unigrams), just return each character
-  if (n == 1) {
-    ngrams.reserve(codepoints.size());
-    for (uint32_t codepoint : codepoints) {
-      ngrams.push_back(CodepointsToUtf8({codepoint}));
+/**
+ * @brief Number of ideographs in block [begin, begin + kClassBlockSize)
+ */
+constexpr uint32_t CjkCountInBlock(uint32_t begin) {
+  uint32_t count = 0;
+  for (const auto& range : kCjkRanges) {
+    uint32_t first = range.first > begin ? range.first : begin;
+    uint32_t last = range.last < begin + kClassBlockSize - 1 ? range.last : begin + kClassBlockSize - 1;
+    if (first <= last) {
+      count += last - first + 1;
     }
-    return ngrams;
   }
+  return count;
+}
 
-  // For n > 1
-  if (codepoints.size() < static_cast<size_t>(n)) {
-    return ngrams;
+/**
+ * @brief Number of blocks holding both ideographs and other codepoints
+ */
+constexpr size_t CountMixedBlocks() {
+  size_t mixed = 0;
+  for (uint32_t block = 0; block < kClassBlocks; ++block) {
+    uint32_t count = CjkCountInBlock(block << kClassBlockBits);
+    if (count != 0 && count != kClassBlockSize) {
+      ++mixed;
+    }
   }
+  return mixed;
+}
+
+constexpr size_t kClassStage2Blocks = kUniformCjkBlock + 1 + CountMixedBlocks();
 
-  ngrams.reserve(codepoints.size() - n + 1);
-  for (size_t i = 0; i <= codepoints.size() - n; ++i) {
-    std::vector<uint32_t> ngram_cp(codepoints.begin() + static_cast<std::ptrdiff_t>(i),
-                                   codepoints.begin() + static_cast<std::ptrdiff_t>(i + n));
-    ngrams.push_back(CodepointsToUtf8(ngram_cp));
+/**
+ * @brief Two-level CJK ideograph table
+ *
+ * stage1 maps each 256-codepoint block to a stage2 block. Blocks entirely in
+ * or out of the ranges share the two uniform stage2 blocks, so only the few
+ * blocks a range boundary cuts through get their own (about 2 KB in all).
+ */
+struct CjkClassTable {
+  std::array<uint8_t, kClassBlocks> stage1{};
+  std::array<std::array<uint8_t, kClassBlockSize>, kClassStage2Blocks> stage2{};
+};
+
+constexpr CjkClassTable BuildCjkClassTable() {
+  CjkClassTable table{};
+  for (uint32_t i = 0; i < kClassBlockSize; ++i) {
+    table.stage2[kUniformCjkBlock][i] = 1;
   }
 
-  return ngrams;
+  uint8_t next_block = kUniformCjkBlock + 1;
+  for (uint32_t block = 0; block < kClassBlocks; ++block) {
+    uint32_t begin = block << kClassBlockBits;
+    uint32_t count = CjkCountInBlock(begin);
+    if (count == 0) {
+      table.stage1[block] = kUniformOtherBlock;
+    } else if (count == kClassBlockSize) {
+      table.stage1[block] = kUniformCjkBlock;
+    } else {
+      table.stage1[block] = next_block;
+      for (uint32_t i = 0; i < kClassBlockSize; ++i) {
+        for (const auto& range : kCjkRanges) {
+          if (begin + i >= range.first && begin + i <= range.last) {
+            table.stage2[next_block][i] = 1;
+          }
+        }
+      }
+      ++next_block;
+    }
+  }
+  return table;
 }
 
-namespace {
+constexpr CjkClassTable kCjkClassTable = BuildCjkClassTable();
+
+static_assert(kCjkExtDEnd < kClassTableEnd, "CJK ranges must fit in the classification table");
+static_assert(kClassStage2Blocks <= 256, "Stage 2 block indexes must fit in uint8_t");
 
 /**
  * @brief Check if codepoint is CJK Ideograph (Kanji only, excluding Hiragana/Katakana)
  *
- * CJK Unified Ideographs ranges:
- * - 4E00-9FFF: Common and uncommon Kanji
- * - 3400-4DBF: Extension A
- * - 20000-2A6DF: Extension B
- * - 2A700-2B73F: Extension C
- * - 2B740-2B81F: Extension D
- * - F900-FAFF: Compatibility Ideographs
- *
- * Note: Hiragana (3040-309F) and Katakana (30A0-30FF) are intentionally excluded.
- * They will be processed with ascii_ngram_size instead of kanji_ngram_size.
+ * Two table lookups instead of a chain of range comparisons; the table is
+ * built at compile time from kCjkRanges.
  */
 bool IsCJKIdeograph(uint32_t codepoint) {
-  return (codepoint >= kCjkMainStart && codepoint <= kCjkMainEnd) ||    // Main block
-         (codepoint >= kCjkExtAStart && codepoint <= kCjkExtAEnd) ||    // Extension A
-         (codepoint >= kCjkExtBStart && codepoint <= kCjkExtBEnd) ||    // Extension B
-         (codepoint >= kCjkExtCStart && codepoint <= kCjkExtCEnd) ||    // Extension C
-         (codepoint >= kCjkExtDStart && codepoint <= kCjkExtDEnd) ||    // Extension D
-         (codepoint >= kCjkCompatStart && codepoint <= kCjkCompatEnd);  // Compatibility
+  if (codepoint >= kClassTableEnd) {
+    return false;
+  }
+  uint8_t block = kCjkClassTable.stage1[codepoint >> kClassBlockBits];
+  return kCjkClassTable.stage2[block][codepoint & (kClassBlockSize - 1)] != 0;
+}
+
+/**
+ * @brief Call emit(start, size) for every hybrid n-gram window over codepoints
+ *
+ * CJK characters use kanji_ngram_size, others ascii_ngram_size; an n-gram
+ * never mixes the two. The text is split into runs of one kind, and every
+ * window that fits in its run is emitted, so each codepoint is classified
+ * once.
+ */
+template <typename Emit>
+void ForEachHybridNgram(const std::vector<uint32_t>& codepoints, int ascii_ngram_size, int kanji_ngram_size,
+                        Emit&& emit) {
+  size_t count = codepoints.size();
+  for (size_t run_start = 0; run_start < count;) {
+    bool is_cjk = IsCJKIdeograph(codepoints[run_start]);
+    size_t run_end = run_start + 1;
+    while (run_end < count && IsCJKIdeograph(codepoints[run_end]) == is_cjk) {
+      ++run_end;
+    }
+
+    int size = is_cjk ? kanji_ngram_size : ascii_ngram_size;
+    if (size >= 0) {
+      auto window = static_cast<size_t>(size);
+      for (size_t i = run_start; i < run_end && i + window <= run_end; ++i) {
+        emit(i, window);
+      }
+    }
+    run_start = run_end;
+  }
+}
+
+// N-gram hash parameters (fixed so hashes can be stored and compared across processes)
+constexpr uint64_t kNgramHashBase = 0x9E3779B97F4A7C15ULL;        // Odd multiplier of the polynomial hash
+constexpr uint64_t kNgramHashLengthSalt = 0xC2B2AE3D27D4EB4FULL;  // Separates n-grams of different sizes
+constexpr uint64_t kFmixMultiplier1 = 0xFF51AFD7ED558CCDULL;
+constexpr uint64_t kFmixMultiplier2 = 0xC4CEB9FE1A85EC53ULL;
+constexpr int kFmixShift = 33;
+
+/**
+ * @brief MurmurHash3 64-bit finalizer (spreads polynomial hash bits)
+ */
+uint64_t Fmix64(uint64_t value) {
+  value ^= value >> kFmixShift;
+  value *= kFmixMultiplier1;
+  value ^= value >> kFmixShift;
+  value *= kFmixMultiplier2;
+  value ^= value >> kFmixShift;
+  return value;
+}
+
+/**
+ * @brief Finish the polynomial hash of an n-gram of `size` codepoints
+ */
+uint64_t FinishNgramHash(uint64_t polynomial, size_t size) {
+  return Fmix64(polynomial + static_cast<uint64_t>(size) * kNgramHashLengthSalt);
+}
+
+/**
+ * @brief Fill scratch.prefix_hashes and scratch.hash_powers for codepoints
+ *
+ * prefix_hashes[i] is the polynomial hash of the first i codepoints, so the
+ * hash of [start, start + size) is prefix[start + size] - prefix[start] * base^size.
+ */
+void BuildPrefixHashes(NgramScratch& scratch, size_t max_size) {
+  const std::vector<uint32_t>& codepoints = scratch.codepoints;
+  scratch.prefix_hashes.resize(codepoints.size() + 1);
+  scratch.prefix_hashes[0] = 0;
+  for (size_t i = 0; i < codepoints.size(); ++i) {
+    scratch.prefix_hashes[i + 1] = scratch.prefix_hashes[i] * kNgramHashBase + codepoints[i] + 1;
+  }
+
+  scratch.hash_powers.resize(max_size + 1);
+  scratch.hash_powers[0] = 1;
+  for (size_t i = 1; i <= max_size; ++i) {
+    scratch.hash_powers[i] = scratch.hash_powers[i - 1] * kNgramHashBase;
+  }
+}
+
+/**
+ * @brief Hash of the window [start, start + size) after BuildPrefixHashes
+ */
+uint64_t WindowHash(const NgramScratch& scratch, size_t start, size_t size) {
+  uint64_t polynomial =
+      scratch.prefix_hashes[start + size] - scratch.prefix_hashes[start] * scratch.hash_powers[size];
+  return FinishNgramHash(polynomial, size);
 }
 
 }  // namespace
 
+const std::vector<std::string_view>& GenerateHybridNgramViews(std::string_view text, int ascii_ngram_size,
+                                                              int kanji_ngram_size, NgramScratch& scratch) {
+  scratch.ngrams.clear();
+  std::string_view buffer = IndexCodepoints(text, scratch);
+  scratch.ngrams.reserve(scratch.codepoints.size());  // Estimate
+
+  ForEachHybridNgram(scratch.codepoints, ascii_ngram_size, kanji_ngram_size, [&](size_t start, size_t size) {
+    size_t begin = scratch.offsets[start];
+    scratch.ngrams.push_back(buffer.substr(begin, scratch.offsets[start + size] - begin));
+  });
+
+  return scratch.ngrams;
+}
+
+uint64_t HashNgram(std::string_view ngram) {
+  std::vector<uint32_t> codepoints;
+  DecodeCodepoints(ngram, codepoints);
+
+  uint64_t polynomial = 0;
+  for (uint32_t codepoint : codepoints) {
+    polynomial = polynomial * kNgramHashBase + codepoint + 1;
+  }
+  return FinishNgramHash(polynomial, codepoints.size());
+}
+
+void GenerateNgramHashes(std::string_view text, int n, NgramScratch& scratch, std::vector<uint64_t>& hashes) {
+  hashes.clear();
+  if (n <= 0) {
+    return;
+  }
+
+  DecodeCodepoints(text, scratch.codepoints);
+  size_t count = scratch.codepoints.size();
+  auto size = static_cast<size_t>(n);
+  if (count < size) {
+    return;
+  }
+
+  BuildPrefixHashes(scratch, size);
+  hashes.reserve(count - size + 1);
+  for (size_t i = 0; i + size <= count; ++i) {
+    hashes.push_back(WindowHash(scratch, i, size));
+  }
+}
+
+void GenerateHybridNgramHashes(std::string_view text, int ascii_ngram_size, int kanji_ngram_size,
+                               NgramScratch& scratch, std::vector<uint64_t>& hashes) {
+  hashes.clear();
+  DecodeCodepoints(text, scratch.codepoints);
+  BuildPrefixHashes(scratch, static_cast<size_t>(std::max({ascii_ngram_size, kanji_ngram_size, 0})));
+  hashes.reserve(scratch.codepoints.size());  // Estimate
+
+  ForEachHybridNgram(scratch.codepoints, ascii_ngram_size, kanji_ngram_size,
+                     [&](size_t start, size_t size) { hashes.push_back(WindowHash(scratch, start, size)); });
+}
+
 std::vector<std::string> GenerateHybridNgrams(const std::string& text, int ascii_ngram_size, int kanji_ngram_size) {
-  std::vector<std::string> ngrams;
+  NgramScratch scratch;
+  const auto& views = GenerateHybridNgramViews(text, ascii_ngram_size, kanji_ngram_size, scratch);
+  return {views.begin(), views.end()};
+}
+
+namespace {
+
+// Codepoint ranges a StreamingNormalizer may cut before
+constexpr uint32_t kFirstHiragana = 0x3041;
+constexpr uint32_t kLastHiragana = 0x3096;  // Excludes the sound marks and the digraph U+309F
+constexpr uint32_t kFirstKatakana = 0x30A1;
+constexpr uint32_t kLastKatakana = 0x30FA;  // Excludes the middle dot, prolonged sound mark and U+30FF
+constexpr uint32_t kFirstHangulSyllable = 0xAC00;
+constexpr uint32_t kLastHangulSyllable = 0xD7A3;
 
-  // Convert to codepoints for proper character-level processing
-  std::vector<uint32_t> codepoints = Utf8ToCodepoints(text);
+constexpr size_t kMaxUtf8SequenceBytes = 4;
 
-  if (codepoints.empty()) {
-    return ngrams;
+/**
+ * @brief Check if normalizing the text before a codepoint cannot depend on it or on what follows
+ *
+ * These codepoints are starters that stay starters after NFKC and width
+ * conversion, are never the second part of a composition, and are neither
+ * cased nor case-ignorable (so they end the final sigma context).
+ */
+bool IsStreamBoundary(uint32_t codepoint) {
+  if (codepoint <= kUnicodeMaxOneByte) {
+    return codepoint == ' ' || (codepoint >= '\t' && codepoint <= '\r') || (codepoint >= '0' && codepoint <= '9');
   }
+  return (codepoint >= kFirstHiragana && codepoint <= kLastHiragana) ||
+         (codepoint >= kFirstKatakana && codepoint <= kLastKatakana) ||
+         (codepoint >= kCjkMainStart && codepoint <= kCjkMainEnd) ||
+         (codepoint >= kCjkExtAStart && codepoint <= kCjkExtAEnd) ||
+         (codepoint >= kFirstHangulSyllable && codepoint <= kLastHangulSyllable);
+}
 
-  ngrams.reserve(codepoints.size());  // Estimate
+bool IsContinuationByte(char byte) {
+  return (static_cast<unsigned char>(byte) & ~kUtf8ContinuationMask) == kUtf8ContinuationPattern;
+}
 
-  for (size_t i = 0; i < codepoints.size(); ++i) {
-    uint32_t codepoint = codepoints[i];
-
-    if (IsCJKIdeograph(codepoint)) {
-      // CJK character: use kanji_ngram_size
-      if (i + kanji_ngram_size <= codepoints.size()) {
-        // Check if all next kanji_ngram_size characters are also CJK
-        bool all_cjk = true;
-        for (int j = 0; j < kanji_ngram_size; ++j) {
-          if (!IsCJKIdeograph(codepoints[i + j])) {
-            all_cjk = false;
-            break;
-          }
-        }
+}  // namespace
 
-        if (all_cjk) {
-          std::vector<uint32_t> ngram_codepoints;
-          ngram_codepoints.reserve(kanji_ngram_size);
-          for (int j = 0; j < kanji_ngram_size; ++j) {
-            ngram_codepoints.push_back(codepoints[i + j]);
-          }
-          ngrams.push_back(CodepointsToUtf8(ngram_codepoints));
-        }
+StreamingNormalizer::StreamingNormalizer(Normalizer normalizer, OutputListener listener, size_t max_pending)
+    : normalizer_(normalizer), listener_(std::move(listener)), max_pending_(max_pending) {}
+
+void StreamingNormalizer::Feed(std::string_view chunk) {
+  pending_.append(chunk);
+
+  // Search the new bytes for the last boundary. Lead and ASCII bytes always start a codepoint (or a
+  // replaced ill-formed sequence), so they can be decoded in any order.
+  size_t boundary = 0;
+  for (size_t pos = pending_.size(); pos > scanned_;) {
+    --pos;
+    if (IsContinuationByte(pending_[pos])) {
+      continue;
+    }
+    uint32_t codepoint = 0;
+    if (DecodeUtf8Char(pending_.data() + pos, pending_.size() - pos, codepoint) > 0 && IsStreamBoundary(codepoint)) {
+      boundary = pos;
+      break;
+    }
+  }
+  // A sequence cut off by the end of the chunk is searched again once the next chunk completes it
+  scanned_ = pending_.size() - std::min(pending_.size(), kMaxUtf8SequenceBytes - 1);
+
+  if (boundary == 0 && pending_.size() > max_pending_) {
+    // No boundary in sight: cut before the last codepoint, which may be incomplete
+    boundary = pending_.size() - 1;
+    while (boundary > 0 && IsContinuationByte(pending_[boundary])) {
+      --boundary;
+    }
+  }
+  if (boundary > 0) {
+    Flush(boundary);
+  }
+}
+
+void StreamingNormalizer::Finish() {
+  if (!pending_.empty()) {
+    Flush(pending_.size());
+  }
+  scanned_ = 0;
+}
+
+void StreamingNormalizer::Flush(size_t end) {
+  normalizer_.Normalize(std::string_view(pending_).substr(0, end), output_);
+  if (!output_.empty()) {
+    listener_(output_);
+  }
+  pending_.erase(0, end);
+  scanned_ = scanned_ > end ? scanned_ - end : 0;
+}
+
+StreamingNgramGenerator::StreamingNgramGenerator(int n, NgramListener listener)
+    : hybrid_(false), ascii_ngram_size_(n), kanji_ngram_size_(n), listener_(std::move(listener)) {}
+
+StreamingNgramGenerator::StreamingNgramGenerator(int ascii_ngram_size, int kanji_ngram_size, NgramListener listener)
+    : hybrid_(true),
+      ascii_ngram_size_(ascii_ngram_size),
+      kanji_ngram_size_(kanji_ngram_size),
+      listener_(std::move(listener)) {}
+
+void StreamingNgramGenerator::Feed(std::string_view chunk) {
+  pending_.append(chunk);
+  Decode(false);
+  EmitDecided(false);
+}
+
+void StreamingNgramGenerator::Finish() {
+  Decode(true);
+  EmitDecided(true);
+  pending_.clear();
+  text_.clear();
+  codepoints_.clear();
+  offsets_.clear();
+  cjk_.clear();
+}
+
+void StreamingNgramGenerator::Decode(bool at_end) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(pending_.data());
+  size_t i = 0;
+  while (i < pending_.size()) {
+    if (bytes[i] < kUtf8OneByteMask) {
+      size_t run = AsciiRunLength(pending_.data() + i, pending_.size() - i);
+      for (size_t end = i + run; i < end; ++i) {
+        offsets_.push_back(text_.size());
+        text_ += pending_[i];
+        codepoints_.push_back(bytes[i]);
+        cjk_.push_back(false);
+      }
+      continue;
+    }
+
+    uint32_t codepoint = 0;
+    bool well_formed = true;
+    int char_len = DecodeCodepoint(pending_, i, codepoint, well_formed);
+    if (char_len == 0) {
+      if (!at_end) {
+        break;  // The next chunk may complete the sequence
       }
+      ++i;  // Incomplete at the end of the document: dropped, as by Utf8ToCodepoints
+      continue;
+    }
+
+    // Same bytes the whole-text functions give the code point (re-encoded if ill-formed)
+    offsets_.push_back(text_.size());
+    if (well_formed) {
+      text_.append(pending_, i, char_len);
     } else {
-      // Non-CJK character: use ascii_ngram_size
-      if (i + ascii_ngram_size <= codepoints.size()) {
-        // Check if all next ascii_ngram_size characters are also non-CJK
-        bool all_non_cjk = true;
-        for (int j = 0; j < ascii_ngram_size; ++j) {
-          if (IsCJKIdeograph(codepoints[i + j])) {
-            all_non_cjk = false;
-            break;
-          }
-        }
+      AppendUtf8(codepoint, text_);
+    }
+    codepoints_.push_back(codepoint);
+    cjk_.push_back(hybrid_ && IsCJKIdeograph(codepoint));
+    i += char_len;
+  }
+  pending_.erase(0, i);
+}
 
-        if (all_non_cjk) {
-          std::vector<uint32_t> ngram_codepoints;
-          ngram_codepoints.reserve(ascii_ngram_size);
-          for (int j = 0; j < ascii_ngram_size; ++j) {
-            ngram_codepoints.push_back(codepoints[i + j]);
-          }
-          ngrams.push_back(CodepointsToUtf8(ngram_codepoints));
-        }
+void StreamingNgramGenerator::EmitDecided(bool at_end) {
+  size_t count = codepoints_.size();
+  size_t start = 0;
+  for (; start < count; ++start) {
+    bool is_cjk = cjk_[start];
+    int size = is_cjk ? kanji_ngram_size_ : ascii_ngram_size_;
+    if (size < 0 || (size == 0 && !hybrid_)) {
+      continue;  // No n-gram starts here
+    }
+
+    auto window = static_cast<size_t>(size);
+    size_t known_end = std::min(start + window, count);
+    bool same_kind = true;
+    for (size_t j = start + 1; same_kind && j < known_end; ++j) {
+      same_kind = cjk_[j] == is_cjk;
+    }
+    if (!same_kind) {
+      continue;  // Crosses into a run of the other kind
+    }
+    if (start + window > count) {
+      if (at_end) {
+        continue;  // Runs past the end of the document
       }
+      break;  // Decided by the next chunk
     }
+
+    size_t begin = offsets_[start];
+    size_t end = start + window < count ? offsets_[start + window] : text_.size();
+    listener_(std::string_view(text_).substr(begin, end - begin));
   }
 
-  return ngrams;
+  // Drop the code points no undecided n-gram starts at or covers
+  if (start > 0) {
+    size_t dropped_bytes = start < count ? offsets_[start] : text_.size();
+    text_.erase(0, dropped_bytes);
+    codepoints_.erase(codepoints_.begin(), codepoints_.begin() + static_cast<std::ptrdiff_t>(start));
+    cjk_.erase(cjk_.begin(), cjk_.begin() + static_cast<std::ptrdiff_t>(start));
+    offsets_.erase(offsets_.begin(), offsets_.begin() + static_cast<std::ptrdiff_t>(start));
+    for (size_t& offset : offsets_) {
+      offset -= dropped_bytes;
+    }
+  }
 }
 
 std::string FormatBytes(size_t bytes) {
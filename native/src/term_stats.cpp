@@ -0,0 +1,199 @@
+/**
+ * @file term_stats.cpp
+ * @brief Per-table term frequency cache for selectivity-driven term ordering
+ */
+
+#include "term_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include "search_expression.h"
+
+namespace mygramdb::client {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Statistics of one term
+ */
+struct TermEntry {
+  uint64_t documents = 0;   // Matching documents (exact or estimated)
+  bool exact = false;       // From COUNT (true) or DEBUG candidates (false)
+  Clock::time_point taken;  // When the statistics were recorded
+};
+
+using TableTerms = std::unordered_map<std::string, TermEntry>;
+
+}  // namespace
+
+/**
+ * @brief PIMPL implementation class
+ */
+class TermStatsCache::Impl {
+ public:
+  explicit Impl(const TermStatsConfig& config) : config_(config) {}
+
+  void Record(const std::string& table, const std::string& term, uint64_t documents, bool exact) {
+    auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& terms = tables_[table];
+
+    auto found = terms.find(term);
+    if (found != terms.end()) {
+      // Estimates never override a fresh exact count
+      if (!exact && found->second.exact && IsFresh(found->second, now)) {
+        return;
+      }
+      found->second = TermEntry{documents, exact, now};
+      return;
+    }
+
+    if (config_.max_terms_per_table == 0) {
+      return;
+    }
+    if (terms.size() >= config_.max_terms_per_table) {
+      auto oldest = std::min_element(terms.begin(), terms.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.taken < rhs.second.taken;
+      });
+      terms.erase(oldest);
+    }
+    terms.emplace(term, TermEntry{documents, exact, now});
+  }
+
+  [[nodiscard]] std::optional<uint64_t> Lookup(const std::string& table, const std::string& term) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return LookupLocked(table, term, Clock::now());
+  }
+
+  bool Reorder(const std::string& table, std::string& main_term, std::vector<std::string>& and_terms) const {
+    if (and_terms.empty()) {
+      return false;
+    }
+
+    // Rank every positive term; unknown terms rank last
+    std::vector<std::pair<uint64_t, std::string*>> ranked;
+    ranked.reserve(and_terms.size() + 1);
+    {
+      auto now = Clock::now();
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto documents = LookupLocked(table, main_term, now);
+      ranked.emplace_back(documents.value_or(std::numeric_limits<uint64_t>::max()), &main_term);
+      for (auto& term : and_terms) {
+        documents = LookupLocked(table, term, now);
+        ranked.emplace_back(documents.value_or(std::numeric_limits<uint64_t>::max()), &term);
+      }
+    }
+    std::stable_sort(ranked.begin(), ranked.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    if (ranked.front().second == &main_term) {
+      return false;
+    }
+
+    std::vector<std::string> ordered;
+    ordered.reserve(ranked.size());
+    for (auto& [documents, term] : ranked) {
+      ordered.push_back(std::move(*term));
+    }
+    main_term = std::move(ordered.front());
+    and_terms.assign(std::make_move_iterator(ordered.begin() + 1), std::make_move_iterator(ordered.end()));
+    reorders_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  [[nodiscard]] TermStatsCacheStats GetStats() const {
+    TermStatsCacheStats stats;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& [table, terms] : tables_) {
+        stats.entries += terms.size();
+      }
+    }
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.reorders = reorders_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tables_.clear();
+  }
+
+ private:
+  [[nodiscard]] bool IsFresh(const TermEntry& entry, Clock::time_point now) const {
+    return config_.max_age_ms == 0 || now - entry.taken <= std::chrono::milliseconds(config_.max_age_ms);
+  }
+
+  std::optional<uint64_t> LookupLocked(const std::string& table, const std::string& term,
+                                       Clock::time_point now) const {
+    auto table_iter = tables_.find(table);
+    if (table_iter != tables_.end()) {
+      auto term_iter = table_iter->second.find(term);
+      if (term_iter != table_iter->second.end() && IsFresh(term_iter->second, now)) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return term_iter->second.documents;
+      }
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  TermStatsConfig config_;
+  mutable std::mutex mutex_;                            // Guards tables_
+  std::unordered_map<std::string, TableTerms> tables_;  // Table → term statistics
+  mutable std::atomic<uint64_t> hits_{0};
+  mutable std::atomic<uint64_t> misses_{0};
+  mutable std::atomic<uint64_t> reorders_{0};
+};
+
+// TermStatsCache public interface implementation
+
+TermStatsCache::TermStatsCache(TermStatsConfig config) : impl_(std::make_unique<Impl>(config)) {}
+
+TermStatsCache::~TermStatsCache() = default;
+
+void TermStatsCache::RecordCount(const std::string& table, const std::string& term, uint64_t count) {
+  impl_->Record(table, term, count, true);
+}
+
+void TermStatsCache::RecordCandidates(const std::string& table, const std::string& term, uint64_t candidates) {
+  impl_->Record(table, term, candidates, false);
+}
+
+std::optional<uint64_t> TermStatsCache::Lookup(const std::string& table, const std::string& term) const {
+  return impl_->Lookup(table, term);
+}
+
+bool TermStatsCache::Reorder(const std::string& table, std::string& main_term,
+                             std::vector<std::string>& and_terms) const {
+  return impl_->Reorder(table, main_term, and_terms);
+}
+
+TermStatsCacheStats TermStatsCache::GetStats() const {
+  return impl_->GetStats();
+}
+
+void TermStatsCache::Clear() {
+  impl_->Clear();
+}
+
+bool SimplifySearchExpression(const std::string& expression, const std::string& table, const TermStatsCache& stats,
+                              std::string& main_term, std::vector<std::string>& and_terms,
+                              std::vector<std::string>& not_terms) {
+  if (!SimplifySearchExpression(expression, main_term, and_terms, not_terms)) {
+    return false;
+  }
+  stats.Reorder(table, main_term, and_terms);
+  return true;
+}
+
+}  // namespace mygramdb::client
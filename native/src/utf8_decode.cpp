@@ -0,0 +1,331 @@
+/**
+ * @file utf8_decode.cpp
+ * @brief UTF-8 validation and decoding with a SIMD fast path for ASCII runs
+ */
+
+#include "utf8_decode.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MYGRAMDB_UTF8_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define MYGRAMDB_UTF8_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+namespace mygramdb::utils {
+
+namespace {
+
+constexpr unsigned char kAsciiLimit = 0x80;               // First non-ASCII byte
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;     // High bit of each byte in a word
+constexpr size_t kWordBytes = sizeof(uint64_t);           // Scalar scan step
+[[maybe_unused]] constexpr size_t kSse2Bytes = 16;        // SSE2 scan step
+[[maybe_unused]] constexpr size_t kAvx2Bytes = 32;        // AVX2 scan step
+
+// Lead byte ranges of well-formed sequences (Unicode Table 3-7)
+constexpr unsigned char kMinTwoByteLead = 0xC2;     // 0xC0 and 0xC1 only start overlong forms
+constexpr unsigned char kMinThreeByteLead = 0xE0;
+constexpr unsigned char kMinFourByteLead = 0xF0;
+constexpr unsigned char kMaxFourByteLead = 0xF4;    // Above starts code points > U+10FFFF
+constexpr unsigned char kSurrogateLead = 0xED;      // Second byte limited to exclude surrogates
+
+// Continuation byte range and the narrower second-byte ranges after some leads
+constexpr unsigned char kMinContinuation = 0x80;
+constexpr unsigned char kMaxContinuation = 0xBF;
+constexpr unsigned char kMinAfterE0 = 0xA0;         // Excludes overlong 3-byte forms
+constexpr unsigned char kMaxAfterED = 0x9F;         // Excludes surrogates
+constexpr unsigned char kMinAfterF0 = 0x90;         // Excludes overlong 4-byte forms
+constexpr unsigned char kMaxAfterF4 = 0x8F;         // Excludes code points > U+10FFFF
+
+// Payload masks and shift
+constexpr uint32_t kContinuationBits = 0x3F;
+constexpr uint32_t kTwoByteLeadBits = 0x1F;
+constexpr uint32_t kThreeByteLeadBits = 0x0F;
+constexpr uint32_t kFourByteLeadBits = 0x07;
+constexpr int kShift6 = 6;
+constexpr uint32_t kReplacementCharacter = 0xFFFD;
+
+/**
+ * @brief Scan 8 bytes per step with integer operations
+ */
+size_t AsciiPrefixScalar(const char* data, size_t size) {
+  size_t i = 0;
+  for (; i + kWordBytes <= size; i += kWordBytes) {
+    uint64_t word = 0;
+    std::memcpy(&word, data + i, kWordBytes);
+    if ((word & kHighBits) != 0) {
+      break;
+    }
+  }
+  while (i < size && static_cast<unsigned char>(data[i]) < kAsciiLimit) {
+    ++i;
+  }
+  return i;
+}
+
+#ifdef MYGRAMDB_UTF8_SSE2
+/**
+ * @brief Scan 16 bytes per step (SSE2 is part of every x86-64 CPU)
+ */
+size_t AsciiPrefixSse2(const char* data, size_t size) {
+  size_t i = 0;
+  for (; i + kSse2Bytes <= size; i += kSse2Bytes) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    auto mask = static_cast<unsigned int>(_mm_movemask_epi8(chunk));
+    if (mask != 0) {
+      while ((mask & 1U) == 0) {
+        mask >>= 1U;
+        ++i;
+      }
+      return i;
+    }
+  }
+  return i + AsciiPrefixScalar(data + i, size - i);
+}
+#endif
+
+#ifdef MYGRAMDB_UTF8_AVX2
+/**
+ * @brief Scan 32 bytes per step (only called when the CPU supports AVX2)
+ */
+__attribute__((target("avx2"))) size_t AsciiPrefixAvx2(const char* data, size_t size) {
+  size_t i = 0;
+  for (; i + kAvx2Bytes <= size; i += kAvx2Bytes) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(chunk));
+    if (mask != 0) {
+      return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+  }
+  return i + AsciiPrefixSse2(data + i, size - i);
+}
+#endif
+
+using AsciiScanFn = size_t (*)(const char*, size_t);
+
+/**
+ * @brief Scanner for this CPU
+ */
+struct AsciiScanner {
+  AsciiScanFn scan;
+  const char* name;
+};
+
+AsciiScanner SelectScanner() {
+#ifdef MYGRAMDB_UTF8_AVX2
+  __builtin_cpu_init();  // Needed if the first call happens during static initialization
+  if (__builtin_cpu_supports("avx2") != 0) {
+    return {AsciiPrefixAvx2, "avx2"};
+  }
+#endif
+#ifdef MYGRAMDB_UTF8_SSE2
+  return {AsciiPrefixSse2, "sse2"};
+#else
+  return {AsciiPrefixScalar, "scalar"};
+#endif
+}
+
+size_t AsciiPrefixResolve(const char* data, size_t size);
+
+// Current scanner. Starts at the resolver, which installs the scanner for this CPU on first use; being
+// constant-initialized it is usable from other translation units' static initializers, and each call is a
+// plain pointer load instead of a function-local static guard.
+std::atomic<AsciiScanFn> ascii_scan{AsciiPrefixResolve};
+
+size_t AsciiPrefixResolve(const char* data, size_t size) {
+  AsciiScanFn scan = SelectScanner().scan;
+  ascii_scan.store(scan, std::memory_order_relaxed);
+  return scan(data, size);
+}
+
+/**
+ * @brief Length of the sequence a lead byte starts, and the range its second byte must be in
+ *
+ * @return 2-4, or 0 if the byte cannot start a multi-byte sequence
+ */
+int SequenceShape(unsigned char lead, unsigned char& second_min, unsigned char& second_max) {
+  second_min = kMinContinuation;
+  second_max = kMaxContinuation;
+  if (lead < kMinTwoByteLead || lead > kMaxFourByteLead) {
+    return 0;
+  }
+  if (lead < kMinThreeByteLead) {
+    return 2;
+  }
+  if (lead < kMinFourByteLead) {
+    if (lead == kMinThreeByteLead) {
+      second_min = kMinAfterE0;
+    } else if (lead == kSurrogateLead) {
+      second_max = kMaxAfterED;
+    }
+    return 3;
+  }
+  if (lead == kMinFourByteLead) {
+    second_min = kMinAfterF0;
+  } else if (lead == kMaxFourByteLead) {
+    second_max = kMaxAfterF4;
+  }
+  return 4;
+}
+
+/**
+ * @brief Number of bytes from the start of a multi-byte sequence that are valid so far
+ *
+ * Equals the sequence length for a well-formed sequence; otherwise it is the
+ * length of the maximal subpart (at least 1).
+ */
+int ValidPrefixLength(const unsigned char* bytes, size_t available, int& length) {
+  unsigned char second_min = 0;
+  unsigned char second_max = 0;
+  length = SequenceShape(bytes[0], second_min, second_max);
+  if (length == 0 || available < 2 || bytes[1] < second_min || bytes[1] > second_max) {
+    return 1;
+  }
+  int valid = 2;
+  while (valid < length && static_cast<size_t>(valid) < available && bytes[valid] >= kMinContinuation &&
+         bytes[valid] <= kMaxContinuation) {
+    ++valid;
+  }
+  return valid;
+}
+
+/**
+ * @brief Decode one multi-byte sequence strictly
+ *
+ * @return Bytes consumed, or 0 if the sequence is ill-formed or truncated
+ */
+int DecodeMultiByte(const unsigned char* bytes, size_t available, uint32_t& codepoint) {
+  int length = 0;
+  if (ValidPrefixLength(bytes, available, length) != length) {
+    return 0;
+  }
+
+  static constexpr uint32_t kLeadBits[] = {0, 0, kTwoByteLeadBits, kThreeByteLeadBits, kFourByteLeadBits};
+  codepoint = bytes[0] & kLeadBits[length];
+  for (int i = 1; i < length; ++i) {
+    codepoint = (codepoint << kShift6) | (bytes[i] & kContinuationBits);
+  }
+  return length;
+}
+
+/**
+ * @brief Walk well-formed UTF-8, reporting ASCII runs and multi-byte codepoints
+ *
+ * Calls on_ascii(begin, length) for every ASCII run and on_codepoint(offset,
+ * codepoint) for every multi-byte codepoint, in text order.
+ *
+ * @return True if text is well-formed; otherwise error_offset (if given) is set
+ */
+template <typename OnAscii, typename OnCodepoint>
+bool WalkUtf8(std::string_view text, size_t* error_offset, OnAscii&& on_ascii, OnCodepoint&& on_codepoint) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  for (size_t i = 0; i < text.size();) {
+    if (bytes[i] < kAsciiLimit) {
+      size_t run = AsciiRunLength(text.data() + i, text.size() - i);
+      on_ascii(i, run);
+      i += run;
+      continue;
+    }
+
+    uint32_t codepoint = 0;
+    int length = DecodeMultiByte(bytes + i, text.size() - i, codepoint);
+    if (length == 0) {
+      if (error_offset != nullptr) {
+        *error_offset = i;
+      }
+      return false;
+    }
+    on_codepoint(i, codepoint);
+    i += length;
+  }
+  return true;
+}
+
+}  // namespace
+
+size_t AsciiPrefixLength(const char* data, size_t size) {
+  return ascii_scan.load(std::memory_order_relaxed)(data, size);
+}
+
+const char* Utf8ScanLevel() {
+  return SelectScanner().name;
+}
+
+int DecodeUtf8Char(const char* data, size_t size, uint32_t& codepoint) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  if (bytes[0] < kAsciiLimit) {
+    codepoint = bytes[0];
+    return 1;
+  }
+  return DecodeMultiByte(bytes, size, codepoint);
+}
+
+bool ValidateUtf8(std::string_view text, size_t* error_offset) {
+  return WalkUtf8(
+      text, error_offset, [](size_t, size_t) {}, [](size_t, uint32_t) {});
+}
+
+bool DecodeUtf8(std::string_view text, std::vector<uint32_t>& codepoints, size_t* error_offset) {
+  codepoints.clear();
+  codepoints.reserve(text.size());  // Over-allocate for ASCII
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  return WalkUtf8(
+      text, error_offset,
+      [&](size_t begin, size_t length) {
+        if (length == 1) {
+          codepoints.push_back(bytes[begin]);
+        } else {
+          codepoints.insert(codepoints.end(), bytes + begin, bytes + begin + length);
+        }
+      },
+      [&](size_t, uint32_t codepoint) { codepoints.push_back(codepoint); });
+}
+
+void DecodeUtf8Replacing(std::string_view text, std::vector<uint32_t>& codepoints) {
+  codepoints.clear();
+  codepoints.reserve(text.size());  // Over-allocate for ASCII
+  const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+  for (size_t i = 0; i < text.size();) {
+    if (bytes[i] < kAsciiLimit) {
+      size_t run = AsciiRunLength(text.data() + i, text.size() - i);
+      codepoints.insert(codepoints.end(), bytes + i, bytes + i + run);
+      i += run;
+      continue;
+    }
+
+    uint32_t codepoint = 0;
+    int length = DecodeMultiByte(bytes + i, text.size() - i, codepoint);
+    if (length == 0) {
+      int sequence_length = 0;
+      codepoints.push_back(kReplacementCharacter);
+      i += ValidPrefixLength(bytes + i, text.size() - i, sequence_length);
+      continue;
+    }
+    codepoints.push_back(codepoint);
+    i += length;
+  }
+}
+
+bool Utf8Boundaries(std::string_view text, std::vector<size_t>& offsets, size_t* error_offset) {
+  offsets.clear();
+  offsets.reserve(text.size() + 1);
+  bool ok = WalkUtf8(
+      text, error_offset,
+      [&](size_t begin, size_t length) {
+        for (size_t i = begin; i < begin + length; ++i) {
+          offsets.push_back(i);
+        }
+      },
+      [&](size_t offset, uint32_t) { offsets.push_back(offset); });
+  if (ok) {
+    offsets.push_back(text.size());
+  }
+  return ok;
+}
+
+}  // namespace mygramdb::utils
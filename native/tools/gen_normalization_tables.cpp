@@ -0,0 +1,297 @@
+/**
+ * @file gen_normalization_tables.cpp
+ * @brief Generate native/src/normalization_tables.inc from ICU
+ *
+ * The built-in normalizer (builtin_normalizer.cpp) replays NFKC, the width
+ * transliterators and root-locale lowercasing from tables this tool extracts
+ * from the ICU it is linked with. The JavaScript width conversion
+ * (src/normalization-tables.ts) uses the same width tables, so both
+ * implementations normalize alike. Only regenerating the tables needs ICU:
+ *
+ *   g++ -std=c++17 native/tools/gen_normalization_tables.cpp -licuuc -licui18n -o gen_normalization_tables
+ *   ./gen_normalization_tables > native/src/normalization_tables.inc
+ *   ./gen_normalization_tables --typescript > src/normalization-tables.ts
+ */
+
+#include <unicode/locid.h>
+#include <unicode/normalizer2.h>
+#include <unicode/translit.h>
+#include <unicode/uchar.h>
+#include <unicode/unistr.h>
+#include <unicode/uvernum.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr UChar32 kMaxCodepoint = 0x10FFFF;
+
+// Precomposed Hangul syllables, decomposed and composed arithmetically by the normalizer
+constexpr UChar32 kFirstHangulSyllable = 0xAC00;
+constexpr UChar32 kLastHangulSyllable = 0xD7A3;
+
+// Half-width katakana, and the half-width (semi-)voiced sound marks that Halfwidth-Fullwidth composes with them
+constexpr UChar32 kFirstHalfwidthKatakana = 0xFF61;
+constexpr UChar32 kLastHalfwidthKatakana = 0xFF9F;
+constexpr UChar32 kHalfwidthSoundMarks[] = {0xFF9E, 0xFF9F};
+
+// Entries per output line
+constexpr size_t kMappingsPerLine = 4;
+constexpr size_t kPoolCodepointsPerLine = 8;
+constexpr size_t kCompositionsPerLine = 4;
+constexpr size_t kRangesPerLine = 5;
+constexpr size_t kClassRangesPerLine = 4;
+
+struct Entry {
+  UChar32 codepoint;
+  std::vector<UChar32> mapped;
+};
+
+struct Composition {
+  UChar32 first;
+  UChar32 second;
+  UChar32 composed;
+};
+
+std::vector<UChar32> ToCodepoints(const icu::UnicodeString& text) {
+  std::vector<UChar32> out;
+  for (int32_t i = 0; i < text.length(); i += U16_LENGTH(text.char32At(i))) {
+    out.push_back(text.char32At(i));
+  }
+  return out;
+}
+
+icu::UnicodeString Transliterate(icu::Transliterator& transliterator, icu::UnicodeString text) {
+  transliterator.transliterate(text);
+  return text;
+}
+
+bool IsSurrogate(UChar32 codepoint) { return codepoint >= 0xD800 && codepoint <= 0xDFFF; }
+
+bool IsHangulSyllable(UChar32 codepoint) {
+  return codepoint >= kFirstHangulSyllable && codepoint <= kLastHangulSyllable;
+}
+
+/**
+ * @brief Start an output line every per_line entries
+ */
+void Separate(size_t index, size_t per_line) { std::printf(index % per_line == 0 ? "\n    " : " "); }
+
+/**
+ * @brief Print a sorted mapping table as entries plus a pool of the codepoints they map to
+ */
+void PrintMap(const char* name, const std::vector<Entry>& entries) {
+  std::vector<UChar32> pool;
+  std::printf("constexpr NormalizationMapping k%sMappings[] = {", name);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    Separate(i, kMappingsPerLine);
+    std::printf("{0x%04X, %zu, %zu},", static_cast<unsigned>(entries[i].codepoint), pool.size(),
+                entries[i].mapped.size());
+    pool.insert(pool.end(), entries[i].mapped.begin(), entries[i].mapped.end());
+  }
+  std::printf("\n};\n\nconstexpr uint32_t k%sPool[] = {", name);
+  for (size_t i = 0; i < pool.size(); ++i) {
+    Separate(i, kPoolCodepointsPerLine);
+    std::printf("0x%04X,", static_cast<unsigned>(pool[i]));
+  }
+  std::printf("\n};\n\n");
+}
+
+/**
+ * @brief Print a composition table sorted by (first, second)
+ */
+void PrintCompositions(const char* name, const std::vector<Composition>& compositions) {
+  std::printf("constexpr Composition k%sCompositions[] = {", name);
+  for (size_t i = 0; i < compositions.size(); ++i) {
+    Separate(i, kCompositionsPerLine);
+    std::printf("{0x%04X, 0x%04X, 0x%04X},", static_cast<unsigned>(compositions[i].first),
+                static_cast<unsigned>(compositions[i].second), static_cast<unsigned>(compositions[i].composed));
+  }
+  std::printf("\n};\n\n");
+}
+
+/**
+ * @brief Print the ranges of codepoints with a binary property
+ */
+void PrintRanges(const char* name, UProperty property) {
+  std::printf("constexpr CodepointRange k%sRanges[] = {", name);
+  size_t count = 0;
+  for (UChar32 codepoint = 0; codepoint <= kMaxCodepoint; ++codepoint) {
+    if (u_hasBinaryProperty(codepoint, property) == 0) {
+      continue;
+    }
+    UChar32 last = codepoint;
+    while (last < kMaxCodepoint && u_hasBinaryProperty(last + 1, property) != 0) {
+      ++last;
+    }
+    Separate(count++, kRangesPerLine);
+    std::printf("{0x%04X, 0x%04X},", static_cast<unsigned>(codepoint), static_cast<unsigned>(last));
+    codepoint = last;
+  }
+  std::printf("\n};\n\n");
+}
+
+/**
+ * @brief Print the ranges of codepoints with the same non-zero canonical combining class
+ */
+void PrintCombiningClasses() {
+  std::printf("constexpr CombiningClassRange kCombiningClassRanges[] = {");
+  size_t count = 0;
+  for (UChar32 codepoint = 0; codepoint <= kMaxCodepoint; ++codepoint) {
+    uint8_t combining_class = u_getCombiningClass(codepoint);
+    if (combining_class == 0) {
+      continue;
+    }
+    UChar32 last = codepoint;
+    while (last < kMaxCodepoint && u_getCombiningClass(last + 1) == combining_class) {
+      ++last;
+    }
+    Separate(count++, kClassRangesPerLine);
+    std::printf("{0x%04X, 0x%04X, %u},", static_cast<unsigned>(codepoint), static_cast<unsigned>(last),
+                static_cast<unsigned>(combining_class));
+    codepoint = last;
+  }
+  std::printf("\n};\n\n");
+}
+
+/**
+ * @brief Print a codepoint as a TypeScript string escape
+ */
+void PrintEscaped(UChar32 codepoint) {
+  std::printf(codepoint > 0xFFFF ? "\\u{%x}" : "\\u%04x", static_cast<unsigned>(codepoint));
+}
+
+/**
+ * @brief Print a mapping table as TypeScript [codepoint, mapped text] pairs
+ */
+void PrintTypeScriptMap(const char* name, const std::vector<Entry>& entries) {
+  std::printf("export const %s_MAPPINGS: ReadonlyArray<readonly [number, string]> = [\n", name);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    std::printf("  [0x%04x, '", static_cast<unsigned>(entries[i].codepoint));
+    for (UChar32 mapped : entries[i].mapped) {
+      PrintEscaped(mapped);
+    }
+    std::printf("']%s\n", i + 1 < entries.size() ? "," : "");
+  }
+  std::printf("];\n");
+}
+
+/**
+ * @brief Print a composition table as TypeScript [first, second, composed] triples
+ */
+void PrintTypeScriptCompositions(const char* name, const std::vector<Composition>& compositions) {
+  std::printf("export const %s_COMPOSITIONS: ReadonlyArray<readonly [number, number, number]> = [\n", name);
+  for (size_t i = 0; i < compositions.size(); ++i) {
+    std::printf("  [0x%04x, 0x%04x, 0x%04x]%s\n", static_cast<unsigned>(compositions[i].first),
+                static_cast<unsigned>(compositions[i].second), static_cast<unsigned>(compositions[i].composed),
+                i + 1 < compositions.size() ? "," : "");
+  }
+  std::printf("];\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool typescript = argc > 1 && std::strcmp(argv[1], "--typescript") == 0;
+
+  UErrorCode status = U_ZERO_ERROR;
+  const icu::Normalizer2* nfkd = icu::Normalizer2::getNFKDInstance(status);
+  const icu::Normalizer2* nfc = icu::Normalizer2::getNFCInstance(status);
+  std::unique_ptr<icu::Transliterator> narrow(
+      icu::Transliterator::createInstance("Fullwidth-Halfwidth", UTRANS_FORWARD, status));
+  std::unique_ptr<icu::Transliterator> wide(
+      icu::Transliterator::createInstance("Halfwidth-Fullwidth", UTRANS_FORWARD, status));
+  if (U_FAILURE(status)) {
+    std::fprintf(stderr, "ICU initialization failed: %s\n", u_errorName(status));
+    return 1;
+  }
+
+  std::vector<Entry> nfkd_entries;
+  std::vector<Entry> narrow_entries;
+  std::vector<Entry> wide_entries;
+  std::vector<Entry> lower_entries;
+  std::vector<Composition> canonical_compositions;
+  for (UChar32 codepoint = 0; codepoint <= kMaxCodepoint; ++codepoint) {
+    if (IsSurrogate(codepoint)) {
+      continue;
+    }
+    icu::UnicodeString source(codepoint);
+    icu::UnicodeString decomposed = nfkd->normalize(source, status);
+    if (decomposed != source && !IsHangulSyllable(codepoint)) {
+      nfkd_entries.push_back({codepoint, ToCodepoints(decomposed)});
+    }
+    // Primary composites: two-codepoint canonical decompositions that compose back (not excluded)
+    icu::UnicodeString raw;
+    if (!IsHangulSyllable(codepoint) && nfc->getRawDecomposition(codepoint, raw) && raw.countChar32() == 2) {
+      UChar32 first = raw.char32At(0);
+      UChar32 second = raw.char32At(U16_LENGTH(first));
+      if (nfc->composePair(first, second) == codepoint) {
+        canonical_compositions.push_back({first, second, codepoint});
+      }
+    }
+    icu::UnicodeString narrowed = Transliterate(*narrow, source);
+    if (narrowed != source) {
+      narrow_entries.push_back({codepoint, ToCodepoints(narrowed)});
+    }
+    icu::UnicodeString widened = Transliterate(*wide, source);
+    if (widened != source) {
+      wide_entries.push_back({codepoint, ToCodepoints(widened)});
+    }
+    icu::UnicodeString lowered = source;
+    lowered.toLower(icu::Locale::getRoot());
+    if (lowered != source) {
+      lower_entries.push_back({codepoint, ToCodepoints(lowered)});
+    }
+  }
+  if (U_FAILURE(status)) {
+    std::fprintf(stderr, "ICU normalization failed: %s\n", u_errorName(status));
+    return 1;
+  }
+  std::sort(canonical_compositions.begin(), canonical_compositions.end(),
+            [](const Composition& a, const Composition& b) {
+              return a.first != b.first ? a.first < b.first : a.second < b.second;
+            });
+
+  // Half-width kana followed by a half-width sound mark, which Halfwidth-Fullwidth turns into one voiced kana
+  std::vector<Composition> wide_compositions;
+  for (UChar32 base = kFirstHalfwidthKatakana; base <= kLastHalfwidthKatakana; ++base) {
+    for (UChar32 mark : kHalfwidthSoundMarks) {
+      icu::UnicodeString widened = Transliterate(*wide, icu::UnicodeString(base).append(mark));
+      if (widened.countChar32() == 1) {
+        wide_compositions.push_back({base, mark, widened.char32At(0)});
+      }
+    }
+  }
+
+  if (typescript) {
+    // Width tables only: JavaScript has NFKC and lowercasing built in
+    std::printf("// Generated by native/tools/gen_normalization_tables.cpp --typescript from ICU %s (Unicode %s).\n",
+                U_ICU_VERSION, U_UNICODE_VERSION);
+    std::printf("// Do not edit.\n\n");
+    PrintTypeScriptMap("NARROW", narrow_entries);
+    std::printf("\n");
+    PrintTypeScriptMap("WIDE", wide_entries);
+    std::printf("\n");
+    PrintTypeScriptCompositions("WIDE", wide_compositions);
+    return 0;
+  }
+
+  std::printf("// Generated by native/tools/gen_normalization_tables.cpp from ICU %s (Unicode %s). Do not edit.\n",
+              U_ICU_VERSION, U_UNICODE_VERSION);
+  std::printf("// clang-format off\n\n");
+  PrintMap("Nfkd", nfkd_entries);
+  PrintCompositions("Canonical", canonical_compositions);
+  PrintCombiningClasses();
+  PrintMap("Narrow", narrow_entries);
+  PrintMap("Wide", wide_entries);
+  PrintCompositions("Wide", wide_compositions);
+  PrintMap("Lower", lower_entries);
+  PrintRanges("Cased", UCHAR_CASED);
+  PrintRanges("CaseIgnorable", UCHAR_CASE_IGNORABLE);
+  std::printf("// clang-format on\n");
+  return 0;
+}
@@ -0,0 +1,921 @@
+/**
+ * @file standin_server.cpp
+ * @brief MygramDB protocol stand-in server for benchmarks and tests
+ *
+ * Speaks the text protocol the clients use (SEARCH, COUNT, GET, INFO,
+ * CONFIG, DEBUG, REPLICATION, SAVE/LOAD) and answers SEARCH/COUNT from a
+ * LocalIndex, so every client path can be exercised and timed on one box
+ * without a MySQL-backed server. Data is synthetic (a skewed vocabulary, so
+ * terms range from rare to common) or loaded from TSV files
+ * ("pk<TAB>text[<TAB>key=value...]" per line). SAVE and LOAD are
+ * acknowledged without touching the disk.
+ *
+ * node-gyp builds it as the mygram_standin target (build/Release/mygram_standin), or:
+ *
+ *   g++ -std=c++17 -O2 -pthread -Inative/include native/tools/standin_server.cpp native/src/local_index.cpp \
+ *       native/src/query_analysis.cpp native/src/search_expression.cpp native/src/string_utils.cpp \
+ *       native/src/builtin_normalizer.cpp native/src/utf8_decode.cpp native/src/network_utils.cpp -o mygram_standin
+ *
+ *   ./mygram_standin --port 11016 --documents 100000 --latency-us 200
+ *
+ * The two clients read DEBUG output differently: the native client expects
+ * "DEBUG key=value ..." on the result line (--debug-style inline, the
+ * default), the JavaScript client a "# DEBUG" section of "key: value" lines
+ * (--debug-style section).
+ *
+ * --info-sections MS separates the INFO sections with blank lines and sends
+ * each section as its own write, MS milliseconds apart, so a reader that
+ * stops at the first blank line it has received can be caught.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "local_index.h"
+#include "network_utils.h"
+
+namespace {
+
+using mygramdb::client::CountResponse;
+using mygramdb::client::Error;
+using mygramdb::client::LocalIndex;
+using mygramdb::client::LocalIndexConfig;
+using mygramdb::client::SearchResponse;
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+constexpr uint16_t kDefaultPort = 11016;
+constexpr int kListenBacklog = 128;
+constexpr size_t kReadBufferSize = 64 * 1024;    // Bytes per recv()
+constexpr size_t kMaxPendingBytes = 1024 * 1024;  // Connection closed if a command grows past this
+constexpr int64_t kBaseTimestamp = 1700000000;     // created_at of the first synthetic document (epoch seconds)
+constexpr int64_t kTimestampStep = 60;             // Seconds between synthetic documents
+constexpr size_t kStatusValues = 3;                // Distinct synthetic status values
+constexpr size_t kCategoryValues = 8;              // Distinct synthetic category values
+constexpr double kMicrosecondsPerMillisecond = 1000.0;
+constexpr const char* kGtidSource = "3E11FA47-71CA-11E1-9E33-C80AA9429562";
+
+// Synthetic vocabulary; earlier words are drawn more often
+constexpr const char* kWords[] = {
+    "the",      "data",     "search",   "index",    "golang",   "python",   "東京",     "tutorial",
+    "guide",    "rust",     "database", "cluster",  "天気",     "ニュース", "release",  "memory",
+    "network",  "大阪",     "server",   "client",   "latency",  "cache",    "replica",  "機械学習",
+    "kernel",   "compiler", "parser",   "protocol", "京都",     "benchmark", "shard",   "vector",
+    "北海道",   "snapshot", "journal",  "tokenizer", "フィルタ", "throughput", "quantile", "zipf"};
+constexpr size_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief Command line options
+ */
+struct Options {
+  std::string host = "127.0.0.1";                          // Listen address
+  uint16_t port = kDefaultPort;                            // Listen port
+  std::vector<std::string> tables{"articles"};             // Tables filled with synthetic documents
+  size_t documents = 10000;                                // Synthetic documents per table
+  size_t words = 8;                                        // Words per synthetic document
+  size_t extra_fields = 0;                                 // Padding fields per synthetic document (f1, f2, ...)
+  size_t field_bytes = 16;                                 // Length of each padding field value
+  std::vector<std::pair<std::string, std::string>> loads;  // Tables loaded from TSV files (table, path)
+  uint32_t default_limit = 100;                            // Results when SEARCH has no LIMIT
+  uint32_t latency_us = 0;                                 // Delay before each reply batch
+  uint32_t jitter_us = 0;                                  // Extra uniform random delay, up to this
+  uint32_t seed = 1;                                       // Synthetic data and jitter seed
+  bool inline_debug = true;                                // DEBUG style (see file comment)
+  std::optional<uint32_t> info_sections_ms;                // Send INFO sections as segments this far apart
+  LocalIndexConfig index;                                  // N-gram sizes and normalization
+};
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+/**
+ * @brief One table: the index for SEARCH/COUNT and the fields for GET
+ */
+struct Table {
+  explicit Table(const LocalIndexConfig& config) : index(config) {}
+
+  LocalIndex index;
+  std::unordered_map<std::string, Fields> documents;  // Primary key → fields
+};
+
+/**
+ * @brief State shared by all connections (tables are read-only once serving)
+ */
+struct ServerState {
+  Options options;
+  std::map<std::string, std::unique_ptr<Table>> tables;
+  std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+  std::atomic<uint64_t> total_requests{0};
+  std::atomic<uint64_t> total_errors{0};
+  std::atomic<uint64_t> active_connections{0};
+  std::atomic<bool> replication_running{true};
+};
+
+/**
+ * @brief Parsed SEARCH/COUNT arguments
+ */
+struct QueryRequest {
+  const Table* table = nullptr;
+  std::string query;
+  std::vector<std::string> and_terms;
+  std::vector<std::string> not_terms;
+  Fields filters;
+  std::string sort_column;
+  bool sort_desc = true;
+  uint32_t limit = 0;
+  uint32_t offset = 0;
+};
+
+std::atomic<bool> g_stop{false};
+std::atomic<int> g_listen_fd{-1};
+
+void HandleStopSignal(int /*signal*/) {
+  g_stop = true;
+  // The signal may land on a connection thread; shutdown() wakes accept() in the main thread
+  int listen_fd = g_listen_fd.load();
+  if (listen_fd >= 0) {
+    shutdown(listen_fd, SHUT_RDWR);
+  }
+}
+
+std::string Upper(std::string_view text) {
+  std::string out(text);
+  std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return std::toupper(c); });
+  return out;
+}
+
+std::optional<uint64_t> ParseUnsigned(std::string_view text) {
+  if (text.empty() || text.size() > std::numeric_limits<uint64_t>::digits10) {
+    return std::nullopt;
+  }
+  uint64_t value = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      return std::nullopt;
+    }
+    value = value * 10 + static_cast<uint64_t>(c - '0');  // NOLINT(readability-magic-numbers)
+  }
+  return value;
+}
+
+/**
+ * @brief Split a command line into tokens
+ *
+ * Quoted tokens may contain spaces; a backslash escapes the next character
+ * (the inverse of the clients' query escaping).
+ */
+std::vector<std::string> Tokenize(std::string_view line) {
+  std::vector<std::string> tokens;
+  size_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) {
+      ++pos;
+    }
+    if (pos >= line.size()) {
+      break;
+    }
+
+    std::string token;
+    if (line[pos] == '"' || line[pos] == '\'') {
+      char quote = line[pos++];
+      while (pos < line.size() && line[pos] != quote) {
+        if (line[pos] == '\\' && pos + 1 < line.size()) {
+          ++pos;
+        }
+        token += line[pos++];
+      }
+      ++pos;  // Closing quote
+    } else {
+      while (pos < line.size() && line[pos] != ' ' && line[pos] != '\t') {
+        token += line[pos++];
+      }
+    }
+    tokens.push_back(std::move(token));
+  }
+  return tokens;
+}
+
+/**
+ * @brief Parse "SEARCH|COUNT <table> <query> [AND t] [NOT t] [FILTER k = v] [SORT [col] ASC|DESC] [LIMIT [o,]n]"
+ * @return Error message, or nullopt on success
+ */
+std::optional<std::string> ParseQueryRequest(const ServerState& state, const std::vector<std::string>& tokens,
+                                             bool search, QueryRequest& request) {
+  if (tokens.size() < 3) {
+    return "Usage: " + tokens[0] + " <table> <query> ...";
+  }
+  auto table = state.tables.find(tokens[1]);
+  if (table == state.tables.end()) {
+    return "Table not found: " + tokens[1];
+  }
+  request.table = table->second.get();
+  request.query = tokens[2];
+  request.limit = state.options.default_limit;
+
+  for (size_t i = 3; i < tokens.size(); ++i) {
+    std::string keyword = Upper(tokens[i]);
+    bool has_arg = i + 1 < tokens.size();
+    if ((keyword == "AND" || keyword == "NOT") && has_arg) {
+      (keyword == "AND" ? request.and_terms : request.not_terms).push_back(tokens[++i]);
+    } else if (keyword == "FILTER" && has_arg) {
+      // "FILTER key = value" as the clients send it, or "FILTER key=value"
+      std::string key = tokens[++i];
+      std::string value;
+      size_t equals = key.find('=');
+      if (equals != std::string::npos) {
+        value = key.substr(equals + 1);
+        key.resize(equals);
+      } else if (i + 2 < tokens.size() && tokens[i + 1] == "=") {
+        value = tokens[i + 2];
+        i += 2;
+      } else {
+        return "Invalid FILTER clause";
+      }
+      request.filters.emplace_back(std::move(key), std::move(value));
+    } else if (keyword == "SORT" && search && has_arg) {
+      std::string order = Upper(tokens[++i]);
+      if (order != "ASC" && order != "DESC") {
+        request.sort_column = tokens[i];
+        order = i + 1 < tokens.size() ? Upper(tokens[i + 1]) : "";
+        if (order == "ASC" || order == "DESC") {
+          ++i;
+        }
+      }
+      request.sort_desc = order != "ASC";
+    } else if (keyword == "LIMIT" && search && has_arg) {
+      const std::string& arg = tokens[++i];
+      size_t comma = arg.find(',');
+      auto limit = ParseUnsigned(comma == std::string::npos ? arg : std::string_view(arg).substr(comma + 1));
+      auto offset = comma == std::string::npos ? std::optional<uint64_t>(request.offset)
+                                               : ParseUnsigned(std::string_view(arg).substr(0, comma));
+      if (!limit || !offset || *limit > UINT32_MAX || *offset > UINT32_MAX) {
+        return "Invalid LIMIT clause";
+      }
+      request.limit = static_cast<uint32_t>(*limit);
+      request.offset = static_cast<uint32_t>(*offset);
+    } else if (keyword == "OFFSET" && search && has_arg) {
+      auto offset = ParseUnsigned(tokens[++i]);
+      if (!offset || *offset > UINT32_MAX) {
+        return "Invalid OFFSET clause";
+      }
+      request.offset = static_cast<uint32_t>(*offset);
+    } else {
+      return "Unexpected token: " + tokens[i];
+    }
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief Append debug output in the configured style
+ */
+void AppendDebug(const ServerState& state, const QueryRequest& request, double elapsed_ms, uint64_t candidates,
+                 uint64_t final_count, std::string& out) {
+  char query_time[32];  // NOLINT(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+  std::snprintf(query_time, sizeof(query_time), "%.3f", elapsed_ms);
+  size_t terms = 1 + request.and_terms.size() + request.not_terms.size();
+  std::pair<const char*, std::string> values[] = {
+      {"query_time", query_time},
+      {"index_time", query_time},
+      {"filter_time", "0.000"},
+      {"terms", std::to_string(terms)},
+      {"candidates", std::to_string(candidates)},
+      {"final", std::to_string(final_count)},
+      {"optimization", "standin"},
+  };
+
+  if (state.options.inline_debug) {
+    out += " DEBUG";
+    for (const auto& [key, value] : values) {
+      out.append(" ").append(key).append("=").append(value);
+    }
+    out += "\r\n";
+    return;
+  }
+  out += "\n# DEBUG\n";
+  for (const auto& [key, value] : values) {
+    bool is_time = std::strstr(key, "_time") != nullptr;
+    out.append(key).append(": ").append(value).append(is_time ? "ms\n" : "\n");
+  }
+  out += "\n";
+}
+
+void HandleSearch(ServerState& state, const std::vector<std::string>& tokens, bool debug, std::string& out) {
+  QueryRequest request;
+  if (auto err = ParseQueryRequest(state, tokens, true, request)) {
+    out.append("ERROR ").append(*err).append("\r\n");
+    ++state.total_errors;
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto result = request.table->index.Search(request.query, request.limit, request.offset, request.and_terms,
+                                            request.not_terms, request.filters, request.sort_column,
+                                            request.sort_desc);
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  if (auto* err = std::get_if<Error>(&result)) {
+    out.append("ERROR ").append(err->message).append("\r\n");
+    ++state.total_errors;
+    return;
+  }
+
+  const auto& response = std::get<SearchResponse>(result);
+  out.append("OK RESULTS ").append(std::to_string(response.total_count));
+  for (const auto& hit : response.results) {
+    out.append(" ").append(hit.primary_key);
+  }
+  if (debug) {
+    AppendDebug(state, request, elapsed.count() / kMicrosecondsPerMillisecond, response.total_count,
+                response.results.size(), out);
+  } else {
+    out += "\r\n";
+  }
+}
+
+void HandleCount(ServerState& state, const std::vector<std::string>& tokens, bool debug, std::string& out) {
+  QueryRequest request;
+  if (auto err = ParseQueryRequest(state, tokens, false, request)) {
+    out.append("ERROR ").append(*err).append("\r\n");
+    ++state.total_errors;
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto result = request.table->index.Count(request.query, request.and_terms, request.not_terms, request.filters);
+  std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  if (auto* err = std::get_if<Error>(&result)) {
+    out.append("ERROR ").append(err->message).append("\r\n");
+    ++state.total_errors;
+    return;
+  }
+
+  uint64_t count = std::get<CountResponse>(result).count;
+  out.append("OK COUNT ").append(std::to_string(count));
+  if (debug) {
+    AppendDebug(state, request, elapsed.count() / kMicrosecondsPerMillisecond, count, count, out);
+  } else {
+    out += "\r\n";
+  }
+}
+
+void HandleGet(ServerState& state, const std::vector<std::string>& tokens, std::string& out) {
+  if (tokens.size() != 3) {
+    out += "ERROR Usage: GET <table> <primary_key>\r\n";
+    ++state.total_errors;
+    return;
+  }
+  auto table = state.tables.find(tokens[1]);
+  if (table == state.tables.end()) {
+    out.append("ERROR Table not found: ").append(tokens[1]).append("\r\n");
+    ++state.total_errors;
+    return;
+  }
+  auto document = table->second->documents.find(tokens[2]);
+  if (document == table->second->documents.end()) {
+    out += "ERROR Document not found\r\n";
+    ++state.total_errors;
+    return;
+  }
+
+  out.append("OK DOC ").append(tokens[2]);
+  for (const auto& [key, value] : document->second) {
+    out.append(" ").append(key).append("=").append(value);
+  }
+  out += "\r\n";
+}
+
+/**
+ * @brief INFO as "key: value" lines (no blank line before the end, which the JavaScript client reads as the end)
+ *
+ * With --info-sections, sections are separated by blank lines and the offset
+ * of each section after the first is added to breaks.
+ */
+void HandleInfo(const ServerState& state, std::string& out, std::vector<size_t>& breaks) {
+  uint64_t doc_count = 0;
+  uint64_t index_bytes = 0;
+  std::string table_names;
+  for (const auto& [name, table] : state.tables) {
+    auto stats = table->index.GetStats();
+    doc_count += stats.documents;
+    index_bytes += stats.posting_bytes;
+    table_names.append(table_names.empty() ? "" : ",").append(name);
+  }
+  auto uptime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - state.started);
+
+  std::ostringstream server;
+  std::ostringstream stats;
+  std::ostringstream index;
+  std::ostringstream replication;
+  server << "# Server\n"
+         << "version: standin\n"
+         << "uptime_seconds: " << uptime.count() << "\n";
+  stats << "# Stats\n"
+        << "total_requests: " << state.total_requests.load() << "\n"
+        << "total_errors: " << state.total_errors.load() << "\n"
+        << "active_connections: " << state.active_connections.load() << "\n";
+  index << "# Index\n"
+        << "doc_count: " << doc_count << "\n"
+        << "index_size_bytes: " << index_bytes << "\n"
+        << "tables: " << table_names << "\n";
+  replication << "# Replication\n"
+              << "replication_status: " << (state.replication_running ? "running" : "stopped") << "\n";
+
+  bool sectioned = state.options.info_sections_ms.has_value();
+  out += "OK INFO\n";
+  for (const auto* section : {&server, &stats, &index, &replication}) {
+    if (sectioned && section != &server) {
+      breaks.push_back(out.size());
+    }
+    out.append(section->str()).append(sectioned ? "\n" : "");
+  }
+  out += sectioned ? "" : "\n";
+}
+
+void HandleConfig(const ServerState& state, std::string& out) {
+  std::ostringstream config;
+  config << "OK CONFIG\n"
+         << "tables:\n";
+  for (const auto& [name, table] : state.tables) {
+    config << "  - name: " << name << "\n"
+           << "    ngram_size: " << state.options.index.ascii_ngram_size << "\n"
+           << "    kanji_ngram_size: " << state.options.index.kanji_ngram_size << "\n";
+  }
+  config << "api:\n"
+         << "  tcp:\n"
+         << "    bind: " << state.options.host << "\n"
+         << "    port: " << state.options.port << "\n"
+         << "    default_limit: " << state.options.default_limit << "\n\n";
+  out += config.str();
+}
+
+void HandleReplication(ServerState& state, const std::vector<std::string>& tokens, std::string& out) {
+  std::string action = tokens.size() == 2 ? Upper(tokens[1]) : "";
+  if (action == "STATUS") {
+    uint64_t doc_count = 0;
+    for (const auto& [name, table] : state.tables) {
+      doc_count += table->documents.size();
+    }
+    out.append("OK REPLICATION status=")
+        .append(state.replication_running ? "running" : "stopped")
+        .append(" gtid=")
+        .append(kGtidSource)
+        .append(":1-")
+        .append(std::to_string(std::max<uint64_t>(doc_count, 1)))
+        .append("\r\n");
+  } else if (action == "STOP" || action == "START") {
+    state.replication_running = action == "START";
+    out.append("OK REPLICATION ").append(action == "START" ? "STARTED" : "STOPPED").append("\r\n");
+  } else {
+    out += "ERROR Usage: REPLICATION STATUS|STOP|START\r\n";
+    ++state.total_errors;
+  }
+}
+
+/**
+ * @brief Answer one command line, appending the reply to out
+ *
+ * Offsets in out where a delayed segment should start are added to breaks.
+ */
+void HandleCommand(ServerState& state, std::string_view line, bool& debug, std::string& out,
+                   std::vector<size_t>& breaks) {
+  ++state.total_requests;
+  auto tokens = Tokenize(line);
+  if (tokens.empty()) {
+    out += "ERROR Empty command\r\n";
+    ++state.total_errors;
+    return;
+  }
+
+  std::string command = Upper(tokens[0]);
+  if (command == "SEARCH") {
+    HandleSearch(state, tokens, debug, out);
+  } else if (command == "COUNT") {
+    HandleCount(state, tokens, debug, out);
+  } else if (command == "GET") {
+    HandleGet(state, tokens, out);
+  } else if (command == "INFO") {
+    HandleInfo(state, out, breaks);
+  } else if (command == "CONFIG") {
+    HandleConfig(state, out);
+  } else if (command == "REPLICATION") {
+    HandleReplication(state, tokens, out);
+  } else if (command == "DEBUG" && tokens.size() == 2 && (Upper(tokens[1]) == "ON" || Upper(tokens[1]) == "OFF")) {
+    debug = Upper(tokens[1]) == "ON";
+    out += debug ? "OK DEBUG_ON\r\n" : "OK DEBUG_OFF\r\n";
+  } else if (command == "SAVE") {
+    out.append("OK SAVED ").append(tokens.size() > 1 ? tokens[1] : "standin.dmp").append("\r\n");
+  } else if (command == "LOAD" && tokens.size() == 2) {
+    out.append("OK LOADED ").append(tokens[1]).append("\r\n");
+  } else {
+    out.append("ERROR Unknown command: ").append(tokens[0]).append("\r\n");
+    ++state.total_errors;
+  }
+}
+
+bool SendAll(int fd, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+/**
+ * @brief Send out in segments split at breaks, gap_ms apart
+ */
+bool SendSegments(int fd, const std::string& out, const std::vector<size_t>& breaks, uint32_t gap_ms) {
+  size_t start = 0;
+  for (size_t end : breaks) {
+    if (!SendAll(fd, out.substr(start, end - start))) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(gap_ms));
+    start = end;
+  }
+  return SendAll(fd, out.substr(start));
+}
+
+/**
+ * @brief Serve one connection until the client disconnects
+ *
+ * Commands that arrive together (pipelined GETs) are answered with one
+ * write, after one injected delay, as a round trip would be.
+ */
+void ServeConnection(ServerState& state, int fd, uint32_t seed) {
+  ++state.active_connections;
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<uint32_t> jitter(0, state.options.jitter_us);
+  std::vector<char> buffer(kReadBufferSize);
+  std::string pending;
+  std::string out;
+  std::vector<size_t> breaks;  // Offsets in out where a delayed segment starts
+  bool debug = false;
+
+  while (!g_stop) {
+    ssize_t received = recv(fd, buffer.data(), buffer.size(), 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received <= 0) {
+      break;
+    }
+    pending.append(buffer.data(), static_cast<size_t>(received));
+
+    out.clear();
+    breaks.clear();
+    size_t start = 0;
+    for (size_t newline = pending.find('\n'); newline != std::string::npos; newline = pending.find('\n', start)) {
+      std::string_view line(pending.data() + start, newline - start);
+      if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+      }
+      if (!line.empty()) {
+        HandleCommand(state, line, debug, out, breaks);
+      }
+      start = newline + 1;
+    }
+    pending.erase(0, start);
+    if (pending.size() > kMaxPendingBytes) {
+      break;
+    }
+
+    if (!out.empty()) {
+      uint32_t delay_us = state.options.latency_us + (state.options.jitter_us > 0 ? jitter(rng) : 0);
+      if (delay_us > 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(delay_us));
+      }
+      if (!SendSegments(fd, out, breaks, state.options.info_sections_ms.value_or(0))) {
+        break;
+      }
+    }
+  }
+
+  close(fd);
+  --state.active_connections;
+}
+
+/**
+ * @brief Fill a table with synthetic documents
+ *
+ * Words follow a skewed distribution, so some terms hit most documents and
+ * others few. Fields: status (integer), category (string), created_at
+ * (epoch seconds) and the configured padding fields.
+ */
+void FillSynthetic(const Options& options, uint32_t seed, Table& table) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::string padding(options.field_bytes, 'x');
+  std::string text;
+
+  for (size_t i = 0; i < options.documents; ++i) {
+    text.clear();
+    for (size_t w = 0; w < options.words; ++w) {
+      double u = unit(rng);
+      auto word = std::min(kWordCount - 1, static_cast<size_t>(u * u * static_cast<double>(kWordCount)));
+      text.append(w == 0 ? "" : " ").append(kWords[word]);
+    }
+
+    Fields fields{{"status", std::to_string(i % kStatusValues)},
+                  {"category", "c" + std::to_string(i % kCategoryValues)},
+                  {"created_at", std::to_string(kBaseTimestamp + static_cast<int64_t>(i) * kTimestampStep)}};
+    for (size_t f = 1; f <= options.extra_fields; ++f) {
+      fields.emplace_back("f" + std::to_string(f), padding);
+    }
+
+    std::string primary_key = std::to_string(i + 1);
+    table.index.Add(primary_key, text, fields);
+    table.documents.emplace(std::move(primary_key), std::move(fields));
+  }
+}
+
+/**
+ * @brief Load "pk<TAB>text[<TAB>key=value...]" lines into a table
+ * @return Error message, or nullopt on success
+ */
+std::optional<std::string> LoadTsv(const std::string& path, Table& table) {
+  std::ifstream file(path);
+  if (!file) {
+    return "cannot open " + path;
+  }
+
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    std::vector<std::string> columns;
+    std::istringstream row(line);
+    for (std::string column; std::getline(row, column, '\t');) {
+      columns.push_back(std::move(column));
+    }
+    if (columns.size() < 2 || columns[0].empty()) {
+      continue;
+    }
+
+    Fields fields;
+    for (size_t i = 2; i < columns.size(); ++i) {
+      size_t equals = columns[i].find('=');
+      if (equals != std::string::npos && equals > 0) {
+        fields.emplace_back(columns[i].substr(0, equals), columns[i].substr(equals + 1));
+      }
+    }
+    table.index.Add(columns[0], columns[1], fields);
+    table.documents[columns[0]] = std::move(fields);
+  }
+  return std::nullopt;
+}
+
+void PrintUsage(const char* program) {
+  std::fprintf(stderr,
+               "Usage: %s [options]\n"
+               "  --host ADDR             Listen address (default: 127.0.0.1)\n"
+               "  --port N                Listen port (default: 11016)\n"
+               "  --tables A,B            Synthetic tables (default: articles)\n"
+               "  --documents N           Synthetic documents per table (default: 10000)\n"
+               "  --words N               Words per synthetic document (default: 8)\n"
+               "  --fields N              Padding fields per synthetic document (default: 0)\n"
+               "  --field-bytes N         Bytes per padding field value (default: 16)\n"
+               "  --load TABLE=PATH       Load a table from a TSV file instead (repeatable)\n"
+               "  --default-limit N       Results when SEARCH has no LIMIT (default: 100)\n"
+               "  --latency-us N          Delay before each reply batch (default: 0)\n"
+               "  --jitter-us N           Extra uniform random delay, up to N (default: 0)\n"
+               "  --seed N                Synthetic data and jitter seed (default: 1)\n"
+               "  --ngram-size N          N-gram size for non-CJK text (default: 2)\n"
+               "  --kanji-ngram-size N    N-gram size for CJK ideographs (default: 1)\n"
+               "  --debug-style S         DEBUG output: inline (native client) or section (JavaScript client)\n"
+               "  --info-sections MS      Blank-line-separated INFO sections, sent MS milliseconds apart\n",
+               program);
+}
+
+/**
+ * @brief Parse the command line
+ * @return Options, or an error message
+ */
+std::variant<Options, std::string> ParseOptions(int argc, char** argv) {
+  Options options;
+  bool tables_given = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string flag = argv[i];
+    if (flag == "--help" || flag == "-h") {
+      return std::string();
+    }
+    if (i + 1 >= argc) {
+      return "missing value for " + flag;
+    }
+    std::string value = argv[++i];
+    auto number = ParseUnsigned(value);
+    auto require_number = [&](uint64_t max) -> std::optional<std::string> {
+      if (!number || *number > max) {
+        return "invalid value for " + flag + ": " + value;
+      }
+      return std::nullopt;
+    };
+
+    std::optional<std::string> err;
+    if (flag == "--host") {
+      if (!mygramdb::utils::ParseIPv4(value)) {
+        return "invalid IPv4 address: " + value;
+      }
+      options.host = value;
+    } else if (flag == "--port") {
+      if (!(err = require_number(UINT16_MAX))) {
+        options.port = static_cast<uint16_t>(*number);
+      }
+    } else if (flag == "--tables") {
+      options.tables.clear();
+      std::istringstream names(value);
+      for (std::string name; std::getline(names, name, ',');) {
+        if (!name.empty()) {
+          options.tables.push_back(name);
+        }
+      }
+      tables_given = true;
+    } else if (flag == "--documents") {
+      if (!(err = require_number(UINT32_MAX))) {
+        options.documents = static_cast<size_t>(*number);
+      }
+    } else if (flag == "--words") {
+      if (!(err = require_number(UINT16_MAX))) {
+        options.words = static_cast<size_t>(*number);
+      }
+    } else if (flag == "--fields") {
+      if (!(err = require_number(UINT16_MAX))) {
+        options.extra_fields = static_cast<size_t>(*number);
+      }
+    } else if (flag == "--field-bytes") {
+      if (!(err = require_number(kMaxPendingBytes))) {
+        options.field_bytes = static_cast<size_t>(*number);
+      }
+    } else if (flag == "--load") {
+      size_t equals = value.find('=');
+      if (equals == std::string::npos || equals == 0 || equals + 1 == value.size()) {
+        return "expected TABLE=PATH for --load";
+      }
+      options.loads.emplace_back(value.substr(0, equals), value.substr(equals + 1));
+    } else if (flag == "--default-limit") {
+      if (!(err = require_number(UINT32_MAX))) {
+        options.default_limit = static_cast<uint32_t>(*number);
+      }
+    } else if (flag == "--latency-us" || flag == "--jitter-us" || flag == "--seed") {
+      if (!(err = require_number(UINT32_MAX))) {
+        (flag == "--seed" ? options.seed : flag == "--latency-us" ? options.latency_us : options.jitter_us) =
+            static_cast<uint32_t>(*number);
+      }
+    } else if (flag == "--ngram-size" || flag == "--kanji-ngram-size") {
+      if (!(err = require_number(UINT8_MAX)) && *number == 0) {
+        err = flag + " must be at least 1";
+      }
+      if (!err) {
+        (flag == "--ngram-size" ? options.index.ascii_ngram_size : options.index.kanji_ngram_size) =
+            static_cast<int>(*number);
+      }
+    } else if (flag == "--debug-style") {
+      if (value != "inline" && value != "section") {
+        return "expected inline or section for --debug-style";
+      }
+      options.inline_debug = value == "inline";
+    } else if (flag == "--info-sections") {
+      if (!(err = require_number(UINT16_MAX))) {
+        options.info_sections_ms = static_cast<uint32_t>(*number);
+      }
+    } else {
+      return "unknown option: " + flag;
+    }
+    if (err) {
+      return *err;
+    }
+  }
+
+  // Loading tables replaces the default synthetic table unless --tables was given
+  if (!options.loads.empty() && !tables_given) {
+    options.tables.clear();
+  }
+  return options;
+}
+
+int Listen(const Options& options) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int enable = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(options.port);
+  inet_pton(AF_INET, options.host.c_str(), &addr.sin_addr);
+  if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(fd, kListenBacklog) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto parsed = ParseOptions(argc, argv);
+  if (auto* message = std::get_if<std::string>(&parsed)) {
+    if (!message->empty()) {
+      std::fprintf(stderr, "%s: %s\n", argv[0], message->c_str());
+    }
+    PrintUsage(argv[0]);
+    return message->empty() ? 0 : 2;
+  }
+
+  ServerState state;
+  state.options = std::get<Options>(std::move(parsed));
+  const Options& options = state.options;
+
+  auto build_start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < options.tables.size(); ++i) {
+    auto& table = state.tables[options.tables[i]];
+    table = std::make_unique<Table>(options.index);
+    FillSynthetic(options, options.seed + static_cast<uint32_t>(i), *table);
+  }
+  for (const auto& [name, path] : options.loads) {
+    auto& table = state.tables[name];
+    if (!table) {
+      table = std::make_unique<Table>(options.index);
+    }
+    if (auto err = LoadTsv(path, *table)) {
+      std::fprintf(stderr, "%s: %s\n", argv[0], err->c_str());
+      return 1;
+    }
+  }
+  std::chrono::duration<double> build_time = std::chrono::steady_clock::now() - build_start;
+
+  int listen_fd = Listen(options);
+  if (listen_fd < 0) {
+    std::fprintf(stderr, "%s: cannot listen on %s:%u: %s\n", argv[0], options.host.c_str(), options.port,
+                 std::strerror(errno));
+    return 1;
+  }
+  g_listen_fd = listen_fd;
+
+  struct sigaction action {};
+  action.sa_handler = HandleStopSignal;  // No SA_RESTART: accept() returns on a signal
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  for (const auto& [name, table] : state.tables) {
+    auto stats = table->index.GetStats();
+    std::fprintf(stderr, "table %s: %zu documents, %zu n-grams, %zu posting bytes\n", name.c_str(), stats.documents,
+                 stats.ngrams, stats.posting_bytes);
+  }
+  std::fprintf(stderr, "listening on %s:%u (data ready in %.2fs)\n", options.host.c_str(), options.port,
+               build_time.count());
+
+  uint32_t connection_seed = options.seed;
+  while (!g_stop) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0) {
+      continue;  // EINTR on shutdown, or a transient error
+    }
+    int enable = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    std::thread(ServeConnection, std::ref(state), fd, ++connection_seed).detach();
+  }
+
+  close(listen_fd);
+  std::fprintf(stderr, "served %llu requests (%llu errors)\n",
+               static_cast<unsigned long long>(state.total_requests.load()),
+               static_cast<unsigned long long>(state.total_errors.load()));
+  return 0;
+}
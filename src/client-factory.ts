@@ -7,9 +7,32 @@
  * 2. Fall back to pure JavaScript implementation
  */
 
-import { ClientConfig } from './types';
+import { ClientConfig, CountOptions, QueryNormalization, SearchOptions } from './types';
 import { MygramClient } from './client';
 import { NativeMygramClient } from './native-client';
+import { InfoPoller, NativeInfoPoller } from './info-poller';
+import { ExpressionCache } from './expression-cache';
+import {
+  ConvertedExpression,
+  PackedConversions,
+  convertSearchExpressions,
+  unpackConversions
+} from './search-expression';
+import { NativeQueryCost, QueryCost, QueryCostOptions, estimateQueryCostJs, fromNativeQueryCost } from './query-cost';
+import { generateHybridNgramHashesJs, generateNgramHashesJs } from './ngram-hash';
+import {
+  NativeNgramBatch,
+  NgramBatch,
+  NgramBatchOptions,
+  PackedDocuments,
+  fromNativeNgramBatch,
+  generateNgramBatchJs
+} from './ngram-batch';
+import { MetricsCollector, MetricsCollectorOptions, NativeMetricsCollector } from './server-metrics';
+import { LocalIndex, LocalIndexOptions } from './local-index';
+import { NgramBloomFilter, NgramFilterOptions } from './ngram-filter';
+import { MemoryPressureMonitor, MemoryPressureOptions } from './memory-pressure';
+import { canonicalCountKey, canonicalSearchKey } from './query-key';
 import { tryLoadNative as loadNativeModule } from './native-loader';
 
 let nativeBinding: unknown = null;
@@ -66,6 +89,464 @@ export function createMygramClient(
   return new MygramClient(config);
 }
 
+/**
+ * Create a cached INFO poller with its own connection
+ *
+ * The native poller refreshes on a background thread; the JavaScript fallback
+ * polls a dedicated MygramClient from the event loop.
+ *
+ * @param {ClientConfig} [config={}] - Connection configuration
+ * @param {number} [intervalMs=1000] - Delay between polls
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {InfoPoller | NativeInfoPoller} Poller instance (call start() to begin polling)
+ *
+ * @example
+ * ```typescript
+ * const poller = createInfoPoller({ host: 'localhost' }, 5000);
+ * await poller.start();
+ * const docs = poller.latest()?.info.docCount;
+ * ```
+ */
+export function createInfoPoller(
+  config: ClientConfig = {},
+  intervalMs = 1000,
+  forceJavaScript = false
+): InfoPoller | NativeInfoPoller {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new NativeInfoPoller(nativeBinding as never, config, intervalMs);
+  }
+  return new InfoPoller(new MygramClient(config), intervalMs);
+}
+
+/**
+ * Create a server metrics collector with its own connection
+ *
+ * The native collector samples on a background thread; the JavaScript fallback
+ * samples a dedicated MygramClient from the event loop.
+ *
+ * @param {ClientConfig} [config={}] - Connection configuration
+ * @param {MetricsCollectorOptions} [options={}] - Sampling interval and rolling windows
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {MetricsCollector | NativeMetricsCollector} Collector instance (call start() to begin sampling)
+ *
+ * @example
+ * ```typescript
+ * const collector = createMetricsCollector({ host: 'localhost' }, { intervalMs: 5000, windows: [60, 600] });
+ * await collector.start();
+ * const qps = collector.getMetrics().windows[0].requestsPerSecond;
+ * ```
+ */
+export function createMetricsCollector(
+  config: ClientConfig = {},
+  options: MetricsCollectorOptions = {},
+  forceJavaScript = false
+): MetricsCollector | NativeMetricsCollector {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new NativeMetricsCollector(nativeBinding as never, config, options);
+  }
+  return new MetricsCollector(new MygramClient(config), options);
+}
+
+/**
+ * Create a parsed search expression cache
+ *
+ * The native cache parses with the C++ expression parser; the JavaScript
+ * fallback parses with its TS port (same queries, terms and errors) and
+ * keeps entries in a Map.
+ *
+ * @param {number} [capacity=1024] - Maximum entries (0 disables caching)
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {ExpressionCache} Cache instance (call destroy() when done)
+ *
+ * @example
+ * ```typescript
+ * const cache = createExpressionCache(4096);
+ * const { mainTerm, andTerms, notTerms } = cache.get('golang -old');
+ * console.log(cache.getStats().hitRate);
+ * ```
+ */
+export function createExpressionCache(capacity = 1024, forceJavaScript = false): ExpressionCache {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new ExpressionCache(capacity, nativeBinding as never);
+  }
+  return new ExpressionCache(capacity);
+}
+
+/**
+ * Create an in-process n-gram index
+ *
+ * The native index keeps delta-compressed posting lists with skip entries;
+ * the JavaScript fallback keeps plain arrays of document ids.
+ *
+ * @param {LocalIndexOptions} [options={}] - N-gram sizes and normalization (match the server's table)
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {LocalIndex} Index instance (call destroy() when done)
+ *
+ * @example
+ * ```typescript
+ * const index = createLocalIndex();
+ * index.add('1', '東京都の天気', { status: '1' });
+ * const { results, totalCount } = index.search('天気', { filters: { status: '1' } });
+ * ```
+ */
+export function createLocalIndex(options: LocalIndexOptions = {}, forceJavaScript = false): LocalIndex {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new LocalIndex(options, nativeBinding as never);
+  }
+  return new LocalIndex(options);
+}
+
+/**
+ * Create an empty n-gram Bloom filter
+ *
+ * Add every document of a table, then pass the filter to the client's
+ * setNgramFilter() so queries that cannot match are answered locally.
+ *
+ * @param {number} expectedNgrams - Distinct n-grams the filter is sized for
+ * @param {NgramFilterOptions} [options={}] - N-gram sizes and normalization (match the server's table)
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {NgramBloomFilter} Filter instance (call destroy() when done)
+ *
+ * @example
+ * ```typescript
+ * const filter = createNgramFilter(1_000_000);
+ * for (const text of documents) {
+ *   filter.add(text);
+ * }
+ * client.setNgramFilter('articles', filter);
+ * ```
+ */
+export function createNgramFilter(
+  expectedNgrams: number,
+  options: NgramFilterOptions = {},
+  forceJavaScript = false
+): NgramBloomFilter {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new NgramBloomFilter(expectedNgrams, options, nativeBinding as never);
+  }
+  return new NgramBloomFilter(expectedNgrams, options);
+}
+
+/**
+ * Restore an n-gram Bloom filter from serialize() output
+ *
+ * Both implementations read and write the same format.
+ *
+ * @param {Uint8Array} data - Serialized filter
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {NgramBloomFilter} Filter instance (call destroy() when done)
+ * @throws {Error} If the data is truncated or not a filter
+ */
+export function loadNgramFilter(data: Uint8Array, forceJavaScript = false): NgramBloomFilter {
+  if (!forceJavaScript && tryLoadNative()) {
+    return NgramBloomFilter.deserialize(data, nativeBinding as never);
+  }
+  return NgramBloomFilter.deserialize(data);
+}
+
+/**
+ * Create a memory pressure monitor
+ *
+ * The native binding reads memory health like the C++ library (cgroup v1/v2
+ * aware, page cache counted as reclaimable); the JavaScript fallback uses
+ * process.constrainedMemory() and process.availableMemory().
+ *
+ * @param {MemoryPressureOptions} [options={}] - Interval and capacity fractions
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {MemoryPressureMonitor} Monitor instance (call stop() when done)
+ *
+ * @example
+ * ```typescript
+ * const cache = createExpressionCache(4096);
+ * const monitor = createMemoryPressureMonitor();
+ * monitor.subscribeCache(cache); // 2048 entries on WARNING, 409 on CRITICAL
+ * monitor.start();
+ * ```
+ */
+export function createMemoryPressureMonitor(
+  options: MemoryPressureOptions = {},
+  forceJavaScript = false
+): MemoryPressureMonitor {
+  if (!forceJavaScript && tryLoadNative()) {
+    return new MemoryPressureMonitor(options, nativeBinding as never);
+  }
+  return new MemoryPressureMonitor(options);
+}
+
+/**
+ * Convert many search expressions in one call
+ *
+ * The native binding parses the whole batch in a single call (splitting large
+ * batches across a few threads) and returns the results packed into one
+ * string; the JavaScript fallback converts the expressions one by one with
+ * the TS port of the same parser, so both return the same queries and errors.
+ *
+ * @param {string[]} expressions - Web-style search expressions
+ * @param {number} [maxThreads=0] - Upper bound on native threads (0 = default, 1 = calling thread only)
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {ConvertedExpression[]} One result per input, in input order
+ *
+ * @example
+ * ```typescript
+ * const results = batchConvertSearchExpressions(['golang -old', 'a OR']);
+ * // [{ ok: true, query: 'golang AND NOT old' }, { ok: false, error: "Expected term after 'OR'" }]
+ * ```
+ */
+export function batchConvertSearchExpressions(
+  expressions: string[],
+  maxThreads = 0,
+  forceJavaScript = false
+): ConvertedExpression[] {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      convertSearchExpressions(expressions: string[], maxThreads: number): PackedConversions;
+    };
+    return unpackConversions(binding.convertSearchExpressions(expressions, maxThreads));
+  }
+  return convertSearchExpressions(expressions);
+}
+
+/**
+ * Estimate the cost of a search expression before sending it
+ *
+ * Splits every term into the hybrid n-grams the server looks up and
+ * classifies the total, so expensive queries can be routed to another
+ * replica, deprioritized or rejected. Uses the native parser and n-gram
+ * generator when available.
+ *
+ * @param {string} expression - Web-style search expression
+ * @param {QueryCostOptions} [options={}] - N-gram sizes, normalization and class thresholds
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {QueryCost} Estimated cost
+ * @throws {Error} If the expression does not parse
+ *
+ * @example
+ * ```typescript
+ * const cost = estimateQueryCost(userQuery, { asciiNgramSize: 2, kanjiNgramSize: 1 });
+ * if (cost.costClass === 'excessive') {
+ *   throw new Error('Query too broad');
+ * }
+ * ```
+ */
+export function estimateQueryCost(
+  expression: string,
+  options: QueryCostOptions = {},
+  forceJavaScript = false
+): QueryCost {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      estimateQueryCost(expression: string, options: QueryCostOptions): NativeQueryCost;
+    };
+    return fromNativeQueryCost(binding.estimateQueryCost(expression, options));
+  }
+  return estimateQueryCostJs(expression, options);
+}
+
+/**
+ * Build the canonical SEARCH key for a query
+ *
+ * Equivalent queries (term order, duplicate terms, filter order) map to the
+ * same key. Uses the native canonicalizer when available; the JavaScript
+ * fallback builds the same string.
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {SearchOptions} [options={}] - Search options
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {string} Canonical key
+ *
+ * @example
+ * ```typescript
+ * searchKey('articles', 'foo', { andTerms: ['bar'] }); // 'SEARCH articles bar AND foo LIMIT 1000'
+ * ```
+ */
+export function searchKey(
+  table: string,
+  query: string,
+  options: SearchOptions = {},
+  normalization: QueryNormalization = {},
+  forceJavaScript = false
+): string {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      canonicalSearchKey(
+        table: string,
+        query: string,
+        limit: number,
+        offset: number,
+        andTerms: string[],
+        notTerms: string[],
+        filterKeys: string[],
+        filterValues: string[],
+        sortColumn: string,
+        sortDesc: boolean,
+        normalization: QueryNormalization
+      ): string;
+    };
+    const {
+      limit = 1000,
+      offset = 0,
+      andTerms = [],
+      notTerms = [],
+      filters = {},
+      sortColumn = '',
+      sortDesc = true
+    } = options;
+    const filterKeys = Object.keys(filters);
+    return binding.canonicalSearchKey(
+      table,
+      query,
+      limit,
+      offset,
+      andTerms,
+      notTerms,
+      filterKeys,
+      filterKeys.map((key) => filters[key]),
+      sortColumn,
+      sortDesc,
+      normalization
+    );
+  }
+  return canonicalSearchKey(table, query, options, normalization);
+}
+
+/**
+ * Build the canonical COUNT key for a query
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {CountOptions} [options={}] - Count options
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {string} Canonical key
+ */
+export function countKey(
+  table: string,
+  query: string,
+  options: CountOptions = {},
+  normalization: QueryNormalization = {},
+  forceJavaScript = false
+): string {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      canonicalCountKey(
+        table: string,
+        query: string,
+        andTerms: string[],
+        notTerms: string[],
+        filterKeys: string[],
+        filterValues: string[],
+        normalization: QueryNormalization
+      ): string;
+    };
+    const { andTerms = [], notTerms = [], filters = {} } = options;
+    const filterKeys = Object.keys(filters);
+    return binding.canonicalCountKey(
+      table,
+      query,
+      andTerms,
+      notTerms,
+      filterKeys,
+      filterKeys.map((key) => filters[key]),
+      normalization
+    );
+  }
+  return canonicalCountKey(table, query, options, normalization);
+}
+
+/**
+ * Hash the n-grams of a text
+ *
+ * Returns one 64-bit rolling hash per n-gram instead of the n-gram strings,
+ * computed natively from code points when the binding is available. Native
+ * and JavaScript hashes are identical.
+ *
+ * @param {string} text - Text (should be normalized)
+ * @param {number} ngramSize - N-gram size in code points
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {BigUint64Array} One hash per n-gram, in text order
+ */
+export function generateNgramHashes(text: string, ngramSize: number, forceJavaScript = false): BigUint64Array {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as { ngramHashes(text: string, ngramSize: number): BigUint64Array };
+    return binding.ngramHashes(text, ngramSize);
+  }
+  return generateNgramHashesJs(text, ngramSize);
+}
+
+/**
+ * Hash the hybrid n-grams of a text
+ *
+ * Same n-grams as generateHybridNgrams, hashed like generateNgramHashes.
+ *
+ * @param {string} text - Text (should be normalized)
+ * @param {number} [asciiNgramSize=2] - N-gram size for non-CJK characters
+ * @param {number} [kanjiNgramSize=1] - N-gram size for CJK ideographs
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {BigUint64Array} One hash per n-gram, in text order
+ *
+ * @example
+ * ```typescript
+ * const seen = new Set(generateHybridNgramHashes(normalizedTitle));
+ * ```
+ */
+export function generateHybridNgramHashes(
+  text: string,
+  asciiNgramSize = 2,
+  kanjiNgramSize = 1,
+  forceJavaScript = false
+): BigUint64Array {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      ngramHashes(text: string, asciiNgramSize: number, kanjiNgramSize: number): BigUint64Array;
+    };
+    return binding.ngramHashes(text, asciiNgramSize, kanjiNgramSize);
+  }
+  return generateHybridNgramHashesJs(text, asciiNgramSize, kanjiNgramSize);
+}
+
+/**
+ * Normalize and split a batch of documents into hybrid n-grams
+ *
+ * Returns per-document n-gram counts, and optionally the n-gram hashes or
+ * the n-grams themselves, packed into flat arrays. The native binding
+ * processes the batch in one call on a few threads that balance uneven
+ * documents by work stealing; the JavaScript fallback splits the documents
+ * one by one.
+ *
+ * @param {string[] | PackedDocuments} documents - Document texts, or documents packed with packDocuments
+ * @param {NgramBatchOptions} [options={}] - Normalization, n-gram sizes, output and thread limit
+ * @param {boolean} [forceJavaScript=false] - Force use of pure JavaScript implementation
+ * @returns {NgramBatch} Packed results in input order
+ *
+ * @example
+ * ```typescript
+ * const { counts } = generateNgramBatch(rows, { nfkc: true, width: 'narrow', lower: true, distinct: true });
+ * const postings = counts.reduce((sum, count) => sum + count, 0);
+ * ```
+ */
+export function generateNgramBatch(
+  documents: string[] | PackedDocuments,
+  options: NgramBatchOptions = {},
+  forceJavaScript = false
+): NgramBatch {
+  if (!forceJavaScript && tryLoadNative()) {
+    const binding = nativeBinding as {
+      ngramBatch(
+        documents: string[] | Uint8Array,
+        offsets: Uint32Array | null,
+        options: NgramBatchOptions
+      ): NativeNgramBatch;
+    };
+    const native = Array.isArray(documents)
+      ? binding.ngramBatch(documents, null, options)
+      : binding.ngramBatch(documents.data, documents.offsets, options);
+    return fromNativeNgramBatch(native);
+  }
+  return generateNgramBatchJs(documents, options);
+}
+
 /**
  * Check if native binding is available
  *
@@ -13,9 +13,14 @@ import {
   ReplicationStatus,
   SearchOptions,
   CountOptions,
-  DebugInfo
+  DebugInfo,
+  ColumnarDocuments,
+  FieldSchema,
+  TypedDocument
 } from './types';
-import { ConnectionError, ProtocolError, TimeoutError } from './errors';
+import { ConnectionError, InputValidationError, ProtocolError, TimeoutError } from './errors';
+import { buildColumnarDocuments } from './columnar';
+import { FieldSchemaCache } from './field-schema';
 import {
   DEFAULT_MAX_QUERY_LENGTH,
   ensureSafeCommandValue,
@@ -23,13 +28,22 @@ import {
   ensureSafeStringArray,
   ensureQueryLengthWithinLimit
 } from './command-utils';
+import { SingleFlight, canonicalCountKey, canonicalSearchKey } from './query-key';
+import { TermStatsCache } from './term-stats';
+import { prepareTerms } from './query-analysis';
+import { NgramBloomFilter } from './ngram-filter';
 
 const DEFAULT_CONFIG: Required<ClientConfig> = {
   host: '127.0.0.1',
   port: 11016,
   timeout: 5000,
   recvBufferSize: 65536,
-  maxQueryLength: DEFAULT_MAX_QUERY_LENGTH
+  maxQueryLength: DEFAULT_MAX_QUERY_LENGTH,
+  learnFieldSchemas: false,
+  reorderTerms: false,
+  analyzeQueries: false,
+  singleFlight: false,
+  queryNormalization: {}
 };
 
 /**
@@ -57,6 +71,12 @@ export class MygramClient {
   private pendingResolve: ((value: string) => void) | null = null;
   private pendingReject: ((error: Error) => void) | null = null;
   private timeoutHandle: NodeJS.Timeout | null = null;
+  private fieldSchemas: FieldSchemaCache;
+  private searchFlights = new SingleFlight<SearchResponse>();
+  private countFlights = new SingleFlight<CountResponse>();
+  private termStats = new TermStatsCache();
+  private ngramFilters = new Map<string, NgramBloomFilter>();
+  private savedRoundTrips = 0;
 
   /**
    * Create a new MygramDB client
@@ -69,6 +89,7 @@ export class MygramClient {
       mergedConfig.maxQueryLength = DEFAULT_MAX_QUERY_LENGTH;
     }
     this.config = mergedConfig;
+    this.fieldSchemas = new FieldSchemaCache(mergedConfig.learnFieldSchemas);
   }
 
   /**
@@ -191,18 +212,41 @@ export class MygramClient {
       this.config.maxQueryLength
     );
 
-    const parts: string[] = ['SEARCH', safeTable, safeQuery];
+    let requiredTerms = andTerms;
+    let excludedTerms = notTerms;
+    if (this.config.analyzeQueries) {
+      const prepared = prepareTerms(safeQuery, andTerms, notTerms);
+      if (prepared.analysis.verdict !== 'send') {
+        // Known outcome: answer locally
+        this.savedRoundTrips += 1;
+        if (prepared.analysis.verdict === 'invalid') {
+          throw new InputValidationError(prepared.analysis.reason ?? 'Invalid query');
+        }
+        return { results: [], totalCount: 0 };
+      }
+      ({ andTerms: requiredTerms, notTerms: excludedTerms } = prepared);
+    }
+
+    if (this.rejectedByNgramFilter(safeTable, safeQuery, requiredTerms)) {
+      return { results: [], totalCount: 0 };
+    }
+
+    // Start from the rarest known term; the intersection (and so the result) is the same
+    const ordered = this.config.reorderTerms
+      ? this.termStats.reorder(safeTable, safeQuery, requiredTerms)
+      : { mainTerm: safeQuery, andTerms: requiredTerms };
+    const parts: string[] = ['SEARCH', safeTable, ordered.mainTerm];
 
     // Add AND terms
-    if (andTerms.length > 0) {
-      andTerms.forEach((term) => {
+    if (ordered.andTerms.length > 0) {
+      ordered.andTerms.forEach((term) => {
         parts.push('AND', term);
       });
     }
 
     // Add NOT terms
-    if (notTerms.length > 0) {
-      notTerms.forEach((term) => {
+    if (excludedTerms.length > 0) {
+      excludedTerms.forEach((term) => {
         parts.push('NOT', term);
       });
     }
@@ -229,8 +273,22 @@ export class MygramClient {
       parts.push('LIMIT', `${limit}`);
     }
 
-    const response = await this.sendCommand(parts.join(' '));
-    return MygramClient.parseSearchResponse(response);
+    const command = parts.join(' ');
+    const execute = async (): Promise<SearchResponse> => {
+      const response = MygramClient.parseSearchResponse(await this.sendCommand(command));
+      if (this.config.reorderTerms) {
+        const lone = ordered.andTerms.length === 0 && excludedTerms.length === 0 && filterEntries.length === 0;
+        this.termStats.recordResponse(safeTable, ordered.mainTerm, lone, response.totalCount, response.debug);
+      }
+      return response;
+    };
+    if (!this.config.singleFlight) {
+      return execute();
+    }
+
+    // Concurrent equivalent searches share one round trip (and one response object)
+    const key = canonicalSearchKey(safeTable, safeQuery, options, this.config.queryNormalization);
+    return this.searchFlights.run(key, execute);
   }
 
   /**
@@ -263,18 +321,41 @@ export class MygramClient {
       this.config.maxQueryLength
     );
 
-    const parts: string[] = ['COUNT', safeTable, safeQuery];
+    let requiredTerms = andTerms;
+    let excludedTerms = notTerms;
+    if (this.config.analyzeQueries) {
+      const prepared = prepareTerms(safeQuery, andTerms, notTerms);
+      if (prepared.analysis.verdict !== 'send') {
+        // Known outcome: answer locally
+        this.savedRoundTrips += 1;
+        if (prepared.analysis.verdict === 'invalid') {
+          throw new InputValidationError(prepared.analysis.reason ?? 'Invalid query');
+        }
+        return { count: 0 };
+      }
+      ({ andTerms: requiredTerms, notTerms: excludedTerms } = prepared);
+    }
+
+    if (this.rejectedByNgramFilter(safeTable, safeQuery, requiredTerms)) {
+      return { count: 0 };
+    }
+
+    // Start from the rarest known term; the intersection (and so the result) is the same
+    const ordered = this.config.reorderTerms
+      ? this.termStats.reorder(safeTable, safeQuery, requiredTerms)
+      : { mainTerm: safeQuery, andTerms: requiredTerms };
+    const parts: string[] = ['COUNT', safeTable, ordered.mainTerm];
 
     // Add AND terms
-    if (andTerms.length > 0) {
-      andTerms.forEach((term) => {
+    if (ordered.andTerms.length > 0) {
+      ordered.andTerms.forEach((term) => {
         parts.push('AND', term);
       });
     }
 
     // Add NOT terms
-    if (notTerms.length > 0) {
-      notTerms.forEach((term) => {
+    if (excludedTerms.length > 0) {
+      excludedTerms.forEach((term) => {
         parts.push('NOT', term);
       });
     }
@@ -289,8 +370,21 @@ export class MygramClient {
       });
     }
 
-    const response = await this.sendCommand(parts.join(' '));
-    return MygramClient.parseCountResponse(response);
+    const command = parts.join(' ');
+    const execute = async (): Promise<CountResponse> => {
+      const response = MygramClient.parseCountResponse(await this.sendCommand(command));
+      if (this.config.reorderTerms) {
+        const lone = ordered.andTerms.length === 0 && excludedTerms.length === 0 && filterEntries.length === 0;
+        this.termStats.recordResponse(safeTable, ordered.mainTerm, lone, response.count, response.debug);
+      }
+      return response;
+    };
+    if (!this.config.singleFlight) {
+      return execute();
+    }
+
+    const key = canonicalCountKey(safeTable, safeQuery, options, this.config.queryNormalization);
+    return this.countFlights.run(key, execute);
   }
 
   /**
@@ -310,6 +404,147 @@ export class MygramClient {
     return MygramClient.parseDocumentResponse(response);
   }
 
+  /**
+   * Declare the filter field types of a table
+   *
+   * getTyped() decodes declared fields and getColumns() uses the declared types
+   * for column storage. Declaring replaces any schema learned for the table.
+   *
+   * @param {string} table - Table name
+   * @param {FieldSchema} schema - Field types (empty to drop the table's schema)
+   * @returns {void}
+   */
+  setFieldSchema(table: string, schema: FieldSchema): void {
+    this.fieldSchemas.set(ensureSafeCommandValue(table, 'table'), schema);
+  }
+
+  /**
+   * Get the declared or learned field schema of a table
+   *
+   * @param {string} table - Table name
+   * @returns {FieldSchema | undefined} Field schema, or undefined if the table has none
+   */
+  getFieldSchema(table: string): FieldSchema | undefined {
+    return this.fieldSchemas.get(table);
+  }
+
+  /**
+   * Get the term statistics used by the reorderTerms option
+   *
+   * With reorderTerms, single-term results and DEBUG candidate counts are
+   * recorded automatically; callers may also prime the cache.
+   *
+   * @returns {TermStatsCache} Term statistics of this client
+   */
+  getTermStats(): TermStatsCache {
+    return this.termStats;
+  }
+
+  /**
+   * Attach an n-gram filter to a table
+   *
+   * search/count calls for the table with a positive term containing an
+   * n-gram the filter never saw return an empty result without a round trip.
+   * The filter is shared, not copied: keep adding the table's new documents
+   * to it so it keeps covering the index.
+   *
+   * @param {string} table - Table name
+   * @param {NgramBloomFilter | null} filter - Filter of the table's n-grams (null to detach)
+   * @returns {void}
+   */
+  setNgramFilter(table: string, filter: NgramBloomFilter | null): void {
+    const safeTable = ensureSafeCommandValue(table, 'table');
+    if (filter) {
+      this.ngramFilters.set(safeTable, filter);
+    } else {
+      this.ngramFilters.delete(safeTable);
+    }
+  }
+
+  /**
+   * Get the number of search/count calls answered without the server
+   *
+   * With analyzeQueries, queries that can never match (a term both required
+   * and excluded) return an empty result and invalid ones (empty terms, no
+   * positive term) throw without a round trip. Queries rejected by an
+   * n-gram filter (see setNgramFilter) count as well.
+   *
+   * @returns {number} Round trips saved so far
+   */
+  getSavedRoundTrips(): number {
+    return this.savedRoundTrips;
+  }
+
+  /**
+   * Check the positive terms against the table's n-gram filter, if any
+   *
+   * @param {string} table - Table name
+   * @param {string} mainTerm - Main search term
+   * @param {string[]} andTerms - Additional required terms
+   * @returns {boolean} True if some term cannot match (counted as a saved round trip)
+   */
+  private rejectedByNgramFilter(table: string, mainTerm: string, andTerms: string[]): boolean {
+    const filter = this.ngramFilters.get(table);
+    if (!filter || filter.mayMatchQuery(mainTerm, andTerms)) {
+      return false;
+    }
+    this.savedRoundTrips += 1;
+    return true;
+  }
+
+  /**
+   * Get a document with filter fields decoded by the table's field schema
+   *
+   * Integer and float fields become numbers and timestamp fields become Dates.
+   * With learnFieldSchemas, tables without a declared schema are typed from the
+   * values seen so far.
+   *
+   * @param {string} table - Table name to retrieve document from
+   * @param {string} primaryKey - Primary key value of the document
+   * @returns {Promise<TypedDocument>} Document with decoded field values
+   * @throws {ConnectionError} If not connected to server
+   * @throws {TimeoutError} If command times out
+   * @throws {ProtocolError} If server returns an error
+   */
+  async getTyped(table: string, primaryKey: string): Promise<TypedDocument> {
+    const document = await this.get(table, primaryKey);
+    return this.fieldSchemas.decode(table, document);
+  }
+
+  /**
+   * Get selected fields of many documents as columns
+   *
+   * Documents the server reports as missing leave their row empty (found = 0).
+   *
+   * @param {string} table - Table name to retrieve documents from
+   * @param {string[]} primaryKeys - Primary keys to fetch (row order)
+   * @param {string[]} fields - Field names to extract
+   * @returns {Promise<ColumnarDocuments>} Columnar result with one column per field
+   * @throws {ConnectionError} If not connected to server
+   * @throws {TimeoutError} If command times out
+   */
+  async getColumns(table: string, primaryKeys: string[], fields: string[]): Promise<ColumnarDocuments> {
+    ensureSafeCommandValue(table, 'table');
+    ensureSafeStringArray(primaryKeys, 'primaryKeys');
+    ensureSafeStringArray(fields, 'fields');
+
+    // One request in flight at a time on this connection
+    const documents: Array<Document | null> = [];
+    for (let i = 0; i < primaryKeys.length; i += 1) {
+      try {
+        // eslint-disable-next-line no-await-in-loop
+        documents.push(await this.get(table, primaryKeys[i]));
+      } catch (error) {
+        if (!(error instanceof ProtocolError)) {
+          throw error;
+        }
+        documents.push(null);
+      }
+    }
+
+    return buildColumnarDocuments(primaryKeys, fields, documents, this.fieldSchemas.get(table));
+  }
+
   /**
    * Get server information including version, uptime, and statistics
    *
@@ -585,6 +820,7 @@ export class MygramClient {
     }
 
     const lines = response.split('\n').slice(1); // Skip "OK INFO" line
+    const values: Record<string, string> = {};
     const info: Partial<ServerInfo> = {
       version: '',
       uptimeSeconds: 0,
@@ -592,15 +828,21 @@ export class MygramClient {
       activeConnections: 0,
       indexSizeBytes: 0,
       docCount: 0,
-      tables: []
+      tables: [],
+      values
     };
 
     lines.forEach((line) => {
       const trimmed = line.trim();
       if (!trimmed || trimmed.startsWith('#')) return;
 
-      const [key, value] = trimmed.split(':').map((s) => s.trim());
-      if (!key || !value) return;
+      // Split at the first colon only; values such as timestamps may contain ':'
+      const colon = trimmed.indexOf(':');
+      if (colon <= 0) return;
+      const key = trimmed.slice(0, colon).trim();
+      const value = trimmed.slice(colon + 1).trim();
+      values[key] = value;
+      if (!value) return;
 
       switch (key) {
         case 'version':
@@ -613,12 +855,15 @@ export class MygramClient {
           info.totalRequests = parseInt(value, 10);
           break;
         case 'connected_clients':
+        case 'active_connections':
           info.activeConnections = parseInt(value, 10);
           break;
         case 'used_memory_bytes':
+        case 'index_size_bytes':
           info.indexSizeBytes = parseInt(value, 10);
           break;
         case 'total_documents':
+        case 'doc_count':
           info.docCount = parseInt(value, 10);
           break;
         case 'tables':
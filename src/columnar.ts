@@ -0,0 +1,99 @@
+/**
+ * Columnar (struct-of-arrays) helpers for multi-document GET results
+ */
+
+import { ColumnarDocuments, Document, FieldColumn, FieldSchema } from './types';
+import { parseTimestampMillis } from './field-schema';
+
+/** Plain decimal numbers only (no hex, Infinity or NaN spellings), matching the native client */
+const DECIMAL_PATTERN = /^[+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?$/;
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+/**
+ * Check whether a field value is stored as a number in columnar results
+ *
+ * @param {string} value - Raw field value
+ * @returns {boolean} True if the value is a plain decimal number
+ */
+export function isDecimalNumber(value: string): boolean {
+  return DECIMAL_PATTERN.test(value);
+}
+
+/**
+ * Build columnar documents from per-document GET results
+ *
+ * @param {string[]} primaryKeys - Requested primary keys (row order)
+ * @param {string[]} fields - Field names to extract
+ * @param {Array<Document | null>} documents - Documents per row (null when not found)
+ * @param {FieldSchema} [schema] - Table field schema; declared strings stay strings, timestamps become epoch ms
+ * @returns {ColumnarDocuments} Columnar result
+ */
+export function buildColumnarDocuments(
+  primaryKeys: string[],
+  fields: string[],
+  documents: Array<Document | null>,
+  schema?: FieldSchema
+): ColumnarDocuments {
+  const rows = primaryKeys.length;
+  const found = new Uint8Array(rows);
+  documents.forEach((doc, row) => {
+    if (doc) found[row] = 1;
+  });
+
+  const columns: Record<string, FieldColumn> = {};
+  fields.forEach((field) => {
+    const present = new Uint8Array(rows);
+    const rawValues = documents.map((doc) => doc?.fields[field]);
+    rawValues.forEach((value, row) => {
+      if (value !== undefined) present[row] = 1;
+    });
+    const type = schema?.[field];
+
+    if (type === 'timestamp') {
+      const millis = rawValues.map((value) => (value === undefined ? NaN : parseTimestampMillis(value)));
+      if (millis.every((value) => value !== null)) {
+        columns[field] = { kind: 'number', type, values: Float64Array.from(millis as number[]), present };
+        return;
+      }
+    } else if (type !== 'string' && rawValues.every((value) => value === undefined || isDecimalNumber(value))) {
+      const values = new Float64Array(rows);
+      rawValues.forEach((value, row) => {
+        values[row] = value === undefined ? NaN : Number(value);
+      });
+      columns[field] = { kind: 'number', type, values, present };
+      return;
+    }
+
+    const encoded = rawValues.map((value) => textEncoder.encode(value ?? ''));
+    const offsets = new Uint32Array(rows + 1);
+    encoded.forEach((bytes, row) => {
+      offsets[row + 1] = offsets[row] + bytes.length;
+    });
+    const data = new Uint8Array(offsets[rows]);
+    encoded.forEach((bytes, row) => {
+      data.set(bytes, offsets[row]);
+    });
+    columns[field] = { kind: 'string', type, data, offsets, present };
+  });
+
+  return { primaryKeys, found, columns };
+}
+
+/**
+ * Read a single value from a field column
+ *
+ * @param {FieldColumn} column - Field column
+ * @param {number} row - Row index
+ * @returns {number | string | undefined} Value, or undefined if the field is absent
+ */
+export function getColumnValue(column: FieldColumn, row: number): number | string | undefined {
+  if (!column.present[row]) {
+    return undefined;
+  }
+  if (column.kind === 'number') {
+    return column.values[row];
+  }
+  return textDecoder.decode(column.data.subarray(column.offsets[row], column.offsets[row + 1]));
+}
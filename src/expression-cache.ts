@@ -0,0 +1,240 @@
+/**
+ * Parsed search expression cache
+ *
+ * Search boxes send the same expressions over and over. The cache parses each
+ * distinct expression once and serves the converted query string and the
+ * simplified term lists from memory afterwards.
+ */
+
+import { formatQueryAst, parseQueryAst, simplifyQueryAst } from './query-ast';
+
+const DEFAULT_CAPACITY = 1024;
+
+/**
+ * Parse results for one search expression
+ */
+export interface ParsedExpression {
+  /** Converted query string */
+  query: string;
+  /** Simplified main term (undefined if the expression has a group or no positive term) */
+  mainTerm?: string;
+  /** Additional required terms */
+  andTerms: string[];
+  /** Excluded terms */
+  notTerms: string[];
+}
+
+/**
+ * Expression cache counters
+ */
+export interface ExpressionCacheStats {
+  /** Lookups served from the cache */
+  hits: number;
+  /** Lookups that parsed the expression */
+  misses: number;
+  /** Entries dropped to stay within capacity */
+  evictions: number;
+  /** Entries currently cached */
+  size: number;
+  /** Maximum entries */
+  capacity: number;
+  /** Fraction of lookups served from the cache (0 before any lookup) */
+  hitRate: number;
+}
+
+// Native cache binding interface
+interface NativeExpressionCacheBinding {
+  createExpressionCache(capacity: number): unknown;
+  destroyExpressionCache(cache: unknown): void;
+  parseExpressionCached(
+    cache: unknown,
+    expression: string
+  ): { query: string; simplified: boolean; main_term: string; and_terms: string[]; not_terms: string[] };
+  getExpressionCacheStats(cache: unknown): {
+    hits: number;
+    misses: number;
+    evictions: number;
+    size: number;
+    capacity: number;
+  };
+  resizeExpressionCache(cache: unknown, capacity: number): void;
+  clearExpressionCache(cache: unknown): void;
+}
+
+// Cached parse outcome (errors are cached too)
+type CacheEntry = { parsed: ParsedExpression } | { error: Error };
+
+/**
+ * Compute the hit rate from counters
+ *
+ * @param {number} hits - Cache hits
+ * @param {number} misses - Cache misses
+ * @returns {number} Hit rate between 0 and 1
+ */
+function hitRate(hits: number, misses: number): number {
+  return hits + misses === 0 ? 0 : hits / (hits + misses);
+}
+
+/**
+ * Parse an expression without caching
+ *
+ * Same results as the native cache: the query and errors come from the TS
+ * port of the native parser.
+ *
+ * @param {string} expression - Web-style search expression
+ * @returns {ParsedExpression} Parse results
+ * @throws {Error} If the expression is invalid
+ */
+export function parseExpression(expression: string): ParsedExpression {
+  const ast = parseQueryAst(expression);
+  const query = formatQueryAst(ast);
+  const simplified = simplifyQueryAst(ast);
+  if (!simplified) {
+    // Groups or no positive term: the query is still usable, the simplified form is not
+    return { query, andTerms: [], notTerms: [] };
+  }
+  return { query, ...simplified };
+}
+
+/**
+ * LRU cache of parsed search expressions
+ *
+ * With a native binding, parsing and caching run in the native library (call
+ * destroy() when done). Without one, entries live in a Map kept in
+ * least-recently-used order and expressions are parsed in JavaScript.
+ */
+export class ExpressionCache {
+  private native: NativeExpressionCacheBinding | null;
+  private handle: unknown = null;
+  private entries = new Map<string, CacheEntry>();
+  private capacity: number;
+  private hits = 0;
+  private misses = 0;
+  private evictions = 0;
+
+  /**
+   * Create a new expression cache
+   *
+   * @param {number} [capacity=1024] - Maximum entries (0 disables caching)
+   * @param {NativeExpressionCacheBinding | null} [native=null] - Native binding object
+   */
+  constructor(capacity = DEFAULT_CAPACITY, native: NativeExpressionCacheBinding | null = null) {
+    this.capacity = capacity;
+    this.native = native;
+    if (native) {
+      this.handle = native.createExpressionCache(capacity);
+    }
+  }
+
+  /**
+   * Get parse results, parsing and caching the expression on a miss
+   *
+   * @param {string} expression - Web-style search expression
+   * @returns {ParsedExpression} Parse results
+   * @throws {Error} If the expression is invalid
+   */
+  get(expression: string): ParsedExpression {
+    if (this.native && this.handle) {
+      const raw = this.native.parseExpressionCached(this.handle, expression);
+      return {
+        query: raw.query,
+        mainTerm: raw.simplified ? raw.main_term : undefined,
+        andTerms: raw.and_terms,
+        notTerms: raw.not_terms
+      };
+    }
+
+    let entry = this.entries.get(expression);
+    if (entry) {
+      this.hits += 1;
+      // Move to the most recently used end
+      this.entries.delete(expression);
+      this.entries.set(expression, entry);
+    } else {
+      this.misses += 1;
+      try {
+        entry = { parsed: parseExpression(expression) };
+      } catch (error) {
+        entry = { error: error instanceof Error ? error : new Error(String(error)) };
+      }
+      if (this.capacity > 0) {
+        this.entries.set(expression, entry);
+        this.evictOverflow();
+      }
+    }
+
+    if ('error' in entry) {
+      throw entry.error;
+    }
+    return entry.parsed;
+  }
+
+  /**
+   * Get cache counters
+   *
+   * @returns {ExpressionCacheStats} Counters
+   */
+  getStats(): ExpressionCacheStats {
+    if (this.native && this.handle) {
+      const raw = this.native.getExpressionCacheStats(this.handle);
+      return { ...raw, hitRate: hitRate(raw.hits, raw.misses) };
+    }
+    return {
+      hits: this.hits,
+      misses: this.misses,
+      evictions: this.evictions,
+      size: this.entries.size,
+      capacity: this.capacity,
+      hitRate: hitRate(this.hits, this.misses)
+    };
+  }
+
+  /**
+   * Change the capacity, evicting least recently used entries if needed
+   *
+   * @param {number} capacity - Maximum entries (0 disables caching)
+   * @returns {void}
+   */
+  resize(capacity: number): void {
+    this.capacity = capacity;
+    if (this.native && this.handle) {
+      this.native.resizeExpressionCache(this.handle, capacity);
+      return;
+    }
+    this.evictOverflow();
+  }
+
+  /**
+   * Remove all entries (counters are kept)
+   *
+   * @returns {void}
+   */
+  clear(): void {
+    if (this.native && this.handle) {
+      this.native.clearExpressionCache(this.handle);
+      return;
+    }
+    this.entries.clear();
+  }
+
+  /**
+   * Release the native cache (the instance must not be used afterwards)
+   *
+   * @returns {void}
+   */
+  destroy(): void {
+    if (this.native && this.handle) {
+      this.native.destroyExpressionCache(this.handle);
+      this.handle = null;
+    }
+    this.entries.clear();
+  }
+
+  private evictOverflow(): void {
+    while (this.entries.size > this.capacity) {
+      const oldest = this.entries.keys().next().value as string;
+      this.entries.delete(oldest);
+      this.evictions += 1;
+    }
+  }
+}
@@ -0,0 +1,242 @@
+/**
+ * Typed decoding of document filter fields
+ *
+ * Mirrors native/src/field_schema.cpp so both clients decode values the same way.
+ */
+
+import { Document, FieldSchema, FieldType, TypedDocument, TypedFieldValue } from './types';
+
+const INTEGER_PATTERN = /^[+-]?\d+$/;
+const DECIMAL_PATTERN = /^[+-]?(\d+\.?\d*|\.\d+)([eE][+-]?\d+)?$/;
+const LEADING_ZERO_PATTERN = /^[+-]?0\d/;
+const TIMESTAMP_PATTERN =
+  /^(\d{4})-(\d{2})-(\d{2})(?:[T ](\d{2}):(\d{2})(?::(\d{2})(?:[.,](\d+))?)?(Z|[+-]\d{2}(?::?\d{2})?)?)?$/i;
+
+const MS_PER_SECOND = 1000;
+const SECONDS_PER_DAY = 86400;
+const DAYS_IN_MONTH = [31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31];
+
+const FIELD_TYPES: readonly FieldType[] = ['string', 'integer', 'float', 'timestamp'];
+
+/**
+ * Days since 1970-01-01 for a proleptic Gregorian date (Howard Hinnant's days_from_civil)
+ *
+ * @param {number} year - Year
+ * @param {number} month - Month (1-12)
+ * @param {number} day - Day of month
+ * @returns {number} Days since the Unix epoch
+ */
+function daysFromCivil(year: number, month: number, day: number): number {
+  const y = month <= 2 ? year - 1 : year;
+  const era = Math.floor(y / 400);
+  const yearOfEra = y - era * 400;
+  const dayOfYear = Math.floor((153 * (month + (month > 2 ? -3 : 9)) + 2) / 5) + day - 1;
+  const dayOfEra = yearOfEra * 365 + Math.floor(yearOfEra / 4) - Math.floor(yearOfEra / 100) + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * Check whether a string is a known field type name
+ *
+ * @param {string} value - Candidate type name
+ * @returns {boolean} True for 'string', 'integer', 'float' or 'timestamp'
+ */
+export function isFieldType(value: string): value is FieldType {
+  return FIELD_TYPES.includes(value as FieldType);
+}
+
+/**
+ * Parse a timestamp to milliseconds since the Unix epoch
+ *
+ * Accepts integer epoch seconds and ISO-8601 dates / date-times with optional
+ * fraction and zone. Date-times without a zone are interpreted as UTC.
+ *
+ * @param {string} value - Raw field value
+ * @returns {number | null} Milliseconds since epoch, or null if not a timestamp
+ */
+export function parseTimestampMillis(value: string): number | null {
+  if (INTEGER_PATTERN.test(value)) {
+    return Number(value) * MS_PER_SECOND;
+  }
+
+  const match = TIMESTAMP_PATTERN.exec(value);
+  if (!match) {
+    return null;
+  }
+
+  const year = Number(match[1]);
+  const month = Number(match[2]);
+  const day = Number(match[3]);
+  const leap = (year % 4 === 0 && year % 100 !== 0) || year % 400 === 0;
+  const daysInMonth = month === 2 && leap ? 29 : DAYS_IN_MONTH[month - 1];
+  if (month < 1 || month > 12 || day < 1 || day > daysInMonth) {
+    return null;
+  }
+
+  const hour = Number(match[4] ?? 0);
+  const minute = Number(match[5] ?? 0);
+  const second = Number(match[6] ?? 0);
+  if (hour > 23 || minute > 59 || second > 60) {
+    return null;
+  }
+
+  // Millisecond precision; finer digits are ignored
+  const millis = match[7] ? Number(match[7].slice(0, 3).padEnd(3, '0')) : 0;
+
+  let offsetSeconds = 0;
+  const zone = match[8];
+  if (zone && zone.toUpperCase() !== 'Z') {
+    const digits = zone.slice(1).replace(':', '');
+    const zoneHours = Number(digits.slice(0, 2));
+    const zoneMinutes = digits.length > 2 ? Number(digits.slice(2)) : 0;
+    if (zoneHours > 23 || zoneMinutes > 59) {
+      return null;
+    }
+    offsetSeconds = (zone[0] === '-' ? -1 : 1) * (zoneHours * 3600 + zoneMinutes * 60);
+  }
+
+  const seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second;
+  return (seconds - offsetSeconds) * MS_PER_SECOND + millis;
+}
+
+/**
+ * Decode a raw field value according to its declared type
+ *
+ * @param {string} value - Raw field value
+ * @param {FieldType} type - Declared type
+ * @returns {TypedFieldValue} Decoded value (the raw string if it does not match the type)
+ */
+export function decodeFieldValue(value: string, type: FieldType): TypedFieldValue {
+  switch (type) {
+    case 'integer':
+      return INTEGER_PATTERN.test(value) ? Number(value) : value;
+    case 'float':
+      return DECIMAL_PATTERN.test(value) ? Number(value) : value;
+    case 'timestamp': {
+      const millis = parseTimestampMillis(value);
+      return millis === null ? value : new Date(millis);
+    }
+    default:
+      return value;
+  }
+}
+
+/**
+ * Infer the narrowest type that fits a raw value
+ *
+ * Numbers with leading zeros (zip codes, padded IDs) are inferred as strings.
+ *
+ * @param {string} value - Raw field value
+ * @returns {FieldType} Inferred type
+ */
+export function inferFieldType(value: string): FieldType {
+  if (LEADING_ZERO_PATTERN.test(value)) {
+    return 'string';
+  }
+  if (INTEGER_PATTERN.test(value)) {
+    return 'integer';
+  }
+  if (DECIMAL_PATTERN.test(value)) {
+    return 'float';
+  }
+  if (parseTimestampMillis(value) !== null) {
+    return 'timestamp';
+  }
+  return 'string';
+}
+
+/**
+ * Widen two observed types to one that fits both
+ *
+ * @param {FieldType} current - Type seen so far
+ * @param {FieldType} observed - Type of a new value
+ * @returns {FieldType} 'float' for integer + float, 'string' for any other mismatch
+ */
+export function mergeFieldTypes(current: FieldType, observed: FieldType): FieldType {
+  if (current === observed) {
+    return current;
+  }
+  if ((current === 'integer' && observed === 'float') || (current === 'float' && observed === 'integer')) {
+    return 'float';
+  }
+  return 'string';
+}
+
+/**
+ * Per-table field schemas, declared explicitly or learned from GET responses
+ */
+export class FieldSchemaCache {
+  private readonly learn: boolean;
+  private readonly schemas = new Map<string, { types: FieldSchema; declared: boolean }>();
+
+  /**
+   * @param {boolean} [learn=false] - Infer field types of tables without a declared schema
+   */
+  constructor(learn = false) {
+    this.learn = learn;
+  }
+
+  /**
+   * Declare the field types of a table (an empty schema drops it)
+   *
+   * @param {string} table - Table name
+   * @param {FieldSchema} schema - Field types
+   * @returns {void}
+   */
+  set(table: string, schema: FieldSchema): void {
+    const entries = Object.entries(schema);
+    entries.forEach(([field, type]) => {
+      if (!isFieldType(type)) {
+        throw new TypeError(`Unknown field type for ${field}: ${String(type)}`);
+      }
+    });
+    if (entries.length === 0) {
+      this.schemas.delete(table);
+      return;
+    }
+    this.schemas.set(table, { types: { ...schema }, declared: true });
+  }
+
+  /**
+   * Get the declared or learned schema of a table
+   *
+   * @param {string} table - Table name
+   * @returns {FieldSchema | undefined} Copy of the schema, or undefined if the table has none
+   */
+  get(table: string): FieldSchema | undefined {
+    const entry = this.schemas.get(table);
+    return entry ? { ...entry.types } : undefined;
+  }
+
+  /**
+   * Decode a document's fields with its table's schema, learning types if enabled
+   *
+   * @param {string} table - Table name
+   * @param {Document} document - Raw document
+   * @returns {TypedDocument} Document with decoded field values
+   */
+  decode(table: string, document: Document): TypedDocument {
+    let entry = this.schemas.get(table);
+    if (!entry && this.learn) {
+      entry = { types: {}, declared: false };
+      this.schemas.set(table, entry);
+    }
+
+    const fields: Record<string, TypedFieldValue> = {};
+    Object.entries(document.fields).forEach(([field, value]) => {
+      if (!entry) {
+        fields[field] = value;
+        return;
+      }
+      let type = entry.types[field];
+      if (!entry.declared) {
+        const observed = inferFieldType(value);
+        type = type === undefined ? observed : mergeFieldTypes(type, observed);
+        entry.types[field] = type;
+      }
+      fields[field] = type === undefined ? value : decodeFieldValue(value, type);
+    });
+
+    return { primaryKey: document.primaryKey, fields };
+  }
+}
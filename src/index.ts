@@ -9,15 +9,82 @@
 
 export { MygramClient } from './client';
 export { NativeMygramClient } from './native-client';
-export { createMygramClient, isNativeAvailable, getClientType } from './client-factory';
+export {
+  createMygramClient,
+  createInfoPoller,
+  createMetricsCollector,
+  createExpressionCache,
+  createLocalIndex,
+  createNgramFilter,
+  loadNgramFilter,
+  createMemoryPressureMonitor,
+  batchConvertSearchExpressions,
+  estimateQueryCost,
+  searchKey,
+  countKey,
+  generateNgramHashes,
+  generateHybridNgramHashes,
+  generateNgramBatch,
+  isNativeAvailable,
+  getClientType
+} from './client-factory';
+export { InfoPoller, NativeInfoPoller } from './info-poller';
+export type { InfoSource } from './info-poller';
+export { MetricsAccumulator, MetricsCollector, NativeMetricsCollector } from './server-metrics';
+export type { MetricsCollectorOptions } from './server-metrics';
+export { ExpressionCache, parseExpression } from './expression-cache';
+export type { ParsedExpression, ExpressionCacheStats } from './expression-cache';
+export { LocalIndex, compareSortKeys } from './local-index';
+export type { LocalIndexOptions, LocalIndexStats } from './local-index';
+export { NgramBloomFilter } from './ngram-filter';
+export type { NgramFilterOptions, NgramFilterStats } from './ngram-filter';
+export { MemoryPressureMonitor, classifyMemoryHealth, readMemoryHealthJs } from './memory-pressure';
+export type { MemoryHealth, MemoryHealthStatus, MemoryPressureOptions, ResizableCache } from './memory-pressure';
+export {
+  SingleFlight,
+  canonicalCountKey,
+  canonicalSearchKey,
+  canonicalizeExpression,
+  canonicalizeTerms,
+  escapeQueryTerm,
+  normalizeQueryTerm
+} from './query-key';
+export type { CanonicalTerms } from './query-key';
+export { TermStatsCache, simplifySearchExpressionBySelectivity } from './term-stats';
+export type { TermStatsOptions, TermStatsCacheStats, OrderedTerms } from './term-stats';
+export { classifyQueryCost, estimateQueryCostJs, generateHybridNgrams, isCjkIdeograph } from './query-cost';
+export type { QueryCost, QueryCostClass, QueryCostOptions, TermCost } from './query-cost';
+export { generateHybridNgramHashesJs, generateNgramHashesJs, hashNgram } from './ngram-hash';
+export {
+  fromNativeNgramBatch,
+  generateNgramBatchJs,
+  getDocumentNgrams,
+  packDocuments,
+  unpackDocuments
+} from './ngram-batch';
+export type { NgramBatch, NgramBatchOptions, NgramBatchOutput, PackedDocuments } from './ngram-batch';
+export { analyzeExpression, analyzeTerms, dedupeTerms, prepareTerms } from './query-analysis';
+export type { QueryAnalysis, QueryVerdict, PreparedTerms } from './query-analysis';
 export {
   parseSearchExpression,
   convertSearchExpression,
+  convertSearchExpressions,
+  unpackConversions,
   simplifySearchExpression,
   hasComplexExpression,
   toQueryString
 } from './search-expression';
-export type { SearchExpression } from './search-expression';
+export type { SearchExpression, ConvertedExpression, PackedConversions } from './search-expression';
+export { flattenQueryAst, formatQueryAst, parseQueryAst, simplifyQueryAst } from './query-ast';
+export type { QueryNode } from './query-ast';
+export { buildColumnarDocuments, getColumnValue, isDecimalNumber } from './columnar';
+export {
+  FieldSchemaCache,
+  decodeFieldValue,
+  inferFieldType,
+  mergeFieldTypes,
+  parseTimestampMillis
+} from './field-schema';
 export type {
   ClientConfig,
   SearchResult,
@@ -25,10 +92,22 @@ export type {
   CountResponse,
   Document,
   ServerInfo,
+  InfoSnapshot,
+  MetricsWindow,
+  ServerMetrics,
+  QueryNormalization,
   ReplicationStatus,
   SearchOptions,
   CountOptions,
-  DebugInfo
+  DebugInfo,
+  NumericColumn,
+  StringColumn,
+  FieldColumn,
+  ColumnarDocuments,
+  FieldType,
+  FieldSchema,
+  TypedFieldValue,
+  TypedDocument
 } from './types';
 export {
   MygramError, ConnectionError, ProtocolError, TimeoutError
@@ -0,0 +1,298 @@
+/**
+ * Cached INFO polling
+ *
+ * Health checks and dashboards read server statistics far more often than
+ * they change. A poller refreshes INFO on a dedicated connection at a fixed
+ * interval and serves the latest snapshot without a round trip.
+ */
+
+import { ClientConfig, InfoSnapshot, ServerInfo } from './types';
+import { ConnectionError } from './errors';
+
+const DEFAULT_INTERVAL_MS = 1000;
+
+/**
+ * Client polled by InfoPoller (a dedicated MygramClient or NativeMygramClient)
+ */
+export interface InfoSource {
+  connect(): Promise<void>;
+  disconnect(): void;
+  isConnected(): boolean;
+  info(): Promise<ServerInfo>;
+}
+
+// Server info as returned by the native binding
+export interface NativeServerInfo {
+  version: string;
+  uptime_seconds: number;
+  total_requests: number;
+  active_connections: number;
+  index_size_bytes: number;
+  doc_count: number;
+  tables: string[];
+  values: Record<string, string>;
+}
+
+// Native poller binding interface
+interface NativeInfoPollerBinding {
+  createInfoPoller(host: string, port: number, timeout: number, intervalMs: number): unknown;
+  startInfoPoller(poller: unknown): boolean;
+  destroyInfoPoller(poller: unknown): void;
+  getInfoSnapshot(poller: unknown): { info: NativeServerInfo; captured_at_ms: number; sequence: number } | null;
+  getInfoPollerError(poller: unknown): string;
+}
+
+/**
+ * Convert native server info to ServerInfo
+ *
+ * @param {NativeServerInfo} raw - Server info from the native binding
+ * @returns {ServerInfo} Server info
+ */
+export function fromNativeServerInfo(raw: NativeServerInfo): ServerInfo {
+  return {
+    version: raw.version,
+    uptimeSeconds: raw.uptime_seconds,
+    totalRequests: raw.total_requests,
+    activeConnections: raw.active_connections,
+    indexSizeBytes: raw.index_size_bytes,
+    docCount: raw.doc_count,
+    tables: raw.tables,
+    values: raw.values
+  };
+}
+
+/**
+ * INFO poller driven by the event loop
+ *
+ * The poller owns its client: it connects on start() and disconnects on stop().
+ * A failed poll keeps the previous snapshot, records the error and reconnects
+ * on the next tick.
+ */
+export class InfoPoller {
+  private source: InfoSource;
+  private intervalMs: number;
+  private timer: NodeJS.Timeout | null = null;
+  private inFlight = false;
+  private snapshot: InfoSnapshot | undefined;
+  private sequence = 0;
+  private lastError = '';
+  private listener: ((snapshot: InfoSnapshot) => void) | undefined;
+
+  /**
+   * Create a new INFO poller
+   *
+   * @param {InfoSource} source - Dedicated client to poll
+   * @param {number} [intervalMs=1000] - Delay between polls
+   */
+  constructor(source: InfoSource, intervalMs = DEFAULT_INTERVAL_MS) {
+    this.source = source;
+    this.intervalMs = intervalMs;
+  }
+
+  /**
+   * Register a listener called after each successful poll
+   *
+   * @param {Function} listener - Receives each new snapshot
+   * @returns {void}
+   */
+  onSnapshot(listener: (snapshot: InfoSnapshot) => void): void {
+    this.listener = listener;
+  }
+
+  /**
+   * Poll once, then keep polling in the background
+   *
+   * @returns {Promise<void>} Resolves after the first successful poll
+   * @throws {ConnectionError} If the first poll fails
+   */
+  async start(): Promise<void> {
+    if (this.timer) {
+      return;
+    }
+
+    await this.pollNow();
+    this.timer = setInterval(() => {
+      if (this.inFlight) return;
+      this.pollNow().catch(() => {
+        // Recorded in lastError; the next tick retries
+      });
+    }, this.intervalMs);
+    this.timer.unref();
+  }
+
+  /**
+   * Stop polling and close the connection (the latest snapshot stays available)
+   *
+   * @returns {void}
+   */
+  stop(): void {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+    }
+    this.source.disconnect();
+  }
+
+  /**
+   * Check if background polling is active
+   *
+   * @returns {boolean} True if running
+   */
+  isRunning(): boolean {
+    return this.timer !== null;
+  }
+
+  /**
+   * Refresh the snapshot now, outside the schedule
+   *
+   * @returns {Promise<InfoSnapshot>} New snapshot
+   * @throws {ConnectionError} If the poll fails
+   */
+  async pollNow(): Promise<InfoSnapshot> {
+    let snapshot: InfoSnapshot;
+    this.inFlight = true;
+    try {
+      if (!this.source.isConnected()) {
+        await this.source.connect();
+      }
+      const info = await this.source.info();
+      this.sequence += 1;
+      snapshot = { info, capturedAt: Date.now(), sequence: this.sequence };
+      this.snapshot = snapshot;
+      this.lastError = '';
+    } catch (error) {
+      // Reconnect on the next attempt; the connection state is unknown
+      this.source.disconnect();
+      this.lastError = error instanceof Error ? error.message : String(error);
+      throw error instanceof ConnectionError ? error : new ConnectionError(this.lastError);
+    } finally {
+      this.inFlight = false;
+    }
+
+    if (this.listener) {
+      this.listener(snapshot);
+    }
+    return snapshot;
+  }
+
+  /**
+   * Get the latest snapshot
+   *
+   * @returns {InfoSnapshot | undefined} Snapshot, or undefined before the first successful poll
+   */
+  latest(): InfoSnapshot | undefined {
+    return this.snapshot;
+  }
+
+  /**
+   * Get the error of the most recent poll
+   *
+   * @returns {string} Error message (empty if the last poll succeeded)
+   */
+  getLastError(): string {
+    return this.lastError;
+  }
+}
+
+/**
+ * INFO poller running on a native background thread
+ *
+ * Polling does not depend on the event loop, so snapshots stay fresh while
+ * JavaScript is busy.
+ */
+export class NativeInfoPoller {
+  private native: NativeInfoPollerBinding;
+  private config: ClientConfig;
+  private intervalMs: number;
+  private handle: unknown = null;
+  private finalSnapshot: InfoSnapshot | undefined;
+  private finalError = '';
+
+  /**
+   * Create a new native INFO poller
+   *
+   * @param {NativeInfoPollerBinding} native - Native binding object
+   * @param {ClientConfig} [config={}] - Connection configuration
+   * @param {number} [intervalMs=1000] - Delay between polls
+   */
+  constructor(native: NativeInfoPollerBinding, config: ClientConfig = {}, intervalMs = DEFAULT_INTERVAL_MS) {
+    this.native = native;
+    this.config = config;
+    this.intervalMs = intervalMs;
+  }
+
+  /**
+   * Poll once, then keep polling in the background
+   *
+   * @returns {Promise<void>} Resolves after the first successful poll
+   * @throws {ConnectionError} If the first poll fails
+   */
+  async start(): Promise<void> {
+    if (this.handle) {
+      return;
+    }
+
+    const handle = this.native.createInfoPoller(
+      this.config.host ?? '127.0.0.1',
+      this.config.port ?? 11016,
+      this.config.timeout ?? 5000,
+      this.intervalMs
+    );
+    if (!this.native.startInfoPoller(handle)) {
+      const error = this.native.getInfoPollerError(handle);
+      this.native.destroyInfoPoller(handle);
+      this.finalError = error || 'Failed to poll INFO';
+      throw new ConnectionError(this.finalError);
+    }
+    this.handle = handle;
+  }
+
+  /**
+   * Stop polling and close the connection (the latest snapshot stays available)
+   *
+   * @returns {void}
+   */
+  stop(): void {
+    if (!this.handle) {
+      return;
+    }
+    this.finalSnapshot = this.latest();
+    this.finalError = this.getLastError();
+    this.native.destroyInfoPoller(this.handle);
+    this.handle = null;
+  }
+
+  /**
+   * Check if background polling is active
+   *
+   * @returns {boolean} True if running
+   */
+  isRunning(): boolean {
+    return this.handle !== null;
+  }
+
+  /**
+   * Get the latest snapshot
+   *
+   * @returns {InfoSnapshot | undefined} Snapshot, or undefined before the first successful poll
+   */
+  latest(): InfoSnapshot | undefined {
+    if (!this.handle) {
+      return this.finalSnapshot;
+    }
+    const raw = this.native.getInfoSnapshot(this.handle);
+    if (!raw) {
+      return undefined;
+    }
+    return { info: fromNativeServerInfo(raw.info), capturedAt: raw.captured_at_ms, sequence: raw.sequence };
+  }
+
+  /**
+   * Get the error of the most recent poll
+   *
+   * @returns {string} Error message (empty if the last poll succeeded)
+   */
+  getLastError(): string {
+    return this.handle ? this.native.getInfoPollerError(this.handle) : this.finalError;
+  }
+}
@@ -0,0 +1,496 @@
+/**
+ * In-process n-gram inverted index
+ *
+ * For small reference tables a network round trip to the server costs more
+ * than the search itself. LocalIndex indexes documents the way the server
+ * does (normalize, split into hybrid n-grams, one posting list per n-gram)
+ * and answers search/count with the same term semantics as client.search,
+ * without leaving the process.
+ */
+
+import { CountOptions, CountResponse, QueryNormalization, SearchOptions, SearchResponse } from './types';
+import { analyzeTerms } from './query-analysis';
+import { normalizeQueryTerm } from './query-key';
+import { generateHybridNgrams } from './query-cost';
+
+const DEFAULT_LIMIT = 1000;
+const MIN_REMOVED_FOR_COMPACTION = 1024;
+const BYTES_PER_JS_POSTING = 4;
+const DIGITS = /^[0-9]+$/;
+
+/**
+ * Local index options
+ *
+ * Mirror the server's table settings to get the results the server would.
+ * Normalization applies to documents and terms alike; unlike query keys it
+ * defaults to what the server does out of the box (NFKC, narrow width).
+ */
+export interface LocalIndexOptions extends QueryNormalization {
+  /** Server's ngram_size for non-CJK text (default: 2) */
+  asciiNgramSize?: number;
+  /** Server's kanji_ngram_size (default: 1) */
+  kanjiNgramSize?: number;
+}
+
+/**
+ * Local index counters
+ */
+export interface LocalIndexStats {
+  /** Live documents */
+  documents: number;
+  /** Removed or replaced documents still in posting lists */
+  removed: number;
+  /** Distinct n-grams (posting lists) */
+  ngrams: number;
+  /** Posting list entries */
+  postings: number;
+  /** Size of all posting lists (compressed natively, 4 bytes per entry in JavaScript) */
+  postingBytes: number;
+}
+
+// Native local index binding interface
+interface NativeLocalIndexBinding {
+  createLocalIndex(options: LocalIndexOptions): unknown;
+  destroyLocalIndex(index: unknown): void;
+  localIndexAdd(index: unknown, primaryKey: string, text: string, fieldKeys: string[], fieldValues: string[]): void;
+  localIndexRemove(index: unknown, primaryKey: string): boolean;
+  localIndexSearch(
+    index: unknown,
+    query: string,
+    limit: number,
+    offset: number,
+    andTerms: string[],
+    notTerms: string[],
+    filterKeys: string[],
+    filterValues: string[],
+    sortColumn: string,
+    sortDesc: boolean
+  ): { total_count: number; primary_keys: string[] };
+  localIndexCount(
+    index: unknown,
+    query: string,
+    andTerms: string[],
+    notTerms: string[],
+    filterKeys: string[],
+    filterValues: string[]
+  ): number;
+  getLocalIndexStats(index: unknown): {
+    documents: number;
+    removed: number;
+    ngrams: number;
+    postings: number;
+    posting_bytes: number;
+  };
+  compactLocalIndex(index: unknown): void;
+  clearLocalIndex(index: unknown): void;
+}
+
+// Indexed document (slot of a document id)
+interface DocumentEntry {
+  primaryKey: string;
+  fields: Map<string, string>;
+  alive: boolean;
+}
+
+/**
+ * Compare sort keys: digit-only values first, as numbers, then the rest as strings
+ *
+ * Keeping the two kinds apart makes this a total order (comparing pairs of
+ * mixed keys one way or the other is not transitive); same order as the
+ * native index.
+ *
+ * @param {string} a - First key
+ * @param {string} b - Second key
+ * @returns {number} Negative, zero or positive
+ */
+export function compareSortKeys(a: string, b: string): number {
+  const aIsNumber = DIGITS.test(a);
+  const bIsNumber = DIGITS.test(b);
+  if (aIsNumber !== bIsNumber) {
+    return aIsNumber ? -1 : 1;
+  }
+  if (aIsNumber) {
+    const aDigits = a.replace(/^0+(?=.)/, '');
+    const bDigits = b.replace(/^0+(?=.)/, '');
+    if (aDigits.length !== bDigits.length) {
+      return aDigits.length < bDigits.length ? -1 : 1;
+    }
+    if (aDigits !== bDigits) {
+      return aDigits < bDigits ? -1 : 1;
+    }
+  }
+  if (a === b) {
+    return 0;
+  }
+  return a < b ? -1 : 1;
+}
+
+/**
+ * Keep the ids (ascending) that are in a posting list
+ *
+ * @param {number[]} list - Posting list (ascending)
+ * @param {number[]} docIds - Candidate ids (ascending)
+ * @returns {number[]} Ids present in both
+ */
+function intersect(list: number[], docIds: number[]): number[] {
+  const kept: number[] = [];
+  let j = 0;
+  for (let i = 0; i < docIds.length && j < list.length; i += 1) {
+    while (j < list.length && list[j] < docIds[i]) {
+      j += 1;
+    }
+    if (j < list.length && list[j] === docIds[i]) {
+      kept.push(docIds[i]);
+    }
+  }
+  return kept;
+}
+
+/**
+ * In-process n-gram inverted index
+ *
+ * A document matches a term when it contains every n-gram of the term; as
+ * on the server, positions are not checked. A query matches documents that
+ * match all positive terms and no NOT term; a term too short to form an
+ * n-gram matches nothing. Filters compare field values for equality, and
+ * results are ordered by primary key (or a field), comparing digit-only
+ * values as numbers.
+ *
+ * With a native binding, documents live in delta-compressed posting lists in
+ * the native library (call destroy() when done). Without one, posting lists
+ * are plain arrays of document ids.
+ */
+export class LocalIndex {
+  private native: NativeLocalIndexBinding | null;
+  private handle: unknown = null;
+  private options: LocalIndexOptions;
+  private documents: DocumentEntry[] = [];
+  private ids = new Map<string, number>();
+  private postings = new Map<string, number[]>();
+
+  /**
+   * Create an empty index
+   *
+   * @param {LocalIndexOptions} [options={}] - N-gram sizes and normalization
+   * @param {NativeLocalIndexBinding | null} [native=null] - Native binding object
+   */
+  constructor(options: LocalIndexOptions = {}, native: NativeLocalIndexBinding | null = null) {
+    this.options = { nfkc: true, width: 'narrow', lower: false, ...options };
+    this.native = native;
+    if (native) {
+      this.handle = native.createLocalIndex(this.options);
+    }
+  }
+
+  /**
+   * Add a document, replacing any document with the same primary key
+   *
+   * @param {string} primaryKey - Primary key
+   * @param {string} text - Indexed text
+   * @param {Record<string, string>} [fields={}] - Filter fields
+   * @returns {void}
+   */
+  add(primaryKey: string, text: string, fields: Record<string, string> = {}): void {
+    if (this.native && this.handle) {
+      this.native.localIndexAdd(this.handle, primaryKey, text, Object.keys(fields), Object.values(fields));
+      return;
+    }
+
+    this.removeDocument(primaryKey);
+    const docId = this.documents.length;
+    this.documents.push({ primaryKey, fields: new Map(Object.entries(fields)), alive: true });
+    this.ids.set(primaryKey, docId);
+    this.ngrams(text).forEach((ngram) => {
+      const list = this.postings.get(ngram);
+      if (list) {
+        list.push(docId);
+      } else {
+        this.postings.set(ngram, [docId]);
+      }
+    });
+    this.compactIfNeeded();
+  }
+
+  /**
+   * Remove a document
+   *
+   * @param {string} primaryKey - Primary key
+   * @returns {boolean} True if the document was indexed
+   */
+  remove(primaryKey: string): boolean {
+    if (this.native && this.handle) {
+      return this.native.localIndexRemove(this.handle, primaryKey);
+    }
+    const removed = this.removeDocument(primaryKey);
+    this.compactIfNeeded();
+    return removed;
+  }
+
+  /**
+   * Search for documents (same options as client.search, without the table)
+   *
+   * @param {string} query - Search query text
+   * @param {SearchOptions} [options={}] - Limit (0 for all), offset, terms, filters and sort order
+   * @returns {SearchResponse} Matching primary keys and the total count
+   * @throws {Error} If the query has no positive term
+   */
+  search(query: string, options: SearchOptions = {}): SearchResponse {
+    const {
+      limit = DEFAULT_LIMIT,
+      offset = 0,
+      andTerms = [],
+      notTerms = [],
+      filters = {},
+      sortColumn = '',
+      sortDesc = true
+    } = options;
+
+    if (this.native && this.handle) {
+      const raw = this.native.localIndexSearch(
+        this.handle,
+        query,
+        limit,
+        offset,
+        andTerms,
+        notTerms,
+        Object.keys(filters),
+        Object.values(filters),
+        sortColumn,
+        sortDesc
+      );
+      return {
+        results: raw.primary_keys.map((primaryKey) => ({ primaryKey })),
+        totalCount: raw.total_count
+      };
+    }
+
+    const matches = this.match(query, andTerms, notTerms, filters);
+    const key = (docId: number): string => {
+      const document = this.documents[docId];
+      return sortColumn === '' ? document.primaryKey : (document.fields.get(sortColumn) ?? '');
+    };
+    matches.sort((a, b) => {
+      const order = compareSortKeys(key(a), key(b)) || a - b;
+      return sortDesc ? -order : order;
+    });
+
+    const end = limit === 0 ? matches.length : offset + limit;
+    return {
+      results: matches.slice(offset, end).map((docId) => ({ primaryKey: this.documents[docId].primaryKey })),
+      totalCount: matches.length
+    };
+  }
+
+  /**
+   * Count matching documents
+   *
+   * @param {string} query - Search query text
+   * @param {CountOptions} [options={}] - Terms and filters
+   * @returns {CountResponse} Matching documents
+   * @throws {Error} If the query has no positive term
+   */
+  count(query: string, options: CountOptions = {}): CountResponse {
+    const { andTerms = [], notTerms = [], filters = {} } = options;
+    if (this.native && this.handle) {
+      return {
+        count: this.native.localIndexCount(
+          this.handle,
+          query,
+          andTerms,
+          notTerms,
+          Object.keys(filters),
+          Object.values(filters)
+        )
+      };
+    }
+    return { count: this.match(query, andTerms, notTerms, filters).length };
+  }
+
+  /**
+   * Get index counters
+   *
+   * @returns {LocalIndexStats} Counters
+   */
+  getStats(): LocalIndexStats {
+    if (this.native && this.handle) {
+      const raw = this.native.getLocalIndexStats(this.handle);
+      return {
+        documents: raw.documents,
+        removed: raw.removed,
+        ngrams: raw.ngrams,
+        postings: raw.postings,
+        postingBytes: raw.posting_bytes
+      };
+    }
+
+    let postings = 0;
+    this.postings.forEach((list) => {
+      postings += list.length;
+    });
+    return {
+      documents: this.ids.size,
+      removed: this.documents.length - this.ids.size,
+      ngrams: this.postings.size,
+      postings,
+      postingBytes: postings * BYTES_PER_JS_POSTING
+    };
+  }
+
+  /**
+   * Rebuild posting lists without removed documents
+   *
+   * @returns {void}
+   */
+  compact(): void {
+    if (this.native && this.handle) {
+      this.native.compactLocalIndex(this.handle);
+      return;
+    }
+    if (this.documents.length === this.ids.size) {
+      return;
+    }
+
+    const newIds = new Array<number>(this.documents.length);
+    const documents: DocumentEntry[] = [];
+    this.documents.forEach((document, docId) => {
+      if (document.alive) {
+        newIds[docId] = documents.length;
+        documents.push(document);
+      }
+    });
+    this.ids.forEach((docId, primaryKey) => this.ids.set(primaryKey, newIds[docId]));
+
+    this.postings.forEach((list, ngram) => {
+      const compacted = list.filter((docId) => this.documents[docId].alive).map((docId) => newIds[docId]);
+      if (compacted.length === 0) {
+        this.postings.delete(ngram);
+      } else {
+        this.postings.set(ngram, compacted);
+      }
+    });
+    this.documents = documents;
+  }
+
+  /**
+   * Remove all documents
+   *
+   * @returns {void}
+   */
+  clear(): void {
+    if (this.native && this.handle) {
+      this.native.clearLocalIndex(this.handle);
+      return;
+    }
+    this.documents = [];
+    this.ids.clear();
+    this.postings.clear();
+  }
+
+  /**
+   * Release the native index (the instance must not be used afterwards)
+   *
+   * @returns {void}
+   */
+  destroy(): void {
+    if (this.native && this.handle) {
+      this.native.destroyLocalIndex(this.handle);
+      this.handle = null;
+    }
+    this.clear();
+  }
+
+  private ngrams(text: string): string[] {
+    const { asciiNgramSize = 2, kanjiNgramSize = 1 } = this.options;
+    const normalized = normalizeQueryTerm(text, this.options);
+    return Array.from(new Set(generateHybridNgrams(normalized, asciiNgramSize, kanjiNgramSize)));
+  }
+
+  private removeDocument(primaryKey: string): boolean {
+    const docId = this.ids.get(primaryKey);
+    if (docId === undefined) {
+      return false;
+    }
+    this.documents[docId].alive = false;
+    this.ids.delete(primaryKey);
+    return true;
+  }
+
+  private compactIfNeeded(): void {
+    const removed = this.documents.length - this.ids.size;
+    if (removed >= MIN_REMOVED_FOR_COMPACTION && removed * 2 >= this.documents.length) {
+      this.compact();
+    }
+  }
+
+  /**
+   * Posting lists of every n-gram of a term
+   *
+   * @returns {number[][] | null} Lists, or null if the term cannot match (no n-gram, or one never indexed)
+   */
+  private termLists(term: string): number[][] | null {
+    const ngrams = this.ngrams(term);
+    if (ngrams.length === 0) {
+      return null;
+    }
+    const lists: number[][] = [];
+    for (let i = 0; i < ngrams.length; i += 1) {
+      const list = this.postings.get(ngrams[i]);
+      if (!list) {
+        return null;
+      }
+      lists.push(list);
+    }
+    return lists;
+  }
+
+  /**
+   * Find the documents matching a query, in document id order
+   */
+  private match(query: string, andTerms: string[], notTerms: string[], filters: Record<string, string>): number[] {
+    const analysis = analyzeTerms(query, andTerms, notTerms);
+    if (analysis.verdict === 'invalid') {
+      throw new Error(analysis.reason);
+    }
+    if (analysis.verdict === 'empty') {
+      return [];
+    }
+
+    // Every n-gram of every positive term, intersected from the shortest list up
+    const lists: number[][] = [];
+    const positive = [query, ...andTerms];
+    for (let i = 0; i < positive.length; i += 1) {
+      const termLists = this.termLists(positive[i]);
+      if (!termLists) {
+        return [];
+      }
+      lists.push(...termLists);
+    }
+    lists.sort((a, b) => a.length - b.length);
+
+    let matches = lists[0].filter((docId) => this.documents[docId].alive);
+    for (let i = 1; i < lists.length && matches.length > 0; i += 1) {
+      matches = intersect(lists[i], matches);
+    }
+
+    // A NOT term removes the documents containing all of its n-grams
+    notTerms.forEach((term) => {
+      const termLists = matches.length > 0 ? this.termLists(term) : null;
+      if (termLists) {
+        let hits = matches;
+        termLists.forEach((list) => {
+          hits = intersect(list, hits);
+        });
+        const excluded = new Set(hits);
+        matches = matches.filter((docId) => !excluded.has(docId));
+      }
+    });
+
+    const filterEntries = Object.entries(filters);
+    if (filterEntries.length > 0) {
+      matches = matches.filter((docId) =>
+        filterEntries.every(([key, value]) => this.documents[docId].fields.get(key) === value)
+      );
+    }
+    return matches;
+  }
+}
@@ -0,0 +1,275 @@
+/**
+ * Memory-pressure-adaptive cache sizing
+ *
+ * Caches sized for a healthy host can push a memory-limited container into an
+ * OOM kill. A monitor samples memory health at a fixed interval and tells
+ * subscribers when the status changes; subscribed caches evict down to a
+ * fraction of their capacity under WARNING or CRITICAL and get their full
+ * capacity back once HEALTHY.
+ */
+
+import * as os from 'os';
+
+const DEFAULT_INTERVAL_MS = 5000;
+const DEFAULT_WARNING_FRACTION = 0.5;
+const DEFAULT_CRITICAL_FRACTION = 0.1;
+
+// Available memory ratios of the status bands (as in the native memory_utils)
+const HEALTHY_THRESHOLD = 0.2;
+const WARNING_THRESHOLD = 0.1;
+
+/**
+ * Memory health status
+ */
+export type MemoryHealthStatus = 'HEALTHY' | 'WARNING' | 'CRITICAL' | 'UNKNOWN';
+
+/**
+ * One memory health reading
+ */
+export interface MemoryHealth {
+  status: MemoryHealthStatus;
+  /** Physical memory, or the cgroup limit if lower */
+  totalBytes: number;
+  /** Memory that can still be used without pressure */
+  availableBytes: number;
+  /** The figures are the container's budget rather than the host's */
+  cgroupLimited: boolean;
+}
+
+/**
+ * Memory pressure monitor options
+ */
+export interface MemoryPressureOptions {
+  /** Delay between health checks (default: 5000) */
+  intervalMs?: number;
+  /** Capacity kept by subscribed caches on WARNING (default: 0.5) */
+  warningFraction?: number;
+  /** Capacity kept by subscribed caches on CRITICAL (default: 0.1) */
+  criticalFraction?: number;
+  /** Health readings (default: the native binding, else readMemoryHealthJs) */
+  source?: () => MemoryHealth;
+}
+
+/**
+ * Cache whose capacity a monitor can change (e.g. ExpressionCache)
+ */
+export interface ResizableCache {
+  resize(capacity: number): void;
+  getStats(): { capacity: number };
+}
+
+// Native memory binding interface
+interface NativeMemoryBinding {
+  getMemoryHealth(): {
+    status: MemoryHealthStatus;
+    total_physical_bytes: number;
+    available_physical_bytes: number;
+    cgroup_limited: boolean;
+  };
+}
+
+/**
+ * Classify an available memory ratio
+ *
+ * @param {number} totalBytes - Total memory
+ * @param {number} availableBytes - Available memory
+ * @returns {MemoryHealthStatus} Status (UNKNOWN if the total is unknown)
+ */
+export function classifyMemoryHealth(totalBytes: number, availableBytes: number): MemoryHealthStatus {
+  if (!(totalBytes > 0)) {
+    return 'UNKNOWN';
+  }
+  const ratio = availableBytes / totalBytes;
+  if (ratio >= HEALTHY_THRESHOLD) {
+    return 'HEALTHY';
+  }
+  return ratio >= WARNING_THRESHOLD ? 'WARNING' : 'CRITICAL';
+}
+
+/**
+ * Read memory health with Node.js APIs
+ *
+ * process.constrainedMemory() and process.availableMemory() follow the
+ * cgroup limit; available memory counts page cache as used, so the reading is
+ * more conservative than the native one.
+ *
+ * @returns {MemoryHealth} Reading
+ */
+export function readMemoryHealthJs(): MemoryHealth {
+  const hostTotal = os.totalmem();
+  const constrained = process.constrainedMemory();
+  const cgroupLimited = constrained > 0 && constrained < hostTotal;
+  const totalBytes = cgroupLimited ? constrained : hostTotal;
+  const availableBytes = Math.min(process.availableMemory(), totalBytes);
+  return { status: classifyMemoryHealth(totalBytes, availableBytes), totalBytes, availableBytes, cgroupLimited };
+}
+
+/**
+ * Samples memory health on a timer and notifies subscribers of changes
+ *
+ * Listeners are called only when the status changes. An UNKNOWN reading is
+ * ignored, so a failed check leaves caches as they are. The timer does not
+ * keep the process alive.
+ */
+export class MemoryPressureMonitor {
+  private intervalMs: number;
+  private warningFraction: number;
+  private criticalFraction: number;
+  private source: () => MemoryHealth;
+  private timer: NodeJS.Timeout | null = null;
+  private status: MemoryHealthStatus = 'UNKNOWN';
+  private listeners = new Map<number, (status: MemoryHealthStatus) => void>();
+  private lastSubscription = 0;
+
+  /**
+   * Create a new memory pressure monitor
+   *
+   * @param {MemoryPressureOptions} [options={}] - Interval, capacity fractions and reading source
+   * @param {NativeMemoryBinding | null} [native=null] - Native binding object (cgroup-aware readings)
+   */
+  constructor(options: MemoryPressureOptions = {}, native: NativeMemoryBinding | null = null) {
+    this.intervalMs = options.intervalMs ?? DEFAULT_INTERVAL_MS;
+    this.warningFraction = options.warningFraction ?? DEFAULT_WARNING_FRACTION;
+    this.criticalFraction = options.criticalFraction ?? DEFAULT_CRITICAL_FRACTION;
+    if (options.source) {
+      this.source = options.source;
+    } else if (native) {
+      this.source = () => {
+        const raw = native.getMemoryHealth();
+        return {
+          status: raw.status,
+          totalBytes: raw.total_physical_bytes,
+          availableBytes: raw.available_physical_bytes,
+          cgroupLimited: raw.cgroup_limited
+        };
+      };
+    } else {
+      this.source = readMemoryHealthJs;
+    }
+  }
+
+  /**
+   * Register a listener for status changes
+   *
+   * The listener is called right away with the current status if one is known.
+   *
+   * @param {Function} listener - Receives each new status
+   * @returns {number} Subscription id for unsubscribe()
+   */
+  subscribe(listener: (status: MemoryHealthStatus) => void): number {
+    this.lastSubscription += 1;
+    this.listeners.set(this.lastSubscription, listener);
+    if (this.status !== 'UNKNOWN') {
+      listener(this.status);
+    }
+    return this.lastSubscription;
+  }
+
+  /**
+   * Resize a cache with the memory health status
+   *
+   * The cache's capacity at subscription is its full capacity; WARNING and
+   * CRITICAL scale it by warningFraction and criticalFraction, evicting least
+   * recently used entries.
+   *
+   * @param {ResizableCache} cache - Cache to resize
+   * @returns {number} Subscription id for unsubscribe()
+   */
+  subscribeCache(cache: ResizableCache): number {
+    const fullCapacity = cache.getStats().capacity;
+    return this.subscribe((status) => cache.resize(this.scaledCapacity(fullCapacity, status)));
+  }
+
+  /**
+   * Remove a subscription
+   *
+   * @param {number} subscription - Id returned by subscribe() or subscribeCache()
+   * @returns {void}
+   */
+  unsubscribe(subscription: number): void {
+    this.listeners.delete(subscription);
+  }
+
+  /**
+   * Check once, then keep checking in the background
+   *
+   * @returns {void}
+   */
+  start(): void {
+    if (this.timer) {
+      return;
+    }
+    this.checkNow();
+    this.timer = setInterval(() => this.checkNow(), this.intervalMs);
+    this.timer.unref();
+  }
+
+  /**
+   * Stop checking (subscriptions are kept)
+   *
+   * @returns {void}
+   */
+  stop(): void {
+    if (this.timer) {
+      clearInterval(this.timer);
+      this.timer = null;
+    }
+  }
+
+  /**
+   * Check if background checking is active
+   *
+   * @returns {boolean} True if running
+   */
+  isRunning(): boolean {
+    return this.timer !== null;
+  }
+
+  /**
+   * Check memory health now, notifying subscribers if the status changed
+   *
+   * @returns {MemoryHealth} Reading (status UNKNOWN if it failed)
+   */
+  checkNow(): MemoryHealth {
+    let health: MemoryHealth;
+    try {
+      health = this.source();
+    } catch {
+      return { status: 'UNKNOWN', totalBytes: 0, availableBytes: 0, cgroupLimited: false };
+    }
+
+    if (health.status !== 'UNKNOWN' && health.status !== this.status) {
+      this.status = health.status;
+      for (const listener of [...this.listeners.values()]) {
+        listener(health.status);
+      }
+    }
+    return health;
+  }
+
+  /**
+   * Get the last known status
+   *
+   * @returns {MemoryHealthStatus} Status (UNKNOWN before the first successful check)
+   */
+  getStatus(): MemoryHealthStatus {
+    return this.status;
+  }
+
+  /**
+   * Capacity a cache with the given full capacity keeps in a status
+   *
+   * @param {number} fullCapacity - Capacity when HEALTHY
+   * @param {MemoryHealthStatus} status - Memory health status
+   * @returns {number} Scaled capacity
+   */
+  scaledCapacity(fullCapacity: number, status: MemoryHealthStatus): number {
+    let fraction = 1;
+    if (status === 'WARNING') {
+      fraction = this.warningFraction;
+    } else if (status === 'CRITICAL') {
+      fraction = this.criticalFraction;
+    }
+    return Math.floor(fullCapacity * Math.min(Math.max(fraction, 0), 1));
+  }
+}
@@ -14,9 +14,15 @@ import {
   ReplicationStatus,
   SearchOptions,
   CountOptions,
-  DebugInfo
+  DebugInfo,
+  ColumnarDocuments,
+  FieldColumn,
+  FieldSchema,
+  FieldType,
+  TypedDocument,
+  TypedFieldValue
 } from './types';
-import { ConnectionError, ProtocolError } from './errors';
+import { ConnectionError, InputValidationError, ProtocolError } from './errors';
 import {
   DEFAULT_MAX_QUERY_LENGTH,
   ensureSafeCommandValue,
@@ -24,16 +30,47 @@ import {
   ensureSafeStringArray,
   ensureQueryLengthWithinLimit
 } from './command-utils';
+import { isFieldType } from './field-schema';
+import { fromNativeServerInfo, NativeServerInfo } from './info-poller';
+import { TermStatsCache } from './term-stats';
+import { prepareTerms } from './query-analysis';
+import { NgramBloomFilter } from './ngram-filter';
+
+// Columnar result as returned by the native binding
+interface NativeColumnarResult {
+  primary_keys: string[];
+  found: Uint8Array;
+  columns: Array<{
+    name: string;
+    kind: 'number' | 'string';
+    type?: FieldType;
+    present: Uint8Array;
+    values?: Float64Array;
+    data?: Uint8Array;
+    offsets?: Uint32Array;
+  }>;
+}
+
+// Typed document as returned by the native binding
+interface NativeTypedDocument {
+  primary_key: string;
+  fields: Record<string, TypedFieldValue>;
+}
 
 // Native binding interface
 interface NativeBinding {
-  createClient(config: { host: string; port: number; timeout: number }): unknown;
+  createClient(config: { host: string; port: number; timeout: number; learnFieldSchemas: boolean }): unknown;
   connect(client: unknown): boolean;
   disconnect(client: unknown): void;
   destroyClient(client: unknown): void;
   isConnected(client: unknown): boolean;
   search(client: unknown, table: string, query: string, limit: number, offset: number): string;
   sendCommand(client: unknown, command: string): string;
+  get(client: unknown, table: string, primaryKey: string): NativeTypedDocument;
+  getColumns(client: unknown, table: string, primaryKeys: string[], fields: string[]): NativeColumnarResult;
+  info(client: unknown): NativeServerInfo;
+  setFieldSchema(client: unknown, table: string, schema: FieldSchema): void;
+  getFieldSchema(client: unknown, table: string): FieldSchema | null;
   getLastError(client: unknown): string;
 }
 
@@ -42,7 +79,12 @@ const DEFAULT_CONFIG: Required<ClientConfig> = {
   port: 11016,
   timeout: 5000,
   recvBufferSize: 65536,
-  maxQueryLength: DEFAULT_MAX_QUERY_LENGTH
+  maxQueryLength: DEFAULT_MAX_QUERY_LENGTH,
+  learnFieldSchemas: false,
+  reorderTerms: false,
+  analyzeQueries: false,
+  singleFlight: false,
+  queryNormalization: {}
 };
 
 /**
@@ -56,6 +98,10 @@ export class NativeMygramClient {
   private native: NativeBinding;
   private clientHandle: unknown = null;
   private connected = false;
+  private declaredSchemas = new Map<string, FieldSchema>();
+  private termStats = new TermStatsCache();
+  private ngramFilters = new Map<string, NgramBloomFilter>();
+  private savedRoundTrips = 0;
 
   /**
    * Create a new native MygramDB client
@@ -87,7 +133,13 @@ export class NativeMygramClient {
       this.clientHandle = this.native.createClient({
         host: this.config.host,
         port: this.config.port,
-        timeout: this.config.timeout
+        timeout: this.config.timeout,
+        learnFieldSchemas: this.config.learnFieldSchemas
+      });
+
+      // Schemas declared before connecting live on the JS side until a handle exists
+      this.declaredSchemas.forEach((schema, table) => {
+        this.native.setFieldSchema(this.clientHandle, table, schema);
       });
 
       const result = this.native.connect(this.clientHandle);
@@ -173,18 +225,41 @@ export class NativeMygramClient {
       this.config.maxQueryLength
     );
 
-    const parts: string[] = ['SEARCH', safeTable, safeQuery];
+    let requiredTerms = andTerms;
+    let excludedTerms = notTerms;
+    if (this.config.analyzeQueries) {
+      const prepared = prepareTerms(safeQuery, andTerms, notTerms);
+      if (prepared.analysis.verdict !== 'send') {
+        // Known outcome: answer locally
+        this.savedRoundTrips += 1;
+        if (prepared.analysis.verdict === 'invalid') {
+          throw new InputValidationError(prepared.analysis.reason ?? 'Invalid query');
+        }
+        return { results: [], totalCount: 0 };
+      }
+      ({ andTerms: requiredTerms, notTerms: excludedTerms } = prepared);
+    }
+
+    if (this.rejectedByNgramFilter(safeTable, safeQuery, requiredTerms)) {
+      return { results: [], totalCount: 0 };
+    }
+
+    // Start from the rarest known term; the intersection (and so the result) is the same
+    const ordered = this.config.reorderTerms
+      ? this.termStats.reorder(safeTable, safeQuery, requiredTerms)
+      : { mainTerm: safeQuery, andTerms: requiredTerms };
+    const parts: string[] = ['SEARCH', safeTable, ordered.mainTerm];
 
     // Add AND terms
-    if (andTerms.length > 0) {
-      andTerms.forEach((term) => {
+    if (ordered.andTerms.length > 0) {
+      ordered.andTerms.forEach((term) => {
         parts.push('AND', term);
       });
     }
 
     // Add NOT terms
-    if (notTerms.length > 0) {
-      notTerms.forEach((term) => {
+    if (excludedTerms.length > 0) {
+      excludedTerms.forEach((term) => {
         parts.push('NOT', term);
       });
     }
@@ -211,8 +286,12 @@ export class NativeMygramClient {
       parts.push('LIMIT', `${limit}`);
     }
 
-    const response = await this.sendCommand(parts.join(' '));
-    return NativeMygramClient.parseSearchResponse(response);
+    const response = NativeMygramClient.parseSearchResponse(await this.sendCommand(parts.join(' ')));
+    if (this.config.reorderTerms) {
+      const lone = ordered.andTerms.length === 0 && excludedTerms.length === 0 && filterEntries.length === 0;
+      this.termStats.recordResponse(safeTable, ordered.mainTerm, lone, response.totalCount, response.debug);
+    }
+    return response;
   }
 
   /**
@@ -232,16 +311,38 @@ export class NativeMygramClient {
     ensureSafeStringArray(notTerms, 'notTerms');
     const safeFilters = ensureSafeFilters(filters);
 
-    const parts: string[] = ['COUNT', safeTable, safeQuery];
+    let requiredTerms = andTerms;
+    let excludedTerms = notTerms;
+    if (this.config.analyzeQueries) {
+      const prepared = prepareTerms(safeQuery, andTerms, notTerms);
+      if (prepared.analysis.verdict !== 'send') {
+        // Known outcome: answer locally
+        this.savedRoundTrips += 1;
+        if (prepared.analysis.verdict === 'invalid') {
+          throw new InputValidationError(prepared.analysis.reason ?? 'Invalid query');
+        }
+        return { count: 0 };
+      }
+      ({ andTerms: requiredTerms, notTerms: excludedTerms } = prepared);
+    }
+
+    if (this.rejectedByNgramFilter(safeTable, safeQuery, requiredTerms)) {
+      return { count: 0 };
+    }
+
+    const ordered = this.config.reorderTerms
+      ? this.termStats.reorder(safeTable, safeQuery, requiredTerms)
+      : { mainTerm: safeQuery, andTerms: requiredTerms };
+    const parts: string[] = ['COUNT', safeTable, ordered.mainTerm];
 
-    if (andTerms.length > 0) {
-      andTerms.forEach((term) => {
+    if (ordered.andTerms.length > 0) {
+      ordered.andTerms.forEach((term) => {
         parts.push('AND', term);
       });
     }
 
-    if (notTerms.length > 0) {
-      notTerms.forEach((term) => {
+    if (excludedTerms.length > 0) {
+      excludedTerms.forEach((term) => {
         parts.push('NOT', term);
       });
     }
@@ -255,8 +356,12 @@ export class NativeMygramClient {
       });
     }
 
-    const response = await this.sendCommand(parts.join(' '));
-    return NativeMygramClient.parseCountResponse(response);
+    const response = NativeMygramClient.parseCountResponse(await this.sendCommand(parts.join(' ')));
+    if (this.config.reorderTerms) {
+      const lone = ordered.andTerms.length === 0 && excludedTerms.length === 0 && filterEntries.length === 0;
+      this.termStats.recordResponse(safeTable, ordered.mainTerm, lone, response.count, response.debug);
+    }
+    return response;
   }
 
   /**
@@ -273,14 +378,197 @@ export class NativeMygramClient {
     return NativeMygramClient.parseDocumentResponse(response);
   }
 
+  /**
+   * Declare the filter field types of a table
+   *
+   * @param {string} table - Table name
+   * @param {FieldSchema} schema - Field types (empty to drop the table's schema)
+   * @returns {void}
+   */
+  setFieldSchema(table: string, schema: FieldSchema): void {
+    const safeTable = ensureSafeCommandValue(table, 'table');
+    Object.entries(schema).forEach(([field, type]) => {
+      if (!isFieldType(type)) {
+        throw new TypeError(`Unknown field type for ${field}: ${String(type)}`);
+      }
+    });
+
+    if (Object.keys(schema).length === 0) {
+      this.declaredSchemas.delete(safeTable);
+    } else {
+      this.declaredSchemas.set(safeTable, { ...schema });
+    }
+    if (this.clientHandle) {
+      this.native.setFieldSchema(this.clientHandle, safeTable, schema);
+    }
+  }
+
+  /**
+   * Get the declared or learned field schema of a table
+   *
+   * @param {string} table - Table name
+   * @returns {FieldSchema | undefined} Field schema, or undefined if the table has none
+   */
+  getFieldSchema(table: string): FieldSchema | undefined {
+    if (this.clientHandle) {
+      return this.native.getFieldSchema(this.clientHandle, table) ?? undefined;
+    }
+    const schema = this.declaredSchemas.get(table);
+    return schema ? { ...schema } : undefined;
+  }
+
+  /**
+   * Get the term statistics used by the reorderTerms option
+   *
+   * With reorderTerms, single-term results and DEBUG candidate counts are
+   * recorded automatically; callers may also prime the cache.
+   *
+   * @returns {TermStatsCache} Term statistics of this client
+   */
+  getTermStats(): TermStatsCache {
+    return this.termStats;
+  }
+
+  /**
+   * Attach an n-gram filter to a table
+   *
+   * search/count calls for the table with a positive term containing an
+   * n-gram the filter never saw return an empty result without a round trip.
+   * The filter is shared, not copied: keep adding the table's new documents
+   * to it so it keeps covering the index.
+   *
+   * @param {string} table - Table name
+   * @param {NgramBloomFilter | null} filter - Filter of the table's n-grams (null to detach)
+   * @returns {void}
+   */
+  setNgramFilter(table: string, filter: NgramBloomFilter | null): void {
+    const safeTable = ensureSafeCommandValue(table, 'table');
+    if (filter) {
+      this.ngramFilters.set(safeTable, filter);
+    } else {
+      this.ngramFilters.delete(safeTable);
+    }
+  }
+
+  /**
+   * Get the number of search/count calls answered without the server
+   *
+   * With analyzeQueries, queries that can never match (a term both required
+   * and excluded) return an empty result and invalid ones (empty terms, no
+   * positive term) throw without a round trip. Queries rejected by an
+   * n-gram filter (see setNgramFilter) count as well.
+   *
+   * @returns {number} Round trips saved so far
+   */
+  getSavedRoundTrips(): number {
+    return this.savedRoundTrips;
+  }
+
+  /**
+   * Check the positive terms against the table's n-gram filter, if any
+   *
+   * @param {string} table - Table name
+   * @param {string} mainTerm - Main search term
+   * @param {string[]} andTerms - Additional required terms
+   * @returns {boolean} True if some term cannot match (counted as a saved round trip)
+   */
+  private rejectedByNgramFilter(table: string, mainTerm: string, andTerms: string[]): boolean {
+    const filter = this.ngramFilters.get(table);
+    if (!filter || filter.mayMatchQuery(mainTerm, andTerms)) {
+      return false;
+    }
+    this.savedRoundTrips += 1;
+    return true;
+  }
+
+  /**
+   * Get a document with filter fields decoded natively by the table's field schema
+   *
+   * @param {string} table - Table name
+   * @param {string} primaryKey - Primary key value
+   * @returns {Promise<TypedDocument>} Document with decoded field values
+   */
+  async getTyped(table: string, primaryKey: string): Promise<TypedDocument> {
+    const safeTable = ensureSafeCommandValue(table, 'table');
+    const safePrimaryKey = ensureSafeCommandValue(primaryKey, 'primaryKey');
+
+    if (!this.connected || !this.clientHandle) {
+      throw new ConnectionError('Not connected to server');
+    }
+
+    let raw: NativeTypedDocument;
+    try {
+      raw = this.native.get(this.clientHandle, safeTable, safePrimaryKey);
+    } catch (error) {
+      const errorMsg = this.native.getLastError(this.clientHandle);
+      throw new ProtocolError(errorMsg || (error instanceof Error ? error.message : 'Get failed'));
+    }
+
+    return { primaryKey: raw.primary_key, fields: raw.fields };
+  }
+
+  /**
+   * Get selected fields of many documents as columns
+   *
+   * GET commands are pipelined natively and decoded straight into typed
+   * columns. Documents the server reports as missing leave their row empty.
+   *
+   * @param {string} table - Table name
+   * @param {string[]} primaryKeys - Primary keys to fetch (row order)
+   * @param {string[]} fields - Field names to extract
+   * @returns {Promise<ColumnarDocuments>} Columnar result with one column per field
+   */
+  async getColumns(table: string, primaryKeys: string[], fields: string[]): Promise<ColumnarDocuments> {
+    const safeTable = ensureSafeCommandValue(table, 'table');
+    ensureSafeStringArray(primaryKeys, 'primaryKeys');
+    ensureSafeStringArray(fields, 'fields');
+
+    if (!this.connected || !this.clientHandle) {
+      throw new ConnectionError('Not connected to server');
+    }
+
+    let raw: NativeColumnarResult;
+    try {
+      raw = this.native.getColumns(this.clientHandle, safeTable, primaryKeys, fields);
+    } catch (error) {
+      const errorMsg = this.native.getLastError(this.clientHandle);
+      throw new ConnectionError(errorMsg || (error instanceof Error ? error.message : 'GetColumns failed'));
+    }
+
+    const columns: Record<string, FieldColumn> = {};
+    raw.columns.forEach((column) => {
+      if (column.kind === 'number') {
+        columns[column.name] = { kind: 'number', type: column.type, values: column.values!, present: column.present };
+      } else {
+        columns[column.name] = {
+          kind: 'string',
+          type: column.type,
+          data: column.data!,
+          offsets: column.offsets!,
+          present: column.present
+        };
+      }
+    });
+
+    return { primaryKeys: raw.primary_keys, found: raw.found, columns };
+  }
+
   /**
    * Get server information
    *
    * @returns {Promise<ServerInfo>} Server information
    */
   async info(): Promise<ServerInfo> {
-    const response = await this.sendCommand('INFO');
-    return NativeMygramClient.parseInfoResponse(response);
+    if (!this.connected || !this.clientHandle) {
+      throw new ConnectionError('Not connected to server');
+    }
+
+    try {
+      return fromNativeServerInfo(this.native.info(this.clientHandle));
+    } catch (error) {
+      const errorMsg = this.native.getLastError(this.clientHandle);
+      throw new ProtocolError(errorMsg || (error instanceof Error ? error.message : 'Info failed'));
+    }
   }
 
   /**
@@ -447,59 +735,6 @@ export class NativeMygramClient {
     return { primaryKey, fields };
   }
 
-  private static parseInfoResponse(response: string): ServerInfo {
-    if (!response.startsWith('OK INFO')) {
-      throw new ProtocolError(`Invalid INFO response: ${response}`);
-    }
-
-    const lines = response.split('\n').slice(1);
-    const info: Partial<ServerInfo> = {
-      version: '',
-      uptimeSeconds: 0,
-      totalRequests: 0,
-      activeConnections: 0,
-      indexSizeBytes: 0,
-      docCount: 0,
-      tables: []
-    };
-
-    lines.forEach((line) => {
-      const trimmed = line.trim();
-      if (!trimmed || trimmed.startsWith('#')) return;
-
-      const [key, value] = trimmed.split(':').map((s) => s.trim());
-      if (!key || !value) return;
-
-      switch (key) {
-        case 'version':
-          info.version = value;
-          break;
-        case 'uptime_seconds':
-          info.uptimeSeconds = parseInt(value, 10);
-          break;
-        case 'total_requests':
-          info.totalRequests = parseInt(value, 10);
-          break;
-        case 'connected_clients':
-          info.activeConnections = parseInt(value, 10);
-          break;
-        case 'used_memory_bytes':
-          info.indexSizeBytes = parseInt(value, 10);
-          break;
-        case 'total_documents':
-          info.docCount = parseInt(value, 10);
-          break;
-        case 'tables':
-          info.tables = value.split(',').map((s) => s.trim());
-          break;
-        default:
-          break;
-      }
-    });
-
-    return info as ServerInfo;
-  }
-
   private static parseReplicationStatusResponse(response: string): ReplicationStatus {
     if (!response.startsWith('OK REPLICATION ')) {
       throw new ProtocolError(`Invalid REPLICATION STATUS response: ${response}`);
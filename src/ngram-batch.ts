@@ -0,0 +1,208 @@
+/**
+ * Bulk normalization and hybrid n-gram splitting of many documents
+ *
+ * Repeats the server's ingest-side split over a batch of documents, for
+ * tools that predict index size or screen content before it is loaded.
+ * Results are packed into flat arrays (one entry range per document), so a
+ * batch of millions of rows does not turn into millions of small arrays.
+ */
+
+import { QueryNormalization } from './types';
+import { normalizeQueryTerm } from './query-key';
+import { generateHybridNgrams } from './query-cost';
+import { generateHybridNgramHashesJs } from './ngram-hash';
+
+const textEncoder = new TextEncoder();
+const textDecoder = new TextDecoder();
+
+/**
+ * What a batch produces per document besides its n-gram count
+ */
+export type NgramBatchOutput = 'counts' | 'hashes' | 'ngrams';
+
+/**
+ * Batch options
+ *
+ * The n-gram sizes and normalization must match the server's configuration
+ * for the results to match what the server indexes.
+ */
+export interface NgramBatchOptions extends QueryNormalization {
+  /** Server's ngram_size for non-CJK text (default: 2) */
+  asciiNgramSize?: number;
+  /** Server's kanji_ngram_size (default: 1) */
+  kanjiNgramSize?: number;
+  /** What to produce (default: 'counts') */
+  output?: NgramBatchOutput;
+  /** Keep only the first occurrence of an n-gram in each document (default: false) */
+  distinct?: boolean;
+  /** Upper bound on native threads (0 = default, 1 = calling thread only) */
+  maxThreads?: number;
+}
+
+/**
+ * Documents packed back to back as UTF-8
+ */
+export interface PackedDocuments {
+  /** Document bytes, back to back */
+  data: Uint8Array;
+  /** Document boundaries (byte offsets, one more than the number of documents) */
+  offsets: Uint32Array;
+}
+
+/**
+ * N-grams of a batch of documents, packed into flat arrays
+ *
+ * Document i owns entries [documentOffsets[i], documentOffsets[i + 1]) of
+ * hashes or of the n-grams; n-gram j is data.slice(ngramOffsets[j], ngramOffsets[j + 1]).
+ */
+export interface NgramBatch {
+  /** N-grams of each document */
+  counts: Uint32Array;
+  /** Entry boundaries, one more than the number of documents ('hashes' and 'ngrams') */
+  documentOffsets?: Uint32Array;
+  /** Hashes of all documents, in order ('hashes') */
+  hashes?: BigUint64Array;
+  /** N-gram text, back to back ('ngrams') */
+  data?: string;
+  /** N-gram boundaries (UTF-16 offsets, one more than the number of n-grams) ('ngrams') */
+  ngramOffsets?: Uint32Array;
+}
+
+// Native batch shape (snake_case, as returned by the binding)
+export interface NativeNgramBatch {
+  counts: Uint32Array;
+  document_offsets?: Uint32Array;
+  hashes?: BigUint64Array;
+  data?: string;
+  ngram_offsets?: Uint32Array;
+}
+
+/**
+ * Pack documents back to back as UTF-8
+ *
+ * @param {string[]} documents - Document texts
+ * @returns {PackedDocuments} Packed documents
+ */
+export function packDocuments(documents: string[]): PackedDocuments {
+  const encoded = documents.map((document) => textEncoder.encode(document));
+  const offsets = new Uint32Array(documents.length + 1);
+  for (let i = 0; i < encoded.length; i += 1) {
+    offsets[i + 1] = offsets[i] + encoded[i].length;
+  }
+
+  const data = new Uint8Array(offsets[documents.length]);
+  for (let i = 0; i < encoded.length; i += 1) {
+    data.set(encoded[i], offsets[i]);
+  }
+  return { data, offsets };
+}
+
+/**
+ * Unpack documents packed with packDocuments
+ *
+ * @param {PackedDocuments} packed - Packed documents
+ * @returns {string[]} Document texts
+ */
+export function unpackDocuments(packed: PackedDocuments): string[] {
+  const documents: string[] = new Array(Math.max(packed.offsets.length - 1, 0));
+  for (let i = 0; i < documents.length; i += 1) {
+    documents[i] = textDecoder.decode(packed.data.subarray(packed.offsets[i], packed.offsets[i + 1]));
+  }
+  return documents;
+}
+
+/**
+ * N-grams of one document from an 'ngrams' batch
+ *
+ * @param {NgramBatch} batch - Batch produced with output 'ngrams'
+ * @param {number} index - Document index
+ * @returns {string[]} N-grams of the document, in text order
+ */
+export function getDocumentNgrams(batch: NgramBatch, index: number): string[] {
+  const { data = '', documentOffsets, ngramOffsets } = batch;
+  if (documentOffsets === undefined || ngramOffsets === undefined) {
+    return [];
+  }
+
+  const ngrams: string[] = [];
+  for (let j = documentOffsets[index]; j < documentOffsets[index + 1]; j += 1) {
+    ngrams.push(data.slice(ngramOffsets[j], ngramOffsets[j + 1]));
+  }
+  return ngrams;
+}
+
+/**
+ * Convert a native batch to NgramBatch
+ *
+ * @param {NativeNgramBatch} native - Batch returned by the binding
+ * @returns {NgramBatch} Batch
+ */
+export function fromNativeNgramBatch(native: NativeNgramBatch): NgramBatch {
+  const batch: NgramBatch = { counts: native.counts };
+  if (native.document_offsets !== undefined) {
+    batch.documentOffsets = native.document_offsets;
+  }
+  if (native.hashes !== undefined) {
+    batch.hashes = native.hashes;
+  }
+  if (native.data !== undefined && native.ngram_offsets !== undefined) {
+    batch.data = native.data;
+    batch.ngramOffsets = native.ngram_offsets;
+  }
+  return batch;
+}
+
+/**
+ * Normalize and split a batch of documents in JavaScript
+ *
+ * Normalizes like normalizeQueryTerm, with the same width tables as the
+ * native normalizer.
+ *
+ * @param {string[] | PackedDocuments} documents - Document texts, or documents packed with packDocuments
+ * @param {NgramBatchOptions} [options={}] - Normalization, n-gram sizes and output
+ * @returns {NgramBatch} Packed results
+ */
+export function generateNgramBatchJs(
+  documents: string[] | PackedDocuments,
+  options: NgramBatchOptions = {}
+): NgramBatch {
+  const texts = Array.isArray(documents) ? documents : unpackDocuments(documents);
+  const { asciiNgramSize = 2, kanjiNgramSize = 1, output = 'counts', distinct = false } = options;
+  const counts = new Uint32Array(texts.length);
+  const documentOffsets = new Uint32Array(texts.length + 1);
+  const hashes: bigint[] = [];
+  const ngrams: string[] = [];
+
+  for (let i = 0; i < texts.length; i += 1) {
+    const normalized = normalizeQueryTerm(texts[i], options);
+    if (output === 'hashes') {
+      const documentHashes = generateHybridNgramHashesJs(normalized, asciiNgramSize, kanjiNgramSize);
+      const kept = distinct ? Array.from(new Set(documentHashes)) : Array.from(documentHashes);
+      kept.forEach((hash) => hashes.push(hash));
+      counts[i] = kept.length;
+    } else {
+      const documentNgrams = generateHybridNgrams(normalized, asciiNgramSize, kanjiNgramSize);
+      const kept = distinct ? Array.from(new Set(documentNgrams)) : documentNgrams;
+      if (output === 'ngrams') {
+        kept.forEach((ngram) => ngrams.push(ngram));
+      }
+      counts[i] = kept.length;
+    }
+    documentOffsets[i + 1] = documentOffsets[i] + counts[i];
+  }
+
+  const batch: NgramBatch = { counts };
+  if (output === 'hashes') {
+    batch.documentOffsets = documentOffsets;
+    batch.hashes = BigUint64Array.from(hashes);
+  } else if (output === 'ngrams') {
+    const ngramOffsets = new Uint32Array(ngrams.length + 1);
+    for (let j = 0; j < ngrams.length; j += 1) {
+      ngramOffsets[j + 1] = ngramOffsets[j] + ngrams[j].length;
+    }
+    batch.documentOffsets = documentOffsets;
+    batch.data = ngrams.join('');
+    batch.ngramOffsets = ngramOffsets;
+  }
+  return batch;
+}
@@ -0,0 +1,353 @@
+/**
+ * Bloom filter of a table's indexed n-grams
+ *
+ * A document matches a term only if it contains every n-gram of the term, so
+ * a term with an n-gram that occurs in no document of the table matches
+ * nothing. An NgramBloomFilter holds the n-grams of every indexed document
+ * in a few bits each; a client with a filter for a table (setNgramFilter)
+ * answers such queries with an empty result instead of sending them.
+ */
+
+import { QueryNormalization } from './types';
+import { normalizeQueryTerm } from './query-key';
+import { generateHybridNgramHashesJs } from './ngram-hash';
+
+const BLOCK_BITS = 512;
+const WORDS_PER_BLOCK = BLOCK_BITS / 32;
+const BLOCK_BIT_SHIFT = 23;
+const BIT_STEP_MULTIPLIER = 0x9e3779b9;
+const MAX_HASH_COUNT = 16;
+const MAX_BLOCKS = 0xffffffff;
+const DEFAULT_BITS_PER_NGRAM = 10;
+const LOW_32_BITS = 0xffffffffn;
+
+// Serialized layout, shared with the native filter (little-endian):
+// magic "MGNF", version, ascii/kanji n-gram size, flags (1 = nfkc, 2 = lower),
+// width (0 = keep, 1 = narrow, 2 = wide), hash count, 2 reserved bytes,
+// block count (u32), n-gram count (u64), then the bit array
+const MAGIC = [0x4d, 0x47, 0x4e, 0x46];
+const FORMAT_VERSION = 1;
+const HEADER_SIZE = 24;
+const FLAG_NFKC = 1;
+const FLAG_LOWER = 2;
+const WIDTHS: Array<'keep' | 'narrow' | 'wide'> = ['keep', 'narrow', 'wide'];
+
+/**
+ * N-gram filter options
+ *
+ * N-gram sizes and normalization must mirror the server's table settings:
+ * an n-gram hashed differently from the server's is reported absent and
+ * would wrongly empty a query. Normalization defaults to what the server
+ * does out of the box (NFKC, narrow width).
+ */
+export interface NgramFilterOptions extends QueryNormalization {
+  /** Server's ngram_size for non-CJK text (default: 2) */
+  asciiNgramSize?: number;
+  /** Server's kanji_ngram_size (default: 1) */
+  kanjiNgramSize?: number;
+  /** Filter bits per expected n-gram (default: 10, ~1% false positives) */
+  bitsPerNgram?: number;
+}
+
+/**
+ * N-gram filter counters
+ */
+export interface NgramFilterStats {
+  /** N-grams added (repeats of an n-gram count once, up to false positives) */
+  ngrams: number;
+  /** Size of the bit array */
+  sizeBytes: number;
+  /** Bits set per n-gram */
+  hashCount: number;
+  /** Estimated from the fraction of bits set */
+  falsePositiveRate: number;
+}
+
+// Native n-gram filter binding interface
+interface NativeNgramFilterBinding {
+  createNgramFilter(expectedNgrams: number, options: NgramFilterOptions): unknown;
+  deserializeNgramFilter(data: Uint8Array): unknown;
+  destroyNgramFilter(filter: unknown): void;
+  ngramFilterAdd(filter: unknown, input: string | string[] | BigUint64Array): void;
+  ngramFilterMayMatch(filter: unknown, term: string): boolean;
+  getNgramFilterStats(filter: unknown): {
+    ngrams: number;
+    size_bytes: number;
+    hash_count: number;
+    false_positive_rate: number;
+  };
+  serializeNgramFilter(filter: unknown): Uint8Array;
+}
+
+/**
+ * Count the set bits of a 32-bit word
+ *
+ * @param {number} word - 32-bit word
+ * @returns {number} Set bits
+ */
+function popcount32(word: number): number {
+  let bits = word - ((word >>> 1) & 0x55555555);
+  bits = (bits & 0x33333333) + ((bits >>> 2) & 0x33333333);
+  return (Math.imul((bits + (bits >>> 4)) & 0x0f0f0f0f, 0x01010101) >>> 24) & 0xff;
+}
+
+/**
+ * Blocked Bloom filter over 64-bit n-gram hashes (see hashNgram)
+ *
+ * Each n-gram sets a few bits within one 64-byte block. The filter never
+ * reports an added n-gram as absent; an absent n-gram is reported present
+ * with the false positive rate, which only costs the round trip the filter
+ * would have saved.
+ *
+ * Build it from every document of the table (a full export of its text
+ * columns) and keep adding inserted and updated documents; a filter built
+ * from a sample would miss rare n-grams and wrongly empty queries for them.
+ * serialize() output is the same for the native and JavaScript
+ * implementations, so a filter built once can be shipped to many clients.
+ *
+ * With a native binding, the bits live in the native library (call destroy()
+ * when done).
+ */
+export class NgramBloomFilter {
+  private native: NativeNgramFilterBinding | null;
+  private handle: unknown = null;
+  private options: NgramFilterOptions;
+  private words: Uint32Array = new Uint32Array(0);
+  private blocks = 0;
+  private hashCount = 1;
+  private ngrams = 0;
+
+  /**
+   * Create an empty filter
+   *
+   * @param {number} expectedNgrams - Distinct n-grams the filter is sized for (more raise the false positive rate)
+   * @param {NgramFilterOptions} [options={}] - N-gram sizes, normalization and bits per n-gram
+   * @param {NativeNgramFilterBinding | null} [native=null] - Native binding object
+   */
+  constructor(
+    expectedNgrams: number,
+    options: NgramFilterOptions = {},
+    native: NativeNgramFilterBinding | null = null
+  ) {
+    this.options = { nfkc: true, width: 'narrow', lower: false, ...options };
+    this.native = native;
+    if (native) {
+      this.handle = native.createNgramFilter(expectedNgrams, this.options);
+      return;
+    }
+
+    const bitsPerNgram = Math.max(this.options.bitsPerNgram ?? DEFAULT_BITS_PER_NGRAM, 1);
+    const bits = Math.max(1, expectedNgrams * bitsPerNgram);
+    this.blocks = Math.min(Math.max(Math.ceil(bits / BLOCK_BITS), 1), MAX_BLOCKS);
+    this.words = new Uint32Array(this.blocks * WORDS_PER_BLOCK);
+    this.hashCount = Math.min(Math.max(Math.round(bitsPerNgram * Math.LN2), 1), MAX_HASH_COUNT);
+  }
+
+  /**
+   * Restore a filter from serialize() output
+   *
+   * @param {Uint8Array} data - Serialized filter
+   * @param {NativeNgramFilterBinding | null} [native=null] - Native binding object
+   * @returns {NgramBloomFilter} Filter
+   * @throws {Error} If the data is truncated or not a filter
+   */
+  static deserialize(data: Uint8Array, native: NativeNgramFilterBinding | null = null): NgramBloomFilter {
+    const filter = Object.create(NgramBloomFilter.prototype) as NgramBloomFilter;
+    filter.native = native;
+    filter.handle = null;
+
+    if (data.length < HEADER_SIZE || MAGIC.some((byte, i) => data[i] !== byte)) {
+      throw new Error('Not an n-gram filter');
+    }
+    if (data[4] !== FORMAT_VERSION) {
+      throw new Error(`Unsupported n-gram filter version: ${data[4]}`);
+    }
+    filter.options = {
+      asciiNgramSize: data[5],
+      kanjiNgramSize: data[6],
+      nfkc: (data[7] & FLAG_NFKC) !== 0,
+      lower: (data[7] & FLAG_LOWER) !== 0,
+      width: WIDTHS[data[8]] ?? 'keep'
+    };
+    if (native) {
+      filter.handle = native.deserializeNgramFilter(data);
+      return filter;
+    }
+
+    const view = new DataView(data.buffer, data.byteOffset, data.byteLength);
+    filter.hashCount = data[9];
+    filter.blocks = view.getUint32(12, true);
+    filter.ngrams = Number(view.getBigUint64(16, true));
+    if (
+      filter.blocks === 0 ||
+      filter.hashCount === 0 ||
+      filter.hashCount > MAX_HASH_COUNT ||
+      data.length !== HEADER_SIZE + (filter.blocks * BLOCK_BITS) / 8
+    ) {
+      throw new Error('Corrupt n-gram filter');
+    }
+    filter.words = new Uint32Array(filter.blocks * WORDS_PER_BLOCK);
+    for (let i = 0; i < filter.words.length; i += 1) {
+      filter.words[i] = view.getUint32(HEADER_SIZE + i * 4, true);
+    }
+    return filter;
+  }
+
+  /**
+   * Add document texts (normalized first) or n-gram hashes of normalized text
+   *
+   * @param {string | string[] | BigUint64Array} input - Document text(s), or hashes from generateHybridNgramHashes
+   * @returns {void}
+   */
+  add(input: string | string[] | BigUint64Array): void {
+    if (this.native && this.handle) {
+      this.native.ngramFilterAdd(this.handle, input);
+      return;
+    }
+
+    if (input instanceof BigUint64Array) {
+      input.forEach((hash) => this.addHash(hash));
+      return;
+    }
+    (typeof input === 'string' ? [input] : input).forEach((text) => {
+      this.hashes(text).forEach((hash) => this.addHash(hash));
+    });
+  }
+
+  /**
+   * Check whether a term may match any document
+   *
+   * @param {string} term - Search term
+   * @returns {boolean} False if an n-gram of the term was never added; true otherwise,
+   *   including for terms too short to form an n-gram
+   */
+  mayMatch(term: string): boolean {
+    if (this.native && this.handle) {
+      return this.native.ngramFilterMayMatch(this.handle, term);
+    }
+    return this.hashes(term).every((hash) => this.mayContainHash(hash));
+  }
+
+  /**
+   * Check whether a query may match any document
+   *
+   * NOT terms cannot make an empty result non-empty, so only the positive
+   * terms are checked.
+   *
+   * @param {string} mainTerm - Main search term
+   * @param {string[]} [andTerms=[]] - Additional required terms
+   * @returns {boolean} False if some positive term cannot match
+   */
+  mayMatchQuery(mainTerm: string, andTerms: string[] = []): boolean {
+    return this.mayMatch(mainTerm) && andTerms.every((term) => this.mayMatch(term));
+  }
+
+  /**
+   * Get filter counters
+   *
+   * @returns {NgramFilterStats} Counters
+   */
+  getStats(): NgramFilterStats {
+    if (this.native && this.handle) {
+      const raw = this.native.getNgramFilterStats(this.handle);
+      return {
+        ngrams: raw.ngrams,
+        sizeBytes: raw.size_bytes,
+        hashCount: raw.hash_count,
+        falsePositiveRate: raw.false_positive_rate
+      };
+    }
+
+    let setBits = 0;
+    this.words.forEach((word) => {
+      setBits += popcount32(word);
+    });
+    const fill = setBits / (this.words.length * 32);
+    return {
+      ngrams: this.ngrams,
+      sizeBytes: this.words.length * 4,
+      hashCount: this.hashCount,
+      falsePositiveRate: fill ** this.hashCount
+    };
+  }
+
+  /**
+   * Serialize the filter (configuration and bits)
+   *
+   * @returns {Uint8Array} Bytes for NgramBloomFilter.deserialize
+   */
+  serialize(): Uint8Array {
+    if (this.native && this.handle) {
+      return this.native.serializeNgramFilter(this.handle);
+    }
+
+    const data = new Uint8Array(HEADER_SIZE + this.words.length * 4);
+    const view = new DataView(data.buffer);
+    data.set(MAGIC, 0);
+    data[4] = FORMAT_VERSION;
+    data[5] = this.options.asciiNgramSize ?? 2;
+    data[6] = this.options.kanjiNgramSize ?? 1;
+    data[7] = (this.options.nfkc ? FLAG_NFKC : 0) | (this.options.lower ? FLAG_LOWER : 0);
+    data[8] = Math.max(WIDTHS.indexOf(this.options.width ?? 'keep'), 0);
+    data[9] = this.hashCount;
+    view.setUint32(12, this.blocks, true);
+    view.setBigUint64(16, BigInt(this.ngrams), true);
+    for (let i = 0; i < this.words.length; i += 1) {
+      view.setUint32(HEADER_SIZE + i * 4, this.words[i], true);
+    }
+    return data;
+  }
+
+  /**
+   * Release the native filter (clients it is attached to can no longer use it)
+   *
+   * @returns {void}
+   */
+  destroy(): void {
+    if (this.native && this.handle) {
+      this.native.destroyNgramFilter(this.handle);
+      this.handle = null;
+    }
+  }
+
+  private hashes(text: string): BigUint64Array {
+    const { asciiNgramSize = 2, kanjiNgramSize = 1 } = this.options;
+    return generateHybridNgramHashesJs(normalizeQueryTerm(text, this.options), asciiNgramSize, kanjiNgramSize);
+  }
+
+  /**
+   * First 32-bit word of a hash's block (the high 32 bits scaled to the block count)
+   */
+  private blockStart(hash: bigint): number {
+    return Number(((hash >> 32n) * BigInt(this.blocks)) >> 32n) * WORDS_PER_BLOCK;
+  }
+
+  private addHash(hash: bigint): void {
+    const start = this.blockStart(hash);
+    let bits = Number(hash & LOW_32_BITS);
+    let added = false;
+    for (let i = 0; i < this.hashCount; i += 1) {
+      const bit = bits >>> BLOCK_BIT_SHIFT;
+      const mask = 1 << (bit & 31);
+      added = added || (this.words[start + (bit >>> 5)] & mask) === 0;
+      this.words[start + (bit >>> 5)] |= mask;
+      bits = Math.imul(bits, BIT_STEP_MULTIPLIER) >>> 0;
+    }
+    if (added) {
+      this.ngrams += 1;
+    }
+  }
+
+  private mayContainHash(hash: bigint): boolean {
+    const start = this.blockStart(hash);
+    let bits = Number(hash & LOW_32_BITS);
+    for (let i = 0; i < this.hashCount; i += 1) {
+      const bit = bits >>> BLOCK_BIT_SHIFT;
+      if ((this.words[start + (bit >>> 5)] & (1 << (bit & 31))) === 0) {
+        return false;
+      }
+      bits = Math.imul(bits, BIT_STEP_MULTIPLIER) >>> 0;
+    }
+    return true;
+  }
+}
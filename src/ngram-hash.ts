@@ -0,0 +1,118 @@
+/**
+ * Rolling 64-bit hashes of n-grams
+ *
+ * Hashing the n-grams of a text instead of materializing them as strings
+ * gives compact keys for client-side sets, sketches and filters. The hash is
+ * computed from code points (a polynomial over the window, finished with the
+ * murmur3 64-bit mixer), so the native binding and this JavaScript version
+ * produce the same values and an n-gram hashes the same wherever it occurs.
+ */
+
+import { isCjkIdeograph } from './query-cost';
+
+const MASK = (1n << 64n) - 1n;
+const HASH_BASE = 0x9e3779b97f4a7c15n;
+const LENGTH_SALT = 0xc2b2ae3d27d4eb4fn;
+const FMIX_MULTIPLIER_1 = 0xff51afd7ed558ccdn;
+const FMIX_MULTIPLIER_2 = 0xc4ceb9fe1a85ec53n;
+
+/**
+ * Murmur3 64-bit finalizer
+ *
+ * @param {bigint} value - 64-bit value
+ * @returns {bigint} Mixed value
+ */
+function fmix64(value: bigint): bigint {
+  let mixed = value;
+  mixed ^= mixed >> 33n;
+  mixed = (mixed * FMIX_MULTIPLIER_1) & MASK;
+  mixed ^= mixed >> 33n;
+  mixed = (mixed * FMIX_MULTIPLIER_2) & MASK;
+  mixed ^= mixed >> 33n;
+  return mixed;
+}
+
+/**
+ * Hash a window of code points
+ *
+ * @param {number[]} codePoints - Code points of the text
+ * @param {number} start - First code point of the window
+ * @param {number} size - Window size in code points
+ * @returns {bigint} 64-bit hash
+ */
+function hashWindow(codePoints: number[], start: number, size: number): bigint {
+  let polynomial = 0n;
+  for (let i = start; i < start + size; i += 1) {
+    polynomial = (polynomial * HASH_BASE + BigInt(codePoints[i] + 1)) & MASK;
+  }
+  return fmix64((polynomial + BigInt(size) * LENGTH_SALT) & MASK);
+}
+
+/**
+ * Split a string into code points
+ *
+ * @param {string} text - Text
+ * @returns {number[]} Code points
+ */
+function toCodePoints(text: string): number[] {
+  return Array.from(text, (char) => char.codePointAt(0) ?? 0);
+}
+
+/**
+ * Hash one n-gram
+ *
+ * @param {string} ngram - N-gram text
+ * @returns {bigint} 64-bit hash, equal to the n-gram's entry from generateNgramHashes
+ */
+export function hashNgram(ngram: string): bigint {
+  const codePoints = toCodePoints(ngram);
+  return hashWindow(codePoints, 0, codePoints.length);
+}
+
+/**
+ * Hash the n-grams of a text in JavaScript
+ *
+ * @param {string} text - Text (should be normalized)
+ * @param {number} ngramSize - N-gram size in code points
+ * @returns {BigUint64Array} One hash per n-gram, in text order
+ */
+export function generateNgramHashesJs(text: string, ngramSize: number): BigUint64Array {
+  const codePoints = toCodePoints(text);
+  if (ngramSize <= 0 || codePoints.length < ngramSize) {
+    return new BigUint64Array(0);
+  }
+
+  const hashes = new BigUint64Array(codePoints.length - ngramSize + 1);
+  for (let i = 0; i < hashes.length; i += 1) {
+    hashes[i] = hashWindow(codePoints, i, ngramSize);
+  }
+  return hashes;
+}
+
+/**
+ * Hash the hybrid n-grams of a text in JavaScript
+ *
+ * Same windows as generateHybridNgrams.
+ *
+ * @param {string} text - Text (should be normalized)
+ * @param {number} [asciiNgramSize=2] - N-gram size for non-CJK characters
+ * @param {number} [kanjiNgramSize=1] - N-gram size for CJK ideographs
+ * @returns {BigUint64Array} One hash per n-gram, in text order
+ */
+export function generateHybridNgramHashesJs(text: string, asciiNgramSize = 2, kanjiNgramSize = 1): BigUint64Array {
+  const codePoints = toCodePoints(text);
+  const cjk = codePoints.map(isCjkIdeograph);
+  const hashes: bigint[] = [];
+
+  for (let i = 0; i < codePoints.length; i += 1) {
+    const size = cjk[i] ? kanjiNgramSize : asciiNgramSize;
+    let sameKind = size >= 0 && i + size <= codePoints.length;
+    for (let j = 1; sameKind && j < size; j += 1) {
+      sameKind = cjk[i + j] === cjk[i];
+    }
+    if (sameKind) {
+      hashes.push(hashWindow(codePoints, i, size));
+    }
+  }
+  return BigUint64Array.from(hashes);
+}
@@ -0,0 +1,515 @@
+// Generated by native/tools/gen_normalization_tables.cpp --typescript from ICU 72.1 (Unicode 15.0).
+// Do not edit.
+
+export const NARROW_MAPPINGS: ReadonlyArray<readonly [number, string]> = [
+  [0x1100, '\uffa1'],
+  [0x1101, '\uffa2'],
+  [0x1102, '\uffa4'],
+  [0x1103, '\uffa7'],
+  [0x1104, '\uffa8'],
+  [0x1105, '\uffa9'],
+  [0x1106, '\uffb1'],
+  [0x1107, '\uffb2'],
+  [0x1108, '\uffb3'],
+  [0x1109, '\uffb5'],
+  [0x110a, '\uffb6'],
+  [0x110b, '\uffb7'],
+  [0x110c, '\uffb8'],
+  [0x110d, '\uffb9'],
+  [0x110e, '\uffba'],
+  [0x110f, '\uffbb'],
+  [0x1110, '\uffbc'],
+  [0x1111, '\uffbd'],
+  [0x1112, '\uffbe'],
+  [0x111a, '\uffb0'],
+  [0x1121, '\uffb4'],
+  [0x1160, '\uffa0'],
+  [0x1161, '\uffc2'],
+  [0x1162, '\uffc3'],
+  [0x1163, '\uffc4'],
+  [0x1164, '\uffc5'],
+  [0x1165, '\uffc6'],
+  [0x1166, '\uffc7'],
+  [0x1167, '\uffca'],
+  [0x1168, '\uffcb'],
+  [0x1169, '\uffcc'],
+  [0x116a, '\uffcd'],
+  [0x116b, '\uffce'],
+  [0x116c, '\uffcf'],
+  [0x116d, '\uffd2'],
+  [0x116e, '\uffd3'],
+  [0x116f, '\uffd4'],
+  [0x1170, '\uffd5'],
+  [0x1171, '\uffd6'],
+  [0x1172, '\uffd7'],
+  [0x1173, '\uffda'],
+  [0x1174, '\uffdb'],
+  [0x1175, '\uffdc'],
+  [0x11aa, '\uffa3'],
+  [0x11ac, '\uffa5'],
+  [0x11ad, '\uffa6'],
+  [0x11b0, '\uffaa'],
+  [0x11b1, '\uffab'],
+  [0x11b2, '\uffac'],
+  [0x11b3, '\uffad'],
+  [0x11b4, '\uffae'],
+  [0x11b5, '\uffaf'],
+  [0x2190, '\uffe9'],
+  [0x2191, '\uffea'],
+  [0x2192, '\uffeb'],
+  [0x2193, '\uffec'],
+  [0x2502, '\uffe8'],
+  [0x25a0, '\uffed'],
+  [0x25cb, '\uffee'],
+  [0x3000, '\u0020'],
+  [0x3001, '\uff64'],
+  [0x3002, '\uff61'],
+  [0x300c, '\uff62'],
+  [0x300d, '\uff63'],
+  [0x3099, '\uff9e'],
+  [0x309a, '\uff9f'],
+  [0x30a1, '\uff67'],
+  [0x30a2, '\uff71'],
+  [0x30a3, '\uff68'],
+  [0x30a4, '\uff72'],
+  [0x30a5, '\uff69'],
+  [0x30a6, '\uff73'],
+  [0x30a7, '\uff6a'],
+  [0x30a8, '\uff74'],
+  [0x30a9, '\uff6b'],
+  [0x30aa, '\uff75'],
+  [0x30ab, '\uff76'],
+  [0x30ac, '\uff76\uff9e'],
+  [0x30ad, '\uff77'],
+  [0x30ae, '\uff77\uff9e'],
+  [0x30af, '\uff78'],
+  [0x30b0, '\uff78\uff9e'],
+  [0x30b1, '\uff79'],
+  [0x30b2, '\uff79\uff9e'],
+  [0x30b3, '\uff7a'],
+  [0x30b4, '\uff7a\uff9e'],
+  [0x30b5, '\uff7b'],
+  [0x30b6, '\uff7b\uff9e'],
+  [0x30b7, '\uff7c'],
+  [0x30b8, '\uff7c\uff9e'],
+  [0x30b9, '\uff7d'],
+  [0x30ba, '\uff7d\uff9e'],
+  [0x30bb, '\uff7e'],
+  [0x30bc, '\uff7e\uff9e'],
+  [0x30bd, '\uff7f'],
+  [0x30be, '\uff7f\uff9e'],
+  [0x30bf, '\uff80'],
+  [0x30c0, '\uff80\uff9e'],
+  [0x30c1, '\uff81'],
+  [0x30c2, '\uff81\uff9e'],
+  [0x30c3, '\uff6f'],
+  [0x30c4, '\uff82'],
+  [0x30c5, '\uff82\uff9e'],
+  [0x30c6, '\uff83'],
+  [0x30c7, '\uff83\uff9e'],
+  [0x30c8, '\uff84'],
+  [0x30c9, '\uff84\uff9e'],
+  [0x30ca, '\uff85'],
+  [0x30cb, '\uff86'],
+  [0x30cc, '\uff87'],
+  [0x30cd, '\uff88'],
+  [0x30ce, '\uff89'],
+  [0x30cf, '\uff8a'],
+  [0x30d0, '\uff8a\uff9e'],
+  [0x30d1, '\uff8a\uff9f'],
+  [0x30d2, '\uff8b'],
+  [0x30d3, '\uff8b\uff9e'],
+  [0x30d4, '\uff8b\uff9f'],
+  [0x30d5, '\uff8c'],
+  [0x30d6, '\uff8c\uff9e'],
+  [0x30d7, '\uff8c\uff9f'],
+  [0x30d8, '\uff8d'],
+  [0x30d9, '\uff8d\uff9e'],
+  [0x30da, '\uff8d\uff9f'],
+  [0x30db, '\uff8e'],
+  [0x30dc, '\uff8e\uff9e'],
+  [0x30dd, '\uff8e\uff9f'],
+  [0x30de, '\uff8f'],
+  [0x30df, '\uff90'],
+  [0x30e0, '\uff91'],
+  [0x30e1, '\uff92'],
+  [0x30e2, '\uff93'],
+  [0x30e3, '\uff6c'],
+  [0x30e4, '\uff94'],
+  [0x30e5, '\uff6d'],
+  [0x30e6, '\uff95'],
+  [0x30e7, '\uff6e'],
+  [0x30e8, '\uff96'],
+  [0x30e9, '\uff97'],
+  [0x30ea, '\uff98'],
+  [0x30eb, '\uff99'],
+  [0x30ec, '\uff9a'],
+  [0x30ed, '\uff9b'],
+  [0x30ef, '\uff9c'],
+  [0x30f2, '\uff66'],
+  [0x30f3, '\uff9d'],
+  [0x30f4, '\uff73\uff9e'],
+  [0x30f7, '\uff9c\uff9e'],
+  [0x30fa, '\uff66\uff9e'],
+  [0x30fb, '\uff65'],
+  [0x30fc, '\uff70'],
+  [0xff01, '\u0021'],
+  [0xff02, '\u0022'],
+  [0xff03, '\u0023'],
+  [0xff04, '\u0024'],
+  [0xff05, '\u0025'],
+  [0xff06, '\u0026'],
+  [0xff07, '\u0027'],
+  [0xff08, '\u0028'],
+  [0xff09, '\u0029'],
+  [0xff0a, '\u002a'],
+  [0xff0b, '\u002b'],
+  [0xff0c, '\u002c'],
+  [0xff0d, '\u002d'],
+  [0xff0e, '\u002e'],
+  [0xff0f, '\u002f'],
+  [0xff10, '\u0030'],
+  [0xff11, '\u0031'],
+  [0xff12, '\u0032'],
+  [0xff13, '\u0033'],
+  [0xff14, '\u0034'],
+  [0xff15, '\u0035'],
+  [0xff16, '\u0036'],
+  [0xff17, '\u0037'],
+  [0xff18, '\u0038'],
+  [0xff19, '\u0039'],
+  [0xff1a, '\u003a'],
+  [0xff1b, '\u003b'],
+  [0xff1c, '\u003c'],
+  [0xff1d, '\u003d'],
+  [0xff1e, '\u003e'],
+  [0xff1f, '\u003f'],
+  [0xff20, '\u0040'],
+  [0xff21, '\u0041'],
+  [0xff22, '\u0042'],
+  [0xff23, '\u0043'],
+  [0xff24, '\u0044'],
+  [0xff25, '\u0045'],
+  [0xff26, '\u0046'],
+  [0xff27, '\u0047'],
+  [0xff28, '\u0048'],
+  [0xff29, '\u0049'],
+  [0xff2a, '\u004a'],
+  [0xff2b, '\u004b'],
+  [0xff2c, '\u004c'],
+  [0xff2d, '\u004d'],
+  [0xff2e, '\u004e'],
+  [0xff2f, '\u004f'],
+  [0xff30, '\u0050'],
+  [0xff31, '\u0051'],
+  [0xff32, '\u0052'],
+  [0xff33, '\u0053'],
+  [0xff34, '\u0054'],
+  [0xff35, '\u0055'],
+  [0xff36, '\u0056'],
+  [0xff37, '\u0057'],
+  [0xff38, '\u0058'],
+  [0xff39, '\u0059'],
+  [0xff3a, '\u005a'],
+  [0xff3b, '\u005b'],
+  [0xff3c, '\u005c'],
+  [0xff3d, '\u005d'],
+  [0xff3e, '\u005e'],
+  [0xff3f, '\u005f'],
+  [0xff40, '\u0060'],
+  [0xff41, '\u0061'],
+  [0xff42, '\u0062'],
+  [0xff43, '\u0063'],
+  [0xff44, '\u0064'],
+  [0xff45, '\u0065'],
+  [0xff46, '\u0066'],
+  [0xff47, '\u0067'],
+  [0xff48, '\u0068'],
+  [0xff49, '\u0069'],
+  [0xff4a, '\u006a'],
+  [0xff4b, '\u006b'],
+  [0xff4c, '\u006c'],
+  [0xff4d, '\u006d'],
+  [0xff4e, '\u006e'],
+  [0xff4f, '\u006f'],
+  [0xff50, '\u0070'],
+  [0xff51, '\u0071'],
+  [0xff52, '\u0072'],
+  [0xff53, '\u0073'],
+  [0xff54, '\u0074'],
+  [0xff55, '\u0075'],
+  [0xff56, '\u0076'],
+  [0xff57, '\u0077'],
+  [0xff58, '\u0078'],
+  [0xff59, '\u0079'],
+  [0xff5a, '\u007a'],
+  [0xff5b, '\u007b'],
+  [0xff5c, '\u007c'],
+  [0xff5d, '\u007d'],
+  [0xff5e, '\u007e'],
+  [0xffe0, '\u00a2'],
+  [0xffe1, '\u00a3'],
+  [0xffe2, '\u00ac'],
+  [0xffe3, '\u00af'],
+  [0xffe4, '\u00a6'],
+  [0xffe5, '\u00a5'],
+  [0xffe6, '\u20a9']
+];
+
+export const WIDE_MAPPINGS: ReadonlyArray<readonly [number, string]> = [
+  [0x0020, '\u3000'],
+  [0x0021, '\uff01'],
+  [0x0022, '\uff02'],
+  [0x0023, '\uff03'],
+  [0x0024, '\uff04'],
+  [0x0025, '\uff05'],
+  [0x0026, '\uff06'],
+  [0x0027, '\uff07'],
+  [0x0028, '\uff08'],
+  [0x0029, '\uff09'],
+  [0x002a, '\uff0a'],
+  [0x002b, '\uff0b'],
+  [0x002c, '\uff0c'],
+  [0x002d, '\uff0d'],
+  [0x002e, '\uff0e'],
+  [0x002f, '\uff0f'],
+  [0x0030, '\uff10'],
+  [0x0031, '\uff11'],
+  [0x0032, '\uff12'],
+  [0x0033, '\uff13'],
+  [0x0034, '\uff14'],
+  [0x0035, '\uff15'],
+  [0x0036, '\uff16'],
+  [0x0037, '\uff17'],
+  [0x0038, '\uff18'],
+  [0x0039, '\uff19'],
+  [0x003a, '\uff1a'],
+  [0x003b, '\uff1b'],
+  [0x003c, '\uff1c'],
+  [0x003d, '\uff1d'],
+  [0x003e, '\uff1e'],
+  [0x003f, '\uff1f'],
+  [0x0040, '\uff20'],
+  [0x0041, '\uff21'],
+  [0x0042, '\uff22'],
+  [0x0043, '\uff23'],
+  [0x0044, '\uff24'],
+  [0x0045, '\uff25'],
+  [0x0046, '\uff26'],
+  [0x0047, '\uff27'],
+  [0x0048, '\uff28'],
+  [0x0049, '\uff29'],
+  [0x004a, '\uff2a'],
+  [0x004b, '\uff2b'],
+  [0x004c, '\uff2c'],
+  [0x004d, '\uff2d'],
+  [0x004e, '\uff2e'],
+  [0x004f, '\uff2f'],
+  [0x0050, '\uff30'],
+  [0x0051, '\uff31'],
+  [0x0052, '\uff32'],
+  [0x0053, '\uff33'],
+  [0x0054, '\uff34'],
+  [0x0055, '\uff35'],
+  [0x0056, '\uff36'],
+  [0x0057, '\uff37'],
+  [0x0058, '\uff38'],
+  [0x0059, '\uff39'],
+  [0x005a, '\uff3a'],
+  [0x005b, '\uff3b'],
+  [0x005c, '\uff3c'],
+  [0x005d, '\uff3d'],
+  [0x005e, '\uff3e'],
+  [0x005f, '\uff3f'],
+  [0x0060, '\uff40'],
+  [0x0061, '\uff41'],
+  [0x0062, '\uff42'],
+  [0x0063, '\uff43'],
+  [0x0064, '\uff44'],
+  [0x0065, '\uff45'],
+  [0x0066, '\uff46'],
+  [0x0067, '\uff47'],
+  [0x0068, '\uff48'],
+  [0x0069, '\uff49'],
+  [0x006a, '\uff4a'],
+  [0x006b, '\uff4b'],
+  [0x006c, '\uff4c'],
+  [0x006d, '\uff4d'],
+  [0x006e, '\uff4e'],
+  [0x006f, '\uff4f'],
+  [0x0070, '\uff50'],
+  [0x0071, '\uff51'],
+  [0x0072, '\uff52'],
+  [0x0073, '\uff53'],
+  [0x0074, '\uff54'],
+  [0x0075, '\uff55'],
+  [0x0076, '\uff56'],
+  [0x0077, '\uff57'],
+  [0x0078, '\uff58'],
+  [0x0079, '\uff59'],
+  [0x007a, '\uff5a'],
+  [0x007b, '\uff5b'],
+  [0x007c, '\uff5c'],
+  [0x007d, '\uff5d'],
+  [0x007e, '\uff5e'],
+  [0x00a2, '\uffe0'],
+  [0x00a3, '\uffe1'],
+  [0x00a5, '\uffe5'],
+  [0x00a6, '\uffe4'],
+  [0x00ac, '\uffe2'],
+  [0x00af, '\uffe3'],
+  [0x20a9, '\uffe6'],
+  [0xff61, '\u3002'],
+  [0xff62, '\u300c'],
+  [0xff63, '\u300d'],
+  [0xff64, '\u3001'],
+  [0xff65, '\u30fb'],
+  [0xff66, '\u30f2'],
+  [0xff67, '\u30a1'],
+  [0xff68, '\u30a3'],
+  [0xff69, '\u30a5'],
+  [0xff6a, '\u30a7'],
+  [0xff6b, '\u30a9'],
+  [0xff6c, '\u30e3'],
+  [0xff6d, '\u30e5'],
+  [0xff6e, '\u30e7'],
+  [0xff6f, '\u30c3'],
+  [0xff70, '\u30fc'],
+  [0xff71, '\u30a2'],
+  [0xff72, '\u30a4'],
+  [0xff73, '\u30a6'],
+  [0xff74, '\u30a8'],
+  [0xff75, '\u30aa'],
+  [0xff76, '\u30ab'],
+  [0xff77, '\u30ad'],
+  [0xff78, '\u30af'],
+  [0xff79, '\u30b1'],
+  [0xff7a, '\u30b3'],
+  [0xff7b, '\u30b5'],
+  [0xff7c, '\u30b7'],
+  [0xff7d, '\u30b9'],
+  [0xff7e, '\u30bb'],
+  [0xff7f, '\u30bd'],
+  [0xff80, '\u30bf'],
+  [0xff81, '\u30c1'],
+  [0xff82, '\u30c4'],
+  [0xff83, '\u30c6'],
+  [0xff84, '\u30c8'],
+  [0xff85, '\u30ca'],
+  [0xff86, '\u30cb'],
+  [0xff87, '\u30cc'],
+  [0xff88, '\u30cd'],
+  [0xff89, '\u30ce'],
+  [0xff8a, '\u30cf'],
+  [0xff8b, '\u30d2'],
+  [0xff8c, '\u30d5'],
+  [0xff8d, '\u30d8'],
+  [0xff8e, '\u30db'],
+  [0xff8f, '\u30de'],
+  [0xff90, '\u30df'],
+  [0xff91, '\u30e0'],
+  [0xff92, '\u30e1'],
+  [0xff93, '\u30e2'],
+  [0xff94, '\u30e4'],
+  [0xff95, '\u30e6'],
+  [0xff96, '\u30e8'],
+  [0xff97, '\u30e9'],
+  [0xff98, '\u30ea'],
+  [0xff99, '\u30eb'],
+  [0xff9a, '\u30ec'],
+  [0xff9b, '\u30ed'],
+  [0xff9c, '\u30ef'],
+  [0xff9d, '\u30f3'],
+  [0xff9e, '\u3099'],
+  [0xff9f, '\u309a'],
+  [0xffa0, '\u1160'],
+  [0xffa1, '\u1100'],
+  [0xffa2, '\u1101'],
+  [0xffa3, '\u11aa'],
+  [0xffa4, '\u1102'],
+  [0xffa5, '\u11ac'],
+  [0xffa6, '\u11ad'],
+  [0xffa7, '\u1103'],
+  [0xffa8, '\u1104'],
+  [0xffa9, '\u1105'],
+  [0xffaa, '\u11b0'],
+  [0xffab, '\u11b1'],
+  [0xffac, '\u11b2'],
+  [0xffad, '\u11b3'],
+  [0xffae, '\u11b4'],
+  [0xffaf, '\u11b5'],
+  [0xffb0, '\u111a'],
+  [0xffb1, '\u1106'],
+  [0xffb2, '\u1107'],
+  [0xffb3, '\u1108'],
+  [0xffb4, '\u1121'],
+  [0xffb5, '\u1109'],
+  [0xffb6, '\u110a'],
+  [0xffb7, '\u110b'],
+  [0xffb8, '\u110c'],
+  [0xffb9, '\u110d'],
+  [0xffba, '\u110e'],
+  [0xffbb, '\u110f'],
+  [0xffbc, '\u1110'],
+  [0xffbd, '\u1111'],
+  [0xffbe, '\u1112'],
+  [0xffc2, '\u1161'],
+  [0xffc3, '\u1162'],
+  [0xffc4, '\u1163'],
+  [0xffc5, '\u1164'],
+  [0xffc6, '\u1165'],
+  [0xffc7, '\u1166'],
+  [0xffca, '\u1167'],
+  [0xffcb, '\u1168'],
+  [0xffcc, '\u1169'],
+  [0xffcd, '\u116a'],
+  [0xffce, '\u116b'],
+  [0xffcf, '\u116c'],
+  [0xffd2, '\u116d'],
+  [0xffd3, '\u116e'],
+  [0xffd4, '\u116f'],
+  [0xffd5, '\u1170'],
+  [0xffd6, '\u1171'],
+  [0xffd7, '\u1172'],
+  [0xffda, '\u1173'],
+  [0xffdb, '\u1174'],
+  [0xffdc, '\u1175'],
+  [0xffe8, '\u2502'],
+  [0xffe9, '\u2190'],
+  [0xffea, '\u2191'],
+  [0xffeb, '\u2192'],
+  [0xffec, '\u2193'],
+  [0xffed, '\u25a0'],
+  [0xffee, '\u25cb']
+];
+
+export const WIDE_COMPOSITIONS: ReadonlyArray<readonly [number, number, number]> = [
+  [0xff66, 0xff9e, 0x30fa],
+  [0xff73, 0xff9e, 0x30f4],
+  [0xff76, 0xff9e, 0x30ac],
+  [0xff77, 0xff9e, 0x30ae],
+  [0xff78, 0xff9e, 0x30b0],
+  [0xff79, 0xff9e, 0x30b2],
+  [0xff7a, 0xff9e, 0x30b4],
+  [0xff7b, 0xff9e, 0x30b6],
+  [0xff7c, 0xff9e, 0x30b8],
+  [0xff7d, 0xff9e, 0x30ba],
+  [0xff7e, 0xff9e, 0x30bc],
+  [0xff7f, 0xff9e, 0x30be],
+  [0xff80, 0xff9e, 0x30c0],
+  [0xff81, 0xff9e, 0x30c2],
+  [0xff82, 0xff9e, 0x30c5],
+  [0xff83, 0xff9e, 0x30c7],
+  [0xff84, 0xff9e, 0x30c9],
+  [0xff8a, 0xff9e, 0x30d0],
+  [0xff8a, 0xff9f, 0x30d1],
+  [0xff8b, 0xff9e, 0x30d3],
+  [0xff8b, 0xff9f, 0x30d4],
+  [0xff8c, 0xff9e, 0x30d6],
+  [0xff8c, 0xff9f, 0x30d7],
+  [0xff8d, 0xff9e, 0x30d9],
+  [0xff8d, 0xff9f, 0x30da],
+  [0xff8e, 0xff9e, 0x30dc],
+  [0xff8e, 0xff9f, 0x30dd],
+  [0xff9c, 0xff9e, 0x30f7]
+];
@@ -0,0 +1,182 @@
+/**
+ * Static analysis of search queries before they are sent
+ *
+ * Some queries have a known outcome without asking the server: `+foo -foo`
+ * can never match, and a query without any positive term is rejected. The
+ * analysis finds these cases (plus duplicate terms, which are harmless but
+ * wasteful) so the client can answer locally and skip the round trip.
+ */
+
+import { SearchExpression, parseSearchExpression } from './search-expression';
+
+const NO_POSITIVE_TERM = 'Search expression must have at least one positive term';
+
+/**
+ * What the client should do with a query
+ *
+ * - `send`: outcome depends on the index
+ * - `empty`: can never match; answer with an empty result
+ * - `invalid`: the server would reject it; answer with an error
+ */
+export type QueryVerdict = 'send' | 'empty' | 'invalid';
+
+/**
+ * Analysis result
+ *
+ * Only exact term matches are compared: `+Foo -foo` is not reported as a
+ * contradiction since the server's normalization is unknown here.
+ */
+export interface QueryAnalysis {
+  /** Suggested handling */
+  verdict: QueryVerdict;
+  /** Why the query is empty or invalid */
+  reason?: string;
+  /** Terms both required and excluded */
+  contradictions: string[];
+  /** Repeated terms */
+  duplicates: string[];
+}
+
+/**
+ * Remove repeated terms, keeping the first occurrence of each
+ *
+ * @param {string[]} terms - Terms
+ * @returns {string[]} Terms without repeats
+ */
+export function dedupeTerms(terms: string[]): string[] {
+  return Array.from(new Set(terms));
+}
+
+/**
+ * Compare required and excluded term lists
+ *
+ * @param {string[]} required - Required terms
+ * @param {string[]} excluded - Excluded terms
+ * @returns {QueryAnalysis} Analysis result
+ */
+function analyzeTermSets(required: string[], excluded: string[]): QueryAnalysis {
+  const analysis: QueryAnalysis = { verdict: 'send', contradictions: [], duplicates: [] };
+
+  const requiredSet = new Set<string>();
+  for (let i = 0; i < required.length; i += 1) {
+    if (requiredSet.has(required[i])) {
+      analysis.duplicates.push(required[i]);
+    }
+    requiredSet.add(required[i]);
+  }
+
+  const excludedSet = new Set<string>();
+  for (let i = 0; i < excluded.length; i += 1) {
+    const term = excluded[i];
+    if (excludedSet.has(term)) {
+      analysis.duplicates.push(term);
+    } else if (requiredSet.has(term)) {
+      analysis.contradictions.push(term);
+    }
+    excludedSet.add(term);
+  }
+
+  if (analysis.contradictions.length > 0) {
+    analysis.verdict = 'empty';
+    analysis.reason = `'${analysis.contradictions[0]}' is both required and excluded`;
+  }
+  return analysis;
+}
+
+/**
+ * Analyze a main query with additional AND/NOT terms
+ *
+ * A main query containing whitespace may be a whole expression, so it only
+ * counts as a positive part and is not compared with other terms.
+ *
+ * @param {string} query - Main search query
+ * @param {string[]} [andTerms=[]] - Additional required terms
+ * @param {string[]} [notTerms=[]] - Excluded terms
+ * @returns {QueryAnalysis} Analysis result
+ */
+export function analyzeTerms(query: string, andTerms: string[] = [], notTerms: string[] = []): QueryAnalysis {
+  const invalid = (reason: string): QueryAnalysis => ({
+    verdict: 'invalid',
+    reason,
+    contradictions: [],
+    duplicates: []
+  });
+
+  if (query.trim().length === 0) {
+    return invalid(andTerms.length === 0 && notTerms.length > 0 ? NO_POSITIVE_TERM : 'Search query cannot be empty');
+  }
+  if (andTerms.some((term) => term.length === 0)) {
+    return invalid('AND term cannot be empty');
+  }
+  if (notTerms.some((term) => term.length === 0)) {
+    return invalid('NOT term cannot be empty');
+  }
+
+  const required = /\s/.test(query) ? andTerms : [query, ...andTerms];
+  return analyzeTermSets(required, notTerms);
+}
+
+/**
+ * Parse and analyze a web-style search expression
+ *
+ * With OR or grouping, only explicitly required (+) terms are compared with
+ * excluded ones, since other terms may be OR alternatives.
+ *
+ * @param {string} expression - Web-style search expression
+ * @returns {QueryAnalysis} Analysis result (invalid with the parse error if it does not parse)
+ */
+export function analyzeExpression(expression: string): QueryAnalysis {
+  let expr: SearchExpression;
+  try {
+    expr = parseSearchExpression(expression);
+  } catch (error) {
+    return {
+      verdict: 'invalid',
+      reason: error instanceof Error ? error.message : String(error),
+      contradictions: [],
+      duplicates: []
+    };
+  }
+
+  const complex = expr.rawExpression.length > 0;
+  if (!complex && expr.requiredTerms.length === 0 && expr.optionalTerms.length === 0) {
+    return { verdict: 'invalid', reason: NO_POSITIVE_TERM, contradictions: [], duplicates: [] };
+  }
+
+  const required = complex ? expr.requiredTerms : [...expr.requiredTerms, ...expr.optionalTerms];
+  return analyzeTermSets(required, expr.excludedTerms);
+}
+
+/**
+ * Terms ready to send, with the analysis that produced them
+ */
+export interface PreparedTerms {
+  /** Analysis of the original terms */
+  analysis: QueryAnalysis;
+  /** Required terms without repeats (or the main query) */
+  andTerms: string[];
+  /** Excluded terms without repeats */
+  notTerms: string[];
+}
+
+/**
+ * Analyze terms and drop repeats when the query still has to be sent
+ *
+ * Dropping repeated required or excluded terms never changes the result.
+ *
+ * @param {string} query - Main search query
+ * @param {string[]} andTerms - Additional required terms
+ * @param {string[]} notTerms - Excluded terms
+ * @returns {PreparedTerms} Analysis and deduplicated terms
+ */
+export function prepareTerms(query: string, andTerms: string[], notTerms: string[]): PreparedTerms {
+  const analysis = analyzeTerms(query, andTerms, notTerms);
+  if (analysis.verdict !== 'send' || analysis.duplicates.length === 0) {
+    return { analysis, andTerms, notTerms };
+  }
+  return {
+    analysis,
+    andTerms: dedupeTerms(andTerms).filter((term) => term !== query),
+    notTerms: dedupeTerms(notTerms)
+  };
+}
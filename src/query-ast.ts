@@ -0,0 +1,374 @@
+/**
+ * Search expression AST (same grammar and output as the native parser)
+ *
+ * parseSearchExpression() in search-expression.ts is the original JS parser
+ * and keeps its own conventions (unprefixed terms are OR-ed). This module
+ * mirrors the native QueryAst instead, so code that falls back to JS when the
+ * addon is missing produces the same query strings and error messages.
+ *
+ * Grammar (highest precedence first):
+ * 1. Parentheses `()`, terms and `"phrases"`
+ * 2. Prefix operators `+` and `-`
+ * 3. `OR`
+ * 4. Implicit AND (space between terms)
+ *
+ * Examples:
+ * - `golang tutorial` → `golang AND tutorial`
+ * - `python OR ruby` → `python OR ruby`
+ * - `a OR b c` → `(a OR b) AND c`
+ * - `golang -(old OR legacy)` → `golang AND NOT (old OR legacy)`
+ */
+
+import type { SearchExpression } from './search-expression';
+
+/**
+ * Node of a parsed search expression
+ */
+export type QueryNode =
+  | { kind: 'term'; text: string }
+  | { kind: 'phrase'; text: string }
+  | { kind: 'not'; child: QueryNode }
+  | { kind: 'and' | 'or'; children: QueryNode[] };
+
+// Maximum parenthesis nesting (bounds parser recursion on untrusted input)
+const MAX_NESTING_DEPTH = 64;
+
+// Characters ending a bare term: ASCII whitespace, + - ( ) " and the full-width space
+const DELIMITER = /[ \t\n\v\f\r+\-()"\u3000]/;
+const WHITESPACE = /[ \t\n\v\f\r\u3000]/;
+const ALNUM = /[A-Za-z0-9]/;
+
+type TokenType = 'term' | 'quoted' | 'plus' | 'minus' | 'or' | 'lparen' | 'rparen' | 'end';
+
+const SINGLE_CHAR_TOKENS: Record<string, TokenType | undefined> = {
+  '+': 'plus',
+  '-': 'minus',
+  '(': 'lparen',
+  ')': 'rparen'
+};
+
+interface Token {
+  type: TokenType;
+  value: string;
+  /** Raw quoted text (before escapes are resolved) was empty */
+  empty: boolean;
+}
+
+/**
+ * Tokenizer with one token of lookahead (see the native Tokenizer)
+ */
+class Tokenizer {
+  private input: string;
+  private pos = 0;
+  private peeked: Token | null = null;
+
+  constructor(input: string) {
+    this.input = input;
+  }
+
+  next(): Token {
+    if (this.peeked) {
+      const token = this.peeked;
+      this.peeked = null;
+      return token;
+    }
+    return this.scan();
+  }
+
+  peek(): Token {
+    if (!this.peeked) {
+      this.peeked = this.scan();
+    }
+    return this.peeked;
+  }
+
+  private scan(): Token {
+    const { input } = this;
+    while (this.pos < input.length && WHITESPACE.test(input[this.pos])) {
+      this.pos += 1;
+    }
+    if (this.pos >= input.length) {
+      return { type: 'end', value: '', empty: false };
+    }
+
+    const char = input[this.pos];
+    if (char === '"') {
+      return this.readQuoted();
+    }
+    const single = SINGLE_CHAR_TOKENS[char];
+    if (single) {
+      this.pos += 1;
+      return { type: single, value: char, empty: false };
+    }
+
+    // OR operator, only as a whole word
+    if (
+      input.startsWith('OR', this.pos) &&
+      (this.pos === 0 || !ALNUM.test(input[this.pos - 1])) &&
+      (this.pos + 2 === input.length || !ALNUM.test(input[this.pos + 2]))
+    ) {
+      this.pos += 2;
+      return { type: 'or', value: 'OR', empty: false };
+    }
+
+    const start = this.pos;
+    while (this.pos < input.length && !DELIMITER.test(input[this.pos])) {
+      this.pos += 1;
+    }
+    return { type: 'term', value: input.slice(start, this.pos), empty: false };
+  }
+
+  private readQuoted(): Token {
+    const { input } = this;
+    this.pos += 1; // Skip opening quote
+    const start = this.pos;
+    let value = '';
+    // An escaped quote does not close the phrase; an unclosed quote takes the rest
+    while (this.pos < input.length && input[this.pos] !== '"') {
+      if (input[this.pos] === '\\' && this.pos + 1 < input.length) {
+        this.pos += 1;
+      }
+      value += input[this.pos];
+      this.pos += 1;
+    }
+    const empty = this.pos === start;
+    if (this.pos < input.length) {
+      this.pos += 1; // Skip closing quote
+    }
+    return { type: 'quoted', value, empty };
+  }
+}
+
+/**
+ * Build a group, flattening children of the same kind (a single child stands alone)
+ */
+function makeGroup(kind: 'and' | 'or', children: QueryNode[]): QueryNode {
+  const flat: QueryNode[] = [];
+  for (const child of children) {
+    if (child.kind === kind) {
+      flat.push(...child.children);
+    } else {
+      flat.push(child);
+    }
+  }
+  return flat.length === 1 ? flat[0] : { kind, children: flat };
+}
+
+/**
+ * Negate a node (NOT NOT x is x)
+ */
+function makeNot(child: QueryNode): QueryNode {
+  return child.kind === 'not' ? child.child : { kind: 'not', child };
+}
+
+/**
+ * Recursive descent parser (see the native Parser for the grammar)
+ */
+class Parser {
+  private tokenizer: Tokenizer;
+  private current: Token;
+
+  constructor(input: string) {
+    this.tokenizer = new Tokenizer(input);
+    this.current = this.tokenizer.next();
+  }
+
+  parse(): QueryNode {
+    const root = this.parseAnd(0);
+    if (this.current.type === 'rparen') {
+      throw new Error("Unexpected ')'");
+    }
+    if (!root) {
+      throw new Error('Empty search expression');
+    }
+    return root;
+  }
+
+  private advance(): void {
+    this.current = this.tokenizer.next();
+  }
+
+  // and := or { or }  (stops at ')' or end; returns null when empty)
+  private parseAnd(depth: number): QueryNode | null {
+    const children: QueryNode[] = [];
+    while (this.current.type !== 'end' && this.current.type !== 'rparen') {
+      if (this.current.type === 'or') {
+        throw new Error("Unexpected 'OR' operator");
+      }
+      children.push(this.parseOr(depth));
+    }
+    return children.length === 0 ? null : makeGroup('and', children);
+  }
+
+  // or := unary { "OR" unary }
+  private parseOr(depth: number): QueryNode {
+    const children = [this.parseUnary(depth)];
+    while (this.current.type === 'or') {
+      const next = this.tokenizer.peek().type;
+      if (next === 'end' || next === 'rparen' || next === 'or') {
+        throw new Error("Expected term after 'OR'");
+      }
+      this.advance();
+      children.push(this.parseUnary(depth));
+    }
+    return makeGroup('or', children);
+  }
+
+  // unary := [ "+" | "-" ] primary
+  private parseUnary(depth: number): QueryNode {
+    if (this.current.type === 'plus' || this.current.type === 'minus') {
+      const negate = this.current.type === 'minus';
+      this.advance();
+      if (this.current.type !== 'term' && this.current.type !== 'quoted' && this.current.type !== 'lparen') {
+        throw new Error(`Expected term after '${negate ? '-' : '+'}'`);
+      }
+      const child = this.parsePrimary(depth);
+      return negate ? makeNot(child) : child;
+    }
+    return this.parsePrimary(depth);
+  }
+
+  // primary := term | "phrase" | "(" and ")"
+  private parsePrimary(depth: number): QueryNode {
+    const token = this.current;
+    switch (token.type) {
+      case 'term':
+        this.advance();
+        return { kind: 'term', text: token.value };
+      case 'quoted':
+        if (token.empty) {
+          throw new Error('Empty phrase');
+        }
+        this.advance();
+        return { kind: 'phrase', text: token.value };
+      case 'lparen': {
+        if (depth >= MAX_NESTING_DEPTH) {
+          throw new Error('Expression nested too deeply');
+        }
+        this.advance();
+        const node = this.parseAnd(depth + 1);
+        if (this.current.type !== 'rparen') {
+          throw new Error('Unbalanced parentheses');
+        }
+        if (!node) {
+          throw new Error('Empty parentheses');
+        }
+        this.advance();
+        return node;
+      }
+      case 'rparen':
+        throw new Error("Unexpected ')'");
+      case 'or':
+        throw new Error("Unexpected 'OR' operator");
+      default:
+        throw new Error('Unexpected end of expression');
+    }
+  }
+}
+
+/**
+ * Parse a web-style search expression into an AST
+ *
+ * @param {string} expression - Web-style search expression
+ * @returns {QueryNode} Root node
+ * @throws {Error} With the native parser's message if the expression is invalid
+ */
+export function parseQueryAst(expression: string): QueryNode {
+  return new Parser(expression).parse();
+}
+
+/**
+ * Quote a phrase with backslash escapes
+ *
+ * @param {string} text - Phrase text
+ * @returns {string} Quoted phrase
+ */
+function quote(text: string): string {
+  return `"${text.replace(/["\\]/g, '\\$&')}"`;
+}
+
+/**
+ * Serialize a node, parenthesizing nested groups
+ *
+ * @param {QueryNode} node - Node to serialize
+ * @param {boolean} nested - Node is an operand of another operator
+ * @returns {string} Query string
+ */
+function formatNode(node: QueryNode, nested: boolean): string {
+  switch (node.kind) {
+    case 'term':
+      return node.text === 'AND' || node.text === 'OR' || node.text === 'NOT' ? quote(node.text) : node.text;
+    case 'phrase':
+      return quote(node.text);
+    case 'not':
+      return `NOT ${formatNode(node.child, true)}`;
+    default:
+      break;
+  }
+
+  // Positive children first (the server expects a positive term before NOT)
+  let children = node.children;
+  if (node.kind === 'and') {
+    const negated = children.filter((child) => child.kind === 'not');
+    children = [...children.filter((child) => child.kind !== 'not'), ...negated];
+  }
+  const joined = children.map((child) => formatNode(child, true)).join(node.kind === 'and' ? ' AND ' : ' OR ');
+  return nested ? `(${joined})` : joined;
+}
+
+/**
+ * Serialize an AST into a QueryAST-compatible query string
+ *
+ * @param {QueryNode} node - Root node
+ * @returns {string} Query string
+ */
+export function formatQueryAst(node: QueryNode): string {
+  return formatNode(node, false);
+}
+
+/**
+ * Flatten an AST into required, excluded and raw parts
+ *
+ * Top-level terms and phrases become required terms, top-level negated terms
+ * become excluded terms, and everything else is serialized into rawExpression
+ * (joined with AND, OR groups parenthesized when there are several parts).
+ *
+ * @param {QueryNode} root - Root node
+ * @returns {SearchExpression} Flattened expression (optionalTerms is always empty)
+ */
+export function flattenQueryAst(root: QueryNode): SearchExpression {
+  const expr: SearchExpression = { requiredTerms: [], excludedTerms: [], optionalTerms: [], rawExpression: '' };
+  const complexParts: QueryNode[] = [];
+  for (const node of root.kind === 'and' ? root.children : [root]) {
+    if (node.kind === 'term' || node.kind === 'phrase') {
+      expr.requiredTerms.push(formatQueryAst(node));
+    } else if (node.kind === 'not' && (node.child.kind === 'term' || node.child.kind === 'phrase')) {
+      expr.excludedTerms.push(formatQueryAst(node.child));
+    } else {
+      complexParts.push(node);
+    }
+  }
+  expr.rawExpression = complexParts
+    .map((node) => formatNode(node, complexParts.length > 1 && node.kind === 'or'))
+    .join(' AND ');
+  return expr;
+}
+
+/**
+ * Simplify an AST to basic terms
+ *
+ * Expressions with OR or grouping have no such form and are rejected rather
+ * than simplified to a wider query.
+ *
+ * @param {QueryNode} root - Root node
+ * @returns {{ mainTerm: string, andTerms: string[], notTerms: string[] } | null} Terms, or null
+ */
+export function simplifyQueryAst(
+  root: QueryNode
+): { mainTerm: string; andTerms: string[]; notTerms: string[] } | null {
+  const expr = flattenQueryAst(root);
+  if (expr.rawExpression.length > 0 || expr.requiredTerms.length === 0) {
+    return null;
+  }
+  return { mainTerm: expr.requiredTerms[0], andTerms: expr.requiredTerms.slice(1), notTerms: expr.excludedTerms };
+}
@@ -0,0 +1,219 @@
+/**
+ * Query cost estimation from hybrid n-gram expansion
+ *
+ * The server splits every term into hybrid n-grams and looks up one posting
+ * list per n-gram, so a long term or a long OR chain can expand into
+ * hundreds of lookups. The estimate repeats that split on the client so
+ * expensive queries can be routed, deprioritized or rejected before sending.
+ */
+
+import { QueryNormalization } from './types';
+import { normalizeQueryTerm } from './query-key';
+import { parseSearchExpression } from './search-expression';
+
+/**
+ * Coarse cost class of a query
+ */
+export type QueryCostClass = 'low' | 'moderate' | 'high' | 'excessive';
+
+/**
+ * Cost estimation options
+ *
+ * The n-gram sizes and normalization must match the server's configuration
+ * for the counts to match what the server looks up.
+ */
+export interface QueryCostOptions extends QueryNormalization {
+  /** Server's ngram_size for non-CJK text (default: 2) */
+  asciiNgramSize?: number;
+  /** Server's kanji_ngram_size (default: 1) */
+  kanjiNgramSize?: number;
+  /** Total n-grams for the 'moderate' class (default: 32) */
+  moderateNgrams?: number;
+  /** Total n-grams for the 'high' class (default: 128) */
+  highNgrams?: number;
+  /** Total n-grams for the 'excessive' class (default: 512) */
+  excessiveNgrams?: number;
+}
+
+/**
+ * Cost of one term
+ */
+export interface TermCost {
+  /** Term text as parsed (phrases without quotes) */
+  term: string;
+  /** N-grams the term expands into */
+  ngrams: number;
+  /** Quoted phrase */
+  phrase: boolean;
+  /** Under a NOT */
+  excluded: boolean;
+  /** Under an OR (one alternative among others) */
+  optional: boolean;
+}
+
+/**
+ * Estimated cost of a query
+ */
+export interface QueryCost {
+  /** Every term and phrase */
+  terms: TermCost[];
+  /** Sum of n-grams over all terms (posting list lookups) */
+  totalNgrams: number;
+  /** Distinct n-grams over the whole query */
+  distinctNgrams: number;
+  /** N-grams of the most expensive term */
+  maxTermNgrams: number;
+  /** Terms too short to produce any n-gram */
+  shortTerms: number;
+  /** Class of totalNgrams */
+  costClass: QueryCostClass;
+}
+
+// Native estimate shape (snake_case, as returned by the binding)
+export interface NativeQueryCost {
+  terms: TermCost[];
+  total_ngrams: number;
+  distinct_ngrams: number;
+  max_term_ngrams: number;
+  short_terms: number;
+  cost_class: QueryCostClass;
+}
+
+/**
+ * Check if a code point is a CJK ideograph (same ranges as the server)
+ *
+ * Hiragana and katakana are not ideographs; they use the ASCII n-gram size.
+ *
+ * @param {number} codePoint - Unicode code point
+ * @returns {boolean} True for CJK ideographs
+ */
+export function isCjkIdeograph(codePoint: number): boolean {
+  return (
+    (codePoint >= 0x4e00 && codePoint <= 0x9fff) ||
+    (codePoint >= 0x3400 && codePoint <= 0x4dbf) ||
+    (codePoint >= 0x20000 && codePoint <= 0x2a6df) ||
+    (codePoint >= 0x2a700 && codePoint <= 0x2b73f) ||
+    (codePoint >= 0x2b740 && codePoint <= 0x2b81f) ||
+    (codePoint >= 0xf900 && codePoint <= 0xfaff)
+  );
+}
+
+/**
+ * Split text into hybrid n-grams
+ *
+ * CJK ideographs form n-grams of kanjiNgramSize, everything else of
+ * asciiNgramSize; an n-gram never mixes the two kinds.
+ *
+ * @param {string} text - Normalized text
+ * @param {number} [asciiNgramSize=2] - N-gram size for non-CJK characters
+ * @param {number} [kanjiNgramSize=1] - N-gram size for CJK ideographs
+ * @returns {string[]} N-grams in text order
+ */
+export function generateHybridNgrams(text: string, asciiNgramSize = 2, kanjiNgramSize = 1): string[] {
+  const chars = Array.from(text);
+  const cjk = chars.map((char) => isCjkIdeograph(char.codePointAt(0) ?? 0));
+  const ngrams: string[] = [];
+
+  for (let i = 0; i < chars.length; i += 1) {
+    const size = cjk[i] ? kanjiNgramSize : asciiNgramSize;
+    let sameKind = i + size <= chars.length;
+    for (let j = 1; sameKind && j < size; j += 1) {
+      sameKind = cjk[i + j] === cjk[i];
+    }
+    if (sameKind) {
+      ngrams.push(chars.slice(i, i + size).join(''));
+    }
+  }
+  return ngrams;
+}
+
+/**
+ * Classify a total n-gram count
+ *
+ * @param {number} totalNgrams - Total n-grams of a query
+ * @param {QueryCostOptions} [options={}] - Class thresholds
+ * @returns {QueryCostClass} Cost class
+ */
+export function classifyQueryCost(totalNgrams: number, options: QueryCostOptions = {}): QueryCostClass {
+  const { moderateNgrams = 32, highNgrams = 128, excessiveNgrams = 512 } = options;
+  if (totalNgrams >= excessiveNgrams) {
+    return 'excessive';
+  }
+  if (totalNgrams >= highNgrams) {
+    return 'high';
+  }
+  return totalNgrams >= moderateNgrams ? 'moderate' : 'low';
+}
+
+/**
+ * Estimate the cost of a search expression in JavaScript
+ *
+ * Terms are listed required first, then unprefixed, then excluded. With OR
+ * or grouping, every unprefixed term is marked optional.
+ *
+ * @param {string} expression - Web-style search expression
+ * @param {QueryCostOptions} [options={}] - Estimation options
+ * @returns {QueryCost} Estimated cost
+ * @throws {Error} If the expression does not parse
+ */
+export function estimateQueryCostJs(expression: string, options: QueryCostOptions = {}): QueryCost {
+  const { asciiNgramSize = 2, kanjiNgramSize = 1 } = options;
+  const expr = parseSearchExpression(expression);
+  const complex = expr.rawExpression.length > 0;
+  const phrases = new Set<string>();
+  const phrasePattern = /"([^"]*)"/g;
+  let match = phrasePattern.exec(expression);
+  while (match !== null) {
+    phrases.add(match[1]);
+    match = phrasePattern.exec(expression);
+  }
+
+  const cost: QueryCost = {
+    terms: [],
+    totalNgrams: 0,
+    distinctNgrams: 0,
+    maxTermNgrams: 0,
+    shortTerms: 0,
+    costClass: 'low'
+  };
+  const distinct = new Set<string>();
+
+  const addTerms = (terms: string[], excluded: boolean, optional: boolean): void => {
+    for (let i = 0; i < terms.length; i += 1) {
+      const ngrams = generateHybridNgrams(normalizeQueryTerm(terms[i], options), asciiNgramSize, kanjiNgramSize);
+      for (let j = 0; j < ngrams.length; j += 1) {
+        distinct.add(ngrams[j]);
+      }
+      cost.terms.push({ term: terms[i], ngrams: ngrams.length, phrase: phrases.has(terms[i]), excluded, optional });
+      cost.totalNgrams += ngrams.length;
+      cost.maxTermNgrams = Math.max(cost.maxTermNgrams, ngrams.length);
+      if (ngrams.length === 0) {
+        cost.shortTerms += 1;
+      }
+    }
+  };
+  addTerms(expr.requiredTerms, false, false);
+  addTerms(expr.optionalTerms, false, complex);
+  addTerms(expr.excludedTerms, true, false);
+
+  cost.distinctNgrams = distinct.size;
+  cost.costClass = classifyQueryCost(cost.totalNgrams, options);
+  return cost;
+}
+
+/**
+ * Convert a native estimate to QueryCost
+ *
+ * @param {NativeQueryCost} native - Estimate returned by the binding
+ * @returns {QueryCost} Estimated cost
+ */
+export function fromNativeQueryCost(native: NativeQueryCost): QueryCost {
+  return {
+    terms: native.terms,
+    totalNgrams: native.total_ngrams,
+    distinctNgrams: native.distinct_ngrams,
+    maxTermNgrams: native.max_term_ngrams,
+    shortTerms: native.short_terms,
+    costClass: native.cost_class
+  };
+}
@@ -0,0 +1,337 @@
+/**
+ * Canonical query forms and command keys
+ *
+ * "+foo +bar", "bar foo" and "foo  bar" all ask the server for the same
+ * documents, yet naive command building produces three different strings.
+ * Canonicalization sorts and dedupes the AND/NOT term sets (and filters) so
+ * equivalent queries map to one key, suitable for result caching and for
+ * coalescing concurrent identical requests.
+ *
+ * Keys match the native canonical keys byte for byte (strings are ordered by
+ * code point, which is UTF-8 byte order, and widths are converted with the
+ * native tables).
+ */
+
+import { CountOptions, QueryNormalization, SearchOptions } from './types';
+import { flattenQueryAst, parseQueryAst } from './query-ast';
+import { NARROW_MAPPINGS, WIDE_COMPOSITIONS, WIDE_MAPPINGS } from './normalization-tables';
+
+const NARROW = new Map(NARROW_MAPPINGS);
+const WIDE = new Map(WIDE_MAPPINGS);
+const CODE_POINT_LIMIT = 0x110000;
+const WIDE_COMPOSED = new Map(
+  WIDE_COMPOSITIONS.map(([first, second, composed]) => [first * CODE_POINT_LIMIT + second, composed])
+);
+
+/**
+ * Search terms in canonical order
+ */
+export interface CanonicalTerms {
+  /** Smallest positive term */
+  mainTerm: string;
+  /** Remaining positive terms (sorted) */
+  andTerms: string[];
+  /** Excluded terms (sorted) */
+  notTerms: string[];
+}
+
+/**
+ * Replace each code point that has a mapping
+ *
+ * @param {number[]} codePoints - Input code points
+ * @param {Map<number, string>} mappings - Code point to replacement text
+ * @returns {string} Mapped text
+ */
+function mapCodePoints(codePoints: number[], mappings: Map<number, string>): string {
+  let result = '';
+  for (let i = 0; i < codePoints.length; i += 1) {
+    result += mappings.get(codePoints[i]) ?? String.fromCodePoint(codePoints[i]);
+  }
+  return result;
+}
+
+/**
+ * Convert full-width forms to half-width (ICU Fullwidth-Halfwidth, as the native normalizer)
+ *
+ * @param {string} text - Input text
+ * @returns {string} Converted text
+ */
+function toNarrow(text: string): string {
+  return mapCodePoints(Array.from(text, (ch) => ch.codePointAt(0) as number), NARROW);
+}
+
+/**
+ * Convert half-width forms to full-width (ICU Halfwidth-Fullwidth, as the native normalizer)
+ *
+ * Half-width voiced kana are two code points that widen into one.
+ *
+ * @param {string} text - Input text
+ * @returns {string} Converted text
+ */
+function toWide(text: string): string {
+  const codePoints: number[] = [];
+  for (const ch of text) {
+    const codePoint = ch.codePointAt(0) as number;
+    const last = codePoints.length - 1;
+    const composed = last >= 0 ? WIDE_COMPOSED.get(codePoints[last] * CODE_POINT_LIMIT + codePoint) : undefined;
+    if (composed !== undefined) {
+      codePoints[last] = composed;
+    } else {
+      codePoints.push(codePoint);
+    }
+  }
+  return mapCodePoints(codePoints, WIDE);
+}
+
+/**
+ * Compare strings by code point (the native byte order; plain sort() uses UTF-16 units)
+ *
+ * @param {string} a - First string
+ * @param {string} b - Second string
+ * @returns {number} Negative, zero or positive
+ */
+function compareCodePoints(a: string, b: string): number {
+  const length = Math.min(a.length, b.length);
+  for (let i = 0; i < length; i += 1) {
+    const x = a.codePointAt(i) as number;
+    const y = b.codePointAt(i) as number;
+    if (x !== y) {
+      return x - y;
+    }
+    if (x > 0xffff) {
+      i += 1;
+    }
+  }
+  return a.length - b.length;
+}
+
+/**
+ * Sort strings and drop duplicates and empty strings
+ *
+ * @param {string[]} values - Input strings
+ * @returns {string[]} Sorted unique non-empty strings
+ */
+function sortUnique(values: string[]): string[] {
+  return Array.from(new Set(values.filter((value) => value.length > 0))).sort(compareCodePoints);
+}
+
+/**
+ * Normalize a single term
+ *
+ * Same steps as the native normalizer: NFKC, width conversion with the
+ * native tables, then lowercasing.
+ *
+ * @param {string} term - Search term
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @returns {string} Normalized term
+ */
+export function normalizeQueryTerm(term: string, normalization: QueryNormalization = {}): string {
+  const { nfkc = false, width = 'keep', lower = false } = normalization;
+  let result = nfkc ? term.normalize('NFKC') : term;
+  if (width === 'narrow') {
+    result = toNarrow(result);
+  } else if (width === 'wide') {
+    result = toWide(result);
+  }
+  return lower ? result.toLowerCase() : result;
+}
+
+/**
+ * Canonicalize positive and excluded term sets
+ *
+ * @param {string[]} positive - Required terms
+ * @param {string[]} negative - Excluded terms
+ * @param {QueryNormalization} normalization - Normalization settings
+ * @returns {CanonicalTerms} Canonical terms
+ */
+function canonicalizeTermSets(
+  positive: string[],
+  negative: string[],
+  normalization: QueryNormalization
+): CanonicalTerms {
+  const sortedPositive = sortUnique(positive.map((term) => normalizeQueryTerm(term, normalization)));
+  return {
+    mainTerm: sortedPositive.length > 0 ? sortedPositive[0] : '',
+    andTerms: sortedPositive.slice(1),
+    notTerms: sortUnique(negative.map((term) => normalizeQueryTerm(term, normalization)))
+  };
+}
+
+/**
+ * Canonicalize a main term with additional AND/NOT terms
+ *
+ * The main term is just another required term, so it takes part in sorting.
+ * Empty terms are dropped (mainTerm stays empty if no positive term is left).
+ *
+ * @param {string} query - Main search term
+ * @param {string[]} [andTerms=[]] - Additional required terms
+ * @param {string[]} [notTerms=[]] - Excluded terms
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @returns {CanonicalTerms} Canonical terms
+ */
+export function canonicalizeTerms(
+  query: string,
+  andTerms: string[] = [],
+  notTerms: string[] = [],
+  normalization: QueryNormalization = {}
+): CanonicalTerms {
+  return canonicalizeTermSets([query, ...andTerms], notTerms, normalization);
+}
+
+/**
+ * Canonicalize a web-style search expression
+ *
+ * @param {string} expression - Web-style search expression
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @returns {CanonicalTerms} Canonical terms
+ * @throws {Error} If the expression is invalid, uses OR or grouping, or has no positive term
+ */
+export function canonicalizeExpression(expression: string, normalization: QueryNormalization = {}): CanonicalTerms {
+  const expr = flattenQueryAst(parseQueryAst(expression));
+  if (expr.rawExpression.length > 0) {
+    throw new Error('Expressions with OR or grouping have no canonical term form');
+  }
+  const positive = [...expr.requiredTerms, ...expr.optionalTerms];
+  if (positive.length === 0) {
+    throw new Error('Search expression must have at least one positive term');
+  }
+  return canonicalizeTermSets(positive, expr.excludedTerms, normalization);
+}
+
+/**
+ * Quote a term if it contains whitespace or quotes (same rules as the native client)
+ *
+ * @param {string} term - Term or filter value
+ * @returns {string} Term safe to embed in a key
+ */
+export function escapeQueryTerm(term: string): string {
+  if (!/[ \t\n\r"']/.test(term)) {
+    return term;
+  }
+  return `"${term.replace(/["\\]/g, '\\$&')}"`;
+}
+
+/**
+ * Build the shared term and filter part of a key
+ *
+ * @param {CanonicalTerms} terms - Canonical terms
+ * @param {Record<string, string>} filters - Filter conditions
+ * @returns {string[]} Key parts
+ */
+function termAndFilterParts(terms: CanonicalTerms, filters: Record<string, string>): string[] {
+  const parts = [escapeQueryTerm(terms.mainTerm)];
+  for (let i = 0; i < terms.andTerms.length; i += 1) {
+    parts.push('AND', escapeQueryTerm(terms.andTerms[i]));
+  }
+  for (let i = 0; i < terms.notTerms.length; i += 1) {
+    parts.push('NOT', escapeQueryTerm(terms.notTerms[i]));
+  }
+  const keys = Object.keys(filters).sort(compareCodePoints);
+  for (let i = 0; i < keys.length; i += 1) {
+    parts.push('FILTER', keys[i], '=', escapeQueryTerm(filters[keys[i]]));
+  }
+  return parts;
+}
+
+/**
+ * Build the canonical SEARCH key for a query
+ *
+ * Equivalent queries (term order, duplicate terms, filter order and
+ * normalization differences) produce the same string. Option defaults are
+ * resolved first, so omitting an option and passing its default match too.
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {SearchOptions} [options={}] - Search options
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @returns {string} Canonical key
+ */
+export function canonicalSearchKey(
+  table: string,
+  query: string,
+  options: SearchOptions = {},
+  normalization: QueryNormalization = {}
+): string {
+  const {
+    limit = 1000,
+    offset = 0,
+    andTerms = [],
+    notTerms = [],
+    filters = {},
+    sortColumn = '',
+    sortDesc = true
+  } = options;
+  const terms = canonicalizeTerms(query, andTerms, notTerms, normalization);
+  const parts = ['SEARCH', table, ...termAndFilterParts(terms, filters)];
+  // Same clauses as the native command: primary key DESC and offset 0 are left implicit
+  if (sortColumn) {
+    parts.push('SORT', sortColumn, sortDesc ? 'DESC' : 'ASC');
+  } else if (!sortDesc) {
+    parts.push('SORT', 'ASC');
+  }
+  if (limit > 0 && offset > 0) {
+    parts.push('LIMIT', `${offset},${limit}`);
+  } else if (limit > 0) {
+    parts.push('LIMIT', `${limit}`);
+  }
+  return parts.join(' ');
+}
+
+/**
+ * Build the canonical COUNT key for a query
+ *
+ * @param {string} table - Table name
+ * @param {string} query - Main search term
+ * @param {CountOptions} [options={}] - Count options
+ * @param {QueryNormalization} [normalization={}] - Normalization settings
+ * @returns {string} Canonical key
+ */
+export function canonicalCountKey(
+  table: string,
+  query: string,
+  options: CountOptions = {},
+  normalization: QueryNormalization = {}
+): string {
+  const { andTerms = [], notTerms = [], filters = {} } = options;
+  const terms = canonicalizeTerms(query, andTerms, notTerms, normalization);
+  return ['COUNT', table, ...termAndFilterParts(terms, filters)].join(' ');
+}
+
+/**
+ * Coalesce concurrent calls that share a key
+ *
+ * While a task for a key is running, further run() calls with that key get
+ * the same promise instead of starting another task. The entry is dropped
+ * once the task settles, so later calls start fresh.
+ */
+export class SingleFlight<T> {
+  private inFlight = new Map<string, Promise<T>>();
+
+  /**
+   * Run a task, or join the one already running for the key
+   *
+   * @param {string} key - Request key
+   * @param {() => Promise<T>} task - Task to start if none is running
+   * @returns {Promise<T>} Task result (shared by all joined callers)
+   */
+  run(key: string, task: () => Promise<T>): Promise<T> {
+    const running = this.inFlight.get(key);
+    if (running) {
+      return running;
+    }
+    const promise = task().finally(() => {
+      this.inFlight.delete(key);
+    });
+    this.inFlight.set(key, promise);
+    return promise;
+  }
+
+  /**
+   * Number of keys with a running task
+   *
+   * @returns {number} Running tasks
+   */
+  get size(): number {
+    return this.inFlight.size;
+  }
+}
@@ -20,6 +20,8 @@
  * - `hello world` → `hello AND world` (full-width space supported)
  */
 
+import { formatQueryAst, parseQueryAst } from './query-ast';
+
 /**
  * Parsed search expression components
  */
@@ -319,3 +321,57 @@ export function simplifySearchExpression(expression: string): {
     notTerms: expr.excludedTerms
   };
 }
+
+/**
+ * Result of converting one expression of a batch
+ */
+export type ConvertedExpression = { ok: true; query: string } | { ok: false; error: string };
+
+/**
+ * Batch conversion results packed into one string (native binding format)
+ *
+ * Entry i is `data.slice(offsets[i], offsets[i + 1])`: the converted query
+ * when `ok[i]` is 1, the parse error message when it is 0.
+ */
+export interface PackedConversions {
+  /** Query strings and error messages, back to back */
+  data: string;
+  /** Entry boundaries (UTF-16 offsets, one more than the number of entries) */
+  offsets: Uint32Array;
+  /** 1 if the entry converted, 0 if it holds the error */
+  ok: Uint8Array;
+}
+
+/**
+ * Unpack batch conversion results
+ *
+ * @param {PackedConversions} packed - Packed results
+ * @returns {ConvertedExpression[]} One result per input, in input order
+ */
+export function unpackConversions(packed: PackedConversions): ConvertedExpression[] {
+  const results: ConvertedExpression[] = new Array(packed.ok.length);
+  for (let i = 0; i < packed.ok.length; i += 1) {
+    const text = packed.data.slice(packed.offsets[i], packed.offsets[i + 1]);
+    results[i] = packed.ok[i] === 1 ? { ok: true, query: text } : { ok: false, error: text };
+  }
+  return results;
+}
+
+/**
+ * Convert many search expressions, reporting errors per entry
+ *
+ * Parses with parseQueryAst, so the queries and error messages are the ones
+ * the native batch conversion returns (unlike convertSearchExpression).
+ *
+ * @param {string[]} expressions - Web-style search expressions
+ * @returns {ConvertedExpression[]} One result per input, in input order
+ */
+export function convertSearchExpressions(expressions: string[]): ConvertedExpression[] {
+  return expressions.map((expression): ConvertedExpression => {
+    try {
+      return { ok: true, query: formatQueryAst(parseQueryAst(expression)) };
+    } catch (error) {
+      return { ok: false, error: error instanceof Error ? error.message : String(error) };
+    }
+  });
+}
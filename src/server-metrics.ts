@@ -0,0 +1,406 @@
+/**
+ * Server metrics from INFO deltas
+ *
+ * INFO reports cumulative counters (total_requests, doc_count, ...). A metrics
+ * collector samples them on a schedule and turns consecutive samples into
+ * rates over rolling windows, so applications can watch query load and index
+ * growth without an external scraper.
+ */
+
+import { ClientConfig, InfoSnapshot, MetricsWindow, ServerMetrics } from './types';
+import { ConnectionError } from './errors';
+import { InfoPoller, InfoSource } from './info-poller';
+
+const DEFAULT_INTERVAL_MS = 1000;
+const DEFAULT_WINDOWS = [60, 300, 900];
+
+/**
+ * Metrics collector options
+ */
+export interface MetricsCollectorOptions {
+  /** Delay between samples in milliseconds (default: 1000) */
+  intervalMs?: number;
+  /** Rolling window lengths in seconds (default: 60, 300, 900) */
+  windows?: number[];
+}
+
+// One INFO sample with restart-stitched cumulative counters
+interface MetricsSample {
+  capturedAt: number;
+  requests: number;
+  errors: number;
+  docCount: number;
+  indexSizeBytes: number;
+}
+
+// Server metrics as returned by the native binding
+interface NativeServerMetrics {
+  captured_at_ms: number;
+  sample_count: number;
+  doc_count: number;
+  index_size_bytes: number;
+  index_bytes_per_doc: number;
+  active_connections: number;
+  reports_errors: boolean;
+  counter_resets: number;
+  windows: Array<{
+    window_seconds: number;
+    covered_seconds: number;
+    requests_per_second: number;
+    errors_per_second: number;
+    error_ratio: number;
+    docs_per_second: number;
+    doc_delta: number;
+    index_bytes_delta: number;
+  }>;
+}
+
+// Native collector binding interface
+interface NativeMetricsCollectorBinding {
+  createMetricsCollector(host: string, port: number, timeout: number, intervalMs: number, windows: number[]): unknown;
+  startMetricsCollector(collector: unknown): boolean;
+  destroyMetricsCollector(collector: unknown): void;
+  getServerMetrics(collector: unknown): NativeServerMetrics;
+  getMetricsCollectorError(collector: unknown): string;
+}
+
+/**
+ * Zeroed window for a collector without samples
+ *
+ * @param {number} windowSeconds - Window length in seconds
+ * @returns {MetricsWindow} Window with zero rates
+ */
+function emptyWindow(windowSeconds: number): MetricsWindow {
+  return {
+    windowSeconds,
+    coveredSeconds: 0,
+    requestsPerSecond: 0,
+    errorsPerSecond: 0,
+    errorRatio: 0,
+    docsPerSecond: 0,
+    docDelta: 0,
+    indexBytesDelta: 0
+  };
+}
+
+/**
+ * Rolling-window rate calculator over INFO snapshots
+ *
+ * Counters that go backwards (server restart) are stitched so rates stay
+ * non-negative across the restart. Samples older than the longest window are
+ * discarded.
+ */
+export class MetricsAccumulator {
+  private windows: number[];
+  private maxWindowMs: number;
+  private samples: MetricsSample[] = [];
+  private requestOffset = 0;
+  private errorOffset = 0;
+  private previous: { uptime: number; requests: number; errors: number } | undefined;
+  private activeConnections = 0;
+  private reportsErrors = false;
+  private counterResets = 0;
+
+  /**
+   * Create a new accumulator
+   *
+   * @param {number[]} [windows=[60, 300, 900]] - Rolling window lengths in seconds
+   */
+  constructor(windows: number[] = DEFAULT_WINDOWS) {
+    this.windows = windows.length > 0 ? windows.slice() : DEFAULT_WINDOWS;
+    this.maxWindowMs = Math.max(...this.windows) * 1000;
+  }
+
+  /**
+   * Add a sample (snapshots must arrive in capture order)
+   *
+   * @param {InfoSnapshot} snapshot - INFO snapshot
+   * @returns {void}
+   */
+  record(snapshot: InfoSnapshot): void {
+    const { info } = snapshot;
+    const rawErrors = info.values?.total_errors;
+    const errors = rawErrors !== undefined && /^\d+$/.test(rawErrors) ? Number(rawErrors) : undefined;
+    this.reportsErrors = errors !== undefined;
+
+    if (this.previous) {
+      // A shorter uptime means the server restarted, even if counters caught up
+      const restarted = info.uptimeSeconds < this.previous.uptime;
+      if (restarted || info.totalRequests < this.previous.requests) {
+        this.counterResets += 1;
+        this.requestOffset += this.previous.requests;
+      }
+      if (restarted || (errors ?? 0) < this.previous.errors) {
+        this.errorOffset += this.previous.errors;
+      }
+    }
+    this.previous = { uptime: info.uptimeSeconds, requests: info.totalRequests, errors: errors ?? 0 };
+    this.activeConnections = info.activeConnections;
+
+    const sample: MetricsSample = {
+      capturedAt: snapshot.capturedAt,
+      requests: info.totalRequests + this.requestOffset,
+      errors: (errors ?? 0) + this.errorOffset,
+      docCount: info.docCount,
+      indexSizeBytes: info.indexSizeBytes
+    };
+    this.samples.push(sample);
+
+    // Keep one sample at or before the start of the longest window
+    const cutoff = sample.capturedAt - this.maxWindowMs;
+    let drop = 0;
+    while (this.samples.length - drop > 2 && this.samples[drop + 1].capturedAt <= cutoff) {
+      drop += 1;
+    }
+    if (drop > 0) {
+      this.samples.splice(0, drop);
+    }
+  }
+
+  /**
+   * Compute metrics from the retained samples
+   *
+   * @returns {ServerMetrics} Latest metrics
+   */
+  compute(): ServerMetrics {
+    const latest = this.samples.length > 0 ? this.samples[this.samples.length - 1] : undefined;
+    const windows: MetricsWindow[] = [];
+    for (let i = 0; i < this.windows.length; i += 1) {
+      windows.push(latest ? this.computeWindow(this.windows[i], latest) : emptyWindow(this.windows[i]));
+    }
+
+    return {
+      capturedAt: latest?.capturedAt ?? 0,
+      sampleCount: this.samples.length,
+      docCount: latest?.docCount ?? 0,
+      indexSizeBytes: latest?.indexSizeBytes ?? 0,
+      indexBytesPerDoc: latest && latest.docCount > 0 ? latest.indexSizeBytes / latest.docCount : 0,
+      activeConnections: this.activeConnections,
+      reportsErrors: this.reportsErrors,
+      counterResets: this.counterResets,
+      windows
+    };
+  }
+
+  private computeWindow(windowSeconds: number, latest: MetricsSample): MetricsWindow {
+    // Base sample: the newest one at or before the window start (the oldest while warming up)
+    const windowStart = latest.capturedAt - windowSeconds * 1000;
+    let base = this.samples[0];
+    for (let i = 1; i < this.samples.length && this.samples[i].capturedAt <= windowStart; i += 1) {
+      base = this.samples[i];
+    }
+
+    const coveredSeconds = (latest.capturedAt - base.capturedAt) / 1000;
+    const requests = latest.requests - base.requests;
+    const errors = latest.errors - base.errors;
+    const docDelta = latest.docCount - base.docCount;
+    return {
+      windowSeconds,
+      coveredSeconds,
+      requestsPerSecond: coveredSeconds > 0 ? requests / coveredSeconds : 0,
+      errorsPerSecond: coveredSeconds > 0 ? errors / coveredSeconds : 0,
+      errorRatio: requests > 0 ? errors / requests : 0,
+      docsPerSecond: coveredSeconds > 0 ? docDelta / coveredSeconds : 0,
+      docDelta,
+      indexBytesDelta: latest.indexSizeBytes - base.indexSizeBytes
+    };
+  }
+}
+
+/**
+ * Convert native server metrics to ServerMetrics
+ *
+ * @param {NativeServerMetrics} raw - Metrics from the native binding
+ * @returns {ServerMetrics} Server metrics
+ */
+function fromNativeServerMetrics(raw: NativeServerMetrics): ServerMetrics {
+  return {
+    capturedAt: raw.captured_at_ms,
+    sampleCount: raw.sample_count,
+    docCount: raw.doc_count,
+    indexSizeBytes: raw.index_size_bytes,
+    indexBytesPerDoc: raw.index_bytes_per_doc,
+    activeConnections: raw.active_connections,
+    reportsErrors: raw.reports_errors,
+    counterResets: raw.counter_resets,
+    windows: raw.windows.map((window) => ({
+      windowSeconds: window.window_seconds,
+      coveredSeconds: window.covered_seconds,
+      requestsPerSecond: window.requests_per_second,
+      errorsPerSecond: window.errors_per_second,
+      errorRatio: window.error_ratio,
+      docsPerSecond: window.docs_per_second,
+      docDelta: window.doc_delta,
+      indexBytesDelta: window.index_bytes_delta
+    }))
+  };
+}
+
+/**
+ * Metrics collector driven by the event loop
+ *
+ * The collector owns its client through an InfoPoller: it connects on start()
+ * and disconnects on stop(). Collected samples survive stop().
+ */
+export class MetricsCollector {
+  private poller: InfoPoller;
+  private accumulator: MetricsAccumulator;
+
+  /**
+   * Create a new metrics collector
+   *
+   * @param {InfoSource} source - Dedicated client to sample
+   * @param {MetricsCollectorOptions} [options={}] - Sampling interval and windows
+   */
+  constructor(source: InfoSource, options: MetricsCollectorOptions = {}) {
+    this.poller = new InfoPoller(source, options.intervalMs ?? DEFAULT_INTERVAL_MS);
+    this.accumulator = new MetricsAccumulator(options.windows);
+    this.poller.onSnapshot((snapshot) => this.accumulator.record(snapshot));
+  }
+
+  /**
+   * Take the first sample, then keep sampling in the background
+   *
+   * @returns {Promise<void>} Resolves after the first successful sample
+   * @throws {ConnectionError} If the first sample fails
+   */
+  async start(): Promise<void> {
+    await this.poller.start();
+  }
+
+  /**
+   * Stop sampling and close the connection (collected samples are kept)
+   *
+   * @returns {void}
+   */
+  stop(): void {
+    this.poller.stop();
+  }
+
+  /**
+   * Check if sampling is active
+   *
+   * @returns {boolean} True if running
+   */
+  isRunning(): boolean {
+    return this.poller.isRunning();
+  }
+
+  /**
+   * Compute metrics from the retained samples
+   *
+   * @returns {ServerMetrics} Latest metrics
+   */
+  getMetrics(): ServerMetrics {
+    return this.accumulator.compute();
+  }
+
+  /**
+   * Get the error of the most recent sample attempt
+   *
+   * @returns {string} Error message (empty if the last sample succeeded)
+   */
+  getLastError(): string {
+    return this.poller.getLastError();
+  }
+}
+
+/**
+ * Metrics collector sampling on a native background thread
+ *
+ * Sampling does not depend on the event loop, so rates stay accurate while
+ * JavaScript is busy.
+ */
+export class NativeMetricsCollector {
+  private native: NativeMetricsCollectorBinding;
+  private config: ClientConfig;
+  private options: MetricsCollectorOptions;
+  private handle: unknown = null;
+  private finalMetrics: ServerMetrics | undefined;
+  private finalError = '';
+
+  /**
+   * Create a new native metrics collector
+   *
+   * @param {NativeMetricsCollectorBinding} native - Native binding object
+   * @param {ClientConfig} [config={}] - Connection configuration
+   * @param {MetricsCollectorOptions} [options={}] - Sampling interval and windows
+   */
+  constructor(native: NativeMetricsCollectorBinding, config: ClientConfig = {}, options: MetricsCollectorOptions = {}) {
+    this.native = native;
+    this.config = config;
+    this.options = options;
+  }
+
+  /**
+   * Take the first sample, then keep sampling in the background
+   *
+   * @returns {Promise<void>} Resolves after the first successful sample
+   * @throws {ConnectionError} If the first sample fails
+   */
+  async start(): Promise<void> {
+    if (this.handle) {
+      return;
+    }
+
+    const handle = this.native.createMetricsCollector(
+      this.config.host ?? '127.0.0.1',
+      this.config.port ?? 11016,
+      this.config.timeout ?? 5000,
+      this.options.intervalMs ?? DEFAULT_INTERVAL_MS,
+      this.options.windows ?? []
+    );
+    if (!this.native.startMetricsCollector(handle)) {
+      const error = this.native.getMetricsCollectorError(handle);
+      this.native.destroyMetricsCollector(handle);
+      this.finalError = error || 'Failed to sample INFO';
+      throw new ConnectionError(this.finalError);
+    }
+    this.handle = handle;
+  }
+
+  /**
+   * Stop sampling and close the connection (the last metrics stay available)
+   *
+   * @returns {void}
+   */
+  stop(): void {
+    if (!this.handle) {
+      return;
+    }
+    this.finalMetrics = this.getMetrics();
+    this.finalError = this.getLastError();
+    this.native.destroyMetricsCollector(this.handle);
+    this.handle = null;
+  }
+
+  /**
+   * Check if sampling is active
+   *
+   * @returns {boolean} True if running
+   */
+  isRunning(): boolean {
+    return this.handle !== null;
+  }
+
+  /**
+   * Compute metrics from the retained samples
+   *
+   * @returns {ServerMetrics} Latest metrics
+   */
+  getMetrics(): ServerMetrics {
+    if (!this.handle) {
+      return this.finalMetrics ?? new MetricsAccumulator(this.options.windows).compute();
+    }
+    return fromNativeServerMetrics(this.native.getServerMetrics(this.handle));
+  }
+
+  /**
+   * Get the error of the most recent sample attempt
+   *
+   * @returns {string} Error message (empty if the last sample succeeded)
+   */
+  getLastError(): string {
+    return this.handle ? this.native.getMetricsCollectorError(this.handle) : this.finalError;
+  }
+}
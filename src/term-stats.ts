@@ -0,0 +1,241 @@
+/**
+ * Per-table term frequency cache for selectivity-driven term ordering
+ *
+ * The server starts an AND query from the main term's posting list, so a
+ * common main term inflates `candidates` even when another term would have
+ * narrowed the set immediately. TermStatsCache remembers how many documents
+ * each term matched (from COUNT results and DEBUG candidate counts) and puts
+ * the rarest known term first.
+ */
+
+import { DebugInfo } from './types';
+import { simplifySearchExpression } from './search-expression';
+
+const DEFAULT_MAX_TERMS_PER_TABLE = 4096;
+const DEFAULT_MAX_AGE_MS = 300000;
+
+/**
+ * Term statistics cache options
+ */
+export interface TermStatsOptions {
+  /** Oldest entries are dropped beyond this (default: 4096) */
+  maxTermsPerTable?: number;
+  /** Statistics older than this are ignored, 0 = never expire (default: 300000) */
+  maxAgeMs?: number;
+}
+
+/**
+ * Term statistics cache counters
+ */
+export interface TermStatsCacheStats {
+  /** Terms with statistics (all tables) */
+  entries: number;
+  /** Lookups that found fresh statistics */
+  hits: number;
+  /** Lookups without (fresh) statistics */
+  misses: number;
+  /** reorder() calls that changed the main term */
+  reorders: number;
+}
+
+/**
+ * Positive terms in execution order
+ */
+export interface OrderedTerms {
+  /** Most selective known term */
+  mainTerm: string;
+  /** Remaining required terms */
+  andTerms: string[];
+}
+
+// Statistics of one term
+interface TermEntry {
+  documents: number;
+  exact: boolean;
+  takenAt: number;
+}
+
+/**
+ * Per-table term → document frequency cache
+ *
+ * Exact counts (single-term COUNT without filters) take precedence over
+ * candidate estimates from DEBUG output until they expire.
+ */
+export class TermStatsCache {
+  private tables = new Map<string, Map<string, TermEntry>>();
+  private maxTermsPerTable: number;
+  private maxAgeMs: number;
+  private hits = 0;
+  private misses = 0;
+  private reorders = 0;
+
+  /**
+   * Create a new term statistics cache
+   *
+   * @param {TermStatsOptions} [options={}] - Cache options
+   */
+  constructor(options: TermStatsOptions = {}) {
+    this.maxTermsPerTable = options.maxTermsPerTable ?? DEFAULT_MAX_TERMS_PER_TABLE;
+    this.maxAgeMs = options.maxAgeMs ?? DEFAULT_MAX_AGE_MS;
+  }
+
+  /**
+   * Record the exact number of documents matching a term
+   *
+   * @param {string} table - Table name
+   * @param {string} term - Search term
+   * @param {number} count - Matching documents
+   * @returns {void}
+   */
+  recordCount(table: string, term: string, count: number): void {
+    this.record(table, term, count, true);
+  }
+
+  /**
+   * Record a candidate estimate for a query's main term (DEBUG candidates)
+   *
+   * Ignored while a fresh exact count exists for the term.
+   *
+   * @param {string} table - Table name
+   * @param {string} term - Main search term
+   * @param {number} candidates - Initial candidate count reported by the server
+   * @returns {void}
+   */
+  recordCandidates(table: string, term: string, candidates: number): void {
+    this.record(table, term, candidates, false);
+  }
+
+  /**
+   * Feed statistics from a SEARCH/COUNT response
+   *
+   * A lone term without NOT or FILTER clauses yields its exact document count;
+   * DEBUG candidates estimate the main term's frequency in any query.
+   *
+   * @param {string} table - Table name
+   * @param {string} mainTerm - Main term that was sent
+   * @param {boolean} lone - True if the query had no other terms or filters
+   * @param {number} total - Total matching documents
+   * @param {DebugInfo} [debug] - Debug info from the response
+   * @returns {void}
+   */
+  recordResponse(table: string, mainTerm: string, lone: boolean, total: number, debug?: DebugInfo): void {
+    if (lone) {
+      this.recordCount(table, mainTerm, total);
+    } else if (debug) {
+      this.recordCandidates(table, mainTerm, debug.candidates);
+    }
+  }
+
+  /**
+   * Get the known document frequency of a term
+   *
+   * @param {string} table - Table name
+   * @param {string} term - Search term
+   * @returns {number | undefined} Document frequency, or undefined if unknown or expired
+   */
+  lookup(table: string, term: string): number | undefined {
+    const entry = this.tables.get(table)?.get(term);
+    if (entry && this.isFresh(entry, Date.now())) {
+      this.hits += 1;
+      return entry.documents;
+    }
+    this.misses += 1;
+    return undefined;
+  }
+
+  /**
+   * Put the most selective known term first
+   *
+   * Terms are stably ordered by known frequency; terms without statistics are
+   * assumed common and keep their relative order after the known ones.
+   *
+   * @param {string} table - Table name
+   * @param {string} mainTerm - Main term
+   * @param {string[]} andTerms - Additional required terms
+   * @returns {OrderedTerms} Terms in execution order
+   */
+  reorder(table: string, mainTerm: string, andTerms: string[]): OrderedTerms {
+    if (andTerms.length === 0) {
+      return { mainTerm, andTerms };
+    }
+
+    const terms = [mainTerm, ...andTerms];
+    const ranks = terms.map((term) => this.lookup(table, term) ?? Number.POSITIVE_INFINITY);
+    const order = terms.map((_, index) => index).sort((a, b) => ranks[a] - ranks[b] || a - b);
+    if (order[0] === 0) {
+      return { mainTerm, andTerms };
+    }
+
+    this.reorders += 1;
+    const ordered = order.map((index) => terms[index]);
+    return { mainTerm: ordered[0], andTerms: ordered.slice(1) };
+  }
+
+  /**
+   * Get cache counters
+   *
+   * @returns {TermStatsCacheStats} Counters
+   */
+  getStats(): TermStatsCacheStats {
+    let entries = 0;
+    this.tables.forEach((terms) => {
+      entries += terms.size;
+    });
+    return { entries, hits: this.hits, misses: this.misses, reorders: this.reorders };
+  }
+
+  /**
+   * Drop all statistics (counters are kept)
+   *
+   * @returns {void}
+   */
+  clear(): void {
+    this.tables.clear();
+  }
+
+  private record(table: string, term: string, documents: number, exact: boolean): void {
+    const now = Date.now();
+    let terms = this.tables.get(table);
+    if (!terms) {
+      terms = new Map();
+      this.tables.set(table, terms);
+    }
+
+    const existing = terms.get(term);
+    if (existing) {
+      // Estimates never override a fresh exact count
+      if (!exact && existing.exact && this.isFresh(existing, now)) {
+        return;
+      }
+      terms.delete(term);
+    } else if (this.maxTermsPerTable === 0) {
+      return;
+    } else if (terms.size >= this.maxTermsPerTable) {
+      // Entries stay in recording order, so the first one is the oldest
+      terms.delete(terms.keys().next().value as string);
+    }
+    terms.set(term, { documents, exact, takenAt: now });
+  }
+
+  private isFresh(entry: TermEntry, now: number): boolean {
+    return this.maxAgeMs === 0 || now - entry.takenAt <= this.maxAgeMs;
+  }
+}
+
+/**
+ * Simplify a search expression, choosing the most selective main term
+ *
+ * @param {string} expression - Web-style search expression
+ * @param {string} table - Table the query will run against
+ * @param {TermStatsCache} stats - Term statistics
+ * @returns {{ mainTerm: string, andTerms: string[], notTerms: string[] }} Simplified terms object
+ * @throws {Error} If expression is invalid or has no positive terms
+ */
+export function simplifySearchExpressionBySelectivity(
+  expression: string,
+  table: string,
+  stats: TermStatsCache
+): { mainTerm: string; andTerms: string[]; notTerms: string[] } {
+  const { mainTerm, andTerms, notTerms } = simplifySearchExpression(expression);
+  return { ...stats.reorder(table, mainTerm, andTerms), notTerms };
+}
@@ -16,6 +16,34 @@ export interface ClientConfig {
   recvBufferSize?: number;
   /** Maximum allowed query expression length (characters) */
   maxQueryLength?: number;
+  /** Infer field types of tables without a declared field schema */
+  learnFieldSchemas?: boolean;
+  /** Put the rarest known term first in SEARCH/COUNT (see TermStatsCache) */
+  reorderTerms?: boolean;
+  /** Answer contradictory or invalid search/count calls locally (see getSavedRoundTrips) */
+  analyzeQueries?: boolean;
+  /**
+   * Share one server round trip between concurrent equivalent SEARCH/COUNT
+   * calls (JavaScript client only; native calls block and never overlap)
+   */
+  singleFlight?: boolean;
+  /** Term normalization applied when deriving canonical query keys */
+  queryNormalization?: QueryNormalization;
+}
+
+/**
+ * Client-side term normalization for canonical query keys
+ *
+ * Only enable what the server's own text normalization does; otherwise one
+ * key could merge queries the server treats differently.
+ */
+export interface QueryNormalization {
+  /** Apply NFKC normalization (default: false) */
+  nfkc?: boolean;
+  /** Width conversion, as ICU's Fullwidth-Halfwidth / Halfwidth-Fullwidth (default: 'keep') */
+  width?: 'keep' | 'narrow' | 'wide';
+  /** Convert to lowercase (default: false) */
+  lower?: boolean;
 }
 
 /**
@@ -36,6 +64,78 @@ export interface Document {
   fields: Record<string, string>;
 }
 
+/**
+ * Declared type of a filter field
+ *
+ * Timestamps decode to Date (integer epoch seconds or ISO-8601, UTC when no zone is given).
+ */
+export type FieldType = 'string' | 'integer' | 'float' | 'timestamp';
+
+/**
+ * Field name → declared type for one table
+ */
+export type FieldSchema = Record<string, FieldType>;
+
+/**
+ * Decoded filter field value
+ */
+export type TypedFieldValue = string | number | Date;
+
+/**
+ * Document with filter fields decoded by the table's field schema
+ */
+export interface TypedDocument {
+  /** Document primary key */
+  primaryKey: string;
+  /** Filter fields; undeclared fields and values that do not match their type stay strings */
+  fields: Record<string, TypedFieldValue>;
+}
+
+/**
+ * Numeric field column (every present value parsed as a decimal number)
+ */
+export interface NumericColumn {
+  kind: 'number';
+  /** Declared type from the table's field schema (timestamps are epoch milliseconds) */
+  type?: FieldType;
+  /** One value per row (NaN where the field is absent) */
+  values: Float64Array;
+  /** 1 if the row's document has this field */
+  present: Uint8Array;
+}
+
+/**
+ * String field column packed into a single UTF-8 buffer
+ */
+export interface StringColumn {
+  kind: 'string';
+  /** Declared type from the table's field schema */
+  type?: FieldType;
+  /** Packed UTF-8 bytes of all values */
+  data: Uint8Array;
+  /** Row offsets into data (rows + 1 entries); row i spans offsets[i]..offsets[i + 1] */
+  offsets: Uint32Array;
+  /** 1 if the row's document has this field */
+  present: Uint8Array;
+}
+
+/**
+ * Field column of a columnar multi-document result
+ */
+export type FieldColumn = NumericColumn | StringColumn;
+
+/**
+ * Multi-document GET result in columnar (struct-of-arrays) form
+ */
+export interface ColumnarDocuments {
+  /** Requested primary keys (row order) */
+  primaryKeys: string[];
+  /** 1 if the row's document exists */
+  found: Uint8Array;
+  /** Columns keyed by field name */
+  columns: Record<string, FieldColumn>;
+}
+
 /**
  * Query debug information (when debug mode is enabled)
  */
@@ -110,6 +210,66 @@ export interface ServerInfo {
   docCount: number;
   /** List of table names */
   tables: string[];
+  /** Every key of the INFO body (section headers skipped) */
+  values: Record<string, string>;
+}
+
+/**
+ * Cached INFO poll result
+ */
+export interface InfoSnapshot {
+  /** Parsed INFO response */
+  info: ServerInfo;
+  /** Capture time in milliseconds since the Unix epoch */
+  capturedAt: number;
+  /** 1 for the first successful poll, +1 per poll */
+  sequence: number;
+}
+
+/**
+ * Rates over one rolling window
+ */
+export interface MetricsWindow {
+  /** Requested window length in seconds */
+  windowSeconds: number;
+  /** Time covered by samples (shorter while warming up) */
+  coveredSeconds: number;
+  /** total_requests growth rate */
+  requestsPerSecond: number;
+  /** total_errors growth rate (0 if not reported) */
+  errorsPerSecond: number;
+  /** Errors per request over the window */
+  errorRatio: number;
+  /** doc_count change rate (negative when documents are removed) */
+  docsPerSecond: number;
+  /** doc_count change over the window */
+  docDelta: number;
+  /** index_size_bytes change over the window */
+  indexBytesDelta: number;
+}
+
+/**
+ * Server metrics derived from INFO deltas
+ */
+export interface ServerMetrics {
+  /** Time of the newest sample (0 before the first sample) */
+  capturedAt: number;
+  /** Samples currently retained */
+  sampleCount: number;
+  /** Latest doc_count */
+  docCount: number;
+  /** Latest index_size_bytes */
+  indexSizeBytes: number;
+  /** indexSizeBytes / docCount (0 when empty) */
+  indexBytesPerDoc: number;
+  /** Latest active_connections */
+  activeConnections: number;
+  /** INFO includes total_errors */
+  reportsErrors: boolean;
+  /** Times the server counters restarted (e.g. server restart) */
+  counterResets: number;
+  /** One entry per configured window */
+  windows: MetricsWindow[];
 }
 
 /**
@@ -0,0 +1,61 @@
+import { describe, it, expect } from 'vitest';
+import { buildColumnarDocuments, getColumnValue, isDecimalNumber } from '../src/columnar';
+
+describe('isDecimalNumber', () => {
+  it('should accept plain decimal numbers', () => {
+    expect(isDecimalNumber('42')).toBe(true);
+    expect(isDecimalNumber('-1.5')).toBe(true);
+    expect(isDecimalNumber('.5')).toBe(true);
+    expect(isDecimalNumber('2e10')).toBe(true);
+  });
+
+  it('should reject non-decimal spellings', () => {
+    expect(isDecimalNumber('')).toBe(false);
+    expect(isDecimalNumber('0x1A')).toBe(false);
+    expect(isDecimalNumber('Infinity')).toBe(false);
+    expect(isDecimalNumber('12abc')).toBe(false);
+  });
+});
+
+describe('buildColumnarDocuments', () => {
+  const documents = [
+    { primaryKey: '1', fields: { price: '10', name: 'apple' } },
+    null,
+    { primaryKey: '3', fields: { price: '2.5', name: 'りんご' } }
+  ];
+
+  it('should mark found rows', () => {
+    const result = buildColumnarDocuments(['1', '2', '3'], ['price'], documents);
+    expect(Array.from(result.found)).toEqual([1, 0, 1]);
+    expect(result.primaryKeys).toEqual(['1', '2', '3']);
+  });
+
+  it('should build numeric columns when every value is a number', () => {
+    const result = buildColumnarDocuments(['1', '2', '3'], ['price'], documents);
+    const column = result.columns.price;
+    expect(column.kind).toBe('number');
+    expect(Array.from(column.present)).toEqual([1, 0, 1]);
+    expect(getColumnValue(column, 0)).toBe(10);
+    expect(getColumnValue(column, 1)).toBeUndefined();
+    expect(getColumnValue(column, 2)).toBe(2.5);
+  });
+
+  it('should pack string columns into a single buffer', () => {
+    const result = buildColumnarDocuments(['1', '2', '3'], ['name'], documents);
+    const column = result.columns.name;
+    expect(column.kind).toBe('string');
+    if (column.kind === 'string') {
+      expect(column.offsets.length).toBe(4);
+      expect(column.data.length).toBe(column.offsets[3]);
+    }
+    expect(getColumnValue(column, 0)).toBe('apple');
+    expect(getColumnValue(column, 1)).toBeUndefined();
+    expect(getColumnValue(column, 2)).toBe('りんご');
+  });
+
+  it('should treat missing fields as absent numeric columns', () => {
+    const result = buildColumnarDocuments(['1', '2', '3'], ['missing'], documents);
+    expect(result.columns.missing.kind).toBe('number');
+    expect(Array.from(result.columns.missing.present)).toEqual([0, 0, 0]);
+  });
+});
@@ -0,0 +1,99 @@
+import { describe, it, expect } from 'vitest';
+import { ExpressionCache, parseExpression } from '../src/expression-cache';
+
+describe('parseExpression', () => {
+  it('should return the query and simplified terms', () => {
+    expect(parseExpression('+golang +tutorial -old')).toEqual({
+      query: 'golang AND tutorial AND NOT old',
+      mainTerm: 'golang',
+      andTerms: ['tutorial'],
+      notTerms: ['old']
+    });
+  });
+
+  it('should leave mainTerm undefined without a positive term', () => {
+    const parsed = parseExpression('-old');
+    expect(parsed.query).toBe('NOT old');
+    expect(parsed.mainTerm).toBeUndefined();
+  });
+
+  it('should parse like the native cache', () => {
+    expect(parseExpression('golang tutorial')).toEqual({
+      query: 'golang AND tutorial',
+      mainTerm: 'golang',
+      andTerms: ['tutorial'],
+      notTerms: []
+    });
+    expect(parseExpression('+golang +(tutorial OR guide)')).toEqual({
+      query: 'golang AND (tutorial OR guide)',
+      andTerms: [],
+      notTerms: []
+    });
+    expect(() => parseExpression('   ')).toThrow('Empty search expression');
+  });
+});
+
+describe('ExpressionCache', () => {
+  it('should count hits and misses', () => {
+    const cache = new ExpressionCache(10);
+    cache.get('golang tutorial');
+    cache.get('golang tutorial');
+    cache.get('python OR ruby');
+
+    expect(cache.getStats()).toEqual({
+      hits: 1,
+      misses: 2,
+      evictions: 0,
+      size: 2,
+      capacity: 10,
+      hitRate: 1 / 3
+    });
+  });
+
+  it('should return the same result for a cached expression', () => {
+    const cache = new ExpressionCache(10);
+    expect(cache.get('+golang -old')).toBe(cache.get('+golang -old'));
+  });
+
+  it('should evict the least recently used entry', () => {
+    const cache = new ExpressionCache(2);
+    cache.get('a');
+    cache.get('b');
+    cache.get('a');
+    cache.get('c');
+
+    cache.get('a');
+    cache.get('b');
+    const stats = cache.getStats();
+    expect(stats.evictions).toBe(2);
+    expect(stats.hits).toBe(2);
+    expect(stats.size).toBe(2);
+  });
+
+  it('should cache parse errors', () => {
+    const cache = new ExpressionCache(10);
+    expect(() => cache.get('+')).toThrow('Expected term after');
+    expect(() => cache.get('+')).toThrow('Expected term after');
+    expect(cache.getStats().hits).toBe(1);
+  });
+
+  it('should shrink on resize and keep counters on clear', () => {
+    const cache = new ExpressionCache(10);
+    cache.get('a');
+    cache.get('b');
+    cache.get('c');
+
+    cache.resize(1);
+    expect(cache.getStats()).toMatchObject({ size: 1, capacity: 1, evictions: 2 });
+
+    cache.clear();
+    expect(cache.getStats()).toMatchObject({ size: 0, misses: 3 });
+  });
+
+  it('should not store entries when capacity is 0', () => {
+    const cache = new ExpressionCache(0);
+    cache.get('a');
+    cache.get('a');
+    expect(cache.getStats()).toMatchObject({ hits: 0, misses: 2, size: 0 });
+  });
+});
@@ -0,0 +1,124 @@
+import { describe, it, expect } from 'vitest';
+import {
+  FieldSchemaCache,
+  decodeFieldValue,
+  inferFieldType,
+  mergeFieldTypes,
+  parseTimestampMillis
+} from '../src/field-schema';
+import { buildColumnarDocuments } from '../src/columnar';
+
+describe('parseTimestampMillis', () => {
+  it('should parse epoch seconds', () => {
+    expect(parseTimestampMillis('1700000000')).toBe(1700000000000);
+  });
+
+  it('should parse ISO-8601 dates as UTC', () => {
+    expect(parseTimestampMillis('2024-01-31')).toBe(Date.UTC(2024, 0, 31));
+    expect(parseTimestampMillis('2024-01-31T12:34:56')).toBe(Date.UTC(2024, 0, 31, 12, 34, 56));
+  });
+
+  it('should apply fraction and zone offsets', () => {
+    expect(parseTimestampMillis('2024-01-31T12:00:00.25+09:00')).toBe(Date.UTC(2024, 0, 31, 3, 0, 0, 250));
+    expect(parseTimestampMillis('2024-01-31T12:00:00Z')).toBe(Date.UTC(2024, 0, 31, 12));
+    expect(parseTimestampMillis('2024-01-31T12:00-0500')).toBe(Date.UTC(2024, 0, 31, 17));
+  });
+
+  it('should reject invalid dates', () => {
+    expect(parseTimestampMillis('2023-02-29')).toBeNull();
+    expect(parseTimestampMillis('2024-13-01')).toBeNull();
+    expect(parseTimestampMillis('yesterday')).toBeNull();
+  });
+
+  it('should reject zone offsets with missing minutes after the colon', () => {
+    expect(parseTimestampMillis('2024-01-31T12:00:00+09')).toBe(Date.UTC(2024, 0, 31, 3));
+    expect(parseTimestampMillis('2024-01-31T12:00:00+09:')).toBeNull();
+    expect(parseTimestampMillis('2024-01-31T12:00:00+09:0')).toBeNull();
+  });
+});
+
+describe('decodeFieldValue', () => {
+  it('should decode declared types', () => {
+    expect(decodeFieldValue('42', 'integer')).toBe(42);
+    expect(decodeFieldValue('1.5', 'float')).toBe(1.5);
+    expect(decodeFieldValue('2024-01-31', 'timestamp')).toEqual(new Date(Date.UTC(2024, 0, 31)));
+    expect(decodeFieldValue('42', 'string')).toBe('42');
+  });
+
+  it('should keep values that do not match their type as strings', () => {
+    expect(decodeFieldValue('1.5', 'integer')).toBe('1.5');
+    expect(decodeFieldValue('abc', 'timestamp')).toBe('abc');
+  });
+});
+
+describe('inferFieldType / mergeFieldTypes', () => {
+  it('should infer the narrowest type', () => {
+    expect(inferFieldType('42')).toBe('integer');
+    expect(inferFieldType('-1.5')).toBe('float');
+    expect(inferFieldType('2024-01-31')).toBe('timestamp');
+    expect(inferFieldType('apple')).toBe('string');
+  });
+
+  it('should keep zero-padded numbers as strings', () => {
+    expect(inferFieldType('01234')).toBe('string');
+    expect(inferFieldType('0')).toBe('integer');
+  });
+
+  it('should widen mismatched types', () => {
+    expect(mergeFieldTypes('integer', 'float')).toBe('float');
+    expect(mergeFieldTypes('integer', 'timestamp')).toBe('string');
+    expect(mergeFieldTypes('float', 'float')).toBe('float');
+  });
+});
+
+describe('FieldSchemaCache', () => {
+  it('should decode only declared fields', () => {
+    const cache = new FieldSchemaCache();
+    cache.set('articles', { views: 'integer' });
+    const doc = cache.decode('articles', { primaryKey: '1', fields: { views: '10', rank: '3' } });
+    expect(doc.fields).toEqual({ views: 10, rank: '3' });
+  });
+
+  it('should leave documents untyped without a schema', () => {
+    const cache = new FieldSchemaCache();
+    const doc = cache.decode('articles', { primaryKey: '1', fields: { views: '10' } });
+    expect(doc.fields).toEqual({ views: '10' });
+    expect(cache.get('articles')).toBeUndefined();
+  });
+
+  it('should learn and widen types when enabled', () => {
+    const cache = new FieldSchemaCache(true);
+    cache.decode('articles', { primaryKey: '1', fields: { score: '3', tag: 'a' } });
+    expect(cache.get('articles')).toEqual({ score: 'integer', tag: 'string' });
+    const doc = cache.decode('articles', { primaryKey: '2', fields: { score: '2.5' } });
+    expect(cache.get('articles')).toEqual({ score: 'float', tag: 'string' });
+    expect(doc.fields.score).toBe(2.5);
+  });
+
+  it('should reject unknown type names', () => {
+    const cache = new FieldSchemaCache();
+    expect(() => cache.set('articles', { views: 'bigint' as never })).toThrow(TypeError);
+  });
+});
+
+describe('buildColumnarDocuments with a schema', () => {
+  const documents = [
+    { primaryKey: '1', fields: { zip: '100', created: '2024-01-31' } },
+    { primaryKey: '2', fields: { zip: '200', created: '1700000000' } }
+  ];
+
+  it('should keep declared string fields as strings', () => {
+    const result = buildColumnarDocuments(['1', '2'], ['zip'], documents, { zip: 'string' });
+    expect(result.columns.zip.kind).toBe('string');
+    expect(result.columns.zip.type).toBe('string');
+  });
+
+  it('should store timestamps as epoch milliseconds', () => {
+    const result = buildColumnarDocuments(['1', '2'], ['created'], documents, { created: 'timestamp' });
+    const column = result.columns.created;
+    expect(column.kind).toBe('number');
+    if (column.kind === 'number') {
+      expect(Array.from(column.values)).toEqual([Date.UTC(2024, 0, 31), 1700000000000]);
+    }
+  });
+});
@@ -0,0 +1,92 @@
+import { describe, it, expect, vi, afterEach } from 'vitest';
+import { InfoPoller, InfoSource } from '../src/info-poller';
+import { ConnectionError } from '../src/errors';
+import { ServerInfo } from '../src/types';
+
+function makeInfo(totalRequests: number): ServerInfo {
+  return {
+    version: '1.0.0',
+    uptimeSeconds: 10,
+    totalRequests,
+    activeConnections: 1,
+    indexSizeBytes: 1024,
+    docCount: 5,
+    tables: ['articles'],
+    values: { total_requests: String(totalRequests) }
+  };
+}
+
+function makeSource(): InfoSource & { requests: number; fail: boolean } {
+  let connected = false;
+  return {
+    requests: 0,
+    fail: false,
+    async connect() {
+      connected = true;
+    },
+    disconnect() {
+      connected = false;
+    },
+    isConnected() {
+      return connected;
+    },
+    async info() {
+      if (this.fail) throw new Error('boom');
+      this.requests += 100;
+      return makeInfo(this.requests);
+    }
+  };
+}
+
+describe('InfoPoller', () => {
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('should poll once on start and cache the snapshot', async () => {
+    const source = makeSource();
+    const poller = new InfoPoller(source, 1000);
+    expect(poller.latest()).toBeUndefined();
+
+    await poller.start();
+    expect(poller.isRunning()).toBe(true);
+    expect(poller.latest()?.sequence).toBe(1);
+    expect(poller.latest()?.info.totalRequests).toBe(100);
+
+    poller.stop();
+    expect(poller.isRunning()).toBe(false);
+    expect(source.isConnected()).toBe(false);
+    expect(poller.latest()?.sequence).toBe(1);
+  });
+
+  it('should refresh on the interval', async () => {
+    vi.useFakeTimers();
+    const source = makeSource();
+    const poller = new InfoPoller(source, 1000);
+    await poller.start();
+
+    await vi.advanceTimersByTimeAsync(2000);
+    expect(poller.latest()?.sequence).toBe(3);
+    poller.stop();
+  });
+
+  it('should keep the previous snapshot when a poll fails', async () => {
+    const source = makeSource();
+    const poller = new InfoPoller(source, 1000);
+    await poller.pollNow();
+
+    source.fail = true;
+    await expect(poller.pollNow()).rejects.toThrow(ConnectionError);
+    expect(poller.getLastError()).toBe('boom');
+    expect(poller.latest()?.sequence).toBe(1);
+    expect(source.isConnected()).toBe(false);
+  });
+
+  it('should fail to start when the first poll fails', async () => {
+    const source = makeSource();
+    source.fail = true;
+    const poller = new InfoPoller(source, 1000);
+    await expect(poller.start()).rejects.toThrow('boom');
+    expect(poller.isRunning()).toBe(false);
+  });
+});
@@ -0,0 +1,106 @@
+import { describe, it, expect } from 'vitest';
+import { LocalIndex, compareSortKeys } from '../src/local-index';
+import { SearchOptions } from '../src/types';
+
+function keys(index: LocalIndex, query: string, options: SearchOptions = {}): string[] {
+  return index.search(query, options).results.map((result) => result.primaryKey);
+}
+
+describe('compareSortKeys', () => {
+  it('should compare digit-only keys as numbers', () => {
+    expect(compareSortKeys('9', '10')).toBeLessThan(0);
+    expect(compareSortKeys('010', '9')).toBeGreaterThan(0);
+    expect(compareSortKeys('abc', 'abd')).toBeLessThan(0);
+    expect(compareSortKeys('7', '7')).toBe(0);
+  });
+
+  it('should sort mixed keys the same way in both directions', () => {
+    const values = ['10', '9', '1a', '2', '100', 'abc', '09', 'b7'];
+    const ascending = [...values].sort(compareSortKeys);
+    expect(ascending).toEqual(['2', '09', '9', '10', '100', '1a', 'abc', 'b7']);
+    expect([...values].sort((a, b) => compareSortKeys(b, a))).toEqual([...ascending].reverse());
+  });
+});
+
+describe('LocalIndex', () => {
+  function sampleIndex(): LocalIndex {
+    const index = new LocalIndex();
+    index.add('1', 'golang tutorial', { status: '1' });
+    index.add('2', 'python tutorial', { status: '0' });
+    index.add('10', 'golang guide 東京', { status: '1' });
+    index.add('3', '東京都の天気', { status: '1' });
+    return index;
+  }
+
+  it('should match documents containing every n-gram of the query', () => {
+    const index = sampleIndex();
+    expect(keys(index, 'golang')).toEqual(['10', '1']);
+    expect(keys(index, '東京')).toEqual(['10', '3']);
+    expect(index.search('tutorial').totalCount).toBe(2);
+  });
+
+  it('should apply AND and NOT terms', () => {
+    const index = sampleIndex();
+    expect(keys(index, 'tutorial', { andTerms: ['golang'] })).toEqual(['1']);
+    expect(keys(index, 'tutorial', { notTerms: ['golang'] })).toEqual(['2']);
+    expect(keys(index, '東京', { notTerms: ['天気'] })).toEqual(['10']);
+  });
+
+  it('should filter, sort and page', () => {
+    const index = sampleIndex();
+    expect(keys(index, 'golang', { filters: { status: '0' } })).toEqual([]);
+    expect(keys(index, 'o', { sortDesc: false })).toEqual([]);
+    expect(keys(index, 'on', { sortDesc: false })).toEqual(['2']);
+    expect(keys(index, 'golang', { sortDesc: false })).toEqual(['1', '10']);
+    expect(keys(index, 'golang', { limit: 1, offset: 1 })).toEqual(['1']);
+    expect(keys(index, 'golang', { sortColumn: 'status', sortDesc: false })).toEqual(['1', '10']);
+  });
+
+  it('should normalize documents and terms like the server', () => {
+    const index = new LocalIndex();
+    index.add('1', 'ｇｏｌａｎｇ');
+    expect(index.count('golang').count).toBe(1);
+
+    const raw = new LocalIndex({ width: 'keep', nfkc: false });
+    raw.add('1', 'ｇｏｌａｎｇ');
+    expect(raw.count('golang').count).toBe(0);
+  });
+
+  it('should reject a query without a positive term', () => {
+    const index = sampleIndex();
+    expect(() => index.search('')).toThrow();
+    expect(index.count('golang', { andTerms: ['x'], notTerms: ['x'] }).count).toBe(0);
+  });
+
+  it('should replace and remove documents', () => {
+    const index = sampleIndex();
+    index.add('1', 'rust tutorial', { status: '1' });
+    expect(keys(index, 'golang')).toEqual(['10']);
+    expect(index.remove('10')).toBe(true);
+    expect(index.remove('10')).toBe(false);
+    expect(keys(index, 'golang')).toEqual([]);
+    expect(index.getStats()).toMatchObject({ documents: 3, removed: 2 });
+
+    index.compact();
+    expect(index.getStats()).toMatchObject({ documents: 3, removed: 0 });
+    expect(keys(index, 'tutorial', { sortDesc: false })).toEqual(['1', '2']);
+  });
+
+  it('should compact automatically once removed documents dominate', () => {
+    const index = new LocalIndex();
+    for (let i = 0; i < 2048; i += 1) {
+      index.add(String(i), `doc ${i}`);
+    }
+    for (let i = 0; i < 1024; i += 1) {
+      index.remove(String(i));
+    }
+    expect(index.getStats()).toMatchObject({ documents: 1024, removed: 0 });
+    expect(index.count('doc').count).toBe(1024);
+  });
+
+  it('should remove all documents on clear', () => {
+    const index = sampleIndex();
+    index.clear();
+    expect(index.getStats()).toEqual({ documents: 0, removed: 0, ngrams: 0, postings: 0, postingBytes: 0 });
+  });
+});
@@ -0,0 +1,116 @@
+import { describe, it, expect } from 'vitest';
+import { ExpressionCache } from '../src/expression-cache';
+import {
+  MemoryHealth,
+  MemoryHealthStatus,
+  MemoryPressureMonitor,
+  classifyMemoryHealth,
+  readMemoryHealthJs
+} from '../src/memory-pressure';
+
+function reading(status: MemoryHealthStatus): MemoryHealth {
+  return { status, totalBytes: 1000, availableBytes: 500, cgroupLimited: false };
+}
+
+describe('classifyMemoryHealth', () => {
+  it('should classify the available memory ratio', () => {
+    expect(classifyMemoryHealth(1000, 500)).toBe('HEALTHY');
+    expect(classifyMemoryHealth(1000, 200)).toBe('HEALTHY');
+    expect(classifyMemoryHealth(1000, 150)).toBe('WARNING');
+    expect(classifyMemoryHealth(1000, 50)).toBe('CRITICAL');
+    expect(classifyMemoryHealth(0, 0)).toBe('UNKNOWN');
+  });
+});
+
+describe('readMemoryHealthJs', () => {
+  it('should report a consistent reading', () => {
+    const health = readMemoryHealthJs();
+    expect(health.totalBytes).toBeGreaterThan(0);
+    expect(health.availableBytes).toBeLessThanOrEqual(health.totalBytes);
+    expect(health.status).toBe(classifyMemoryHealth(health.totalBytes, health.availableBytes));
+  });
+});
+
+describe('MemoryPressureMonitor', () => {
+  it('should notify listeners only when the status changes', () => {
+    let status: MemoryHealthStatus = 'HEALTHY';
+    const monitor = new MemoryPressureMonitor({ source: () => reading(status) });
+    const seen: MemoryHealthStatus[] = [];
+    monitor.subscribe((next) => seen.push(next));
+
+    monitor.checkNow();
+    monitor.checkNow();
+    status = 'WARNING';
+    monitor.checkNow();
+    status = 'UNKNOWN';
+    monitor.checkNow();
+    expect(seen).toEqual(['HEALTHY', 'WARNING']);
+    expect(monitor.getStatus()).toBe('WARNING');
+  });
+
+  it('should call new listeners with the known status', () => {
+    const monitor = new MemoryPressureMonitor({ source: () => reading('CRITICAL') });
+    monitor.checkNow();
+    const seen: MemoryHealthStatus[] = [];
+    const subscription = monitor.subscribe((next) => seen.push(next));
+    expect(seen).toEqual(['CRITICAL']);
+
+    monitor.unsubscribe(subscription);
+    expect(monitor.getStatus()).toBe('CRITICAL');
+  });
+
+  it('should shrink subscribed caches under pressure and regrow them when healthy', () => {
+    let status: MemoryHealthStatus = 'HEALTHY';
+    const monitor = new MemoryPressureMonitor({ source: () => reading(status) });
+    const cache = new ExpressionCache(100);
+    for (let i = 0; i < 100; i += 1) {
+      cache.get(`term${i}`);
+    }
+    monitor.subscribeCache(cache);
+
+    status = 'WARNING';
+    monitor.checkNow();
+    expect(cache.getStats()).toMatchObject({ capacity: 50, size: 50 });
+
+    status = 'CRITICAL';
+    monitor.checkNow();
+    expect(cache.getStats()).toMatchObject({ capacity: 10, size: 10 });
+
+    status = 'HEALTHY';
+    monitor.checkNow();
+    expect(cache.getStats()).toMatchObject({ capacity: 100, size: 10 });
+  });
+
+  it('should keep caches as they are when a reading fails', () => {
+    let fail = false;
+    const monitor = new MemoryPressureMonitor({
+      source: () => {
+        if (fail) throw new Error('unreadable');
+        return reading('WARNING');
+      }
+    });
+    const cache = new ExpressionCache(100);
+    monitor.subscribeCache(cache);
+    monitor.checkNow();
+    fail = true;
+    expect(monitor.checkNow().status).toBe('UNKNOWN');
+    expect(cache.getStats().capacity).toBe(50);
+  });
+
+  it('should scale capacities by the configured fractions', () => {
+    const monitor = new MemoryPressureMonitor({ warningFraction: 0.25, criticalFraction: 0 });
+    expect(monitor.scaledCapacity(1024, 'HEALTHY')).toBe(1024);
+    expect(monitor.scaledCapacity(1024, 'WARNING')).toBe(256);
+    expect(monitor.scaledCapacity(1024, 'CRITICAL')).toBe(0);
+    expect(monitor.scaledCapacity(1024, 'UNKNOWN')).toBe(1024);
+  });
+
+  it('should start and stop the timer', () => {
+    const monitor = new MemoryPressureMonitor({ source: () => reading('HEALTHY') });
+    monitor.start();
+    expect(monitor.isRunning()).toBe(true);
+    expect(monitor.getStatus()).toBe('HEALTHY');
+    monitor.stop();
+    expect(monitor.isRunning()).toBe(false);
+  });
+});
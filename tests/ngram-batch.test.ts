@@ -0,0 +1,78 @@
+import { describe, it, expect } from 'vitest';
+import {
+  fromNativeNgramBatch,
+  generateNgramBatchJs,
+  getDocumentNgrams,
+  packDocuments,
+  unpackDocuments
+} from '../src/ngram-batch';
+import { generateHybridNgramHashesJs, hashNgram } from '../src/ngram-hash';
+
+describe('packDocuments', () => {
+  it('should pack UTF-8 bytes with byte offsets', () => {
+    const packed = packDocuments(['ab', '', '機械']);
+    expect(Array.from(packed.offsets)).toEqual([0, 2, 2, 8]);
+    expect(packed.data).toHaveLength(8);
+  });
+
+  it('should round-trip through unpackDocuments', () => {
+    const documents = ['golang', '', '機械学習', '𠀋a'];
+    expect(unpackDocuments(packDocuments(documents))).toEqual(documents);
+  });
+});
+
+describe('generateNgramBatchJs', () => {
+  it('should count n-grams per document', () => {
+    const batch = generateNgramBatchJs(['golang', '機械学習', '', 'a']);
+    expect(Array.from(batch.counts)).toEqual([5, 4, 0, 0]);
+    expect(batch.documentOffsets).toBeUndefined();
+    expect(batch.hashes).toBeUndefined();
+  });
+
+  it('should keep one occurrence per document when distinct', () => {
+    const batch = generateNgramBatchJs(['aaaa', 'aaaa'], { distinct: true, output: 'ngrams' });
+    expect(Array.from(batch.counts)).toEqual([1, 1]);
+    expect(getDocumentNgrams(batch, 1)).toEqual(['aa']);
+  });
+
+  it('should pack hashes in document order', () => {
+    const batch = generateNgramBatchJs(['go', '機械'], { output: 'hashes' });
+    expect(Array.from(batch.documentOffsets ?? [])).toEqual([0, 1, 3]);
+    expect(Array.from(batch.hashes ?? [])).toEqual([
+      ...generateHybridNgramHashesJs('go'),
+      ...generateHybridNgramHashesJs('機械')
+    ]);
+    expect(batch.hashes?.[0]).toBe(hashNgram('go'));
+  });
+
+  it('should pack n-grams with UTF-16 offsets', () => {
+    const batch = generateNgramBatchJs(['𠀋ab', 'xyz'], { output: 'ngrams', asciiNgramSize: 2 });
+    expect(getDocumentNgrams(batch, 0)).toEqual(['𠀋', 'ab']);
+    expect(getDocumentNgrams(batch, 1)).toEqual(['xy', 'yz']);
+  });
+
+  it('should normalize documents first', () => {
+    const batch = generateNgramBatchJs(['ＧＯ'], { output: 'ngrams', nfkc: true, lower: true });
+    expect(getDocumentNgrams(batch, 0)).toEqual(['go']);
+  });
+
+  it('should accept packed documents', () => {
+    const documents = ['golang tutorial', '機械学習'];
+    const fromArray = generateNgramBatchJs(documents, { output: 'hashes' });
+    const fromPacked = generateNgramBatchJs(packDocuments(documents), { output: 'hashes' });
+    expect(fromPacked).toEqual(fromArray);
+  });
+});
+
+describe('fromNativeNgramBatch', () => {
+  it('should convert snake_case fields', () => {
+    const batch = fromNativeNgramBatch({
+      counts: new Uint32Array([2]),
+      document_offsets: new Uint32Array([0, 2]),
+      data: 'goo',
+      ngram_offsets: new Uint32Array([0, 2, 3])
+    });
+    expect(getDocumentNgrams(batch, 0)).toEqual(['go', 'o']);
+    expect(batch.hashes).toBeUndefined();
+  });
+});
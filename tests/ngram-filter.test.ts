@@ -0,0 +1,102 @@
+import { describe, it, expect } from 'vitest';
+import { NgramBloomFilter } from '../src/ngram-filter';
+import { createNgramFilter, generateNgramBatch, isNativeAvailable, loadNgramFilter } from '../src/client-factory';
+import { generateHybridNgramHashesJs } from '../src/ngram-hash';
+
+describe('NgramBloomFilter', () => {
+  function sampleFilter(): NgramBloomFilter {
+    const filter = new NgramBloomFilter(1000);
+    filter.add(['golang tutorial', 'python guide']);
+    filter.add('東京都の天気');
+    return filter;
+  }
+
+  it('should never reject a term of an added document', () => {
+    const filter = sampleFilter();
+    expect(filter.mayMatch('golang')).toBe(true);
+    expect(filter.mayMatch('tutorial')).toBe(true);
+    expect(filter.mayMatch('東京')).toBe(true);
+    expect(filter.mayMatch('天気')).toBe(true);
+  });
+
+  it('should reject terms with an n-gram that was never added', () => {
+    const filter = sampleFilter();
+    expect(filter.mayMatch('rustacean')).toBe(false);
+    expect(filter.mayMatch('大阪')).toBe(false);
+  });
+
+  it('should normalize terms like documents', () => {
+    const filter = sampleFilter();
+    expect(filter.mayMatch('ｇｏｌａｎｇ')).toBe(true);
+  });
+
+  it('should accept terms too short to form an n-gram', () => {
+    const filter = sampleFilter();
+    expect(filter.mayMatch('z')).toBe(true);
+    expect(filter.mayMatch('')).toBe(true);
+  });
+
+  it('should check every positive term of a query', () => {
+    const filter = sampleFilter();
+    expect(filter.mayMatchQuery('golang', ['guide'])).toBe(true);
+    expect(filter.mayMatchQuery('golang', ['rustacean'])).toBe(false);
+  });
+
+  it('should report stats', () => {
+    const stats = sampleFilter().getStats();
+    expect(stats.ngrams).toBeGreaterThan(0);
+    expect(stats.sizeBytes % 64).toBe(0);
+    expect(stats.hashCount).toBe(7);
+    expect(stats.falsePositiveRate).toBeLessThan(0.01);
+  });
+
+  it('should round-trip through serialize', () => {
+    const filter = sampleFilter();
+    const restored = NgramBloomFilter.deserialize(filter.serialize());
+    expect(restored.serialize()).toEqual(filter.serialize());
+    expect(restored.mayMatch('golang')).toBe(true);
+    expect(restored.mayMatch('rustacean')).toBe(false);
+    expect(restored.getStats()).toEqual(filter.getStats());
+  });
+
+  it('should reject data that is not a filter', () => {
+    const data = sampleFilter().serialize();
+    expect(() => NgramBloomFilter.deserialize(new Uint8Array([1, 2, 3]))).toThrow('Not an n-gram filter');
+    expect(() => NgramBloomFilter.deserialize(data.subarray(0, data.length - 8))).toThrow();
+  });
+});
+
+describe('native and JavaScript n-gram filters', () => {
+  const document = 'カタカナのガイド。';
+
+  it('should hash katakana like the native normalizer', () => {
+    // The native narrow width turns katakana and CJK punctuation into their half-width forms
+    const filter = new NgramBloomFilter(1000);
+    filter.add(generateHybridNgramHashesJs('ｶﾀｶﾅのｶﾞｲﾄﾞ｡'));
+    expect(filter.mayMatch('カタカナ')).toBe(true);
+    expect(filter.mayMatch('ガイド。')).toBe(true);
+  });
+
+  it.skipIf(!isNativeAvailable())('should round-trip a katakana document', () => {
+    const native = createNgramFilter(1000);
+    native.add(document);
+    const js = createNgramFilter(1000, {}, true);
+    js.add(document);
+    expect(js.serialize()).toEqual(native.serialize());
+
+    const fromNative = loadNgramFilter(native.serialize(), true);
+    const fromJs = loadNgramFilter(js.serialize());
+    expect(fromNative.mayMatch('カタカナ')).toBe(true);
+    expect(fromNative.mayMatch('ガイド')).toBe(true);
+    expect(fromJs.mayMatch('カタカナ')).toBe(true);
+    expect(fromJs.mayMatch('ガイド')).toBe(true);
+
+    const { hashes } = generateNgramBatch([document], { nfkc: true, width: 'narrow', output: 'hashes' });
+    const fromHashes = createNgramFilter(1000, {}, true);
+    fromHashes.add(hashes as BigUint64Array);
+    expect(fromHashes.serialize()).toEqual(native.serialize());
+
+    native.destroy();
+    fromJs.destroy();
+  });
+});
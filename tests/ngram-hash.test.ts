@@ -0,0 +1,37 @@
+import { describe, it, expect } from 'vitest';
+import { generateHybridNgramHashesJs, generateNgramHashesJs, hashNgram } from '../src/ngram-hash';
+
+describe('hashNgram', () => {
+  it('should match the native hash values', () => {
+    expect(hashNgram('go')).toBe(0x598a0482469bf038n);
+    expect(hashNgram('機')).toBe(0x6d049d9cb2552df4n);
+  });
+
+  it('should separate n-grams of different lengths', () => {
+    expect(hashNgram('a')).not.toBe(hashNgram('aa'));
+    expect(hashNgram('')).not.toBe(hashNgram('\u0000'));
+  });
+});
+
+describe('generateNgramHashesJs', () => {
+  it('should hash every window', () => {
+    const hashes = generateNgramHashesJs('golang', 2);
+    expect(Array.from(hashes)).toEqual(['go', 'ol', 'la', 'an', 'ng'].map(hashNgram));
+  });
+
+  it('should count code points, not UTF-16 units', () => {
+    expect(Array.from(generateNgramHashesJs('𠀋a', 2))).toEqual([hashNgram('𠀋a')]);
+  });
+
+  it('should return nothing for short text or invalid sizes', () => {
+    expect(generateNgramHashesJs('g', 2)).toHaveLength(0);
+    expect(generateNgramHashesJs('go', 0)).toHaveLength(0);
+  });
+});
+
+describe('generateHybridNgramHashesJs', () => {
+  it('should hash the same n-grams as generateHybridNgrams', () => {
+    expect(Array.from(generateHybridNgramHashesJs('Go言語', 2, 1))).toEqual(['Go', '言', '語'].map(hashNgram));
+    expect(Array.from(generateHybridNgramHashesJs('言語x', 2, 2))).toEqual([hashNgram('言語')]);
+  });
+});
@@ -0,0 +1,75 @@
+import { describe, it, expect } from 'vitest';
+import { analyzeExpression, analyzeTerms, dedupeTerms, prepareTerms } from '../src/query-analysis';
+
+describe('analyzeExpression', () => {
+  it('should detect a term both required and excluded', () => {
+    expect(analyzeExpression('+foo -foo')).toEqual({
+      verdict: 'empty',
+      reason: "'foo' is both required and excluded",
+      contradictions: ['foo'],
+      duplicates: []
+    });
+  });
+
+  it('should reject NOT-only expressions', () => {
+    const analysis = analyzeExpression('-old -deprecated');
+    expect(analysis.verdict).toBe('invalid');
+    expect(analysis.reason).toContain('at least one positive term');
+  });
+
+  it('should report parse errors as invalid', () => {
+    expect(analyzeExpression('+').verdict).toBe('invalid');
+    expect(analyzeExpression('   ').verdict).toBe('invalid');
+  });
+
+  it('should report duplicates without blocking the query', () => {
+    expect(analyzeExpression('golang golang -old -old')).toEqual({
+      verdict: 'send',
+      contradictions: [],
+      duplicates: ['golang', 'old']
+    });
+  });
+
+  it('should not treat OR alternatives as required', () => {
+    expect(analyzeExpression('python OR ruby -ruby').verdict).toBe('send');
+    expect(analyzeExpression('+ruby (python OR go) -ruby').verdict).toBe('empty');
+  });
+});
+
+describe('analyzeTerms', () => {
+  it('should compare the main query with excluded terms', () => {
+    expect(analyzeTerms('golang', ['tutorial'], ['golang']).verdict).toBe('empty');
+    expect(analyzeTerms('golang', ['tutorial'], ['old']).verdict).toBe('send');
+  });
+
+  it('should reject empty terms', () => {
+    expect(analyzeTerms('', [], ['old']).reason).toContain('at least one positive term');
+    expect(analyzeTerms('', ['golang']).reason).toBe('Search query cannot be empty');
+    expect(analyzeTerms('golang', ['']).reason).toBe('AND term cannot be empty');
+    expect(analyzeTerms('golang', [], ['']).reason).toBe('NOT term cannot be empty');
+  });
+
+  it('should not compare a multi-word query with other terms', () => {
+    expect(analyzeTerms('golang tutorial', [], ['golang']).verdict).toBe('send');
+  });
+});
+
+describe('prepareTerms', () => {
+  it('should drop repeated terms and the main query from AND terms', () => {
+    expect(prepareTerms('golang', ['tutorial', 'golang', 'tutorial'], ['old', 'old'])).toMatchObject({
+      andTerms: ['tutorial'],
+      notTerms: ['old']
+    });
+  });
+
+  it('should keep the original arrays without duplicates', () => {
+    const andTerms = ['tutorial'];
+    expect(prepareTerms('golang', andTerms, []).andTerms).toBe(andTerms);
+  });
+});
+
+describe('dedupeTerms', () => {
+  it('should keep the first occurrence order', () => {
+    expect(dedupeTerms(['b', 'a', 'b', 'c', 'a'])).toEqual(['b', 'a', 'c']);
+  });
+});
@@ -0,0 +1,67 @@
+import { describe, it, expect } from 'vitest';
+import { flattenQueryAst, formatQueryAst, parseQueryAst, simplifyQueryAst } from '../src/query-ast';
+
+function convert(expression: string): string {
+  return formatQueryAst(parseQueryAst(expression));
+}
+
+describe('parseQueryAst', () => {
+  it('should convert like the native parser', () => {
+    expect(convert('golang tutorial')).toBe('golang AND tutorial');
+    expect(convert('"machine learning" tutorial')).toBe('"machine learning" AND tutorial');
+    expect(convert('golang -old')).toBe('golang AND NOT old');
+    expect(convert('python OR ruby')).toBe('python OR ruby');
+    expect(convert('a OR b c')).toBe('(a OR b) AND c');
+    expect(convert('+golang +(tutorial OR guide)')).toBe('golang AND (tutorial OR guide)');
+    expect(convert('-old golang')).toBe('golang AND NOT old');
+    expect(convert('foo -(bar OR baz)')).toBe('foo AND NOT (bar OR baz)');
+    expect(convert('a (b c)')).toBe('a AND b AND c');
+    expect(convert('機械学習　チュートリアル')).toBe('機械学習 AND チュートリアル');
+  });
+
+  it('should quote reserved words and escape phrases', () => {
+    expect(convert('"AND" NOT')).toBe('"AND" AND "NOT"');
+    expect(convert('"say \\"hi\\""')).toBe('"say \\"hi\\""');
+    expect(convert('ORACLE "OR"')).toBe('ORACLE AND "OR"');
+  });
+
+  it('should report the native error messages', () => {
+    expect(() => parseQueryAst('')).toThrow('Empty search expression');
+    expect(() => parseQueryAst('   ')).toThrow('Empty search expression');
+    expect(() => parseQueryAst('a OR')).toThrow("Expected term after 'OR'");
+    expect(() => parseQueryAst('OR a')).toThrow("Unexpected 'OR' operator");
+    expect(() => parseQueryAst('golang -')).toThrow("Expected term after '-'");
+    expect(() => parseQueryAst('(a')).toThrow('Unbalanced parentheses');
+    expect(() => parseQueryAst('a)')).toThrow("Unexpected ')'");
+    expect(() => parseQueryAst('()')).toThrow('Empty parentheses');
+    expect(() => parseQueryAst('""')).toThrow('Empty phrase');
+    expect(() => parseQueryAst(`${'('.repeat(65)}a${')'.repeat(65)}`)).toThrow('Expression nested too deeply');
+  });
+});
+
+describe('flattenQueryAst', () => {
+  it('should split terms, excluded terms and groups', () => {
+    expect(flattenQueryAst(parseQueryAst('golang (tutorial OR guide) -old -(a OR b)'))).toEqual({
+      requiredTerms: ['golang'],
+      excludedTerms: ['old'],
+      optionalTerms: [],
+      rawExpression: '(tutorial OR guide) AND NOT (a OR b)'
+    });
+  });
+});
+
+describe('simplifyQueryAst', () => {
+  it('should simplify plain terms', () => {
+    expect(simplifyQueryAst(parseQueryAst('golang tutorial -old'))).toEqual({
+      mainTerm: 'golang',
+      andTerms: ['tutorial'],
+      notTerms: ['old']
+    });
+  });
+
+  it('should reject groups instead of dropping them', () => {
+    expect(simplifyQueryAst(parseQueryAst('+golang +(tutorial OR guide)'))).toBeNull();
+    expect(simplifyQueryAst(parseQueryAst('foo -(bar OR baz)'))).toBeNull();
+    expect(simplifyQueryAst(parseQueryAst('-old'))).toBeNull();
+  });
+});
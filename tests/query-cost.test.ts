@@ -0,0 +1,50 @@
+import { describe, it, expect } from 'vitest';
+import { classifyQueryCost, estimateQueryCostJs, generateHybridNgrams } from '../src/query-cost';
+
+describe('generateHybridNgrams', () => {
+  it('should split ASCII text into bigrams', () => {
+    expect(generateHybridNgrams('golang')).toEqual(['go', 'ol', 'la', 'an', 'ng']);
+  });
+
+  it('should use unigrams for CJK ideographs without mixing kinds', () => {
+    expect(generateHybridNgrams('機械学習')).toEqual(['機', '械', '学', '習']);
+    expect(generateHybridNgrams('Go言語')).toEqual(['Go', '言', '語']);
+  });
+
+  it('should produce nothing for terms shorter than the n-gram size', () => {
+    expect(generateHybridNgrams('a')).toEqual([]);
+    expect(generateHybridNgrams('abc', 3)).toEqual(['abc']);
+  });
+});
+
+describe('classifyQueryCost', () => {
+  it('should apply the thresholds', () => {
+    expect(classifyQueryCost(10)).toBe('low');
+    expect(classifyQueryCost(32)).toBe('moderate');
+    expect(classifyQueryCost(128)).toBe('high');
+    expect(classifyQueryCost(600)).toBe('excessive');
+    expect(classifyQueryCost(600, { excessiveNgrams: 1000 })).toBe('high');
+  });
+});
+
+describe('estimateQueryCostJs', () => {
+  it('should count n-grams per term', () => {
+    const cost = estimateQueryCostJs('+golang -old a');
+    expect(cost.terms).toEqual([
+      { term: 'golang', ngrams: 5, phrase: false, excluded: false, optional: false },
+      { term: 'a', ngrams: 0, phrase: false, excluded: false, optional: false },
+      { term: 'old', ngrams: 2, phrase: false, excluded: true, optional: false }
+    ]);
+    expect(cost).toMatchObject({ totalNgrams: 7, distinctNgrams: 6, maxTermNgrams: 5, shortTerms: 1 });
+    expect(cost.costClass).toBe('low');
+  });
+
+  it('should normalize terms before splitting', () => {
+    expect(estimateQueryCostJs('ＧＯＧＯ', { nfkc: true, lower: true }).distinctNgrams).toBe(2);
+  });
+
+  it('should flag long OR chains as expensive', () => {
+    const expression = Array.from({ length: 40 }, (_, i) => `supercalifragilistic${i}`).join(' OR ');
+    expect(estimateQueryCostJs(expression).costClass).toBe('excessive');
+  });
+});
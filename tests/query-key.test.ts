@@ -0,0 +1,135 @@
+import { describe, it, expect } from 'vitest';
+import {
+  SingleFlight,
+  canonicalCountKey,
+  canonicalSearchKey,
+  canonicalizeExpression,
+  canonicalizeTerms,
+  escapeQueryTerm,
+  normalizeQueryTerm
+} from '../src/query-key';
+
+describe('canonicalizeExpression', () => {
+  it('should map equivalent expressions to the same terms', () => {
+    const expected = { mainTerm: 'bar', andTerms: ['foo'], notTerms: [] };
+    expect(canonicalizeExpression('+foo +bar')).toEqual(expected);
+    expect(canonicalizeExpression('bar foo')).toEqual(expected);
+    expect(canonicalizeExpression('foo  bar')).toEqual(expected);
+  });
+
+  it('should dedupe and sort excluded terms', () => {
+    expect(canonicalizeExpression('foo -z -a -z foo')).toEqual({
+      mainTerm: 'foo',
+      andTerms: [],
+      notTerms: ['a', 'z']
+    });
+  });
+
+  it('should reject expressions without a term-list form', () => {
+    expect(() => canonicalizeExpression('python OR ruby')).toThrow('no canonical term form');
+    expect(() => canonicalizeExpression('-old')).toThrow('at least one positive term');
+    expect(() => canonicalizeExpression('foo -(bar OR baz)')).toThrow('no canonical term form');
+  });
+});
+
+describe('canonicalizeTerms', () => {
+  it('should treat the main term as one of the required terms', () => {
+    expect(canonicalizeTerms('zeta', ['alpha', 'zeta', ''], ['old'])).toEqual({
+      mainTerm: 'alpha',
+      andTerms: ['zeta'],
+      notTerms: ['old']
+    });
+  });
+
+  it('should apply normalization before deduping', () => {
+    const terms = canonicalizeTerms('Ｆｏｏ', ['foo'], [], { width: 'narrow', lower: true });
+    expect(terms).toEqual({ mainTerm: 'foo', andTerms: [], notTerms: [] });
+  });
+});
+
+describe('normalizeQueryTerm', () => {
+  it('should leave terms untouched by default', () => {
+    expect(normalizeQueryTerm('Ｆｏｏ Bar')).toBe('Ｆｏｏ Bar');
+  });
+
+  it('should convert width and case', () => {
+    expect(normalizeQueryTerm('Ａｂｃ　１', { width: 'narrow' })).toBe('Abc 1');
+    expect(normalizeQueryTerm('Ab 1', { width: 'wide' })).toBe('Ａｂ　１');
+    expect(normalizeQueryTerm('ＡＢＣ', { nfkc: true, lower: true })).toBe('abc');
+  });
+
+  it('should convert kana and punctuation width like the native normalizer', () => {
+    expect(normalizeQueryTerm('カタカナ', { width: 'narrow' })).toBe('ｶﾀｶﾅ');
+    expect(normalizeQueryTerm('ガ。', { nfkc: true, width: 'narrow' })).toBe('ｶﾞ｡');
+    expect(normalizeQueryTerm('ｶﾞｲﾄﾞ｡', { width: 'wide' })).toBe('ガイド。');
+  });
+});
+
+describe('canonical keys', () => {
+  it('should ignore term and filter order', () => {
+    const a = canonicalSearchKey('articles', 'foo', {
+      andTerms: ['bar'],
+      filters: { status: '1', lang: 'en' }
+    });
+    const b = canonicalSearchKey('articles', 'bar', {
+      andTerms: ['foo', 'bar'],
+      filters: { lang: 'en', status: '1' },
+      limit: 1000
+    });
+    expect(a).toBe(b);
+    expect(a).toBe('SEARCH articles bar AND foo FILTER lang = en FILTER status = 1 LIMIT 1000');
+  });
+
+  it('should keep paging and sorting distinct', () => {
+    const base = canonicalSearchKey('articles', 'foo');
+    expect(canonicalSearchKey('articles', 'foo', { offset: 10 })).not.toBe(base);
+    expect(canonicalSearchKey('articles', 'foo', { sortColumn: 'created_at' })).toBe(
+      'SEARCH articles foo SORT created_at DESC LIMIT 1000'
+    );
+    expect(canonicalSearchKey('articles', 'foo', { offset: 10, limit: 20, sortDesc: false })).toBe(
+      'SEARCH articles foo SORT ASC LIMIT 10,20'
+    );
+  });
+
+  it('should order terms by code point like the native client', () => {
+    // U+1F600 is a surrogate pair in UTF-16 but sorts after U+FF41 in UTF-8
+    expect(canonicalizeTerms('\u{1f600}', ['\uff41']).mainTerm).toBe('\uff41');
+  });
+
+  it('should quote terms with whitespace', () => {
+    expect(escapeQueryTerm('say "hi"')).toBe('"say \\"hi\\""');
+    expect(canonicalCountKey('articles', 'hello world', { notTerms: ['old'] })).toBe(
+      'COUNT articles "hello world" NOT old'
+    );
+  });
+});
+
+describe('SingleFlight', () => {
+  it('should share one task between concurrent calls with the same key', async () => {
+    const flights = new SingleFlight<number>();
+    let calls = 0;
+    const task = async () => {
+      calls += 1;
+      return calls;
+    };
+
+    const [first, second, other] = await Promise.all([
+      flights.run('a', task),
+      flights.run('a', task),
+      flights.run('b', task)
+    ]);
+    expect(first).toBe(1);
+    expect(second).toBe(1);
+    expect(other).toBe(2);
+    expect(flights.size).toBe(0);
+
+    expect(await flights.run('a', task)).toBe(3);
+  });
+
+  it('should release the key when the task fails', async () => {
+    const flights = new SingleFlight<number>();
+    await expect(flights.run('a', async () => Promise.reject(new Error('boom')))).rejects.toThrow('boom');
+    expect(flights.size).toBe(0);
+    expect(await flights.run('a', async () => 1)).toBe(1);
+  });
+});
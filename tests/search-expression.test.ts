@@ -2,6 +2,8 @@ import { describe, it, expect } from 'vitest';
 import {
   parseSearchExpression,
   convertSearchExpression,
+  convertSearchExpressions,
+  unpackConversions,
   simplifySearchExpression,
   hasComplexExpression,
   toQueryString
@@ -213,3 +215,32 @@ describe('simplifySearchExpression', () => {
     );
   });
 });
+
+describe('convertSearchExpressions', () => {
+  it('should report errors per entry', () => {
+    expect(convertSearchExpressions(['+golang -old', ''])).toEqual([
+      { ok: true, query: 'golang AND NOT old' },
+      { ok: false, error: 'Empty search expression' }
+    ]);
+  });
+
+  it('should convert like the native batch conversion', () => {
+    expect(convertSearchExpressions(['golang tutorial', 'a OR b c', 'a OR'])).toEqual([
+      { ok: true, query: 'golang AND tutorial' },
+      { ok: true, query: '(a OR b) AND c' },
+      { ok: false, error: "Expected term after 'OR'" }
+    ]);
+  });
+});
+
+describe('unpackConversions', () => {
+  it('should slice entries by UTF-16 offsets', () => {
+    const data = "日本 AND 語Expected term after 'OR'😀x";
+    const offsets = new Uint32Array([0, 8, 32, 35]);
+    expect(unpackConversions({ data, offsets, ok: new Uint8Array([1, 0, 1]) })).toEqual([
+      { ok: true, query: '日本 AND 語' },
+      { ok: false, error: "Expected term after 'OR'" },
+      { ok: true, query: '😀x' }
+    ]);
+  });
+});
@@ -0,0 +1,154 @@
+import { describe, it, expect, vi, afterEach } from 'vitest';
+import { MetricsAccumulator, MetricsCollector } from '../src/server-metrics';
+import { InfoSource } from '../src/info-poller';
+import { InfoSnapshot, ServerInfo } from '../src/types';
+
+interface Counters {
+  uptime?: number;
+  requests: number;
+  errors?: number;
+  docs?: number;
+  bytes?: number;
+}
+
+function makeSnapshot(capturedAt: number, counters: Counters): InfoSnapshot {
+  const values: Record<string, string> = { total_requests: String(counters.requests) };
+  if (counters.errors !== undefined) {
+    values.total_errors = String(counters.errors);
+  }
+  const info: ServerInfo = {
+    version: '1.0.0',
+    uptimeSeconds: counters.uptime ?? capturedAt / 1000,
+    totalRequests: counters.requests,
+    activeConnections: 2,
+    indexSizeBytes: counters.bytes ?? 1000,
+    docCount: counters.docs ?? 10,
+    tables: ['articles'],
+    values
+  };
+  return { info, capturedAt, sequence: 0 };
+}
+
+describe('MetricsAccumulator', () => {
+  it('should report zero rates before two samples', () => {
+    const accumulator = new MetricsAccumulator([60]);
+    expect(accumulator.compute().windows).toEqual([
+      {
+        windowSeconds: 60,
+        coveredSeconds: 0,
+        requestsPerSecond: 0,
+        errorsPerSecond: 0,
+        errorRatio: 0,
+        docsPerSecond: 0,
+        docDelta: 0,
+        indexBytesDelta: 0
+      }
+    ]);
+
+    accumulator.record(makeSnapshot(1000, { requests: 100 }));
+    const metrics = accumulator.compute();
+    expect(metrics.sampleCount).toBe(1);
+    expect(metrics.windows[0].requestsPerSecond).toBe(0);
+    expect(metrics.indexBytesPerDoc).toBe(100);
+  });
+
+  it('should compute rates and growth over the window', () => {
+    const accumulator = new MetricsAccumulator([10]);
+    accumulator.record(makeSnapshot(1000, { requests: 100, errors: 1, docs: 10, bytes: 1000 }));
+    accumulator.record(makeSnapshot(6000, { requests: 600, errors: 6, docs: 20, bytes: 3000 }));
+
+    const metrics = accumulator.compute();
+    expect(metrics.reportsErrors).toBe(true);
+    expect(metrics.docCount).toBe(20);
+    expect(metrics.indexBytesPerDoc).toBe(150);
+    expect(metrics.windows[0]).toMatchObject({
+      coveredSeconds: 5,
+      requestsPerSecond: 100,
+      errorsPerSecond: 1,
+      errorRatio: 0.01,
+      docsPerSecond: 2,
+      docDelta: 10,
+      indexBytesDelta: 2000
+    });
+  });
+
+  it('should use the newest sample at or before the window start', () => {
+    const accumulator = new MetricsAccumulator([2, 60]);
+    accumulator.record(makeSnapshot(0, { requests: 0 }));
+    accumulator.record(makeSnapshot(1000, { requests: 1000 }));
+    accumulator.record(makeSnapshot(2000, { requests: 1100 }));
+    accumulator.record(makeSnapshot(3000, { requests: 1200 }));
+
+    const [short, long] = accumulator.compute().windows;
+    expect(short.coveredSeconds).toBe(2);
+    expect(short.requestsPerSecond).toBe(100);
+    expect(long.coveredSeconds).toBe(3);
+    expect(long.requestsPerSecond).toBe(400);
+  });
+
+  it('should discard samples older than the longest window', () => {
+    const accumulator = new MetricsAccumulator([2]);
+    for (let i = 0; i <= 10; i += 1) {
+      accumulator.record(makeSnapshot(i * 1000, { requests: i * 10 }));
+    }
+    expect(accumulator.compute().sampleCount).toBe(3);
+  });
+
+  it('should stitch counters across a server restart', () => {
+    const accumulator = new MetricsAccumulator([60]);
+    accumulator.record(makeSnapshot(0, { uptime: 100, requests: 500 }));
+    accumulator.record(makeSnapshot(10000, { uptime: 110, requests: 600 }));
+    accumulator.record(makeSnapshot(20000, { uptime: 5, requests: 50 }));
+
+    const metrics = accumulator.compute();
+    expect(metrics.counterResets).toBe(1);
+    expect(metrics.windows[0].requestsPerSecond).toBe(7.5);
+  });
+
+  it('should report no errors when INFO lacks total_errors', () => {
+    const accumulator = new MetricsAccumulator([60]);
+    accumulator.record(makeSnapshot(0, { requests: 0 }));
+    accumulator.record(makeSnapshot(1000, { requests: 10 }));
+
+    const metrics = accumulator.compute();
+    expect(metrics.reportsErrors).toBe(false);
+    expect(metrics.windows[0].errorRatio).toBe(0);
+  });
+});
+
+describe('MetricsCollector', () => {
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('should sample through an InfoPoller', async () => {
+    vi.useFakeTimers();
+    let requests = 0;
+    let connected = false;
+    const source: InfoSource = {
+      async connect() {
+        connected = true;
+      },
+      disconnect() {
+        connected = false;
+      },
+      isConnected() {
+        return connected;
+      },
+      async info() {
+        requests += 100;
+        return makeSnapshot(Date.now(), { requests }).info;
+      }
+    };
+
+    const collector = new MetricsCollector(source, { intervalMs: 1000, windows: [60] });
+    await collector.start();
+    await vi.advanceTimersByTimeAsync(3000);
+    collector.stop();
+
+    const metrics = collector.getMetrics();
+    expect(collector.isRunning()).toBe(false);
+    expect(metrics.sampleCount).toBe(4);
+    expect(metrics.windows[0].requestsPerSecond).toBeCloseTo(100);
+  });
+});
@@ -0,0 +1,92 @@
+import { describe, it, expect, vi, afterEach } from 'vitest';
+import { TermStatsCache, simplifySearchExpressionBySelectivity } from '../src/term-stats';
+
+describe('TermStatsCache', () => {
+  afterEach(() => {
+    vi.useRealTimers();
+  });
+
+  it('should put the rarest known term first', () => {
+    const stats = new TermStatsCache();
+    stats.recordCount('articles', 'the', 950000);
+    stats.recordCount('articles', 'golang', 1200);
+
+    expect(stats.reorder('articles', 'the', ['tutorial', 'golang'])).toEqual({
+      mainTerm: 'golang',
+      andTerms: ['the', 'tutorial']
+    });
+    expect(stats.getStats().reorders).toBe(1);
+  });
+
+  it('should keep the order without statistics', () => {
+    const stats = new TermStatsCache();
+    stats.recordCount('other', 'b', 1);
+    expect(stats.reorder('articles', 'a', ['b', 'c'])).toEqual({ mainTerm: 'a', andTerms: ['b', 'c'] });
+    expect(stats.getStats().reorders).toBe(0);
+  });
+
+  it('should not let estimates override exact counts', () => {
+    const stats = new TermStatsCache();
+    stats.recordCount('articles', 'golang', 10);
+    stats.recordCandidates('articles', 'golang', 5000);
+    expect(stats.lookup('articles', 'golang')).toBe(10);
+
+    stats.recordCandidates('articles', 'rust', 5000);
+    stats.recordCount('articles', 'rust', 20);
+    expect(stats.lookup('articles', 'rust')).toBe(20);
+  });
+
+  it('should record exact counts only for lone terms', () => {
+    const stats = new TermStatsCache();
+    stats.recordResponse('articles', 'golang', true, 42);
+    stats.recordResponse('articles', 'rust', false, 3, {
+      queryTimeMs: 1,
+      indexTimeMs: 1,
+      filterTimeMs: 0,
+      terms: 2,
+      ngrams: 4,
+      candidates: 700,
+      afterIntersection: 3,
+      afterNot: 3,
+      afterFilters: 3,
+      final: 3,
+      optimization: 'none'
+    });
+    stats.recordResponse('articles', 'python', false, 3);
+
+    expect(stats.lookup('articles', 'golang')).toBe(42);
+    expect(stats.lookup('articles', 'rust')).toBe(700);
+    expect(stats.lookup('articles', 'python')).toBeUndefined();
+  });
+
+  it('should expire old statistics', () => {
+    vi.useFakeTimers();
+    const stats = new TermStatsCache({ maxAgeMs: 1000 });
+    stats.recordCount('articles', 'golang', 10);
+    vi.advanceTimersByTime(1500);
+    expect(stats.lookup('articles', 'golang')).toBeUndefined();
+  });
+
+  it('should drop the oldest term beyond the table limit', () => {
+    const stats = new TermStatsCache({ maxTermsPerTable: 2 });
+    stats.recordCount('articles', 'a', 1);
+    stats.recordCount('articles', 'b', 2);
+    stats.recordCount('articles', 'c', 3);
+
+    expect(stats.getStats().entries).toBe(2);
+    expect(stats.lookup('articles', 'a')).toBeUndefined();
+    expect(stats.lookup('articles', 'c')).toBe(3);
+  });
+});
+
+describe('simplifySearchExpressionBySelectivity', () => {
+  it('should choose the most selective main term', () => {
+    const stats = new TermStatsCache();
+    stats.recordCount('articles', 'tutorial', 5);
+    expect(simplifySearchExpressionBySelectivity('+golang +tutorial -old', 'articles', stats)).toEqual({
+      mainTerm: 'tutorial',
+      andTerms: ['golang'],
+      notTerms: ['old']
+    });
+  });
+});